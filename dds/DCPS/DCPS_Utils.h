@@ -48,6 +48,13 @@ compatibleQOS(const DDS::DataWriterQos * writerQos,
               OpenDDS::DCPS::IncompatibleQosStatus* writerStatus,
               OpenDDS::DCPS::IncompatibleQosStatus* readerStatus);
 
+/// True if a publication in partitions @a pub and a subscription in
+/// partitions @a sub share a partition.
+OpenDDS_Dcps_Export
+bool
+matching_partitions(const DDS::PartitionQosPolicy& pub,
+                    const DDS::PartitionQosPolicy& sub);
+
 OpenDDS_Dcps_Export
 bool
 compatibleQOS(const DDS::PublisherQos * pubQos,
@@ -3203,7 +3203,11 @@ bool DataReaderImpl::check_historic(const ReceivedDataSample& sample)
   if (iter != writers_.end()) {
     const SequenceNumber& seq = sample.header_.sequence_;
     if (iter->second->waiting_for_end_historic_samples_) {
-      iter->second->historic_samples_.insert(std::make_pair(seq, sample));
+      // Delivered later to this reader alone, so it does not hold on to
+      // a sample shared by the other readers.
+      ReceivedDataSample& held =
+        iter->second->historic_samples_.insert(std::make_pair(seq, sample)).first->second;
+      held.shared_decode_.reset();
       return false;
     }
     if (iter->second->last_historic_seq_ != SequenceNumber::SEQUENCENUMBER_UNKNOWN()
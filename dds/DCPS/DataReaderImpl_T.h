@@ -895,50 +895,30 @@ namespace OpenDDS {
   {
     //!!! caller should already have the sample_lock_
 
-    MessageType data;
-
-    const bool cdr = sample.header_.cdr_encapsulation_;
-
-    OpenDDS::DCPS::Serializer ser(
-      sample.sample_.get(),
-      sample.header_.byte_order_ != ACE_CDR_BYTE_ORDER,
-      cdr ? OpenDDS::DCPS::Serializer::ALIGN_CDR
-          : OpenDDS::DCPS::Serializer::ALIGN_NONE);
-
-    if (cdr) {
-      ACE_CDR::ULong header;
-      if (!(ser >> header)) {
-        ACE_ERROR((LM_ERROR, ACE_TEXT("(%P|%t) %CDataReaderImpl::lookup_instance ")
-                  ACE_TEXT("deserialization header failed.\n"),
-                  TraitsType::type_name()));
-        return;
-      }
-
-      if (Serializer::use_rti_serialization()) {
-        // Start counting byte-offset AFTER header
-        ser.reset_alignment();
-      }
-    }
-
-    if (sample.header_.key_fields_only_) {
-      ser >> OpenDDS::DCPS::KeyOnly< MessageType>(data);
-    } else {
-      ser >> data;
-    }
-
-    if (!ser.good_bit()) {
-      ACE_ERROR((LM_ERROR, ACE_TEXT("(%P|%t) %CDataReaderImpl::lookup_instance ")
-                 ACE_TEXT("deserialization failed.\n"),
-                 TraitsType::type_name()));
+    const OpenDDS::DCPS::MarshalingType marshaling_type =
+      sample.header_.key_fields_only_ ? OpenDDS::DCPS::KEY_ONLY_MARSHALING
+                                      : OpenDDS::DCPS::FULL_MARSHALING;
+    unique_ptr<MessageTypeWithAllocator> local(new (*data_allocator()) MessageTypeWithAllocator);
+    bool share = false;
+    const MessageType* const data =
+      demarshal_sample(sample, marshaling_type, *local, share, "lookup_instance");
+    if (!data) {
       return;
     }
 
     DDS::InstanceHandle_t handle(DDS::HANDLE_NIL);
-    typename InstanceMap::const_iterator const it = instance_map_.find(data);
+    typename InstanceMap::const_iterator const it = instance_map_.find(*data);
     if (it != instance_map_.end()) {
       handle = it->second;
     }
 
+    if (share) {
+      // Nothing keeps this decode, so the other readers keep it alive.
+      share_sample(sample, marshaling_type, data,
+                   make_rch<SharedSample>(this, local.release(),
+                                          static_cast<OpenDDS::DCPS::ReceivedDataElement*>(0)));
+    }
+
     if (handle == DDS::HANDLE_NIL) {
       instance.reset();
     } else {
@@ -977,6 +957,115 @@ protected:
                              OpenDDS::DCPS::MarshalingType marshaling_type)
   {
     unique_ptr<MessageTypeWithAllocator> data(new (*data_allocator()) MessageTypeWithAllocator);
+    bool share = false;
+    const MessageType* const decoded =
+      demarshal_sample(sample, marshaling_type, *data, share, "dds_demarshal");
+    if (!decoded) {
+      return;
+    }
+
+#ifndef OPENDDS_NO_CONTENT_FILTERED_TOPIC
+    if (!sample.header_.content_filter_) { // if this is true, the writer has already filtered
+      using OpenDDS::DCPS::ContentFilteredTopicImpl;
+      if (content_filtered_topic_) {
+        const bool sample_only_has_key_fields = !sample.header_.valid_data();
+        if (!content_filtered_topic_->filter(*decoded, sample_only_has_key_fields)) {
+          filtered = true;
+          if (share) {
+            // Rejected here, but perhaps not by the other readers.
+            share_sample(sample, marshaling_type, decoded,
+                         make_rch<SharedSample>(this, data.release(),
+                                                static_cast<OpenDDS::DCPS::ReceivedDataElement*>(0)));
+          }
+          return;
+        }
+      }
+    }
+#endif
+
+    // A sample shared by another reader is only copied once it passed
+    // this reader's filter.
+    if (decoded != data.get()) {
+      static_cast<MessageType&>(*data) = *decoded;
+    }
+
+    // The stored sample is shared with the readers that follow; a sample
+    // that is not stored (filtered or delayed) is not, and they
+    // demarshal the payload themselves.
+    OpenDDS::DCPS::ReceivedDataElement* stored = 0;
+    store_instance_data(move(data), sample.header_, instance, just_registered, filtered,
+                        share ? &stored : 0);
+    if (stored) {
+      share_sample(sample, marshaling_type, decoded,
+                   make_rch<SharedSample>(this, static_cast<MessageTypeWithAllocator*>(0), stored));
+    }
+  }
+
+  /**
+   * Keeps a sample this reader demarshaled valid for the other readers
+   * it is shared with (see SharedDecode): either the sample itself, or
+   * a reference to the ReceivedDataElement storing it.  Both belong to
+   * this reader's allocators, so they are released under its
+   * sample_lock_.
+   */
+  class SharedSample : public OpenDDS::DCPS::RcObject {
+  public:
+    SharedSample(DataReaderImpl_T* reader,
+                 MessageTypeWithAllocator* data,
+                 OpenDDS::DCPS::ReceivedDataElement* element)
+      : reader_(OpenDDS::DCPS::rchandle_from(reader))
+      , data_(data)
+      , element_(element)
+    {
+    }
+
+    ~SharedSample()
+    {
+      ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, reader_->sample_lock_);
+      data_.reset();
+      if (element_) {
+        element_->dec_ref();
+      }
+    }
+
+  private:
+    OpenDDS::DCPS::RcHandle<DataReaderImpl_T> reader_;
+    unique_ptr<MessageTypeWithAllocator> data_;
+    OpenDDS::DCPS::ReceivedDataElement* element_;
+  };
+
+  void share_sample(const OpenDDS::DCPS::ReceivedDataSample& sample,
+                    OpenDDS::DCPS::MarshalingType marshaling_type,
+                    const MessageType* data,
+                    const OpenDDS::DCPS::RcHandle<SharedSample>& keeper)
+  {
+    sample.shared_decode_->store(TraitsType::type_name(),
+                                 marshaling_type == OpenDDS::DCPS::KEY_ONLY_MARSHALING,
+                                 data, keeper);
+  }
+
+  /// The payload of @a sample as another reader of this type it was
+  /// delivered to demarshaled it (see SharedDecode), or demarshaled into
+  /// @a data, in which case @a share is set if the readers that follow
+  /// could use it.  Returns 0 if it can't be demarshaled.
+  const MessageType* demarshal_sample(const OpenDDS::DCPS::ReceivedDataSample& sample,
+                                      OpenDDS::DCPS::MarshalingType marshaling_type,
+                                      MessageType& data,
+                                      bool& share,
+                                      const char* caller)
+  {
+    const bool key_only = marshaling_type == OpenDDS::DCPS::KEY_ONLY_MARSHALING;
+
+    share = false;
+    OpenDDS::DCPS::SharedDecode* const shared = sample.shared_decode_.in();
+    if (shared) {
+      const void* const found = shared->find(TraitsType::type_name(), key_only);
+      if (found) {
+        return static_cast<const MessageType*>(found);
+      }
+      share = shared->usable(TraitsType::type_name(), key_only);
+    }
+
     const bool cdr = sample.header_.cdr_encapsulation_;
 
     OpenDDS::DCPS::Serializer ser(
@@ -987,10 +1076,10 @@ protected:
     if (cdr) {
       ACE_CDR::ULong header;
       if (!(ser >> header)) {
-        ACE_ERROR((LM_ERROR, ACE_TEXT("(%P|%t) %CDataReaderImpl::dds_demarshal ")
+        ACE_ERROR((LM_ERROR, ACE_TEXT("(%P|%t) %CDataReaderImpl::%C ")
                   ACE_TEXT("deserialization header failed, dropping sample.\n"),
-                  TraitsType::type_name()));
-        return;
+                  TraitsType::type_name(), caller));
+        return 0;
       }
 
       if (Serializer::use_rti_serialization()) {
@@ -999,34 +1088,20 @@ protected:
       }
     }
 
-    if (marshaling_type == OpenDDS::DCPS::KEY_ONLY_MARSHALING) {
-      ser >> OpenDDS::DCPS::KeyOnly< MessageType>(*data);
+    if (key_only) {
+      ser >> OpenDDS::DCPS::KeyOnly< MessageType>(data);
     } else {
-      ser >> *data;
+      ser >> data;
     }
 
     if (!ser.good_bit()) {
-      ACE_ERROR((LM_ERROR, ACE_TEXT("(%P|%t) %CDataReaderImpl::dds_demarshal ")
+      ACE_ERROR((LM_ERROR, ACE_TEXT("(%P|%t) %CDataReaderImpl::%C ")
                  ACE_TEXT("deserialization failed, dropping sample.\n"),
-                 TraitsType::type_name()));
-      return;
-    }
-
-#ifndef OPENDDS_NO_CONTENT_FILTERED_TOPIC
-    if (!sample.header_.content_filter_) { // if this is true, the writer has already filtered
-      using OpenDDS::DCPS::ContentFilteredTopicImpl;
-      if (content_filtered_topic_) {
-        const bool sample_only_has_key_fields = !sample.header_.valid_data();
-        const MessageType& type = static_cast<MessageType&>(*data);
-        if (!content_filtered_topic_->filter(type, sample_only_has_key_fields)) {
-          filtered = true;
-          return;
-        }
-      }
+                 TraitsType::type_name(), caller));
+      return 0;
     }
-#endif
 
-    store_instance_data(move(data), sample.header_, instance, just_registered, filtered);
+    return &data;
   }
 
   virtual void dispose_unregister(const OpenDDS::DCPS::ReceivedDataSample& sample,
@@ -1461,12 +1536,16 @@ DDS::ReturnCode_t take_next_instance_i(MessageSequenceType& received_data,
   return DDS::RETCODE_NO_DATA;
 }
 
+/// If @a stored is given and the sample is stored, it is set to the
+/// ReceivedDataElement storing it, which the caller then holds a
+/// reference to.
 void store_instance_data(
                          unique_ptr<MessageTypeWithAllocator> instance_data,
                          const OpenDDS::DCPS::DataSampleHeader& header,
                          OpenDDS::DCPS::SubscriptionInstance_rch& instance_ptr,
                          bool& just_registered,
-                         bool& filtered)
+                         bool& filtered,
+                         OpenDDS::DCPS::ReceivedDataElement** stored = 0)
 {
   const bool is_dispose_msg =
     header.message_id_ == OpenDDS::DCPS::DISPOSE_INSTANCE ||
@@ -1661,7 +1740,7 @@ void store_instance_data(
       }
     }
 
-    finish_store_instance_data(move(instance_data), header, instance_ptr, is_dispose_msg, is_unregister_msg);
+    finish_store_instance_data(move(instance_data), header, instance_ptr, is_dispose_msg, is_unregister_msg, stored);
   }
   else
   {
@@ -1671,7 +1750,8 @@ void store_instance_data(
 }
 
 void finish_store_instance_data(unique_ptr<MessageTypeWithAllocator> instance_data, const DataSampleHeader& header,
-  SubscriptionInstance_rch instance_ptr, bool is_dispose_msg, bool is_unregister_msg )
+  SubscriptionInstance_rch instance_ptr, bool is_dispose_msg, bool is_unregister_msg,
+  OpenDDS::DCPS::ReceivedDataElement** stored = 0)
 {
   if ((this->qos_.resource_limits.max_samples_per_instance !=
         DDS::LENGTH_UNLIMITED) &&
@@ -1806,6 +1886,12 @@ void finish_store_instance_data(unique_ptr<MessageTypeWithAllocator> instance_da
   OpenDDS::DCPS::ReceivedDataElement *ptr =
     new (*rd_allocator_.get()) OpenDDS::DCPS::ReceivedDataElementWithType<MessageTypeWithAllocator>(header,instance_data.release(), &this->sample_lock_);
 
+  if (stored) {
+    // Referenced before sample_lock_ is released for the listeners below.
+    ptr->inc_ref();
+    *stored = ptr;
+  }
+
   ptr->disposed_generation_count_ =
     instance_ptr->instance_state_->disposed_generation_count();
   ptr->no_writers_generation_count_ =
@@ -219,6 +219,7 @@ DataSampleHeader::init(ACE_Message_Block* buffer)
 
   this->cdr_encapsulation_ = byte & mask_flag(CDR_ENCAP_FLAG);
   this->key_fields_only_   = byte & mask_flag(KEY_ONLY_FLAG);
+  this->compressed_        = byte & mask_flag(COMPRESSED_FLAG);
 
   if (!(reader >> this->message_length_)) {
     return;
@@ -304,6 +305,7 @@ operator<<(ACE_Message_Block& buffer, const DataSampleHeader& value)
 
   flags = (value.cdr_encapsulation_ << CDR_ENCAP_FLAG)
         | (value.key_fields_only_   << KEY_ONLY_FLAG)
+        | (value.compressed_        << COMPRESSED_FLAG)
         ;
   writer << ACE_OutputCDR::from_octet(flags);
 
@@ -565,6 +567,7 @@ OPENDDS_STRING to_string(const DataSampleHeader& value)
     if (value.more_fragments_ == 1) ret += "More Fragments, ";
     if (value.cdr_encapsulation_ == 1) ret += "CDR Encapsulation, ";
     if (value.key_fields_only_ == 1) ret += "Key Fields Only, ";
+    if (value.compressed_ == 1) ret += "Compressed, ";
 
     ret += "Sequence: 0x";
     ret += to_dds_string(unsigned(value.sequence_.getValue()), true);
@@ -705,6 +708,7 @@ std::ostream& operator<<(std::ostream& str, const DataSampleHeader& value)
     if (value.more_fragments_ == 1) str << "More Fragments, ";
     if (value.cdr_encapsulation_ == 1) str << "CDR Encapsulation, ";
     if (value.key_fields_only_ == 1) str << "Key Fields Only, ";
+    if (value.compressed_ == 1) str << "Compressed, ";
 
     str << "Sequence: 0x" << std::hex << std::setw(4) << std::setfill('0')
         << value.sequence_.getValue() << ", ";
@@ -66,7 +66,8 @@ enum DataSampleHeaderFlag {
 
 enum DataSampleHeaderFlag2 {
   CDR_ENCAP_FLAG,
-  KEY_ONLY_FLAG
+  KEY_ONLY_FLAG,
+  COMPRESSED_FLAG
 };
 
 /// The header message of a data sample.
@@ -127,7 +128,10 @@ struct OpenDDS_Dcps_Export DataSampleHeader : public PoolAllocationBase {
   /// Only the key fields of the data sample are present in the payload.
   bool key_fields_only_ : 1;
 
-  bool reserved_1 : 1;
+  /// The payload was compressed by the transport (see Compressor.h) and
+  /// message_length_ is its compressed size.
+  bool compressed_ : 1;
+
   bool reserved_2 : 1;
   bool reserved_3 : 1;
   bool reserved_4 : 1;
@@ -19,7 +19,7 @@ OpenDDS::DCPS::DataSampleHeader::DataSampleHeader()
   , more_fragments_(0)
   , cdr_encapsulation_(0)
   , key_fields_only_(0)
-  , reserved_1(0)
+  , compressed_(0)
   , reserved_2(0)
   , reserved_3(0)
   , reserved_4(0)
@@ -51,7 +51,7 @@ OpenDDS::DCPS::DataSampleHeader::DataSampleHeader(ACE_Message_Block& buffer)
   , more_fragments_(0)
   , cdr_encapsulation_(0)
   , key_fields_only_(0)
-  , reserved_1(0)
+  , compressed_(0)
   , reserved_2(0)
   , reserved_3(0)
   , reserved_4(0)
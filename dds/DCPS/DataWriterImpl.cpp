@@ -1957,6 +1957,23 @@ DataWriterImpl::get_publication_id()
   return publication_id_;
 }
 
+Priority
+DataWriterImpl::transport_priority() const
+{
+  return get_priority_value(AssociationData());
+}
+
+ACE_Time_Value
+DataWriterImpl::max_blocking_time() const
+{
+  const DDS::Duration_t& duration = qos_.reliability.max_blocking_time;
+  if (duration.sec == DDS::DURATION_INFINITE_SEC &&
+      duration.nanosec == DDS::DURATION_INFINITE_NSEC) {
+    return ACE_Time_Value::max_time;
+  }
+  return duration_to_time_value(duration);
+}
+
 RepoId
 DataWriterImpl::get_dp_id()
 {
@@ -559,6 +559,10 @@ private:
     return this->qos_.transport_priority.value;
   }
 
+  Priority transport_priority() const;
+
+  ACE_Time_Value max_blocking_time() const;
+
 #if defined(OPENDDS_SECURITY)
   DDS::Security::ParticipantCryptoHandle get_crypto_handle() const;
 #endif
@@ -12,6 +12,7 @@
 #include "dds/DCPS/DCPS_Utils.h"
 #include "dds/DCPS/Discovery.h"
 #include "dds/DCPS/DomainParticipantImpl.h"
+#include "dds/DCPS/EndpointMatchKey.h"
 #include "dds/DCPS/GuidUtils.h"
 #include "dds/DCPS/Marked_Default_Qos.h"
 #include "dds/DCPS/PoolAllocationBase.h"
@@ -140,6 +141,7 @@ namespace OpenDDS {
 
         OpenDDS::DCPS::DiscoveredReaderData reader_data_;
         DDS::InstanceHandle_t bit_ih_;
+        EndpointMatchKey match_key_;
 
 #ifdef OPENDDS_SECURITY
         DDS::Security::EndpointSecurityAttributes security_attribs_;
@@ -174,6 +176,7 @@ namespace OpenDDS {
 
         OpenDDS::DCPS::DiscoveredWriterData writer_data_;
         DDS::InstanceHandle_t bit_ih_;
+        EndpointMatchKey match_key_;
 
 #ifdef OPENDDS_SECURITY
         DDS::Security::EndpointSecurityAttributes security_attribs_;
@@ -639,6 +642,10 @@ namespace OpenDDS {
         RepoIdSet matched_endpoints_;
         DCPS::SequenceNumber sequence_;
         RepoIdSet remote_expectant_opendds_associations_;
+        EndpointMatchKey match_key_;
+        /// The last discovery sample serialized for the endpoint, which is
+        /// sent again to each newly discovered reader until it changes.
+        OPENDDS_VECTOR(char) serialized_;
 #ifdef OPENDDS_SECURITY
         bool have_ice_agent_info;
         ICE::AgentInfo ice_agent_info;
@@ -747,8 +754,15 @@ namespace OpenDDS {
                            bool remove = false)
       {
         const bool reader = repoId.entityId.entityKind & 4;
+        // Only local endpoints have associations to remove, and a
+        // discovered endpoint is only matched with local ones.
+        const bool all = !remove && is_local_endpoint(repoId);
         // Copy the endpoint set - lock can be released in match()
-        RepoIdSet endpoints_copy = td.endpoints();
+        RepoIdSet endpoints_copy = all ? td.endpoints() : td.local_endpoints();
+
+        if (!remove) {
+          refresh_match_key(repoId);
+        }
 
         for (RepoIdSet::const_iterator iter = endpoints_copy.begin();
              iter != endpoints_copy.end(); ++iter) {
@@ -757,12 +771,93 @@ namespace OpenDDS {
             if (remove) {
               remove_assoc(*iter, repoId);
             } else {
-              match(reader ? *iter : repoId, reader ? repoId : *iter);
+              const RepoId& writer = reader ? *iter : repoId;
+              const RepoId& rdr = reader ? repoId : *iter;
+              if (!excluded(writer, rdr)) {
+                match(writer, rdr);
+              }
             }
           }
         }
       }
 
+      bool is_local_endpoint(const RepoId& endpoint) const
+      {
+        return (endpoint.entityId.entityKind & 4) ?
+          local_subscriptions_.count(endpoint) != 0 :
+          local_publications_.count(endpoint) != 0;
+      }
+
+      /// Update the EndpointMatchKey of @a endpoint from its current QoS.
+      void refresh_match_key(const RepoId& endpoint)
+      {
+        if (endpoint.entityId.entityKind & 4) {
+          const LocalSubscriptionIter lsi = local_subscriptions_.find(endpoint);
+          if (lsi != local_subscriptions_.end()) {
+            lsi->second.match_key_.set(lsi->second.qos_, lsi->second.subscriber_qos_,
+                                       lsi->second.trans_info_);
+            return;
+          }
+          const DiscoveredSubscriptionIter dsi = discovered_subscriptions_.find(endpoint);
+          if (dsi != discovered_subscriptions_.end()) {
+            dsi->second.match_key_.set(dsi->second.reader_data_.ddsSubscriptionData,
+                                       dsi->second.reader_data_.readerProxy.allLocators);
+          }
+        } else {
+          const LocalPublicationIter lpi = local_publications_.find(endpoint);
+          if (lpi != local_publications_.end()) {
+            lpi->second.match_key_.set(lpi->second.qos_, lpi->second.publisher_qos_,
+                                       lpi->second.trans_info_);
+            return;
+          }
+          const DiscoveredPublicationIter dpi = discovered_publications_.find(endpoint);
+          if (dpi != discovered_publications_.end()) {
+            dpi->second.match_key_.set(dpi->second.writer_data_.ddsPublicationData,
+                                       dpi->second.writer_data_.writerProxy.allLocators);
+          }
+        }
+      }
+
+      const EndpointMatchKey* match_key(const RepoId& endpoint) const
+      {
+        if (endpoint.entityId.entityKind & 4) {
+          const LocalSubscriptionCIter lsi = local_subscriptions_.find(endpoint);
+          if (lsi != local_subscriptions_.end()) {
+            return &lsi->second.match_key_;
+          }
+          const typename DiscoveredSubscriptionMap::const_iterator dsi =
+            discovered_subscriptions_.find(endpoint);
+          return dsi == discovered_subscriptions_.end() ? 0 : &dsi->second.match_key_;
+        }
+        const LocalPublicationCIter lpi = local_publications_.find(endpoint);
+        if (lpi != local_publications_.end()) {
+          return &lpi->second.match_key_;
+        }
+        const typename DiscoveredPublicationMap::const_iterator dpi =
+          discovered_publications_.find(endpoint);
+        return dpi == discovered_publications_.end() ? 0 : &dpi->second.match_key_;
+      }
+
+      /// True if match() of @a writer and @a reader can be skipped: they
+      /// aren't matched and their match keys show they can't be, without
+      /// an incompatible QoS to report.
+      bool excluded(const RepoId& writer, const RepoId& reader) const
+      {
+        const EndpointMatchKey* const writer_key = match_key(writer);
+        const EndpointMatchKey* const reader_key = match_key(reader);
+        if (!writer_key || !reader_key ||
+            !EndpointMatchKey::excluded(*writer_key, *reader_key)) {
+          return false;
+        }
+        // An existing association has to be broken by match().
+        const LocalPublicationCIter lpi = local_publications_.find(writer);
+        if (lpi != local_publications_.end() && lpi->second.matched_endpoints_.count(reader)) {
+          return false;
+        }
+        const LocalSubscriptionCIter lsi = local_subscriptions_.find(reader);
+        return lsi == local_subscriptions_.end() || !lsi->second.matched_endpoints_.count(writer);
+      }
+
       void
       remove_assoc(const RepoId& remove_from,
                    const RepoId& removing)
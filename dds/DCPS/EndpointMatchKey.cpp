@@ -0,0 +1,166 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "DCPS/DdsDcps_pch.h" //Only the _pch include should start with DCPS/
+#include "EndpointMatchKey.h"
+#include "Qos_Helper.h"
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+EndpointMatchKey::EndpointMatchKey()
+  : valid_(false)
+  , transports_known_(false)
+  , reliability_(DDS::BEST_EFFORT_RELIABILITY_QOS)
+  , durability_(DDS::VOLATILE_DURABILITY_QOS)
+  , liveliness_(DDS::AUTOMATIC_LIVELINESS_QOS)
+  , ownership_(DDS::SHARED_OWNERSHIP_QOS)
+  , access_scope_(DDS::INSTANCE_PRESENTATION_QOS)
+  , coherent_access_(false)
+  , ordered_access_(false)
+{
+  lease_duration_.sec = lease_duration_.nanosec = 0;
+  deadline_ = latency_budget_ = lease_duration_;
+}
+
+void
+EndpointMatchKey::set(const DDS::DataWriterQos& qos,
+                      const DDS::PublisherQos& publisher_qos,
+                      const TransportLocatorSeq& trans_info)
+{
+  valid_ = true;
+  reliability_ = qos.reliability.kind;
+  durability_ = qos.durability.kind;
+  liveliness_ = qos.liveliness.kind;
+  lease_duration_ = qos.liveliness.lease_duration;
+  deadline_ = qos.deadline.period;
+  latency_budget_ = qos.latency_budget.duration;
+  ownership_ = qos.ownership.kind;
+  access_scope_ = publisher_qos.presentation.access_scope;
+  coherent_access_ = publisher_qos.presentation.coherent_access;
+  ordered_access_ = publisher_qos.presentation.ordered_access;
+  partition_ = PartitionMatcher::instance()->compile(publisher_qos.partition);
+  set_transports(trans_info);
+  transports_known_ = true;
+}
+
+void
+EndpointMatchKey::set(const DDS::DataReaderQos& qos,
+                      const DDS::SubscriberQos& subscriber_qos,
+                      const TransportLocatorSeq& trans_info)
+{
+  valid_ = true;
+  reliability_ = qos.reliability.kind;
+  durability_ = qos.durability.kind;
+  liveliness_ = qos.liveliness.kind;
+  lease_duration_ = qos.liveliness.lease_duration;
+  deadline_ = qos.deadline.period;
+  latency_budget_ = qos.latency_budget.duration;
+  ownership_ = qos.ownership.kind;
+  access_scope_ = subscriber_qos.presentation.access_scope;
+  coherent_access_ = subscriber_qos.presentation.coherent_access;
+  ordered_access_ = subscriber_qos.presentation.ordered_access;
+  partition_ = PartitionMatcher::instance()->compile(subscriber_qos.partition);
+  set_transports(trans_info);
+  transports_known_ = true;
+}
+
+void
+EndpointMatchKey::set(const DDS::PublicationBuiltinTopicData& data,
+                      const TransportLocatorSeq& locators)
+{
+  valid_ = true;
+  reliability_ = data.reliability.kind;
+  durability_ = data.durability.kind;
+  liveliness_ = data.liveliness.kind;
+  lease_duration_ = data.liveliness.lease_duration;
+  deadline_ = data.deadline.period;
+  latency_budget_ = data.latency_budget.duration;
+  ownership_ = data.ownership.kind;
+  access_scope_ = data.presentation.access_scope;
+  coherent_access_ = data.presentation.coherent_access;
+  ordered_access_ = data.presentation.ordered_access;
+  partition_ = PartitionMatcher::instance()->compile(data.partition);
+  set_transports(locators);
+  transports_known_ = locators.length() != 0;
+}
+
+void
+EndpointMatchKey::set(const DDS::SubscriptionBuiltinTopicData& data,
+                      const TransportLocatorSeq& locators)
+{
+  valid_ = true;
+  reliability_ = data.reliability.kind;
+  durability_ = data.durability.kind;
+  liveliness_ = data.liveliness.kind;
+  lease_duration_ = data.liveliness.lease_duration;
+  deadline_ = data.deadline.period;
+  latency_budget_ = data.latency_budget.duration;
+  ownership_ = data.ownership.kind;
+  access_scope_ = data.presentation.access_scope;
+  coherent_access_ = data.presentation.coherent_access;
+  ordered_access_ = data.presentation.ordered_access;
+  partition_ = PartitionMatcher::instance()->compile(data.partition);
+  set_transports(locators);
+  transports_known_ = locators.length() != 0;
+}
+
+void
+EndpointMatchKey::set_transports(const TransportLocatorSeq& trans_info)
+{
+  transport_types_.clear();
+  for (CORBA::ULong i = 0; i < trans_info.length(); ++i) {
+    transport_types_.push_back(trans_info[i].transport_type.in());
+  }
+}
+
+bool
+EndpointMatchKey::compatible(const EndpointMatchKey& writer,
+                             const EndpointMatchKey& reader)
+{
+  if (!writer.transports_known_ || !reader.transports_known_) {
+    return false;
+  }
+
+  bool common_transport = false;
+  for (size_t i = 0; !common_transport && i < writer.transport_types_.size(); ++i) {
+    for (size_t j = 0; !common_transport && j < reader.transport_types_.size(); ++j) {
+      common_transport = writer.transport_types_[i] == reader.transport_types_[j];
+    }
+  }
+
+  // The same comparisons as compatibleQOS(), in the same order.
+  using OpenDDS::DCPS::operator>;
+  using OpenDDS::DCPS::operator<;
+  return common_transport &&
+    writer.reliability_ >= reader.reliability_ &&
+    writer.durability_ >= reader.durability_ &&
+    writer.liveliness_ >= reader.liveliness_ &&
+    !(writer.lease_duration_ > reader.lease_duration_) &&
+    !(writer.deadline_ > reader.deadline_) &&
+    !(reader.latency_budget_ < writer.latency_budget_) &&
+    writer.ownership_ == reader.ownership_ &&
+    writer.access_scope_ >= reader.access_scope_ &&
+    (writer.coherent_access_ || !reader.coherent_access_) &&
+    (writer.ordered_access_ || !reader.ordered_access_);
+}
+
+bool
+EndpointMatchKey::excluded(const EndpointMatchKey& writer,
+                           const EndpointMatchKey& reader)
+{
+  return writer.valid_ && reader.valid_ &&
+    !PartitionMatcher::instance()->match(*writer.partition_, *reader.partition_) &&
+    compatible(writer, reader);
+}
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,92 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_DCPS_ENDPOINTMATCHKEY_H
+#define OPENDDS_DCPS_ENDPOINTMATCHKEY_H
+
+#include "dcps_export.h"
+#include "dds/DCPS/PartitionMatcher.h"
+#include "dds/DCPS/PoolAllocator.h"
+#include "dds/DdsDcpsCoreC.h"
+#include "dds/DdsDcpsInfoUtilsC.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+#pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+/**
+ * @class EndpointMatchKey
+ *
+ * @brief What discovery needs of an endpoint to tell, without building
+ *        its full QoS, that it can't be matched with another one.
+ *
+ * The key holds the request/offered (RxO) policies compatibleQOS()
+ * compares, the endpoint's partitions compiled by PartitionMatcher and
+ * the types of its transports.
+ * EndpointManager refreshes it each time the endpoint is added or
+ * updated, and skips the pairs excluded() by their keys.
+ */
+class OpenDDS_Dcps_Export EndpointMatchKey {
+public:
+  EndpointMatchKey();
+
+  void set(const DDS::DataWriterQos& qos, const DDS::PublisherQos& publisher_qos,
+           const TransportLocatorSeq& trans_info);
+  void set(const DDS::DataReaderQos& qos, const DDS::SubscriberQos& subscriber_qos,
+           const TransportLocatorSeq& trans_info);
+
+  /// Discovered endpoints without locators get the default ones of their
+  /// participant while matching, so their transports are not known yet.
+  void set(const DDS::PublicationBuiltinTopicData& data,
+           const TransportLocatorSeq& locators);
+  void set(const DDS::SubscriptionBuiltinTopicData& data,
+           const TransportLocatorSeq& locators);
+
+  bool valid() const { return valid_; }
+
+  /// True if the RxO policies and transports of @a writer and @a reader
+  /// are compatible, so compatibleQOS() wouldn't report an incompatible
+  /// QoS for them.
+  static bool compatible(const EndpointMatchKey& writer,
+                         const EndpointMatchKey& reader);
+
+  /// True if @a writer and @a reader can't be matched and matching them
+  /// wouldn't report an incompatible QoS either: they are compatible but
+  /// have no partition in common.  False if either key isn't valid().
+  static bool excluded(const EndpointMatchKey& writer,
+                       const EndpointMatchKey& reader);
+
+private:
+  void set_transports(const TransportLocatorSeq& trans_info);
+
+  bool valid_;
+  bool transports_known_;
+  DDS::ReliabilityQosPolicyKind reliability_;
+  DDS::DurabilityQosPolicyKind durability_;
+  DDS::LivelinessQosPolicyKind liveliness_;
+  DDS::Duration_t lease_duration_;
+  DDS::Duration_t deadline_;
+  DDS::Duration_t latency_budget_;
+  DDS::OwnershipQosPolicyKind ownership_;
+  DDS::PresentationQosPolicyAccessScopeKind access_scope_;
+  bool coherent_access_;
+  bool ordered_access_;
+  PartitionMatcher::Partitions_rch partition_;
+  OPENDDS_VECTOR(OPENDDS_STRING) transport_types_;
+};
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* OPENDDS_DCPS_ENDPOINTMATCHKEY_H */
@@ -51,6 +51,16 @@ DataReaderRemoteImpl::add_association(const RepoId& yourId,
   }
 }
 
+void
+DataReaderRemoteImpl::add_associations(const RepoId& yourId,
+                                       const WriterAssociationSeq& writers,
+                                       bool active)
+{
+  for (CORBA::ULong i = 0; i < writers.length(); ++i) {
+    add_association(yourId, writers[i], active);
+  }
+}
+
 void
 DataReaderRemoteImpl::association_complete(const RepoId& remote_id)
 {
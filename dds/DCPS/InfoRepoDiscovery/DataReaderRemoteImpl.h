@@ -43,6 +43,10 @@ public:
                                const WriterAssociation& writer,
                                bool active);
 
+  virtual void add_associations(const RepoId& yourId,
+                                const WriterAssociationSeq& writers,
+                                bool active);
+
   virtual void association_complete(const RepoId& remote_id);
 
   virtual void remove_associations(const WriterIdSeq& writers,
@@ -51,6 +51,16 @@ DataWriterRemoteImpl::add_association(const RepoId& yourId,
   }
 }
 
+void
+DataWriterRemoteImpl::add_associations(const RepoId& yourId,
+                                       const ReaderAssociationSeq& readers,
+                                       bool active)
+{
+  for (CORBA::ULong i = 0; i < readers.length(); ++i) {
+    add_association(yourId, readers[i], active);
+  }
+}
+
 void
 DataWriterRemoteImpl::association_complete(const RepoId& remote_id)
 {
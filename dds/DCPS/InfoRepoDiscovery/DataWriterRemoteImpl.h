@@ -39,6 +39,10 @@ public:
                                const ReaderAssociation& readers,
                                bool active);
 
+  virtual void add_associations(const RepoId& yourId,
+                                const ReaderAssociationSeq& readers,
+                                bool active);
+
   virtual void association_complete(const RepoId& remote_id);
 
   virtual void remove_associations(const ReaderIdSeq& readers,
@@ -0,0 +1,278 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "DCPS/DdsDcps_pch.h" //Only the _pch include should start with DCPS/
+#include "PartitionMatcher.h"
+
+#include "ace/Guard_T.h"
+#include "ace/OS_NS_string.h"
+
+#include <algorithm>
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+namespace {
+
+bool
+is_wildcard(const char *str)
+{
+  static const char wild[] = "?*[";
+
+  while (*str) {
+    size_t i = ACE_OS::strcspn(str, wild);
+
+    if (!str[i]) return false; // no wildcard
+
+    if (i > 0 && str[i-1] == '\\') str += i + 1; // escaped wildcard
+
+    else return true;
+  }
+
+  return false;
+}
+
+bool
+contains(const OPENDDS_VECTOR(OPENDDS_STRING)& sorted, const OPENDDS_STRING& name)
+{
+  return std::binary_search(sorted.begin(), sorted.end(), name);
+}
+
+}
+
+PartitionMatcher::Pattern::Pattern(const char* pattern)
+{
+  for (const char* p = pattern; *p; ++p) {
+    Token token = { CHAR, *p, 0 };
+    if (*p == '\\' && p[1]) {
+      token.c_ = *++p;
+    } else if (*p == '*') {
+      if (!tokens_.empty() && tokens_.back().kind_ == STAR) {
+        continue;
+      }
+      token.kind_ = STAR;
+    } else if (*p == '?') {
+      token.kind_ = ANY;
+    } else if (*p == '[') {
+      // [abc], [a-z] or [!abc]; a ']' right after the '[' or '!' is one
+      // of the characters.  Without a closing ']' the '[' is literal.
+      const char* q = p + 1;
+      const bool negate = *q == '!';
+      if (negate) {
+        ++q;
+      }
+      std::bitset<256> chars;
+      const char* const first = q;
+      for (; *q && (*q != ']' || q == first); ++q) {
+        const unsigned char c = static_cast<unsigned char>(*q);
+        if (q[1] == '-' && q[2] && q[2] != ']') {
+          for (unsigned int r = c; r <= static_cast<unsigned char>(q[2]); ++r) {
+            chars.set(r);
+          }
+          q += 2;
+        } else {
+          chars.set(c);
+        }
+      }
+      if (*q == ']') {
+        if (negate) {
+          chars.flip();
+        }
+        token.kind_ = CLASS;
+        token.class_ = classes_.size();
+        classes_.push_back(chars);
+        p = q;
+      }
+    }
+    tokens_.push_back(token);
+  }
+}
+
+bool
+PartitionMatcher::Pattern::matches(const char* name) const
+{
+  // Backtracks to the last '*' only, which is enough for patterns made of
+  // '*' and single characters.
+  const size_t n_tokens = tokens_.size();
+  size_t t = 0;
+  const char* s = name;
+  size_t star = n_tokens;
+  const char* star_s = 0;
+  while (*s) {
+    if (t < n_tokens) {
+      const Token& token = tokens_[t];
+      if (token.kind_ == STAR) {
+        star = t++;
+        star_s = s;
+        continue;
+      }
+      if (token.kind_ == ANY ||
+          (token.kind_ == CHAR && token.c_ == *s) ||
+          (token.kind_ == CLASS && classes_[token.class_].test(static_cast<unsigned char>(*s)))) {
+        ++t;
+        ++s;
+        continue;
+      }
+    }
+    if (star == n_tokens) {
+      return false;
+    }
+    t = star + 1;
+    s = ++star_s;
+  }
+  while (t < n_tokens && tokens_[t].kind_ == STAR) {
+    ++t;
+  }
+  return t == n_tokens;
+}
+
+PartitionMatcher::Partitions::Partitions(const OPENDDS_VECTOR(OPENDDS_STRING)& names)
+  : empty_(names.empty())
+  , default_(names.empty())
+  , id_(0)
+{
+  for (size_t i = 0; i < names.size(); ++i) {
+    if (names[i].empty()) {
+      default_ = true;
+    }
+    if (is_wildcard(names[i].c_str())) {
+      patterns_.push_back(Pattern(names[i].c_str()));
+    } else {
+      literals_.push_back(names[i]);
+    }
+  }
+  // names is sorted, so literals_ is too.
+}
+
+PartitionMatcher::PartitionMatcher()
+  : next_id_(0)
+{
+}
+
+PartitionMatcher*
+PartitionMatcher::instance()
+{
+  return ACE_Singleton<PartitionMatcher, ACE_SYNCH_MUTEX>::instance();
+}
+
+PartitionMatcher::Partitions_rch
+PartitionMatcher::compile(const DDS::PartitionQosPolicy& qos)
+{
+  OPENDDS_VECTOR(OPENDDS_STRING) names;
+  names.reserve(qos.name.length());
+  for (CORBA::ULong i = 0; i < qos.name.length(); ++i) {
+    names.push_back(qos.name[i].in());
+  }
+  std::sort(names.begin(), names.end());
+  names.erase(std::unique(names.begin(), names.end()), names.end());
+
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, g, lock_, make_rch<Partitions>(names));
+  const CompiledMap::iterator pos = compiled_.find(names);
+  if (pos != compiled_.end()) {
+    return pos->second;
+  }
+  if (compiled_.size() >= MAX_CACHED) {
+    compiled_.clear();
+  }
+  Partitions_rch partitions = make_rch<Partitions>(names);
+  partitions->id_ = ++next_id_;
+  compiled_[names] = partitions;
+  return partitions;
+}
+
+bool
+PartitionMatcher::match(const Partitions& pub, const Partitions& sub)
+{
+  if (pub.default_ && sub.default_) {
+    return true;
+  }
+  if (!pub.id_ || !sub.id_) {
+    return match_i(pub, sub);
+  }
+
+  const IdPair key(pub.id_, sub.id_);
+  {
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, g, lock_, match_i(pub, sub));
+    const ResultMap::const_iterator pos = results_.find(key);
+    if (pos != results_.end()) {
+      return pos->second;
+    }
+  }
+
+  const bool result = match_i(pub, sub);
+
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, g, lock_, result);
+  if (results_.size() >= MAX_CACHED) {
+    results_.clear();
+  }
+  results_[key] = result;
+  return result;
+}
+
+bool
+PartitionMatcher::match(const DDS::PartitionQosPolicy& pub,
+                        const DDS::PartitionQosPolicy& sub)
+{
+  const Partitions_rch pub_partitions = compile(pub);
+  const Partitions_rch sub_partitions = compile(sub);
+  return match(*pub_partitions, *sub_partitions);
+}
+
+bool
+PartitionMatcher::match_i(const Partitions& pub, const Partitions& sub)
+{
+  if (pub.default_ && sub.default_) {
+    return true;
+  }
+
+  if (pub.empty_) {
+    // A publisher without partitions is in the default partition, which
+    // the subscriber's patterns can match.
+    for (size_t i = 0; i < sub.patterns_.size(); ++i) {
+      if (sub.patterns_[i].matches("")) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Look up the names of the shorter list in the longer one.
+  const OPENDDS_VECTOR(OPENDDS_STRING)& pub_literals = pub.literals_;
+  const bool pub_shorter = pub_literals.size() < sub.literals_.size();
+  const OPENDDS_VECTOR(OPENDDS_STRING)& shorter = pub_shorter ? pub_literals : sub.literals_;
+  const OPENDDS_VECTOR(OPENDDS_STRING)& longer = pub_shorter ? sub.literals_ : pub_literals;
+  for (size_t i = 0; i < shorter.size(); ++i) {
+    if (contains(longer, shorter[i])) {
+      return true;
+    }
+  }
+
+  for (size_t i = 0; i < pub.patterns_.size(); ++i) {
+    for (size_t j = 0; j < sub.literals_.size(); ++j) {
+      if (pub.patterns_[i].matches(sub.literals_[j].c_str())) {
+        return true;
+      }
+    }
+  }
+
+  for (size_t i = 0; i < sub.patterns_.size(); ++i) {
+    for (size_t j = 0; j < pub_literals.size(); ++j) {
+      if (sub.patterns_[i].matches(pub_literals[j].c_str())) {
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,127 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_DCPS_PARTITIONMATCHER_H
+#define OPENDDS_DCPS_PARTITIONMATCHER_H
+
+#include "dcps_export.h"
+#include "dds/DCPS/PoolAllocator.h"
+#include "dds/DCPS/RcObject.h"
+#include "dds/DCPS/RcHandle_T.h"
+#include "dds/DdsDcpsCoreC.h"
+
+#include "ace/Singleton.h"
+#include "ace/Thread_Mutex.h"
+
+#include <bitset>
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+#pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+/**
+ * @class PartitionMatcher
+ *
+ * @brief Matches the partitions of publishers and subscribers.
+ *
+ * Each partition list is compiled once into a sorted list of its
+ * literal names and a list of its wildcard names compiled to patterns
+ * (the syntax of ACE::wild_match(): '*', '?' and '[...]' classes, with
+ * '\' escaping).  Two compiled lists match if they share a literal name,
+ * or a pattern of either one matches a literal name of the other;
+ * two patterns never match, as before.
+ *
+ * Compiled lists are shared by all endpoints with the same partitions,
+ * and the result for each pair of them is cached, so a discovery that
+ * matches many endpoints with the same partitions compares them once.
+ */
+class OpenDDS_Dcps_Export PartitionMatcher {
+  friend class ACE_Singleton<PartitionMatcher, ACE_SYNCH_MUTEX>;
+
+public:
+  /// A wildcard partition name compiled for matching.
+  class OpenDDS_Dcps_Export Pattern {
+  public:
+    explicit Pattern(const char* pattern);
+
+    bool matches(const char* name) const;
+
+  private:
+    enum Kind { CHAR, ANY, STAR, CLASS };
+    struct Token {
+      Kind kind_;
+      char c_;
+      size_t class_;
+    };
+    OPENDDS_VECTOR(Token) tokens_;
+    OPENDDS_VECTOR(std::bitset<256>) classes_;
+  };
+
+  /// A compiled partition list.
+  class OpenDDS_Dcps_Export Partitions : public RcObject {
+  public:
+    explicit Partitions(const OPENDDS_VECTOR(OPENDDS_STRING)& names);
+
+    /// True if the list is empty or has the default (empty) name.
+    bool is_default() const { return default_; }
+
+  private:
+    friend class PartitionMatcher;
+
+    bool empty_;
+    bool default_;
+    /// Sorted.
+    OPENDDS_VECTOR(OPENDDS_STRING) literals_;
+    OPENDDS_VECTOR(Pattern) patterns_;
+    /// Identifies the list in the cache of results; never reused.
+    unsigned long id_;
+  };
+  typedef RcHandle<Partitions> Partitions_rch;
+
+  static PartitionMatcher* instance();
+
+  /// The compiled list of @a qos, shared with any other list of the same
+  /// names.
+  Partitions_rch compile(const DDS::PartitionQosPolicy& qos);
+
+  /// True if a publisher in @a pub and a subscriber in @a sub share a
+  /// partition.
+  bool match(const Partitions& pub, const Partitions& sub);
+
+  bool match(const DDS::PartitionQosPolicy& pub, const DDS::PartitionQosPolicy& sub);
+
+  /// Compare without the cache.
+  static bool match_i(const Partitions& pub, const Partitions& sub);
+
+  /// Most compiled lists and results that are kept before they are all
+  /// dropped.
+  enum { MAX_CACHED = 4096 };
+
+private:
+  PartitionMatcher();
+
+  typedef OPENDDS_MAP(OPENDDS_VECTOR(OPENDDS_STRING), Partitions_rch) CompiledMap;
+  typedef std::pair<unsigned long, unsigned long> IdPair;
+  typedef OPENDDS_MAP(IdPair, bool) ResultMap;
+
+  ACE_Thread_Mutex lock_;
+  CompiledMap compiled_;
+  ResultMap results_;
+  unsigned long next_id_;
+};
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* OPENDDS_DCPS_PARTITIONMATCHER_H */
@@ -0,0 +1,254 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "dds/DCPS/RTPS/DiscoveryCache.h"
+#include "dds/DCPS/RTPS/ParameterListConverter.h"
+#include "dds/DCPS/RTPS/RtpsCoreTypeSupportImpl.h"
+
+#include "dds/DCPS/Serializer.h"
+
+#include "ace/Message_Block.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_sys_stat.h"
+#include "ace/OS_NS_unistd.h"
+
+#include <cstring>
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace RTPS {
+
+namespace {
+  const char MAGIC[4] = { 'O', 'D', 'D', 'C' };
+  const ACE_CDR::ULong VERSION = 1;
+
+  /// Little-endian, as RTPS discovery sends it.
+  const bool swap_bytes = !ACE_CDR_BYTE_ORDER;
+
+  /// Each entry takes at least 4 bytes (a sentinel or a sequence length),
+  /// so a larger count read from a truncated or corrupt file is rejected
+  /// before it is allocated.
+  bool fits(const ACE_Message_Block& mb, ACE_CDR::ULong count)
+  {
+    return count <= mb.length() / 4;
+  }
+
+  template <typename T>
+  bool endpoint_size(const T& data, size_t& size)
+  {
+    ParameterListConverter::ParameterListWriter sizer;
+    if (ParameterListConverter::to_param_list(data, sizer) != 0 || !sizer.finish()) {
+      return false;
+    }
+    size += sizer.size();
+    return true;
+  }
+
+  template <typename T>
+  bool write_endpoints(DCPS::Serializer& ser, const OPENDDS_VECTOR(T)& endpoints)
+  {
+    if (!(ser << static_cast<ACE_CDR::ULong>(endpoints.size()))) {
+      return false;
+    }
+    for (size_t i = 0; i < endpoints.size(); ++i) {
+      ParameterListConverter::ParameterListWriter writer(&ser);
+      if (ParameterListConverter::to_param_list(endpoints[i], writer) != 0 ||
+          !writer.finish()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  template <typename T>
+  bool read_endpoints(DCPS::Serializer& ser, const ACE_Message_Block& mb,
+                      OPENDDS_VECTOR(T)& endpoints)
+  {
+    ACE_CDR::ULong count;
+    if (!(ser >> count) || !fits(mb, count)) {
+      return false;
+    }
+    endpoints.resize(count);
+    for (ACE_CDR::ULong i = 0; i < count; ++i) {
+      if (ParameterListConverter::from_param_list(ser, endpoints[i]) != 0) {
+        return false;
+      }
+    }
+    return true;
+  }
+}
+
+void
+DiscoveryCache::clear()
+{
+  participants_.clear();
+  writers_.clear();
+  readers_.clear();
+}
+
+bool
+DiscoveryCache::to_buffer(OPENDDS_VECTOR(char)& buffer) const
+{
+  // Magic, version and the three counts.
+  size_t size = sizeof MAGIC + 4 * sizeof(ACE_CDR::ULong);
+
+  OPENDDS_VECTOR(ParameterList) participants(participants_.size());
+  for (size_t i = 0; i < participants_.size(); ++i) {
+    if (ParameterListConverter::to_param_list(participants_[i], participants[i]) != 0) {
+      return false;
+    }
+    size_t padding = 0;
+    DCPS::gen_find_size(participants[i], size, padding);
+  }
+  for (size_t i = 0; i < writers_.size(); ++i) {
+    if (!endpoint_size(writers_[i], size)) {
+      return false;
+    }
+  }
+  for (size_t i = 0; i < readers_.size(); ++i) {
+    if (!endpoint_size(readers_[i], size)) {
+      return false;
+    }
+  }
+
+  ACE_Message_Block mb(size);
+  DCPS::Serializer ser(&mb, swap_bytes, DCPS::Serializer::ALIGN_CDR);
+  if (!ser.write_char_array(MAGIC, sizeof MAGIC) || !(ser << VERSION) ||
+      !(ser << static_cast<ACE_CDR::ULong>(participants.size()))) {
+    return false;
+  }
+  for (size_t i = 0; i < participants.size(); ++i) {
+    if (!(ser << participants[i])) {
+      return false;
+    }
+  }
+  if (!write_endpoints(ser, writers_) || !write_endpoints(ser, readers_)) {
+    return false;
+  }
+
+  buffer.assign(mb.rd_ptr(), mb.wr_ptr());
+  return true;
+}
+
+bool
+DiscoveryCache::from_buffer(const char* buffer, size_t size)
+{
+  clear();
+
+  ACE_Message_Block mb(buffer, size);
+  mb.wr_ptr(size);
+  DCPS::Serializer ser(&mb, swap_bytes, DCPS::Serializer::ALIGN_CDR);
+
+  char magic[sizeof MAGIC];
+  ACE_CDR::ULong version, count;
+  if (!ser.read_char_array(magic, sizeof magic) ||
+      std::memcmp(magic, MAGIC, sizeof MAGIC) != 0 ||
+      !(ser >> version) || version != VERSION || !(ser >> count) ||
+      !fits(mb, count)) {
+    return false;
+  }
+
+  participants_.resize(count);
+  for (ACE_CDR::ULong i = 0; i < count; ++i) {
+    ParameterList plist;
+    if (!(ser >> plist) ||
+        ParameterListConverter::from_param_list(plist, participants_[i]) != 0) {
+      clear();
+      return false;
+    }
+  }
+
+  if (!read_endpoints(ser, mb, writers_) || !read_endpoints(ser, mb, readers_)) {
+    clear();
+    return false;
+  }
+  return true;
+}
+
+bool
+DiscoveryCache::save(const OPENDDS_STRING& path, const DCPS::RepoId& participant) const
+{
+  OPENDDS_VECTOR(char) buffer;
+  if (!to_buffer(buffer)) {
+    ACE_ERROR((LM_ERROR,
+               ACE_TEXT("(%P|%t) ERROR: DiscoveryCache::save - ")
+               ACE_TEXT("failed to serialize the discovery cache\n")));
+    return false;
+  }
+
+  char unique[24 + 2 * sizeof participant.guidPrefix];
+  int length = ACE_OS::snprintf(unique, sizeof unique, ".%lu.",
+                                static_cast<unsigned long>(ACE_OS::getpid()));
+  for (size_t i = 0; i < sizeof participant.guidPrefix; ++i) {
+    length += ACE_OS::snprintf(unique + length, sizeof unique - length, "%02x",
+                               static_cast<unsigned int>(participant.guidPrefix[i]));
+  }
+  const OPENDDS_STRING tmp_path = path + unique + ".tmp";
+  FILE* const file = ACE_OS::fopen(tmp_path.c_str(), ACE_TEXT("wb"));
+  if (!file) {
+    ACE_ERROR((LM_ERROR,
+               ACE_TEXT("(%P|%t) ERROR: DiscoveryCache::save - ")
+               ACE_TEXT("failed to open %C %p\n"), tmp_path.c_str(), ACE_TEXT("fopen")));
+    return false;
+  }
+  const bool written =
+    ACE_OS::fwrite(&buffer[0], 1, buffer.size(), file) == buffer.size();
+  if (ACE_OS::fclose(file) != 0 || !written ||
+      ACE_OS::rename(tmp_path.c_str(), path.c_str()) != 0) {
+    ACE_ERROR((LM_ERROR,
+               ACE_TEXT("(%P|%t) ERROR: DiscoveryCache::save - ")
+               ACE_TEXT("failed to write %C %p\n"), path.c_str(), ACE_TEXT("fwrite")));
+    ACE_OS::unlink(tmp_path.c_str());
+    return false;
+  }
+  return true;
+}
+
+bool
+DiscoveryCache::load(const OPENDDS_STRING& path)
+{
+  clear();
+
+  FILE* const file = ACE_OS::fopen(path.c_str(), ACE_TEXT("rb"));
+  if (!file) {
+    return false;
+  }
+  OPENDDS_VECTOR(char) buffer;
+  char block[64 * 1024];
+  size_t n;
+  while ((n = ACE_OS::fread(block, 1, sizeof block, file)) > 0) {
+    buffer.insert(buffer.end(), block, block + n);
+  }
+  ACE_OS::fclose(file);
+
+  if (buffer.empty() || !from_buffer(&buffer[0], buffer.size())) {
+    ACE_ERROR((LM_WARNING,
+               ACE_TEXT("(%P|%t) WARNING: DiscoveryCache::load - ")
+               ACE_TEXT("ignoring %C, which isn't a discovery cache\n"), path.c_str()));
+    return false;
+  }
+  return true;
+}
+
+OPENDDS_STRING
+DiscoveryCache::path(const OPENDDS_STRING& dir,
+                     const OPENDDS_STRING& key,
+                     DDS::DomainId_t domain)
+{
+  // An existing directory is an error that's ignored.
+  ACE_OS::mkdir(dir.c_str());
+  char domain_str[16];
+  ACE_OS::snprintf(domain_str, sizeof domain_str, "%d", domain);
+  return dir + ACE_DIRECTORY_SEPARATOR_STR_A + "rtps_discovery_" + key +
+    "_" + domain_str + ".cache";
+}
+
+} // namespace RTPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,80 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_RTPS_DISCOVERYCACHE_H
+#define OPENDDS_RTPS_DISCOVERYCACHE_H
+
+#include "dds/DCPS/RTPS/rtps_export.h"
+#include "dds/DCPS/RTPS/Sedp.h"
+
+#include "dds/DCPS/PoolAllocator.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+#pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace RTPS {
+
+/**
+ * @struct DiscoveryCache
+ *
+ * @brief The remote participants and endpoints that RTPS discovery knew
+ * of when it last ran.
+ *
+ * With the DiscoveryCache option, Spdp saves them in a file under
+ * DCPSPersistentDataDir and preloads them when it starts again, as if
+ * they had just been discovered, so local endpoints are associated with
+ * them without waiting for SPDP and SEDP.  They stay tentative until
+ * they are discovered again and are removed if they aren't within
+ * DiscoveryCacheLease.
+ *
+ * The file holds the participants as SPDP parameter lists and the
+ * endpoints as SEDP parameter lists, in little-endian CDR.
+ */
+struct OpenDDS_Rtps_Export DiscoveryCache {
+  OPENDDS_VECTOR(ParticipantData_t) participants_;
+  OPENDDS_VECTOR(DCPS::DiscoveredWriterData) writers_;
+  OPENDDS_VECTOR(DCPS::DiscoveredReaderData) readers_;
+
+  bool empty() const
+  {
+    return participants_.empty() && writers_.empty() && readers_.empty();
+  }
+
+  void clear();
+
+  /// Serialize into @a buffer, which is replaced.
+  bool to_buffer(OPENDDS_VECTOR(char)& buffer) const;
+
+  /// Replace the contents with the ones serialized in @a buffer.
+  bool from_buffer(const char* buffer, size_t size);
+
+  /// Write to @a path, through a temporary file that replaces it.  The
+  /// temporary file is named after the process and @a participant, so
+  /// participants saving the same path at once don't write over each
+  /// other's temporary file.
+  bool save(const OPENDDS_STRING& path, const DCPS::RepoId& participant) const;
+
+  /// Read from @a path; false if there is no file or it can't be read.
+  bool load(const OPENDDS_STRING& path);
+
+  /// The file of the discovery @a key in @a domain, in @a dir, which is
+  /// created if it doesn't exist.
+  static OPENDDS_STRING path(const OPENDDS_STRING& dir,
+                             const OPENDDS_STRING& key,
+                             DDS::DomainId_t domain);
+};
+
+} // namespace RTPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* OPENDDS_RTPS_DISCOVERYCACHE_H */
@@ -0,0 +1,149 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "dds/DCPS/RTPS/DiscoveryPacer.h"
+
+#include "ace/Guard_T.h"
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace RTPS {
+
+DiscoveryPacer::Message::~Message()
+{
+}
+
+DiscoveryPacer::DiscoveryPacer()
+  : rate_(0)
+  , burst_(1)
+  , tokens_(0)
+  , sending_(false)
+{
+}
+
+DiscoveryPacer::~DiscoveryPacer()
+{
+  clear();
+}
+
+void
+DiscoveryPacer::configure(unsigned int rate, unsigned int burst)
+{
+  ACE_GUARD(ACE_Thread_Mutex, g, lock_);
+  rate_ = rate;
+  burst_ = burst ? burst : 1;
+  tokens_ = burst_;
+  last_refill_ = ACE_Time_Value::zero;
+}
+
+void
+DiscoveryPacer::send(Priority priority, Message* message, const ACE_Time_Value& now)
+{
+  if (!enabled()) {
+    message->send();
+    delete message;
+    return;
+  }
+
+  ACE_Guard<ACE_Thread_Mutex> g(lock_);
+  if (!g.locked()) {
+    delete message;
+    return;
+  }
+  queues_[priority].push_back(message);
+  drain_i(now);
+}
+
+void
+DiscoveryPacer::drain(const ACE_Time_Value& now)
+{
+  ACE_GUARD(ACE_Thread_Mutex, g, lock_);
+  drain_i(now);
+}
+
+size_t
+DiscoveryPacer::queued() const
+{
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, g, lock_, 0);
+  size_t count = 0;
+  for (int p = 0; p < PRIORITY_COUNT; ++p) {
+    count += queues_[p].size();
+  }
+  return count;
+}
+
+void
+DiscoveryPacer::clear()
+{
+  ACE_GUARD(ACE_Thread_Mutex, g, lock_);
+  for (int p = 0; p < PRIORITY_COUNT; ++p) {
+    for (Queue::iterator it = queues_[p].begin(); it != queues_[p].end(); ++it) {
+      delete *it;
+    }
+    queues_[p].clear();
+  }
+}
+
+void
+DiscoveryPacer::refill(const ACE_Time_Value& now)
+{
+  if (last_refill_ == ACE_Time_Value::zero) {
+    last_refill_ = now;
+    return;
+  }
+  // Threads may pass times that are slightly out of order.
+  if (now <= last_refill_) {
+    return;
+  }
+  const ACE_Time_Value elapsed = now - last_refill_;
+  tokens_ += (elapsed.sec() + elapsed.usec() / 1e6) * rate_;
+  if (tokens_ > burst_) {
+    tokens_ = burst_;
+  }
+  last_refill_ = now;
+}
+
+void
+DiscoveryPacer::drain_i(const ACE_Time_Value& now)
+{
+  if (sending_) {
+    return;
+  }
+  sending_ = true;
+
+  for (;;) {
+    refill(now);
+
+    OPENDDS_VECTOR(Message*) batch;
+    for (int p = 0; p < PRIORITY_COUNT && tokens_ >= 1; ++p) {
+      while (tokens_ >= 1 && !queues_[p].empty()) {
+        batch.push_back(queues_[p].front());
+        queues_[p].pop_front();
+        tokens_ -= 1;
+      }
+    }
+    if (batch.empty()) {
+      break;
+    }
+
+    // Send without the lock, the transport may call back into discovery.
+    lock_.release();
+    for (size_t i = 0; i < batch.size(); ++i) {
+      batch[i]->send();
+      delete batch[i];
+    }
+    lock_.acquire();
+  }
+
+  sending_ = false;
+}
+
+} // namespace RTPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
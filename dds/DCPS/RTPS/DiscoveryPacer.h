@@ -0,0 +1,105 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_RTPS_DISCOVERYPACER_H
+#define OPENDDS_RTPS_DISCOVERYPACER_H
+
+#include "dds/DCPS/RTPS/rtps_export.h"
+#include "dds/DCPS/PoolAllocator.h"
+
+#include "ace/Thread_Mutex.h"
+#include "ace/Time_Value.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+#pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace RTPS {
+
+/**
+ * @class DiscoveryPacer
+ *
+ * @brief Limits the rate of the messages that the SEDP writers send.
+ *
+ * Messages are sent as long as there are tokens, which are added at the
+ * configured rate up to the configured burst.  Messages that find no
+ * token are queued by priority and sent, highest priority first, as
+ * tokens become available again (see drain()).  Messages of the same
+ * priority are sent in the order they were given, so a writer that always
+ * uses the same priority sends its samples in order.
+ *
+ * A pacer with a rate of 0 is disabled and sends every message at once.
+ */
+class OpenDDS_Rtps_Export DiscoveryPacer {
+public:
+  /// From highest to lowest.
+  enum Priority {
+    /// Announcements of the local data writers and readers.
+    PRIORITY_ENDPOINT,
+    /// Participant liveliness.
+    PRIORITY_PARTICIPANT_MESSAGE,
+    /// Security handshakes, key exchange and secure participant data.
+    PRIORITY_SECURITY,
+    PRIORITY_COUNT
+  };
+
+  /// A message to send.
+  class OpenDDS_Rtps_Export Message {
+  public:
+    virtual ~Message();
+
+    /// Called without the pacer's lock.
+    virtual void send() = 0;
+  };
+
+  DiscoveryPacer();
+  ~DiscoveryPacer();
+
+  /// @a rate messages per second, with bursts of up to @a burst messages.
+  void configure(unsigned int rate, unsigned int burst);
+
+  bool enabled() const { return rate_ != 0; }
+
+  /// Send @a message, or queue it until it can be sent.  Takes ownership
+  /// of @a message.
+  void send(Priority priority, Message* message, const ACE_Time_Value& now);
+
+  /// Send the queued messages that the tokens added since the last call
+  /// allow.
+  void drain(const ACE_Time_Value& now);
+
+  size_t queued() const;
+
+  /// Delete the queued messages without sending them.
+  void clear();
+
+private:
+  void refill(const ACE_Time_Value& now);
+  void drain_i(const ACE_Time_Value& now);
+
+  typedef OPENDDS_DEQUE(Message*) Queue;
+
+  mutable ACE_Thread_Mutex lock_;
+  unsigned int rate_;
+  unsigned int burst_;
+  double tokens_;
+  ACE_Time_Value last_refill_;
+  Queue queues_[PRIORITY_COUNT];
+  /// A thread is sending messages outside the lock; the others leave the
+  /// messages they queue to it, so they keep their order.
+  bool sending_;
+};
+
+} // namespace RTPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* OPENDDS_RTPS_DISCOVERYPACER_H */
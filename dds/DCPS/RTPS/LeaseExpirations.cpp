@@ -0,0 +1,60 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "dds/DCPS/RTPS/LeaseExpirations.h"
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace RTPS {
+
+void
+LeaseExpirations::schedule(const DCPS::RepoId& guid,
+                           const ACE_Time_Value& expiration)
+{
+  cancel(guid);
+  index_[guid] = expirations_.insert(std::make_pair(expiration, guid));
+}
+
+void
+LeaseExpirations::cancel(const DCPS::RepoId& guid)
+{
+  const Index::iterator pos = index_.find(guid);
+  if (pos != index_.end()) {
+    expirations_.erase(pos->second);
+    index_.erase(pos);
+  }
+}
+
+bool
+LeaseExpirations::pop_due(const ACE_Time_Value& now, DCPS::RepoId& guid)
+{
+  if (expirations_.empty() || now < expirations_.begin()->first) {
+    return false;
+  }
+  guid = expirations_.begin()->second;
+  index_.erase(guid);
+  expirations_.erase(expirations_.begin());
+  return true;
+}
+
+bool
+LeaseExpirations::expiration(const DCPS::RepoId& guid,
+                             ACE_Time_Value& expiration) const
+{
+  const Index::const_iterator pos = index_.find(guid);
+  if (pos == index_.end()) {
+    return false;
+  }
+  expiration = pos->second->first;
+  return true;
+}
+
+} // namespace RTPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,66 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_RTPS_LEASEEXPIRATIONS_H
+#define OPENDDS_RTPS_LEASEEXPIRATIONS_H
+
+#include "dds/DCPS/RTPS/rtps_export.h"
+#include "dds/DCPS/GuidUtils.h"
+#include "dds/DCPS/PoolAllocator.h"
+
+#include "ace/Time_Value.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+#pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace RTPS {
+
+/**
+ * @class LeaseExpirations
+ *
+ * @brief Discovered participants ordered by the time their lease
+ *        expires.
+ *
+ * Each participant has at most one entry, so checking for expired
+ * leases only visits the entries that are due (see pop_due()) instead
+ * of every participant.  Not thread safe; Spdp uses it under its lock.
+ */
+class OpenDDS_Rtps_Export LeaseExpirations {
+public:
+  /// Replace the entry of @a guid, if any, with one at @a expiration.
+  void schedule(const DCPS::RepoId& guid, const ACE_Time_Value& expiration);
+
+  void cancel(const DCPS::RepoId& guid);
+
+  /// Remove the earliest entry due at @a now and set @a guid to its
+  /// participant.  Returns false if no entry is due.
+  bool pop_due(const ACE_Time_Value& now, DCPS::RepoId& guid);
+
+  /// Set @a expiration to the entry of @a guid.  Returns false if it has
+  /// none.
+  bool expiration(const DCPS::RepoId& guid, ACE_Time_Value& expiration) const;
+
+  size_t size() const { return index_.size(); }
+
+private:
+  typedef OPENDDS_MULTIMAP(ACE_Time_Value, DCPS::RepoId) Expirations;
+  Expirations expirations_;
+  typedef OPENDDS_MAP_CMP(DCPS::RepoId, Expirations::iterator,
+                          DCPS::GUID_tKeyLessThan) Index;
+  Index index_;
+};
+
+} // namespace RTPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* OPENDDS_RTPS_LEASEEXPIRATIONS_H */
@@ -36,7 +36,12 @@ namespace {
     param_list[length] = param;
   }
 
-  void add_param_locator_seq(ParameterList& param_list,
+  void add_param(ParameterListConverter::ParameterListWriter& writer, const Parameter& param) {
+    writer.add(param);
+  }
+
+  template <typename Sink>
+  void add_param_locator_seq(Sink& param_list,
                              const DCPS::LocatorSeq& locator_seq,
                              const ParameterId_t pid) {
     const CORBA::ULong length = locator_seq.length();
@@ -48,7 +53,8 @@ namespace {
     }
   }
 
-  void add_param_rtps_locator(ParameterList& param_list,
+  template <typename Sink>
+  void add_param_rtps_locator(Sink& param_list,
                               const DCPS::TransportLocator& dcps_locator,
                               bool map /*map IPV4 to IPV6 addr*/) {
     // Convert the tls blob to an RTPS locator seq
@@ -77,7 +83,8 @@ namespace {
     }
   }
 
-  void add_param_dcps_locator(ParameterList& param_list,
+  template <typename Sink>
+  void add_param_dcps_locator(Sink& param_list,
                       const DCPS::TransportLocator& dcps_locator) {
     Parameter param;
     param.opendds_locator(dcps_locator);
@@ -335,14 +342,167 @@ namespace {
   }
 #endif
 
+  /// Apply each parameter of @a param_list to @a decoder, which converts
+  /// them one at a time.
+  template <typename Decoder>
+  int decode(const ParameterList& param_list, Decoder& decoder)
+  {
+    const CORBA::ULong length = param_list.length();
+    for (CORBA::ULong i = 0; i < length; ++i) {
+      if (decoder.apply(param_list[i]) != 0) {
+        return -1;
+      }
+    }
+    decoder.finish();
+    return 0;
+  }
+
+  /// Read parameters from @a ser up to the sentinel and apply them to
+  /// @a decoder, reusing one Parameter instead of growing a ParameterList.
+  template <typename Decoder>
+  int decode(DCPS::Serializer& ser, Decoder& decoder)
+  {
+    Parameter param;
+    while (ser >> param) {
+      if (param._d() == PID_SENTINEL) {
+        decoder.finish();
+        return 0;
+      }
+      if (decoder.apply(param) != 0) {
+        return -1;
+      }
+    }
+    return -1;
+  }
+
+  /// Applies each parameter to two decoders.
+  template <typename First, typename Second>
+  struct DecoderPair {
+    DecoderPair(First& first, Second& second)
+      : first(first), second(second) {}
+
+    int apply(const Parameter& param)
+    {
+      const int result = first.apply(param);
+      return second.apply(param) != 0 ? -1 : result;
+    }
+
+    void finish()
+    {
+      first.finish();
+      second.finish();
+    }
+
+    First& first;
+    Second& second;
+  };
+
+  struct AgentInfoDecoder {
+    AgentInfoDecoder(ICE::AgentInfo& agent_info, bool& have_agent_info)
+      : agent_info(agent_info), have_agent_info(have_agent_info)
+    {
+      have_agent_info = false;
+    }
+
+    int apply(const Parameter& parameter)
+    {
+      switch (parameter._d()) {
+      case PID_OPENDDS_ICE_GENERAL: {
+        have_agent_info = true;
+        const IceGeneral_t& ice_general = parameter.ice_general();
+        agent_info.type = static_cast<ICE::AgentType>(ice_general.agent_type);
+        agent_info.username = ice_general.username;
+        agent_info.password = ice_general.password;
+        break;
+      }
+      case PID_OPENDDS_ICE_CANDIDATE: {
+        have_agent_info = true;
+        const IceCandidate_t& ice_candidate = parameter.ice_candidate();
+        ICE::Candidate candidate;
+        candidate.address.set_type(AF_INET);
+        if (candidate.address.set_address(reinterpret_cast<const char*>(parameter.locator().address) + 12, 4, 0 /*network order*/) != 0) {
+          return -1;
+        }
+        candidate.address.set_port_number(parameter.locator().port);
+        candidate.foundation = ice_candidate.foundation;
+        candidate.priority = ice_candidate.priority;
+        candidate.type = static_cast<ICE::CandidateType>(ice_candidate.type);
+        agent_info.candidates.push_back(candidate);
+        break;
+      }
+      default:
+        // Do nothing.
+        break;
+      }
+      return 0;
+    }
+
+    void finish() {}
+
+    ICE::AgentInfo& agent_info;
+    bool& have_agent_info;
+  };
+
 };
 
 namespace ParameterListConverter {
 
+ParameterListWriter::ParameterListWriter(DCPS::Serializer* ser)
+  : ser_(ser)
+  , size_(0)
+  , good_(true)
+{
+}
+
+bool ParameterListWriter::add(const Parameter& param)
+{
+  if (param._d() == PID_SENTINEL) {
+    return good_;
+  }
+
+  size_t size = 0, pad = 0;
+  DCPS::gen_find_size(param, size, pad);
+  // As gen_find_size() of a ParameterList
+  size_ += size + pad;
+  if (size_ % 4) {
+    size_ += 4 - (size_ % 4);
+  }
+
+  if (!ser_ || !good_) {
+    return good_;
+  }
+
+  // As operator<< of a Parameter, but the value is written in place
+  // instead of to a message block that is then copied.
+  size -= 4; // parameterId & length
+  const size_t post_pad = 4 - ((size + pad) % 4);
+  const size_t total = size + pad + ((post_pad < 4) ? post_pad : 0);
+  static const ACE_CDR::Octet padding[3] = {0};
+  good_ = size + pad <= ACE_UINT16_MAX
+    && (*ser_ << param._d())
+    && (*ser_ << ACE_CDR::UShort(total))
+    && DCPS::insertParamData(*ser_, param)
+    && (post_pad == 4 || ser_->alignment() == DCPS::Serializer::ALIGN_NONE
+        || ser_->write_octet_array(padding, ACE_CDR::ULong(post_pad)));
+  return good_;
+}
+
+bool ParameterListWriter::finish()
+{
+  size_ += 4; // PID_SENTINEL
+  if (ser_ && good_) {
+    good_ = (*ser_ << PID_SENTINEL) && (*ser_ << PID_PAD);
+  }
+  return good_;
+}
+
 // DDS::ParticipantBuiltinTopicData
 
-int to_param_list(const DDS::ParticipantBuiltinTopicData& pbtd,
-                  ParameterList& param_list)
+namespace {
+
+template <typename Sink>
+int add_params(const DDS::ParticipantBuiltinTopicData& pbtd,
+               Sink& param_list)
 {
   if (not_default(pbtd.user_data))
   {
@@ -354,14 +514,15 @@ int to_param_list(const DDS::ParticipantBuiltinTopicData& pbtd,
   return 0;
 }
 
-int from_param_list(const ParameterList& param_list,
-                    DDS::ParticipantBuiltinTopicData& pbtd)
-{
-  pbtd.user_data.value.length(0);
+struct ParticipantBuiltinTopicDataDecoder {
+  explicit ParticipantBuiltinTopicDataDecoder(DDS::ParticipantBuiltinTopicData& pbtd)
+    : pbtd(pbtd)
+  {
+    pbtd.user_data.value.length(0);
+  }
 
-  CORBA::ULong length = param_list.length();
-  for (CORBA::ULong i = 0; i < length; ++i) {
-    const Parameter& param = param_list[i];
+  int apply(const Parameter& param)
+  {
     switch (param._d()) {
       case PID_USER_DATA:
         pbtd.user_data = param.user_data();
@@ -371,9 +532,27 @@ int from_param_list(const ParameterList& param_list,
           return -1;
         }
     }
+    return 0;
   }
 
-  return 0;
+  void finish() {}
+
+  DDS::ParticipantBuiltinTopicData& pbtd;
+};
+
+}
+
+int to_param_list(const DDS::ParticipantBuiltinTopicData& pbtd,
+                  ParameterList& param_list)
+{
+  return add_params(pbtd, param_list);
+}
+
+int from_param_list(const ParameterList& param_list,
+                    DDS::ParticipantBuiltinTopicData& pbtd)
+{
+  ParticipantBuiltinTopicDataDecoder decoder(pbtd);
+  return decode(param_list, decoder);
 }
 
 #ifdef OPENDDS_SECURITY
@@ -475,9 +654,13 @@ int from_param_list(const ParameterList& param_list,
 }
 #endif
 
-OpenDDS_Rtps_Export
-int to_param_list(const ParticipantProxy_t& proxy,
-                  ParameterList& param_list)
+// OpenDDS::RTPS::ParticipantProxy_t
+
+namespace {
+
+template <typename Sink>
+int add_params(const ParticipantProxy_t& proxy,
+               Sink& param_list)
 {
   Parameter pv_param;
   pv_param.version(proxy.protocolVersion);
@@ -562,21 +745,20 @@ int to_param_list(const ParticipantProxy_t& proxy,
   return 0;
 }
 
-int from_param_list(const ParameterList& param_list,
-                    ParticipantProxy_t& proxy)
-{
-  // Track the state of our locators
-  LocatorState du_last_state = locator_undefined;
-  LocatorState mu_last_state = locator_undefined;
-  LocatorState mm_last_state = locator_undefined;
-
-  // Start by setting defaults
-  proxy.availableBuiltinEndpoints = 0;
-  proxy.expectsInlineQos = false;
+struct ParticipantProxyDecoder {
+  explicit ParticipantProxyDecoder(ParticipantProxy_t& proxy)
+    : proxy(proxy)
+    , du_last_state(locator_undefined)
+    , mu_last_state(locator_undefined)
+    , mm_last_state(locator_undefined)
+  {
+    // Start by setting defaults
+    proxy.availableBuiltinEndpoints = 0;
+    proxy.expectsInlineQos = false;
+  }
 
-  CORBA::ULong length = param_list.length();
-  for (CORBA::ULong i = 0; i < length; ++i) {
-    const Parameter& param = param_list[i];
+  int apply(const Parameter& param)
+  {
     switch (param._d()) {
       case PID_PROTOCOL_VERSION:
         proxy.protocolVersion = param.version();
@@ -677,16 +859,41 @@ int from_param_list(const ParameterList& param_list,
           return -1;
         }
     }
+    return 0;
   }
 
-  return 0;
-}
+  void finish() {}
 
-// OpenDDS::RTPS::Duration_t
+  ParticipantProxy_t& proxy;
+  // Track the state of our locators
+  LocatorState du_last_state;
+  LocatorState mu_last_state;
+  LocatorState mm_last_state;
+};
+
+}
 
 OpenDDS_Rtps_Export
-int to_param_list(const Duration_t& duration,
+int to_param_list(const ParticipantProxy_t& proxy,
                   ParameterList& param_list)
+{
+  return add_params(proxy, param_list);
+}
+
+int from_param_list(const ParameterList& param_list,
+                    ParticipantProxy_t& proxy)
+{
+  ParticipantProxyDecoder decoder(proxy);
+  return decode(param_list, decoder);
+}
+
+// OpenDDS::RTPS::Duration_t
+
+namespace {
+
+template <typename Sink>
+int add_params(const Duration_t& duration,
+               Sink& param_list)
 {
   if ((duration.seconds != 100) ||
       (duration.fraction != 0))
@@ -699,16 +906,16 @@ int to_param_list(const Duration_t& duration,
   return 0;
 }
 
-OpenDDS_Rtps_Export
-int from_param_list(const ParameterList& param_list,
-                    Duration_t& duration)
-{
-  duration.seconds = 100;
-  duration.fraction = 0;
+struct DurationDecoder {
+  explicit DurationDecoder(Duration_t& duration)
+    : duration(duration)
+  {
+    duration.seconds = 100;
+    duration.fraction = 0;
+  }
 
-  CORBA::ULong length = param_list.length();
-  for (CORBA::ULong i = 0; i < length; ++i) {
-    const Parameter& param = param_list[i];
+  int apply(const Parameter& param)
+  {
     switch (param._d()) {
       case PID_PARTICIPANT_LEASE_DURATION:
         duration = param.duration();
@@ -718,21 +925,88 @@ int from_param_list(const ParameterList& param_list,
           return -1;
         }
     }
+    return 0;
   }
-  return 0;
+
+  void finish() {}
+
+  Duration_t& duration;
+};
+
+}
+
+OpenDDS_Rtps_Export
+int to_param_list(const Duration_t& duration,
+                  ParameterList& param_list)
+{
+  return add_params(duration, param_list);
+}
+
+OpenDDS_Rtps_Export
+int from_param_list(const ParameterList& param_list,
+                    Duration_t& duration)
+{
+  DurationDecoder decoder(duration);
+  return decode(param_list, decoder);
 }
 
 // OpenDDS::RTPS::SPDPdiscoveredParticipantData
 
+namespace {
+
+template <typename Sink>
+int add_params(const SPDPdiscoveredParticipantData& participant_data,
+               Sink& param_list)
+{
+  add_params(participant_data.ddsParticipantData, param_list);
+  add_params(participant_data.participantProxy, param_list);
+  add_params(participant_data.leaseDuration, param_list);
+
+  return 0;
+}
+
+/// The three conversions that read an SPDP participant, in one pass.
+struct ParticipantDataDecoder {
+  explicit ParticipantDataDecoder(SPDPdiscoveredParticipantData& participant_data)
+    : pbtd(participant_data.ddsParticipantData)
+    , proxy(participant_data.participantProxy)
+    , duration(participant_data.leaseDuration)
+  {}
+
+  int apply(const Parameter& param)
+  {
+    const int pbtd_result = pbtd.apply(param);
+    const int proxy_result = proxy.apply(param);
+    const int duration_result = duration.apply(param);
+    return (pbtd_result || proxy_result || duration_result) ? -1 : 0;
+  }
+
+  void finish()
+  {
+    pbtd.finish();
+    proxy.finish();
+    duration.finish();
+  }
+
+  ParticipantBuiltinTopicDataDecoder pbtd;
+  ParticipantProxyDecoder proxy;
+  DurationDecoder duration;
+};
+
+}
+
 OpenDDS_Rtps_Export
 int to_param_list(const SPDPdiscoveredParticipantData& participant_data,
                   ParameterList& param_list)
 {
-  to_param_list(participant_data.ddsParticipantData, param_list);
-  to_param_list(participant_data.participantProxy, param_list);
-  to_param_list(participant_data.leaseDuration, param_list);
+  return add_params(participant_data, param_list);
+}
 
-  return 0;
+int to_param_list(const SPDPdiscoveredParticipantData& participant_data,
+                  ParameterListWriter& writer)
+{
+  add_params(participant_data, writer);
+  return writer.good() ? 0 : -1;
 }
 
 int from_param_list(const ParameterList& param_list,
@@ -749,6 +1023,13 @@ int from_param_list(const ParameterList& param_list,
   return result;
 }
 
+int from_param_list(DCPS::Serializer& ser,
+                    SPDPdiscoveredParticipantData& participant_data)
+{
+  ParticipantDataDecoder decoder(participant_data);
+  return decode(ser, decoder);
+}
+
 #ifdef OPENDDS_SECURITY
 int to_param_list(const OpenDDS::Security::SPDPdiscoveredParticipantData& participant_data,
                   ParameterList& param_list)
@@ -809,9 +1090,12 @@ int from_param_list(const ParameterList& param_list,
 
 // OpenDDS::DCPS::DiscoveredWriterData
 
-int to_param_list(const DCPS::DiscoveredWriterData& writer_data,
-                  ParameterList& param_list,
-                  bool map)
+namespace {
+
+template <typename Sink>
+int add_params(const DCPS::DiscoveredWriterData& writer_data,
+               Sink& param_list,
+               bool map)
 {
   // Ignore builtin topic key
 
@@ -974,56 +1258,54 @@ int to_param_list(const DCPS::DiscoveredWriterData& writer_data,
   return 0;
 }
 
-int from_param_list(const ParameterList& param_list,
-                    DCPS::DiscoveredWriterData& writer_data)
-{
-  LocatorState last_state = locator_undefined;  // Track state of locator
-  // Collect the rtps_udp locators before appending them to allLocators
-  DCPS::LocatorSeq rtps_udp_locators;
-
-  // Start by setting defaults
-  writer_data.ddsPublicationData.topic_name = "";
-  writer_data.ddsPublicationData.type_name  = "";
-  writer_data.ddsPublicationData.durability =
-      TheServiceParticipant->initial_DurabilityQosPolicy();
-  writer_data.ddsPublicationData.durability_service =
-      TheServiceParticipant->initial_DurabilityServiceQosPolicy();
-  writer_data.ddsPublicationData.deadline =
-      TheServiceParticipant->initial_DeadlineQosPolicy();
-  writer_data.ddsPublicationData.latency_budget =
-      TheServiceParticipant->initial_LatencyBudgetQosPolicy();
-  writer_data.ddsPublicationData.liveliness =
-      TheServiceParticipant->initial_LivelinessQosPolicy();
-  writer_data.ddsPublicationData.reliability =
-      TheServiceParticipant->initial_DataWriterQos().reliability;
-  writer_data.ddsPublicationData.lifespan =
-      TheServiceParticipant->initial_LifespanQosPolicy();
-  writer_data.ddsPublicationData.user_data =
-      TheServiceParticipant->initial_UserDataQosPolicy();
-  writer_data.ddsPublicationData.ownership =
-      TheServiceParticipant->initial_OwnershipQosPolicy();
+struct WriterDataDecoder {
+  explicit WriterDataDecoder(DCPS::DiscoveredWriterData& writer_data)
+    : writer_data(writer_data)
+    , last_state(locator_undefined)
+  {
+    // Start by setting defaults
+    writer_data.ddsPublicationData.topic_name = "";
+    writer_data.ddsPublicationData.type_name  = "";
+    writer_data.ddsPublicationData.durability =
+        TheServiceParticipant->initial_DurabilityQosPolicy();
+    writer_data.ddsPublicationData.durability_service =
+        TheServiceParticipant->initial_DurabilityServiceQosPolicy();
+    writer_data.ddsPublicationData.deadline =
+        TheServiceParticipant->initial_DeadlineQosPolicy();
+    writer_data.ddsPublicationData.latency_budget =
+        TheServiceParticipant->initial_LatencyBudgetQosPolicy();
+    writer_data.ddsPublicationData.liveliness =
+        TheServiceParticipant->initial_LivelinessQosPolicy();
+    writer_data.ddsPublicationData.reliability =
+        TheServiceParticipant->initial_DataWriterQos().reliability;
+    writer_data.ddsPublicationData.lifespan =
+        TheServiceParticipant->initial_LifespanQosPolicy();
+    writer_data.ddsPublicationData.user_data =
+        TheServiceParticipant->initial_UserDataQosPolicy();
+    writer_data.ddsPublicationData.ownership =
+        TheServiceParticipant->initial_OwnershipQosPolicy();
 #ifdef OPENDDS_NO_OWNERSHIP_KIND_EXCLUSIVE
-  writer_data.ddsPublicationData.ownership_strength.value = 0;
+    writer_data.ddsPublicationData.ownership_strength.value = 0;
 #else
-  writer_data.ddsPublicationData.ownership_strength =
-      TheServiceParticipant->initial_OwnershipStrengthQosPolicy();
+    writer_data.ddsPublicationData.ownership_strength =
+        TheServiceParticipant->initial_OwnershipStrengthQosPolicy();
 #endif
-  writer_data.ddsPublicationData.destination_order =
-      TheServiceParticipant->initial_DestinationOrderQosPolicy();
-  writer_data.ddsPublicationData.presentation =
-      TheServiceParticipant->initial_PresentationQosPolicy();
-  writer_data.ddsPublicationData.partition =
-      TheServiceParticipant->initial_PartitionQosPolicy();
-  writer_data.ddsPublicationData.topic_data =
-      TheServiceParticipant->initial_TopicDataQosPolicy();
-  writer_data.ddsPublicationData.group_data =
-      TheServiceParticipant->initial_GroupDataQosPolicy();
-  writer_data.writerProxy.unicastLocatorList.length(0);
-  writer_data.writerProxy.multicastLocatorList.length(0);
+    writer_data.ddsPublicationData.destination_order =
+        TheServiceParticipant->initial_DestinationOrderQosPolicy();
+    writer_data.ddsPublicationData.presentation =
+        TheServiceParticipant->initial_PresentationQosPolicy();
+    writer_data.ddsPublicationData.partition =
+        TheServiceParticipant->initial_PartitionQosPolicy();
+    writer_data.ddsPublicationData.topic_data =
+        TheServiceParticipant->initial_TopicDataQosPolicy();
+    writer_data.ddsPublicationData.group_data =
+        TheServiceParticipant->initial_GroupDataQosPolicy();
+    writer_data.writerProxy.unicastLocatorList.length(0);
+    writer_data.writerProxy.multicastLocatorList.length(0);
+  }
 
-  CORBA::ULong length = param_list.length();
-  for (CORBA::ULong i = 0; i < length; ++i) {
-    const Parameter& param = param_list[i];
+  int apply(const Parameter& param)
+  {
     switch (param._d()) {
       case PID_TOPIC_NAME:
         writer_data.ddsPublicationData.topic_name = param.string_data();
@@ -1124,19 +1406,73 @@ int from_param_list(const ParameterList& param_list,
           return -1;
         }
     }
+    return 0;
   }
-  // Append additional rtps_udp_locators, if any
-  append_locators_if_present(writer_data.writerProxy.allLocators,
-                             rtps_udp_locators);
-  rtps_udp_locators.length(0);
-  return 0;
-}
 
-// OpenDDS::DCPS::DiscoveredReaderData
+  void finish()
+  {
+    // Append additional rtps_udp_locators, if any
+    append_locators_if_present(writer_data.writerProxy.allLocators,
+                               rtps_udp_locators);
+    rtps_udp_locators.length(0);
+  }
 
-int to_param_list(const DCPS::DiscoveredReaderData& reader_data,
+  DCPS::DiscoveredWriterData& writer_data;
+  LocatorState last_state;  // Track state of locator
+  // Collect the rtps_udp locators before appending them to allLocators
+  DCPS::LocatorSeq rtps_udp_locators;
+};
+
+}
+
+int to_param_list(const DCPS::DiscoveredWriterData& writer_data,
                   ParameterList& param_list,
                   bool map)
+{
+  return add_params(writer_data, param_list, map);
+}
+
+int to_param_list(const DCPS::DiscoveredWriterData& writer_data,
+                  ParameterListWriter& writer,
+                  bool map)
+{
+  add_params(writer_data, writer, map);
+  return writer.good() ? 0 : -1;
+}
+
+int from_param_list(const ParameterList& param_list,
+                    DCPS::DiscoveredWriterData& writer_data)
+{
+  WriterDataDecoder decoder(writer_data);
+  return decode(param_list, decoder);
+}
+
+int from_param_list(DCPS::Serializer& ser,
+                    DCPS::DiscoveredWriterData& writer_data)
+{
+  WriterDataDecoder decoder(writer_data);
+  return decode(ser, decoder);
+}
+
+int from_param_list(DCPS::Serializer& ser,
+                    DCPS::DiscoveredWriterData& writer_data,
+                    ICE::AgentInfo& agent_info,
+                    bool& have_agent_info)
+{
+  WriterDataDecoder data_decoder(writer_data);
+  AgentInfoDecoder agent_info_decoder(agent_info, have_agent_info);
+  DecoderPair<WriterDataDecoder, AgentInfoDecoder> decoder(data_decoder, agent_info_decoder);
+  return decode(ser, decoder);
+}
+
+// OpenDDS::DCPS::DiscoveredReaderData
+
+namespace {
+
+template <typename Sink>
+int add_params(const DCPS::DiscoveredReaderData& reader_data,
+               Sink& param_list,
+               bool map)
 {
   // Ignore builtin topic key
   {
@@ -1305,54 +1641,52 @@ int to_param_list(const DCPS::DiscoveredReaderData& reader_data,
   return 0;
 }
 
-int from_param_list(const ParameterList& param_list,
-                    DCPS::DiscoveredReaderData& reader_data)
-{
-  LocatorState last_state = locator_undefined;  // Track state of locator
-  // Collect the rtps_udp locators before appending them to allLocators
-
-  DCPS::LocatorSeq rtps_udp_locators;
-  // Start by setting defaults
-  reader_data.ddsSubscriptionData.topic_name = "";
-  reader_data.ddsSubscriptionData.type_name  = "";
-  reader_data.ddsSubscriptionData.durability =
-      TheServiceParticipant->initial_DurabilityQosPolicy();
-  reader_data.ddsSubscriptionData.deadline =
-      TheServiceParticipant->initial_DeadlineQosPolicy();
-  reader_data.ddsSubscriptionData.latency_budget =
-      TheServiceParticipant->initial_LatencyBudgetQosPolicy();
-  reader_data.ddsSubscriptionData.liveliness =
-      TheServiceParticipant->initial_LivelinessQosPolicy();
-  reader_data.ddsSubscriptionData.reliability =
-      TheServiceParticipant->initial_DataReaderQos().reliability;
-  reader_data.ddsSubscriptionData.ownership =
-      TheServiceParticipant->initial_OwnershipQosPolicy();
-  reader_data.ddsSubscriptionData.destination_order =
-      TheServiceParticipant->initial_DestinationOrderQosPolicy();
-  reader_data.ddsSubscriptionData.user_data =
-      TheServiceParticipant->initial_UserDataQosPolicy();
-  reader_data.ddsSubscriptionData.time_based_filter =
-      TheServiceParticipant->initial_TimeBasedFilterQosPolicy();
-  reader_data.ddsSubscriptionData.presentation =
-      TheServiceParticipant->initial_PresentationQosPolicy();
-  reader_data.ddsSubscriptionData.partition =
-      TheServiceParticipant->initial_PartitionQosPolicy();
-  reader_data.ddsSubscriptionData.topic_data =
-      TheServiceParticipant->initial_TopicDataQosPolicy();
-  reader_data.ddsSubscriptionData.group_data =
-      TheServiceParticipant->initial_GroupDataQosPolicy();
-  reader_data.readerProxy.unicastLocatorList.length(0);
-  reader_data.readerProxy.multicastLocatorList.length(0);
-  reader_data.readerProxy.expectsInlineQos = false;
-  reader_data.contentFilterProperty.contentFilteredTopicName = "";
-  reader_data.contentFilterProperty.relatedTopicName = "";
-  reader_data.contentFilterProperty.filterClassName = "";
-  reader_data.contentFilterProperty.filterExpression = "";
-  reader_data.contentFilterProperty.expressionParameters.length(0);
+struct ReaderDataDecoder {
+  explicit ReaderDataDecoder(DCPS::DiscoveredReaderData& reader_data)
+    : reader_data(reader_data)
+    , last_state(locator_undefined)
+  {
+    // Start by setting defaults
+    reader_data.ddsSubscriptionData.topic_name = "";
+    reader_data.ddsSubscriptionData.type_name  = "";
+    reader_data.ddsSubscriptionData.durability =
+        TheServiceParticipant->initial_DurabilityQosPolicy();
+    reader_data.ddsSubscriptionData.deadline =
+        TheServiceParticipant->initial_DeadlineQosPolicy();
+    reader_data.ddsSubscriptionData.latency_budget =
+        TheServiceParticipant->initial_LatencyBudgetQosPolicy();
+    reader_data.ddsSubscriptionData.liveliness =
+        TheServiceParticipant->initial_LivelinessQosPolicy();
+    reader_data.ddsSubscriptionData.reliability =
+        TheServiceParticipant->initial_DataReaderQos().reliability;
+    reader_data.ddsSubscriptionData.ownership =
+        TheServiceParticipant->initial_OwnershipQosPolicy();
+    reader_data.ddsSubscriptionData.destination_order =
+        TheServiceParticipant->initial_DestinationOrderQosPolicy();
+    reader_data.ddsSubscriptionData.user_data =
+        TheServiceParticipant->initial_UserDataQosPolicy();
+    reader_data.ddsSubscriptionData.time_based_filter =
+        TheServiceParticipant->initial_TimeBasedFilterQosPolicy();
+    reader_data.ddsSubscriptionData.presentation =
+        TheServiceParticipant->initial_PresentationQosPolicy();
+    reader_data.ddsSubscriptionData.partition =
+        TheServiceParticipant->initial_PartitionQosPolicy();
+    reader_data.ddsSubscriptionData.topic_data =
+        TheServiceParticipant->initial_TopicDataQosPolicy();
+    reader_data.ddsSubscriptionData.group_data =
+        TheServiceParticipant->initial_GroupDataQosPolicy();
+    reader_data.readerProxy.unicastLocatorList.length(0);
+    reader_data.readerProxy.multicastLocatorList.length(0);
+    reader_data.readerProxy.expectsInlineQos = false;
+    reader_data.contentFilterProperty.contentFilteredTopicName = "";
+    reader_data.contentFilterProperty.relatedTopicName = "";
+    reader_data.contentFilterProperty.filterClassName = "";
+    reader_data.contentFilterProperty.filterExpression = "";
+    reader_data.contentFilterProperty.expressionParameters.length(0);
+  }
 
-  CORBA::ULong length = param_list.length();
-  for (CORBA::ULong i = 0; i < length; ++i) {
-    const Parameter& param = param_list[i];
+  int apply(const Parameter& param)
+  {
     switch (param._d()) {
       case PID_TOPIC_NAME:
         reader_data.ddsSubscriptionData.topic_name = param.string_data();
@@ -1449,12 +1783,63 @@ int from_param_list(const ParameterList& param_list,
           return -1;
         }
     }
+    return 0;
   }
-  // Append additional rtps_udp_locators, if any
-  append_locators_if_present(reader_data.readerProxy.allLocators,
-                             rtps_udp_locators);
-  rtps_udp_locators.length(0);
-  return 0;
+
+  void finish()
+  {
+    // Append additional rtps_udp_locators, if any
+    append_locators_if_present(reader_data.readerProxy.allLocators,
+                               rtps_udp_locators);
+    rtps_udp_locators.length(0);
+  }
+
+  DCPS::DiscoveredReaderData& reader_data;
+  LocatorState last_state;  // Track state of locator
+  // Collect the rtps_udp locators before appending them to allLocators
+  DCPS::LocatorSeq rtps_udp_locators;
+};
+
+}
+
+int to_param_list(const DCPS::DiscoveredReaderData& reader_data,
+                  ParameterList& param_list,
+                  bool map)
+{
+  return add_params(reader_data, param_list, map);
+}
+
+int to_param_list(const DCPS::DiscoveredReaderData& reader_data,
+                  ParameterListWriter& writer,
+                  bool map)
+{
+  add_params(reader_data, writer, map);
+  return writer.good() ? 0 : -1;
+}
+
+int from_param_list(const ParameterList& param_list,
+                    DCPS::DiscoveredReaderData& reader_data)
+{
+  ReaderDataDecoder decoder(reader_data);
+  return decode(param_list, decoder);
+}
+
+int from_param_list(DCPS::Serializer& ser,
+                    DCPS::DiscoveredReaderData& reader_data)
+{
+  ReaderDataDecoder decoder(reader_data);
+  return decode(ser, decoder);
+}
+
+int from_param_list(DCPS::Serializer& ser,
+                    DCPS::DiscoveredReaderData& reader_data,
+                    ICE::AgentInfo& agent_info,
+                    bool& have_agent_info)
+{
+  ReaderDataDecoder data_decoder(reader_data);
+  AgentInfoDecoder agent_info_decoder(agent_info, have_agent_info);
+  DecoderPair<ReaderDataDecoder, AgentInfoDecoder> decoder(data_decoder, agent_info_decoder);
+  return decode(ser, decoder);
 }
 
 #ifdef OPENDDS_SECURITY
@@ -1566,8 +1951,11 @@ int from_param_list(const ParameterList& param_list,
 }
 #endif
 
-int to_param_list(const ICE::AgentInfo& agent_info,
-                  ParameterList& param_list)
+namespace {
+
+template <typename Sink>
+int add_params(const ICE::AgentInfo& agent_info,
+               Sink& param_list)
 {
   IceGeneral_t ice_general;
   ice_general.agent_type = agent_info.type;
@@ -1598,43 +1986,27 @@ int to_param_list(const ICE::AgentInfo& agent_info,
   return 0;
 }
 
+}
+
+int to_param_list(const ICE::AgentInfo& agent_info,
+                  ParameterList& param_list)
+{
+  return add_params(agent_info, param_list);
+}
+
+int to_param_list(const ICE::AgentInfo& agent_info,
+                  ParameterListWriter& writer)
+{
+  add_params(agent_info, writer);
+  return writer.good() ? 0 : -1;
+}
+
 int from_param_list(const ParameterList& param_list,
                     ICE::AgentInfo& agent_info,
                     bool& have_agent_info)
 {
-  have_agent_info = false;
-  for (CORBA::ULong idx = 0, count = param_list.length(); idx != count; ++idx) {
-    const Parameter& parameter = param_list[idx];
-    switch (parameter._d()) {
-    case PID_OPENDDS_ICE_GENERAL: {
-      have_agent_info = true;
-      const IceGeneral_t& ice_general = parameter.ice_general();
-      agent_info.type = static_cast<ICE::AgentType>(ice_general.agent_type);
-      agent_info.username = ice_general.username;
-      agent_info.password = ice_general.password;
-      break;
-    }
-    case PID_OPENDDS_ICE_CANDIDATE: {
-      have_agent_info = true;
-      const IceCandidate_t& ice_candidate = parameter.ice_candidate();
-      ICE::Candidate candidate;
-      candidate.address.set_type(AF_INET);
-      if (candidate.address.set_address(reinterpret_cast<const char*>(parameter.locator().address) + 12, 4, 0 /*network order*/) != 0) {
-        return -1;
-      }
-      candidate.address.set_port_number(parameter.locator().port);
-      candidate.foundation = ice_candidate.foundation;
-      candidate.priority = ice_candidate.priority;
-      candidate.type = static_cast<ICE::CandidateType>(ice_candidate.type);
-      agent_info.candidates.push_back(candidate);
-      break;
-    }
-    default:
-      // Do nothing.
-      break;
-    }
-  }
-  return 0;
+  AgentInfoDecoder decoder(agent_info, have_agent_info);
+  return decode(param_list, decoder);
 }
 
 } // ParameterListConverter
@@ -12,6 +12,8 @@
 
 #include "dds/DCPS/RTPS/ICE/Ice.h"
 
+#include "dds/DCPS/Serializer.h"
+
 #ifdef OPENDDS_SECURITY
 #include "dds/DCPS/RTPS/RtpsSecurityC.h"
 #endif
@@ -180,6 +182,91 @@ int from_param_list(const ParameterList& param_list,
                     ICE::AgentInfo& agent_info,
                     bool& have_agent_info);
 
+
+// Direct serialization
+//
+// These write and read the same bytes as operator<< and operator>> of the
+// ParameterList that the functions above convert to and from, without
+// building the ParameterList.  Parameters of more than one conversion can
+// be added to a ParameterListWriter before finish() ends the list.
+
+/**
+ * @class ParameterListWriter
+ *
+ * @brief Writes parameters to a stream as a ParameterList would.
+ *
+ * Without a stream only the size is computed, so the same conversion can
+ * be run once to size a message block and again to fill it.  Parameters
+ * are written straight to the stream, which must be at a 4 byte boundary
+ * (as it is after the encapsulation) when the list starts.
+ */
+class OpenDDS_Rtps_Export ParameterListWriter {
+public:
+  explicit ParameterListWriter(DCPS::Serializer* ser = 0);
+
+  /// Add @a param; a PID_SENTINEL is skipped, as operator<< does.
+  bool add(const Parameter& param);
+
+  /// End the list with PID_SENTINEL.
+  bool finish();
+
+  /// The serialized size of the parameters added so far, and of the
+  /// sentinel once finish() was called.
+  size_t size() const { return size_; }
+
+  bool good() const { return good_; }
+
+private:
+  DCPS::Serializer* ser_;
+  size_t size_;
+  bool good_;
+};
+
+OpenDDS_Rtps_Export
+int to_param_list(const SPDPdiscoveredParticipantData& participant_data,
+                  ParameterListWriter& writer);
+
+OpenDDS_Rtps_Export
+int to_param_list(const DCPS::DiscoveredWriterData& writer_data,
+                  ParameterListWriter& writer,
+                  bool map = false /*map IPV4 to IPV6 addr*/);
+
+OpenDDS_Rtps_Export
+int to_param_list(const DCPS::DiscoveredReaderData& reader_data,
+                  ParameterListWriter& writer,
+                  bool map = false /*map IPV4 to IPV6 addr*/);
+
+OpenDDS_Rtps_Export
+int to_param_list(const ICE::AgentInfo& agent_info,
+                  ParameterListWriter& writer);
+
+/// Read a serialized ParameterList, up to and including its sentinel.
+/// Returns -1 if it can't be read or has an incompatible parameter.
+OpenDDS_Rtps_Export
+int from_param_list(DCPS::Serializer& ser,
+                    SPDPdiscoveredParticipantData& participant_data);
+
+OpenDDS_Rtps_Export
+int from_param_list(DCPS::Serializer& ser,
+                    DCPS::DiscoveredWriterData& writer_data);
+
+/// Also read the ICE parameters in the same pass.
+OpenDDS_Rtps_Export
+int from_param_list(DCPS::Serializer& ser,
+                    DCPS::DiscoveredWriterData& writer_data,
+                    ICE::AgentInfo& agent_info,
+                    bool& have_agent_info);
+
+OpenDDS_Rtps_Export
+int from_param_list(DCPS::Serializer& ser,
+                    DCPS::DiscoveredReaderData& reader_data);
+
+OpenDDS_Rtps_Export
+int from_param_list(DCPS::Serializer& ser,
+                    DCPS::DiscoveredReaderData& reader_data,
+                    ICE::AgentInfo& agent_info,
+                    bool& have_agent_info);
+
 }
 }
 }
@@ -53,6 +53,10 @@ RtpsDiscovery::RtpsDiscovery(const RepoKey& key)
   , default_multicast_group_("239.255.0.1") /*RTPS v2.1 9.6.1.4.1*/
   , use_ice_(false)
   , max_spdp_timer_period_(0, 10000)
+  , sedp_max_message_rate_(0)
+  , sedp_max_burst_(10)
+  , discovery_cache_(false)
+  , discovery_cache_lease_(60)
   , max_auth_time_(300, 0)
   , auth_resend_period_(1, 0)
 {
@@ -404,6 +408,95 @@ RtpsDiscovery::Config::discovery_config(ACE_Configuration_Heap& cf)
                               ACE_TEXT("[rtps_discovery/%C] section.\n"),
                               string_value.c_str(), rtps_name.c_str()), -1);
           }
+        } else if (name == "SpdpInitialJitter") {
+          // In milliseconds.
+          const OPENDDS_STRING& string_value = it->second;
+          int int_value;
+          if (DCPS::convertToInteger(string_value, int_value) && int_value >= 0) {
+            discovery->spdp_initial_jitter(ACE_Time_Value(0, int_value * 1000));
+          } else {
+            ACE_ERROR_RETURN((LM_ERROR,
+                              ACE_TEXT("(%P|%t) RtpsDiscovery::Config::discovery_config(): ")
+                              ACE_TEXT("Invalid entry (%C) for SpdpInitialJitter in ")
+                              ACE_TEXT("[rtps_discovery/%C] section.\n"),
+                              string_value.c_str(), rtps_name.c_str()), -1);
+          }
+        } else if (name == "SedpMaxMessageRate") {
+          // Messages per second.
+          const OPENDDS_STRING& string_value = it->second;
+          int int_value;
+          if (DCPS::convertToInteger(string_value, int_value) && int_value >= 0) {
+            discovery->sedp_max_message_rate(static_cast<unsigned int>(int_value));
+          } else {
+            ACE_ERROR_RETURN((LM_ERROR,
+                              ACE_TEXT("(%P|%t) RtpsDiscovery::Config::discovery_config(): ")
+                              ACE_TEXT("Invalid entry (%C) for SedpMaxMessageRate in ")
+                              ACE_TEXT("[rtps_discovery/%C] section.\n"),
+                              string_value.c_str(), rtps_name.c_str()), -1);
+          }
+        } else if (name == "SedpMaxBurst") {
+          // In messages.
+          const OPENDDS_STRING& string_value = it->second;
+          int int_value;
+          if (DCPS::convertToInteger(string_value, int_value) && int_value >= 0) {
+            discovery->sedp_max_burst(static_cast<unsigned int>(int_value));
+          } else {
+            ACE_ERROR_RETURN((LM_ERROR,
+                              ACE_TEXT("(%P|%t) RtpsDiscovery::Config::discovery_config(): ")
+                              ACE_TEXT("Invalid entry (%C) for SedpMaxBurst in ")
+                              ACE_TEXT("[rtps_discovery/%C] section.\n"),
+                              string_value.c_str(), rtps_name.c_str()), -1);
+          }
+        } else if (name == "SedpHeartbeatPeriod") {
+          // In milliseconds.
+          const OPENDDS_STRING& string_value = it->second;
+          int int_value;
+          if (DCPS::convertToInteger(string_value, int_value) && int_value >= 0) {
+            discovery->sedp_heartbeat_period(ACE_Time_Value(0, int_value * 1000));
+          } else {
+            ACE_ERROR_RETURN((LM_ERROR,
+                              ACE_TEXT("(%P|%t) RtpsDiscovery::Config::discovery_config(): ")
+                              ACE_TEXT("Invalid entry (%C) for SedpHeartbeatPeriod in ")
+                              ACE_TEXT("[rtps_discovery/%C] section.\n"),
+                              string_value.c_str(), rtps_name.c_str()), -1);
+          }
+        } else if (name == "DiscoveryCache") {
+          const OPENDDS_STRING& value = it->second;
+          int smInt;
+          if (!DCPS::convertToInteger(value, smInt)) {
+            ACE_ERROR_RETURN((LM_ERROR,
+                              ACE_TEXT("(%P|%t) RtpsDiscovery::Config::discovery_config ")
+                              ACE_TEXT("Invalid entry (%C) for DiscoveryCache in ")
+                              ACE_TEXT("[rtps_discovery/%C] section.\n"),
+                              value.c_str(), rtps_name.c_str()), -1);
+          }
+          discovery->discovery_cache(bool(smInt));
+        } else if (name == "DiscoveryCacheLease") {
+          // In seconds.
+          const OPENDDS_STRING& string_value = it->second;
+          int int_value;
+          if (DCPS::convertToInteger(string_value, int_value) && int_value > 0) {
+            discovery->discovery_cache_lease(ACE_Time_Value(int_value));
+          } else {
+            ACE_ERROR_RETURN((LM_ERROR,
+                              ACE_TEXT("(%P|%t) RtpsDiscovery::Config::discovery_config(): ")
+                              ACE_TEXT("Invalid entry (%C) for DiscoveryCacheLease in ")
+                              ACE_TEXT("[rtps_discovery/%C] section.\n"),
+                              string_value.c_str(), rtps_name.c_str()), -1);
+          }
+        } else if (name == "SedpNakResponseDelay") {
+          // In milliseconds.
+          const OPENDDS_STRING& string_value = it->second;
+          int int_value;
+          if (DCPS::convertToInteger(string_value, int_value) && int_value >= 0) {
+            discovery->sedp_nak_response_delay(ACE_Time_Value(0, int_value * 1000));
+          } else {
+            ACE_ERROR_RETURN((LM_ERROR,
+                              ACE_TEXT("(%P|%t) RtpsDiscovery::Config::discovery_config(): ")
+                              ACE_TEXT("Invalid entry (%C) for SedpNakResponseDelay in ")
+                              ACE_TEXT("[rtps_discovery/%C] section.\n"),
+                              string_value.c_str(), rtps_name.c_str()), -1);
+          }
         }  else {
           ACE_ERROR_RETURN((LM_ERROR,
                             ACE_TEXT("(%P|%t) RtpsDiscovery::Config::discovery_config(): ")
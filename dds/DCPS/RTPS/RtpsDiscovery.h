@@ -164,6 +164,27 @@ public:
   const ACE_Time_Value& max_spdp_timer_period() const { return max_spdp_timer_period_; }
   void max_spdp_timer_period(const ACE_Time_Value& x) { max_spdp_timer_period_ = x; }
 
+  const ACE_Time_Value& spdp_initial_jitter() const { return spdp_initial_jitter_; }
+  void spdp_initial_jitter(const ACE_Time_Value& x) { spdp_initial_jitter_ = x; }
+
+  unsigned int sedp_max_message_rate() const { return sedp_max_message_rate_; }
+  void sedp_max_message_rate(unsigned int x) { sedp_max_message_rate_ = x; }
+
+  unsigned int sedp_max_burst() const { return sedp_max_burst_; }
+  void sedp_max_burst(unsigned int x) { sedp_max_burst_ = x; }
+
+  const ACE_Time_Value& sedp_heartbeat_period() const { return sedp_heartbeat_period_; }
+  void sedp_heartbeat_period(const ACE_Time_Value& x) { sedp_heartbeat_period_ = x; }
+
+  const ACE_Time_Value& sedp_nak_response_delay() const { return sedp_nak_response_delay_; }
+  void sedp_nak_response_delay(const ACE_Time_Value& x) { sedp_nak_response_delay_ = x; }
+
+  bool discovery_cache() const { return discovery_cache_; }
+  void discovery_cache(bool x) { discovery_cache_ = x; }
+
+  const ACE_Time_Value& discovery_cache_lease() const { return discovery_cache_lease_; }
+  void discovery_cache_lease(const ACE_Time_Value& x) { discovery_cache_lease_ = x; }
+
   const ACE_Time_Value& max_auth_time() const { return max_auth_time_; }
   void max_auth_time(const ACE_Time_Value& x) { max_auth_time_ = x; }
 
@@ -184,6 +205,20 @@ private:
   ACE_INET_Addr sedp_stun_server_address_;
   bool use_ice_;
   ACE_Time_Value max_spdp_timer_period_;
+  /// Announcements are delayed by a random time up to this one, see Spdp.
+  ACE_Time_Value spdp_initial_jitter_;
+  /// Messages per second of the SEDP writers, 0 for no limit.
+  unsigned int sedp_max_message_rate_;
+  unsigned int sedp_max_burst_;
+  /// Zero for the rtps_udp transport's default.
+  ACE_Time_Value sedp_heartbeat_period_;
+  ACE_Time_Value sedp_nak_response_delay_;
+  /// Save the discovered participants and endpoints under
+  /// DCPSPersistentDataDir and preload them at startup, see DiscoveryCache.
+  bool discovery_cache_;
+  /// How long the preloaded participants and endpoints are kept without
+  /// being discovered again.
+  ACE_Time_Value discovery_cache_lease_;
   ACE_Time_Value max_auth_time_;
   ACE_Time_Value auth_resend_period_;
 
@@ -8,6 +8,7 @@
 #include "Sedp.h"
 
 #include "MessageTypes.h"
+#include "DiscoveryCache.h"
 #include "ParameterListConverter.h"
 #include "RtpsDiscovery.h"
 #include "RtpsCoreTypeSupportImpl.h"
@@ -183,33 +184,42 @@ Sedp::Sedp(const RepoId& participant_id, Spdp& owner, ACE_Thread_Mutex& lock) :
   DCPS::EndpointManager<ParticipantData_t>(participant_id, lock),
   spdp_(owner),
   publications_writer_(
-    make_id(participant_id, ENTITYID_SEDP_BUILTIN_PUBLICATIONS_WRITER), *this),
+    make_id(participant_id, ENTITYID_SEDP_BUILTIN_PUBLICATIONS_WRITER), *this,
+    DiscoveryPacer::PRIORITY_ENDPOINT),
 
 #ifdef OPENDDS_SECURITY
   publications_secure_writer_(
-    make_id(participant_id, ENTITYID_SEDP_BUILTIN_PUBLICATIONS_SECURE_WRITER), *this),
+    make_id(participant_id, ENTITYID_SEDP_BUILTIN_PUBLICATIONS_SECURE_WRITER), *this,
+    DiscoveryPacer::PRIORITY_ENDPOINT),
 #endif
 
   subscriptions_writer_(
-    make_id(participant_id, ENTITYID_SEDP_BUILTIN_SUBSCRIPTIONS_WRITER), *this),
+    make_id(participant_id, ENTITYID_SEDP_BUILTIN_SUBSCRIPTIONS_WRITER), *this,
+    DiscoveryPacer::PRIORITY_ENDPOINT),
 
 #ifdef OPENDDS_SECURITY
   subscriptions_secure_writer_(
-    make_id(participant_id, ENTITYID_SEDP_BUILTIN_SUBSCRIPTIONS_SECURE_WRITER), *this),
+    make_id(participant_id, ENTITYID_SEDP_BUILTIN_SUBSCRIPTIONS_SECURE_WRITER), *this,
+    DiscoveryPacer::PRIORITY_ENDPOINT),
 #endif
 
   participant_message_writer_(
-    make_id(participant_id, ENTITYID_P2P_BUILTIN_PARTICIPANT_MESSAGE_WRITER), *this),
+    make_id(participant_id, ENTITYID_P2P_BUILTIN_PARTICIPANT_MESSAGE_WRITER), *this,
+    DiscoveryPacer::PRIORITY_PARTICIPANT_MESSAGE),
 
 #ifdef OPENDDS_SECURITY
   participant_message_secure_writer_(
-    make_id(participant_id, ENTITYID_P2P_BUILTIN_PARTICIPANT_MESSAGE_SECURE_WRITER), *this),
+    make_id(participant_id, ENTITYID_P2P_BUILTIN_PARTICIPANT_MESSAGE_SECURE_WRITER), *this,
+    DiscoveryPacer::PRIORITY_PARTICIPANT_MESSAGE),
   participant_stateless_message_writer_(
-    make_id(participant_id, ENTITYID_P2P_BUILTIN_PARTICIPANT_STATELESS_WRITER), *this),
+    make_id(participant_id, ENTITYID_P2P_BUILTIN_PARTICIPANT_STATELESS_WRITER), *this,
+    DiscoveryPacer::PRIORITY_SECURITY),
   dcps_participant_secure_writer_(
-    make_id(participant_id, ENTITYID_SPDP_RELIABLE_BUILTIN_PARTICIPANT_SECURE_WRITER), *this),
+    make_id(participant_id, ENTITYID_SPDP_RELIABLE_BUILTIN_PARTICIPANT_SECURE_WRITER), *this,
+    DiscoveryPacer::PRIORITY_SECURITY),
   participant_volatile_message_secure_writer_(
-    make_id(participant_id, ENTITYID_P2P_BUILTIN_PARTICIPANT_VOLATILE_SECURE_WRITER), *this),
+    make_id(participant_id, ENTITYID_P2P_BUILTIN_PARTICIPANT_VOLATILE_SECURE_WRITER), *this,
+    DiscoveryPacer::PRIORITY_SECURITY),
 #endif
 
   publications_reader_(make_rch<Reader>(
@@ -267,6 +277,7 @@ Sedp::Sedp(const RepoId& participant_id, Spdp& owner, ACE_Thread_Mutex& lock) :
 {
   pub_bit_key_.value[0] = pub_bit_key_.value[1] = pub_bit_key_.value[2] = 0;
   sub_bit_key_.value[0] = sub_bit_key_.value[1] = sub_bit_key_.value[2] = 0;
+  cache_generation_ = 0;
 }
 
 RepoId
@@ -302,6 +313,14 @@ Sedp::init(const RepoId& guid,
   static const double HANDSHAKE_MULTIPLIER = 5;
   rtps_inst->handshake_timeout_ = disco.resend_period() * HANDSHAKE_MULTIPLIER;
 
+  if (disco.sedp_heartbeat_period() != ACE_Time_Value::zero) {
+    rtps_inst->heartbeat_period_ = disco.sedp_heartbeat_period();
+  }
+  if (disco.sedp_nak_response_delay() != ACE_Time_Value::zero) {
+    rtps_inst->nak_response_delay_ = disco.sedp_nak_response_delay();
+  }
+  pacer_.configure(disco.sedp_max_message_rate(), disco.sedp_max_burst());
+
   if (disco.sedp_multicast()) {
     // Bind to a specific multicast group
     const u_short mc_port = disco.pb() + disco.dg() * domainId + disco.dx();
@@ -635,6 +654,96 @@ Sedp::~Sedp()
   TheTransportRegistry->remove_inst(transport_inst_);
 }
 
+void
+Sedp::drain_paced(const ACE_Time_Value& now)
+{
+  pacer_.drain(now);
+}
+
+void
+Sedp::preload(const DiscoveryCache& cache, const ACE_Time_Value& deadline)
+{
+  {
+    ACE_GUARD(ACE_Thread_Mutex, g, lock_);
+    tentative_deadline_ = deadline;
+  }
+
+  for (size_t i = 0; i < cache.writers_.size(); ++i) {
+    data_received(DCPS::SAMPLE_DATA, DiscoveredPublication(cache.writers_[i]));
+    const RepoId& guid = cache.writers_[i].writerProxy.remoteWriterGuid;
+    ACE_GUARD(ACE_Thread_Mutex, g, lock_);
+    if (discovered_publications_.count(guid)) {
+      tentative_endpoints_.insert(guid);
+    }
+  }
+
+  for (size_t i = 0; i < cache.readers_.size(); ++i) {
+    data_received(DCPS::SAMPLE_DATA, DiscoveredSubscription(cache.readers_[i]));
+    const RepoId& guid = cache.readers_[i].readerProxy.remoteReaderGuid;
+    ACE_GUARD(ACE_Thread_Mutex, g, lock_);
+    if (discovered_subscriptions_.count(guid)) {
+      tentative_endpoints_.insert(guid);
+    }
+  }
+}
+
+void
+Sedp::expire_tentative_endpoints(const ACE_Time_Value& now)
+{
+  ACE_GUARD(ACE_Thread_Mutex, g, lock_);
+  if (tentative_endpoints_.empty() || now < tentative_deadline_) {
+    return;
+  }
+
+  DCPS::RepoIdSet expired;
+  std::swap(expired, tentative_endpoints_);
+  for (DCPS::RepoIdSet::const_iterator it = expired.begin(); it != expired.end(); ++it) {
+    if (DCPS::DCPS_debug_level > 1) {
+      ACE_DEBUG((LM_DEBUG,
+        ACE_TEXT("(%P|%t) Sedp::expire_tentative_endpoints - ")
+        ACE_TEXT("%C wasn't discovered again, removing\n"),
+        OPENDDS_STRING(DCPS::GuidConverter(*it)).c_str()));
+    }
+    // Copies, as the data is removed with the endpoint
+    const DiscoveredPublicationIter dpi = discovered_publications_.find(*it);
+    if (dpi != discovered_publications_.end()) {
+      const DCPS::DiscoveredWriterData wdata = dpi->second.writer_data_;
+      process_discovered_writer_data(DCPS::DISPOSE_UNREGISTER_INSTANCE, wdata, *it
+#ifdef OPENDDS_SECURITY
+                                     , false, ICE::AgentInfo()
+#endif
+                                     );
+      continue;
+    }
+    const DiscoveredSubscriptionIter dsi = discovered_subscriptions_.find(*it);
+    if (dsi != discovered_subscriptions_.end()) {
+      const DCPS::DiscoveredReaderData rdata = dsi->second.reader_data_;
+      process_discovered_reader_data(DCPS::DISPOSE_UNREGISTER_INSTANCE, rdata, *it
+#ifdef OPENDDS_SECURITY
+                                     , false, ICE::AgentInfo()
+#endif
+                                     );
+    }
+  }
+}
+
+void
+Sedp::cache_endpoints(DiscoveryCache& cache) const
+{
+  for (DiscoveredPublicationMap::const_iterator it = discovered_publications_.begin();
+       it != discovered_publications_.end(); ++it) {
+    if (!tentative_endpoints_.count(it->first)) {
+      cache.writers_.push_back(it->second.writer_data_);
+    }
+  }
+  for (DiscoveredSubscriptionMap::const_iterator it = discovered_subscriptions_.begin();
+       it != discovered_subscriptions_.end(); ++it) {
+    if (!tentative_endpoints_.count(it->first)) {
+      cache.readers_.push_back(it->second.reader_data_);
+    }
+  }
+}
+
 void
 Sedp::unicast_locators(DCPS::LocatorSeq& locators) const
 {
@@ -1531,6 +1640,7 @@ void
 Sedp::shutdown()
 {
   task_.shutdown();
+  pacer_.clear();
   publications_reader_->shutting_down_ = true;
   subscriptions_reader_->shutting_down_ = true;
   participant_message_reader_->shutting_down_ = true;
@@ -1694,6 +1804,7 @@ void Sedp::process_discovered_writer_data(DCPS::MessageId message_id,
 #endif
 
         DiscoveredPublication& pub = discovered_publications_[guid] = prepub;
+        ++cache_generation_;
 
         // Create a topic if necessary.
         OPENDDS_MAP(OPENDDS_STRING, TopicDetails)::iterator top_it = topics_.find(topic_name);
@@ -1793,6 +1904,7 @@ void Sedp::process_discovered_writer_data(DCPS::MessageId message_id,
                              ACE_TEXT("calling match_endpoints disp/unreg\n")));
       }
       discovered_publications_.erase(iter);
+      ++cache_generation_;
     }
   }
 }
@@ -1810,6 +1922,11 @@ Sedp::data_received(DCPS::MessageId message_id,
 
   ACE_GUARD(ACE_Thread_Mutex, g, lock_);
 
+  // Discovered again (or disposed) since it was preloaded
+  if (tentative_endpoints_.erase(guid)) {
+    ++cache_generation_;
+  }
+
   if (ignoring(guid)
       || ignoring(guid_participant)
       || ignoring(wdata.ddsPublicationData.topic_name)) {
@@ -2003,6 +2120,7 @@ void Sedp::process_discovered_reader_data(DCPS::MessageId message_id,
 #endif
 
         DiscoveredSubscription& sub = discovered_subscriptions_[guid] = presub;
+        ++cache_generation_;
 
         // Create a topic if necessary.
         OPENDDS_MAP(OPENDDS_STRING, TopicDetails)::iterator top_it = topics_.find(topic_name);
@@ -2143,6 +2261,7 @@ void Sedp::process_discovered_reader_data(DCPS::MessageId message_id,
       }
       remove_from_bit(iter->second);
       discovered_subscriptions_.erase(iter);
+      ++cache_generation_;
     }
   }
 }
@@ -2168,6 +2287,11 @@ Sedp::data_received(DCPS::MessageId message_id,
 
   ACE_GUARD(ACE_Thread_Mutex, g, lock_);
 
+  // Discovered again (or disposed) since it was preloaded
+  if (tentative_endpoints_.erase(guid)) {
+    ++cache_generation_;
+  }
+
   if (ignoring(guid)
       || ignoring(guid_participant)
       || ignoring(rdata.ddsSubscriptionData.topic_name)) {
@@ -2605,8 +2729,10 @@ Sedp::Endpoint::~Endpoint()
 }
 
 //---------------------------------------------------------------
-Sedp::Writer::Writer(const RepoId& pub_id, Sedp& sedp)
+Sedp::Writer::Writer(const RepoId& pub_id, Sedp& sedp,
+                     DiscoveryPacer::Priority priority)
   : Endpoint(pub_id, sedp)
+  , priority_(priority)
 {
   header_.prefix[0] = 'R';
   header_.prefix[1] = 'T';
@@ -2678,6 +2804,54 @@ Sedp::Writer::control_dropped(const DCPS::Message_Block_Ptr& /* sample */, bool)
 {
 }
 
+/// A sample that waits in the pacer to be sent.
+class Sedp::Writer::PacedSample : public DiscoveryPacer::Message {
+public:
+  PacedSample(Writer& writer, DCPS::DataSampleElement* element)
+    : writer_(writer)
+    , element_(element)
+  {}
+
+  ~PacedSample()
+  {
+    delete element_;
+  }
+
+  void send()
+  {
+    DCPS::SendStateDataSampleList list;
+    list.enqueue_tail(element_);
+    // The transport delivers or drops it.
+    element_ = 0;
+    writer_.send(list);
+  }
+
+private:
+  Writer& writer_;
+  DCPS::DataSampleElement* element_;
+};
+
+/// A control message that waits in the pacer to be sent.
+class Sedp::Writer::PacedControl : public DiscoveryPacer::Message {
+public:
+  PacedControl(Writer& writer, const DCPS::DataSampleHeader& header,
+               DCPS::Message_Block_Ptr payload)
+    : writer_(writer)
+    , header_(header)
+    , payload_(DCPS::move(payload))
+  {}
+
+  void send()
+  {
+    writer_.send_control(header_, DCPS::move(payload_));
+  }
+
+private:
+  Writer& writer_;
+  DCPS::DataSampleHeader header_;
+  DCPS::Message_Block_Ptr payload_;
+};
+
 void Sedp::Writer::send_sample(const ACE_Message_Block& data,
                                size_t size,
                                const RepoId& reader,
@@ -2697,6 +2871,11 @@ void Sedp::Writer::send_sample(const ACE_Message_Block& data,
     el->set_num_subs(1);
   }
 
+  if (sedp_.pacer_.enabled()) {
+    sedp_.pacer_.send(priority_, new PacedSample(*this, el), ACE_OS::gettimeofday());
+    return;
+  }
+
   DCPS::SendStateDataSampleList list;
   list.enqueue_tail(el);
 
@@ -2706,7 +2885,8 @@ void Sedp::Writer::send_sample(const ACE_Message_Block& data,
 DDS::ReturnCode_t
 Sedp::Writer::write_parameter_list(const ParameterList& plist,
                                    const RepoId& reader,
-                                   DCPS::SequenceNumber& sequence)
+                                   DCPS::SequenceNumber& sequence,
+                                   OPENDDS_VECTOR(char)* serialized)
 {
   DDS::ReturnCode_t result = DDS::RETCODE_OK;
 
@@ -2728,6 +2908,68 @@ Sedp::Writer::write_parameter_list(const ParameterList& plist,
             (ser << plist);
 
   if (ok) {
+    if (serialized) {
+      serialized->assign(payload.cont()->rd_ptr(), payload.cont()->wr_ptr());
+    }
+    send_sample(payload, size, reader, sequence, reader != GUID_UNKNOWN);
+
+  } else {
+    result = DDS::RETCODE_ERROR;
+  }
+
+  delete payload.cont();
+  return result;
+}
+
+namespace {
+  template <typename DiscoveredData>
+  bool add_discovered_data(ParameterListConverter::ParameterListWriter& params,
+                           const DiscoveredData& data,
+                           bool map,
+                           const ICE::AgentInfo* agent_info)
+  {
+    return ParameterListConverter::to_param_list(data, params, map) == 0
+      && (!agent_info || ParameterListConverter::to_param_list(*agent_info, params) == 0)
+      && params.finish();
+  }
+}
+
+template <typename DiscoveredData>
+DDS::ReturnCode_t
+Sedp::Writer::write_discovered_data(const DiscoveredData& data,
+                                    bool map,
+                                    const ICE::AgentInfo* agent_info,
+                                    const RepoId& reader,
+                                    DCPS::SequenceNumber& sequence,
+                                    OPENDDS_VECTOR(char)* serialized)
+{
+  // Determine message length with a pass that only counts
+  ParameterListConverter::ParameterListWriter sizer;
+  if (!add_discovered_data(sizer, data, map, agent_info)) {
+    return DDS::RETCODE_ERROR;
+  }
+  size_t size = 0, padding = 0;
+  DCPS::find_size_ulong(size, padding);
+  size += sizer.size();
+
+  // Build RTPS message
+  ACE_Message_Block payload(DCPS::DataSampleHeader::max_marshaled_size(),
+                            ACE_Message_Block::MB_DATA,
+                            new ACE_Message_Block(size));
+  using DCPS::Serializer;
+  Serializer ser(payload.cont(), host_is_bigendian_, Serializer::ALIGN_CDR);
+  ParameterListConverter::ParameterListWriter params(&ser);
+  const bool ok = (ser << ACE_OutputCDR::from_octet(0)) &&  // PL_CDR_LE = 0x0003
+                  (ser << ACE_OutputCDR::from_octet(3)) &&
+                  (ser << ACE_OutputCDR::from_octet(0)) &&
+                  (ser << ACE_OutputCDR::from_octet(0)) &&
+                  add_discovered_data(params, data, map, agent_info);
+
+  DDS::ReturnCode_t result = DDS::RETCODE_OK;
+  if (ok) {
+    if (serialized) {
+      serialized->assign(payload.cont()->rd_ptr(), payload.cont()->wr_ptr());
+    }
     send_sample(payload, size, reader, sequence, reader != GUID_UNKNOWN);
 
   } else {
@@ -2738,6 +2980,27 @@ Sedp::Writer::write_parameter_list(const ParameterList& plist,
   return result;
 }
 
+DDS::ReturnCode_t
+Sedp::Writer::write_serialized(const OPENDDS_VECTOR(char)& serialized,
+                               const RepoId& reader,
+                               DCPS::SequenceNumber& sequence)
+{
+  // The sample is copied since the transport may still hold the last one.
+  const size_t size = serialized.size();
+  ACE_Message_Block payload(DCPS::DataSampleHeader::max_marshaled_size(),
+                            ACE_Message_Block::MB_DATA,
+                            new ACE_Message_Block(size));
+  DDS::ReturnCode_t result = DDS::RETCODE_OK;
+  if (payload.cont()->copy(&serialized[0], size) == 0) {
+    send_sample(payload, size, reader, sequence, reader != GUID_UNKNOWN);
+  } else {
+    result = DDS::RETCODE_ERROR;
+  }
+
+  delete payload.cont();
+  return result;
+}
+
 DDS::ReturnCode_t
 Sedp::Writer::write_participant_message(const ParticipantMessageData& pmd,
                                         const RepoId& reader,
@@ -2953,6 +3216,12 @@ Sedp::Writer::write_control_msg(DCPS::Message_Block_Ptr payload,
 {
   DCPS::DataSampleHeader header;
   set_header_fields(header, size, GUID_UNKNOWN, seq, false, id);
+  // Paced with the samples, so it doesn't overtake them.
+  if (sedp_.pacer_.enabled()) {
+    sedp_.pacer_.send(priority_, new PacedControl(*this, header, DCPS::move(payload)),
+                      ACE_OS::gettimeofday());
+    return;
+  }
   // no need to serialize header since rtps_udp transport ignores it
   send_control(header, DCPS::move(payload));
 }
@@ -3020,6 +3289,32 @@ decode_parameter_list(const DCPS::ReceivedDataSample& sample,
   return true;
 }
 
+/// Read the DiscoveredWriterData or DiscoveredReaderData of @a sample
+/// straight from @a ser, with its ICE agent info in the same pass if
+/// @a agent_info isn't null.
+template <typename DiscoveredData>
+static bool
+decode_discovered_data(const DCPS::ReceivedDataSample& sample,
+                       DCPS::Serializer& ser,
+                       const ACE_CDR::Octet& encap,
+                       DiscoveredData& data,
+                       ICE::AgentInfo* agent_info = 0,
+                       bool* have_agent_info = 0)
+{
+  if (sample.header_.key_fields_only_ && encap < 2) {
+    ParameterList plist;
+    if (agent_info) {
+      *have_agent_info = false;
+    }
+    return decode_parameter_list(sample, ser, encap, plist)
+      && ParameterListConverter::from_param_list(plist, data) == 0;
+  }
+  if (agent_info) {
+    return ParameterListConverter::from_param_list(ser, data, *agent_info, *have_agent_info) == 0;
+  }
+  return ParameterListConverter::from_param_list(ser, data) == 0;
+}
+
 void
 Sedp::Reader::data_received(const DCPS::ReceivedDataSample& sample)
 {
@@ -3051,30 +3346,20 @@ Sedp::Reader::data_received(const DCPS::ReceivedDataSample& sample)
     // to determine whether or not to swap bytes.
 
     if (sample.header_.publication_id_.entityId == ENTITYID_SEDP_BUILTIN_PUBLICATIONS_WRITER) {
-      ParameterList data;
-      if (!decode_parameter_list(sample, ser, encap, data)) {
-        ACE_ERROR((LM_ERROR, ACE_TEXT("ERROR: Sedp::Reader::data_received - ")
-                   ACE_TEXT("failed to deserialize data\n")));
-        return;
-      }
-
       DCPS::unique_ptr<DiscoveredPublication> wdata(new DiscoveredPublication);
-      if (ParameterListConverter::from_param_list(data, wdata->writer_data_) < 0) {
-        ACE_ERROR((LM_ERROR,
-                   ACE_TEXT("(%P|%t) ERROR: Sedp::Reader::data_received - ")
-                   ACE_TEXT("failed to convert from ParameterList ")
-                   ACE_TEXT("to DiscoveredWriterData\n")));
-        return;
-      }
 #ifdef OPENDDS_SECURITY
-      if (ParameterListConverter::from_param_list(data, wdata->ice_agent_info_, wdata->have_ice_agent_info_) < 0) {
+      const bool decoded = decode_discovered_data(sample, ser, encap, wdata->writer_data_,
+                                                  &wdata->ice_agent_info_,
+                                                  &wdata->have_ice_agent_info_);
+#else
+      const bool decoded = decode_discovered_data(sample, ser, encap, wdata->writer_data_);
+#endif
+      if (!decoded) {
         ACE_ERROR((LM_ERROR,
                    ACE_TEXT("(%P|%t) ERROR: Sedp::Reader::data_received - ")
-                   ACE_TEXT("failed to convert from ParameterList ")
-                   ACE_TEXT("to ICE Agent info\n")));
+                   ACE_TEXT("failed to deserialize DiscoveredWriterData\n")));
         return;
       }
-#endif
       sedp_.task_.enqueue(id, move(wdata));
 
 #ifdef OPENDDS_SECURITY
@@ -3106,30 +3391,20 @@ Sedp::Reader::data_received(const DCPS::ReceivedDataSample& sample)
 #endif
 
     } else if (sample.header_.publication_id_.entityId == ENTITYID_SEDP_BUILTIN_SUBSCRIPTIONS_WRITER) {
-      ParameterList data;
-      if (!decode_parameter_list(sample, ser, encap, data)) {
-        ACE_ERROR((LM_ERROR, ACE_TEXT("ERROR: Sedp::Reader::data_received - ")
-                   ACE_TEXT("failed to deserialize data\n")));
-        return;
-      }
-
       DCPS::unique_ptr<DiscoveredSubscription> rdata(new DiscoveredSubscription);
-      if (ParameterListConverter::from_param_list(data, rdata->reader_data_) < 0) {
-        ACE_ERROR((LM_ERROR,
-                   ACE_TEXT("(%P|%t) ERROR Sedp::Reader::data_received - ")
-                   ACE_TEXT("failed to convert from ParameterList ")
-                   ACE_TEXT("to DiscoveredReaderData\n")));
-        return;
-      }
 #ifdef OPENDDS_SECURITY
-      if (ParameterListConverter::from_param_list(data, rdata->ice_agent_info_, rdata->have_ice_agent_info_) < 0) {
+      const bool decoded = decode_discovered_data(sample, ser, encap, rdata->reader_data_,
+                                                  &rdata->ice_agent_info_,
+                                                  &rdata->have_ice_agent_info_);
+#else
+      const bool decoded = decode_discovered_data(sample, ser, encap, rdata->reader_data_);
+#endif
+      if (!decoded) {
         ACE_ERROR((LM_ERROR,
-                   ACE_TEXT("(%P|%t) ERROR: Sedp::Reader::data_received - ")
-                   ACE_TEXT("failed to convert from ParameterList ")
-                   ACE_TEXT("to ICE Agent info\n")));
+                   ACE_TEXT("(%P|%t) ERROR Sedp::Reader::data_received - ")
+                   ACE_TEXT("failed to deserialize DiscoveredReaderData\n")));
         return;
       }
-#endif
       if (rdata->reader_data_.readerProxy.expectsInlineQos) {
         set_inline_qos(rdata->reader_data_.readerProxy.allLocators);
       }
@@ -3475,34 +3750,31 @@ Sedp::write_publication_data_unsecure(
     const RepoId& reader)
 {
   DDS::ReturnCode_t result = DDS::RETCODE_OK;
+  if (reader == GUID_UNKNOWN) {
+    // Written to every reader because the publication changed.
+    lp.serialized_.clear();
+  }
   if (spdp_.associated() && (reader != GUID_UNKNOWN ||
                              !associated_participants_.empty())) {
+    if (!lp.serialized_.empty()) {
+      return publications_writer_.write_serialized(lp.serialized_, reader, lp.sequence_);
+    }
+
     DCPS::DiscoveredWriterData dwd;
-    ParameterList plist;
     populate_discovered_writer_msg(dwd, rid, lp);
 
-    // Convert to parameter list
-    if (ParameterListConverter::to_param_list(dwd, plist, map_ipv4_to_ipv6())) {
-      ACE_ERROR((LM_ERROR,
-                 ACE_TEXT("(%P|%t) ERROR: Sedp::write_publication_data - ")
-                 ACE_TEXT("Failed to convert DiscoveredWriterData ")
-                 ACE_TEXT(" to ParameterList\n")));
-      result = DDS::RETCODE_ERROR;
-    }
+    const ICE::AgentInfo* agent_info = 0;
 #ifdef OPENDDS_SECURITY
     if (lp.have_ice_agent_info) {
-      if (ParameterListConverter::to_param_list(lp.ice_agent_info, plist)) {
-        ACE_ERROR((LM_ERROR,
-                   ACE_TEXT("(%P|%t) ERROR: Sedp::write_publication_data - ")
-                   ACE_TEXT("Failed to convert ICE Agent info ")
-                   ACE_TEXT("to ParameterList\n")));
-        result = DDS::RETCODE_ERROR;
-      }
+      agent_info = &lp.ice_agent_info;
     }
 #endif
-
-    if (DDS::RETCODE_OK == result) {
-      result = publications_writer_.write_parameter_list(plist, reader, lp.sequence_);
+    result = publications_writer_.write_discovered_data(dwd, map_ipv4_to_ipv6(), agent_info,
+                                                        reader, lp.sequence_, &lp.serialized_);
+    if (result != DDS::RETCODE_OK) {
+      ACE_ERROR((LM_ERROR,
+                 ACE_TEXT("(%P|%t) ERROR: Sedp::write_publication_data - ")
+                 ACE_TEXT("Failed to serialize DiscoveredWriterData\n")));
     }
   } else if (DCPS::DCPS_debug_level > 3) {
     ACE_DEBUG((LM_INFO, ACE_TEXT("(%P|%t) Sedp::write_publication_data - ")
@@ -3519,8 +3791,17 @@ Sedp::write_publication_data_secure(
     const RepoId& reader)
 {
   DDS::ReturnCode_t result = DDS::RETCODE_OK;
+  if (reader == GUID_UNKNOWN) {
+    // Written to every reader because the publication changed.
+    lp.serialized_.clear();
+  }
   if (spdp_.associated() && (reader != GUID_UNKNOWN ||
                              !associated_participants_.empty())) {
+    if (!lp.serialized_.empty()) {
+      RepoId effective_reader = reader;
+      effective_reader.entityId = ENTITYID_SEDP_BUILTIN_PUBLICATIONS_SECURE_READER;
+      return publications_secure_writer_.write_serialized(lp.serialized_, effective_reader, lp.sequence_);
+    }
 
     DiscoveredPublication_SecurityWrapper dwd;
     ParameterList plist;
@@ -3550,7 +3831,7 @@ Sedp::write_publication_data_secure(
       RepoId effective_reader = reader;
       if (reader != GUID_UNKNOWN)
         effective_reader.entityId = ENTITYID_SEDP_BUILTIN_PUBLICATIONS_SECURE_READER;
-      result = publications_secure_writer_.write_parameter_list(plist, effective_reader, lp.sequence_);
+      result = publications_secure_writer_.write_parameter_list(plist, effective_reader, lp.sequence_, &lp.serialized_);
     }
   } else if (DCPS::DCPS_debug_level > 3) {
     ACE_DEBUG((LM_INFO, ACE_TEXT("(%P|%t) Sedp::write_publication_data - ")
@@ -3610,33 +3891,31 @@ Sedp::write_subscription_data_unsecure(
     const RepoId& reader)
 {
   DDS::ReturnCode_t result = DDS::RETCODE_OK;
+  if (reader == GUID_UNKNOWN) {
+    // Written to every reader because the subscription changed.
+    ls.serialized_.clear();
+  }
   if (spdp_.associated() && (reader != GUID_UNKNOWN ||
                              !associated_participants_.empty())) {
+    if (!ls.serialized_.empty()) {
+      return subscriptions_writer_.write_serialized(ls.serialized_, reader, ls.sequence_);
+    }
+
     DCPS::DiscoveredReaderData drd;
-    ParameterList plist;
     populate_discovered_reader_msg(drd, rid, ls);
 
-    // Convert to parameter list
-    if (ParameterListConverter::to_param_list(drd, plist, map_ipv4_to_ipv6())) {
-      ACE_ERROR((LM_ERROR,
-                 ACE_TEXT("(%P|%t) ERROR: Sedp::write_subscription_data - ")
-                 ACE_TEXT("Failed to convert DiscoveredReaderData ")
-                 ACE_TEXT("to ParameterList\n")));
-      result = DDS::RETCODE_ERROR;
-    }
+    const ICE::AgentInfo* agent_info = 0;
 #ifdef OPENDDS_SECURITY
     if (ls.have_ice_agent_info) {
-      if (ParameterListConverter::to_param_list(ls.ice_agent_info, plist)) {
-        ACE_ERROR((LM_ERROR,
-                   ACE_TEXT("(%P|%t) ERROR: Sedp::write_subscription_data - ")
-                   ACE_TEXT("Failed to convert ICE Agent info ")
-                   ACE_TEXT("to ParameterList\n")));
-        result = DDS::RETCODE_ERROR;
-      }
+      agent_info = &ls.ice_agent_info;
     }
 #endif
-    if (DDS::RETCODE_OK == result) {
-      result = subscriptions_writer_.write_parameter_list(plist, reader, ls.sequence_);
+    result = subscriptions_writer_.write_discovered_data(drd, map_ipv4_to_ipv6(), agent_info,
+                                                         reader, ls.sequence_, &ls.serialized_);
+    if (result != DDS::RETCODE_OK) {
+      ACE_ERROR((LM_ERROR,
+                 ACE_TEXT("(%P|%t) ERROR: Sedp::write_subscription_data - ")
+                 ACE_TEXT("Failed to serialize DiscoveredReaderData\n")));
     }
   } else if (DCPS::DCPS_debug_level > 3) {
     ACE_DEBUG((LM_INFO, ACE_TEXT("(%P|%t) Sedp::write_subscription_data - ")
@@ -3653,8 +3932,17 @@ Sedp::write_subscription_data_secure(
     const RepoId& reader)
 {
   DDS::ReturnCode_t result = DDS::RETCODE_OK;
+  if (reader == GUID_UNKNOWN) {
+    // Written to every reader because the subscription changed.
+    ls.serialized_.clear();
+  }
   if (spdp_.associated() && (reader != GUID_UNKNOWN ||
                              !associated_participants_.empty())) {
+    if (!ls.serialized_.empty()) {
+      RepoId effective_reader = reader;
+      effective_reader.entityId = ENTITYID_SEDP_BUILTIN_SUBSCRIPTIONS_SECURE_READER;
+      return subscriptions_secure_writer_.write_serialized(ls.serialized_, effective_reader, ls.sequence_);
+    }
 
     DiscoveredSubscription_SecurityWrapper drd;
     ParameterList plist;
@@ -3684,7 +3972,7 @@ Sedp::write_subscription_data_secure(
       RepoId effective_reader = reader;
       if (reader != GUID_UNKNOWN)
         effective_reader.entityId = ENTITYID_SEDP_BUILTIN_SUBSCRIPTIONS_SECURE_READER;
-      result = subscriptions_secure_writer_.write_parameter_list(plist, effective_reader, ls.sequence_);
+      result = subscriptions_secure_writer_.write_parameter_list(plist, effective_reader, ls.sequence_, &ls.serialized_);
     }
   } else if (DCPS::DCPS_debug_level > 3) {
     ACE_DEBUG((LM_INFO, ACE_TEXT("(%P|%t) Sedp::write_subscription_data - ")
@@ -15,6 +15,7 @@
 #include "dds/DCPS/RTPS/RtpsCoreTypeSupportImpl.h"
 #include "dds/DCPS/RTPS/BaseMessageTypes.h"
 #include "dds/DCPS/RTPS/BaseMessageUtils.h"
+#include "dds/DCPS/RTPS/DiscoveryPacer.h"
 
 #include "dds/DCPS/RTPS/ICE/Ice.h"
 
@@ -55,6 +56,7 @@ namespace RTPS {
 class RtpsDiscovery;
 class Spdp;
 class WaitForAcks;
+struct DiscoveryCache;
 
 #ifdef OPENDDS_SECURITY
 struct DiscoveredPublication_SecurityWrapper;
@@ -88,6 +90,25 @@ public:
   void acknowledge();
 
   void shutdown();
+
+  /// Send the messages of the SEDP writers that the pacer has queued and
+  /// can now send.
+  void drain_paced(const ACE_Time_Value& now);
+
+  /// Add the endpoints of @a cache as if they had been discovered.  They
+  /// are tentative until they are discovered again and are removed by
+  /// expire_tentative_endpoints() if they aren't by @a deadline.
+  void preload(const DiscoveryCache& cache, const ACE_Time_Value& deadline);
+  void expire_tentative_endpoints(const ACE_Time_Value& now);
+
+  /// Add the discovered endpoints that aren't tentative to @a cache.
+  /// lock_ must be acquired before calling this.
+  void cache_endpoints(DiscoveryCache& cache) const;
+
+  /// Changes each time cache_endpoints() may give a different result.
+  /// lock_ must be acquired before calling this.
+  ACE_UINT64 cache_generation() const { return cache_generation_; }
+
   void unicast_locators(DCPS::LocatorSeq& locators) const;
 
   // @brief return the ip address we have bound to.
@@ -160,6 +181,19 @@ public:
 private:
   Spdp& spdp_;
 
+  /// Limits the rate of the messages of the writers below, see the
+  /// SedpMaxMessageRate and SedpMaxBurst discovery options.
+  DiscoveryPacer pacer_;
+
+  /// Discovered endpoints that were preloaded from the DiscoveryCache and
+  /// haven't been discovered again since.
+  DCPS::RepoIdSet tentative_endpoints_;
+  ACE_Time_Value tentative_deadline_;
+
+  /// Bumped (under lock_) when a discovered endpoint is added or removed
+  /// or stops being tentative.
+  ACE_UINT64 cache_generation_;
+
 #ifdef OPENDDS_SECURITY
   DDS::Security::ParticipantSecurityAttributes participant_sec_attr_;
 #endif
@@ -302,7 +336,8 @@ private:
 
   class Writer : public DCPS::TransportSendListener, public Endpoint {
   public:
-    Writer(const DCPS::RepoId& pub_id, Sedp& sedp);
+    Writer(const DCPS::RepoId& pub_id, Sedp& sedp,
+           DiscoveryPacer::Priority priority);
     virtual ~Writer();
 
     bool assoc(const DCPS::AssociationData& subscription);
@@ -330,9 +365,29 @@ private:
                      DCPS::SequenceNumber& sequence,
                      bool historic = false);
 
+    /// Write @a plist, and keep its serialized form in @a serialized if
+    /// it's not null.
     DDS::ReturnCode_t write_parameter_list(const ParameterList& plist,
                                            const DCPS::RepoId& reader,
-                                           DCPS::SequenceNumber& sequence);
+                                           DCPS::SequenceNumber& sequence,
+                                           OPENDDS_VECTOR(char)* serialized = 0);
+
+    /// Write the parameters of @a data, a DCPS::DiscoveredWriterData or
+    /// DCPS::DiscoveredReaderData, and those of @a agent_info if it's not
+    /// null, straight to the sample instead of through a ParameterList.
+    template <typename DiscoveredData>
+    DDS::ReturnCode_t write_discovered_data(const DiscoveredData& data,
+                                            bool map,
+                                            const ICE::AgentInfo* agent_info,
+                                            const DCPS::RepoId& reader,
+                                            DCPS::SequenceNumber& sequence,
+                                            OPENDDS_VECTOR(char)* serialized = 0);
+
+    /// Write a sample serialized by write_parameter_list() or
+    /// write_discovered_data().
+    DDS::ReturnCode_t write_serialized(const OPENDDS_VECTOR(char)& serialized,
+                                       const DCPS::RepoId& reader,
+                                       DCPS::SequenceNumber& sequence);
 
     DDS::ReturnCode_t write_participant_message(const ParticipantMessageData& pmd,
                                                 const DCPS::RepoId& reader,
@@ -359,6 +414,11 @@ private:
   private:
     Header header_;
     DCPS::SequenceNumber seq_;
+    /// The priority of the samples of this writer when they are paced.
+    DiscoveryPacer::Priority priority_;
+
+    class PacedSample;
+    class PacedControl;
 
     void write_control_msg(DCPS::Message_Block_Ptr payload,
                            size_t size,
@@ -8,6 +8,7 @@
 #include "Spdp.h"
 
 #include "BaseMessageTypes.h"
+#include "DiscoveryCache.h"
 #include "MessageTypes.h"
 #include "ParameterListConverter.h"
 #include "RtpsCoreTypeSupportImpl.h"
@@ -30,6 +31,7 @@
 
 #include "ace/Reactor.h"
 #include "ace/OS_NS_sys_socket.h" // For setsockopt()
+#include "ace/OS_NS_stdlib.h"
 
 #include <cstring>
 #include <stdexcept>
@@ -151,6 +153,8 @@ Spdp::Spdp(DDS::DomainId_t domain,
   , eh_shutdown_(false)
   , shutdown_cond_(lock_)
   , shutdown_flag_(false)
+  , discovery_generation_(0)
+  , saved_discovery_generation_(0)
   , sedp_(guid_, *this, lock_)
 #ifdef OPENDDS_SECURITY
   , security_config_()
@@ -186,6 +190,8 @@ Spdp::Spdp(DDS::DomainId_t domain,
   , eh_shutdown_(false)
   , shutdown_cond_(lock_)
   , shutdown_flag_(false)
+  , discovery_generation_(0)
+  , saved_discovery_generation_(0)
   , sedp_(guid_, *this, lock_)
   , security_config_(Security::SecurityRegistry::instance()->default_config())
   , security_enabled_(security_config_->get_authentication() && security_config_->get_access_control() && security_config_->get_crypto_key_factory() && security_config_->get_crypto_key_exchange())
@@ -360,6 +366,11 @@ Spdp::handle_participant_data(DCPS::MessageId id, const ParticipantData_t& cpdat
     return;
   }
 
+  // Announced (or disposed) since it was preloaded
+  if (tentative_participants_.erase(guid)) {
+    ++discovery_generation_;
+  }
+
   // Find the participant - iterator valid only as long as we hold the lock
   DiscoveredParticipantIter iter = participants_.find(guid);
 
@@ -386,6 +397,8 @@ Spdp::handle_participant_data(DCPS::MessageId id, const ParticipantData_t& cpdat
     // add a new participant
     participants_[guid] = DiscoveredParticipant(pdata, now);
     DiscoveredParticipant& dp = participants_[guid];
+    ++discovery_generation_;
+    lease_expirations_.schedule(guid, now + ACE_Time_Value(pdata.leaseDuration.seconds));
 
 #ifdef OPENDDS_SECURITY
     if (is_security_enabled()) {
@@ -402,8 +415,13 @@ Spdp::handle_participant_data(DCPS::MessageId id, const ParticipantData_t& cpdat
 #endif
 
     // Since we've just seen a new participant, let's send out our
-    // own announcement, so they don't have to wait.
-    this->tport_->write_i();
+    // own announcement, so they don't have to wait.  With a jitter, one
+    // announcement is sent for all the participants seen before it goes.
+    if (disco_->spdp_initial_jitter() == ACE_Time_Value::zero) {
+      this->tport_->write_i();
+    } else {
+      this->tport_->schedule_announcement(now);
+    }
 
 #ifdef OPENDDS_SECURITY
     if (is_security_enabled()) {
@@ -415,6 +433,7 @@ Spdp::handle_participant_data(DCPS::MessageId id, const ParticipantData_t& cpdat
           ACE_DEBUG((LM_DEBUG, ACE_TEXT("(%P|%t) DEBUG: Spdp::data_received - ")
             ACE_TEXT("Incompatible security attributes in discovered participant: %C\n"),
             std::string(DCPS::GuidConverter(guid)).c_str()));
+            lease_expirations_.cancel(guid);
             participants_.erase(guid);
         } else { // allow_unauthenticated_participants == true
           dp.auth_state_ = DCPS::AS_UNAUTHENTICATED;
@@ -432,6 +451,7 @@ Spdp::handle_participant_data(DCPS::MessageId id, const ParticipantData_t& cpdat
             ACE_DEBUG((LM_DEBUG, ACE_TEXT("(%P|%t) DEBUG: Spdp::data_received - ")
               ACE_TEXT("Incompatible security attributes in discovered participant: %C\n"),
               std::string(DCPS::GuidConverter(guid)).c_str()));
+            lease_expirations_.cancel(guid);
             participants_.erase(guid);
           } else { // allow_unauthenticated_participants == true
             dp.auth_state_ = DCPS::AS_UNAUTHENTICATED;
@@ -439,6 +459,7 @@ Spdp::handle_participant_data(DCPS::MessageId id, const ParticipantData_t& cpdat
           }
         } else if (dp.auth_state_ == DCPS::AS_AUTHENTICATED) {
           if (match_authenticated(guid, dp) == false) {
+            lease_expirations_.cancel(guid);
             participants_.erase(guid);
           }
         }
@@ -474,7 +495,9 @@ Spdp::handle_participant_data(DCPS::MessageId id, const ParticipantData_t& cpdat
       if (endpoint) {
         stop_ice(endpoint, iter->first, iter->second.pdata_.participantProxy.availableBuiltinEndpoints);
       }
+      lease_expirations_.cancel(guid);
       remove_discovered_participant(iter);
+      ++discovery_generation_;
       return;
     }
 
@@ -502,6 +525,10 @@ Spdp::handle_participant_data(DCPS::MessageId id, const ParticipantData_t& cpdat
     }
     // Participant may have been removed while lock released
     if (iter != participants_.end()) {
+      if (pdata.leaseDuration.seconds < iter->second.pdata_.leaseDuration.seconds) {
+        // The entry in lease_expirations_ may now be too late
+        lease_expirations_.schedule(guid, now + ACE_Time_Value(pdata.leaseDuration.seconds));
+      }
       iter->second.pdata_ = pdata;
       iter->second.last_seen_ = now;
     }
@@ -832,6 +859,7 @@ Spdp::check_auth_states(const ACE_Time_Value& tv) {
           stop_ice(endpoint, pit->first, pit->second.pdata_.participantProxy.availableBuiltinEndpoints);
         }
         remove_discovered_participant(pit);
+        ++discovery_generation_;
       } else {
         pit->second.auth_state_ = DCPS::AS_UNAUTHENTICATED;
         match_unauthenticated(*it, pit->second);
@@ -1134,33 +1162,44 @@ Spdp::remove_expired_participants()
 {
   // Find and remove any expired discovered participant
   ACE_GUARD (ACE_Thread_Mutex, g, lock_);
-  // Iterate through a copy of the repo Ids, rather than the map
-  //   as it gets unlocked in remove_discovered_participant()
-  DCPS::RepoIdSet participant_ids;
-  get_discovered_participant_ids(participant_ids);
-  for (DCPS::RepoIdSet::iterator participant_id = participant_ids.begin();
-       participant_id != participant_ids.end();
-       ++participant_id)
-  {
-    DiscoveredParticipantIter part = participants_.find(*participant_id);
-    if (part != participants_.end()) {
-      if (part->second.last_seen_ <
-          ACE_OS::gettimeofday() -
-          ACE_Time_Value(part->second.pdata_.leaseDuration.seconds)) {
-        if (DCPS::DCPS_debug_level > 1) {
-          DCPS::GuidConverter conv(part->first);
-          ACE_DEBUG((LM_WARNING,
-            ACE_TEXT("(%P|%t) Spdp::remove_expired_participants() - ")
-            ACE_TEXT("participant %C exceeded lease duration, removing\n"),
-            OPENDDS_STRING(conv).c_str()));
-        }
-        ICE::Endpoint* endpoint = sedp_.get_ice_endpoint();
-        if (endpoint) {
-          stop_ice(endpoint, part->first, part->second.pdata_.participantProxy.availableBuiltinEndpoints);
+  const ACE_Time_Value now = ACE_OS::gettimeofday();
+  // Take each entry that is due out of lease_expirations_ before looking
+  //   at its participant, as the lock can be released while removing it
+  DCPS::RepoId guid;
+  while (lease_expirations_.pop_due(now, guid)) {
+
+    // The participant may have been removed some other way
+    DiscoveredParticipantIter part = participants_.find(guid);
+    if (part == participants_.end()) {
+      continue;
+    }
 
-        }
-        remove_discovered_participant(part);
-      }
+    const ACE_Time_Value expiration = part->second.last_seen_ +
+      ACE_Time_Value(part->second.pdata_.leaseDuration.seconds);
+    if (expiration > now) {
+      // Seen since this entry was scheduled
+      lease_expirations_.schedule(guid, expiration);
+      continue;
+    }
+
+    if (DCPS::DCPS_debug_level > 1) {
+      DCPS::GuidConverter conv(part->first);
+      ACE_DEBUG((LM_WARNING,
+        ACE_TEXT("(%P|%t) Spdp::remove_expired_participants() - ")
+        ACE_TEXT("participant %C exceeded lease duration, removing\n"),
+        OPENDDS_STRING(conv).c_str()));
+    }
+    ICE::Endpoint* endpoint = sedp_.get_ice_endpoint();
+    if (endpoint) {
+      stop_ice(endpoint, part->first, part->second.pdata_.participantProxy.availableBuiltinEndpoints);
+
+    }
+    tentative_participants_.erase(guid);
+    remove_discovered_participant(part);
+    ++discovery_generation_;
+    if (participants_.find(guid) != participants_.end()) {
+      // Not removed yet, try again on the next pass
+      lease_expirations_.schedule(guid, now + disco_->resend_period());
     }
   }
 }
@@ -1170,11 +1209,103 @@ Spdp::init_bit(const DDS::Subscriber_var& bit_subscriber)
 {
   bit_subscriber_ = bit_subscriber;
   tport_->open();
+  load_discovery_cache();
+}
+
+void
+Spdp::load_discovery_cache()
+{
+  if (!disco_->discovery_cache()) {
+    return;
+  }
+#ifdef OPENDDS_SECURITY
+  if (is_security_enabled()) {
+    ACE_DEBUG((LM_WARNING,
+      ACE_TEXT("(%P|%t) WARNING: Spdp::load_discovery_cache() - ")
+      ACE_TEXT("DiscoveryCache is ignored with security\n")));
+    return;
+  }
+#endif
+
+  DiscoveryCache cache;
+  if (!cache.load(DiscoveryCache::path(TheServiceParticipant->persistent_data_dir().c_str(),
+                                       disco_->key(), domain_))) {
+    return;
+  }
+
+  const ACE_Time_Value lease = disco_->discovery_cache_lease();
+  for (size_t i = 0; i < cache.participants_.size(); ++i) {
+    ParticipantData_t& pdata = cache.participants_[i];
+    const RepoId guid = make_guid(pdata.participantProxy.guidPrefix, DCPS::ENTITYID_PARTICIPANT);
+    {
+      ACE_GUARD(ACE_Thread_Mutex, g, lock_);
+      if (participants_.count(guid)) {
+        // Already announced itself
+        continue;
+      }
+    }
+    pdata.leaseDuration.seconds = static_cast<CORBA::Long>(lease.sec());
+    handle_participant_data(DCPS::SAMPLE_DATA, pdata);
+    ACE_GUARD(ACE_Thread_Mutex, g, lock_);
+    if (participants_.count(guid)) {
+      tentative_participants_.insert(guid);
+    }
+  }
+
+  sedp_.preload(cache, ACE_OS::gettimeofday() + lease);
+
+  if (DCPS::DCPS_debug_level) {
+    ACE_DEBUG((LM_DEBUG,
+      ACE_TEXT("(%P|%t) Spdp::load_discovery_cache() - preloaded %B participants, ")
+      ACE_TEXT("%B writers and %B readers\n"), cache.participants_.size(),
+      cache.writers_.size(), cache.readers_.size()));
+  }
+}
+
+void
+Spdp::save_discovery_cache(bool force)
+{
+  if (!disco_->discovery_cache()) {
+    return;
+  }
+#ifdef OPENDDS_SECURITY
+  if (is_security_enabled()) {
+    return;
+  }
+#endif
+
+  ACE_GUARD(ACE_Thread_Mutex, save_guard, discovery_cache_lock_);
+  DiscoveryCache cache;
+  {
+    ACE_GUARD(ACE_Thread_Mutex, g, lock_);
+    // Checked before copying anything, as this runs on every resend
+    const ACE_UINT64 generation = discovery_generation_ + sedp_.cache_generation();
+    if (!force && generation == saved_discovery_generation_) {
+      return;
+    }
+    saved_discovery_generation_ = generation;
+
+    for (DiscoveredParticipantConstIter it = participants_.begin();
+         it != participants_.end(); ++it) {
+      if (!tentative_participants_.count(it->first)) {
+        cache.participants_.push_back(it->second.pdata_);
+      }
+    }
+    sedp_.cache_endpoints(cache);
+  }
+
+  // Written without lock_
+  cache.save(DiscoveryCache::path(TheServiceParticipant->persistent_data_dir().c_str(),
+                                  disco_->key(), domain_), guid_);
 }
 
 void
 Spdp::fini_bit()
 {
+  // The participant is going away; this is the last chance to save what
+  // it discovered, and it isn't done from the destructor.
+  save_discovery_cache(true);
+
   bit_subscriber_ = 0;
   wait_for_acks_.reset();
   // request for SpdpTransport(actually Reactor) thread and Sedp::Task
@@ -1321,6 +1452,8 @@ Spdp::build_local_pdata(
 
 bool Spdp::announce_domain_participant_qos()
 {
+  // The next announcement has the new QoS.
+  tport_->announcement_.clear();
 
 #ifdef OPENDDS_SECURITY
   if (is_security_enabled())
@@ -1334,6 +1467,8 @@ Spdp::SpdpTransport::SpdpTransport(Spdp* outer, bool securityGuids)
   : outer_(outer), lease_duration_(outer_->disco_->resend_period() * LEASE_MULT)
   , buff_(64 * 1024)
   , wbuff_(64 * 1024)
+  , announcement_offset_(0)
+  , jitter_seed_(0)
 {
   hdr_.prefix[0] = 'R';
   hdr_.prefix[1] = 'T';
@@ -1447,6 +1582,18 @@ Spdp::SpdpTransport::open()
   disco_resend_period_ = outer_->disco_->resend_period();
   last_disco_resend_ = 0;
 
+  if (outer_->disco_->spdp_initial_jitter() != ACE_Time_Value::zero) {
+    // Delay the first announcement instead of sending it from the first
+    // timeout.
+    ACE_GUARD(ACE_Thread_Mutex, g, outer_->lock_);
+    const ACE_Time_Value now = ACE_OS::gettimeofday();
+    jitter_seed_ = static_cast<unsigned int>(now.usec()) ^
+      (static_cast<unsigned int>(outer_->guid_.guidPrefix[10]) << 8 |
+       outer_->guid_.guidPrefix[11]);
+    last_disco_resend_ = now;
+    schedule_announcement(now);
+  }
+
   ACE_Time_Value timer_period = disco_resend_period_ < outer_->disco_->max_spdp_timer_period() ? disco_resend_period_ : outer_->disco_->max_spdp_timer_period();
 
   if (-1 == reactor->schedule_timer(this, 0, ACE_Time_Value(0), timer_period)) {
@@ -1553,38 +1700,80 @@ Spdp::SpdpTransport::write()
   write_i();
 }
 
-void
-Spdp::SpdpTransport::write_i()
+bool
+Spdp::SpdpTransport::write_announcement(DCPS::Serializer& ser)
 {
+  // Reuse the last announcement if the participant hasn't changed, and
+  // the headers before it haven't changed its alignment.
+  const size_t offset = wbuff_.length();
+  if (!announcement_.empty() && offset == announcement_offset_) {
+    if (wbuff_.copy(&announcement_[0], announcement_.size()) != 0) {
+      ACE_ERROR((LM_ERROR,
+        ACE_TEXT("(%P|%t) ERROR: Spdp::SpdpTransport::write() - ")
+        ACE_TEXT("failed to copy the SPDP announcement\n")));
+      return false;
+    }
+    return true;
+  }
+
   const ParticipantData_t pdata = outer_->build_local_pdata(
 #ifdef OPENDDS_SECURITY
      outer_->is_security_enabled() ? Security::DPDK_ENHANCED : Security::DPDK_ORIGINAL
 #endif
                                                             );
 
-  data_.writerSN.high = seq_.getHigh();
-  data_.writerSN.low = seq_.getLow();
-  ++seq_;
-
   ParameterList plist;
   if (ParameterListConverter::to_param_list(pdata, plist) < 0) {
     ACE_ERROR((LM_ERROR, ACE_TEXT("(%P|%t) ERROR: ")
       ACE_TEXT("Spdp::SpdpTransport::write() - ")
       ACE_TEXT("failed to convert from SPDPdiscoveredParticipantData ")
       ACE_TEXT("to ParameterList\n")));
+    return false;
+  }
+
+  CORBA::UShort options = 0;
+  if (!(ser << encap_LE) || !(ser << options) || !(ser << plist)) {
+    ACE_ERROR((LM_ERROR,
+      ACE_TEXT("(%P|%t) ERROR: Spdp::SpdpTransport::write() - ")
+      ACE_TEXT("failed to serialize headers for SPDP\n")));
+    return false;
+  }
+
+  announcement_.assign(wbuff_.rd_ptr() + offset, wbuff_.wr_ptr());
+  announcement_offset_ = offset;
+  return true;
+}
+
+void
+Spdp::SpdpTransport::schedule_announcement(const ACE_Time_Value& now)
+{
+  if (next_announcement_ != ACE_Time_Value::zero) {
     return;
   }
+  ACE_Time_Value delay = outer_->disco_->spdp_initial_jitter();
+  delay *= static_cast<double>(ACE_OS::rand_r(&jitter_seed_)) / RAND_MAX;
+  next_announcement_ = now + delay;
+}
+
+void
+Spdp::SpdpTransport::write_i()
+{
+  next_announcement_ = ACE_Time_Value::zero;
+  data_.writerSN.high = seq_.getHigh();
+  data_.writerSN.low = seq_.getLow();
+  ++seq_;
 
   wbuff_.reset();
-  CORBA::UShort options = 0;
   DCPS::Serializer ser(&wbuff_, false, DCPS::Serializer::ALIGN_CDR);
-  if (!(ser << hdr_) || !(ser << data_) || !(ser << encap_LE) || !(ser << options)
-      || !(ser << plist)) {
+  if (!(ser << hdr_) || !(ser << data_)) {
     ACE_ERROR((LM_ERROR,
       ACE_TEXT("(%P|%t) ERROR: Spdp::SpdpTransport::write() - ")
       ACE_TEXT("failed to serialize headers for SPDP\n")));
     return;
   }
+  if (!write_announcement(ser)) {
+    return;
+  }
 
   typedef OPENDDS_SET(ACE_INET_Addr)::const_iterator iter_t;
   for (iter_t iter = send_addrs_.begin(); iter != send_addrs_.end(); ++iter) {
@@ -1601,8 +1790,22 @@ Spdp::SpdpTransport::write_i()
 
   if (outer_->disco_->spdp_rtps_relay_address() != ACE_INET_Addr()) {
 #ifdef OPENDDS_SECURITY
+    // The ICE agent info can change at any time, so the announcement to
+    // the relay is rebuilt with it.
     ICE::Endpoint* endpoint = outer_->sedp_.get_ice_endpoint();
     if (endpoint) {
+      const ParticipantData_t pdata = outer_->build_local_pdata(
+         outer_->is_security_enabled() ? Security::DPDK_ENHANCED : Security::DPDK_ORIGINAL);
+
+      ParameterList plist;
+      if (ParameterListConverter::to_param_list(pdata, plist) < 0) {
+        ACE_ERROR((LM_ERROR, ACE_TEXT("(%P|%t) ERROR: ")
+                   ACE_TEXT("Spdp::SpdpTransport::write() - ")
+                   ACE_TEXT("failed to convert from SPDPdiscoveredParticipantData ")
+                   ACE_TEXT("to ParameterList\n")));
+        return;
+      }
+
       const ICE::AgentInfo& agent_info = ICE::Agent::instance()->get_local_agent_info(endpoint);
       if (ParameterListConverter::to_param_list(agent_info, plist) < 0) {
         ACE_ERROR((LM_ERROR, ACE_TEXT("(%P|%t) ERROR: ")
@@ -1611,19 +1814,19 @@ Spdp::SpdpTransport::write_i()
                    ACE_TEXT("to ParameterList\n")));
         return;
       }
-    }
-#endif
 
-    wbuff_.reset();
-    CORBA::UShort options = 0;
-    DCPS::Serializer ser(&wbuff_, false, DCPS::Serializer::ALIGN_CDR);
-    if (!(ser << hdr_) || !(ser << data_) || !(ser << encap_LE) || !(ser << options)
-        || !(ser << plist)) {
-      ACE_ERROR((LM_ERROR,
-                 ACE_TEXT("(%P|%t) ERROR: Spdp::SpdpTransport::write() - ")
-                 ACE_TEXT("failed to serialize headers for SPDP\n")));
-      return;
+      wbuff_.reset();
+      CORBA::UShort options = 0;
+      DCPS::Serializer ser(&wbuff_, false, DCPS::Serializer::ALIGN_CDR);
+      if (!(ser << hdr_) || !(ser << data_) || !(ser << encap_LE) || !(ser << options)
+          || !(ser << plist)) {
+        ACE_ERROR((LM_ERROR,
+                   ACE_TEXT("(%P|%t) ERROR: Spdp::SpdpTransport::write() - ")
+                   ACE_TEXT("failed to serialize headers for SPDP\n")));
+        return;
+      }
     }
+#endif
 
     const ssize_t res =
       unicast_socket_.send(wbuff_.rd_ptr(), wbuff_.length(), outer_->disco_->spdp_rtps_relay_address());
@@ -1643,9 +1846,18 @@ Spdp::SpdpTransport::handle_timeout(const ACE_Time_Value& tv, const void*)
   if (tv > last_disco_resend_ + disco_resend_period_) {
     write();
     outer_->remove_expired_participants();
+    outer_->sedp_.expire_tentative_endpoints(tv);
+    outer_->save_discovery_cache(false);
     last_disco_resend_ = tv;
+  } else if (outer_->disco_->spdp_initial_jitter() != ACE_Time_Value::zero) {
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, g, outer_->lock_, 0);
+    if (next_announcement_ != ACE_Time_Value::zero && tv >= next_announcement_) {
+      write_i();
+    }
   }
 
+  outer_->sedp_.drain_paced(tv);
+
 #ifdef OPENDDS_SECURITY
   outer_->check_auth_states(tv);
 #endif
@@ -2024,6 +2236,7 @@ Spdp::remove_sedp_unicast(const ACE_INET_Addr& addr)
   }
 
   sedp_unicast_ = new_sedp_unicast;
+  tport_->announcement_.clear();
 }
 
 void
@@ -2037,6 +2250,7 @@ Spdp::add_sedp_unicast(const ACE_INET_Addr& addr)
   const CORBA::ULong idx = sedp_unicast_.length();
   sedp_unicast_.length(idx + 1);
   sedp_unicast_[idx] = locator;
+  tport_->announcement_.clear();
 }
 
 void Spdp::start_ice(ICE::Endpoint* endpoint, RepoId r, const BuiltinEndpointSet_t& avail, const ICE::AgentInfo& agent_info) {
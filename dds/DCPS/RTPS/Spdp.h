@@ -20,6 +20,7 @@
 
 #include "RtpsCoreC.h"
 #include "Sedp.h"
+#include "LeaseExpirations.h"
 #include "rtps_export.h"
 
 #include "ace/Atomic_Op.h"
@@ -179,6 +180,8 @@ private:
     void open();
     void write();
     void write_i();
+    void schedule_announcement(const ACE_Time_Value& now);
+    bool write_announcement(DCPS::Serializer& ser);
     void close();
     void dispose_unregister();
     bool open_unicast_socket(u_short port_common, u_short participant_id);
@@ -195,8 +198,19 @@ private:
     ACE_SOCK_Dgram_Mcast multicast_socket_;
     OPENDDS_SET(ACE_INET_Addr) send_addrs_;
     ACE_Message_Block buff_, wbuff_;
+    /// The encapsulation and parameter list of the last announcement as
+    /// serialized at announcement_offset_ of wbuff_.  They only change
+    /// with the local participant, which clears them to have them rebuilt.
+    OPENDDS_VECTOR(char) announcement_;
+    size_t announcement_offset_;
     ACE_Time_Value disco_resend_period_;
     ACE_Time_Value last_disco_resend_;
+    /// With an SpdpInitialJitter, the time of the announcement that
+    /// schedule_announcement() delayed (zero if there is none), so the
+    /// participants that start or are discovered together don't all
+    /// announce at once.
+    ACE_Time_Value next_announcement_;
+    unsigned int jitter_seed_;
   } *tport_;
 
   ACE_Event_Handler_var eh_; // manages our refcount on tport_
@@ -204,9 +218,33 @@ private:
   ACE_Condition_Thread_Mutex shutdown_cond_;
   ACE_Atomic_Op<ACE_Thread_Mutex, bool> shutdown_flag_; // Spdp shutting down
 
+  /// With the DiscoveryCache option, preload the participants and
+  /// endpoints that were discovered when the domain was last used.
+  void load_discovery_cache();
+  /// Save the discovered participants and endpoints for the next start,
+  /// unless @a force is false and none were added or removed since they
+  /// were last saved.
+  void save_discovery_cache(bool force);
+
+  /// Participants preloaded by load_discovery_cache() that haven't
+  /// announced themselves since.
+  DCPS::RepoIdSet tentative_participants_;
+
+  /// Bumped (under lock_) when a participant is added or removed or stops
+  /// being tentative.
+  ACE_UINT64 discovery_generation_;
+  /// discovery_generation_ plus Sedp::cache_generation() as of the last save.
+  ACE_UINT64 saved_discovery_generation_;
+  /// Serializes the saves, which write the file without lock_.
+  ACE_Thread_Mutex discovery_cache_lock_;
+
   void remove_expired_participants();
   void get_discovered_participant_ids(DCPS::RepoIdSet& results) const;
 
+  /// Announcements just update last_seen_; an entry that comes due for a
+  /// participant that was seen since is moved to its new expiration.
+  LeaseExpirations lease_expirations_;
+
   Sedp sedp_;
   // wait for acknowledgments from SpdpTransport and Sedp::Task
   // when BIT is being removed (fini_bit)
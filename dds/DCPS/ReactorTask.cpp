@@ -28,6 +28,7 @@ OpenDDS::DCPS::ReactorTask::ReactorTask(bool useAsyncSend)
   , reactor_owner_(ACE_OS::NULL_thread)
   , proactor_(0)
   , use_async_send_(useAsyncSend)
+  , cpu_(-1)
 {
 }
 
@@ -124,6 +125,7 @@ OpenDDS::DCPS::ReactorTask::svc()
                "(%P|%t) ERROR: Failed to change the reactor's owner().\n"));
   }
   reactor_owner_ = ACE_Thread_Manager::instance()->thr_self();
+  bind_to_cpu();
   wait_for_startup();
 
 
@@ -181,6 +183,32 @@ OpenDDS::DCPS::ReactorTask::close(u_long flags)
   return 0;
 }
 
+void
+OpenDDS::DCPS::ReactorTask::bind_to_cpu()
+{
+  if (cpu_ < 0) {
+    return;
+  }
+
+#if defined ACE_HAS_CPU_SET_T
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  CPU_SET(cpu_, &cpus);
+
+  ACE_hthread_t self;
+  ACE_OS::thr_self(self);
+  if (ACE_OS::thr_setaffinity(self, sizeof cpus, &cpus) != 0) {
+    ACE_ERROR((LM_WARNING,
+               "(%P|%t) WARNING: ReactorTask::bind_to_cpu could not bind "
+               "the reactor thread to cpu %d: %p\n", cpu_, "thr_setaffinity"));
+  }
+#else
+  ACE_ERROR((LM_WARNING,
+             "(%P|%t) WARNING: ReactorTask::bind_to_cpu binding threads "
+             "to a cpu is not supported on this platform\n"));
+#endif
+}
+
 void
 OpenDDS::DCPS::ReactorTask::stop()
 {
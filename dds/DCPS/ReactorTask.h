@@ -49,6 +49,10 @@ public:
 
   void wait_for_startup() { barrier_.wait(); }
 
+  /// Bind the reactor thread to @a cpu once it starts; a negative value
+  /// (the default) leaves the thread unbound.  Must be called before open().
+  void cpu_affinity(int cpu) { cpu_ = cpu; }
+
   bool is_shut_down() const { return state_ == STATE_NOT_RUNNING; }
 
   OPENDDS_POOL_ALLOCATION_FWD
@@ -69,6 +73,9 @@ private:
   ACE_thread_t  reactor_owner_;
   ACE_Proactor* proactor_;
   bool          use_async_send_;
+  int           cpu_;
+
+  void bind_to_cpu();
 };
 
 } // namespace DCPS
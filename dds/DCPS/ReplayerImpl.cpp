@@ -845,6 +845,23 @@ ReplayerImpl::get_priority_value(const AssociationData&) const
   return this->qos_.transport_priority.value;
 }
 
+Priority
+ReplayerImpl::transport_priority() const
+{
+  return get_priority_value(AssociationData());
+}
+
+ACE_Time_Value
+ReplayerImpl::max_blocking_time() const
+{
+  const DDS::Duration_t& duration = qos_.reliability.max_blocking_time;
+  if (duration.sec == DDS::DURATION_INFINITE_SEC &&
+      duration.nanosec == DDS::DURATION_INFINITE_NSEC) {
+    return ACE_Time_Value::max_time;
+  }
+  return duration_to_time_value(duration);
+}
+
 void
 ReplayerImpl::data_delivered(const DataSampleElement* sample)
 {
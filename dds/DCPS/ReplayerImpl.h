@@ -109,6 +109,8 @@ public:
   virtual CORBA::Long get_priority_value(const AssociationData& data) const;
 
   // Implement TransportSendListener
+  virtual Priority transport_priority() const;
+  virtual ACE_Time_Value max_blocking_time() const;
   virtual void data_delivered(const DataSampleElement* sample);
   virtual void data_dropped(const DataSampleElement* sample,
                             bool                         dropped_by_transport);
@@ -308,6 +308,9 @@ public:
 
   ACE_CString default_address() const;
 
+  /// The DCPSPersistentDataDir directory.
+  ACE_CString persistent_data_dir() const;
+
 #ifndef OPENDDS_NO_PERSISTENCE_PROFILE
   /// Get the data durability cache corresponding to the given
   /// DurabilityQosPolicy and sample list depth.
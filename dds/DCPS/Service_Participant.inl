@@ -355,6 +355,13 @@ Service_Participant::default_address() const
   return this->default_address_;
 }
 
+ACE_INLINE
+ACE_CString
+Service_Participant::persistent_data_dir() const
+{
+  return this->persistent_data_dir_;
+}
+
 ACE_INLINE
 bool
 Service_Participant::use_bidir_giop() const
@@ -10,7 +10,10 @@
 #include "dds/DCPS/Registered_Data_Types.h"
 #include "dds/DCPS/Qos_Helper.h"
 #include "dds/DCPS/DataWriterImpl.h"
+#include "dds/DCPS/SafetyProfileStreams.h"
+#include "dds/DCPS/Serializer.h"
 #include "dds/DCPS/transport/framework/TransportRegistry.h"
+#include "dds/DdsDcpsInfoUtilsTypeSupportImpl.h"
 
 #include <ctype.h>
 
@@ -71,6 +74,301 @@ void EndpointRegistry::match()
   }
 }
 
+namespace {
+  /// The blobs of the tables are little-endian CDR.
+  const bool swap_bytes = !ACE_CDR_BYTE_ORDER;
+
+  template <typename T>
+  const T* data_or_null(const OPENDDS_VECTOR(T)& v)
+  {
+    return v.empty() ? 0 : &v[0];
+  }
+
+  template <typename T>
+  bool from_blob(const StaticDiscoveryBlob& blob, T& value)
+  {
+    ACE_Message_Block mb(reinterpret_cast<const char*>(blob.data), blob.size);
+    mb.wr_ptr(blob.size);
+    Serializer ser(&mb, swap_bytes, Serializer::ALIGN_CDR);
+    return ser >> value;
+  }
+
+  /// @a s as the contents of a C string literal.
+  OPENDDS_STRING escape(const OPENDDS_STRING& s)
+  {
+    OPENDDS_STRING result;
+    for (size_t i = 0; i < s.size(); ++i) {
+      if (s[i] == '"' || s[i] == '\\') {
+        result += '\\';
+      }
+      result += s[i];
+    }
+    return result;
+  }
+
+  void append_bytes(OPENDDS_STRING& out, const unsigned char* data, size_t size)
+  {
+    for (size_t i = 0; i < size; ++i) {
+      out += (i % 12 == 0) ? "\n  " : " ";
+      out += "0x" + to_dds_string(static_cast<unsigned int>(data[i]), true) + ",";
+    }
+  }
+
+  void append_blobs(OPENDDS_STRING& out, const char* name,
+                    const OPENDDS_VECTOR(StaticDiscoveryBlob)& blobs)
+  {
+    if (blobs.empty()) {
+      return;
+    }
+    for (size_t i = 0; i < blobs.size(); ++i) {
+      out += "const unsigned char " + OPENDDS_STRING(name) + "_" + to_dds_string(i) + "[] = {";
+      append_bytes(out, blobs[i].data, blobs[i].size);
+      out += "\n};\n";
+    }
+    out += "const OpenDDS::DCPS::StaticDiscoveryBlob " + OPENDDS_STRING(name) + "[] = {\n";
+    for (size_t i = 0; i < blobs.size(); ++i) {
+      const OPENDDS_STRING blob = OPENDDS_STRING(name) + "_" + to_dds_string(i);
+      out += "  { " + blob + ", sizeof " + blob + " },\n";
+    }
+    out += "};\n\n";
+  }
+
+  /// The pointer and count members of StaticDiscoveryTables for @a name.
+  OPENDDS_STRING table_member(const char* name, size_t count)
+  {
+    return count ? OPENDDS_STRING("  ") + name + ", " + to_dds_string(count) + ",\n"
+      : OPENDDS_STRING("  0, 0,\n");
+  }
+}
+
+template <typename T>
+unsigned int
+StaticDiscoveryTableBuilder::Blobs::add(const T& value, bool& good)
+{
+  size_t size = 0, padding = 0;
+  gen_find_size(value, size, padding);
+  ACE_Message_Block mb(size + padding);
+  Serializer ser(&mb, swap_bytes, Serializer::ALIGN_CDR);
+  if (!(ser << value)) {
+    good = false;
+    return 0;
+  }
+  const Bytes bytes(mb.rd_ptr(), mb.wr_ptr());
+  const OPENDDS_MAP(Bytes, unsigned int)::const_iterator pos = index.find(bytes);
+  if (pos != index.end()) {
+    return pos->second;
+  }
+  const unsigned int i = static_cast<unsigned int>(data.size());
+  data.push_back(bytes);
+  index[bytes] = i;
+  return i;
+}
+
+void
+StaticDiscoveryTableBuilder::Blobs::finish()
+{
+  // data doesn't change any more, so the blobs can point into it
+  blobs.resize(data.size());
+  for (size_t i = 0; i < data.size(); ++i) {
+    blobs[i].data = data_or_null(data[i]);
+    blobs[i].size = static_cast<unsigned int>(data[i].size());
+  }
+}
+
+StaticDiscoveryTableBuilder::StaticDiscoveryTableBuilder(const EndpointRegistry& registry)
+  : good_(true)
+{
+  // topics_ and endpoints_ point into strings_, which mustn't reallocate
+  strings_.reserve(3 * registry.topic_map.size() +
+                   registry.writer_map.size() + registry.reader_map.size());
+  add_topics(registry);
+
+  typedef OPENDDS_MAP_CMP(RepoId, unsigned int, GUID_tKeyLessThan) IndexMap;
+  IndexMap index;
+
+  for (EndpointRegistry::WriterMapType::const_iterator pos = registry.writer_map.begin(),
+         limit = registry.writer_map.end(); pos != limit; ++pos) {
+    const EndpointRegistry::Writer& writer = pos->second;
+    StaticDiscoveryEndpoint endpoint;
+    std::memcpy(endpoint.guid, pos->first.guidPrefix, sizeof(GuidPrefix_t));
+    std::memcpy(endpoint.guid + sizeof(GuidPrefix_t), pos->first.entityId.entityKey, 3);
+    endpoint.guid[15] = pos->first.entityId.entityKind;
+    endpoint.writer = true;
+    endpoint.topic = topic(writer.topic_name);
+    // The user data is the entity key, set again when the tables are loaded
+    DDS::DataWriterQos qos(writer.qos);
+    qos.user_data.value.length(0);
+    endpoint.qos = writer_qos_.add(qos, good_);
+    endpoint.group_qos = publisher_qos_.add(writer.publisher_qos, good_);
+    endpoint.locators = locators_.add(writer.trans_info, good_);
+    strings_.push_back(writer.trans_cfg);
+    endpoint.config = strings_.back().c_str();
+    index[pos->first] = static_cast<unsigned int>(endpoints_.size());
+    endpoints_.push_back(endpoint);
+  }
+
+  for (EndpointRegistry::ReaderMapType::const_iterator pos = registry.reader_map.begin(),
+         limit = registry.reader_map.end(); pos != limit; ++pos) {
+    const EndpointRegistry::Reader& reader = pos->second;
+    StaticDiscoveryEndpoint endpoint;
+    std::memcpy(endpoint.guid, pos->first.guidPrefix, sizeof(GuidPrefix_t));
+    std::memcpy(endpoint.guid + sizeof(GuidPrefix_t), pos->first.entityId.entityKey, 3);
+    endpoint.guid[15] = pos->first.entityId.entityKind;
+    endpoint.writer = false;
+    endpoint.topic = topic(reader.topic_name);
+    DDS::DataReaderQos qos(reader.qos);
+    qos.user_data.value.length(0);
+    endpoint.qos = reader_qos_.add(qos, good_);
+    endpoint.group_qos = subscriber_qos_.add(reader.subscriber_qos, good_);
+    endpoint.locators = locators_.add(reader.trans_info, good_);
+    strings_.push_back(reader.trans_cfg);
+    endpoint.config = strings_.back().c_str();
+    index[pos->first] = static_cast<unsigned int>(endpoints_.size());
+    endpoints_.push_back(endpoint);
+  }
+
+  // A match is in both the writer's and the reader's sets, so the
+  // writers' are enough.
+  for (EndpointRegistry::WriterMapType::const_iterator pos = registry.writer_map.begin(),
+         limit = registry.writer_map.end(); pos != limit; ++pos) {
+    const unsigned int writer = index[pos->first];
+    for (int reliable = 0; reliable != 2; ++reliable) {
+      const EndpointRegistry::RepoIdSetType& readers =
+        reliable ? pos->second.reliable_readers : pos->second.best_effort_readers;
+      for (EndpointRegistry::RepoIdSetType::const_iterator r = readers.begin();
+           r != readers.end(); ++r) {
+        const IndexMap::const_iterator reader = index.find(*r);
+        if (reader != index.end()) {
+          const StaticDiscoveryMatch match = { writer, reader->second, reliable != 0 };
+          matches_.push_back(match);
+        }
+      }
+    }
+  }
+
+  writer_qos_.finish();
+  reader_qos_.finish();
+  publisher_qos_.finish();
+  subscriber_qos_.finish();
+  locators_.finish();
+
+  tables_.topics = data_or_null(topics_);
+  tables_.topic_count = static_cast<unsigned int>(topics_.size());
+  tables_.writer_qos = data_or_null(writer_qos_.blobs);
+  tables_.writer_qos_count = static_cast<unsigned int>(writer_qos_.blobs.size());
+  tables_.reader_qos = data_or_null(reader_qos_.blobs);
+  tables_.reader_qos_count = static_cast<unsigned int>(reader_qos_.blobs.size());
+  tables_.publisher_qos = data_or_null(publisher_qos_.blobs);
+  tables_.publisher_qos_count = static_cast<unsigned int>(publisher_qos_.blobs.size());
+  tables_.subscriber_qos = data_or_null(subscriber_qos_.blobs);
+  tables_.subscriber_qos_count = static_cast<unsigned int>(subscriber_qos_.blobs.size());
+  tables_.locators = data_or_null(locators_.blobs);
+  tables_.locator_count = static_cast<unsigned int>(locators_.blobs.size());
+  tables_.endpoints = data_or_null(endpoints_);
+  tables_.endpoint_count = static_cast<unsigned int>(endpoints_.size());
+  tables_.matches = data_or_null(matches_);
+  tables_.match_count = static_cast<unsigned int>(matches_.size());
+}
+
+void
+StaticDiscoveryTableBuilder::add_topics(const EndpointRegistry& registry)
+{
+  for (EndpointRegistry::TopicMapType::const_iterator pos = registry.topic_map.begin(),
+         limit = registry.topic_map.end(); pos != limit; ++pos) {
+    const size_t first = strings_.size();
+    strings_.push_back(pos->first);
+    strings_.push_back(pos->second.name);
+    strings_.push_back(pos->second.type_name);
+    const StaticDiscoveryTopic topic = {
+      strings_[first].c_str(), strings_[first + 1].c_str(), strings_[first + 2].c_str()
+    };
+    // Endpoints refer to their topic by name
+    topic_index_.insert(std::make_pair(pos->second.name,
+                                       static_cast<unsigned int>(topics_.size())));
+    topics_.push_back(topic);
+  }
+}
+
+unsigned int
+StaticDiscoveryTableBuilder::topic(const OPENDDS_STRING& name)
+{
+  const OPENDDS_MAP(OPENDDS_STRING, unsigned int)::const_iterator pos = topic_index_.find(name);
+  if (pos == topic_index_.end()) {
+    ACE_ERROR((LM_ERROR,
+               ACE_TEXT("(%P|%t) ERROR: StaticDiscoveryTableBuilder - ")
+               ACE_TEXT("no topic named %C\n"), name.c_str()));
+    good_ = false;
+    return 0;
+  }
+  return pos->second;
+}
+
+OPENDDS_STRING
+StaticDiscoveryTableBuilder::to_cpp(const OPENDDS_STRING& name) const
+{
+  OPENDDS_STRING out =
+    "// Generated by static_discovery_tables, do not edit.\n"
+    "\n"
+    "#include \"dds/DCPS/StaticDiscoveryTables.h\"\n"
+    "\n"
+    "namespace {\n"
+    "\n";
+
+  if (!topics_.empty()) {
+    out += "const OpenDDS::DCPS::StaticDiscoveryTopic topics[] = {\n";
+    for (size_t i = 0; i < topics_.size(); ++i) {
+      out += "  { \"" + escape(topics_[i].key) + "\", \"" + escape(topics_[i].name) +
+        "\", \"" + escape(topics_[i].type_name) + "\" },\n";
+    }
+    out += "};\n\n";
+  }
+
+  append_blobs(out, "writer_qos", writer_qos_.blobs);
+  append_blobs(out, "reader_qos", reader_qos_.blobs);
+  append_blobs(out, "publisher_qos", publisher_qos_.blobs);
+  append_blobs(out, "subscriber_qos", subscriber_qos_.blobs);
+  append_blobs(out, "locators", locators_.blobs);
+
+  if (!endpoints_.empty()) {
+    out += "const OpenDDS::DCPS::StaticDiscoveryEndpoint endpoints[] = {\n";
+    for (size_t i = 0; i < endpoints_.size(); ++i) {
+      const StaticDiscoveryEndpoint& e = endpoints_[i];
+      out += "  { {";
+      append_bytes(out, e.guid, sizeof e.guid);
+      out += "\n    }, " + OPENDDS_STRING(e.writer ? "true" : "false") +
+        ", " + to_dds_string(e.topic) + ", " + to_dds_string(e.qos) +
+        ", " + to_dds_string(e.group_qos) + ", " + to_dds_string(e.locators) +
+        ", \"" + escape(e.config) + "\" },\n";
+    }
+    out += "};\n\n";
+  }
+
+  if (!matches_.empty()) {
+    out += "const OpenDDS::DCPS::StaticDiscoveryMatch matches[] = {\n";
+    for (size_t i = 0; i < matches_.size(); ++i) {
+      out += "  { " + to_dds_string(matches_[i].writer) + ", " +
+        to_dds_string(matches_[i].reader) + ", " +
+        (matches_[i].reliable ? "true" : "false") + " },\n";
+    }
+    out += "};\n\n";
+  }
+
+  out += "}\n"
+    "\n"
+    "extern const OpenDDS::DCPS::StaticDiscoveryTables " + name + ";\n"
+    "const OpenDDS::DCPS::StaticDiscoveryTables " + name + " = {\n";
+  out += table_member("topics", topics_.size());
+  out += table_member("writer_qos", writer_qos_.blobs.size());
+  out += table_member("reader_qos", reader_qos_.blobs.size());
+  out += table_member("publisher_qos", publisher_qos_.blobs.size());
+  out += table_member("subscriber_qos", subscriber_qos_.blobs.size());
+  out += table_member("locators", locators_.blobs.size());
+  out += table_member("endpoints", endpoints_.size());
+  out += table_member("matches", matches_.size());
+  out += "};\n";
+  return out;
+}
+
 StaticEndpointManager::StaticEndpointManager(const RepoId& participant_id,
                                              ACE_Thread_Mutex& lock,
                                              const EndpointRegistry& registry,
@@ -778,6 +1076,126 @@ StaticDiscovery::load_configuration(ACE_Configuration_Heap& cf)
   return 0;
 }
 
+int
+StaticDiscovery::load_tables(const StaticDiscoveryTables& tables)
+{
+  for (unsigned int i = 0; i < tables.topic_count; ++i) {
+    EndpointRegistry::Topic topic;
+    topic.name = tables.topics[i].name;
+    topic.type_name = tables.topics[i].type_name;
+    registry.topic_map[tables.topics[i].key] = topic;
+  }
+
+  // Each distinct QoS and locator sequence is deserialized once.
+  OPENDDS_VECTOR(DDS::DataWriterQos) writer_qos(tables.writer_qos_count);
+  OPENDDS_VECTOR(DDS::DataReaderQos) reader_qos(tables.reader_qos_count);
+  OPENDDS_VECTOR(DDS::PublisherQos) publisher_qos(tables.publisher_qos_count);
+  OPENDDS_VECTOR(DDS::SubscriberQos) subscriber_qos(tables.subscriber_qos_count);
+  OPENDDS_VECTOR(TransportLocatorSeq) locators(tables.locator_count);
+  bool good = true;
+  for (unsigned int i = 0; good && i < tables.writer_qos_count; ++i) {
+    good = from_blob(tables.writer_qos[i], writer_qos[i]);
+  }
+  for (unsigned int i = 0; good && i < tables.reader_qos_count; ++i) {
+    good = from_blob(tables.reader_qos[i], reader_qos[i]);
+  }
+  for (unsigned int i = 0; good && i < tables.publisher_qos_count; ++i) {
+    good = from_blob(tables.publisher_qos[i], publisher_qos[i]);
+  }
+  for (unsigned int i = 0; good && i < tables.subscriber_qos_count; ++i) {
+    good = from_blob(tables.subscriber_qos[i], subscriber_qos[i]);
+  }
+  for (unsigned int i = 0; good && i < tables.locator_count; ++i) {
+    good = from_blob(tables.locators[i], locators[i]);
+  }
+  if (!good) {
+    ACE_ERROR_RETURN((LM_ERROR,
+                      ACE_TEXT("(%P|%t) ERROR: StaticDiscovery::load_tables ")
+                      ACE_TEXT("failed to deserialize a QoS or locators.\n")),
+                      -1);
+  }
+
+  OPENDDS_VECTOR(EndpointRegistry::Writer*) writers(tables.endpoint_count);
+  OPENDDS_VECTOR(EndpointRegistry::Reader*) readers(tables.endpoint_count);
+  OPENDDS_VECTOR(RepoId) ids(tables.endpoint_count);
+
+  for (unsigned int i = 0; i < tables.endpoint_count; ++i) {
+    const StaticDiscoveryEndpoint& endpoint = tables.endpoints[i];
+    if (endpoint.topic >= tables.topic_count ||
+        endpoint.qos >= (endpoint.writer ? tables.writer_qos_count : tables.reader_qos_count) ||
+        endpoint.group_qos >= (endpoint.writer ? tables.publisher_qos_count : tables.subscriber_qos_count) ||
+        endpoint.locators >= tables.locator_count) {
+      ACE_ERROR_RETURN((LM_ERROR,
+                        ACE_TEXT("(%P|%t) ERROR: StaticDiscovery::load_tables ")
+                        ACE_TEXT("endpoint %u refers to an entry that doesn't exist.\n"),
+                        i),
+                        -1);
+    }
+
+    RepoId& id = ids[i];
+    std::memcpy(id.guidPrefix, endpoint.guid, sizeof(GuidPrefix_t));
+    id.entityId = EndpointRegistry::build_id(endpoint.guid + sizeof(GuidPrefix_t),
+                                             endpoint.guid[15]);
+    const OPENDDS_STRING topic_name = tables.topics[endpoint.topic].name;
+
+    if (endpoint.writer) {
+      DDS::DataWriterQos qos(writer_qos[endpoint.qos]);
+      qos.user_data.value.length(3);
+      std::memcpy(qos.user_data.value.get_buffer(), id.entityId.entityKey, 3);
+      const std::pair<EndpointRegistry::WriterMapType::iterator, bool> result =
+        registry.writer_map.insert(std::make_pair(id,
+          EndpointRegistry::Writer(topic_name, qos, publisher_qos[endpoint.group_qos],
+                                   endpoint.config, locators[endpoint.locators])));
+      if (!result.second) {
+        ACE_ERROR_RETURN((LM_ERROR,
+                          ACE_TEXT("(%P|%t) ERROR: StaticDiscovery::load_tables ")
+                          ACE_TEXT("duplicate writer %C.\n"), LogGuid(id).c_str()),
+                          -1);
+      }
+      writers[i] = &result.first->second;
+    } else {
+      DDS::DataReaderQos qos(reader_qos[endpoint.qos]);
+      qos.user_data.value.length(3);
+      std::memcpy(qos.user_data.value.get_buffer(), id.entityId.entityKey, 3);
+      const std::pair<EndpointRegistry::ReaderMapType::iterator, bool> result =
+        registry.reader_map.insert(std::make_pair(id,
+          EndpointRegistry::Reader(topic_name, qos, subscriber_qos[endpoint.group_qos],
+                                   endpoint.config, locators[endpoint.locators])));
+      if (!result.second) {
+        ACE_ERROR_RETURN((LM_ERROR,
+                          ACE_TEXT("(%P|%t) ERROR: StaticDiscovery::load_tables ")
+                          ACE_TEXT("duplicate reader %C.\n"), LogGuid(id).c_str()),
+                          -1);
+      }
+      readers[i] = &result.first->second;
+    }
+  }
+
+  // The matches were made when the tables were generated.
+  for (unsigned int i = 0; i < tables.match_count; ++i) {
+    const StaticDiscoveryMatch& match = tables.matches[i];
+    if (match.writer >= tables.endpoint_count || !writers[match.writer] ||
+        match.reader >= tables.endpoint_count || !readers[match.reader]) {
+      ACE_ERROR_RETURN((LM_ERROR,
+                        ACE_TEXT("(%P|%t) ERROR: StaticDiscovery::load_tables ")
+                        ACE_TEXT("match %u isn't between a writer and a reader.\n"),
+                        i),
+                        -1);
+    }
+    EndpointRegistry::Writer& writer = *writers[match.writer];
+    EndpointRegistry::Reader& reader = *readers[match.reader];
+    if (match.reliable) {
+      writer.reliable_readers.insert(ids[match.reader]);
+      reader.reliable_writers.insert(ids[match.writer]);
+    } else {
+      writer.best_effort_readers.insert(ids[match.reader]);
+      reader.best_effort_writers.insert(ids[match.writer]);
+    }
+  }
+
+  return 0;
+}
+
 int
 StaticDiscovery::parse_topics(ACE_Configuration_Heap& cf)
 {
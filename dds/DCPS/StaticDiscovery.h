@@ -10,6 +10,7 @@
 
 #include "dds/DCPS/WaitSet.h"
 #include "dds/DCPS/DiscoveryBase.h"
+#include "dds/DCPS/StaticDiscoveryTables.h"
 
 #ifdef DDS_HAS_MINIMUM_BIT
 #include "dds/DCPS/DataReaderImpl_T.h"
@@ -128,6 +129,60 @@ public:
                          const EntityId_t& entity_id);
 };
 
+/**
+ * @class StaticDiscoveryTableBuilder
+ *
+ * @brief The StaticDiscoveryTables of an EndpointRegistry that has been
+ * matched.
+ *
+ * Identical QoS and locators are stored once.  bin/static_discovery_tables
+ * writes them as C++ with to_cpp().
+ */
+class OpenDDS_Dcps_Export StaticDiscoveryTableBuilder {
+public:
+  explicit StaticDiscoveryTableBuilder(const EndpointRegistry& registry);
+
+  /// False if an endpoint's topic isn't in the registry or something
+  /// couldn't be serialized.
+  bool good() const { return good_; }
+
+  /// Valid as long as this builder.
+  const StaticDiscoveryTables& tables() const { return tables_; }
+
+  /// A C++ source file that defines the tables as @a name, which the
+  /// application declares as
+  /// extern const OpenDDS::DCPS::StaticDiscoveryTables name;
+  OPENDDS_STRING to_cpp(const OPENDDS_STRING& name) const;
+
+private:
+  typedef OPENDDS_VECTOR(unsigned char) Bytes;
+
+  /// Distinct blobs, in the order they were added.
+  struct Blobs {
+    OPENDDS_VECTOR(Bytes) data;
+    OPENDDS_MAP(Bytes, unsigned int) index;
+    OPENDDS_VECTOR(StaticDiscoveryBlob) blobs;
+
+    template <typename T>
+    unsigned int add(const T& value, bool& good);
+    void finish();
+  };
+
+  void add_topics(const EndpointRegistry& registry);
+  unsigned int topic(const OPENDDS_STRING& name);
+
+  bool good_;
+  /// The key, name and type name of each topic, then the transport
+  /// configuration of each endpoint, which topics_ and endpoints_ point to.
+  OPENDDS_VECTOR(OPENDDS_STRING) strings_;
+  OPENDDS_MAP(OPENDDS_STRING, unsigned int) topic_index_;
+  OPENDDS_VECTOR(StaticDiscoveryTopic) topics_;
+  Blobs writer_qos_, reader_qos_, publisher_qos_, subscriber_qos_, locators_;
+  OPENDDS_VECTOR(StaticDiscoveryEndpoint) endpoints_;
+  OPENDDS_VECTOR(StaticDiscoveryMatch) matches_;
+  StaticDiscoveryTables tables_;
+};
+
 struct StaticDiscoveredParticipantData {};
 class StaticParticipant;
 
@@ -240,6 +295,10 @@ public:
 
   int load_configuration(ACE_Configuration_Heap& config);
 
+  /// Instead of the [endpoint] sections of the configuration, add the
+  /// endpoints of @a tables, which are already matched.
+  int load_tables(const StaticDiscoveryTables& tables);
+
   virtual OpenDDS::DCPS::RepoId generate_participant_guid();
 
   virtual AddDomainStatus add_domain_participant(DDS::DomainId_t domain,
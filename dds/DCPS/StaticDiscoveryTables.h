@@ -0,0 +1,89 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_STATICDISCOVERY_STATICDISCOVERYTABLES_H
+#define OPENDDS_STATICDISCOVERY_STATICDISCOVERYTABLES_H
+
+#include "dds/Versioned_Namespace.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+#pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+// The static discovery configuration as constant tables, which
+// bin/static_discovery_tables generates from the [topic], [*qos] and
+// [endpoint] sections of a configuration file, with the matches between
+// the writers and readers already made.  The types are aggregates, so the
+// generated tables are initialized when the program is loaded, and this
+// header includes nothing else so the generated file compiles quickly.
+// StaticDiscovery::load_tables() fills its EndpointRegistry from them.
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+/// [topic/<key>]
+struct StaticDiscoveryTopic {
+  const char* key;
+  const char* name;
+  const char* type_name;
+};
+
+/// A QoS or a TransportLocatorSeq in little-endian CDR.
+struct StaticDiscoveryBlob {
+  const unsigned char* data;
+  unsigned int size;
+};
+
+struct StaticDiscoveryEndpoint {
+  /// The GUID prefix and entity id.
+  unsigned char guid[16];
+  bool writer;
+  /// Into StaticDiscoveryTables::topics.
+  unsigned int topic;
+  /// Into writer_qos or reader_qos, without the user data, which is set
+  /// from the entity key.
+  unsigned int qos;
+  /// Into publisher_qos or subscriber_qos.
+  unsigned int group_qos;
+  /// Into locators.
+  unsigned int locators;
+  /// The transport configuration, empty for the default one.
+  const char* config;
+};
+
+/// Indexes of StaticDiscoveryTables::endpoints.
+struct StaticDiscoveryMatch {
+  unsigned int writer;
+  unsigned int reader;
+  bool reliable;
+};
+
+struct StaticDiscoveryTables {
+  const StaticDiscoveryTopic* topics;
+  unsigned int topic_count;
+  const StaticDiscoveryBlob* writer_qos;
+  unsigned int writer_qos_count;
+  const StaticDiscoveryBlob* reader_qos;
+  unsigned int reader_qos_count;
+  const StaticDiscoveryBlob* publisher_qos;
+  unsigned int publisher_qos_count;
+  const StaticDiscoveryBlob* subscriber_qos;
+  unsigned int subscriber_qos_count;
+  const StaticDiscoveryBlob* locators;
+  unsigned int locator_count;
+  const StaticDiscoveryEndpoint* endpoints;
+  unsigned int endpoint_count;
+  const StaticDiscoveryMatch* matches;
+  unsigned int match_count;
+};
+
+}
+}
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* OPENDDS_STATICDISCOVERY_STATICDISCOVERYTABLES_H */
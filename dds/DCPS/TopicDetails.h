@@ -48,7 +48,7 @@ namespace OpenDDS {
         has_dcps_key_ = has_dcps_key;
         topic_callbacks_ = topic_callbacks;
 
-        endpoints_.clear();
+        endpoints_ = local_endpoints_;
         inconsistent_topic_count_ = 0;
 
         for (RemoteTopicMap::iterator pos = remote_topics_.begin(), limit = remote_topics_.end();
@@ -99,6 +99,7 @@ namespace OpenDDS {
       // Local
       void add_pub_sub(const DCPS::RepoId& guid) {
         endpoints_.insert(guid);
+        local_endpoints_.insert(guid);
       }
 
       // Remote
@@ -172,6 +173,7 @@ namespace OpenDDS {
       // Local and remote
       void remove_pub_sub(const DCPS::RepoId& guid) {
         endpoints_.erase(guid);
+        local_endpoints_.erase(guid);
 
         RepoId participant_id = guid;
         participant_id.entityId = ENTITYID_PARTICIPANT;
@@ -204,6 +206,8 @@ namespace OpenDDS {
       bool has_dcps_key() const { return has_dcps_key_; }
       bool local_is_set() const { return topic_callbacks_; }
       const RepoIdSet& endpoints() const { return endpoints_; }
+      /// The subset of endpoints() that are local.
+      const RepoIdSet& local_endpoints() const { return local_endpoints_; }
 
       bool is_dead() const {
         return topic_callbacks_ == 0 && remote_topics_.empty();
@@ -217,6 +221,7 @@ namespace OpenDDS {
       bool has_dcps_key_;
       TopicCallbacks* topic_callbacks_;
       RepoIdSet endpoints_;
+      RepoIdSet local_endpoints_;
 
       RemoteTopicMap remote_topics_;
       int inconsistent_topic_count_;
@@ -0,0 +1,381 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "DCPS/DdsDcps_pch.h" //Only the _pch include should start with DCPS/
+#include "Compressor.h"
+#include "NetworkAddress.h"
+#include "ReceivedDataSample.h"
+#include "TransportCustomizedElement.h"
+#include "dds/DCPS/DataSampleHeader.h"
+#include "dds/DCPS/Serializer.h"
+
+#include "ace/Guard_T.h"
+#include "ace/Log_Msg.h"
+#include "ace/Thread_Mutex.h"
+
+#include <cstring>
+
+#ifdef OPENDDS_HAS_LZ4
+#include <lz4.h>
+#endif
+
+#ifdef OPENDDS_HAS_ZSTD
+#include <zstd.h>
+#endif
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+namespace {
+
+#ifdef OPENDDS_HAS_LZ4
+class Lz4Compressor : public Compressor {
+public:
+  Kind kind() const { return LZ4; }
+
+  const char* name() const { return "lz4"; }
+
+  size_t bound(size_t size) const
+  {
+    return LZ4_compressBound(static_cast<int>(size));
+  }
+
+  /// The level is LZ4's acceleration: higher is faster and compresses
+  /// less.
+  size_t compress(const char* in, size_t in_size,
+                  char* out, size_t out_size, int level) const
+  {
+    const int result = LZ4_compress_fast(in, out, static_cast<int>(in_size),
+                                         static_cast<int>(out_size),
+                                         level > 0 ? level : 1);
+    return result > 0 ? result : 0;
+  }
+
+  bool decompress(const char* in, size_t in_size,
+                  char* out, size_t out_size) const
+  {
+    return LZ4_decompress_safe(in, out, static_cast<int>(in_size),
+                               static_cast<int>(out_size)) == static_cast<int>(out_size);
+  }
+};
+
+Lz4Compressor lz4_compressor;
+#endif
+
+#ifdef OPENDDS_HAS_ZSTD
+/// zstd's contexts are expensive to create, so each thread compressing
+/// or decompressing borrows one from a pool and returns it when done.
+template <typename Context, Context* (*Create)(), size_t (*Free)(Context*)>
+class ZstdContextPool {
+public:
+  ~ZstdContextPool()
+  {
+    for (size_t i = 0; i < free_.size(); ++i) {
+      Free(free_[i]);
+    }
+  }
+
+  Context* acquire()
+  {
+    {
+      ACE_Guard<ACE_Thread_Mutex> guard(lock_);
+      if (!free_.empty()) {
+        Context* const context = free_.back();
+        free_.pop_back();
+        return context;
+      }
+    }
+    return Create();
+  }
+
+  void release(Context* context)
+  {
+    if (context) {
+      ACE_Guard<ACE_Thread_Mutex> guard(lock_);
+      free_.push_back(context);
+    }
+  }
+
+private:
+  ACE_Thread_Mutex lock_;
+  OPENDDS_VECTOR(Context*) free_;
+};
+
+class ZstdCompressor : public Compressor {
+public:
+  Kind kind() const { return ZSTD; }
+
+  const char* name() const { return "zstd"; }
+
+  size_t bound(size_t size) const
+  {
+    return ZSTD_compressBound(size);
+  }
+
+  size_t compress(const char* in, size_t in_size,
+                  char* out, size_t out_size, int level) const
+  {
+    ZSTD_CCtx* const context = cctx_.acquire();
+    if (!context) {
+      return 0;
+    }
+    const size_t result =
+      ZSTD_compressCCtx(context, out, out_size, in, in_size,
+                        level ? level : ZSTD_CLEVEL_DEFAULT);
+    cctx_.release(context);
+    return ZSTD_isError(result) ? 0 : result;
+  }
+
+  bool decompress(const char* in, size_t in_size,
+                  char* out, size_t out_size) const
+  {
+    ZSTD_DCtx* const context = dctx_.acquire();
+    if (!context) {
+      return false;
+    }
+    const size_t result = ZSTD_decompressDCtx(context, out, out_size, in, in_size);
+    dctx_.release(context);
+    return !ZSTD_isError(result) && result == out_size;
+  }
+
+private:
+  mutable ZstdContextPool<ZSTD_CCtx, ZSTD_createCCtx, ZSTD_freeCCtx> cctx_;
+  mutable ZstdContextPool<ZSTD_DCtx, ZSTD_createDCtx, ZSTD_freeDCtx> dctx_;
+};
+
+ZstdCompressor zstd_compressor;
+#endif
+
+/// Compressors installed by the application, by kind.
+const Compressor* installed[Compressor::MAX_KIND + 1];
+
+}
+
+Compressor::~Compressor()
+{
+}
+
+void
+Compressor::install(const Compressor* compressor)
+{
+  const Kind kind = compressor->kind();
+  if (kind == NONE || kind > MAX_KIND) {
+    ACE_ERROR((LM_ERROR,
+               ACE_TEXT("(%P|%t) ERROR: Compressor::install: ")
+               ACE_TEXT("invalid kind %d for compressor %C.\n"),
+               int(kind), compressor->name()));
+    return;
+  }
+  installed[kind] = compressor;
+}
+
+const Compressor*
+Compressor::find(Kind kind)
+{
+  if (kind == NONE || kind > MAX_KIND) {
+    return 0;
+  }
+  if (installed[kind]) {
+    return installed[kind];
+  }
+  switch (kind) {
+#ifdef OPENDDS_HAS_LZ4
+  case LZ4:
+    return &lz4_compressor;
+#endif
+#ifdef OPENDDS_HAS_ZSTD
+  case ZSTD:
+    return &zstd_compressor;
+#endif
+  default:
+    return 0;
+  }
+}
+
+const Compressor*
+Compressor::find(const OPENDDS_STRING& name)
+{
+  for (int kind = NONE + 1; kind <= MAX_KIND; ++kind) {
+    const Compressor* const compressor = find(static_cast<Kind>(kind));
+    if (compressor && name == compressor->name()) {
+      return compressor;
+    }
+  }
+  return 0;
+}
+
+ACE_CDR::Octet
+Compressor::available()
+{
+  ACE_CDR::Octet kinds = 0;
+  for (int kind = NONE + 1; kind <= MAX_KIND; ++kind) {
+    if (find(static_cast<Kind>(kind))) {
+      kinds |= 1 << kind;
+    }
+  }
+  return kinds;
+}
+
+ACE_CDR::Octet
+Compressor::remote_available(const TransportBLOB& remote)
+{
+  // Locators from peers without compression support end after the
+  // address.
+  ACE_InputCDR cdr((const char*)remote.get_buffer(), remote.length());
+  NetworkAddress address;
+  ACE_CDR::Octet kinds = 0;
+  if (!(cdr >> address) || !(cdr >> ACE_InputCDR::to_octet(kinds))) {
+    return 0;
+  }
+  return kinds;
+}
+
+TransportQueueElement*
+Compressor::compress_sample(TransportQueueElement* element,
+                            const Compressor& compressor,
+                            size_t threshold, int level)
+{
+  const ACE_Message_Block* const msg = element->msg();
+  if (!msg || msg->length() <= size_t(DataSampleHeader::MESSAGE_ID_OFFSET) ||
+      msg->rd_ptr()[DataSampleHeader::MESSAGE_ID_OFFSET] != SAMPLE_DATA ||
+      msg->total_length() < threshold) {
+    return element;
+  }
+
+  Message_Block_Ptr dup(msg->duplicate());
+  DataSampleHeader header(*dup); // leaves dup at the start of the payload
+  const size_t size = header.message_length_;
+  if (header.compressed_ || header.more_fragments_ || size < threshold ||
+      size < size_t(PREFIX_SIZE)) {
+    return element;
+  }
+
+  ACE_Message_Block* payload = dup.get();
+  while (payload && payload->length() == 0) {
+    payload = payload->cont();
+  }
+  if (!payload || payload->total_length() != size) {
+    return element;
+  }
+
+  // Almost every payload is serialized into one block; others are
+  // copied to make them contiguous.
+  ACE_Message_Block contiguous(payload->cont() ? size : 0);
+  const char* in = payload->rd_ptr();
+  if (payload->cont()) {
+    for (const ACE_Message_Block* mb = payload; mb; mb = mb->cont()) {
+      contiguous.copy(mb->rd_ptr(), mb->length());
+    }
+    in = contiguous.rd_ptr();
+  }
+
+  // Only use the result if it saves something.
+  const size_t capacity = compressor.bound(size);
+  Message_Block_Ptr compressed(new ACE_Message_Block(PREFIX_SIZE + capacity));
+  char* const out = compressed->wr_ptr();
+  const size_t compressed_size =
+    compressor.compress(in, size, out + PREFIX_SIZE, capacity, level);
+  if (compressed_size == 0 || compressed_size + PREFIX_SIZE >= size) {
+    return element;
+  }
+
+  const ACE_CDR::ULong original_size = static_cast<ACE_CDR::ULong>(size);
+  out[0] = static_cast<char>((original_size >> 24) & 0xff);
+  out[1] = static_cast<char>((original_size >> 16) & 0xff);
+  out[2] = static_cast<char>((original_size >> 8) & 0xff);
+  out[3] = static_cast<char>(original_size & 0xff);
+  out[4] = static_cast<char>(compressor.kind());
+  compressed->wr_ptr(PREFIX_SIZE + compressed_size);
+
+  header.compressed_ = true;
+  header.message_length_ = static_cast<ACE_UINT32>(PREFIX_SIZE + compressed_size);
+
+  Message_Block_Ptr head(
+    DataSampleHeader::alloc_msgblock(*msg, DataSampleHeader::max_marshaled_size(), true));
+  *head << header;
+  head->cont(compressed.release());
+  if (header.content_filter_) {
+    DataSampleHeader::add_cfentries(&header.content_filter_entries_, head.get());
+  }
+
+  TransportCustomizedElement* const result =
+    new TransportCustomizedElement(element, false);
+  result->set_msg(move(head));
+  return result;
+}
+
+bool
+Compressor::decompress_sample(ReceivedDataSample& sample, size_t max_size)
+{
+  if (!sample.header_.compressed_) {
+    return true;
+  }
+
+  const ACE_Message_Block* const payload = sample.sample_.get();
+  const size_t length = payload ? payload->total_length() : 0;
+  if (length < size_t(PREFIX_SIZE)) {
+    ACE_ERROR_RETURN((LM_ERROR,
+                      ACE_TEXT("(%P|%t) ERROR: Compressor::decompress_sample: ")
+                      ACE_TEXT("compressed payload of %B bytes is too short.\n"),
+                      length),
+                     false);
+  }
+
+  // The payload may have been received into several blocks.
+  ACE_Message_Block contiguous(payload->cont() ? length : 0);
+  const char* in = payload->rd_ptr();
+  if (payload->cont()) {
+    for (const ACE_Message_Block* mb = payload; mb; mb = mb->cont()) {
+      contiguous.copy(mb->rd_ptr(), mb->length());
+    }
+    in = contiguous.rd_ptr();
+  }
+
+  const unsigned char* const prefix = reinterpret_cast<const unsigned char*>(in);
+  const size_t original_size = (size_t(prefix[0]) << 24) | (size_t(prefix[1]) << 16) |
+                               (size_t(prefix[2]) << 8) | size_t(prefix[3]);
+  if (original_size > max_size) {
+    ACE_ERROR_RETURN((LM_ERROR,
+                      ACE_TEXT("(%P|%t) ERROR: Compressor::decompress_sample: ")
+                      ACE_TEXT("compressed payload claims %B bytes, more than ")
+                      ACE_TEXT("compression_max_size %B.\n"),
+                      original_size, max_size),
+                     false);
+  }
+
+  const Compressor* const compressor = find(static_cast<Kind>(prefix[4]));
+  if (!compressor) {
+    ACE_ERROR_RETURN((LM_ERROR,
+                      ACE_TEXT("(%P|%t) ERROR: Compressor::decompress_sample: ")
+                      ACE_TEXT("compression kind %d is not available.\n"),
+                      int(prefix[4])),
+                     false);
+  }
+
+  Message_Block_Ptr original(new ACE_Message_Block(original_size));
+  if (!compressor->decompress(in + PREFIX_SIZE, length - PREFIX_SIZE,
+                              original->wr_ptr(), original_size)) {
+    ACE_ERROR_RETURN((LM_ERROR,
+                      ACE_TEXT("(%P|%t) ERROR: Compressor::decompress_sample: ")
+                      ACE_TEXT("%C failed to restore %B bytes from %B.\n"),
+                      compressor->name(), original_size, length - PREFIX_SIZE),
+                     false);
+  }
+  original->wr_ptr(original_size);
+
+  sample.sample_.reset(original.release());
+  sample.header_.compressed_ = false;
+  sample.header_.message_length_ = static_cast<ACE_UINT32>(original_size);
+  return true;
+}
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
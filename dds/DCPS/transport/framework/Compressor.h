@@ -0,0 +1,119 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_DCPS_COMPRESSOR_H
+#define OPENDDS_DCPS_COMPRESSOR_H
+
+#include "dds/DCPS/dcps_export.h"
+#include "dds/DCPS/PoolAllocator.h"
+#include "dds/DdsDcpsInfoUtilsC.h"
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+class TransportQueueElement;
+class ReceivedDataSample;
+
+/**
+ * @class Compressor
+ *
+ * @brief A compression algorithm the transport framework can apply to
+ *        the payload of data samples.
+ *
+ * A DataLink whose TransportInst sets "compression" replaces each
+ * SAMPLE_DATA element with a payload of at least compression_threshold
+ * bytes by a copy whose payload is compressed, and sets the compressed_
+ * flag of its DataSampleHeader.  The compressed payload starts with the
+ * uncompressed size (4 octets, big endian) and the Kind of the
+ * algorithm (1 octet).  The receive strategy restores the payload after
+ * reassembling any fragments, so DataReaders never see it compressed.
+ *
+ * The tcp and udp transports advertise the algorithms they can
+ * decompress (available()) in their locators, after the address.  A
+ * link only compresses if its peer advertised the configured algorithm,
+ * so peers that are not built with it, or predate compression, keep
+ * receiving plain samples.
+ *
+ * LZ4 and zstd are built in when OpenDDS is configured with --lz4 or
+ * --zstd.  Applications can add their own algorithm with install().
+ */
+class OpenDDS_Dcps_Export Compressor {
+public:
+  /// Identifies an algorithm on the wire.  Kinds up to MAX_KIND that are
+  /// not listed here are free for algorithms installed by applications.
+  enum Kind {
+    NONE = 0,
+    LZ4 = 1,
+    ZSTD = 2,
+    MAX_KIND = 7
+  };
+
+  virtual ~Compressor();
+
+  virtual Kind kind() const = 0;
+
+  /// Name used for the "compression" transport option.
+  virtual const char* name() const = 0;
+
+  /// Largest compressed size of @a size bytes.
+  virtual size_t bound(size_t size) const = 0;
+
+  /// Compress @a in_size bytes at @a in into the @a out_size bytes at
+  /// @a out.  @a level is the configured compression_level, 0 for the
+  /// algorithm's default.  Returns the compressed size, 0 on failure.
+  virtual size_t compress(const char* in, size_t in_size,
+                          char* out, size_t out_size, int level) const = 0;
+
+  /// Decompress @a in_size bytes at @a in into exactly @a out_size bytes
+  /// at @a out.  Returns false if the input is corrupt or of another size.
+  virtual bool decompress(const char* in, size_t in_size,
+                          char* out, size_t out_size) const = 0;
+
+  /// Use @a compressor for its kind(), in place of the built in one if
+  /// there is one.  Must be called before any transport is created; the
+  /// caller keeps ownership.
+  static void install(const Compressor* compressor);
+
+  /// Compressor for @a kind, or 0 if it is not available.
+  static const Compressor* find(Kind kind);
+
+  /// Compressor named @a name, or 0 if it is not available.
+  static const Compressor* find(const OPENDDS_STRING& name);
+
+  /// Bit (1 << kind) set for each kind this process can decompress.
+  static ACE_CDR::Octet available();
+
+  /// The kinds a peer advertised in its tcp or udp locator @a remote, 0
+  /// if it advertised none.
+  static ACE_CDR::Octet remote_available(const TransportBLOB& remote);
+
+  /// Return a TransportCustomizedElement in place of @a element carrying
+  /// its sample with the payload compressed by @a compressor, or
+  /// @a element itself if it is not a SAMPLE_DATA message, its payload
+  /// is smaller than @a threshold, or it does not get any smaller.
+  static TransportQueueElement* compress_sample(TransportQueueElement* element,
+                                                const Compressor& compressor,
+                                                size_t threshold, int level);
+
+  /// Restore the payload of @a sample if it is compressed.  Returns false
+  /// (after logging why) if it can't be, in which case the sample must be
+  /// dropped.  The size a payload restores to comes from the peer, so one
+  /// claiming more than @a max_size bytes is rejected before allocating.
+  static bool decompress_sample(ReceivedDataSample& sample, size_t max_size);
+
+  /// Octets in front of each compressed payload.
+  enum { PREFIX_SIZE = 5 };
+};
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* OPENDDS_DCPS_COMPRESSOR_H */
@@ -9,6 +9,9 @@
 #include "DataLink.h"
 
 #include "ReceivedDataSample.h"
+#include "Compressor.h"
+#include "LinkLatency.h"
+#include "KernelTimestamps.h"
 
 #include "TransportImpl.h"
 #include "TransportInst.h"
@@ -38,6 +41,36 @@ OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 namespace OpenDDS {
 namespace DCPS {
 
+namespace {
+
+/// Records, for a sample with a kernel receive timestamp, the time from
+/// that timestamp to its dispatch and the time the readers took with it.
+class ReceiveLatencyTimer {
+public:
+  ReceiveLatencyTimer(DataLink& link, const ReceivedDataSample& sample)
+    : latency_(sample.kernel_receive_time_ != ACE_Time_Value::zero ? link.latency() : 0)
+  {
+    if (latency_) {
+      dispatched_ = ACE_OS::gettimeofday();
+      latency_->record(LinkLatency::RECEIVE_DISPATCH,
+                       dispatched_ - sample.kernel_receive_time_);
+    }
+  }
+
+  ~ReceiveLatencyTimer()
+  {
+    if (latency_) {
+      latency_->record(LinkLatency::READER, ACE_OS::gettimeofday() - dispatched_);
+    }
+  }
+
+private:
+  LinkLatency* const latency_;
+  ACE_Time_Value dispatched_;
+};
+
+}
+
 /// Only called by our TransportImpl object.
 DataLink::DataLink(TransportImpl& impl, Priority priority, bool is_loopback,
                    bool is_active)
@@ -45,6 +78,9 @@ DataLink::DataLink(TransportImpl& impl, Priority priority, bool is_loopback,
     scheduled_to_stop_at_(ACE_Time_Value::zero),
     impl_(impl),
     transport_priority_(priority),
+    compressor_(0),
+    compression_threshold_(0),
+    compression_level_(0),
     scheduling_release_(false),
     is_loopback_(is_loopback),
     is_active_(is_active),
@@ -59,6 +95,11 @@ DataLink::DataLink(TransportImpl& impl, Priority priority, bool is_loopback,
 
   id_ = DataLink::get_next_datalink_id();
 
+  if (impl.config().kernel_timestamps_) {
+    this->latency_.reset(new LinkLatency(id_));
+    impl.add_link_latency(this->latency_.get());
+  }
+
   if (impl.config().thread_per_connection_) {
     this->thr_per_con_send_task_.reset(new ThreadPerConnectionSendTask(this));
 
@@ -95,6 +136,13 @@ DataLink::~DataLink()
   if (this->thr_per_con_send_task_ != 0) {
     this->thr_per_con_send_task_->close(1);
   }
+
+  if (this->latency_) {
+    if (Transport_debug_level > 0) {
+      this->latency_->log();
+    }
+    this->impl_.remove_link_latency(this->latency_.get());
+  }
 }
 
 TransportImpl&
@@ -315,11 +363,20 @@ DataLink::schedule_stop(const ACE_Time_Value& schedule_to_stop_at)
   }
 }
 
+ACE_Reactor*
+DataLink::get_reactor()
+{
+  return impl_.reactor();
+}
+
 void
 DataLink::notify_reactor()
 {
-  ReactorTask_rch reactor(impl_.reactor_task());
-  reactor->get_reactor()->notify(this);
+  // handle_exception() has to run on the thread that serves this link.
+  ACE_Reactor* const reactor = this->get_reactor();
+  if (reactor) {
+    reactor->notify(this);
+  }
 }
 
 void
@@ -553,6 +610,42 @@ DataLink::schedule_delayed_release()
   this->schedule_stop(future_release_time);
 }
 
+void
+DataLink::negotiate_compression(const TransportBLOB& remote)
+{
+  const TransportInst& config = impl_.config();
+  if (config.compression_.empty() || config.compression_ == "none") {
+    return;
+  }
+
+  const Compressor* const compressor = Compressor::find(config.compression_);
+  if (!compressor) {
+    return;
+  }
+
+  if (Compressor::remote_available(remote) & (1 << compressor->kind())) {
+    compressor_ = compressor;
+    compression_threshold_ = config.compression_threshold_;
+    compression_level_ = config.compression_level_;
+  }
+
+  VDBG_LVL((LM_DEBUG, "(%P|%t) DataLink::negotiate_compression: link[%@] %C %C\n",
+            this, compressor->name(),
+            compressor_ ? "is used" : "is not supported by the peer"), 1);
+}
+
+const Compressor*
+DataLink::compressor() const
+{
+  return compressor_;
+}
+
+LinkLatency*
+DataLink::latency() const
+{
+  return latency_.get();
+}
+
 bool
 DataLink::cancel_release()
 {
@@ -663,6 +756,8 @@ DataLink::data_received_i(ReceivedDataSample& sample,
                           ReceiveListenerSet::ConstrainReceiveSet constrain)
 {
   DBG_ENTRY_LVL("DataLink", "data_received_i", 6);
+  const ReceiveLatencyTimer latency_timer(*this, sample);
+
   // Which remote publication sent this message?
   const RepoId& publication_id = sample.header_.publication_id_;
 
@@ -1053,6 +1148,27 @@ DataLink::handle_close(ACE_HANDLE h, ACE_Reactor_Mask m)
   return 0;
 }
 
+void
+DataLink::enable_kernel_timestamps(KernelTimestamps& timestamps, ACE_HANDLE socket)
+{
+  const TransportInst& config = impl_.config();
+  if (!config.kernel_timestamps_) {
+    return;
+  }
+
+  if (config.use_io_uring_) {
+    ACE_DEBUG((LM_NOTICE,
+               ACE_TEXT("(%P|%t) NOTICE: DataLink::enable_kernel_timestamps: ")
+               ACE_TEXT("kernel_timestamps is not used with io_uring\n")));
+    return;
+  }
+
+  if (timestamps.enable(socket)) {
+    VDBG_LVL((LM_DEBUG, "(%P|%t) DataLink::enable_kernel_timestamps: "
+              "link[%@] socket %d\n", this, socket), 2);
+  }
+}
+
 void
 DataLink::set_dscp_codepoint(int cp, ACE_SOCK& socket)
 {
@@ -53,6 +53,9 @@ class ReceivedDataSample;
 class DataSampleElement;
 class ThreadPerConnectionSendTask;
 class TransportClient;
+class Compressor;
+class LinkLatency;
+class KernelTimestamps;
 class TransportImpl;
 
 typedef OPENDDS_MAP_CMP(RepoId, DataLinkSet_rch, GUID_tKeyLessThan) DataLinkSetMap;
@@ -97,6 +100,12 @@ public:
   //this thread avoids possibly deadlocking trying to access reactor
   //to stop strategies or schedule timers
   void schedule_stop(const ACE_Time_Value& schedule_to_stop_at);
+
+  /// The reactor serving this link.  Transports that spread their links
+  /// across several reactor threads (reactor_threads) override this to
+  /// return the link's own; by default it is the transport's reactor.
+  virtual ACE_Reactor* get_reactor();
+
   /// The stop method is used to stop the DataLink prior to shutdown.
   void stop();
 
@@ -214,6 +223,12 @@ public:
   // perform this behavior.
   void set_dscp_codepoint(int cp, ACE_SOCK& socket);
 
+  /// Have the kernel timestamp the datagrams of @a socket if the
+  /// transport sets kernel_timestamps.  Sockets read through io_uring
+  /// are left alone, since their transmit timestamps would never be
+  /// taken from the error queue.
+  void enable_kernel_timestamps(KernelTimestamps& timestamps, ACE_HANDLE socket);
+
   /// Accessors for the TRANSPORT_PRIORITY value associated with
   /// this link.
   Priority& transport_priority();
@@ -225,6 +240,18 @@ public:
   bool& is_active();
   bool  is_active() const;
 
+  /// Compress the samples sent on this link with the transport's
+  /// "compression" algorithm if the peer, whose locator is @a remote,
+  /// advertised that it can decompress them.
+  void negotiate_compression(const TransportBLOB& remote);
+
+  /// Algorithm compressing the samples sent on this link, or 0.
+  const Compressor* compressor() const;
+
+  /// Latency breakdown of this link, or 0 unless its transport sets
+  /// kernel_timestamps.
+  LinkLatency* latency() const;
+
   bool cancel_release();
 
   /// This allows a subclass to easily create a transport control
@@ -413,6 +440,13 @@ private:
   /// TRANSPORT_PRIORITY value associated with the link.
   Priority transport_priority_;
 
+  /// Set by negotiate_compression() before the link is used.
+  const Compressor* compressor_;
+  size_t compression_threshold_;
+  int compression_level_;
+
+  unique_ptr<LinkLatency> latency_;
+
   bool scheduling_release_;
 
 protected:
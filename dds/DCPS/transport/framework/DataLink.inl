@@ -8,8 +8,11 @@
 #include "TransportSendStrategy.h"
 #include "TransportStrategy.h"
 #include "ThreadPerConnectionSendTask.h"
+#include "Compressor.h"
+#include "LinkLatency.h"
 #include "EntryExit.h"
 #include "dds/DCPS/GuidConverter.h"
+#include "ace/OS_NS_sys_time.h"
 
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
@@ -110,6 +113,16 @@ DataLink::send(TransportQueueElement* element)
     return;
   }
 
+  if (this->compressor_) {
+    element = Compressor::compress_sample(element, *this->compressor_,
+                                          this->compression_threshold_,
+                                          this->compression_level_);
+  }
+
+  if (this->latency_) {
+    element->send_time(ACE_OS::gettimeofday());
+  }
+
   if (this->thr_per_con_send_task_ != 0) {
     if (this->thr_per_con_send_task_->add_request(SEND, element) == -1) {
       element->data_dropped(true);
@@ -243,6 +256,8 @@ DataLink::start(const TransportSendStrategy_rch& send_strategy,
   // We assume that the send_strategy is not NULL, but the receive_strategy
   // is allowed to be NULL.
 
+  send_strategy->latency(this->latency_.get());
+
   // Attempt to start the strategies, and if there is a start() failure,
   // make sure to stop() any strategy that was already start()'ed.
   if (send_strategy->start() != 0) {
@@ -0,0 +1,713 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "DCPS/DdsDcps_pch.h" //Only the _pch include should start with DCPS/
+#include "IoUringReceiver.h"
+#include "KernelTimestamps.h"
+#include "TransportDebug.h"
+
+#include "ace/Guard_T.h"
+#include "ace/Log_Msg.h"
+#include "ace/OS_NS_errno.h"
+#include "ace/OS_NS_string.h"
+
+#include <algorithm>
+
+#if defined ACE_LINUX && defined __GNUC__
+#  include <linux/version.h>
+#  if LINUX_VERSION_CODE >= KERNEL_VERSION(6, 0, 0)
+#    include <linux/io_uring.h>
+#    if defined IORING_RECV_MULTISHOT
+#      define OPENDDS_HAS_IO_URING
+#    endif
+#  endif
+#endif
+
+#ifdef OPENDDS_HAS_IO_URING
+#  include <sys/mman.h>
+#  include <sys/socket.h>
+#  include <sys/syscall.h>
+#  include <sys/utsname.h>
+#  include <netinet/in.h>
+#  include <unistd.h>
+#  include <cstdlib>
+#endif
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+#ifdef OPENDDS_HAS_IO_URING
+
+namespace {
+  const unsigned RING_ENTRIES = 16;
+  const unsigned short BUFFER_GROUP = 0;
+  const size_t MAX_SOCKETS = 2;
+
+  int sys_io_uring_setup(unsigned entries, io_uring_params* params)
+  {
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+  }
+
+  int sys_io_uring_enter(int fd, unsigned to_submit, unsigned min_complete,
+                         unsigned flags)
+  {
+    return static_cast<int>(syscall(__NR_io_uring_enter, fd, to_submit,
+                                    min_complete, flags, 0, 0));
+  }
+
+  int sys_io_uring_register(int fd, unsigned opcode, void* arg, unsigned nr)
+  {
+    return static_cast<int>(syscall(__NR_io_uring_register, fd, opcode, arg, nr));
+  }
+
+  unsigned load_acquire(const unsigned* p)
+  {
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+  }
+
+  void store_release(unsigned* p, unsigned value)
+  {
+    __atomic_store_n(p, value, __ATOMIC_RELEASE);
+  }
+
+  /// Multishot recvmsg arrived in Linux 6.0.
+  bool kernel_supports_multishot()
+  {
+    utsname name;
+    if (uname(&name) != 0) {
+      return false;
+    }
+    return std::strtol(name.release, 0, 10) >= 6;
+  }
+}
+
+struct IoUringReceiver::Ring {
+  struct Socket {
+    Socket() : handle_(ACE_INVALID_HANDLE), stream_(false), armed_(false), user_data_(0)
+    {
+      ACE_OS::memset(&msg_, 0, sizeof msg_);
+    }
+    ACE_HANDLE handle_;
+    bool stream_;
+    bool armed_;
+    ACE_UINT64 user_data_;
+    /// recvmsg template; the kernel lays out each buffer according to
+    /// the name and control lengths given here.
+    msghdr msg_;
+  };
+
+  Ring()
+    : fd_(-1)
+    , sq_ring_(MAP_FAILED), sq_ring_size_(0)
+    , cq_ring_(MAP_FAILED), cq_ring_size_(0)
+    , sqes_(static_cast<io_uring_sqe*>(MAP_FAILED)), sqes_size_(0)
+    , sq_head_(0), sq_tail_(0), sq_mask_(0), sq_entries_(0), sq_array_(0)
+    , cq_head_(0), cq_tail_(0), cq_mask_(0), cqes_(0)
+    , to_submit_(0)
+    , buf_ring_(static_cast<io_uring_buf_ring*>(MAP_FAILED)), buf_ring_size_(0)
+    , buffers_(0), buffer_count_(0), buffer_size_(0), buf_tail_(0)
+    , generation_(0)
+    , current_(0), current_length_(0), current_bid_(-1)
+    , syscalls_(0), completions_(0)
+  {}
+
+  ~Ring() { release(); }
+
+  bool setup(size_t buffers, size_t buffer_size);
+  void release();
+
+  io_uring_sqe* next_sqe();
+  int submit();
+  bool arm(Socket& socket);
+  void recycle(int bid);
+  bool completion_waiting() const
+  {
+    return load_acquire(cq_tail_) != *cq_head_;
+  }
+
+  int fd_;
+  void* sq_ring_;
+  size_t sq_ring_size_;
+  void* cq_ring_;
+  size_t cq_ring_size_;
+  io_uring_sqe* sqes_;
+  size_t sqes_size_;
+
+  unsigned* sq_head_;
+  unsigned* sq_tail_;
+  unsigned sq_mask_;
+  unsigned sq_entries_;
+  unsigned* sq_array_;
+  unsigned* cq_head_;
+  unsigned* cq_tail_;
+  unsigned cq_mask_;
+  io_uring_cqe* cqes_;
+  unsigned to_submit_;
+
+  io_uring_buf_ring* buf_ring_;
+  size_t buf_ring_size_;
+  char* buffers_;
+  unsigned buffer_count_;
+  size_t buffer_size_;
+  unsigned short buf_tail_;
+
+  Socket sockets_[MAX_SOCKETS];
+  ACE_UINT64 generation_;
+
+  /// Stream data not yet taken by receive(), and the buffer it is in.
+  const char* current_;
+  size_t current_length_;
+  int current_bid_;
+
+  size_t syscalls_;
+  size_t completions_;
+};
+
+bool
+IoUringReceiver::Ring::setup(size_t buffers, size_t buffer_size)
+{
+  // The buffer ring has a power of 2 number of entries.
+  buffer_count_ = 1;
+  while (buffer_count_ < buffers && buffer_count_ < 32768) {
+    buffer_count_ <<= 1;
+  }
+  buffer_size_ = buffer_size;
+
+  // Room in the completion queue for every buffer to be filled before
+  // the reactor thread gets to them.
+  io_uring_params params;
+  ACE_OS::memset(&params, 0, sizeof params);
+  params.flags = IORING_SETUP_CQSIZE;
+  params.cq_entries = std::max(2 * buffer_count_, 2 * RING_ENTRIES);
+  fd_ = sys_io_uring_setup(RING_ENTRIES, &params);
+  if (fd_ < 0) {
+    return false;
+  }
+
+  sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+  const bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+  if (single_mmap) {
+    sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+  }
+
+  sq_ring_ = mmap(0, sq_ring_size_, PROT_READ | PROT_WRITE,
+                  MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQ_RING);
+  if (sq_ring_ == MAP_FAILED) {
+    return false;
+  }
+  if (single_mmap) {
+    cq_ring_ = sq_ring_;
+  } else {
+    cq_ring_ = mmap(0, cq_ring_size_, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_CQ_RING);
+    if (cq_ring_ == MAP_FAILED) {
+      return false;
+    }
+  }
+
+  sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+  sqes_ = static_cast<io_uring_sqe*>(mmap(0, sqes_size_, PROT_READ | PROT_WRITE,
+                                          MAP_SHARED | MAP_POPULATE, fd_,
+                                          IORING_OFF_SQES));
+  if (sqes_ == MAP_FAILED) {
+    return false;
+  }
+
+  char* const sq = static_cast<char*>(sq_ring_);
+  sq_head_ = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+  sq_tail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+  sq_mask_ = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+  sq_entries_ = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_entries);
+  sq_array_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+
+  char* const cq = static_cast<char*>(cq_ring_);
+  cq_head_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+  cq_tail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+  cq_mask_ = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+  cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+  buf_ring_size_ = buffer_count_ * sizeof(io_uring_buf);
+  buf_ring_ = static_cast<io_uring_buf_ring*>(mmap(0, buf_ring_size_,
+                                                   PROT_READ | PROT_WRITE,
+                                                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+  if (buf_ring_ == MAP_FAILED) {
+    return false;
+  }
+
+  buffers_ = static_cast<char*>(std::malloc(buffer_count_ * buffer_size_));
+  if (!buffers_) {
+    return false;
+  }
+
+  io_uring_buf_reg reg;
+  ACE_OS::memset(&reg, 0, sizeof reg);
+  reg.ring_addr = reinterpret_cast<ACE_UINT64>(buf_ring_);
+  reg.ring_entries = buffer_count_;
+  reg.bgid = BUFFER_GROUP;
+  ++syscalls_;
+  if (sys_io_uring_register(fd_, IORING_REGISTER_PBUF_RING, &reg, 1) != 0) {
+    return false;
+  }
+
+  for (unsigned bid = 0; bid < buffer_count_; ++bid) {
+    recycle(static_cast<int>(bid));
+  }
+  return true;
+}
+
+void
+IoUringReceiver::Ring::release()
+{
+  if (buffers_) {
+    std::free(buffers_);
+    buffers_ = 0;
+  }
+  if (buf_ring_ != MAP_FAILED) {
+    munmap(buf_ring_, buf_ring_size_);
+    buf_ring_ = static_cast<io_uring_buf_ring*>(MAP_FAILED);
+  }
+  if (sqes_ != MAP_FAILED) {
+    munmap(sqes_, sqes_size_);
+    sqes_ = static_cast<io_uring_sqe*>(MAP_FAILED);
+  }
+  if (cq_ring_ != MAP_FAILED && cq_ring_ != sq_ring_) {
+    munmap(cq_ring_, cq_ring_size_);
+  }
+  cq_ring_ = MAP_FAILED;
+  if (sq_ring_ != MAP_FAILED) {
+    munmap(sq_ring_, sq_ring_size_);
+    sq_ring_ = MAP_FAILED;
+  }
+  if (fd_ >= 0) {
+    ::close(fd_);
+    fd_ = -1;
+  }
+}
+
+io_uring_sqe*
+IoUringReceiver::Ring::next_sqe()
+{
+  const unsigned tail = *sq_tail_ + to_submit_;
+  if (tail - load_acquire(sq_head_) >= sq_entries_) {
+    return 0;
+  }
+  const unsigned index = tail & sq_mask_;
+  io_uring_sqe* const sqe = &sqes_[index];
+  ACE_OS::memset(sqe, 0, sizeof *sqe);
+  sq_array_[index] = index;
+  ++to_submit_;
+  return sqe;
+}
+
+int
+IoUringReceiver::Ring::submit()
+{
+  if (to_submit_ == 0) {
+    return 0;
+  }
+  store_release(sq_tail_, *sq_tail_ + to_submit_);
+  const unsigned count = to_submit_;
+  to_submit_ = 0;
+  ++syscalls_;
+  return sys_io_uring_enter(fd_, count, 0, 0) < 0 ? -1 : 0;
+}
+
+bool
+IoUringReceiver::Ring::arm(Socket& socket)
+{
+  io_uring_sqe* const sqe = next_sqe();
+  if (!sqe) {
+    return false;
+  }
+  sqe->opcode = socket.stream_ ? IORING_OP_RECV : IORING_OP_RECVMSG;
+  sqe->fd = socket.handle_;
+  if (!socket.stream_) {
+    sqe->addr = reinterpret_cast<ACE_UINT64>(&socket.msg_);
+    sqe->len = 1;
+  }
+  sqe->ioprio = IORING_RECV_MULTISHOT;
+  sqe->flags = IOSQE_BUFFER_SELECT;
+  sqe->buf_group = BUFFER_GROUP;
+  sqe->user_data = socket.user_data_;
+  socket.armed_ = true;
+  return true;
+}
+
+void
+IoUringReceiver::Ring::recycle(int bid)
+{
+  // The entries start at the beginning of the ring (the tail overlays
+  // the first one); the bufs member is not at offset 0 in C++ builds of
+  // some versions of the kernel headers.
+  io_uring_buf& buf =
+    reinterpret_cast<io_uring_buf*>(buf_ring_)[buf_tail_ & (buffer_count_ - 1)];
+  buf.addr = reinterpret_cast<ACE_UINT64>(buffers_ + bid * buffer_size_);
+  buf.len = static_cast<ACE_UINT32>(buffer_size_);
+  buf.bid = static_cast<unsigned short>(bid);
+  ++buf_tail_;
+  __atomic_store_n(&buf_ring_->tail, buf_tail_, __ATOMIC_RELEASE);
+}
+
+namespace {
+  size_t scatter(iovec iov[], int n, const char* data, size_t length)
+  {
+    size_t copied = 0;
+    for (int i = 0; i < n && copied < length; ++i) {
+      const size_t chunk = std::min(static_cast<size_t>(iov[i].iov_len), length - copied);
+      ACE_OS::memcpy(iov[i].iov_base, data + copied, chunk);
+      copied += chunk;
+    }
+    return copied;
+  }
+}
+
+#else
+
+struct IoUringReceiver::Ring {};
+
+#endif /* OPENDDS_HAS_IO_URING */
+
+IoUringReceiver::IoUringReceiver()
+  : ring_(0)
+{
+}
+
+IoUringReceiver::~IoUringReceiver()
+{
+  close();
+}
+
+bool
+IoUringReceiver::supported()
+{
+#ifdef OPENDDS_HAS_IO_URING
+  return true;
+#else
+  return false;
+#endif
+}
+
+bool
+IoUringReceiver::open(size_t buffers, size_t buffer_size)
+{
+#ifdef OPENDDS_HAS_IO_URING
+  close();
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, lock_, false);
+
+  if (!kernel_supports_multishot()) {
+    ACE_ERROR((LM_WARNING,
+               ACE_TEXT("(%P|%t) WARNING: IoUringReceiver::open: ")
+               ACE_TEXT("io_uring receives require Linux 6.0 or later\n")));
+    return false;
+  }
+
+  ring_ = new Ring;
+  if (!ring_->setup(buffers, buffer_size)) {
+    ACE_ERROR((LM_WARNING,
+               ACE_TEXT("(%P|%t) WARNING: IoUringReceiver::open: ")
+               ACE_TEXT("unable to set up io_uring: %p\n"),
+               ACE_TEXT("io_uring")));
+    delete ring_;
+    ring_ = 0;
+    return false;
+  }
+
+  VDBG_LVL((LM_DEBUG, "(%P|%t) IoUringReceiver::open: ring %d with %u buffers "
+            "of %B bytes\n", ring_->fd_, ring_->buffer_count_, ring_->buffer_size_), 2);
+  return true;
+#else
+  ACE_UNUSED_ARG(buffers);
+  ACE_UNUSED_ARG(buffer_size);
+  ACE_ERROR((LM_WARNING,
+             ACE_TEXT("(%P|%t) WARNING: IoUringReceiver::open: ")
+             ACE_TEXT("io_uring is not supported on this platform\n")));
+  return false;
+#endif
+}
+
+void
+IoUringReceiver::close()
+{
+  // Closing the ring cancels the outstanding receives.
+  ACE_GUARD(ACE_Thread_Mutex, guard, lock_);
+  delete ring_;
+  ring_ = 0;
+}
+
+bool
+IoUringReceiver::is_open() const
+{
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, lock_, false);
+  return ring_ != 0;
+}
+
+bool
+IoUringReceiver::add(ACE_HANDLE socket, bool stream)
+{
+#ifdef OPENDDS_HAS_IO_URING
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, lock_, false);
+  if (!ring_) {
+    return false;
+  }
+  for (size_t i = 0; i < MAX_SOCKETS; ++i) {
+    Ring::Socket& s = ring_->sockets_[i];
+    if (s.handle_ != ACE_INVALID_HANDLE) {
+      continue;
+    }
+    s.handle_ = socket;
+    s.stream_ = stream;
+    s.user_data_ = (++ring_->generation_ << 8) | i;
+    ACE_OS::memset(&s.msg_, 0, sizeof s.msg_);
+    s.msg_.msg_namelen = sizeof(sockaddr_storage);
+    if (!stream) {
+      s.msg_.msg_controllen = DATAGRAM_CONTROL_SIZE;
+    }
+    if (!ring_->arm(s) || ring_->submit() != 0) {
+      ACE_ERROR((LM_ERROR,
+                 ACE_TEXT("(%P|%t) ERROR: IoUringReceiver::add: ")
+                 ACE_TEXT("unable to arm receive on handle %d: %p\n"),
+                 socket, ACE_TEXT("io_uring_enter")));
+      s.handle_ = ACE_INVALID_HANDLE;
+      return false;
+    }
+    return true;
+  }
+  ACE_ERROR((LM_ERROR,
+             ACE_TEXT("(%P|%t) ERROR: IoUringReceiver::add: ")
+             ACE_TEXT("too many sockets\n")));
+  return false;
+#else
+  ACE_UNUSED_ARG(socket);
+  ACE_UNUSED_ARG(stream);
+  return false;
+#endif
+}
+
+void
+IoUringReceiver::remove(ACE_HANDLE socket)
+{
+#ifdef OPENDDS_HAS_IO_URING
+  ACE_GUARD(ACE_Thread_Mutex, guard, lock_);
+  if (!ring_) {
+    return;
+  }
+  for (size_t i = 0; i < MAX_SOCKETS; ++i) {
+    Ring::Socket& s = ring_->sockets_[i];
+    if (s.handle_ != socket) {
+      continue;
+    }
+    if (s.armed_) {
+      io_uring_sqe* const sqe = ring_->next_sqe();
+      if (sqe) {
+        sqe->opcode = IORING_OP_ASYNC_CANCEL;
+        sqe->fd = -1;
+        sqe->addr = s.user_data_;
+        ring_->submit();
+      }
+    }
+    if (s.stream_ && ring_->current_bid_ >= 0) {
+      ring_->recycle(ring_->current_bid_);
+      ring_->current_bid_ = -1;
+      ring_->current_length_ = 0;
+    }
+    // Completions still to come for it no longer match a socket.
+    s = Ring::Socket();
+  }
+#else
+  ACE_UNUSED_ARG(socket);
+#endif
+}
+
+ACE_HANDLE
+IoUringReceiver::get_handle() const
+{
+#ifdef OPENDDS_HAS_IO_URING
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, lock_, ACE_INVALID_HANDLE);
+  return ring_ ? ring_->fd_ : ACE_INVALID_HANDLE;
+#else
+  return ACE_INVALID_HANDLE;
+#endif
+}
+
+ssize_t
+IoUringReceiver::receive(iovec iov[], int n, ACE_INET_Addr& remote_address,
+                         ACE_Time_Value* received, ACE_INET_Addr* local_address)
+{
+#ifdef OPENDDS_HAS_IO_URING
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, lock_, -1);
+  if (!ring_) {
+    errno = EBADF;
+    return -1;
+  }
+  Ring& r = *ring_;
+
+  // Rest of a chunk of stream data that did not fit last time.
+  if (r.current_length_) {
+    const size_t copied = scatter(iov, n, r.current_, r.current_length_);
+    r.current_ += copied;
+    r.current_length_ -= copied;
+    if (r.current_length_ == 0) {
+      r.recycle(r.current_bid_);
+      r.current_bid_ = -1;
+    }
+    return static_cast<ssize_t>(copied);
+  }
+
+  ssize_t result = -1;
+  errno = EWOULDBLOCK;
+
+  while (result == -1 && r.completion_waiting()) {
+    const unsigned head = *r.cq_head_;
+    const io_uring_cqe cqe = r.cqes_[head & r.cq_mask_];
+    store_release(r.cq_head_, head + 1);
+
+    const int bid = (cqe.flags & IORING_CQE_F_BUFFER)
+      ? static_cast<int>(cqe.flags >> IORING_CQE_BUFFER_SHIFT) : -1;
+    const size_t slot = static_cast<size_t>(cqe.user_data & 0xff);
+    Ring::Socket* const socket =
+      (slot < MAX_SOCKETS && r.sockets_[slot].handle_ != ACE_INVALID_HANDLE
+       && r.sockets_[slot].user_data_ == cqe.user_data) ? &r.sockets_[slot] : 0;
+
+    if (!socket) {
+      // Cancellation, or data for a socket that was removed.
+      if (bid >= 0) {
+        r.recycle(bid);
+      }
+      continue;
+    }
+
+    ++r.completions_;
+    if (!(cqe.flags & IORING_CQE_F_MORE)) {
+      socket->armed_ = false;
+    }
+
+    if (cqe.res < 0) {
+      if (cqe.res == -ENOBUFS) {
+        // Every buffer was in use; the data is still queued on the
+        // socket and is picked up once the receive is re-armed.
+        continue;
+      }
+      if (socket->stream_) {
+        errno = -cqe.res;
+        result = -1;
+        break;
+      }
+      VDBG_LVL((LM_WARNING, "(%P|%t) WARNING: IoUringReceiver::receive: "
+                "handle %d: %C\n", socket->handle_, ACE_OS::strerror(-cqe.res)), 1);
+      continue;
+    }
+
+    if (socket->stream_ && cqe.res == 0) {
+      if (bid >= 0) {
+        r.recycle(bid);
+      }
+      result = 0;
+      break;
+    }
+    if (bid < 0) {
+      continue;
+    }
+
+    const char* const buffer = r.buffers_ + bid * r.buffer_size_;
+
+    if (socket->stream_) {
+      const size_t length = static_cast<size_t>(cqe.res);
+      const size_t copied = scatter(iov, n, buffer, length);
+      if (copied < length) {
+        r.current_ = buffer + copied;
+        r.current_length_ = length - copied;
+        r.current_bid_ = bid;
+      } else {
+        r.recycle(bid);
+      }
+      result = static_cast<ssize_t>(copied);
+
+    } else {
+      const io_uring_recvmsg_out* const out =
+        reinterpret_cast<const io_uring_recvmsg_out*>(buffer);
+      const char* const name = buffer + sizeof *out;
+      char* const control = const_cast<char*>(name) + socket->msg_.msg_namelen;
+      const char* const payload = control + socket->msg_.msg_controllen;
+      const size_t available = r.buffer_size_ - (payload - buffer);
+      const size_t length = std::min(static_cast<size_t>(out->payloadlen), available);
+      if (out->namelen <= socket->msg_.msg_namelen) {
+        remote_address.set_addr(const_cast<char*>(name), static_cast<int>(out->namelen));
+      }
+      if (received) {
+        KernelTimestamps::received(control,
+                                   std::min(static_cast<size_t>(out->controllen),
+                                            static_cast<size_t>(socket->msg_.msg_controllen)),
+                                   *received, local_address);
+      }
+      result = static_cast<ssize_t>(scatter(iov, n, payload, length));
+      r.recycle(bid);
+    }
+  }
+
+  // Re-arm receives the kernel terminated (buffers ran out, or errors).
+  for (size_t i = 0; i < MAX_SOCKETS; ++i) {
+    Ring::Socket& s = r.sockets_[i];
+    if (s.handle_ != ACE_INVALID_HANDLE && !s.armed_ && !(s.stream_ && result == 0)) {
+      r.arm(s);
+    }
+  }
+  const int saved_errno = errno;
+  r.submit();
+  errno = saved_errno;
+
+  return result;
+#else
+  ACE_UNUSED_ARG(iov);
+  ACE_UNUSED_ARG(n);
+  ACE_UNUSED_ARG(remote_address);
+  ACE_UNUSED_ARG(received);
+  ACE_UNUSED_ARG(local_address);
+  errno = EBADF;
+  return -1;
+#endif
+}
+
+bool
+IoUringReceiver::pending() const
+{
+#ifdef OPENDDS_HAS_IO_URING
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, lock_, false);
+  return ring_ && (ring_->current_length_ || ring_->completion_waiting());
+#else
+  return false;
+#endif
+}
+
+size_t
+IoUringReceiver::syscalls() const
+{
+#ifdef OPENDDS_HAS_IO_URING
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, lock_, 0);
+  return ring_ ? ring_->syscalls_ : 0;
+#else
+  return 0;
+#endif
+}
+
+size_t
+IoUringReceiver::completions() const
+{
+#ifdef OPENDDS_HAS_IO_URING
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, lock_, 0);
+  return ring_ ? ring_->completions_ : 0;
+#else
+  return 0;
+#endif
+}
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
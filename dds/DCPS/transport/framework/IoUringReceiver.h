@@ -0,0 +1,114 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_DCPS_IOURINGRECEIVER_H
+#define OPENDDS_DCPS_IOURINGRECEIVER_H
+
+#include "dds/DCPS/dcps_export.h"
+
+#include "ace/INET_Addr.h"
+#include "ace/Thread_Mutex.h"
+#include "ace/Time_Value.h"
+#include "ace/os_include/sys/os_uio.h"
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+/**
+ * @class IoUringReceiver
+ *
+ * @brief Receives from a transport's sockets through a Linux io_uring.
+ *
+ * Each socket added to the receiver has a multishot receive (recvmsg
+ * for datagram sockets, recv for stream sockets) armed on the ring.
+ * The kernel fills buffers from a buffer ring registered with it, and
+ * posts a completion for every datagram or chunk of stream data, so a
+ * batch of arrivals costs a single wakeup of the reactor and no receive
+ * system calls at all.
+ *
+ * The ring's file descriptor (get_handle()) is registered with the
+ * reactor in place of the sockets; it is readable while completions are
+ * waiting.  The receive strategy then calls receive() from its
+ * receive_bytes() instead of reading the socket.
+ *
+ * Requires Linux 6.0 or later; open() fails (and the transport keeps
+ * using the reactor) when the kernel, its headers or the seccomp policy
+ * do not allow it.
+ */
+class OpenDDS_Dcps_Export IoUringReceiver {
+public:
+  /// Room for the ancillary data (kernel timestamps, packet information)
+  /// received with a datagram.
+  enum { DATAGRAM_CONTROL_SIZE = 512 };
+
+  /// Buffer size that holds any datagram along with the source address
+  /// and ancillary data the kernel stores in front of it.
+  enum { DATAGRAM_BUFFER_SIZE = 65536 + 256 + DATAGRAM_CONTROL_SIZE };
+
+  IoUringReceiver();
+  ~IoUringReceiver();
+
+  /// Is io_uring support compiled in?
+  static bool supported();
+
+  /// Set up the ring with @a buffers receive buffers of @a buffer_size
+  /// bytes.  Returns false (after logging why) if that is not possible.
+  bool open(size_t buffers, size_t buffer_size);
+
+  /// Stop receiving and release the ring.
+  void close();
+
+  bool is_open() const;
+
+  /// Start receiving from @a socket.  Returns false on failure.
+  bool add(ACE_HANDLE socket, bool stream);
+
+  /// Stop receiving from @a socket.
+  void remove(ACE_HANDLE socket);
+
+  /// Handle to register with the reactor.
+  ACE_HANDLE get_handle() const;
+
+  /// Copy the next received data into @a iov.  Returns the number of
+  /// bytes, 0 if a stream socket was closed by its peer, or -1 with
+  /// errno set: EWOULDBLOCK when nothing has been received.  For a
+  /// datagram, @a received is set to its kernel receive timestamp (zero
+  /// without one, see KernelTimestamps) and @a local_address to the
+  /// address it was sent to, if the socket receives packet information.
+  ssize_t receive(iovec iov[], int n, ACE_INET_Addr& remote_address,
+                  ACE_Time_Value* received = 0,
+                  ACE_INET_Addr* local_address = 0);
+
+  /// Is received data waiting to be taken by receive()?
+  bool pending() const;
+
+  /// Number of io_uring_enter() system calls made.
+  size_t syscalls() const;
+
+  /// Number of receive completions handled.
+  size_t completions() const;
+
+private:
+  IoUringReceiver(const IoUringReceiver&);
+  IoUringReceiver& operator=(const IoUringReceiver&);
+
+  struct Ring;
+  Ring* ring_;
+
+  /// Sockets may be added and removed by threads other than the one
+  /// receiving.
+  mutable ACE_Thread_Mutex lock_;
+};
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* OPENDDS_DCPS_IOURINGRECEIVER_H */
@@ -0,0 +1,254 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "DCPS/DdsDcps_pch.h" //Only the _pch include should start with DCPS/
+#include "KernelTimestamps.h"
+#include "LinkLatency.h"
+
+#include "ace/Guard_T.h"
+#include "ace/Log_Msg.h"
+#include "ace/OS_NS_errno.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_sys_socket.h"
+
+#if defined ACE_LINUX && defined __GNUC__
+#  include <linux/version.h>
+#  if LINUX_VERSION_CODE >= KERNEL_VERSION(4, 0, 0)
+#    include <sys/socket.h>
+#    if defined SO_TIMESTAMPING
+#      define OPENDDS_HAS_KERNEL_TIMESTAMPS
+#    endif
+#  endif
+#endif
+
+#ifdef OPENDDS_HAS_KERNEL_TIMESTAMPS
+#  include <linux/errqueue.h>
+#  include <linux/net_tstamp.h>
+#  include <netinet/in.h>
+#endif
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+#ifdef OPENDDS_HAS_KERNEL_TIMESTAMPS
+
+namespace {
+  /// Software timestamps of received and transmitted datagrams, the
+  /// latter numbered and without a copy of the datagram.
+  const int TIMESTAMPING_FLAGS =
+    SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_TX_SOFTWARE |
+    SOF_TIMESTAMPING_SOFTWARE | SOF_TIMESTAMPING_OPT_ID |
+    SOF_TIMESTAMPING_OPT_TSONLY;
+
+  /// Room for the timestamps, extended error and packet information
+  /// the kernel attaches to a datagram.
+  const size_t CONTROL_SIZE = 512;
+
+  ACE_Time_Value to_time_value(const timespec& ts)
+  {
+    return ACE_Time_Value(ts.tv_sec, ts.tv_nsec / 1000);
+  }
+
+  /// The software timestamp, the first of the three the kernel reports.
+  const timespec* find_timestamp(msghdr& msg)
+  {
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+      if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMPING) {
+        const timespec* const ts =
+          reinterpret_cast<const scm_timestamping*>(CMSG_DATA(cmsg))->ts;
+        return (ts->tv_sec || ts->tv_nsec) ? ts : 0;
+      }
+    }
+    return 0;
+  }
+}
+
+#endif
+
+KernelTimestamps::KernelTimestamps()
+  : next_id_(0)
+  , enabled_(false)
+{
+}
+
+bool
+KernelTimestamps::supported()
+{
+#ifdef OPENDDS_HAS_KERNEL_TIMESTAMPS
+  return true;
+#else
+  return false;
+#endif
+}
+
+bool
+KernelTimestamps::enable(ACE_HANDLE socket)
+{
+#ifdef OPENDDS_HAS_KERNEL_TIMESTAMPS
+  int flags = TIMESTAMPING_FLAGS;
+  if (ACE_OS::setsockopt(socket, SOL_SOCKET, SO_TIMESTAMPING,
+                         reinterpret_cast<const char*>(&flags), sizeof flags) != 0) {
+    ACE_ERROR_RETURN((LM_WARNING,
+                      ACE_TEXT("(%P|%t) WARNING: KernelTimestamps::enable: ")
+                      ACE_TEXT("SO_TIMESTAMPING failed: %m\n")),
+                     false);
+  }
+
+  ACE_Guard<ACE_Thread_Mutex> guard(lock_);
+  next_id_ = 0;
+  enabled_ = true;
+  return true;
+#else
+  ACE_UNUSED_ARG(socket);
+  ACE_ERROR_RETURN((LM_WARNING,
+                    ACE_TEXT("(%P|%t) WARNING: KernelTimestamps::enable: ")
+                    ACE_TEXT("kernel timestamps are not supported on this platform\n")),
+                   false);
+#endif
+}
+
+bool
+KernelTimestamps::enabled() const
+{
+  return enabled_;
+}
+
+void
+KernelTimestamps::sent(const ACE_Time_Value& called)
+{
+  if (!enabled_) {
+    return;
+  }
+  ACE_Guard<ACE_Thread_Mutex> guard(lock_);
+  sent_[next_id_ % SENT_RING_SIZE] = called;
+  ++next_id_;
+}
+
+void
+KernelTimestamps::collect_send_timestamps(ACE_HANDLE socket, LinkLatency& latency)
+{
+#ifdef OPENDDS_HAS_KERNEL_TIMESTAMPS
+  char control[CONTROL_SIZE];
+  for (;;) {
+    msghdr msg;
+    ACE_OS::memset(&msg, 0, sizeof msg);
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof control;
+    if (::recvmsg(socket, &msg, MSG_ERRQUEUE | MSG_DONTWAIT) < 0) {
+      return;
+    }
+
+    const timespec* const timestamp = find_timestamp(msg);
+    const sock_extended_err* error = 0;
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+      if ((cmsg->cmsg_level == SOL_IP && cmsg->cmsg_type == IP_RECVERR) ||
+          (cmsg->cmsg_level == SOL_IPV6 && cmsg->cmsg_type == IPV6_RECVERR)) {
+        error = reinterpret_cast<const sock_extended_err*>(CMSG_DATA(cmsg));
+      }
+    }
+    if (!timestamp || !error || error->ee_origin != SO_EE_ORIGIN_TIMESTAMPING) {
+      continue;
+    }
+
+    ACE_Time_Value called;
+    {
+      ACE_Guard<ACE_Thread_Mutex> guard(lock_);
+      const ACE_UINT32 age = next_id_ - error->ee_data;
+      if (age == 0 || age > SENT_RING_SIZE) {
+        continue;
+      }
+      called = sent_[error->ee_data % SENT_RING_SIZE];
+    }
+    latency.record(LinkLatency::KERNEL_SEND, to_time_value(*timestamp) - called);
+  }
+#else
+  ACE_UNUSED_ARG(socket);
+  ACE_UNUSED_ARG(latency);
+#endif
+}
+
+ssize_t
+KernelTimestamps::recv(ACE_HANDLE socket, iovec iov[], int n,
+                       ACE_INET_Addr& remote_address, ACE_Time_Value& received,
+                       ACE_INET_Addr* local_address)
+{
+#ifdef OPENDDS_HAS_KERNEL_TIMESTAMPS
+  char control[CONTROL_SIZE];
+  msghdr msg;
+  ACE_OS::memset(&msg, 0, sizeof msg);
+  msg.msg_name = remote_address.get_addr();
+  msg.msg_namelen = remote_address.get_size();
+  msg.msg_iov = iov;
+  msg.msg_iovlen = n;
+  msg.msg_control = control;
+  msg.msg_controllen = sizeof control;
+
+  const ssize_t result = ::recvmsg(socket, &msg, MSG_DONTWAIT);
+  if (result < 0) {
+    return result;
+  }
+
+  remote_address.set_size(msg.msg_namelen);
+  remote_address.set_type(static_cast<sockaddr*>(remote_address.get_addr())->sa_family);
+
+  KernelTimestamps::received(control, msg.msg_controllen, received, local_address);
+  return result;
+#else
+  ACE_UNUSED_ARG(socket);
+  ACE_UNUSED_ARG(iov);
+  ACE_UNUSED_ARG(n);
+  ACE_UNUSED_ARG(remote_address);
+  ACE_UNUSED_ARG(received);
+  ACE_UNUSED_ARG(local_address);
+  errno = ENOTSUP;
+  return -1;
+#endif
+}
+
+void
+KernelTimestamps::received(char* control, size_t control_length,
+                           ACE_Time_Value& received,
+                           ACE_INET_Addr* local_address)
+{
+#ifdef OPENDDS_HAS_KERNEL_TIMESTAMPS
+  msghdr msg;
+  ACE_OS::memset(&msg, 0, sizeof msg);
+  msg.msg_control = control;
+  msg.msg_controllen = control_length;
+
+  const timespec* const timestamp = find_timestamp(msg);
+  received = timestamp ? to_time_value(*timestamp) : ACE_Time_Value::zero;
+
+  if (local_address) {
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+      if (cmsg->cmsg_level == IPPROTO_IP && cmsg->cmsg_type == IP_PKTINFO) {
+        const in_pktinfo* const info = reinterpret_cast<const in_pktinfo*>(CMSG_DATA(cmsg));
+        local_address->set_address(reinterpret_cast<const char*>(&info->ipi_addr),
+                                   sizeof info->ipi_addr, 0 /*encode*/);
+#ifdef ACE_HAS_IPV6
+      } else if (cmsg->cmsg_level == IPPROTO_IPV6 && cmsg->cmsg_type == IPV6_PKTINFO) {
+        const in6_pktinfo* const info = reinterpret_cast<const in6_pktinfo*>(CMSG_DATA(cmsg));
+        local_address->set_address(reinterpret_cast<const char*>(&info->ipi6_addr),
+                                   sizeof info->ipi6_addr, 0 /*encode*/);
+#endif
+      }
+    }
+  }
+#else
+  ACE_UNUSED_ARG(control);
+  ACE_UNUSED_ARG(control_length);
+  ACE_UNUSED_ARG(local_address);
+  received = ACE_Time_Value::zero;
+#endif
+}
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
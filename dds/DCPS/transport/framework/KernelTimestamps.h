@@ -0,0 +1,105 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_DCPS_KERNELTIMESTAMPS_H
+#define OPENDDS_DCPS_KERNELTIMESTAMPS_H
+
+#include "dds/DCPS/dcps_export.h"
+#include "dds/DCPS/Definitions.h"
+
+#include "ace/INET_Addr.h"
+#include "ace/Thread_Mutex.h"
+#include "ace/Time_Value.h"
+#include "ace/os_include/sys/os_uio.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+class LinkLatency;
+
+/**
+ * @class KernelTimestamps
+ *
+ * @brief Kernel timestamps (SO_TIMESTAMPING) of the datagrams sent and
+ *        received on a socket.
+ *
+ * enable() asks the kernel to timestamp each datagram the socket
+ * receives, and each datagram it sends when it is handed to the
+ * network device.  Only software timestamps are requested, which every
+ * Linux network driver supports; the timestamps are taken from the
+ * system clock, like ACE_OS::gettimeofday().
+ *
+ * The kernel numbers the datagrams sent on the socket, so every send on
+ * a socket with timestamps enabled must be followed by sent().  The
+ * transmit timestamps are queued on the socket's error queue, which
+ * makes the socket readable; the receive strategy takes them with
+ * collect_send_timestamps() and then receives with recv(), which also
+ * returns the receive timestamp.
+ *
+ * Requires Linux; enable() fails (and the transport runs without
+ * timestamps) elsewhere.
+ */
+class OpenDDS_Dcps_Export KernelTimestamps {
+public:
+  KernelTimestamps();
+
+  /// Is kernel timestamping compiled in?
+  static bool supported();
+
+  /// Timestamp the datagrams sent and received on @a socket.  Returns
+  /// false (after logging why) if that is not possible.
+  bool enable(ACE_HANDLE socket);
+
+  bool enabled() const;
+
+  /// A datagram passed to a send system call at @a called was accepted
+  /// by the kernel.
+  void sent(const ACE_Time_Value& called);
+
+  /// Take the transmit timestamps queued on @a socket and record the
+  /// time from each send system call to its timestamp in @a latency.
+  void collect_send_timestamps(ACE_HANDLE socket, LinkLatency& latency);
+
+  /// Receive a datagram like ACE_SOCK_Dgram::recv() without blocking,
+  /// setting @a received to its kernel receive timestamp (or zero if it
+  /// has none) and, if it is not null and the socket receives packet
+  /// information, @a local_address to the address it was sent to.
+  /// Returns -1 with errno set to EWOULDBLOCK if nothing is waiting.
+  ssize_t recv(ACE_HANDLE socket, iovec iov[], int n,
+               ACE_INET_Addr& remote_address, ACE_Time_Value& received,
+               ACE_INET_Addr* local_address = 0);
+
+  /// Like recv(), for a datagram received by other means (IoUringReceiver):
+  /// take the receive timestamp and packet information from the
+  /// @a control_length bytes of ancillary data at @a control.
+  static void received(char* control, size_t control_length,
+                       ACE_Time_Value& received,
+                       ACE_INET_Addr* local_address = 0);
+
+private:
+  /// Send calls whose timestamps have not been collected yet, by the
+  /// number the kernel gives them.  Timestamps of older sends are
+  /// ignored.
+  enum { SENT_RING_SIZE = 1024 };
+  ACE_Time_Value sent_[SENT_RING_SIZE];
+  ACE_UINT32 next_id_;
+  bool enabled_;
+  ACE_Thread_Mutex lock_;
+};
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* OPENDDS_DCPS_KERNELTIMESTAMPS_H */
@@ -0,0 +1,84 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "DCPS/DdsDcps_pch.h" //Only the _pch include should start with DCPS/
+#include "LinkLatency.h"
+
+#include "ace/Guard_T.h"
+#include "ace/Log_Msg.h"
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+namespace {
+
+double mean(const Log2Histogram& histogram)
+{
+  return histogram.n_ ? histogram.sum_ / histogram.n_ : 0.0;
+}
+
+}
+
+LinkLatency::LinkLatency(DataLinkIdType link_id)
+{
+  stats_.link_id_ = link_id;
+}
+
+void
+LinkLatency::record(Stage stage, const ACE_Time_Value& elapsed)
+{
+  ACE_UINT64 usec = 0;
+  if (elapsed > ACE_Time_Value::zero) {
+    elapsed.to_usec(usec);
+  }
+
+  ACE_Guard<ACE_Thread_Mutex> guard(lock_);
+  switch (stage) {
+  case SEND_QUEUE:
+    stats_.send_queue_.add(usec);
+    break;
+  case KERNEL_SEND:
+    stats_.kernel_send_.add(usec);
+    break;
+  case RECEIVE_DISPATCH:
+    stats_.receive_dispatch_.add(usec);
+    break;
+  case READER:
+    stats_.reader_.add(usec);
+    break;
+  }
+}
+
+void
+LinkLatency::stats(LinkLatencyStats& stats) const
+{
+  ACE_Guard<ACE_Thread_Mutex> guard(lock_);
+  stats = stats_;
+}
+
+void
+LinkLatency::log() const
+{
+  LinkLatencyStats stats;
+  this->stats(stats);
+  ACE_DEBUG((LM_DEBUG,
+             ACE_TEXT("(%P|%t) LinkLatency::log: link %Q latency in usec (mean/max/samples): ")
+             ACE_TEXT("send queue %.1f/%Q/%Q, kernel send %.1f/%Q/%Q, ")
+             ACE_TEXT("kernel receive to dispatch %.1f/%Q/%Q, reader %.1f/%Q/%Q\n"),
+             stats.link_id_,
+             mean(stats.send_queue_), stats.send_queue_.max_, stats.send_queue_.n_,
+             mean(stats.kernel_send_), stats.kernel_send_.max_, stats.kernel_send_.n_,
+             mean(stats.receive_dispatch_), stats.receive_dispatch_.max_, stats.receive_dispatch_.n_,
+             mean(stats.reader_), stats.reader_.max_, stats.reader_.n_));
+}
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
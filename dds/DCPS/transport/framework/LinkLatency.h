@@ -0,0 +1,89 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_DCPS_LINKLATENCY_H
+#define OPENDDS_DCPS_LINKLATENCY_H
+
+#include "dds/DCPS/dcps_export.h"
+#include "Log2Histogram.h"
+#include "TransportDefs.h"
+
+#include "ace/Thread_Mutex.h"
+#include "ace/Time_Value.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+/// Where the time a sample spends between its writer and its readers
+/// went, as observed by one DataLink, in microseconds.
+struct LinkLatencyStats {
+  /// DataLink::id() of the link.
+  DataLinkIdType link_id_;
+
+  /// From DataLink::send() to the send system call of the packet
+  /// carrying the sample.
+  Log2Histogram send_queue_;
+
+  /// From the send system call to the kernel's transmit timestamp.
+  Log2Histogram kernel_send_;
+
+  /// From the kernel's receive timestamp to the DataLink handing the
+  /// sample to its readers.
+  Log2Histogram receive_dispatch_;
+
+  /// Time the readers took to take the sample.
+  Log2Histogram reader_;
+};
+
+/**
+ * @class LinkLatency
+ *
+ * @brief Latency breakdown of a DataLink whose transport sets
+ *        kernel_timestamps.
+ *
+ * The send and receive paths of the link record how long each stage
+ * took; the monitor library publishes the result (see
+ * TransportImpl::link_latency_stats()) and log() writes it when
+ * Transport_debug_level is at least 1.
+ */
+class OpenDDS_Dcps_Export LinkLatency {
+public:
+  enum Stage {
+    SEND_QUEUE,
+    KERNEL_SEND,
+    RECEIVE_DISPATCH,
+    READER
+  };
+
+  explicit LinkLatency(DataLinkIdType link_id);
+
+  /// Record that a sample spent @a elapsed in @a stage.  Negative
+  /// times, from the system clock being set back, count as 0.
+  void record(Stage stage, const ACE_Time_Value& elapsed);
+
+  void stats(LinkLatencyStats& stats) const;
+
+  /// Write the mean and maximum of each stage with ACE_DEBUG.
+  void log() const;
+
+private:
+  mutable ACE_Thread_Mutex lock_;
+  LinkLatencyStats stats_;
+};
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* OPENDDS_DCPS_LINKLATENCY_H */
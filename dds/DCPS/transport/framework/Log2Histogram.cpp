@@ -0,0 +1,57 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "DCPS/DdsDcps_pch.h" //Only the _pch include should start with DCPS/
+#include "Log2Histogram.h"
+
+#include <algorithm>
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+Log2Histogram::Log2Histogram()
+  : n_(0)
+  , min_(0)
+  , max_(0)
+  , sum_(0)
+  , sum_sq_(0)
+{
+  std::fill(counts_, counts_ + BUCKETS, ACE_UINT64(0));
+}
+
+void
+Log2Histogram::add(ACE_UINT64 value)
+{
+  size_t bucket = 0;
+  for (ACE_UINT64 v = value; v && bucket < BUCKETS - 1; v >>= 1) {
+    ++bucket;
+  }
+  ++counts_[bucket];
+
+  if (n_ == 0 || value < min_) {
+    min_ = value;
+  }
+  if (value > max_) {
+    max_ = value;
+  }
+  ++n_;
+  sum_ += double(value);
+  sum_sq_ += double(value) * double(value);
+}
+
+ACE_UINT64
+Log2Histogram::bucket_min(size_t bucket)
+{
+  return bucket ? ACE_UINT64(1) << (bucket - 1) : 0;
+}
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
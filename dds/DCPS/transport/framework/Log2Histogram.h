@@ -0,0 +1,56 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_DCPS_LOG2HISTOGRAM_H
+#define OPENDDS_DCPS_LOG2HISTOGRAM_H
+
+#include "dds/DCPS/dcps_export.h"
+#include "dds/DCPS/Definitions.h"
+
+#include "ace/Basic_Types.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+/**
+ * @struct Log2Histogram
+ *
+ * @brief Counts of observed values in power of two buckets.
+ *
+ * Bucket 0 counts the value 0 and bucket i (i > 0) the values from
+ * 2^(i-1) to 2^i - 1.  The last bucket also counts everything larger.
+ */
+struct OpenDDS_Dcps_Export Log2Histogram {
+  enum { BUCKETS = 32 };
+
+  Log2Histogram();
+
+  void add(ACE_UINT64 value);
+
+  /// Smallest value counted in @a bucket.
+  static ACE_UINT64 bucket_min(size_t bucket);
+
+  ACE_UINT64 counts_[BUCKETS];
+  ACE_UINT64 n_;
+  ACE_UINT64 min_;
+  ACE_UINT64 max_;
+  double sum_;
+  double sum_sq_;
+};
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* OPENDDS_DCPS_LOG2HISTOGRAM_H */
@@ -55,7 +55,8 @@ public:
   PriorityKey();
 
   // Construct with values.
-  PriorityKey(Priority priority, ACE_INET_Addr address, bool is_loopback, bool active);
+  PriorityKey(Priority priority, ACE_INET_Addr address, bool is_loopback, bool active,
+              unsigned int stripe = 0);
 
   // Ordering for STL containers.
   bool operator<(const PriorityKey& rhs) const;
@@ -80,6 +81,11 @@ public:
   bool& is_active();
   bool  is_active() const;
 
+  // Access the connection stripe, distinguishing parallel links with
+  // otherwise identical keys.
+  unsigned int& stripe();
+  unsigned int  stripe() const;
+
 private:
   // Priority value of key.
   Priority priority_;
@@ -89,6 +95,9 @@ private:
 
   bool is_loopback_;
   bool is_active_;
+
+  // Connection stripe of key.
+  unsigned int stripe_;
 };
 
 } // namespace DCPS
@@ -12,13 +12,15 @@ namespace DCPS {
 
 ACE_INLINE
 PriorityKey::PriorityKey()
-  : priority_(0), is_loopback_(false), is_active_(false)
+  : priority_(0), is_loopback_(false), is_active_(false), stripe_(0)
 {
 }
 
 ACE_INLINE
-PriorityKey::PriorityKey(Priority priority, ACE_INET_Addr address, bool is_loopback, bool active)
+PriorityKey::PriorityKey(Priority priority, ACE_INET_Addr address, bool is_loopback, bool active,
+                         unsigned int stripe)
   : priority_(priority), address_(address), is_loopback_(is_loopback), is_active_(active)
+  , stripe_(stripe)
 {
 }
 
@@ -32,7 +34,7 @@ PriorityKey::operator<(const PriorityKey& rhs) const
          (rhs.priority_ < this->priority_)? false :
          (this->is_loopback_ != rhs.is_loopback_) ? rhs.is_loopback_ :
          (this->is_active_ != rhs.is_active_) ? rhs.is_active_ :
-         false;
+         this->stripe_ < rhs.stripe_;
 }
 
 ACE_INLINE
@@ -42,7 +44,8 @@ PriorityKey::operator==(const PriorityKey& rhs) const
   return (this->priority_ == rhs.priority_)
          && (this->address_ == rhs.address_)
          && (this->is_loopback_ == rhs.is_loopback_)
-         && (this->is_active_ == rhs.is_active_);
+         && (this->is_active_ == rhs.is_active_)
+         && (this->stripe_ == rhs.stripe_);
 }
 
 ACE_INLINE
@@ -50,7 +53,7 @@ unsigned long
 PriorityKey::hash() const
 {
   return (this->priority_ << 16) + this->address_.hash() + this->is_loopback_
-    + this->is_active_;
+    + this->is_active_ + (this->stripe_ << 8);
 }
 
 ACE_INLINE
@@ -109,6 +112,20 @@ bool PriorityKey::is_active() const
   return this->is_active_;
 }
 
+
+ACE_INLINE
+unsigned int& PriorityKey::stripe()
+{
+  return this->stripe_;
+}
+
+
+ACE_INLINE
+unsigned int PriorityKey::stripe() const
+{
+  return this->stripe_;
+}
+
 }
 }
 
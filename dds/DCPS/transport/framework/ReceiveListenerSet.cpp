@@ -10,6 +10,7 @@
 #include "dds/DCPS/GuidConverter.h"
 
 #include "ReceiveListenerSet.h"
+#include "ReceivedDataSample.h"
 
 #if !defined (__ACE_INLINE__)
 #include "ReceiveListenerSet.inl"
@@ -107,14 +108,21 @@ ReceiveListenerSet::data_received(const ReceivedDataSample& sample,
     }
   }
 
+  // The readers demarshal the payload once between them.
+  SharedDecode_rch decode = sample.shared_decode_;
+  if (!decode && handles.size() > 1 && sample.sample_) {
+    decode = make_rch<SharedDecode>();
+  }
+
   for (size_t i = 0; i < handles.size(); ++i) {
     TransportReceiveListener_rch listener = handles[i].lock();
     if (!listener)
       continue;
-    if (i < handles.size() - 1 && sample.sample_) {
+    if ((i < handles.size() - 1 || decode) && sample.sample_) {
       // demarshal (in data_received()) updates the rd_ptr() of any of
       // the message blocks in the chain, so give it a duplicated chain.
       ReceivedDataSample rds(sample);
+      rds.shared_decode_ = decode;
       listener->data_received(rds);
     } else {
       listener->data_received(sample);
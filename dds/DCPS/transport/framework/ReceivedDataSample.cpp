@@ -9,6 +9,63 @@
 #include "ReceivedDataSample.h"
 #include "EntryExit.h"
 
+#include "ace/Guard_T.h"
+
+#include <cstring>
+
 #if !defined (__ACE_INLINE__)
 # include "ReceivedDataSample.inl"
 #endif /* !__ACE_INLINE__ */
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+SharedDecode::SharedDecode()
+  : type_name_(0)
+  , key_only_(false)
+  , data_(0)
+{
+}
+
+SharedDecode::~SharedDecode()
+{
+}
+
+const void*
+SharedDecode::find(const char* type_name, bool key_only) const
+{
+  ACE_Guard<ACE_Thread_Mutex> guard(lock_);
+  if (data_ && key_only_ == key_only && std::strcmp(type_name_, type_name) == 0) {
+    return data_;
+  }
+  return 0;
+}
+
+bool
+SharedDecode::usable(const char* type_name, bool key_only) const
+{
+  ACE_Guard<ACE_Thread_Mutex> guard(lock_);
+  return !data_ || (key_only_ == key_only && std::strcmp(type_name_, type_name) == 0);
+}
+
+bool
+SharedDecode::store(const char* type_name, bool key_only, const void* data,
+                    const RcHandle<RcObject>& keeper)
+{
+  ACE_Guard<ACE_Thread_Mutex> guard(lock_);
+  if (data_) {
+    return false;
+  }
+  type_name_ = type_name;
+  key_only_ = key_only;
+  data_ = data;
+  keeper_ = keeper;
+  return true;
+}
+
+}
+}
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
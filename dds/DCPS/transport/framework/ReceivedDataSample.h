@@ -9,6 +9,10 @@
 #define OPENDDS_DCPS_RECEIVEDDATASAMPLE_H
 
 #include "dds/DCPS/DataSampleHeader.h"
+#include "dds/DCPS/RcObject.h"
+
+#include "ace/Thread_Mutex.h"
+#include "ace/Time_Value.h"
 
 ACE_BEGIN_VERSIONED_NAMESPACE_DECL
 class ACE_Message_Block;
@@ -19,6 +23,51 @@ OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 namespace OpenDDS {
 namespace DCPS {
 
+/**
+ * @class SharedDecode
+ *
+ * @brief A received sample demarshaled once for all of the readers it
+ *        is delivered to.
+ *
+ * ReceiveListenerSet attaches one to the ReceivedDataSample it hands to
+ * each listener when there are several.  The first DataReader to
+ * demarshal the payload stores the sample it keeps here, and the
+ * readers of the same type that follow copy it instead of demarshaling
+ * the payload again.
+ */
+class OpenDDS_Dcps_Export SharedDecode : public RcObject {
+public:
+  SharedDecode();
+
+  ~SharedDecode();
+
+  /// The sample as demarshaled by a reader of type @a type_name, with
+  /// only its key fields if @a key_only is set, or 0 if there is none.
+  const void* find(const char* type_name, bool key_only) const;
+
+  /// False if a sample demarshaled for another type or marshaling is
+  /// stored already, in which case there is nothing to share.
+  bool usable(const char* type_name, bool key_only) const;
+
+  /// Share @a data, which @a keeper keeps valid until it is released,
+  /// with the other readers.  Returns false if a sample is stored
+  /// already.
+  bool store(const char* type_name, bool key_only, const void* data,
+             const RcHandle<RcObject>& keeper);
+
+private:
+  SharedDecode(const SharedDecode&);
+  SharedDecode& operator=(const SharedDecode&);
+
+  mutable ACE_Thread_Mutex lock_;
+  const char* type_name_;
+  bool key_only_;
+  const void* data_;
+  RcHandle<RcObject> keeper_;
+};
+
+typedef RcHandle<SharedDecode> SharedDecode_rch;
+
 /**
  * @class ReceivedDataSample
  *
@@ -45,6 +94,14 @@ public:
 
   /// The "data" part (ie, no "header" part) of the sample.
   Message_Block_Ptr sample_;
+
+  /// The payload demarshaled by the first of several readers, shared
+  /// with the others.  Nil if the sample is delivered to one reader.
+  SharedDecode_rch shared_decode_;
+
+  /// When the kernel received the datagram carrying the sample, if the
+  /// transport sets kernel_timestamps; zero otherwise.
+  ACE_Time_Value kernel_receive_time_;
 };
 
 void swap(ReceivedDataSample&, ReceivedDataSample&);
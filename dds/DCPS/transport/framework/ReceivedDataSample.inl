@@ -16,6 +16,7 @@ namespace DCPS {
 ACE_INLINE
 ReceivedDataSample::ReceivedDataSample(ACE_Message_Block* payload)
   : sample_(payload)
+  , kernel_receive_time_(ACE_Time_Value::zero)
 {
   DBG_ENTRY_LVL("ReceivedDataSample", "ReceivedDataSample",6);
 }
@@ -24,6 +25,8 @@ ACE_INLINE
 ReceivedDataSample::ReceivedDataSample(const ReceivedDataSample& other)
   : header_(other.header_)
   , sample_(ACE_Message_Block::duplicate(other.sample_.get()))
+  , shared_decode_(other.shared_decode_)
+  , kernel_receive_time_(other.kernel_receive_time_)
 {
   DBG_ENTRY_LVL("ReceivedDataSample", "ReceivedDataSample(copy)", 6);
 }
@@ -49,6 +52,8 @@ swap(ReceivedDataSample& a, ReceivedDataSample& b)
   using std::swap;
   swap(a.header_, b.header_);
   swap(a.sample_, b.sample_);
+  swap(a.shared_decode_, b.shared_decode_);
+  swap(a.kernel_receive_time_, b.kernel_receive_time_);
 }
 
 }
@@ -0,0 +1,161 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "DCPS/DdsDcps_pch.h" //Only the _pch include should start with DCPS/
+#include "SendLaneQueue.h"
+#include "TransportQueueElement.h"
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+SendLaneQueue::SendLaneQueue()
+  : lanes_(1)
+  , packets_(1)
+  , current_(0)
+{
+}
+
+void
+SendLaneQueue::configure(size_t lanes, const OPENDDS_VECTOR(int)& weights)
+{
+  if (lanes == 0) {
+    lanes = 1;
+  }
+  lanes_.resize(lanes);
+  packets_.assign(lanes, 0);
+  weights_ = weights;
+  if (!weights_.empty()) {
+    weights_.resize(lanes, 1);
+  }
+  credits_ = weights_;
+  current_ = 0;
+}
+
+size_t
+SendLaneQueue::lanes() const
+{
+  return lanes_.size();
+}
+
+size_t
+SendLaneQueue::lane(Priority priority) const
+{
+  if (priority <= 0) {
+    return 0;
+  }
+  return (size_t(priority) < lanes_.size()) ? size_t(priority) : lanes_.size() - 1;
+}
+
+int
+SendLaneQueue::put(TransportQueueElement* element)
+{
+  return lanes_[lane(element->priority())].put(element);
+}
+
+void
+SendLaneQueue::select_lane()
+{
+  if (weights_.empty()) {
+    for (size_t i = lanes_.size(); i > 0; --i) {
+      if (lanes_[i - 1].size()) {
+        current_ = i - 1;
+        ++packets_[current_];
+        return;
+      }
+    }
+    return;
+  }
+
+  // Take the highest lane with both samples and credit left; when there
+  // is none, start a new round.
+  for (int round = 0; round < 2; ++round) {
+    for (size_t i = lanes_.size(); i > 0; --i) {
+      if (lanes_[i - 1].size() && credits_[i - 1] > 0) {
+        current_ = i - 1;
+        --credits_[current_];
+        ++packets_[current_];
+        return;
+      }
+    }
+    credits_ = weights_;
+  }
+}
+
+TransportQueueElement*
+SendLaneQueue::peek() const
+{
+  return lanes_[current_].peek();
+}
+
+TransportQueueElement*
+SendLaneQueue::get()
+{
+  return lanes_[current_].get();
+}
+
+void
+SendLaneQueue::replace_head(TransportQueueElement* element)
+{
+  lanes_[current_].replace_head(element);
+}
+
+size_t
+SendLaneQueue::size() const
+{
+  size_t size = 0;
+  for (size_t i = 0; i < lanes_.size(); ++i) {
+    size += lanes_[i].size();
+  }
+  return size;
+}
+
+void
+SendLaneQueue::accept_visitor(VisitorType& visitor) const
+{
+  for (size_t i = lanes_.size(); i > 0; --i) {
+    lanes_[i - 1].accept_visitor(visitor);
+  }
+}
+
+void
+SendLaneQueue::accept_remove_visitor(VisitorType& visitor)
+{
+  for (size_t i = lanes_.size(); i > 0; --i) {
+    lanes_[i - 1].accept_remove_visitor(visitor);
+  }
+}
+
+void
+SendLaneQueue::accept_replace_visitor(VisitorType& visitor)
+{
+  for (size_t i = lanes_.size(); i > 0; --i) {
+    lanes_[i - 1].accept_replace_visitor(visitor);
+  }
+}
+
+void
+SendLaneQueue::drain(QueueType& queue)
+{
+  for (size_t i = lanes_.size(); i > 0; --i) {
+    while (TransportQueueElement* element = lanes_[i - 1].get()) {
+      queue.put(element);
+    }
+  }
+}
+
+const OPENDDS_VECTOR(size_t)&
+SendLaneQueue::packets() const
+{
+  return packets_;
+}
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,102 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_DCPS_SENDLANEQUEUE_H
+#define OPENDDS_DCPS_SENDLANEQUEUE_H
+
+#include "dds/DCPS/dcps_export.h"
+#include "dds/DCPS/PoolAllocator.h"
+#include "BasicQueue_T.h"
+#include "TransportDefs.h"
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+class TransportQueueElement;
+
+/**
+ * @class SendLaneQueue
+ *
+ * @brief The queue a TransportSendStrategy keeps samples in while it
+ *        can't send them directly, split into lanes by TRANSPORT_PRIORITY.
+ *
+ * Elements are put in the lane of their priority(): lane 0 holds
+ * priorities of 0 and below and the last lane holds all priorities at
+ * or above its index.  Each packet is built from the lane chosen by
+ * select_lane(), so a sample in a higher lane waits at most for the
+ * packet being sent, not for everything queued ahead of it.
+ *
+ * Without weights, lanes are served in strict priority order.  With
+ * weights, each lane may build up to its weight in packets per round
+ * (higher lanes first), so lower lanes are never starved.
+ *
+ * Samples of one writer always share a lane, so they stay in order
+ * unless the writer's TRANSPORT_PRIORITY is changed while some of them
+ * are queued.
+ */
+class OpenDDS_Dcps_Export SendLaneQueue {
+public:
+  typedef BasicQueue<TransportQueueElement> QueueType;
+  typedef BasicQueueVisitor<TransportQueueElement> VisitorType;
+
+  SendLaneQueue();
+
+  /// Use @a lanes lanes, served by strict priority if @a weights is
+  /// empty, otherwise by the weight given for each lane.
+  void configure(size_t lanes, const OPENDDS_VECTOR(int)& weights);
+
+  size_t lanes() const;
+
+  /// Lane for samples of @a priority.
+  size_t lane(Priority priority) const;
+
+  /// Append @a element to the lane of its priority.
+  int put(TransportQueueElement* element);
+
+  /// Choose the lane the next packet is built from.  peek(), get() and
+  /// replace_head() work on that lane.
+  void select_lane();
+
+  TransportQueueElement* peek() const;
+  TransportQueueElement* get();
+  void replace_head(TransportQueueElement* element);
+
+  /// Number of elements in all lanes.
+  size_t size() const;
+
+  void accept_visitor(VisitorType& visitor) const;
+  void accept_remove_visitor(VisitorType& visitor);
+  void accept_replace_visitor(VisitorType& visitor);
+
+  /// Move the elements of every lane to @a queue.
+  void drain(QueueType& queue);
+
+  /// Packets built from each lane.
+  const OPENDDS_VECTOR(size_t)& packets() const;
+
+private:
+  OPENDDS_VECTOR(QueueType) lanes_;
+
+  /// Packets per round for each lane, empty for strict priority.
+  OPENDDS_VECTOR(int) weights_;
+
+  /// Packets each lane may still build in this round.
+  OPENDDS_VECTOR(int) credits_;
+
+  OPENDDS_VECTOR(size_t) packets_;
+
+  size_t current_;
+};
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* OPENDDS_DCPS_SENDLANEQUEUE_H */
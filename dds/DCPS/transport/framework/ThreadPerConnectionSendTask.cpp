@@ -12,26 +12,72 @@
 #include "DataLink.h"
 #include "ThreadPerConRemoveVisitor.h"
 #include "DirectPriorityMapper.h"
+#include "TransportImpl.h"
+#include "TransportInst.h"
 #include "dds/DCPS/transport/framework/EntryExit.h"
 #include "dds/DCPS/DataSampleElement.h"
 #include "dds/DCPS/Service_Participant.h"
 
 #include "ace/Auto_Ptr.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/OS_NS_errno.h"
+#include "ace/OS_NS_sys_time.h"
 
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
 namespace OpenDDS {
 namespace DCPS {
 
+namespace {
+
+/// Removes the oldest sample from the queue.
+class DropOldestVisitor : public BasicQueueVisitor<SendRequest> {
+public:
+  DropOldestVisitor() : dropped_(0) {}
+
+  int visit_element_remove(SendRequest* req, int& remove)
+  {
+    if (req->op_ != SEND) {
+      return 1;
+    }
+    remove = 1;
+    dropped_ = req;
+    return 0;
+  }
+
+  SendRequest* dropped_;
+};
+
+}
+
 ThreadPerConnectionSendTask::ThreadPerConnectionSendTask(DataLink* link)
   : lock_()
   , work_available_(lock_)
+  , space_available_(lock_)
+  , samples_(0)
+  , queue_max_(link->impl().config().thread_per_connection_queue_max_)
+  , backpressure_(BLOCK)
+  , cpu_(-1)
   , shutdown_initiated_(false)
   , opened_(false)
   , thr_id_(ACE_OS::NULL_thread)
   , link_(link)
 {
   DBG_ENTRY_LVL("ThreadPerConnectionSendTask", "ThreadPerConnectionSendTask", 6);
+
+  const TransportInst& config = link->impl().config();
+  backpressure_from_name(config.thread_per_connection_backpressure_, backpressure_);
+
+  const OPENDDS_VECTOR(int)& cpus = config.thread_per_connection_cpus_;
+  if (!cpus.empty()) {
+    cpu_ = cpus[link->id() % cpus.size()];
+  }
+
+  stats_.link_id_ = link->id();
+  stats_.blocked_ = 0;
+  stats_.timed_out_ = 0;
+  stats_.dropped_ = 0;
+  stats_.rejected_ = 0;
 }
 
 ThreadPerConnectionSendTask::~ThreadPerConnectionSendTask()
@@ -39,6 +85,22 @@ ThreadPerConnectionSendTask::~ThreadPerConnectionSendTask()
   DBG_ENTRY_LVL("ThreadPerConnectionSendTask", "~ThreadPerConnectionSendTask", 6);
 }
 
+bool
+ThreadPerConnectionSendTask::backpressure_from_name(const OPENDDS_STRING& name,
+                                                    Backpressure& backpressure)
+{
+  if (name == "block") {
+    backpressure = BLOCK;
+  } else if (name == "drop_oldest") {
+    backpressure = DROP_OLDEST;
+  } else if (name == "fail") {
+    backpressure = FAIL;
+  } else {
+    return false;
+  }
+  return true;
+}
+
 int ThreadPerConnectionSendTask::add_request(SendStrategyOpType op,
                                              TransportQueueElement* element)
 {
@@ -49,6 +111,7 @@ int ThreadPerConnectionSendTask::add_request(SendStrategyOpType op,
   req->element_ = element;
 
   int result = -1;
+  SendRequest* dropped = 0;
   { // guard scope
     GuardType guard(this->lock_);
 
@@ -56,9 +119,61 @@ int ThreadPerConnectionSendTask::add_request(SendStrategyOpType op,
       return -1;
     }
 
+    // Only samples count against the limit; the SEND_START and SEND_STOP
+    // requests around them must always get through.
+    if (op == SEND && this->queue_max_ && this->samples_ >= this->queue_max_) {
+      switch (this->backpressure_) {
+      case BLOCK: {
+        ++this->stats_.blocked_;
+        const ACE_Time_Value max_blocking = element
+          ? element->max_blocking_time() : ACE_Time_Value::max_time;
+        const bool bounded = max_blocking != ACE_Time_Value::max_time;
+        const ACE_Time_Value deadline =
+          bounded ? ACE_OS::gettimeofday() + max_blocking : ACE_Time_Value::zero;
+        while (!this->shutdown_initiated_ && this->samples_ >= this->queue_max_) {
+          if (this->space_available_.wait(bounded ? &deadline : 0) == -1 &&
+              errno == ETIME) {
+            break;
+          }
+        }
+        if (this->shutdown_initiated_) {
+          return -1;
+        }
+        if (this->samples_ >= this->queue_max_) {
+          ++this->stats_.timed_out_;
+          VDBG_LVL((LM_DEBUG,
+                    ACE_TEXT("(%P|%t) ThreadPerConnectionSendTask::add_request: ")
+                    ACE_TEXT("queue of link %Q is still full after ")
+                    ACE_TEXT("max_blocking_time, dropped the sample\n"),
+                    this->stats_.link_id_), 2);
+          return -1;
+        }
+        break;
+      }
+      case DROP_OLDEST: {
+        DropOldestVisitor visitor;
+        this->queue_.accept_remove_visitor(visitor);
+        if (visitor.dropped_) {
+          dropped = visitor.dropped_;
+          --this->samples_;
+          ++this->stats_.dropped_;
+        }
+        break;
+      }
+      case FAIL:
+        ++this->stats_.rejected_;
+        return -1;
+      }
+    }
+
+    req->queued_ = ACE_High_Res_Timer::gettimeofday_hr();
     result = this->queue_.put(req.get());
 
     if (result == 0) {
+      if (op == SEND) {
+        ++this->samples_;
+        this->stats_.depth_.add(this->queue_.size());
+      }
       this->work_available_.signal();
       req.release();
 
@@ -69,6 +184,15 @@ int ThreadPerConnectionSendTask::add_request(SendStrategyOpType op,
     }
   }
 
+  if (dropped) {
+    VDBG_LVL((LM_DEBUG,
+              ACE_TEXT("(%P|%t) ThreadPerConnectionSendTask::add_request: ")
+              ACE_TEXT("queue of link %Q is full, dropped the oldest sample\n"),
+              this->stats_.link_id_), 2);
+    dropped->element_->data_dropped(true);
+    delete dropped;
+  }
+
   return result;
 }
 
@@ -87,12 +211,24 @@ int ThreadPerConnectionSendTask::open(void*)
                      -1);
   }
 
+  const TransportInst& config = this->link_->impl().config();
+
   DirectPriorityMapper mapper(this->link_->transport_priority());
-  int priority = mapper.thread_priority();
+  int priority = config.thread_per_connection_priority_
+    ? config.thread_per_connection_priority_ : mapper.thread_priority();
 
   long flags  = THR_NEW_LWP | THR_JOINABLE ;//|THR_SCOPE_PROCESS | THR_SCOPE_THREAD;
   int policy = TheServiceParticipant->scheduler();
 
+  const OPENDDS_STRING& scheduler = config.thread_per_connection_scheduler_;
+  if (scheduler == "SCHED_FIFO") {
+    policy = THR_SCHED_FIFO;
+  } else if (scheduler == "SCHED_RR") {
+    policy = THR_SCHED_RR;
+  } else if (scheduler == "SCHED_OTHER") {
+    policy = THR_SCHED_DEFAULT;
+  }
+
   if (policy >= 0) {
     flags |= policy;
   } else {
@@ -121,9 +257,40 @@ int ThreadPerConnectionSendTask::open(void*)
   // Now we have past the point where we can say we've been open()'ed before.
   this->opened_ = true;
 
+  // This may schedule the statistics timer, which must not be done while
+  // holding our lock_ (the timer takes it to collect the stats).
+  guard.release();
+  this->link_->impl().add_send_task(this);
+
   return 0;
 }
 
+void ThreadPerConnectionSendTask::bind_to_cpu()
+{
+  if (this->cpu_ < 0) {
+    return;
+  }
+
+#if defined ACE_HAS_CPU_SET_T
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  CPU_SET(this->cpu_, &cpus);
+
+  ACE_hthread_t self;
+  ACE_OS::thr_self(self);
+  if (ACE_OS::thr_setaffinity(self, sizeof cpus, &cpus) != 0) {
+    ACE_ERROR((LM_WARNING,
+               "(%P|%t) WARNING: ThreadPerConnectionSendTask::bind_to_cpu could "
+               "not bind the send thread to cpu %d: %p\n", this->cpu_,
+               "thr_setaffinity"));
+  }
+#else
+  ACE_ERROR((LM_WARNING,
+             "(%P|%t) WARNING: ThreadPerConnectionSendTask::bind_to_cpu binding "
+             "threads to a cpu is not supported on this platform\n"));
+#endif
+}
+
 int ThreadPerConnectionSendTask::svc()
 {
   DBG_ENTRY_LVL("ThreadPerConnectionSendTask", "svc", 6);
@@ -137,6 +304,8 @@ int ThreadPerConnectionSendTask::svc()
   ACE_OS::sigfillset(&set);
   ACE_OS::thr_sigsetmask(SIG_SETMASK, &set, NULL);
 
+  this->bind_to_cpu();
+
   // Start the "GetWork-And-PerformWork" loop for the current worker thread.
   while (!this->shutdown_initiated_) {
     SendRequest* req;
@@ -162,6 +331,18 @@ int ThreadPerConnectionSendTask::svc()
         //  ACE_TEXT("dequeue_head")));
         continue;
       }
+
+      if (req->op_ == SEND) {
+        const ACE_Time_Value waited =
+          ACE_High_Res_Timer::gettimeofday_hr() - req->queued_;
+        ACE_UINT64 usec = 0;
+        waited.to_usec(usec);
+        this->stats_.latency_.add(usec);
+
+        if (this->samples_-- == this->queue_max_) {
+          this->space_available_.broadcast();
+        }
+      }
     }
 
     this->execute(*req);
@@ -190,12 +371,17 @@ int ThreadPerConnectionSendTask::close(u_long flag)
     // Set the shutdown flag to true.
     this->shutdown_initiated_ = true;
     this->work_available_.signal();
+    this->space_available_.broadcast();
   }
 
   if (this->opened_ && !ACE_OS::thr_equal(this->thr_id_, ACE_OS::thr_self())) {
     this->wait();
   }
 
+  if (this->opened_) {
+    this->link_->impl().remove_send_task(this);
+  }
+
   return 0;
 }
 
@@ -214,6 +400,13 @@ ThreadPerConnectionSendTask::remove_sample(const DataSampleElement* element)
   return visitor.status();
 }
 
+void
+ThreadPerConnectionSendTask::stats(SendTaskStats& stats)
+{
+  GuardType guard(this->lock_);
+  stats = this->stats_;
+}
+
 void ThreadPerConnectionSendTask::execute(SendRequest& req)
 {
   DBG_ENTRY_LVL("ThreadPerConnectionSendTask", "execute", 6);
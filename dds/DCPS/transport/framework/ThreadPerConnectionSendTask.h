@@ -12,12 +12,15 @@
 
 #include "dds/DCPS/dcps_export.h"
 #include "dds/DCPS/PoolAllocationBase.h"
+#include "dds/DCPS/PoolAllocator.h"
 #include "BasicQueue_T.h"
+#include "Log2Histogram.h"
 #include "TransportDefs.h"
 
 #include "ace/Condition_T.h"
 #include "ace/Synch_Traits.h"
 #include "ace/Task.h"
+#include "ace/Time_Value.h"
 
 #if !defined (ACE_LACKS_PRAGMA_ONCE)
 # pragma once
@@ -45,6 +48,34 @@ enum SendStrategyOpType {
 struct SendRequest : public PoolAllocationBase {
   SendStrategyOpType op_;
   TransportQueueElement* element_;
+  /// When the request was queued.
+  ACE_Time_Value queued_;
+};
+
+/// What a ThreadPerConnectionSendTask observed about its queue since it
+/// was opened.
+struct SendTaskStats {
+  /// DataLink::id() of the link the task sends for.
+  DataLinkIdType link_id_;
+
+  /// Requests in the queue, sampled each time a sample is queued.
+  Log2Histogram depth_;
+
+  /// Microseconds each sample waited in the queue.
+  Log2Histogram latency_;
+
+  /// Samples that had to wait for room in a full queue ("block").
+  ACE_UINT64 blocked_;
+
+  /// Samples dropped because their writer's max_blocking_time passed
+  /// before there was room ("block").
+  ACE_UINT64 timed_out_;
+
+  /// Samples dropped from a full queue to make room ("drop_oldest").
+  ACE_UINT64 dropped_;
+
+  /// Samples rejected by a full queue ("fail").
+  ACE_UINT64 rejected_;
 };
 
 /**
@@ -78,8 +109,31 @@ public:
   /// Remove sample from the thread per connection queue.
   RemoveResult remove_sample(const DataSampleElement* element);
 
+  /// Copy the queue statistics gathered so far into @a stats.
+  void stats(SendTaskStats& stats);
+
+  /// What add_request does with a sample when the queue already holds
+  /// thread_per_connection_queue_max samples.
+  enum Backpressure {
+    /// Wait until the thread has made room, or the sample's
+    /// max_blocking_time has passed.
+    BLOCK,
+    /// Drop the oldest queued sample.
+    DROP_OLDEST,
+    /// Reject the new sample.
+    FAIL
+  };
+
+  /// The Backpressure named @a name ("block", "drop_oldest" or "fail"),
+  /// returned in @a backpressure.  Returns false if there is none.
+  static bool backpressure_from_name(const OPENDDS_STRING& name,
+                                     Backpressure& backpressure);
+
 private:
 
+  /// Bind the calling thread to the cpu_ it was assigned.
+  void bind_to_cpu();
+
   /// Handle the request.
   virtual void execute(SendRequest& req);
 
@@ -101,6 +155,23 @@ private:
   /// added to the queue_, and also when this task is shutdown.
   ConditionType work_available_;
 
+  /// Signaled when the thread takes a sample out of a full queue, and
+  /// when this task is shutdown.
+  ConditionType space_available_;
+
+  /// Samples (SEND requests) in the queue_.
+  size_t samples_;
+
+  /// Most samples the queue_ holds, 0 for no limit.
+  size_t queue_max_;
+
+  Backpressure backpressure_;
+
+  /// The cpu the thread is bound to, -1 if it is not bound.
+  int cpu_;
+
+  SendTaskStats stats_;
+
   /// Flag used to initiate a shutdown request to all worker threads.
   bool shutdown_initiated_;
 
@@ -47,6 +47,18 @@ TransportCustomizedElement::publication_id() const
   return publication_id_;
 }
 
+Priority
+TransportCustomizedElement::priority() const
+{
+  return orig_ ? orig_->priority() : 0;
+}
+
+ACE_Time_Value
+TransportCustomizedElement::max_blocking_time() const
+{
+  return orig_ ? orig_->max_blocking_time() : ACE_Time_Value::max_time;
+}
+
 RepoId
 TransportCustomizedElement::subscription_id() const
 {
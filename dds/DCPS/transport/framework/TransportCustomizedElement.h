@@ -29,6 +29,9 @@ public:
   virtual RepoId publication_id() const;
   void set_publication_id(const RepoId& id);
 
+  virtual Priority priority() const;
+  virtual ACE_Time_Value max_blocking_time() const;
+
   virtual const ACE_Message_Block* msg() const;
   void set_msg(Message_Block_Ptr m);
 
@@ -32,6 +32,7 @@ namespace DCPS {
 TransportImpl::TransportImpl(TransportInst& config)
   : config_(config)
   , monitor_(0)
+  , statistics_timer_(make_rch<StatisticsTimer>(this))
   , last_link_(0)
   , is_shut_down_(false)
 {
@@ -44,6 +45,7 @@ TransportImpl::TransportImpl(TransportInst& config)
 TransportImpl::~TransportImpl()
 {
   DBG_ENTRY_LVL("TransportImpl", "~TransportImpl", 6);
+  this->statistics_timer_->detach();
 }
 
 bool
@@ -62,8 +64,18 @@ TransportImpl::shutdown()
   // Stop datalink clean task.
   this->dl_clean_task_.close(1);
 
-  if (!this->reactor_task_.is_nil()) {
-    this->reactor_task_->stop();
+  this->statistics_timer_->detach();
+  {
+    GuardType guard(this->statistics_lock_);
+    ACE_Reactor* const reactor = this->reactor();
+    if (reactor && this->statistics_period_ != ACE_Time_Value::zero) {
+      reactor->cancel_timer(this->statistics_timer_.in());
+    }
+    this->statistics_period_ = ACE_Time_Value::zero;
+  }
+
+  for (size_t i = 0; i < this->reactor_tasks_.size(); ++i) {
+    this->reactor_tasks_[i]->stop();
   }
 
   // Tell our subclass about the "shutdown event".
@@ -112,9 +124,31 @@ TransportImpl::create_reactor_task(bool useAsyncSend)
     return;
   }
 
-  this->reactor_task_= make_rch<ReactorTask>(useAsyncSend);
-  if (0 != this->reactor_task_->open(0)) {
-    throw Transport::MiscProblem(); // error already logged by TRT::open()
+  const size_t threads = this->config_.reactor_threads_;
+  const OPENDDS_VECTOR(int)& cpus = this->config_.reactor_cpus_;
+
+  for (size_t i = 0; i < threads; ++i) {
+    ReactorTask_rch task = make_rch<ReactorTask>(useAsyncSend);
+    if (!cpus.empty()) {
+      task->cpu_affinity(cpus[i % cpus.size()]);
+    }
+    if (0 != task->open(0)) {
+      for (size_t j = 0; j < this->reactor_tasks_.size(); ++j) {
+        this->reactor_tasks_[j]->stop();
+      }
+      this->reactor_tasks_.clear();
+      throw Transport::MiscProblem(); // error already logged by TRT::open()
+    }
+    this->reactor_tasks_.push_back(task);
+  }
+
+  this->reactor_task_ = this->reactor_tasks_[0];
+
+  if (threads > 1 && Transport_debug_level > 0) {
+    ACE_DEBUG((LM_DEBUG,
+               ACE_TEXT("(%P|%t) TransportImpl::create_reactor_task: ")
+               ACE_TEXT("%B reactor threads for transport %C\n"),
+               threads, this->config_.name().c_str()));
   }
 }
 
@@ -145,6 +179,116 @@ TransportImpl::report()
   }
 }
 
+void
+TransportImpl::send_task_stats(SendTaskStatsSeq& stats) const
+{
+  GuardType guard(this->send_tasks_lock_);
+  stats.resize(this->send_tasks_.size());
+  size_t i = 0;
+  for (SendTasks::const_iterator it = this->send_tasks_.begin();
+       it != this->send_tasks_.end(); ++it, ++i) {
+    (*it)->stats(stats[i]);
+  }
+}
+
+void
+TransportImpl::add_send_task(ThreadPerConnectionSendTask* task)
+{
+  {
+    GuardType guard(this->send_tasks_lock_);
+    this->send_tasks_.insert(task);
+  }
+  this->schedule_statistics(this->config_.thread_per_connection_report_period_);
+}
+
+void
+TransportImpl::remove_send_task(ThreadPerConnectionSendTask* task)
+{
+  GuardType guard(this->send_tasks_lock_);
+  this->send_tasks_.erase(task);
+}
+
+void
+TransportImpl::link_latency_stats(LinkLatencyStatsSeq& stats) const
+{
+  GuardType guard(this->link_latencies_lock_);
+  stats.resize(this->link_latencies_.size());
+  size_t i = 0;
+  for (LinkLatencies::const_iterator it = this->link_latencies_.begin();
+       it != this->link_latencies_.end(); ++it, ++i) {
+    (*it)->stats(stats[i]);
+  }
+}
+
+void
+TransportImpl::add_link_latency(LinkLatency* latency)
+{
+  {
+    GuardType guard(this->link_latencies_lock_);
+    this->link_latencies_.insert(latency);
+  }
+  this->schedule_statistics(this->config_.kernel_timestamps_report_period_);
+}
+
+void
+TransportImpl::remove_link_latency(LinkLatency* latency)
+{
+  GuardType guard(this->link_latencies_lock_);
+  this->link_latencies_.erase(latency);
+}
+
+void
+TransportImpl::schedule_statistics(long period)
+{
+  if (!this->monitor_ || period <= 0 || this->is_shut_down_) {
+    return;
+  }
+
+  ACE_Time_Value interval;
+  interval.msec(period);
+
+  GuardType guard(this->statistics_lock_);
+  if (this->statistics_period_ != ACE_Time_Value::zero &&
+      this->statistics_period_ <= interval) {
+    return;
+  }
+
+  ACE_Reactor* const reactor = this->reactor();
+  if (!reactor) {
+    return;
+  }
+  if (this->statistics_period_ != ACE_Time_Value::zero) {
+    reactor->cancel_timer(this->statistics_timer_.in());
+  }
+  if (reactor->schedule_timer(this->statistics_timer_.in(), 0,
+                              interval, interval) == -1) {
+    ACE_ERROR((LM_WARNING,
+               ACE_TEXT("(%P|%t) WARNING: TransportImpl::schedule_statistics: ")
+               ACE_TEXT("failed to schedule the statistics timer\n")));
+    this->statistics_period_ = ACE_Time_Value::zero;
+    return;
+  }
+  this->statistics_period_ = interval;
+}
+
+int
+TransportImpl::StatisticsTimer::handle_timeout(const ACE_Time_Value& /*now*/,
+                                               const void* /*arg*/)
+{
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, this->lock_, 0);
+  if (this->impl_) {
+    this->impl_->report();
+  }
+  return 0;
+}
+
+void
+TransportImpl::StatisticsTimer::detach()
+{
+  ACE_GUARD(ACE_Thread_Mutex, guard, this->lock_);
+  this->impl_ = 0;
+}
+
 void
 TransportImpl::dump()
 {
@@ -19,14 +19,18 @@
 #include "dds/DCPS/ReactorTask.h"
 #include "dds/DCPS/ReactorTask_rch.h"
 #include "DataLinkCleanupTask.h"
+#include "ThreadPerConnectionSendTask.h"
+#include "LinkLatency.h"
 #include "dds/DCPS/PoolAllocator.h"
 #include "dds/DCPS/DiscoveryListener.h"
+#include "dds/DCPS/RcEventHandler.h"
 
 #if defined(OPENDDS_SECURITY)
 #include "dds/DdsSecurityCoreC.h"
 #endif
 
 #include "ace/Synch_Traits.h"
+#include "ace/Thread_Mutex.h"
 
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
@@ -119,6 +123,16 @@ public:
 
   void report();
 
+  /// Statistics of the queue of each ThreadPerConnectionSendTask (see
+  /// thread_per_connection) of this transport's DataLinks.
+  typedef OPENDDS_VECTOR(SendTaskStats) SendTaskStatsSeq;
+  void send_task_stats(SendTaskStatsSeq& stats) const;
+
+  /// Latency breakdown of each of this transport's DataLinks, if it sets
+  /// kernel_timestamps.
+  typedef OPENDDS_VECTOR(LinkLatencyStats) LinkLatencyStatsSeq;
+  void link_latency_stats(LinkLatencyStatsSeq& stats) const;
+
   struct ConnectionAttribs {
     RepoId local_id_;
     Priority priority_;
@@ -201,6 +215,11 @@ protected:
   /// returned.
   ReactorTask_rch reactor_task();
 
+  /// The reactor task a DataLink identified by @a key runs on.  When
+  /// the transport is configured with more than one reactor thread
+  /// the DataLinks are spread across them by this key.
+  ReactorTask_rch reactor_task(size_t key);
+
   typedef OPENDDS_MULTIMAP(TransportClient_wrch, DataLink_rch) PendConnMap;
   PendConnMap pending_connections_;
   void add_pending_connection(const TransportClient_rch& client, DataLink_rch link);
@@ -213,6 +232,34 @@ private:
   friend class TransportInst;
   friend class TransportClient;
   friend class DataLink;
+  friend class ThreadPerConnectionSendTask;
+
+  void add_send_task(ThreadPerConnectionSendTask* task);
+  void remove_send_task(ThreadPerConnectionSendTask* task);
+
+  void add_link_latency(LinkLatency* latency);
+  void remove_link_latency(LinkLatency* latency);
+
+  /// Have the statistics timer report() at least every @a period
+  /// milliseconds.  Does nothing without a monitor or if @a period is 0.
+  void schedule_statistics(long period);
+
+  /// Reports the statistics of the send tasks to the monitor from the
+  /// reactor, so that the send threads never publish a sample.
+  class StatisticsTimer : public RcEventHandler {
+  public:
+    explicit StatisticsTimer(TransportImpl* impl) : impl_(impl) {}
+    int handle_timeout(const ACE_Time_Value& now, const void* arg);
+
+    /// Called when the transport shuts down, so that a timer that is
+    /// already being dispatched does nothing.
+    void detach();
+
+  private:
+    ACE_Thread_Mutex lock_;
+    TransportImpl* impl_;
+  };
+
   /// Called by the TransportRegistry when this TransportImpl object
   /// is released while the TransportRegistry is handling a release()
   /// "event".
@@ -272,12 +319,38 @@ public:
   /// subclass (of TransportImpl) doesn't require a reactor.
   ReactorTask_rch reactor_task_;
 
+  /// All of the reactor tasks (reactor_threads of them), the first of
+  /// which is reactor_task_.
+  typedef OPENDDS_VECTOR(ReactorTask_rch) ReactorTasks;
+  ReactorTasks reactor_tasks_;
+
   /// smart ptr to the associated DL cleanup task
   DataLinkCleanupTask dl_clean_task_;
 
   /// Monitor object for this entity
   Monitor* monitor_;
 
+  /// Protects send_tasks_.
+  mutable LockType send_tasks_lock_;
+
+  typedef OPENDDS_SET(ThreadPerConnectionSendTask*) SendTasks;
+  SendTasks send_tasks_;
+
+  /// Protects link_latencies_.
+  mutable LockType link_latencies_lock_;
+
+  typedef OPENDDS_SET(LinkLatency*) LinkLatencies;
+  LinkLatencies link_latencies_;
+
+  RcHandle<StatisticsTimer> statistics_timer_;
+
+  /// Protects statistics_period_.  Not taken by the timer, so the reactor
+  /// may be called while holding it.
+  LockType statistics_lock_;
+
+  /// Interval the statistics timer is scheduled with, zero if it isn't.
+  ACE_Time_Value statistics_period_;
+
 protected:
   /// Id of the last link established.
   std::size_t last_link_;
@@ -28,6 +28,16 @@ OpenDDS::DCPS::TransportImpl::reactor_task()
   return this->reactor_task_;
 }
 
+ACE_INLINE OpenDDS::DCPS::ReactorTask_rch
+OpenDDS::DCPS::TransportImpl::reactor_task(size_t key)
+{
+  DBG_ENTRY_LVL("TransportImpl","reactor_task",6);
+  if (this->reactor_tasks_.size() < 2) {
+    return this->reactor_task_;
+  }
+  return this->reactor_tasks_[key % this->reactor_tasks_.size()];
+}
+
 ACE_INLINE ACE_Reactor_Timer_Interface*
 OpenDDS::DCPS::TransportImpl::timer() const
 {
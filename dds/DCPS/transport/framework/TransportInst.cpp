@@ -9,10 +9,13 @@
 #include "TransportInst.h"
 #include "TransportImpl.h"
 #include "TransportExceptions.h"
+#include "Compressor.h"
+#include "ThreadPerConnectionSendTask.h"
 #include "EntryExit.h"
 #include "DCPS/SafetyProfileStreams.h"
 
 #include "ace/Configuration.h"
+#include "ace/OS_NS_stdlib.h"
 
 #include <cstring>
 #include <algorithm>
@@ -45,6 +48,96 @@ OpenDDS::DCPS::TransportInst::load(ACE_Configuration_Heap& cf,
   // for control messages.
   GET_CONFIG_VALUE(cf, sect, ACE_TEXT("datalink_control_chunks"), this->datalink_control_chunks_, size_t)
 
+  GET_CONFIG_VALUE(cf, sect, ACE_TEXT("receive_buffers"), this->receive_buffers_, size_t)
+  GET_CONFIG_VALUE(cf, sect, ACE_TEXT("receive_buffer_low_water"), this->receive_buffer_low_water_, size_t)
+  GET_CONFIG_VALUE(cf, sect, ACE_TEXT("receive_message_blocks"), this->receive_message_blocks_, size_t)
+  GET_CONFIG_VALUE(cf, sect, ACE_TEXT("receive_data_blocks"), this->receive_data_blocks_, size_t)
+  GET_CONFIG_VALUE(cf, sect, ACE_TEXT("receive_data_blocks_max"), this->receive_data_blocks_max_, size_t)
+  GET_CONFIG_VALUE(cf, sect, ACE_TEXT("reactor_threads"), this->reactor_threads_, size_t)
+  GET_CONFIG_VALUE(cf, sect, ACE_TEXT("io_uring"), this->use_io_uring_, bool)
+  GET_CONFIG_VALUE(cf, sect, ACE_TEXT("io_uring_buffers"), this->io_uring_buffers_, size_t)
+  GET_CONFIG_VALUE(cf, sect, ACE_TEXT("batch_bytes"), this->batch_bytes_, size_t)
+  GET_CONFIG_VALUE(cf, sect, ACE_TEXT("batch_delay"), this->batch_delay_, long)
+
+  ACE_TString cpus;
+  GET_CONFIG_TSTRING_VALUE(cf, sect, ACE_TEXT("reactor_cpus"), cpus)
+  if (!cpus.empty() && parse_list(ACE_TEXT_ALWAYS_CHAR(cpus.c_str()), reactor_cpus_) != 0) {
+    ACE_ERROR_RETURN((LM_ERROR,
+                      ACE_TEXT("(%P|%t) ERROR: TransportInst::load: ")
+                      ACE_TEXT("invalid reactor_cpus value \"%s\".\n"),
+                      cpus.c_str()),
+                     -1);
+  }
+
+  GET_CONFIG_VALUE(cf, sect, ACE_TEXT("send_lanes"), this->send_lanes_, size_t)
+
+  ACE_TString weights;
+  GET_CONFIG_TSTRING_VALUE(cf, sect, ACE_TEXT("send_lane_weights"), weights)
+  if (!weights.empty() &&
+      parse_list(ACE_TEXT_ALWAYS_CHAR(weights.c_str()), send_lane_weights_) != 0) {
+    ACE_ERROR_RETURN((LM_ERROR,
+                      ACE_TEXT("(%P|%t) ERROR: TransportInst::load: ")
+                      ACE_TEXT("invalid send_lane_weights value \"%s\".\n"),
+                      weights.c_str()),
+                     -1);
+  }
+
+  GET_CONFIG_STRING_VALUE(cf, sect, ACE_TEXT("compression"), this->compression_)
+  if (this->compression_ != "none" && !Compressor::find(this->compression_)) {
+    ACE_ERROR_RETURN((LM_ERROR,
+                      ACE_TEXT("(%P|%t) ERROR: TransportInst::load: ")
+                      ACE_TEXT("compression \"%C\" is not available.\n"),
+                      this->compression_.c_str()),
+                     -1);
+  }
+  GET_CONFIG_VALUE(cf, sect, ACE_TEXT("compression_threshold"), this->compression_threshold_, size_t)
+  GET_CONFIG_VALUE(cf, sect, ACE_TEXT("compression_level"), this->compression_level_, int)
+  GET_CONFIG_VALUE(cf, sect, ACE_TEXT("compression_max_size"), this->compression_max_size_, size_t)
+
+  ACE_TString send_cpus;
+  GET_CONFIG_TSTRING_VALUE(cf, sect, ACE_TEXT("thread_per_connection_cpus"), send_cpus)
+  if (!send_cpus.empty() &&
+      parse_list(ACE_TEXT_ALWAYS_CHAR(send_cpus.c_str()), thread_per_connection_cpus_) != 0) {
+    ACE_ERROR_RETURN((LM_ERROR,
+                      ACE_TEXT("(%P|%t) ERROR: TransportInst::load: ")
+                      ACE_TEXT("invalid thread_per_connection_cpus value \"%s\".\n"),
+                      send_cpus.c_str()),
+                     -1);
+  }
+
+  GET_CONFIG_STRING_VALUE(cf, sect, ACE_TEXT("thread_per_connection_scheduler"),
+                          this->thread_per_connection_scheduler_)
+  if (!this->thread_per_connection_scheduler_.empty() &&
+      this->thread_per_connection_scheduler_ != "SCHED_OTHER" &&
+      this->thread_per_connection_scheduler_ != "SCHED_FIFO" &&
+      this->thread_per_connection_scheduler_ != "SCHED_RR") {
+    ACE_ERROR_RETURN((LM_ERROR,
+                      ACE_TEXT("(%P|%t) ERROR: TransportInst::load: ")
+                      ACE_TEXT("invalid thread_per_connection_scheduler value \"%C\".\n"),
+                      this->thread_per_connection_scheduler_.c_str()),
+                     -1);
+  }
+  GET_CONFIG_VALUE(cf, sect, ACE_TEXT("thread_per_connection_priority"), this->thread_per_connection_priority_, int)
+  GET_CONFIG_VALUE(cf, sect, ACE_TEXT("thread_per_connection_queue_max"), this->thread_per_connection_queue_max_, size_t)
+
+  GET_CONFIG_STRING_VALUE(cf, sect, ACE_TEXT("thread_per_connection_backpressure"),
+                          this->thread_per_connection_backpressure_)
+  ThreadPerConnectionSendTask::Backpressure backpressure;
+  if (!ThreadPerConnectionSendTask::backpressure_from_name(
+        this->thread_per_connection_backpressure_, backpressure)) {
+    ACE_ERROR_RETURN((LM_ERROR,
+                      ACE_TEXT("(%P|%t) ERROR: TransportInst::load: ")
+                      ACE_TEXT("invalid thread_per_connection_backpressure value \"%C\".\n"),
+                      this->thread_per_connection_backpressure_.c_str()),
+                     -1);
+  }
+  GET_CONFIG_VALUE(cf, sect, ACE_TEXT("thread_per_connection_report_period"),
+                   this->thread_per_connection_report_period_, long)
+
+  GET_CONFIG_VALUE(cf, sect, ACE_TEXT("kernel_timestamps"), this->kernel_timestamps_, bool)
+  GET_CONFIG_VALUE(cf, sect, ACE_TEXT("kernel_timestamps_report_period"),
+                   this->kernel_timestamps_report_period_, long)
+
   ACE_TString stringvalue;
   if (cf.get_string_value (sect, ACE_TEXT("passive_connect_duration"), stringvalue) == 0) {
     ACE_DEBUG ((LM_WARNING,
@@ -57,6 +150,33 @@ OpenDDS::DCPS::TransportInst::load(ACE_Configuration_Heap& cf,
   return 0;
 }
 
+int
+OpenDDS::DCPS::TransportInst::parse_list(const char* list,
+                                         OPENDDS_VECTOR(int)& values)
+{
+  OPENDDS_VECTOR(int) parsed;
+  const char* pos = list;
+  while (*pos) {
+    char* end = 0;
+    const long value = ACE_OS::strtol(pos, &end, 10);
+    if (end == pos || value < 0) {
+      return -1;
+    }
+    parsed.push_back(static_cast<int>(value));
+    pos = end;
+    while (*pos == ' ') {
+      ++pos;
+    }
+    if (*pos == ',') {
+      ++pos;
+    } else if (*pos) {
+      return -1;
+    }
+  }
+  values.swap(parsed);
+  return 0;
+}
+
 void
 OpenDDS::DCPS::TransportInst::dump() const
 {
@@ -98,6 +218,43 @@ OpenDDS::DCPS::TransportInst::dump_to_str() const
   ret += formatNameForDump("thread_per_connection")   + (this->thread_per_connection_ ? "true" : "false") + '\n';
   ret += formatNameForDump("datalink_release_delay")  + to_dds_string(this->datalink_release_delay_) + '\n';
   ret += formatNameForDump("datalink_control_chunks") + to_dds_string(unsigned(this->datalink_control_chunks_)) + '\n';
+  ret += formatNameForDump("receive_buffers")         + to_dds_string(unsigned(this->receive_buffers_)) + '\n';
+  ret += formatNameForDump("receive_buffer_low_water") + to_dds_string(unsigned(this->receive_buffer_low_water_)) + '\n';
+  ret += formatNameForDump("receive_message_blocks")  + to_dds_string(unsigned(this->receive_message_blocks_)) + '\n';
+  ret += formatNameForDump("receive_data_blocks")     + to_dds_string(unsigned(this->receive_data_blocks_)) + '\n';
+  ret += formatNameForDump("receive_data_blocks_max") + to_dds_string(unsigned(this->receive_data_blocks_max_)) + '\n';
+  ret += formatNameForDump("reactor_threads")         + to_dds_string(unsigned(this->reactor_threads_)) + '\n';
+  ret += formatNameForDump("reactor_cpus");
+  for (size_t i = 0; i < this->reactor_cpus_.size(); ++i) {
+    ret += (i ? "," : "") + to_dds_string(this->reactor_cpus_[i]);
+  }
+  ret += '\n';
+  ret += formatNameForDump("io_uring")                + (this->use_io_uring_ ? "true" : "false") + '\n';
+  ret += formatNameForDump("io_uring_buffers")        + to_dds_string(unsigned(this->io_uring_buffers_)) + '\n';
+  ret += formatNameForDump("batch_bytes")             + to_dds_string(unsigned(this->batch_bytes_)) + '\n';
+  ret += formatNameForDump("batch_delay")             + to_dds_string(this->batch_delay_) + '\n';
+  ret += formatNameForDump("send_lanes")              + to_dds_string(unsigned(this->send_lanes_)) + '\n';
+  ret += formatNameForDump("send_lane_weights");
+  for (size_t i = 0; i < this->send_lane_weights_.size(); ++i) {
+    ret += (i ? "," : "") + to_dds_string(this->send_lane_weights_[i]);
+  }
+  ret += '\n';
+  ret += formatNameForDump("compression")             + this->compression_ + '\n';
+  ret += formatNameForDump("compression_threshold")   + to_dds_string(unsigned(this->compression_threshold_)) + '\n';
+  ret += formatNameForDump("compression_level")       + to_dds_string(this->compression_level_) + '\n';
+  ret += formatNameForDump("compression_max_size")    + to_dds_string(unsigned(this->compression_max_size_)) + '\n';
+  ret += formatNameForDump("thread_per_connection_cpus");
+  for (size_t i = 0; i < this->thread_per_connection_cpus_.size(); ++i) {
+    ret += (i ? "," : "") + to_dds_string(this->thread_per_connection_cpus_[i]);
+  }
+  ret += '\n';
+  ret += formatNameForDump("thread_per_connection_scheduler") + this->thread_per_connection_scheduler_ + '\n';
+  ret += formatNameForDump("thread_per_connection_priority") + to_dds_string(this->thread_per_connection_priority_) + '\n';
+  ret += formatNameForDump("thread_per_connection_queue_max") + to_dds_string(unsigned(this->thread_per_connection_queue_max_)) + '\n';
+  ret += formatNameForDump("thread_per_connection_backpressure") + this->thread_per_connection_backpressure_ + '\n';
+  ret += formatNameForDump("thread_per_connection_report_period") + to_dds_string(this->thread_per_connection_report_period_) + '\n';
+  ret += formatNameForDump("kernel_timestamps")       + (this->kernel_timestamps_ ? "true" : "false") + '\n';
+  ret += formatNameForDump("kernel_timestamps_report_period") + to_dds_string(this->kernel_timestamps_report_period_) + '\n';
   return ret;
 }
 
@@ -101,6 +101,133 @@ public:
   /// samples. The default value is 32.
   size_t datalink_control_chunks_;
 
+  /// Number of receive buffers in the ring each DataLink reads into.
+  /// The default value is 16.
+  size_t receive_buffers_;
+
+  /// A receive buffer with less free space than this (in bytes) is
+  /// retired from the ring once it has been parsed.  The default value
+  /// is 4096.
+  size_t receive_buffer_low_water_;
+
+  /// Number of pre-allocated message blocks used for received data
+  /// and the samples parsed out of it.  The default value is 1000.
+  size_t receive_message_blocks_;
+
+  /// Number of data blocks in each segment of the receive buffer pool.
+  /// The pool starts with one segment.  The default value is 100.
+  size_t receive_data_blocks_;
+
+  /// Upper bound on the data blocks the receive buffer pool may grow to
+  /// before further receive buffers overflow to the heap.  The default
+  /// value is 400.
+  size_t receive_data_blocks_max_;
+
+  /// Number of reactor threads the transport instance runs.  Each
+  /// DataLink is assigned to one of them by a hash of its remote
+  /// endpoint.  The default value is 1.
+  size_t reactor_threads_;
+
+  /// CPUs the reactor threads are bound to, assigned round robin.
+  /// Empty (the default) leaves the threads unbound.
+  OPENDDS_VECTOR(int) reactor_cpus_;
+
+  /// Receive through a Linux io_uring (see IoUringReceiver) instead of
+  /// reading the sockets when the reactor reports them readable.  Only
+  /// the tcp, udp and rtps_udp transports use it.  The default value is
+  /// false.
+  bool use_io_uring_;
+
+  /// Number of receive buffers registered with the io_uring of each
+  /// DataLink.  The default value is 64.
+  size_t io_uring_buffers_;
+
+  /// Batch samples written while the send strategy is idle: the packet
+  /// being built is held back until it reaches this many bytes (or one
+  /// of the optimum_packet_size and max_samples_per_packet limits), or
+  /// until batch_delay has passed since it was started.  The default
+  /// value is 0, which sends each packet as soon as the writer is done.
+  size_t batch_bytes_;
+
+  /// Longest time in microseconds a sample waits in a partially filled
+  /// batch.  Only used when batch_bytes is set.  The default value is
+  /// 1000.
+  long batch_delay_;
+
+  /// Number of priority lanes in the queue that holds samples while a
+  /// DataLink is backpressured.  A writer's samples are queued in the
+  /// lane of its TRANSPORT_PRIORITY (0 for the lowest lane, up to
+  /// send_lanes - 1 for the highest) and each packet is built from one
+  /// lane, so high priority samples overtake queued bulk data at packet
+  /// boundaries.  The default value is 1.
+  size_t send_lanes_;
+
+  /// Packets each lane may send per round, lowest lane first.  Empty (the
+  /// default) serves the lanes in strict priority order.
+  OPENDDS_VECTOR(int) send_lane_weights_;
+
+  /// Algorithm ("lz4", "zstd" or one installed with Compressor::install)
+  /// compressing the payload of samples sent to peers that can
+  /// decompress it.  Only the tcp and udp transports negotiate it.  The
+  /// default value is "none".
+  OPENDDS_STRING compression_;
+
+  /// Samples with a smaller payload (in bytes) are sent uncompressed.
+  /// The default value is 1024.
+  size_t compression_threshold_;
+
+  /// Passed to the compression algorithm: zstd's compression level or
+  /// LZ4's acceleration.  The default value is 0, which uses the
+  /// algorithm's default.
+  int compression_level_;
+
+  /// Largest payload (in bytes) a received compressed sample may claim to
+  /// restore to.  Samples claiming more are dropped without allocating
+  /// it.  The default value is 67108864 (64 MiB).
+  size_t compression_max_size_;
+
+  /// CPUs the thread_per_connection send threads are bound to, by
+  /// DataLink id modulo the number of CPUs.  Empty (the default) leaves
+  /// the threads unbound.
+  OPENDDS_VECTOR(int) thread_per_connection_cpus_;
+
+  /// Scheduling policy of the send threads: "SCHED_OTHER", "SCHED_FIFO"
+  /// or "SCHED_RR".  Empty (the default) uses DCPSScheduler's.
+  OPENDDS_STRING thread_per_connection_scheduler_;
+
+  /// Priority of the send threads.  The default value is 0, which maps
+  /// the link's TRANSPORT_PRIORITY to a thread priority.
+  int thread_per_connection_priority_;
+
+  /// Most samples the queue of a send thread holds.  The default value
+  /// is 0, for no limit.
+  size_t thread_per_connection_queue_max_;
+
+  /// What happens to a sample sent while the queue of a send thread is
+  /// full: "block" (the default) waits for room, for at most the writer's
+  /// max_blocking_time, "drop_oldest" drops the oldest queued sample and
+  /// "fail" drops the new one.  Dropped samples are reported to their
+  /// writer like samples the transport dropped.
+  OPENDDS_STRING thread_per_connection_backpressure_;
+
+  /// Milliseconds between the reports of the send queue statistics to the
+  /// monitor library, if it is enabled.  They are reported from the
+  /// transport's reactor; 0 doesn't report them.  The default value is
+  /// 10000.
+  long thread_per_connection_report_period_;
+
+  /// Have the kernel timestamp the datagrams the udp, multicast and
+  /// rtps_udp transports send and receive (see KernelTimestamps), and
+  /// measure where each DataLink's latency goes (see LinkLatency).
+  /// Linux only.  The default value is false.
+  bool kernel_timestamps_;
+
+  /// Milliseconds between the reports of the latency breakdowns to the
+  /// monitor library, if it is enabled.  Like the send task statistics
+  /// they are reported from the transport's reactor; 0 doesn't report
+  /// them.  The default value is 10000.
+  long kernel_timestamps_report_period_;
+
   /// Does the transport as configured support RELIABLE_RELIABILITY_QOS?
   virtual bool is_reliable() const = 0;
 
@@ -129,6 +256,10 @@ private:
   /// value.
   void adjust_config_value();
 
+  /// Parse a comma separated list of non-negative numbers (such as
+  /// reactor_cpus) into @a values.  Returns -1 if the list is malformed.
+  int parse_list(const char* list, OPENDDS_VECTOR(int)& values);
+
   friend class TransportRegistry;
   void shutdown();
 
@@ -21,6 +21,27 @@ OpenDDS::DCPS::TransportInst::TransportInst(const char* type,
     thread_per_connection_(0),
     datalink_release_delay_(10000),
     datalink_control_chunks_(32),
+    receive_buffers_(16),
+    receive_buffer_low_water_(4096),
+    receive_message_blocks_(1000),
+    receive_data_blocks_(100),
+    receive_data_blocks_max_(400),
+    reactor_threads_(1),
+    use_io_uring_(false),
+    io_uring_buffers_(64),
+    batch_bytes_(0),
+    batch_delay_(1000),
+    send_lanes_(1),
+    compression_("none"),
+    compression_threshold_(1024),
+    compression_level_(0),
+    compression_max_size_(64 * 1024 * 1024),
+    thread_per_connection_priority_(0),
+    thread_per_connection_queue_max_(0),
+    thread_per_connection_backpressure_("block"),
+    thread_per_connection_report_period_(10000),
+    kernel_timestamps_(false),
+    kernel_timestamps_report_period_(10000),
     name_(name)
 {
   DBG_ENTRY_LVL("TransportInst", "TransportInst", 6);
@@ -41,4 +62,77 @@ OpenDDS::DCPS::TransportInst::adjust_config_value()
                ACE_TEXT("(%P|%t) NOTICE: \"max_samples_per_packet\" is adjusted from %u to %u\n"),
                old_value, max_samples_per_packet_));
   }
+
+  // The receive buffer ring must be able to hold a maximum sized
+  // message even when every buffer in it is down to the low water mark.
+  if (receive_buffer_low_water_ == 0 ||
+      receive_buffer_low_water_ > size_t(RECEIVE_DATA_BUFFER_SIZE)) {
+    old_value = receive_buffer_low_water_;
+    receive_buffer_low_water_ = 4096;
+    ACE_DEBUG((LM_NOTICE,
+               ACE_TEXT("(%P|%t) NOTICE: \"receive_buffer_low_water\" is adjusted from %u to %u\n"),
+               old_value, receive_buffer_low_water_));
+  }
+
+  const size_t min_receive_buffers =
+    (size_t(RECEIVE_DATA_BUFFER_SIZE) + receive_buffer_low_water_ - 1) / receive_buffer_low_water_;
+
+  if (receive_buffers_ < min_receive_buffers) {
+    old_value = receive_buffers_;
+    receive_buffers_ = min_receive_buffers;
+    ACE_DEBUG((LM_NOTICE,
+               ACE_TEXT("(%P|%t) NOTICE: \"receive_buffers\" is adjusted from %u to %u\n"),
+               old_value, receive_buffers_));
+  }
+
+  // Each pool segment must be able to fill the whole ring.
+  if (receive_data_blocks_ < receive_buffers_) {
+    old_value = receive_data_blocks_;
+    receive_data_blocks_ = receive_buffers_;
+    ACE_DEBUG((LM_NOTICE,
+               ACE_TEXT("(%P|%t) NOTICE: \"receive_data_blocks\" is adjusted from %u to %u\n"),
+               old_value, receive_data_blocks_));
+  }
+
+  if (receive_data_blocks_max_ < receive_data_blocks_) {
+    receive_data_blocks_max_ = receive_data_blocks_;
+  }
+
+  if (reactor_threads_ == 0) {
+    reactor_threads_ = 1;
+    ACE_DEBUG((LM_NOTICE,
+               ACE_TEXT("(%P|%t) NOTICE: \"reactor_threads\" is adjusted from 0 to 1\n")));
+  }
+
+  // A batch must always be flushed by the timer eventually.
+  if (batch_bytes_ > 0 && batch_delay_ <= 0) {
+    const long old_delay = batch_delay_;
+    batch_delay_ = 1000;
+    ACE_DEBUG((LM_NOTICE,
+               ACE_TEXT("(%P|%t) NOTICE: \"batch_delay\" is adjusted from %d to %d\n"),
+               int(old_delay), int(batch_delay_)));
+  }
+
+  if (send_lanes_ == 0) {
+    send_lanes_ = 1;
+    ACE_DEBUG((LM_NOTICE,
+               ACE_TEXT("(%P|%t) NOTICE: \"send_lanes\" is adjusted from 0 to 1\n")));
+  }
+
+  // Every lane needs a weight, and a lane without credit would never
+  // be served.
+  if (!send_lane_weights_.empty()) {
+    if (send_lane_weights_.size() != send_lanes_) {
+      ACE_DEBUG((LM_NOTICE,
+                 ACE_TEXT("(%P|%t) NOTICE: \"send_lane_weights\" has %B weights ")
+                 ACE_TEXT("for %B lanes, missing weights are 1\n"),
+                 send_lane_weights_.size(), send_lanes_));
+      send_lane_weights_.resize(send_lanes_, 1);
+    }
+    for (size_t i = 0; i < send_lane_weights_.size(); ++i) {
+      if (send_lane_weights_[i] == 0) {
+        send_lane_weights_[i] = 1;
+      }
+    }
+  }
 }
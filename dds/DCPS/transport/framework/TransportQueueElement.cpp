@@ -32,6 +32,18 @@ TransportQueueElement::requires_exclusive_packet() const
   return false;
 }
 
+Priority
+TransportQueueElement::priority() const
+{
+  return 0;
+}
+
+ACE_Time_Value
+TransportQueueElement::max_blocking_time() const
+{
+  return ACE_Time_Value::max_time;
+}
+
 bool
 TransportQueueElement::is_control(RepoId /*pub_id*/) const
 {
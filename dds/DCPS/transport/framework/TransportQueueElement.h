@@ -13,6 +13,9 @@
 #include "dds/DCPS/GuidUtils.h"
 #include "dds/DCPS/PoolAllocationBase.h"
 #include "dds/DCPS/SequenceNumber.h"
+#include "TransportDefs.h"
+
+#include "ace/Time_Value.h"
 
 #include <utility>
 
@@ -103,6 +106,14 @@ public:
   /// Accessor for the publication id that sent the sample.
   virtual RepoId publication_id() const = 0;
 
+  /// TRANSPORT_PRIORITY of the publication that sent the sample.
+  virtual Priority priority() const;
+
+  /// How long the publication that sent the sample may block waiting for
+  /// room in a full queue (its RELIABILITY max_blocking_time), or
+  /// ACE_Time_Value::max_time to wait as long as it takes.
+  virtual ACE_Time_Value max_blocking_time() const;
+
   /// Accessor for the subscription id, if sent the sample is sent to 1 sub
   virtual RepoId subscription_id() const {
     return GUID_UNKNOWN;
@@ -125,6 +136,11 @@ public:
   bool released() const;
   void released(bool flag);
 
+  /// When DataLink::send() queued the element, if the link measures its
+  /// latency (see LinkLatency); zero otherwise.
+  const ACE_Time_Value& send_time() const;
+  void send_time(const ACE_Time_Value& time);
+
   /// Clone method with provided message block allocator and data block
   /// allocators.
   static ACE_Message_Block* clone_mb(const ACE_Message_Block* msg,
@@ -176,6 +192,8 @@ private:
 
   /// If the callback to DW is made.
   bool released_;
+
+  ACE_Time_Value send_time_;
 };
 
 } // namespace DCPS
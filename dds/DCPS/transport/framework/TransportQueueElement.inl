@@ -17,7 +17,8 @@ ACE_INLINE
 TransportQueueElement::TransportQueueElement(unsigned long initial_count)
   : sub_loan_count_(initial_count),
     dropped_(false),
-    released_(false)
+    released_(false),
+    send_time_(ACE_Time_Value::zero)
 {
   DBG_ENTRY_LVL("TransportQueueElement", "TransportQueueElement", 6);
 }
@@ -93,6 +94,20 @@ TransportQueueElement::released(bool flag)
   this->released_ = flag;
 }
 
+ACE_INLINE
+const ACE_Time_Value&
+TransportQueueElement::send_time() const
+{
+  return this->send_time_;
+}
+
+ACE_INLINE
+void
+TransportQueueElement::send_time(const ACE_Time_Value& time)
+{
+  this->send_time_ = time;
+}
+
 ACE_INLINE
 bool
 TransportQueueElement::MatchOnPubId::matches(
@@ -6,6 +6,8 @@
  */
 
 #include "TransportReceiveStrategy_T.h"
+#include "TransportInst.h"
+#include "Compressor.h"
 #include "ace/INET_Addr.h"
 #include "ace/Min_Max.h"
 
@@ -19,32 +21,43 @@ namespace OpenDDS {
 namespace DCPS {
 
 template<typename TH, typename DSH>
-TransportReceiveStrategy<TH, DSH>::TransportReceiveStrategy()
+TransportReceiveStrategy<TH, DSH>::TransportReceiveStrategy(const TransportInst& config)
   : gracefully_disconnected_(false),
     receive_sample_remaining_(0),
-    mb_allocator_(MESSAGE_BLOCKS),
-    db_allocator_(DATA_BLOCKS),
-    data_allocator_(DATA_BLOCKS),
+    receive_buffer_count_(config.receive_buffers_),
+    buffer_low_water_(config.receive_buffer_low_water_),
+    mb_allocator_(config.receive_message_blocks_),
+    data_blocks_per_segment_(segment_blocks(config)),
+    max_pool_segments_(max_segments(config)),
+    max_decompressed_size_(config.compression_max_size_),
+    pool_grows_(0),
+    pool_shrinks_(0),
+    released_data_hits_(0),
+    released_data_misses_(0),
+    receive_peak_(0),
+    receive_buffers_(config.receive_buffers_, static_cast<ACE_Message_Block*>(0)),
+    iov_(config.receive_buffers_),
     buffer_index_(0),
     payload_(0),
     good_pdu_(true),
-    pdu_remaining_(0)
+    pdu_remaining_(0),
+    kernel_receive_time_(ACE_Time_Value::zero)
 {
   DBG_ENTRY_LVL("TransportReceiveStrategy", "TransportReceiveStrategy" ,6);
 
+  this->pool_segments_.push_back(
+    new PoolSegment(this->data_blocks_per_segment_, this->pool_lock_));
+
   if (Transport_debug_level >= 2) {
     ACE_DEBUG((LM_DEBUG,"(%P|%t) TransportReceiveStrategy-mb"
                " Cached_Allocator_With_Overflow %x with %d chunks\n",
-               &mb_allocator_, MESSAGE_BLOCKS));
-    ACE_DEBUG((LM_DEBUG,"(%P|%t) TransportReceiveStrategy-db"
-               " Cached_Allocator_With_Overflow %x with %d chunks\n",
-               &db_allocator_, DATA_BLOCKS));
+               &mb_allocator_, config.receive_message_blocks_));
     ACE_DEBUG((LM_DEBUG,"(%P|%t) TransportReceiveStrategy-data"
-               " Cached_Allocator_With_Overflow %x with %d chunks\n",
-               &data_allocator_, DATA_BLOCKS));
+               " pool with %d receive buffers, segments of %d chunks,"
+               " at most %d segments\n",
+               receive_buffer_count_, data_blocks_per_segment_,
+               max_pool_segments_));
   }
-
-  ACE_OS::memset(this->receive_buffers_, 0, sizeof(this->receive_buffers_));
 }
 
 template<typename TH, typename DSH>
@@ -62,6 +75,193 @@ TransportReceiveStrategy<TH, DSH>::~TransportReceiveStrategy()
                  size));
     }
   }
+
+  if (Transport_debug_level >= 2) {
+    const ReceiveBufferPoolStats stats = this->pool_stats();
+    ACE_DEBUG((LM_DEBUG,
+               ACE_TEXT("(%P|%t) TransportReceiveStrategy::~TransportReceiveStrategy() - ")
+               ACE_TEXT("data blocks: %u pool hits, %u heap misses; ")
+               ACE_TEXT("message blocks: %u pool hits, %u heap misses; ")
+               ACE_TEXT("pool grew %u and shrank %u times; ")
+               ACE_TEXT("receive peak %u bytes.\n"),
+               stats.data_hits, stats.data_misses,
+               stats.message_block_hits, stats.message_block_misses,
+               stats.grows, stats.shrinks, stats.receive_peak));
+  }
+
+  // The receive buffers hold on to the segments' data blocks.
+  for (size_t i = 0; i < this->receive_buffers_.size(); ++i) {
+    if (this->receive_buffers_[i] != 0) {
+      this->receive_buffers_[i]->cont(0);
+      ACE_DES_FREE(this->receive_buffers_[i],
+                   this->mb_allocator_.free,
+                   ACE_Message_Block);
+      this->receive_buffers_[i] = 0;
+    }
+  }
+  ACE_Message_Block::release(this->payload_);
+  this->payload_ = 0;
+
+  for (size_t i = 0; i < this->pool_segments_.size(); ++i) {
+    delete this->pool_segments_[i];
+  }
+}
+
+template<typename TH, typename DSH>
+size_t
+TransportReceiveStrategy<TH, DSH>::segment_blocks(const TransportInst& config)
+{
+  // TransportInst::adjust_config_value() normally guarantees this, but
+  // the fields are public and may be changed after it ran.
+  return ace_max(config.receive_data_blocks_,
+                 ace_max(config.receive_buffers_, size_t(1)));
+}
+
+template<typename TH, typename DSH>
+size_t
+TransportReceiveStrategy<TH, DSH>::max_segments(const TransportInst& config)
+{
+  return ace_max(config.receive_data_blocks_max_ / segment_blocks(config),
+                 size_t(1));
+}
+
+template<typename TH, typename DSH>
+template<typename Allocator>
+void*
+TransportReceiveStrategy<TH, DSH>::SegmentAllocator<Allocator>::malloc(size_t nbytes)
+{
+  void* const ptr = Allocator::malloc(nbytes);
+  if (ptr != 0) {
+    ACE_GUARD_RETURN(ACE_SYNCH_MUTEX, guard, this->lock_, ptr);
+    ++this->in_use_;
+  }
+  return ptr;
+}
+
+template<typename TH, typename DSH>
+template<typename Allocator>
+void
+TransportReceiveStrategy<TH, DSH>::SegmentAllocator<Allocator>::free(void* ptr)
+{
+  if (ptr == 0) {
+    return;
+  }
+  Allocator::free(ptr);
+  // Nothing of the segment is touched after the lock is released.
+  ACE_GUARD(ACE_SYNCH_MUTEX, guard, this->lock_);
+  --this->in_use_;
+}
+
+template<typename TH, typename DSH>
+size_t
+TransportReceiveStrategy<TH, DSH>::pool_available() const
+{
+  size_t available = 0;
+  for (size_t i = 0; i < this->pool_segments_.size(); ++i) {
+    available += this->pool_segments_[i]->data_allocator_.available();
+  }
+  return available;
+}
+
+template<typename TH, typename DSH>
+bool
+TransportReceiveStrategy<TH, DSH>::grow_pool()
+{
+  if (this->pool_segments_.size() >= this->max_pool_segments_) {
+    return false;
+  }
+
+  PoolSegment* const segment =
+    new PoolSegment(this->data_blocks_per_segment_, this->pool_lock_);
+  {
+    ACE_GUARD_RETURN(ACE_SYNCH_MUTEX, guard, this->pool_lock_, false);
+    this->pool_segments_.push_back(segment);
+    ++this->pool_grows_;
+  }
+
+  VDBG_LVL((LM_DEBUG, "(%P|%t) TransportReceiveStrategy::grow_pool() - "
+            "now %d segments of %d chunks.\n",
+            this->pool_segments_.size(), this->data_blocks_per_segment_), 2);
+  return true;
+}
+
+template<typename TH, typename DSH>
+void
+TransportReceiveStrategy<TH, DSH>::shrink_pool()
+{
+  // Newer segments are released first; the first segment always stays.
+  while (this->pool_segments_.size() > 1) {
+    PoolSegment* const segment = this->pool_segments_.back();
+    {
+      ACE_GUARD(ACE_SYNCH_MUTEX, guard, this->pool_lock_);
+      // Blocks only come from a segment without any in use on this
+      // thread, so it stays idle once it is out of pool_segments_.
+      if (segment->in_use_ != 0 ||
+          this->pool_available() - segment->chunks_ < 2 * this->high_water()) {
+        return;
+      }
+      this->pool_segments_.pop_back();
+      this->released_data_hits_ += segment->data_allocator_.allocs_from_pool_.value();
+      this->released_data_misses_ += segment->data_allocator_.allocs_from_heap_.value();
+      ++this->pool_shrinks_;
+    }
+    delete segment;
+
+    VDBG_LVL((LM_DEBUG, "(%P|%t) TransportReceiveStrategy::shrink_pool() - "
+              "now %d segments of %d chunks.\n",
+              this->pool_segments_.size(), this->data_blocks_per_segment_), 2);
+  }
+}
+
+template<typename TH, typename DSH>
+size_t
+TransportReceiveStrategy<TH, DSH>::high_water() const
+{
+  return ace_min(this->receive_peak_ / RECEIVE_DATA_BUFFER_SIZE + 2,
+                 this->receive_buffer_count_);
+}
+
+template<typename TH, typename DSH>
+typename TransportReceiveStrategy<TH, DSH>::PoolSegment*
+TransportReceiveStrategy<TH, DSH>::select_segment()
+{
+  if (this->pool_available() < this->high_water()) {
+    this->grow_pool();
+  }
+
+  // Prefer the oldest segment with free blocks so that newer ones drain.
+  for (size_t i = 0; i < this->pool_segments_.size(); ++i) {
+    if (this->pool_segments_[i]->data_allocator_.available() > 0) {
+      return this->pool_segments_[i];
+    }
+  }
+
+  // The pool is at its maximum; this allocation overflows to the heap.
+  return this->pool_segments_.back();
+}
+
+template<typename TH, typename DSH>
+ReceiveBufferPoolStats
+TransportReceiveStrategy<TH, DSH>::pool_stats() const
+{
+  ReceiveBufferPoolStats stats = ReceiveBufferPoolStats();
+  stats.message_block_hits = this->mb_allocator_.allocs_from_pool_.value();
+  stats.message_block_misses = this->mb_allocator_.allocs_from_heap_.value();
+
+  ACE_GUARD_RETURN(ACE_SYNCH_MUTEX, guard, this->pool_lock_, stats);
+  stats.data_hits = this->released_data_hits_;
+  stats.data_misses = this->released_data_misses_;
+  for (size_t i = 0; i < this->pool_segments_.size(); ++i) {
+    stats.data_hits += this->pool_segments_[i]->data_allocator_.allocs_from_pool_.value();
+    stats.data_misses += this->pool_segments_[i]->data_allocator_.allocs_from_heap_.value();
+  }
+  stats.segments = this->pool_segments_.size();
+  stats.data_blocks = stats.segments * this->data_blocks_per_segment_;
+  stats.grows = this->pool_grows_;
+  stats.shrinks = this->pool_shrinks_;
+  stats.receive_peak = this->receive_peak_;
+  stats.high_water = this->high_water();
+  return stats;
 }
 
 template<typename TH, typename DSH>
@@ -157,11 +357,12 @@ TransportReceiveStrategy<TH, DSH>::handle_dds_input(ACE_HANDLE fd)
   // than the low water amount of space left.
   //
   size_t index;
+  bool retired = false;
 
-  for (index = 0; index < RECEIVE_BUFFERS; ++index) {
+  for (index = 0; index < this->receive_buffer_count_; ++index) {
     if ((this->receive_buffers_[index] != 0)
         && (this->receive_buffers_[index]->length() == 0)
-        && (this->receive_buffers_[index]->space() < BUFFER_LOW_WATER)) {
+        && (this->receive_buffers_[index]->space() < this->buffer_low_water_)) {
       VDBG((LM_DEBUG,"(%P|%t) DBG:   "
             "Remove a receive_buffer_[%d] from use.\n",
             index));
@@ -169,7 +370,7 @@ TransportReceiveStrategy<TH, DSH>::handle_dds_input(ACE_HANDLE fd)
       // unlink any Message_Block that continues to this one
       // being removed.
       // This avoids a possible infinite ->cont() loop.
-      for (size_t ii =0; ii < RECEIVE_BUFFERS; ii++) {
+      for (size_t ii =0; ii < this->receive_buffer_count_; ii++) {
         if ((0 != this->receive_buffers_[ii]) &&
             (this->receive_buffers_[ii]->cont() ==
              this->receive_buffers_[index])) {
@@ -185,9 +386,17 @@ TransportReceiveStrategy<TH, DSH>::handle_dds_input(ACE_HANDLE fd)
         this->mb_allocator_.free,
         ACE_Message_Block);
       this->receive_buffers_[index] = 0;
+      retired = true;
     }
   }
 
+  //
+  // Retired buffers may have left pool segments idle.
+  //
+  if (retired) {
+    this->shrink_pool();
+  }
+
   //
   // Allocate buffers for any empty slots.  We may have emptied one just
   // here, but others may have been emptied by a large read during the
@@ -203,6 +412,8 @@ TransportReceiveStrategy<TH, DSH>::handle_dds_input(ACE_HANDLE fd)
             "Allocate a Message_Block for new receive_buffer_[%d].\n",
             index));
 
+      PoolSegment* const segment = this->select_segment();
+
       ACE_NEW_MALLOC_RETURN(
         this->receive_buffers_[index],
         (ACE_Message_Block*) this->mb_allocator_.malloc(
@@ -212,12 +423,12 @@ TransportReceiveStrategy<TH, DSH>::handle_dds_input(ACE_HANDLE fd)
           ACE_Message_Block::MB_DATA,   // Default
           0,                            // Start with no continuation
           0,                            // Let the constructor allocate
-          &this->data_allocator_,       // Our buffer cache
+          &segment->data_allocator_,    // Our buffer cache
           &this->receive_lock_,         // Our locking strategy
           ACE_DEFAULT_MESSAGE_BLOCK_PRIORITY, // Default
           ACE_Time_Value::zero,         // Default
           ACE_Time_Value::max_time,     // Default
-          &this->db_allocator_,         // Our data block cache
+          &segment->db_allocator_,      // Our data block cache
           &this->mb_allocator_          // Our message block cache
         ),
         -1);
@@ -256,12 +467,12 @@ TransportReceiveStrategy<TH, DSH>::handle_dds_input(ACE_HANDLE fd)
   //
   // Form the iovec from the message block chain of receive buffers.
   //
-  iovec iov[RECEIVE_BUFFERS];
+  iovec* const iov = &this->iov_[0];
   size_t vec_index = 0;
   size_t current = this->buffer_index_;
 
   for (index = 0;
-       index < RECEIVE_BUFFERS;
+       index < this->receive_buffer_count_;
        ++index, current = this->successor_index(current)) {
     // Invariant.  ASSERT?
     if (this->receive_buffers_[current] == 0) {
@@ -303,6 +514,7 @@ TransportReceiveStrategy<TH, DSH>::handle_dds_input(ACE_HANDLE fd)
   //
   ACE_INET_Addr remote_address;
   bool stop = false;
+  this->kernel_receive_time_ = ACE_Time_Value::zero;
   ssize_t bytes_remaining = this->receive_bytes(iov,
                                                 static_cast<int>(vec_index),
                                                 remote_address,
@@ -331,6 +543,14 @@ TransportReceiveStrategy<TH, DSH>::handle_dds_input(ACE_HANDLE fd)
             "recvv() return %d - we call this the bytes_remaining.\n",
             bytes_remaining), 5);
 
+  // The pool's watermarks follow the size of what the link receives.
+  {
+    ACE_GUARD_RETURN(ACE_SYNCH_MUTEX, guard, this->pool_lock_, -1);
+    this->receive_peak_ =
+      ace_max(static_cast<size_t>(bytes_remaining),
+              this->receive_peak_ - this->receive_peak_ / 16);
+  }
+
   if (bytes_remaining == 0) {
     if (this->gracefully_disconnected_) {
       VDBG_LVL((LM_INFO,
@@ -825,6 +1045,7 @@ TransportReceiveStrategy<TH, DSH>::handle_dds_input(ACE_HANDLE fd)
 
         ReceivedDataSample rds(this->payload_);
         this->payload_ = 0;  // rds takes ownership of payload_
+        rds.kernel_receive_time_ = this->kernel_receive_time_;
         if (this->data_sample_header_.into_received_data_sample(rds)) {
 
           if (this->data_sample_header_.more_fragments()
@@ -833,12 +1054,14 @@ TransportReceiveStrategy<TH, DSH>::handle_dds_input(ACE_HANDLE fd)
 
             if (this->reassemble(rds)) {
               VDBG((LM_DEBUG,"(%P|%t) DBG:   Reassembled complete message\n"));
-              this->deliver_sample(rds, remote_address);
+              if (Compressor::decompress_sample(rds, this->max_decompressed_size_)) {
+                this->deliver_sample(rds, remote_address);
+              }
             }
             // If reassemble() returned false, it takes ownership of the data
             // just like deliver_sample() does.
 
-          } else {
+          } else if (Compressor::decompress_sample(rds, this->max_decompressed_size_)) {
             this->deliver_sample(rds, remote_address);
           }
         }
@@ -896,7 +1119,7 @@ TransportReceiveStrategy<TH, DSH>::reset()
   this->payload_ = 0;
   this->good_pdu_ = true;
   this->pdu_remaining_ = 0;
-  for (int i = 0; i < RECEIVE_BUFFERS; ++i) {
+  for (size_t i = 0; i < this->receive_buffer_count_; ++i) {
     ACE_Message_Block& rb = *this->receive_buffers_[i];
     rb.rd_ptr(rb.wr_ptr());
   }
@@ -14,6 +14,8 @@
 #include "TransportDefs.h"
 #include "TransportHeader.h"
 
+#include "dds/DCPS/PoolAllocator.h"
+
 #include "ace/INET_Addr.h"
 #include "ace/Lock_Adapter_T.h"
 #include "ace/Synch_Traits.h"
@@ -23,6 +25,28 @@ OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 namespace OpenDDS {
 namespace DCPS {
 
+class TransportInst;
+
+/// Snapshot of the receive buffer pool counters of a
+/// TransportReceiveStrategy.  A "hit" is an allocation served from the
+/// pre-allocated pool, a "miss" one that overflowed to the heap.  The
+/// data counters include the segments that have been released.
+struct ReceiveBufferPoolStats {
+  unsigned long data_hits;
+  unsigned long data_misses;
+  unsigned long message_block_hits;
+  unsigned long message_block_misses;
+  size_t segments;
+  size_t data_blocks;
+  size_t grows;
+  /// Segments released (deleted) by the pool.
+  size_t shrinks;
+  /// Recent peak of the bytes returned by one receive.
+  size_t receive_peak;
+  /// Free data blocks below which the pool grows, from receive_peak.
+  size_t high_water;
+};
+
 /**
  * This class provides buffer for data received by transports, de-assemble
  * the data to individual samples and deliver them.
@@ -54,8 +78,11 @@ public:
   const DSH& received_sample_header() const;
   DSH& received_sample_header();
 
+  /// Current receive buffer pool counters.
+  ReceiveBufferPoolStats pool_stats() const;
+
 protected:
-  TransportReceiveStrategy();
+  explicit TransportReceiveStrategy(const TransportInst& config);
 
   /// Only our subclass knows how to do this.
   virtual ssize_t receive_bytes(iovec          iov[],
@@ -99,6 +126,30 @@ private:
 
   void update_buffer_index(bool& done);
 
+  struct PoolSegment;
+
+  /// Choose the pool segment to take the next receive buffer from,
+  /// growing the pool when it runs low.
+  PoolSegment* select_segment();
+
+  /// Add a segment to the pool if the configured maximum allows it.
+  bool grow_pool();
+
+  /// Release idle segments once the rest of the pool has headroom.
+  void shrink_pool();
+
+  /// Free data blocks the largest recent receive would take from the
+  /// pool: the buffers it fills, and the partly filled one it leaves.
+  size_t high_water() const;
+
+  /// Pool sizes derived from the configuration; a zero
+  /// receive_data_blocks falls back to one segment filling the ring.
+  static size_t segment_blocks(const TransportInst& config);
+  static size_t max_segments(const TransportInst& config);
+
+  /// Number of free data blocks across all pool segments.
+  size_t pool_available() const;
+
   virtual bool reassemble(ReceivedDataSample& data);
 
   /// Bytes remaining in the current DataSample.
@@ -110,29 +161,94 @@ private:
   //
   // The total available space in the receive buffers must have enough to hold
   // a max sized message.  The max message is about 64K and the low water for
-  // a buffer is 4096.  Therefore, 16 receive buffers is appropriate.
+  // a buffer defaults to 4096, so 16 receive buffers are used by default.
+  // TransportInst::adjust_config_value() keeps configured values consistent.
   //
-  enum { RECEIVE_BUFFERS  =   16 };
-  enum { BUFFER_LOW_WATER = 4096 };
+  const size_t receive_buffer_count_;
+  const size_t buffer_low_water_;
 
   //
   // Message Block Allocators are more plentiful since they hold samples
   // as well as data read from the handle(s).
   //
-  enum { MESSAGE_BLOCKS   = 1000 };
-  enum { DATA_BLOCKS      =  100 };
-
-//MJM: We should probably bring the allocator typedefs down into this
-//MJM: class since they are limited to this scope.
   TransportMessageBlockAllocator mb_allocator_;
-  TransportDataBlockAllocator    db_allocator_;
-  TransportDataAllocator         data_allocator_;
+
+  /// One of a segment's allocators.  It counts the chunks the segment
+  /// has given out, from the pool or the heap, under the strategy's
+  /// pool_lock_.  A thread returning the last chunk is done with the
+  /// segment once it has released that lock, so the receiving thread
+  /// may delete a segment it finds with nothing in use.
+  template <typename Allocator>
+  class SegmentAllocator : public Allocator {
+  public:
+    SegmentAllocator(size_t n_chunks, size_t& in_use, ACE_SYNCH_MUTEX& lock)
+      : Allocator(n_chunks)
+      , in_use_(in_use)
+      , lock_(lock)
+    {}
+
+    void* malloc(size_t nbytes);
+    void free(void* ptr);
+
+  private:
+    size_t& in_use_;
+    ACE_SYNCH_MUTEX& lock_;
+  };
+
+  /// The data blocks and their buffers come from a pool of equally sized
+  /// segments.  The pool grows by a segment when fewer free data blocks
+  /// remain than the largest recent receive would take (high water), and
+  /// a segment is released once none of its blocks are in use and the
+  /// rest of the pool has twice that many free (low water), so links
+  /// with small packets keep only the first segment.  Blocks remember
+  /// the segment they came from, so segments can come and go while
+  /// received samples still refer to older ones.
+  struct PoolSegment {
+    PoolSegment(size_t n_chunks, ACE_SYNCH_MUTEX& lock)
+      : in_use_(0)
+      , db_allocator_(n_chunks, in_use_, lock)
+      , data_allocator_(n_chunks, in_use_, lock)
+      , chunks_(n_chunks)
+    {}
+
+    /// Data blocks and buffers given out and not yet returned.
+    size_t in_use_;
+    SegmentAllocator<TransportDataBlockAllocator> db_allocator_;
+    SegmentAllocator<TransportDataAllocator>      data_allocator_;
+    const size_t                                  chunks_;
+  };
+  typedef OPENDDS_VECTOR(PoolSegment*) PoolSegments;
+
+  PoolSegments pool_segments_;
+  const size_t data_blocks_per_segment_;
+  const size_t max_pool_segments_;
+
+  /// Largest payload a compressed sample may restore to.
+  const size_t max_decompressed_size_;
+
+  /// How often the pool has changed size.
+  size_t pool_grows_;
+  size_t pool_shrinks_;
+
+  /// Data counters of the segments that were released.
+  unsigned long released_data_hits_;
+  unsigned long released_data_misses_;
+
+  /// Peak of the bytes returned by receive_bytes(), decaying by 1/16 on
+  /// each receive so that the pool follows the link's current packets.
+  size_t receive_peak_;
+
+  /// Protects pool_segments_, receive_peak_ and the segments' in_use_
+  /// counts.  Only the receiving thread changes the pool, so it reads
+  /// pool_segments_ and receive_peak_ without the lock.
+  mutable ACE_SYNCH_MUTEX pool_lock_;
 
   /// Locking strategy for the allocators.
   ACE_Lock_Adapter<ACE_SYNCH_MUTEX> receive_lock_;
 
-  /// Set of receive buffers in use.
-  ACE_Message_Block* receive_buffers_[RECEIVE_BUFFERS];
+  /// Ring of receive buffers in use, and the iovec formed from it.
+  OPENDDS_VECTOR(ACE_Message_Block*) receive_buffers_;
+  OPENDDS_VECTOR(iovec) iov_;
 
   /// Current receive buffer index in use.
   size_t buffer_index_;
@@ -152,6 +268,10 @@ private:
 
   /// Amount of the current PDU that has not been processed yet.
   size_t pdu_remaining_;
+
+  /// Set by receive_bytes() to the kernel's receive timestamp of the
+  /// datagram it returned, if the transport sets kernel_timestamps.
+  ACE_Time_Value kernel_receive_time_;
 };
 
 } // namespace DCPS */
@@ -56,7 +56,7 @@ template<typename TH, typename DSH>
 ACE_INLINE size_t
 OpenDDS::DCPS::TransportReceiveStrategy<TH, DSH>::successor_index(size_t index) const
 {
-  return ++index % RECEIVE_BUFFERS;
+  return ++index % this->receive_buffer_count_;
 }
 
 template<typename TH, typename DSH>
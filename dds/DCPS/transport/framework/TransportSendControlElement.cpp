@@ -120,6 +120,19 @@ TransportSendControlElement::publication_id() const
   return this->publisher_id_;
 }
 
+Priority
+TransportSendControlElement::priority() const
+{
+  return this->listener_ ? this->listener_->transport_priority() : 0;
+}
+
+ACE_Time_Value
+TransportSendControlElement::max_blocking_time() const
+{
+  return this->listener_ ? this->listener_->max_blocking_time()
+                         : ACE_Time_Value::max_time;
+}
+
 const ACE_Message_Block*
 TransportSendControlElement::msg() const
 {
@@ -51,6 +51,9 @@ public:
   /// Accessor for the publisher id.
   virtual RepoId publication_id() const;
 
+  virtual Priority priority() const;
+  virtual ACE_Time_Value max_blocking_time() const;
+
   /// Accessor for the ACE_Message_Block
   virtual const ACE_Message_Block* msg() const;
 
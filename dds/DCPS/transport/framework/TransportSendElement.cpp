@@ -44,6 +44,20 @@ OpenDDS::DCPS::TransportSendElement::publication_id() const
   return this->element_->get_pub_id();
 }
 
+OpenDDS::DCPS::Priority
+OpenDDS::DCPS::TransportSendElement::priority() const
+{
+  const TransportSendListener* listener = this->element_->get_send_listener();
+  return listener ? listener->transport_priority() : 0;
+}
+
+ACE_Time_Value
+OpenDDS::DCPS::TransportSendElement::max_blocking_time() const
+{
+  const TransportSendListener* listener = this->element_->get_send_listener();
+  return listener ? listener->max_blocking_time() : ACE_Time_Value::max_time;
+}
+
 OpenDDS::DCPS::RepoId
 OpenDDS::DCPS::TransportSendElement::subscription_id() const
 {
@@ -77,6 +77,18 @@ TransportSendListener::retrieve_inline_qos_data(InlineQosData& qos_data) const
   qos_data.topic_name = "";
 }
 
+Priority
+TransportSendListener::transport_priority() const
+{
+  return 0;
+}
+
+ACE_Time_Value
+TransportSendListener::max_blocking_time() const
+{
+  return ACE_Time_Value::max_time;
+}
+
 } }
 
 OPENDDS_END_VERSIONED_NAMESPACE_DECL
@@ -17,6 +17,8 @@
 #include "dds/DCPS/PoolAllocator.h"
 #include "dds/DCPS/SequenceNumber.h"
 
+#include "ace/Time_Value.h"
+
 ACE_BEGIN_VERSIONED_NAMESPACE_DECL
 class ACE_Message_Block;
 ACE_END_VERSIONED_NAMESPACE_DECL
@@ -71,6 +73,15 @@ public:
 
   virtual void retrieve_inline_qos_data(InlineQosData& qos_data) const;
 
+  /// TRANSPORT_PRIORITY of the samples being sent, which selects the
+  /// send lane they are queued in.
+  virtual Priority transport_priority() const;
+
+  /// Longest time a sample may wait for room in a full send queue (see
+  /// thread_per_connection_backpressure), ACE_Time_Value::max_time for
+  /// no limit.
+  virtual ACE_Time_Value max_blocking_time() const;
+
 protected:
 
   TransportSendListener();
@@ -19,11 +19,14 @@
 #include "PacketRemoveVisitor.h"
 #include "TransportDefs.h"
 #include "DirectPriorityMapper.h"
+#include "LinkLatency.h"
 #include "dds/DCPS/DataSampleHeader.h"
 #include "dds/DCPS/DataSampleElement.h"
 #include "dds/DCPS/Service_Participant.h"
 #include "EntryExit.h"
 
+#include "ace/Reactor.h"
+#include "ace/OS_NS_sys_time.h"
 #include "ace/Reverse_Lock_T.h"
 
 #if !defined (__ACE_INLINE__)
@@ -48,6 +51,29 @@ namespace {
   /// In this case "payload data" includes the content-filtering
   /// GUID sequence, so this is chosen to be 4 + (16 * N).
   static const size_t MIN_FRAG = 68;
+
+  /// Records how long each element of a packet about to be sent waited
+  /// since DataLink::send(), once per element.
+  class SendTimeVisitor : public BasicQueueVisitor<TransportQueueElement> {
+  public:
+    SendTimeVisitor(LinkLatency& latency, const ACE_Time_Value& now)
+      : latency_(latency)
+      , now_(now)
+    {}
+
+    int visit_element(TransportQueueElement* element)
+    {
+      if (element->send_time() != ACE_Time_Value::zero) {
+        latency_.record(LinkLatency::SEND_QUEUE, now_ - element->send_time());
+        element->send_time(ACE_Time_Value::zero);
+      }
+      return 1;
+    }
+
+  private:
+    LinkLatency& latency_;
+    const ACE_Time_Value now_;
+  };
 }
 
 // I think 2 chunks for the header message block is enough
@@ -65,6 +91,12 @@ TransportSendStrategy::TransportSendStrategy(
     max_samples_(transport.config().max_samples_per_packet_),
     optimum_size_(transport.config().optimum_packet_size_),
     max_size_(transport.config().max_packet_size_),
+    batch_bytes_(transport.config().batch_bytes_),
+    batch_delay_(0, transport.config().batch_delay_),
+    batch_timer_(make_rch<BatchTimer>(this)),
+    batch_scheduled_(false),
+    batch_deadline_(ACE_Time_Value::zero),
+    batch_timer_flushes_(0),
     max_header_size_(0),
     header_block_(0),
     pkt_chain_(0),
@@ -78,7 +110,8 @@ TransportSendStrategy::TransportSendStrategy(
     transport_(transport),
     graceful_disconnecting_(false),
     link_released_(true),
-    send_buffer_(0)
+    send_buffer_(0),
+    latency_(0)
 {
   DBG_ENTRY_LVL("TransportSendStrategy","TransportSendStrategy",6);
 
@@ -97,6 +130,9 @@ TransportSendStrategy::TransportSendStrategy(
   // don't want to keep asking for it over and over.
   this->max_header_size_ = TransportHeader::max_marshaled_size();
 
+  this->queue_.configure(transport.config().send_lanes_,
+                         transport.config().send_lane_weights_);
+
   delayed_delivered_notification_queue_.reserve(this->max_samples_);
 }
 
@@ -118,6 +154,12 @@ TransportSendStrategy::send_buffer(TransportSendBuffer* send_buffer)
   }
 }
 
+void
+TransportSendStrategy::latency(LinkLatency* latency)
+{
+  this->latency_ = latency;
+}
+
 ThreadSynchWorker::WorkOutcome
 TransportSendStrategy::perform_work()
 {
@@ -783,7 +825,7 @@ TransportSendStrategy::clear(SendMode mode)
     }
 
     elems.swap(this->elems_);
-    queue.swap(this->queue_);
+    this->queue_.drain(queue);
 
     this->header_.length_ = 0;
     this->pkt_chain_ = 0;
@@ -853,6 +895,28 @@ TransportSendStrategy::stop()
 {
   DBG_ENTRY_LVL("TransportSendStrategy","stop",6);
 
+  // The batch timer takes our lock_ so it's cancelled before taking it.
+  this->batch_timer_->detach();
+  ACE_Reactor* const reactor = this->transport_.reactor();
+  if (reactor) {
+    reactor->cancel_timer(this->batch_timer_.in());
+  }
+
+  if (this->batch_bytes_ > 0) {
+    VDBG_LVL((LM_DEBUG, ACE_TEXT("(%P|%t) TransportSendStrategy[%@]::stop: ")
+              ACE_TEXT("batches sent by the timer: %B\n"),
+              this, this->batch_timer_flushes_), 1);
+  }
+
+  if (this->queue_.lanes() > 1 && Transport_debug_level > 1) {
+    const OPENDDS_VECTOR(size_t)& packets = this->queue_.packets();
+    for (size_t i = 0; i < packets.size(); ++i) {
+      ACE_DEBUG((LM_DEBUG, ACE_TEXT("(%P|%t) TransportSendStrategy[%@]::stop: ")
+                 ACE_TEXT("send lane %B queued packets: %B\n"),
+                 this, i, packets[i]));
+    }
+  }
+
   if (this->header_block_ != 0) {
     this->header_block_->release ();
     this->header_block_ = 0;
@@ -1173,6 +1237,7 @@ void
 TransportSendStrategy::send_stop(RepoId /*repoId*/)
 {
   DBG_ENTRY_LVL("TransportSendStrategy","send_stop",6);
+  bool schedule_batch_timer = false;
   {
     GuardType guard(this->lock_);
 
@@ -1233,10 +1298,12 @@ TransportSendStrategy::send_stop(RepoId /*repoId*/)
           "header_.length_ == [%d].\n", header_length));
 
     // Only attempt to send the current packet (directly) if the current
-    // packet actually contains something (it could be empty).
+    // packet actually contains something (it could be empty), and it
+    // isn't being held back to batch it with samples that follow.
     if ((header_length > 0) &&
         //(this->elems_.size ()+this->not_yet_pac_q_->size() > 0))
-        (this->elems_.size() > 0)) {
+        (this->elems_.size() > 0) &&
+        !this->hold_batch(schedule_batch_timer)) {
       VDBG((LM_DEBUG, "(%P|%t) DBG:   "
             "There is something in the current packet - attempt to send "
             "it (directly) now.\n"));
@@ -1257,9 +1324,130 @@ TransportSendStrategy::send_stop(RepoId /*repoId*/)
     }
   }
 
+  if (schedule_batch_timer) {
+    this->schedule_batch(this->batch_delay_);
+  }
+
+  send_delayed_notifications();
+}
+
+bool
+TransportSendStrategy::hold_batch(bool& schedule)
+{
+  schedule = false;
+
+  if (this->batch_bytes_ == 0) {
+    return false;
+  }
+
+  const ACE_Time_Value now = ACE_OS::gettimeofday();
+  if (this->batch_scheduled_ && now >= this->batch_deadline_) {
+    // Held for batch_delay_ already (the timer may have found a sample
+    // still being added to it): send it now.
+    this->batch_scheduled_ = false;
+    return false;
+  }
+
+  if (this->graceful_disconnecting_ ||
+      this->max_header_size_ + this->header_.length_ >= this->batch_bytes_) {
+    return false;
+  }
+
+  if (!this->batch_scheduled_) {
+    this->batch_scheduled_ = true;
+    this->batch_deadline_ = now + this->batch_delay_;
+    schedule = true;
+  }
+
+  VDBG((LM_DEBUG, "(%P|%t) DBG:   "
+        "Holding the current packet of [%d] bytes for a batch of [%B].\n",
+        this->header_.length_, this->batch_bytes_));
+  return true;
+}
+
+void
+TransportSendStrategy::schedule_batch(const ACE_Time_Value& delay)
+{
+  ACE_Reactor* const reactor = this->transport_.reactor();
+  if (!reactor ||
+      reactor->schedule_timer(this->batch_timer_.in(), 0, delay) == -1) {
+    ACE_ERROR((LM_WARNING,
+               ACE_TEXT("(%P|%t) WARNING: TransportSendStrategy::schedule_batch: ")
+               ACE_TEXT("failed to schedule the batch timer, sending now\n")));
+    {
+      // A packet still being added to is then sent by its send_stop().
+      GuardType guard(this->lock_);
+      this->batch_deadline_ = ACE_Time_Value::zero;
+    }
+    this->flush_batch();
+  }
+}
+
+void
+TransportSendStrategy::flush_batch()
+{
+  DBG_ENTRY_LVL("TransportSendStrategy","flush_batch",6);
+  ACE_Time_Value remaining = ACE_Time_Value::zero;
+  {
+    GuardType guard(this->lock_);
+
+    // A packet that filled up has been sent already.
+    if (this->link_released_ || this->mode_ != MODE_DIRECT ||
+        this->header_.length_ == 0 || this->elems_.size() == 0) {
+      this->batch_scheduled_ = false;
+      return;
+    }
+
+    if (this->start_counter_ != 0) {
+      // A sample is still being added to the packet.  Its send_stop()
+      // sends the packet if the deadline has passed by then (see
+      // hold_batch()); otherwise the timer waits out the rest of
+      // batch_delay_, so the packet is not held for a whole new one.
+      remaining = this->batch_deadline_ - ACE_OS::gettimeofday();
+      if (remaining <= ACE_Time_Value::zero) {
+        return;
+      }
+
+    } else {
+      this->batch_scheduled_ = false;
+      ++this->batch_timer_flushes_;
+
+      // This runs on the reactor thread, so don't relink here; a lost
+      // connection is left to the transport's own reconnect handling.
+      this->direct_send(false);
+
+      if (this->mode_ == MODE_QUEUE) {
+        this->synch_->work_available();
+      }
+    }
+  }
+
+  if (remaining > ACE_Time_Value::zero) {
+    this->schedule_batch(remaining);
+    return;
+  }
+
   send_delayed_notifications();
 }
 
+int
+TransportSendStrategy::BatchTimer::handle_timeout(const ACE_Time_Value& /*now*/,
+                                                  const void* /*arg*/)
+{
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, this->lock_, 0);
+  if (this->strategy_) {
+    this->strategy_->flush_batch();
+  }
+  return 0;
+}
+
+void
+TransportSendStrategy::BatchTimer::detach()
+{
+  ACE_GUARD(ACE_Thread_Mutex, guard, this->lock_);
+  this->strategy_ = 0;
+}
+
 void
 TransportSendStrategy::remove_all_msgs(RepoId pub_id)
 {
@@ -1511,6 +1699,10 @@ TransportSendStrategy::get_packet_elems_from_queue()
 {
   DBG_ENTRY_LVL("TransportSendStrategy", "get_packet_elems_from_queue", 6);
 
+  // Each packet is built from a single lane, so a higher priority sample
+  // only has to wait for the packet that is being sent.
+  this->queue_.select_lane();
+
   for (TransportQueueElement* element = this->queue_.peek(); element != 0;
        element = this->queue_.peek()) {
 
@@ -1738,6 +1930,11 @@ TransportSendStrategy::send_packet()
 {
   DBG_ENTRY_LVL("TransportSendStrategy", "send_packet", 6);
 
+  if (this->latency_) {
+    SendTimeVisitor visitor(*this->latency_, ACE_OS::gettimeofday());
+    this->elems_.accept_visitor(visitor);
+  }
+
   int bp_flag = 0;
   const ssize_t num_bytes_sent =
     this->do_send_packet(this->pkt_chain_, bp_flag);
@@ -1867,6 +2064,15 @@ TransportSendStrategy::add_delayed_notification(TransportQueueElement* element)
   this->delayed_delivered_notification_queue_.push_back(std::make_pair(element, this->mode_));
 }
 
+void
+TransportSendStrategy::add_delayed_notifications(const OPENDDS_VECTOR(TransportQueueElement*)& elements)
+{
+  GuardType guard(this->lock_);
+  for (size_t i = 0; i < elements.size(); ++i) {
+    TransportSendStrategy::add_delayed_notification(elements[i]);
+  }
+}
+
 void
 OpenDDS::DCPS::TransportSendStrategy::deliver_ack_request(TransportQueueElement* element)
 {
@@ -12,14 +12,18 @@
 #include "dds/DCPS/Definitions.h"
 #include "dds/DCPS/RcObject.h"
 #include "dds/DCPS/PoolAllocator.h"
+#include "dds/DCPS/RcEventHandler.h"
 #include "ThreadSynchWorker.h"
 #include "TransportDefs.h"
 #include "BasicQueue_T.h"
+#include "SendLaneQueue.h"
 #include "TransportHeader.h"
 #include "TransportReplacedElement.h"
 #include "TransportRetainedElement.h"
 #include "ThreadSynchStrategy_rch.h"
 #include "ace/Synch_Traits.h"
+#include "ace/Thread_Mutex.h"
+#include "ace/Time_Value.h"
 
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
@@ -35,6 +39,7 @@ class DataSampleElement;
 class QueueRemoveVisitor;
 class PacketRemoveVisitor;
 class TransportImpl;
+class LinkLatency;
 
 /**
  * This class provides methods to fill packets with samples for sending
@@ -54,6 +59,11 @@ public:
   /// Assigns an optional send buffer.
   void send_buffer(TransportSendBuffer* send_buffer);
 
+  /// Record the time each sample waits between DataLink::send() and the
+  /// send system call in @a latency (the owning DataLink's, if it
+  /// measures its latency).
+  void latency(LinkLatency* latency);
+
   /// Start the TransportSendStrategy.  This happens once, when
   /// the DataLink that "owns" this strategy object has established
   /// a connection.
@@ -172,6 +182,14 @@ protected:
 
   TransportQueueElement* current_packet_first_element() const;
 
+  /// Chain of blocks holding the unsent bytes of the current packet.
+  /// This is the chain that was converted to iovecs for send_bytes_i().
+  const ACE_Message_Block* current_packet_chain() const;
+
+  /// The packet header block at the front of current_packet_chain(), or 0
+  /// once the header has been sent.
+  const ACE_Message_Block* current_packet_header() const;
+
   /// The maximum size of a message allowed by the this TransportImpl, or 0
   /// if there is no such limit.  This is expected to be a constant, for example
   /// UDP/IPv4 can send messages of up to 65466 bytes.
@@ -185,6 +203,11 @@ protected:
 
   virtual void add_delayed_notification(TransportQueueElement* element);
 
+  /// Queue the delayed notifications of @a elements, which a subclass held
+  /// back from add_delayed_notification(), for send_delayed_notifications().
+  /// Takes lock_, so it is called without it.
+  void add_delayed_notifications(const OPENDDS_VECTOR(TransportQueueElement*)& elements);
+
   /// If delayed notifications were queued up, issue those callbacks here.
   /// The default match is "match all", otherwise match can be used to specify
   /// either a certain individual packet or a publication id.
@@ -263,6 +286,36 @@ private:
   /// or max_size_ [user's configured limit]
   size_t space_available() const;
 
+  /// Called from send_stop() with the lock_ held when batching is
+  /// configured.  Returns true if the current packet should be held back
+  /// for more samples, and sets @a schedule when the batch timer needs to
+  /// be scheduled (which must be done once the lock_ is released).
+  bool hold_batch(bool& schedule);
+
+  /// Schedule the batch timer to fire after @a delay.  Sends the held
+  /// packet right away if the timer can't be scheduled.
+  void schedule_batch(const ACE_Time_Value& delay);
+
+  /// Called by the batch timer: send the held packet, if any.  If a
+  /// sample is still being added to it, the timer is scheduled again for
+  /// what is left of batch_delay_ instead.
+  void flush_batch();
+
+  /// Flushes the packet held back by batching when batch_delay_ passes.
+  class BatchTimer : public RcEventHandler {
+  public:
+    explicit BatchTimer(TransportSendStrategy* strategy) : strategy_(strategy) {}
+    int handle_timeout(const ACE_Time_Value& now, const void* arg);
+
+    /// Called when the strategy is stopped, so that a timer that is
+    /// already being dispatched does nothing.
+    void detach();
+
+  private:
+    ACE_Thread_Mutex lock_;
+    TransportSendStrategy* strategy_;
+  };
+
   typedef ACE_SYNCH_MUTEX     LockType;
   typedef ACE_Guard<LockType> GuardType;
 
@@ -315,12 +368,33 @@ private:
   /// Configuration - max transport packet size (bytes)
   ACE_UINT32 max_size_;
 
+  /// Configuration - batch size (bytes) that a packet is held back for
+  /// in send_stop(), 0 if batching is disabled.
+  size_t batch_bytes_;
+
+  /// Configuration - longest time a packet is held back for.
+  ACE_Time_Value batch_delay_;
+
+  RcHandle<BatchTimer> batch_timer_;
+
+  /// Is the batch timer scheduled?  Protected by lock_.
+  bool batch_scheduled_;
+
+  /// When the held packet has to be sent: batch_delay_ after it was
+  /// first held back.  Protected by lock_.
+  ACE_Time_Value batch_deadline_;
+
+  /// Packets sent by the batch timer rather than by reaching a limit,
+  /// logged when the strategy stops.
+  size_t batch_timer_flushes_;
+
   /// Used during backpressure situations to hold samples that have
   /// not yet been made to be part of a transport packet, and are
   /// completely unsent.
   /// Also used as a bucket for packets which still have to become
   /// part of a packet.
-  QueueType queue_;
+  /// Split into lanes by TRANSPORT_PRIORITY (see send_lanes).
+  SendLaneQueue queue_;
 
   /// Maximum marshalled size of the transport packet header.
   size_t max_header_size_;
@@ -391,6 +465,8 @@ private:
 
   TransportSendBuffer* send_buffer_;
 
+  LinkLatency* latency_;
+
   // N.B. The behavior present in TransortSendBuffer should be
   // refactored into the TransportSendStrategy eventually; a good
   // amount of private state is shared between both classes.
@@ -145,4 +145,16 @@ OpenDDS::DCPS::TransportSendStrategy::current_packet_first_element() const
   return this->elems_.peek();
 }
 
+ACE_INLINE const ACE_Message_Block*
+OpenDDS::DCPS::TransportSendStrategy::current_packet_chain() const
+{
+  return this->pkt_chain_;
+}
+
+ACE_INLINE const ACE_Message_Block*
+OpenDDS::DCPS::TransportSendStrategy::current_packet_header() const
+{
+  return this->header_complete_ ? 0 : this->header_block_;
+}
+
 OPENDDS_END_VERSIONED_NAMESPACE_DECL
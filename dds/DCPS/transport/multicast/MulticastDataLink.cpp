@@ -22,6 +22,7 @@
 
 #include "dds/DCPS/Service_Participant.h"
 #include "dds/DCPS/transport/framework/NetworkAddress.h"
+#include "dds/DCPS/transport/framework/TransportDebug.h"
 #include "dds/DCPS/GuidConverter.h"
 #include "dds/DCPS/RepoIdConverter.h"
 
@@ -45,7 +46,13 @@ MulticastDataLink::MulticastDataLink(MulticastTransport& transport,
   local_peer_(local_peer),
   reactor_task_(reactor_task),
   send_strategy_(make_rch<MulticastSendStrategy>(this)),
-  recv_strategy_(make_rch<MulticastReceiveStrategy>(this))
+  recv_strategy_(make_rch<MulticastReceiveStrategy>(this)),
+  fec_peers_(false),
+  repair_timer_(make_rch<RepairTimer>(ref(*this))),
+  repair_scheduled_(false),
+  repairs_stopped_(false),
+  repairs_requested_(0),
+  repairs_sent_(0)
 {
   // A send buffer may be bound to the send strategy to ensure a
   // configured number of most-recent datagrams are retained:
@@ -123,6 +130,12 @@ MulticastDataLink::join(const ACE_INET_Addr& group_address)
   }
 #endif /* ACE_DEFAULT_MAX_SOCKET_BUFSIZ */
 
+  // Asynchronous sends complete out of order, so their timestamps can't
+  // be matched with the send calls.
+  if (!this->config().async_send()) {
+    enable_kernel_timestamps(this->timestamps_, handle);
+  }
+
   if (start(static_rchandle_cast<TransportSendStrategy>(this->send_strategy_),
       static_rchandle_cast<TransportStrategy>(this->recv_strategy_))
       != 0) {
@@ -165,8 +178,13 @@ MulticastDataLink::find_or_create_session(MulticastPeer remote_peer)
     return it->second;
   }
 
+  // Sessions run their timers on the reactor that reads this link's
+  // socket, which need not be the transport's first reactor.
   MulticastSession_rch session =
-    this->session_factory_->create(transport().reactor(), transport().reactor_owner(), this, remote_peer);
+    this->session_factory_->create(get_reactor(),
+                                   this->reactor_task_ ? this->reactor_task_->get_reactor_owner()
+                                                       : ACE_OS::NULL_thread,
+                                   this, remote_peer);
   if (session.is_nil()) {
     ACE_ERROR_RETURN((LM_ERROR,
         ACE_TEXT("(%P|%t) ERROR: ")
@@ -188,12 +206,51 @@ MulticastDataLink::find_or_create_session(MulticastPeer remote_peer)
         (unsigned int) remote_peer),
         MulticastSession_rch());
   }
+  update_fec_peers_i();
   return session;
 }
 
+void
+MulticastDataLink::remote_capabilities(MulticastPeer remote_peer,
+                                       ACE_CDR::Octet capabilities)
+{
+  ACE_GUARD(ACE_SYNCH_RECURSIVE_MUTEX, guard, this->session_lock_);
+
+  this->peer_capabilities_[remote_peer] = capabilities;
+  update_fec_peers_i();
+}
+
+bool
+MulticastDataLink::fec_peers() const
+{
+  return this->fec_peers_.value();
+}
+
+void
+MulticastDataLink::update_fec_peers_i()
+{
+  // Older peers parse parity datagrams as data, so parity is only sent
+  // once every remote peer has advertised that it skips them.
+  bool fec_peers = !this->sessions_.empty();
+  for (MulticastSessionMap::const_iterator it(this->sessions_.begin());
+       fec_peers && it != this->sessions_.end(); ++it) {
+    const PeerCapabilities::const_iterator capabilities =
+      this->peer_capabilities_.find(it->first);
+    fec_peers = capabilities != this->peer_capabilities_.end() &&
+      (capabilities->second & MULTICAST_CAP_FEC_PARITY);
+  }
+  this->fec_peers_ = fec_peers;
+}
+
 bool
 MulticastDataLink::check_header(const TransportHeader& header)
 {
+  // Parity datagrams are consumed by the receive strategy when forward
+  // error correction is enabled; skip them otherwise.
+  if (header.reserved_ == MULTICAST_FEC_PARITY) {
+    return false;
+  }
+
   ACE_GUARD_RETURN(ACE_SYNCH_RECURSIVE_MUTEX,
       guard,
       this->session_lock_,
@@ -241,6 +298,82 @@ MulticastDataLink::reassemble(ReceivedDataSample& data,
   return false;
 }
 
+bool
+MulticastDataLink::request_repair(const SequenceRange& range)
+{
+  ++this->repairs_requested_;
+
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, this->repair_lock_, false);
+  if (this->repairs_stopped_) {
+    return false;
+  }
+
+  if (this->config().nak_repair_delay_ == ACE_Time_Value::zero) {
+    const bool result = this->send_buffer_->resend(range);
+    if (result) {
+      ++this->repairs_sent_;
+    }
+    return result;
+  }
+
+  this->pending_repairs_.insert(range);
+
+  if (!this->repair_scheduled_) {
+    if (get_reactor()->schedule_timer(this->repair_timer_.in(), 0,
+                                      this->config().nak_repair_delay_) == -1) {
+      ACE_ERROR((LM_WARNING,
+                 ACE_TEXT("(%P|%t) WARNING: ")
+                 ACE_TEXT("MulticastDataLink::request_repair: ")
+                 ACE_TEXT("failed to schedule repair %p, resending now\n"),
+                 ACE_TEXT("schedule_timer")));
+      this->flush_repairs_i();
+      return true;
+    }
+    this->repair_scheduled_ = true;
+  }
+  return true;
+}
+
+void
+MulticastDataLink::flush_repairs()
+{
+  ACE_GUARD(ACE_Thread_Mutex, guard, this->repair_lock_);
+  if (!this->repairs_stopped_) {
+    this->flush_repairs_i();
+  }
+}
+
+void
+MulticastDataLink::flush_repairs_i()
+{
+  const OPENDDS_VECTOR(SequenceRange) ranges =
+    this->pending_repairs_.present_sequence_ranges();
+  this->pending_repairs_.reset();
+  this->repair_scheduled_ = false;
+
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    const bool result = this->send_buffer_->resend(ranges[i]);
+    if (result) {
+      ++this->repairs_sent_;
+    }
+    VDBG_LVL((LM_DEBUG, ACE_TEXT("(%P|%t) MulticastDataLink[%@]::flush_repairs ")
+              ACE_TEXT("[%q - %q] resend result %C\n"), this,
+              ranges[i].first.getValue(), ranges[i].second.getValue(),
+              result ? "SUCCESS" : "FAILED"), 5);
+  }
+}
+
+int
+MulticastDataLink::RepairTimer::handle_timeout(const ACE_Time_Value& /*now*/,
+                                               const void* /*arg*/)
+{
+  const MulticastDataLink_rch link = this->link_.lock();
+  if (link) {
+    link->flush_repairs();
+  }
+  return 0;
+}
+
 void
 MulticastDataLink::sample_received(ReceivedDataSample& sample)
 {
@@ -349,6 +482,13 @@ MulticastDataLink::syn_received_no_session(MulticastPeer source,
     return;
   }
 
+  // Peers of older releases send no capabilities.
+  ACE_CDR::Octet capabilities = 0;
+  if (!(serializer_read >> ACE_InputCDR::to_octet(capabilities))) {
+    capabilities = 0;
+  }
+  remote_capabilities(source, capabilities);
+
   VDBG_LVL((LM_DEBUG, "(%P|%t) MulticastDataLink[%C]::syn_received_no_session "
       "send_synack local %#08x%08x remote %#08x%08x\n",
       this->config().name().c_str(),
@@ -357,10 +497,12 @@ MulticastDataLink::syn_received_no_session(MulticastPeer source,
       (unsigned int) (source >> 32),
       (unsigned int) source), 2);
 
-  Message_Block_Ptr synack_data(new ACE_Message_Block(sizeof(MulticastPeer)));
+  Message_Block_Ptr synack_data(
+    new ACE_Message_Block(sizeof(MulticastPeer) + sizeof(ACE_CDR::Octet)));
 
   Serializer serializer_write(synack_data.get());
   serializer_write << source;
+  serializer_write << ACE_OutputCDR::from_octet(MULTICAST_CAPABILITIES);
 
   DataSampleHeader header;
   Message_Block_Ptr control(
@@ -396,6 +538,33 @@ MulticastDataLink::stop_i()
     it->second->stop();
   }
   this->sessions_.clear();
+  this->peer_capabilities_.clear();
+  update_fec_peers_i();
+
+  {
+    ACE_GUARD(ACE_Thread_Mutex, repair_guard, this->repair_lock_);
+    this->repairs_stopped_ = true;
+    if (this->repair_scheduled_) {
+      get_reactor()->cancel_timer(this->repair_timer_.in());
+      this->repair_scheduled_ = false;
+    }
+    this->pending_repairs_.reset();
+  }
+
+  if (this->send_buffer_) {
+    VDBG_LVL((LM_DEBUG, ACE_TEXT("(%P|%t) MulticastDataLink[%@]::stop_i: ")
+              ACE_TEXT("repair ranges requested: %B resent: %B\n"),
+              this, this->repairs_requested_.value(),
+              this->repairs_sent_.value()), 1);
+  }
+
+  if (this->config().fec_k_ > 0) {
+    VDBG_LVL((LM_DEBUG, ACE_TEXT("(%P|%t) MulticastDataLink[%@]::stop_i: ")
+              ACE_TEXT("fec parity sent: %B recovered: %B unrecoverable: %B\n"),
+              this, this->send_strategy_->fec_parity_sent(),
+              this->recv_strategy_->fec_recovered(),
+              this->recv_strategy_->fec_unrecoverable()), 1);
+  }
 
   this->socket_.close();
 }
@@ -23,11 +23,14 @@
 
 #include "dds/DCPS/DisjointSequence.h"
 #include "dds/DCPS/PoolAllocator.h"
+#include "dds/DCPS/RcEventHandler.h"
 
 #include "dds/DCPS/transport/framework/DataLink.h"
+#include "dds/DCPS/transport/framework/KernelTimestamps.h"
 #include "dds/DCPS/ReactorTask.h"
 #include "dds/DCPS/transport/framework/TransportSendBuffer.h"
 
+#include "ace/Atomic_Op.h"
 #include "ace/SOCK_Dgram_Mcast.h"
 #include "ace/Synch_Traits.h"
 
@@ -68,18 +71,51 @@ public:
 
   ACE_SOCK_Dgram_Mcast& socket();
 
+  /// Kernel timestamps of the datagrams of socket(), if the transport
+  /// sets kernel_timestamps.
+  KernelTimestamps& timestamps();
+
   bool join(const ACE_INET_Addr& group_address);
 
   MulticastSession_rch find_or_create_session(MulticastPeer remote_peer);
   MulticastSession_rch find_session(MulticastPeer remote_peer);
 
+  /// Record the capabilities @a remote_peer advertised in its SYN or
+  /// SYNACK (see MULTICAST_CAPABILITIES).
+  void remote_capabilities(MulticastPeer remote_peer,
+                           ACE_CDR::Octet capabilities);
+
+  /// Do the remote peers of every session skip parity datagrams?
+  /// Parity is only sent when they do.
+  bool fec_peers() const;
+
   bool check_header(const TransportHeader& header);
   bool check_header(const DataSampleHeader& header);
   void sample_received(ReceivedDataSample& sample);
 
   bool reassemble(ReceivedDataSample& data, const TransportHeader& header);
 
+  /// Resend the datagrams in @a range from the send buffer.  Requests
+  /// are collected for nak_repair_delay so that datagrams requested by
+  /// several remote peers are resent once; returns false if the range
+  /// was neither resent nor queued.
+  bool request_repair(const SequenceRange& range);
+
+  /// Resend the datagrams collected by request_repair(), unless the
+  /// link has stopped.
+  void flush_repairs();
+
 private:
+  class RepairTimer : public RcEventHandler {
+  public:
+    explicit RepairTimer(MulticastDataLink& link) : link_(link) {}
+    int handle_timeout(const ACE_Time_Value& now, const void* arg);
+  private:
+    WeakRcHandle<MulticastDataLink> link_;
+  };
+
+  /// Resend and clear pending_repairs_; the caller holds repair_lock_.
+  void flush_repairs_i();
 
   MulticastSessionFactory_rch session_factory_;
 
@@ -94,11 +130,36 @@ private:
 
   ACE_SOCK_Dgram_Mcast socket_;
 
+  KernelTimestamps timestamps_;
+
   ACE_SYNCH_RECURSIVE_MUTEX session_lock_;
 
   typedef OPENDDS_MAP(MulticastPeer, MulticastSession_rch) MulticastSessionMap;
   MulticastSessionMap sessions_;
 
+  /// Capabilities of the remote peers that sent them; protected by
+  /// session_lock_.
+  typedef OPENDDS_MAP(MulticastPeer, ACE_CDR::Octet) PeerCapabilities;
+  PeerCapabilities peer_capabilities_;
+
+  /// Set fec_peers_ from sessions_ and peer_capabilities_; the caller
+  /// holds session_lock_.
+  void update_fec_peers_i();
+  ACE_Atomic_Op<ACE_Thread_Mutex, bool> fec_peers_;
+
+  RcHandle<RepairTimer> repair_timer_;
+  /// Protects the repair state below.  Repairs are resent while it is
+  /// held, so once stop_i() has set repairs_stopped_ nothing is resent.
+  ACE_Thread_Mutex repair_lock_;
+  DisjointSequence pending_repairs_;
+  bool repair_scheduled_;
+  bool repairs_stopped_;
+
+  /// Repair traffic counters, logged when the link stops: ranges
+  /// requested by remote peers, and ranges resent after merging them.
+  ACE_Atomic_Op<ACE_Thread_Mutex, size_t> repairs_requested_;
+  ACE_Atomic_Op<ACE_Thread_Mutex, size_t> repairs_sent_;
+
   virtual void stop_i();
 
   void syn_received_no_session(MulticastPeer source, const Message_Block_Ptr& data,
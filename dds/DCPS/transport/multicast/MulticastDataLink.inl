@@ -72,6 +72,12 @@ MulticastDataLink::socket()
   return this->socket_;
 }
 
+ACE_INLINE KernelTimestamps&
+MulticastDataLink::timestamps()
+{
+  return this->timestamps_;
+}
+
 } // namespace DCPS
 } // namespace OpenDDS
 
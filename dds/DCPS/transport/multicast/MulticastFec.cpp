@@ -0,0 +1,511 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "MulticastFec.h"
+
+#include "dds/DCPS/Serializer.h"
+#include "dds/DCPS/transport/framework/TransportHeader.h"
+#include "dds/DCPS/transport/framework/TransportDebug.h"
+
+#include "ace/Log_Msg.h"
+
+#include <algorithm>
+#include <cstring>
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+namespace {
+  /// Octets following the TransportHeader of a parity datagram before
+  /// the parity data: K, M, index, reserved, length XOR, data length.
+  const size_t PARITY_PREAMBLE_SZ = 4 + 2 * sizeof(ACE_CDR::ULong);
+
+  /// K is marshaled as an octet.
+  const ACE_INT64 MAX_FEC_K = 255;
+
+  /// Room for a marshaled TransportHeader.
+  const size_t HEADER_BUFFER_SZ = 64;
+
+  size_t total_length(const iovec iov[], int n)
+  {
+    size_t length = 0;
+    for (int i = 0; i < n; ++i) {
+      length += iov[i].iov_len;
+    }
+    return length;
+  }
+
+  /// Copy the first @a size octets of the @a length octet datagram
+  /// read into @a iov to @a out.
+  bool gather(const iovec iov[], int n, size_t length, char* out, size_t size)
+  {
+    if (length < size) {
+      return false;
+    }
+    size_t copied = 0;
+    for (int i = 0; i < n && copied < size; ++i) {
+      const size_t amount = std::min(static_cast<size_t>(iov[i].iov_len),
+                                     size - copied);
+      std::memcpy(out + copied, iov[i].iov_base, amount);
+      copied += amount;
+    }
+    return copied == size;
+  }
+
+  bool parse_header(const char* data, size_t size, TransportHeader& header)
+  {
+    if (size < TransportHeader::max_marshaled_size()) {
+      return false;
+    }
+    ACE_Message_Block mb(const_cast<char*>(data), size);
+    mb.wr_ptr(size);
+    return header.init(&mb) && header.valid();
+  }
+
+  bool parse_header(const OPENDDS_STRING& datagram, TransportHeader& header)
+  {
+    return parse_header(datagram.data(), datagram.size(), header);
+  }
+
+  /// Parse the header of a datagram without copying the rest of it.
+  bool parse_header(const iovec iov[], int n, size_t length,
+                    TransportHeader& header)
+  {
+    char buffer[HEADER_BUFFER_SZ];
+    const size_t size = TransportHeader::max_marshaled_size();
+    return size <= sizeof buffer
+      && gather(iov, n, length, buffer, size)
+      && parse_header(buffer, size, header);
+  }
+
+  void xor_into(OPENDDS_STRING& target, const OPENDDS_STRING& source)
+  {
+    const size_t length = source.size();
+    for (size_t i = 0; i < length; ++i) {
+      target[i] ^= source[i];
+    }
+  }
+
+  void xor_into(OPENDDS_STRING& target, const iovec iov[], int n)
+  {
+    size_t offset = 0;
+    for (int i = 0; i < n; ++i) {
+      const char* const data = static_cast<const char*>(iov[i].iov_base);
+      for (size_t j = 0; j < iov[i].iov_len; ++j) {
+        target[offset + j] ^= data[j];
+      }
+      offset += iov[i].iov_len;
+    }
+  }
+}
+
+FecEncoder::FecEncoder(MulticastPeer source, size_t k, size_t m)
+  : source_(source)
+  , k_(k)
+  , m_(m)
+  , block_start_(0)
+  , next_(0)
+  , count_(0)
+  , parity_(m)
+  , lengths_(m, 0)
+  , length_xor_(m, 0)
+  , parity_generated_(0)
+{
+}
+
+void
+FecEncoder::encode(const iovec iov[], int n,
+                   OPENDDS_VECTOR(OPENDDS_STRING)& parity)
+{
+  ACE_GUARD(ACE_Thread_Mutex, guard, this->lock_);
+
+  const size_t length = total_length(iov, n);
+  TransportHeader header;
+  if (!parse_header(iov, n, length, header)) {
+    return;
+  }
+
+  const ACE_INT64 seq = header.sequence_.getValue();
+  if (this->next_ != 0 && seq < this->next_) {
+    return; // a resend; repairs are not covered by parity
+  }
+  if (this->count_ > 0 && seq != this->next_) {
+    // Datagrams were skipped; abandon the incomplete block.
+    this->count_ = 0;
+  }
+
+  if (this->count_ == 0) {
+    this->block_start_ = seq;
+    for (size_t j = 0; j < this->m_; ++j) {
+      std::fill(this->parity_[j].begin(),
+                this->parity_[j].begin() + this->lengths_[j], '\0');
+      this->lengths_[j] = 0;
+      this->length_xor_[j] = 0;
+    }
+  }
+
+  const size_t j = this->count_ % this->m_;
+  if (this->parity_[j].size() < length) {
+    this->parity_[j].resize(length, '\0');
+  }
+  xor_into(this->parity_[j], iov, n);
+  this->lengths_[j] = std::max(this->lengths_[j], length);
+  this->length_xor_[j] ^= static_cast<ACE_UINT32>(length);
+
+  this->next_ = seq + 1;
+
+  if (++this->count_ == this->k_) {
+    for (size_t p = 0; p < this->m_; ++p) {
+      parity.push_back(this->parity_datagram(p));
+    }
+    this->parity_generated_ += this->m_;
+    this->count_ = 0;
+  }
+}
+
+OPENDDS_STRING
+FecEncoder::parity_datagram(size_t index) const
+{
+  const size_t data_length = this->lengths_[index];
+  const size_t body_length = PARITY_PREAMBLE_SZ + data_length;
+
+  TransportHeader header;
+  header.reserved_ = MULTICAST_FEC_PARITY;
+  header.length_ = static_cast<ACE_UINT32>(body_length);
+  header.sequence_ = SequenceNumber(this->block_start_);
+  header.source_ = this->source_;
+
+  ACE_Message_Block mb(TransportHeader::max_marshaled_size() + body_length);
+  mb << header;
+
+  Serializer serializer(&mb);
+  serializer << ACE_OutputCDR::from_octet(static_cast<ACE_CDR::Octet>(this->k_));
+  serializer << ACE_OutputCDR::from_octet(static_cast<ACE_CDR::Octet>(this->m_));
+  serializer << ACE_OutputCDR::from_octet(static_cast<ACE_CDR::Octet>(index));
+  serializer << ACE_OutputCDR::from_octet(0);
+  serializer << ACE_CDR::ULong(this->length_xor_[index]);
+  serializer << ACE_CDR::ULong(data_length);
+  serializer.write_octet_array(
+    reinterpret_cast<const ACE_CDR::Octet*>(this->parity_[index].data()),
+    static_cast<ACE_CDR::ULong>(data_length));
+
+  return OPENDDS_STRING(mb.rd_ptr(), mb.length());
+}
+
+size_t
+FecEncoder::parity_generated() const
+{
+  return this->parity_generated_.value();
+}
+
+
+bool
+FecDecoder::Parity::covers(ACE_INT64 seq) const
+{
+  return seq >= this->block_start_
+    && seq < this->block_start_ + static_cast<ACE_INT64>(this->k_)
+    && static_cast<size_t>(seq - this->block_start_) % this->m_ == this->index_;
+}
+
+FecDecoder::FecDecoder(MulticastPeer local_peer, size_t window)
+  : local_peer_(local_peer)
+  , window_(window)
+  , recovered_(0)
+  , unrecoverable_(0)
+{
+}
+
+bool
+FecDecoder::received(const iovec iov[], int n, size_t length)
+{
+  TransportHeader header;
+  if (!parse_header(iov, n, length, header)) {
+    return false;
+  }
+
+  const bool is_parity = header.reserved_ == MULTICAST_FEC_PARITY;
+  if (header.source_ == this->local_peer_) {
+    return is_parity;
+  }
+
+  Source& source = this->sources_[header.source_];
+  const ACE_INT64 seq = header.sequence_.getValue();
+
+  if (is_parity) {
+    Datagram datagram(length, '\0');
+    if (gather(iov, n, length, &datagram[0], length)) {
+      ACE_Message_Block body(&datagram[0], length);
+      body.wr_ptr(length);
+      body.rd_ptr(TransportHeader::max_marshaled_size());
+      this->parity_received(source, body, seq, header.swap_bytes());
+    }
+    return true;
+  }
+
+  // Only sources that send parity have their datagrams kept, and not
+  // twice, once their parity has been used, or once they are too old to
+  // matter.
+  const bool keep = source.kept_from_ != 0 && seq >= source.kept_from_ &&
+    !source.datagrams_.count(seq) && !source.resolved_.count(seq) &&
+    !(source.high_ > static_cast<ACE_INT64>(this->window_) &&
+      seq < source.high_ - static_cast<ACE_INT64>(this->window_));
+  if (keep) {
+    Datagram& datagram = source.datagrams_[seq];
+    datagram.resize(length);
+    gather(iov, n, length, &datagram[0], length);
+  }
+  this->advance(source, seq);
+  if (!keep) {
+    return false;
+  }
+
+  // Parity received ahead of this datagram may now be able to rebuild
+  // the one datagram still missing from its group.
+  Parities::iterator it =
+    source.parities_.lower_bound(ParityKey(seq - MAX_FEC_K + 1, 0));
+  while (it != source.parities_.end() && it->first.first <= seq) {
+    const Parities::iterator current = it++;
+    if (current->second.covers(seq)) {
+      this->try_recover(source, current);
+    }
+  }
+
+  return false;
+}
+
+void
+FecDecoder::parity_received(Source& source, ACE_Message_Block& body,
+                            ACE_INT64 block_start, bool swap_bytes)
+{
+  Serializer serializer(&body, swap_bytes);
+
+  ACE_CDR::Octet k = 0, m = 0, index = 0, reserved = 0;
+  ACE_CDR::ULong length_xor = 0, data_length = 0;
+
+  if (!(serializer >> ACE_InputCDR::to_octet(k)) ||
+      !(serializer >> ACE_InputCDR::to_octet(m)) ||
+      !(serializer >> ACE_InputCDR::to_octet(index)) ||
+      !(serializer >> ACE_InputCDR::to_octet(reserved)) ||
+      !(serializer >> length_xor) ||
+      !(serializer >> data_length) ||
+      k == 0 || m == 0 || m > k || index >= m ||
+      data_length < TransportHeader::max_marshaled_size() ||
+      data_length > body.length()) {
+    VDBG_LVL((LM_WARNING, "(%P|%t) WARNING: FecDecoder::parity_received: "
+              "malformed parity datagram dropped\n"), 1);
+    return;
+  }
+
+  if (source.kept_from_ == 0) {
+    // The source's first parity: its datagrams are kept from now on.
+    source.kept_from_ = source.high_ + 1;
+  }
+  if (block_start < source.kept_from_ ||
+      (source.high_ > static_cast<ACE_INT64>(this->window_) &&
+       block_start + k <= source.high_ - static_cast<ACE_INT64>(this->window_))) {
+    return; // the covered datagrams are not kept
+  }
+
+  const ParityKey key(block_start, index);
+  if (source.parities_.count(key)) {
+    return;
+  }
+
+  Parity& parity = source.parities_[key];
+  parity.block_start_ = block_start;
+  parity.k_ = k;
+  parity.m_ = m;
+  parity.index_ = index;
+  parity.length_xor_ = length_xor;
+  parity.data_.resize(data_length);
+  serializer.read_octet_array(
+    reinterpret_cast<ACE_CDR::Octet*>(&parity.data_[0]), data_length);
+
+  this->try_recover(source, source.parities_.find(key));
+}
+
+size_t
+FecDecoder::missing(const Source& source, const Parity& parity,
+                    ACE_INT64& last_missing) const
+{
+  size_t count = 0;
+  const ACE_INT64 end = parity.block_start_ + static_cast<ACE_INT64>(parity.k_);
+  for (ACE_INT64 seq = parity.block_start_ + parity.index_; seq < end;
+       seq += parity.m_) {
+    if (source.datagrams_.find(seq) == source.datagrams_.end()) {
+      last_missing = seq;
+      ++count;
+    }
+  }
+  return count;
+}
+
+void
+FecDecoder::try_recover(Source& source, Parities::iterator it)
+{
+  const Parity& parity = it->second;
+
+  ACE_INT64 lost = 0;
+  const size_t count = this->missing(source, parity, lost);
+  if (count > 1) {
+    return; // wait for more of the group, e.g. from NAK repairs
+  }
+
+  const ACE_INT64 end = parity.block_start_ + static_cast<ACE_INT64>(parity.k_);
+  if (count == 1) {
+    Datagram rebuilt(parity.data_);
+    ACE_UINT32 length = parity.length_xor_;
+    bool ok = true;
+
+    for (ACE_INT64 seq = parity.block_start_ + parity.index_; ok && seq < end;
+         seq += parity.m_) {
+      if (seq == lost) continue;
+      const Datagram& datagram = source.datagrams_[seq];
+      if (datagram.size() > rebuilt.size()) {
+        ok = false;
+      } else {
+        xor_into(rebuilt, datagram);
+        length ^= static_cast<ACE_UINT32>(datagram.size());
+      }
+    }
+
+    TransportHeader header;
+    if (ok && length <= rebuilt.size()) {
+      rebuilt.resize(length);
+      ok = parse_header(rebuilt, header)
+        && header.reserved_ != MULTICAST_FEC_PARITY
+        && header.sequence_.getValue() == lost;
+    } else {
+      ok = false;
+    }
+
+    if (ok) {
+      VDBG_LVL((LM_DEBUG, "(%P|%t) FecDecoder::try_recover: "
+                "rebuilt datagram %q from remote peer %#08x%08x\n",
+                lost,
+                (unsigned int)(header.source_ >> 32),
+                (unsigned int) header.source_), 4);
+      this->recovered_queue_.push_back(rebuilt);
+      ++this->recovered_;
+    } else {
+      VDBG_LVL((LM_WARNING, "(%P|%t) WARNING: FecDecoder::try_recover: "
+                "parity for datagram %q does not match the received data\n",
+                lost), 1);
+    }
+  }
+
+  // Each datagram is covered by one parity, so the group's datagrams
+  // can go with it.
+  for (ACE_INT64 seq = parity.block_start_ + parity.index_; seq < end;
+       seq += parity.m_) {
+    source.datagrams_.erase(seq);
+    source.resolved_.insert(seq);
+  }
+  source.parities_.erase(it);
+}
+
+void
+FecDecoder::advance(Source& source, ACE_INT64 seq)
+{
+  if (seq <= source.high_) {
+    return;
+  }
+  source.high_ = seq;
+
+  if (seq <= static_cast<ACE_INT64>(this->window_)) {
+    return;
+  }
+  const ACE_INT64 low = seq - static_cast<ACE_INT64>(this->window_);
+
+  // Parity whose group falls out of the window can no longer help.
+  for (Parities::iterator it = source.parities_.begin();
+       it != source.parities_.end() && it->first.first < low;) {
+    if (it->first.first + static_cast<ACE_INT64>(it->second.k_) <= low) {
+      ACE_INT64 lost = 0;
+      if (this->missing(source, it->second, lost) > 0) {
+        ++this->unrecoverable_;
+      }
+      source.parities_.erase(it++);
+    } else {
+      ++it;
+    }
+  }
+
+  source.datagrams_.erase(source.datagrams_.begin(),
+                          source.datagrams_.lower_bound(low));
+  source.resolved_.erase(source.resolved_.begin(),
+                         source.resolved_.lower_bound(low));
+}
+
+bool
+FecDecoder::has_recovered() const
+{
+  return !this->recovered_queue_.empty();
+}
+
+ssize_t
+FecDecoder::take_recovered(iovec iov[], int n)
+{
+  if (this->recovered_queue_.empty()) {
+    return 0;
+  }
+
+  const Datagram datagram(this->recovered_queue_.front());
+  this->recovered_queue_.pop_front();
+
+  size_t capacity = 0;
+  for (int i = 0; i < n; ++i) {
+    capacity += iov[i].iov_len;
+  }
+  if (capacity < datagram.size()) {
+    ACE_ERROR((LM_WARNING,
+               ACE_TEXT("(%P|%t) WARNING: FecDecoder::take_recovered: ")
+               ACE_TEXT("rebuilt datagram of %B bytes exceeds the %B bytes ")
+               ACE_TEXT("available in the receive buffers.\n"),
+               datagram.size(), capacity));
+    return 0;
+  }
+
+  size_t copied = 0;
+  for (int i = 0; i < n && copied < datagram.size(); ++i) {
+    const size_t amount = std::min(static_cast<size_t>(iov[i].iov_len),
+                                   datagram.size() - copied);
+    std::memcpy(iov[i].iov_base, datagram.data() + copied, amount);
+    copied += amount;
+  }
+  return static_cast<ssize_t>(copied);
+}
+
+size_t
+FecDecoder::recovered() const
+{
+  return this->recovered_.value();
+}
+
+size_t
+FecDecoder::unrecoverable() const
+{
+  return this->unrecoverable_.value();
+}
+
+size_t
+FecDecoder::kept() const
+{
+  size_t count = 0;
+  for (Sources::const_iterator it = this->sources_.begin();
+       it != this->sources_.end(); ++it) {
+    count += it->second.datagrams_.size();
+  }
+  return count;
+}
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,174 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef DCPS_MULTICASTFEC_H
+#define DCPS_MULTICASTFEC_H
+
+#include "Multicast_Export.h"
+
+#include "MulticastTypes.h"
+
+#include "dds/DCPS/PoolAllocator.h"
+
+#include "ace/Atomic_Op.h"
+#include "ace/Message_Block.h"
+#include "ace/Thread_Mutex.h"
+#include "ace/os_include/sys/os_uio.h"
+
+#include <utility>
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+/**
+ * @class FecEncoder
+ *
+ * @brief Generates XOR parity datagrams for outgoing multicast datagrams.
+ *
+ * Consecutive datagrams are grouped into blocks of K.  Within a block,
+ * parity datagram j (0 <= j < M) is the XOR of every datagram whose
+ * position i in the block satisfies i % M == j, so a block can lose up
+ * to M datagrams (any burst of up to M) and still be rebuilt by its
+ * receivers.  Parity datagrams carry a TransportHeader marked with
+ * MULTICAST_FEC_PARITY and never take a sequence number of their own.
+ * Each datagram is XORed into its parity as it is sent, so only the M
+ * parity buffers are kept.  Resent datagrams are not covered, and a
+ * block that skips a sequence number is abandoned.
+ */
+class OpenDDS_Multicast_Export FecEncoder {
+public:
+  FecEncoder(MulticastPeer source, size_t k, size_t m);
+
+  /// Add an outgoing datagram; once it completes a block the parity
+  /// datagrams to send are appended to @a parity.
+  void encode(const iovec iov[], int n,
+              OPENDDS_VECTOR(OPENDDS_STRING)& parity);
+
+  /// Number of parity datagrams generated.
+  size_t parity_generated() const;
+
+private:
+  OPENDDS_STRING parity_datagram(size_t index) const;
+
+  const MulticastPeer source_;
+  const size_t k_;
+  const size_t m_;
+
+  ACE_Thread_Mutex lock_;
+
+  /// Sequence number of the first datagram in the current block, and
+  /// of the datagram expected next.
+  ACE_INT64 block_start_;
+  ACE_INT64 next_;
+  size_t count_;
+
+  /// Per parity datagram: XOR of the covered datagrams (zero padded),
+  /// the longest covered datagram, and the XOR of their lengths.
+  OPENDDS_VECTOR(OPENDDS_STRING) parity_;
+  OPENDDS_VECTOR(size_t) lengths_;
+  OPENDDS_VECTOR(ACE_UINT32) length_xor_;
+
+  ACE_Atomic_Op<ACE_Thread_Mutex, size_t> parity_generated_;
+};
+
+/**
+ * @class FecDecoder
+ *
+ * @brief Rebuilds lost multicast datagrams from FecEncoder parity.
+ *
+ * Once a remote peer has sent parity, its datagrams are kept for a
+ * window of sequence numbers, and only until the parity covering them
+ * has been used.  Datagrams of peers that send no parity are not kept.
+ * When a parity datagram covers exactly one datagram that has not been
+ * received, that datagram is rebuilt and queued so that
+ * the receive strategy can parse it as if it had just been read from
+ * the socket.  Gaps that parity cannot repair are left to the NAK
+ * based repair of ReliableSession.
+ *
+ * Only the thread reading the socket uses a decoder.
+ */
+class OpenDDS_Multicast_Export FecDecoder {
+public:
+  FecDecoder(MulticastPeer local_peer, size_t window);
+
+  /// Record a datagram read from the socket into @a iov.  Returns
+  /// true if it was a parity datagram, which the caller must not parse.
+  bool received(const iovec iov[], int n, size_t length);
+
+  /// Is a rebuilt datagram waiting to be parsed?
+  bool has_recovered() const;
+
+  /// Copy the next rebuilt datagram into @a iov.  Returns its length,
+  /// or 0 if it did not fit.
+  ssize_t take_recovered(iovec iov[], int n);
+
+  /// Number of datagrams rebuilt from parity.
+  size_t recovered() const;
+
+  /// Number of parity datagrams that left the window without being
+  /// able to rebuild their missing datagrams.
+  size_t unrecoverable() const;
+
+  /// Number of received datagrams kept for recoveries.
+  size_t kept() const;
+
+private:
+  typedef OPENDDS_STRING Datagram;
+
+  struct Parity {
+    ACE_INT64 block_start_;
+    size_t k_;
+    size_t m_;
+    size_t index_;
+    ACE_UINT32 length_xor_;
+    Datagram data_;
+
+    bool covers(ACE_INT64 seq) const;
+  };
+
+  typedef std::pair<ACE_INT64, size_t> ParityKey;
+  typedef OPENDDS_MAP(ParityKey, Parity) Parities;
+  typedef OPENDDS_MAP(ACE_INT64, Datagram) Datagrams;
+
+  struct Source {
+    Source() : high_(0), kept_from_(0) {}
+    Datagrams datagrams_;
+    Parities parities_;
+    ACE_INT64 high_;
+    /// First sequence number kept, once the source has sent parity.
+    ACE_INT64 kept_from_;
+    /// Datagrams whose parity has been used, so that late copies of
+    /// them (e.g. repairs) are not kept.
+    OPENDDS_SET(ACE_INT64) resolved_;
+  };
+  typedef OPENDDS_MAP(MulticastPeer, Source) Sources;
+
+  void parity_received(Source& source, ACE_Message_Block& body,
+                       ACE_INT64 block_start, bool swap_bytes);
+  void try_recover(Source& source, Parities::iterator parity);
+  void advance(Source& source, ACE_INT64 seq);
+  size_t missing(const Source& source, const Parity& parity,
+                 ACE_INT64& last_missing) const;
+
+  const MulticastPeer local_peer_;
+  const size_t window_;
+
+  Sources sources_;
+  OPENDDS_DEQUE(Datagram) recovered_queue_;
+
+  ACE_Atomic_Op<ACE_Thread_Mutex, size_t> recovered_;
+  ACE_Atomic_Op<ACE_Thread_Mutex, size_t> unrecoverable_;
+};
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif  /* DCPS_MULTICASTFEC_H */
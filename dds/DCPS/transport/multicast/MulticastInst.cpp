@@ -14,6 +14,7 @@
 
 #include "ace/Configuration.h"
 
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 
@@ -37,10 +38,19 @@ const long DEFAULT_NAK_INTERVAL(500);
 const long DEFAULT_NAK_DELAY_INTERVALS(4);
 const long DEFAULT_NAK_MAX(3);
 const long DEFAULT_NAK_TIMEOUT(30000);
+const bool DEFAULT_NAK_SUPPRESSION(true);
+const long DEFAULT_NAK_REPAIR_DELAY(20);
 
 const unsigned char DEFAULT_TTL(1);
 const bool DEFAULT_ASYNC_SEND(false);
 
+const size_t DEFAULT_FEC_K(0);
+const size_t DEFAULT_FEC_M(1);
+const size_t MAX_FEC_K(255);
+
+const double DEFAULT_SEND_LOSS_RATE(0.0);
+const size_t DEFAULT_SEND_LOSS_BURST(1);
+
 } // namespace
 
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
@@ -57,6 +67,7 @@ MulticastInst::MulticastInst(const std::string& name)
     nak_depth_(DEFAULT_NAK_DEPTH),
     nak_delay_intervals_(DEFAULT_NAK_DELAY_INTERVALS),
     nak_max_(DEFAULT_NAK_MAX),
+    nak_suppression_(DEFAULT_NAK_SUPPRESSION),
     ttl_(DEFAULT_TTL),
 #if defined (ACE_DEFAULT_MAX_SOCKET_BUFSIZ)
     rcv_buffer_size_(ACE_DEFAULT_MAX_SOCKET_BUFSIZ),
@@ -64,7 +75,11 @@ MulticastInst::MulticastInst(const std::string& name)
     // Use system default values.
     rcv_buffer_size_(0),
 #endif
-    async_send_(DEFAULT_ASYNC_SEND)
+    async_send_(DEFAULT_ASYNC_SEND),
+    fec_k_(DEFAULT_FEC_K),
+    fec_m_(DEFAULT_FEC_M),
+    send_loss_rate_(DEFAULT_SEND_LOSS_RATE),
+    send_loss_burst_(DEFAULT_SEND_LOSS_BURST)
 {
   default_group_address(this->group_address_);
 
@@ -73,6 +88,7 @@ MulticastInst::MulticastInst(const std::string& name)
 
   this->nak_interval_.msec(DEFAULT_NAK_INTERVAL);
   this->nak_timeout_.msec(DEFAULT_NAK_TIMEOUT);
+  this->nak_repair_delay_.msec(DEFAULT_NAK_REPAIR_DELAY);
 }
 
 int
@@ -121,6 +137,11 @@ MulticastInst::load(ACE_Configuration_Heap& cf,
 
   GET_CONFIG_TIME_VALUE(cf, sect, ACE_TEXT("nak_timeout"), this->nak_timeout_)
 
+  GET_CONFIG_VALUE(cf, sect, ACE_TEXT("nak_suppression"),
+                   this->nak_suppression_, bool)
+
+  GET_CONFIG_TIME_VALUE(cf, sect, ACE_TEXT("nak_repair_delay"), this->nak_repair_delay_)
+
   GET_CONFIG_VALUE(cf, sect, ACE_TEXT("ttl"), this->ttl_, unsigned char)
 
   GET_CONFIG_VALUE(cf, sect, ACE_TEXT("rcv_buffer_size"),
@@ -130,6 +151,37 @@ MulticastInst::load(ACE_Configuration_Heap& cf,
   GET_CONFIG_VALUE(cf, sect, ACE_TEXT("async_send"), this->async_send_, bool)
 #endif
 
+  GET_CONFIG_VALUE(cf, sect, ACE_TEXT("fec_k"), this->fec_k_, size_t)
+  GET_CONFIG_VALUE(cf, sect, ACE_TEXT("fec_m"), this->fec_m_, size_t)
+
+  if (this->fec_k_ > MAX_FEC_K) {
+    ACE_DEBUG((LM_NOTICE,
+               ACE_TEXT("(%P|%t) NOTICE: MulticastInst::load: ")
+               ACE_TEXT("fec_k %B is larger than %B, using %B\n"),
+               this->fec_k_, MAX_FEC_K, MAX_FEC_K));
+    this->fec_k_ = MAX_FEC_K;
+  }
+  if (this->fec_k_ > 0 && (this->fec_m_ == 0 || this->fec_m_ > this->fec_k_)) {
+    const size_t fec_m = std::min(std::max(this->fec_m_, size_t(1)), this->fec_k_);
+    ACE_DEBUG((LM_NOTICE,
+               ACE_TEXT("(%P|%t) NOTICE: MulticastInst::load: ")
+               ACE_TEXT("fec_m %B must be between 1 and fec_k, using %B\n"),
+               this->fec_m_, fec_m));
+    this->fec_m_ = fec_m;
+  }
+
+  GET_CONFIG_VALUE(cf, sect, ACE_TEXT("send_loss_rate"),
+                   this->send_loss_rate_, double)
+  GET_CONFIG_VALUE(cf, sect, ACE_TEXT("send_loss_burst"),
+                   this->send_loss_burst_, size_t)
+  if (this->send_loss_rate_ > 0.0) {
+    ACE_DEBUG((LM_WARNING,
+               ACE_TEXT("(%P|%t) WARNING: MulticastInst::load: ")
+               ACE_TEXT("send_loss_rate is a testing aid; dropping %f of ")
+               ACE_TEXT("outgoing datagrams on purpose\n"),
+               this->send_loss_rate_));
+  }
+
   return 0;
 }
 
@@ -169,6 +221,8 @@ MulticastInst::dump_to_str() const
   os << formatNameForDump("nak_delay_intervals") << this->nak_delay_intervals_ << std::endl;
   os << formatNameForDump("nak_max")             << this->nak_max_ << std::endl;
   os << formatNameForDump("nak_timeout")         << this->nak_timeout_.msec() << std::endl;
+  os << formatNameForDump("nak_suppression")     << (this->nak_suppression_ ? "true" : "false") << std::endl;
+  os << formatNameForDump("nak_repair_delay")    << this->nak_repair_delay_.msec() << std::endl;
   os << formatNameForDump("ttl")                 << int(this->ttl_) << std::endl;
   os << formatNameForDump("rcv_buffer_size");
 
@@ -185,6 +239,12 @@ MulticastInst::dump_to_str() const
 #else
   os << "Not Supported on this Platform" << std::endl;
 #endif
+  os << formatNameForDump("fec_k")               << this->fec_k_ << std::endl;
+  os << formatNameForDump("fec_m")               << this->fec_m_ << std::endl;
+  if (this->send_loss_rate_ > 0.0) {
+    os << formatNameForDump("send_loss_rate")    << this->send_loss_rate_ << std::endl;
+    os << formatNameForDump("send_loss_burst")   << this->send_loss_burst_ << std::endl;
+  }
   return OPENDDS_STRING(os.str());
 }
 
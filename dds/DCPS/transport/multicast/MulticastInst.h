@@ -89,6 +89,18 @@ public:
   /// The default value is: 30000 (30 seconds).
   ACE_Time_Value nak_timeout_;
 
+  /// Enables suppression of repair requests for datagrams that
+  /// another receiver has already requested during the current
+  /// interval (reliable only).
+  /// The default value is: true.
+  bool nak_suppression_;
+
+  /// The number of milliseconds a sender collects repair requests
+  /// before resending the union of the requested datagrams once;
+  /// 0 resends as soon as each request arrives (reliable only).
+  /// The default value is: 20.
+  ACE_Time_Value nak_repair_delay_;
+
   /// time-to-live.
   /// The default value is: 1 (in same subnet)
   unsigned char ttl_;
@@ -105,6 +117,32 @@ public:
   /// that don't support asynchronous I/O.
   bool async_send_;
 
+  /// The number of datagrams protected by each block of forward error
+  /// correction parity; 0 disables sending parity.  Losses that parity
+  /// cannot repair fall back to repair requests (reliable only).  At
+  /// most 255.  Releases without forward error correction parse parity
+  /// as data, so a link only sends it while the remote peer of each of
+  /// its sessions has advertised in its handshake that it skips parity.
+  /// The default value is: 0.
+  size_t fec_k_;
+
+  /// The number of parity datagrams sent for each block of fec_k
+  /// datagrams; a block survives the loss of any fec_m consecutive
+  /// datagrams.  Must be between 1 and fec_k.
+  /// The default value is: 1.
+  size_t fec_m_;
+
+  /// Testing aid, not for deployments: the probability that an outgoing
+  /// datagram is silently dropped instead of sent, to exercise forward
+  /// error correction and repair requests.
+  /// The default value is: 0.0.
+  double send_loss_rate_;
+
+  /// Testing aid: the number of consecutive datagrams dropped each
+  /// time send_loss_rate triggers a loss.
+  /// The default value is: 1.
+  size_t send_loss_burst_;
+
   virtual int load(ACE_Configuration_Heap& cf,
                    ACE_Configuration_Section_Key& sect);
 
@@ -8,16 +8,32 @@
 #include "MulticastReceiveStrategy.h"
 #include "MulticastDataLink.h"
 
+#include "ace/OS_NS_errno.h"
 #include "ace/Reactor.h"
 
+#include <algorithm>
+
+namespace {
+  /// Smallest number of sequence numbers a FecDecoder keeps datagrams for.
+  const size_t FEC_MIN_WINDOW = 256;
+}
+
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
 namespace OpenDDS {
 namespace DCPS {
 
 MulticastReceiveStrategy::MulticastReceiveStrategy(MulticastDataLink* link)
-  : link_(link)
+  : TransportReceiveStrategy<>(link->impl().config())
+  , link_(link)
 {
+  const MulticastInst& config = link->config();
+  if (config.fec_k_ > 0) {
+    // Keep received datagrams long enough for a few blocks of parity.
+    this->fec_decoder_.reset(
+      new FecDecoder(link->local_peer(),
+                     std::max(4 * config.fec_k_, size_t(FEC_MIN_WINDOW))));
+  }
 }
 
 ACE_HANDLE
@@ -29,6 +45,19 @@ MulticastReceiveStrategy::get_handle() const
 
 int
 MulticastReceiveStrategy::handle_input(ACE_HANDLE fd)
+{
+  int result = this->handle_datagram(fd);
+
+  // Datagrams rebuilt from parity are parsed as if they had just been
+  // read from the socket.
+  while (result >= 0 && this->fec_decoder_ && this->fec_decoder_->has_recovered()) {
+    result = this->handle_datagram(fd);
+  }
+  return result;
+}
+
+int
+MulticastReceiveStrategy::handle_datagram(ACE_HANDLE fd)
 {
   const int result = this->handle_dds_input(fd);
   if (result >= 0 && this->pdu_remaining()) {
@@ -39,15 +68,55 @@ MulticastReceiveStrategy::handle_input(ACE_HANDLE fd)
   return result;
 }
 
+size_t
+MulticastReceiveStrategy::fec_recovered() const
+{
+  return this->fec_decoder_ ? this->fec_decoder_->recovered() : 0;
+}
+
+size_t
+MulticastReceiveStrategy::fec_unrecoverable() const
+{
+  return this->fec_decoder_ ? this->fec_decoder_->unrecoverable() : 0;
+}
+
 ssize_t
 MulticastReceiveStrategy::receive_bytes(iovec iov[],
                                         int n,
                                         ACE_INET_Addr& remote_address,
                                         ACE_HANDLE /*fd*/,
-                                        bool& /*stop*/)
+                                        bool& stop)
 {
+  if (this->fec_decoder_ && this->fec_decoder_->has_recovered()) {
+    const ssize_t length = this->fec_decoder_->take_recovered(iov, n);
+    if (length <= 0) {
+      stop = true;
+    }
+    return length;
+  }
+
   ACE_SOCK_Dgram_Mcast& socket = this->link_->socket();
-  return socket.recv(iov, n, remote_address);
+  KernelTimestamps& timestamps = this->link_->timestamps();
+  ssize_t result;
+  if (timestamps.enabled()) {
+    timestamps.collect_send_timestamps(socket.get_handle(), *this->link_->latency());
+    result = timestamps.recv(socket.get_handle(), iov, n, remote_address,
+                             this->kernel_receive_time_);
+    if (result == -1 && errno == EWOULDBLOCK) {
+      // Only transmit timestamps were waiting.
+      stop = true;
+      return 0;
+    }
+  } else {
+    result = socket.recv(iov, n, remote_address);
+  }
+
+  // Parity datagrams only feed the decoder.
+  if (result > 0 && this->fec_decoder_ &&
+      this->fec_decoder_->received(iov, n, static_cast<size_t>(result))) {
+    stop = true;
+  }
+  return result;
 }
 
 bool
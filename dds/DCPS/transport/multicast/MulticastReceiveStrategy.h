@@ -9,8 +9,10 @@
 #define DCPS_MULTICASTRECEIVESTRATEGY_H
 
 #include "Multicast_Export.h"
+#include "MulticastFec.h"
 
 #include "dds/DCPS/RcEventHandler.h"
+#include "dds/DCPS/unique_ptr.h"
 #include "dds/DCPS/transport/framework/TransportReceiveStrategy_T.h"
 
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
@@ -30,6 +32,11 @@ public:
   virtual ACE_HANDLE get_handle() const;
   virtual int handle_input(ACE_HANDLE fd);
 
+  /// Forward error correction counters: datagrams rebuilt from parity,
+  /// and parity datagrams that could not rebuild their losses.
+  size_t fec_recovered() const;
+  size_t fec_unrecoverable() const;
+
 protected:
   virtual ssize_t receive_bytes(iovec iov[],
                                 int n,
@@ -49,7 +56,11 @@ protected:
   virtual bool reassemble(ReceivedDataSample& data);
 
 private:
+  int handle_datagram(ACE_HANDLE fd);
+
   MulticastDataLink* link_;
+
+  unique_ptr<FecDecoder> fec_decoder_;
 };
 
 } // namespace DCPS
@@ -9,6 +9,10 @@
 #include "MulticastDataLink.h"
 #include "dds/DCPS/transport/framework/NullSynchStrategy.h"
 #include "ace/Proactor.h"
+#include "ace/OS_NS_stdlib.h"
+#include "ace/OS_NS_sys_time.h"
+
+#include <cstdlib>
 
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
@@ -20,7 +24,9 @@ MulticastSendStrategy::MulticastSendStrategy(MulticastDataLink* link)
                           0,  // synch_resource
                           link->transport_priority(),
                           make_rch<NullSynchStrategy>()),
-    link_(link)
+    link_(link),
+    loss_burst_remaining_(0),
+    loss_seed_(0)
 #if defined (ACE_HAS_WIN32_OVERLAPPED_IO) || defined (ACE_HAS_AIO_CALLS)
   , async_init_(false)
 #endif
@@ -28,6 +34,25 @@ MulticastSendStrategy::MulticastSendStrategy(MulticastDataLink* link)
   // Multicast will send a SYN (TRANSPORT_CONTROL) before any reservations
   // are made on the DataLink, if the link is "release" it will be dropped.
   this->link_released(false);
+
+  // Each link drops its own datagrams, independent of other links and
+  // of the application's use of rand().
+  const ACE_Time_Value now = ACE_OS::gettimeofday();
+  this->loss_seed_ = static_cast<unsigned int>(now.usec()) ^
+    static_cast<unsigned int>(link->local_peer()) ^
+    static_cast<unsigned int>(reinterpret_cast<size_t>(this));
+
+  const MulticastInst& config = link->config();
+  if (config.fec_k_ > 0) {
+    this->fec_encoder_.reset(
+      new FecEncoder(link->local_peer(), config.fec_k_, config.fec_m_));
+  }
+}
+
+size_t
+MulticastSendStrategy::fec_parity_sent() const
+{
+  return this->fec_encoder_ ? this->fec_encoder_->parity_generated() : 0;
 }
 
 void
@@ -40,7 +65,63 @@ MulticastSendStrategy::prepare_header_i()
 ssize_t
 MulticastSendStrategy::send_bytes_i(const iovec iov[], int n)
 {
-  return (this->link_->config().async_send() ? async_send(iov, n) : sync_send(iov, n));
+  const ssize_t result = this->link_->config().async_send()
+                       ? async_send(iov, n) : sync_send(iov, n);
+
+  // Older peers parse parity as data, so it is only sent while every
+  // remote peer skips it.  The datagrams sent meanwhile leave a gap that
+  // abandons the encoder's block.
+  if (result > 0 && this->fec_encoder_ && this->link_->fec_peers()) {
+    this->send_parity(iov, n);
+  }
+
+  return result;
+}
+
+void
+MulticastSendStrategy::send_parity(const iovec iov[], int n)
+{
+  OPENDDS_VECTOR(OPENDDS_STRING) parity;
+  this->fec_encoder_->encode(iov, n, parity);
+
+  ACE_SOCK_Dgram_Mcast& socket = this->link_->socket();
+  KernelTimestamps& timestamps = this->link_->timestamps();
+  for (size_t i = 0; i < parity.size(); ++i) {
+    if (this->drop_datagram()) {
+      continue;
+    }
+    // Parity is best effort; receivers fall back to NAKs without it.
+    const ACE_Time_Value called =
+      timestamps.enabled() ? ACE_OS::gettimeofday() : ACE_Time_Value::zero;
+    if (socket.send(parity[i].data(), parity[i].size()) < 0) {
+      VDBG_LVL((LM_WARNING, "(%P|%t) WARNING: MulticastSendStrategy::send_parity: "
+                "failed to send parity datagram: %p\n", "send"), 2);
+    } else {
+      timestamps.sent(called);
+    }
+  }
+}
+
+bool
+MulticastSendStrategy::drop_datagram()
+{
+  const MulticastInst& config = this->link_->config();
+  if (config.send_loss_rate_ <= 0.0) {
+    return false;
+  }
+
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, this->loss_lock_, false);
+  if (this->loss_burst_remaining_ > 0) {
+    --this->loss_burst_remaining_;
+    return true;
+  }
+  if (static_cast<double>(ACE_OS::rand_r(&this->loss_seed_)) / RAND_MAX <
+      config.send_loss_rate_) {
+    this->loss_burst_remaining_ =
+      config.send_loss_burst_ > 0 ? config.send_loss_burst_ - 1 : 0;
+    return true;
+  }
+  return false;
 }
 
 ssize_t
@@ -48,7 +129,20 @@ MulticastSendStrategy::sync_send(const iovec iov[], int n)
 {
   ACE_SOCK_Dgram_Mcast& socket = this->link_->socket();
 
+  if (this->drop_datagram()) {
+    // Pretend the datagram was sent; receivers have to repair the loss.
+    ssize_t b = 0;
+    for (int i = 0; i < n; ++i) b += iov[i].iov_len;
+    return b;
+  }
+
+  KernelTimestamps& timestamps = this->link_->timestamps();
+  const ACE_Time_Value called =
+    timestamps.enabled() ? ACE_OS::gettimeofday() : ACE_Time_Value::zero;
   const ssize_t result = socket.send(iov, n);
+  if (result >= 0) {
+    timestamps.sent(called);
+  }
 
   if (result == -1 && errno == ENOBUFS) {
     // Make the framework think this was a successful send to avoid
@@ -9,9 +9,12 @@
 #define DCPS_MULTICASTSENDSTRATEGY_H
 
 #include "Multicast_Export.h"
+#include "MulticastFec.h"
 
 #include "dds/DCPS/transport/framework/TransportSendStrategy.h"
+#include "dds/DCPS/unique_ptr.h"
 #include "ace/Asynch_IO.h"
+#include "ace/Thread_Mutex.h"
 
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
@@ -32,6 +35,9 @@ public:
 
   virtual void stop_i();
 
+  /// Number of forward error correction parity datagrams generated.
+  size_t fec_parity_sent() const;
+
 protected:
   virtual void prepare_header_i();
 
@@ -39,6 +45,13 @@ protected:
   ssize_t sync_send(const iovec iov[], int n);
   ssize_t async_send(const iovec iov[], int n);
 
+  /// Send the parity datagrams of any block @a iov completes.
+  void send_parity(const iovec iov[], int n);
+
+  /// Loss injection for testing repair; true if the datagram should
+  /// be dropped instead of sent.
+  bool drop_datagram();
+
   virtual size_t max_message_size() const
   {
     return UDP_MAX_MESSAGE_SIZE;
@@ -52,6 +65,12 @@ protected:
 private:
   MulticastDataLink* link_;
 
+  unique_ptr<FecEncoder> fec_encoder_;
+
+  ACE_Thread_Mutex loss_lock_;
+  size_t loss_burst_remaining_;
+  unsigned int loss_seed_;
+
 #if defined (ACE_HAS_WIN32_OVERLAPPED_IO) || defined (ACE_HAS_AIO_CALLS)
   ACE_Asynch_Write_Dgram async_writer_;
   bool async_init_;
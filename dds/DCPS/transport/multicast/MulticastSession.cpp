@@ -182,6 +182,13 @@ MulticastSession::syn_received(const Message_Block_Ptr& control)
   // Ignore sample if not destined for us:
   if (local_peer != this->link_->local_peer()) return;
 
+  // Peers of older releases send no capabilities.
+  ACE_CDR::Octet capabilities = 0;
+  if (!(serializer >> ACE_InputCDR::to_octet(capabilities))) {
+    capabilities = 0;
+  }
+  this->link_->remote_capabilities(this->remote_peer_, capabilities);
+
   VDBG_LVL((LM_DEBUG, "(%P|%t) MulticastSession[%C]::syn_received "
                     "local %#08x%08x remote %#08x%08x\n",
                     this->link()->config().name().c_str(),
@@ -210,13 +217,14 @@ MulticastSession::syn_received(const Message_Block_Ptr& control)
 void
 MulticastSession::send_syn()
 {
-  size_t len = sizeof(this->remote_peer_);
+  size_t len = sizeof(this->remote_peer_) + sizeof(ACE_CDR::Octet);
 
   Message_Block_Ptr data( new ACE_Message_Block(len));
 
   Serializer serializer(data.get());
 
   serializer << this->remote_peer_;
+  serializer << ACE_OutputCDR::from_octet(MULTICAST_CAPABILITIES);
 
   VDBG_LVL((LM_DEBUG, "(%P|%t) MulticastSession[%C]::send_syn "
                       "local %#08x%08x remote %#08x%08x\n",
@@ -252,6 +260,13 @@ MulticastSession::synack_received(const Message_Block_Ptr& control)
   // Ignore sample if not destined for us:
   if (local_peer != this->link_->local_peer()) return;
 
+  // Peers of older releases send no capabilities.
+  ACE_CDR::Octet capabilities = 0;
+  if (!(serializer >> ACE_InputCDR::to_octet(capabilities))) {
+    capabilities = 0;
+  }
+  this->link_->remote_capabilities(this->remote_peer_, capabilities);
+
   VDBG_LVL((LM_DEBUG, "(%P|%t) MulticastSession[%C]::synack_received "
                       "local %#08x%08x remote %#08x%08x\n",
                       this->link()->config().name().c_str(),
@@ -273,13 +288,14 @@ MulticastSession::synack_received(const Message_Block_Ptr& control)
 void
 MulticastSession::send_synack()
 {
-  size_t len = sizeof(this->remote_peer_);
+  size_t len = sizeof(this->remote_peer_) + sizeof(ACE_CDR::Octet);
 
   Message_Block_Ptr data(new ACE_Message_Block(len));
 
   Serializer serializer(data.get());
 
   serializer << this->remote_peer_;
+  serializer << ACE_OutputCDR::from_octet(MULTICAST_CAPABILITIES);
 
   VDBG_LVL((LM_DEBUG, "(%P|%t) MulticastSession[%C]::send_synack "
                       "local %#08x%08x remote %#08x%08x active %d\n",
@@ -69,7 +69,7 @@ MulticastTransport::make_datalink(const RepoId& local_id,
             this->config().name().c_str(), (unsigned int)(local_peer >> 32), (unsigned int)local_peer,
             priority, active), 2);
 
-  ReactorTask_rch rtask(reactor_task());
+  ReactorTask_rch rtask(reactor_task(size_t(local_peer ^ (local_peer >> 32)) * 2 + active));
   MulticastDataLink_rch link(make_rch<MulticastDataLink>(ref(*this),
                                    session_factory,
                                    local_peer,
@@ -9,6 +9,7 @@
 #define DCPS_MULTICASTTYPES_H
 
 #include "ace/Basic_Types.h"
+#include "ace/CDR_Base.h"
 #include "dds/Versioned_Namespace.h"
 
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
@@ -18,6 +19,16 @@ namespace DCPS {
 
 typedef ACE_INT64 MulticastPeer;
 
+/// TransportHeader::reserved_ value marking a forward error correction
+/// parity datagram (see FecEncoder).
+const ACE_CDR::Octet MULTICAST_FEC_PARITY = 0x46;
+
+/// Capabilities a peer advertises in the octet following its
+/// MulticastPeer in SYN and SYNACK control samples.  Peers of releases
+/// that do not send the octet have none.
+const ACE_CDR::Octet MULTICAST_CAP_FEC_PARITY = 0x01; ///< skips parity
+const ACE_CDR::Octet MULTICAST_CAPABILITIES = MULTICAST_CAP_FEC_PARITY;
+
 } // namespace DCPS
 } // namespace OpenDDS
 
@@ -17,7 +17,9 @@
 
 #include "dds/DCPS/Serializer.h"
 #include "dds/DCPS/GuidConverter.h"
+#include "dds/DCPS/transport/framework/TransportDebug.h"
 
+#include <algorithm>
 #include <cstdlib>
 
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
@@ -63,7 +65,10 @@ ReliableSession::ReliableSession(ACE_Reactor* reactor,
                                  MulticastDataLink* link,
                                  MulticastPeer remote_peer)
   : MulticastSession(reactor, owner, link, remote_peer),
-    nak_watchdog_(make_rch<NakWatchdog> (reactor, owner, this))
+    nak_watchdog_(make_rch<NakWatchdog> (reactor, owner, this)),
+    naks_sent_(0),
+    naks_suppressed_(0),
+    nak_ranges_received_(0)
 {
 }
 
@@ -452,11 +457,24 @@ ReliableSession::send_naks()
     }
   }
 
-  for (NakPeerSet::iterator it(this->nak_peers_.begin());
-       it != this->nak_peers_.end(); ++it) {
-    // Update sequence to temporarily suppress repair requests for
-    // ranges already requested by other peers for this interval:
-    received.insert(*it);
+  if (!this->nak_peers_.empty()) {
+    const size_t gaps = received.missing_sequence_ranges().size();
+    const SequenceNumber high = received.high();
+
+    for (NakPeerSet::iterator it(this->nak_peers_.begin());
+         it != this->nak_peers_.end(); ++it) {
+      // Update sequence to temporarily suppress repair requests for
+      // ranges already requested by other peers for this interval;
+      // their repair is multicast to us as well.  Ranges beyond our
+      // high-water mark would only create gaps of their own:
+      if (it->first > high) continue;
+      received.insert(SequenceRange(it->first, std::min(it->second, high)));
+    }
+
+    const size_t remaining = received.missing_sequence_ranges().size();
+    if (remaining < gaps) {
+      this->naks_suppressed_ += gaps - remaining;
+    }
   }
   bool sending_naks = false;
   if (received.low() > 1){
@@ -494,6 +512,7 @@ ReliableSession::send_naks()
     }
     // Send control sample to remote peer:
     send_control(MULTICAST_NAK, move(data));
+    ++this->naks_sent_;
   }
   if (received.disjoint()) {
     sending_naks = true;
@@ -516,8 +535,6 @@ ReliableSession::send_naks()
 void
 ReliableSession::nak_received(const Message_Block_Ptr& control)
 {
-  if (!this->active_) return; // sub send naks, then doesn't receive them.
-
   const TransportHeader& header =
     this->link_->receive_strategy()->received_header();
 
@@ -537,6 +554,17 @@ ReliableSession::nak_received(const Message_Block_Ptr& control)
     ranges.push_back(range);
   }
 
+  if (!this->active_) {
+    // Overhear repair requests other peers send to our remote peer so
+    // that send_naks() does not request the same datagrams again:
+    if (this->link_->config().nak_suppression_ &&
+        local_peer == this->remote_peer_ &&
+        header.source_ != this->link_->local_peer()) {
+      this->nak_peers_.insert(ranges.begin(), ranges.end());
+    }
+    return;
+  }
+
   // Ignore sample if not destined for us:
   if ((local_peer != this->link_->local_peer())        // Not to us.
     || (this->remote_peer_ != header.source_)) return; // Not from the remote peer for this session.
@@ -559,8 +587,12 @@ ReliableSession::nak_received(const Message_Block_Ptr& control)
     send_nakack(send_buffer->low());
   }
 
+  this->nak_ranges_received_ += size;
+
+  // Resends are multicast; the link merges the ranges requested by all
+  // peers and resends them once:
   for (CORBA::ULong i = 0; i < size; ++i) {
-    bool ret = send_buffer->resend(ranges[i]);
+    bool ret = this->link_->request_repair(ranges[i]);
     if (OpenDDS::DCPS::DCPS_debug_level > 0) {
       ACE_DEBUG ((LM_DEBUG,
                   ACE_TEXT ("(%P|%t) ReliableSession::nak_received")
@@ -608,6 +640,7 @@ ReliableSession::send_naks(DisjointSequence& received)
   }
   // Send control sample to remote peer:
   send_control(MULTICAST_NAK, move(data));
+  ++this->naks_sent_;
 }
 
 
@@ -727,6 +760,15 @@ ReliableSession::stop()
 {
   MulticastSession::stop();
   this->nak_watchdog_->cancel();
+
+  VDBG_LVL((LM_DEBUG, ACE_TEXT("(%P|%t) ReliableSession::stop local %#08x%08x ")
+            ACE_TEXT("remote %#08x%08x naks sent: %B suppressed: %B nak ranges received: %B\n"),
+            (unsigned int)(this->link()->local_peer() >> 32),
+            (unsigned int) this->link()->local_peer(),
+            (unsigned int)(this->remote_peer_ >> 32),
+            (unsigned int) this->remote_peer_,
+            this->naks_sent_.value(), this->naks_suppressed_.value(),
+            this->nak_ranges_received_.value()), 1);
 }
 
 } // namespace DCPS
@@ -13,6 +13,7 @@
 #include "MulticastSession.h"
 #include "MulticastTypes.h"
 
+#include "ace/Atomic_Op.h"
 #include "ace/Synch_Traits.h"
 
 #include "dds/DCPS/DisjointSequence.h"
@@ -94,6 +95,14 @@ private:
 
   typedef OPENDDS_SET(SequenceRange) NakPeerSet;
   NakPeerSet nak_peers_;
+
+  /// Repair traffic counters, logged when the session stops: NAK
+  /// control samples sent, gaps not requested because another peer
+  /// already requested them, and ranges requested of us by the
+  /// remote peer.
+  ACE_Atomic_Op<ACE_Thread_Mutex, size_t> naks_sent_;
+  ACE_Atomic_Op<ACE_Thread_Mutex, size_t> naks_suppressed_;
+  ACE_Atomic_Op<ACE_Thread_Mutex, size_t> nak_ranges_received_;
 };
 
 } // namespace DCPS
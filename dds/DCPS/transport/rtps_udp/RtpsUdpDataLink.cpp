@@ -255,6 +255,11 @@ RtpsUdpDataLink::open(const ACE_SOCK_Dgram& unicast_socket)
     }
   }
 
+  enable_kernel_timestamps(unicast_timestamps_, unicast_socket_.get_handle());
+  if (config.use_multicast_) {
+    enable_kernel_timestamps(multicast_timestamps_, multicast_socket_.get_handle());
+  }
+
   send_strategy()->send_buffer(&multi_buff_);
 
   if (start(send_strategy_,
@@ -21,6 +21,7 @@
 #include "ace/SOCK_Dgram_Mcast.h"
 
 #include "dds/DCPS/transport/framework/DataLink.h"
+#include "dds/DCPS/transport/framework/KernelTimestamps.h"
 #include "dds/DCPS/ReactorTask.h"
 #include "dds/DCPS/ReactorTask_rch.h"
 #include "dds/DCPS/transport/framework/TransportSendBuffer.h"
@@ -78,6 +79,11 @@ public:
   ACE_SOCK_Dgram& unicast_socket();
   ACE_SOCK_Dgram_Mcast& multicast_socket();
 
+  /// Kernel timestamps of the datagrams of unicast_socket() and
+  /// multicast_socket(), if the transport sets kernel_timestamps.
+  KernelTimestamps& unicast_timestamps();
+  KernelTimestamps& multicast_timestamps();
+
   bool open(const ACE_SOCK_Dgram& unicast_socket);
 
   void received(const RTPS::DataSubmessage& data,
@@ -200,6 +206,8 @@ private:
 
   ACE_SOCK_Dgram unicast_socket_;
   ACE_SOCK_Dgram_Mcast multicast_socket_;
+  KernelTimestamps unicast_timestamps_;
+  KernelTimestamps multicast_timestamps_;
 
   struct MultiSendBuffer : TransportSendBuffer {
 
@@ -38,6 +38,18 @@ RtpsUdpDataLink::multicast_socket()
   return multicast_socket_;
 }
 
+ACE_INLINE KernelTimestamps&
+RtpsUdpDataLink::unicast_timestamps()
+{
+  return unicast_timestamps_;
+}
+
+ACE_INLINE KernelTimestamps&
+RtpsUdpDataLink::multicast_timestamps()
+{
+  return multicast_timestamps_;
+}
+
 ACE_INLINE void
 RtpsUdpDataLink::release_remote_i(const RepoId& remote_id)
 {
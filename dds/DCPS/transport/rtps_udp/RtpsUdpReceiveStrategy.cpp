@@ -22,7 +22,8 @@ namespace OpenDDS {
 namespace DCPS {
 
   RtpsUdpReceiveStrategy::RtpsUdpReceiveStrategy(RtpsUdpDataLink* link, const GuidPrefix_t& local_prefix)
-  : link_(link)
+  : TransportReceiveStrategy<RtpsTransportHeader, RtpsSampleHeader>(link->impl().config())
+  , link_(link)
   , last_received_()
   , recvd_sample_(0)
   , receiver_(local_prefix)
@@ -38,7 +39,14 @@ namespace DCPS {
 int
 RtpsUdpReceiveStrategy::handle_input(ACE_HANDLE fd)
 {
-  return handle_dds_input(fd);
+  int result = handle_dds_input(fd);
+
+  // A single wakeup for the io_uring can carry many datagrams.
+  const size_t max_batch = link_->config().io_uring_buffers_;
+  for (size_t i = 0; i < max_batch && result >= 0 && io_uring_.pending(); ++i) {
+    result = handle_dds_input(fd);
+  }
+  return result;
 }
 
 ssize_t
@@ -47,14 +55,37 @@ RtpsUdpReceiveStrategy::receive_bytes_helper(iovec iov[],
                                              const ACE_SOCK_Dgram& socket,
                                              ACE_INET_Addr& remote_address,
                                              ICE::Endpoint* endpoint,
-                                             bool& stop)
+                                             bool& stop,
+                                             KernelTimestamps* timestamps,
+                                             ACE_Time_Value* kernel_receive_time,
+                                             IoUringReceiver* io_uring)
 {
   ACE_INET_Addr local_address;
-  const ssize_t ret = socket.recv(iov, n, remote_address, 0
+  ssize_t ret;
+  if (io_uring) {
+    const bool timestamped = timestamps && timestamps->enabled();
+    ret = io_uring->receive(iov, n, remote_address,
+                            timestamped ? kernel_receive_time : 0,
+                            &local_address);
+    if (ret == -1 && errno == EWOULDBLOCK) {
+      stop = true;
+      return 0;
+    }
+  } else if (timestamps && timestamps->enabled()) {
+    ret = timestamps->recv(socket.get_handle(), iov, n, remote_address,
+                           *kernel_receive_time, &local_address);
+    if (ret == -1 && errno == EWOULDBLOCK) {
+      // Only transmit timestamps were waiting.
+      stop = true;
+      return 0;
+    }
+  } else {
+    ret = socket.recv(iov, n, remote_address, 0
 #ifdef ACE_RECVPKTINFO
-                                  , &local_address
+                      , &local_address
 #endif
-  );
+    );
+  }
 
   if (ret == -1) {
     return ret;
@@ -111,9 +142,9 @@ RtpsUdpReceiveStrategy::receive_bytes(iovec iov[],
                                       ACE_HANDLE fd,
                                       bool& stop)
 {
+  const bool unicast = fd == link_->unicast_socket().get_handle();
   const ACE_SOCK_Dgram& socket =
-    (fd == link_->unicast_socket().get_handle())
-    ? link_->unicast_socket() : link_->multicast_socket();
+    unicast ? link_->unicast_socket() : link_->multicast_socket();
 #ifdef ACE_LACKS_SENDMSG
   ACE_UNUSED_ARG(stop);
   char buffer[0x10000];
@@ -128,7 +159,37 @@ RtpsUdpReceiveStrategy::receive_bytes(iovec iov[],
   }
   const ssize_t ret = (scatter < 0) ? scatter : (iter - buffer);
 #else
-  const ssize_t ret = receive_bytes_helper(iov, n, socket, remote_address, link_->get_ice_endpoint(), stop);
+  ssize_t ret;
+  if (io_uring_.is_open()) {
+    // fd is the ring's, which reports the datagrams of both sockets, each
+    // with its own kernel timestamp.  The transmit timestamps stay on the
+    // sockets' error queues, which the reactor no longer watches.
+    KernelTimestamps& unicast_timestamps = link_->unicast_timestamps();
+    KernelTimestamps& multicast_timestamps = link_->multicast_timestamps();
+    if (unicast_timestamps.enabled() || multicast_timestamps.enabled()) {
+      if (unicast_timestamps.enabled()) {
+        unicast_timestamps.collect_send_timestamps(link_->unicast_socket().get_handle(),
+                                                   *link_->latency());
+      }
+      if (multicast_timestamps.enabled()) {
+        multicast_timestamps.collect_send_timestamps(link_->multicast_socket().get_handle(),
+                                                     *link_->latency());
+      }
+    }
+    ret = receive_bytes_helper(iov, n, link_->unicast_socket(), remote_address,
+                               link_->get_ice_endpoint(), stop,
+                               unicast_timestamps.enabled() ? &unicast_timestamps
+                                                            : &multicast_timestamps,
+                               &kernel_receive_time_, &io_uring_);
+  } else {
+    KernelTimestamps& timestamps =
+      unicast ? link_->unicast_timestamps() : link_->multicast_timestamps();
+    if (timestamps.enabled()) {
+      timestamps.collect_send_timestamps(socket.get_handle(), *link_->latency());
+    }
+    ret = receive_bytes_helper(iov, n, socket, remote_address, link_->get_ice_endpoint(), stop,
+                               &timestamps, &kernel_receive_time_);
+  }
 #endif
   remote_address_ = remote_address;
 
@@ -432,6 +493,7 @@ RtpsUdpReceiveStrategy::deliver_from_secure(const RTPS::Submessage& submessage)
   RtpsSampleHeader rsh(mb);
   if (check_header(rsh)) {
     ReceivedDataSample plain_sample(mb.duplicate());
+    plain_sample.kernel_receive_time_ = kernel_receive_time_;
     if (rsh.into_received_data_sample(plain_sample)) {
       deliver_sample_i(plain_sample, rsh.submessage_);
     }
@@ -566,6 +628,23 @@ RtpsUdpReceiveStrategy::start_i()
   link_->unicast_socket().control(SIO_UDP_CONNRESET, &recv_udp_connreset);
 #endif
 
+  // STUN messages for ICE need the local address of each datagram, which
+  // only the reactor path provides.
+  if (link_->config().use_io_uring_ && !link_->get_ice_endpoint()) {
+    if (io_uring_.open(link_->config().io_uring_buffers_, IoUringReceiver::DATAGRAM_BUFFER_SIZE)
+        && io_uring_.add(link_->unicast_socket().get_handle(), false)
+        && (!link_->config().use_multicast_
+            || io_uring_.add(link_->multicast_socket().get_handle(), false))
+        && reactor->register_handler(io_uring_.get_handle(), this,
+                                     ACE_Event_Handler::READ_MASK) == 0) {
+      return 0;
+    }
+    ACE_ERROR((LM_WARNING,
+               ACE_TEXT("(%P|%t) WARNING: RtpsUdpReceiveStrategy::start_i: ")
+               ACE_TEXT("io_uring unavailable, receiving through the reactor\n")));
+    io_uring_.close();
+  }
+
   if (reactor->register_handler(link_->unicast_socket().get_handle(), this,
                                 ACE_Event_Handler::READ_MASK) != 0) {
     ACE_ERROR_RETURN((LM_ERROR,
@@ -603,6 +682,15 @@ RtpsUdpReceiveStrategy::stop_i()
     return;
   }
 
+  if (io_uring_.is_open()) {
+    reactor->remove_handler(io_uring_.get_handle(), ACE_Event_Handler::READ_MASK);
+    VDBG_LVL((LM_DEBUG, ACE_TEXT("(%P|%t) RtpsUdpReceiveStrategy[%@]::stop_i: ")
+              ACE_TEXT("io_uring completions: %B system calls: %B\n"),
+              this, io_uring_.completions(), io_uring_.syscalls()), 1);
+    io_uring_.close();
+    return;
+  }
+
   reactor->remove_handler(link_->unicast_socket().get_handle(),
                           ACE_Event_Handler::READ_MASK);
 
@@ -13,6 +13,8 @@
 #include "RtpsSampleHeader.h"
 
 #include "dds/DCPS/transport/framework/TransportReceiveStrategy_T.h"
+#include "dds/DCPS/transport/framework/IoUringReceiver.h"
+#include "dds/DCPS/transport/framework/KernelTimestamps.h"
 
 #include "dds/DCPS/RTPS/RtpsCoreC.h"
 #include "dds/DCPS/RcEventHandler.h"
@@ -68,12 +70,18 @@ public:
   const ReceivedDataSample* withhold_data_from(const RepoId& sub_id);
   void do_not_withhold_data_from(const RepoId& sub_id);
 
+  /// Receive from @a socket, or from @a io_uring when it is not null.
+  /// If @a timestamps is enabled, also set @a kernel_receive_time to the
+  /// datagram's kernel receive timestamp.
   static ssize_t receive_bytes_helper(iovec iov[],
                                       int n,
                                       const ACE_SOCK_Dgram& socket,
                                       ACE_INET_Addr& remote_address,
                                       ICE::Endpoint* endpoint,
-                                      bool& stop);
+                                      bool& stop,
+                                      KernelTimestamps* timestamps = 0,
+                                      ACE_Time_Value* kernel_receive_time = 0,
+                                      IoUringReceiver* io_uring = 0);
 
 private:
   virtual ssize_t receive_bytes(iovec iov[],
@@ -145,6 +153,9 @@ private:
   MessageReceiver receiver_;
   ACE_INET_Addr remote_address_;
 
+  /// Receives from both sockets when the io_uring option is set.
+  IoUringReceiver io_uring_;
+
 #if defined(OPENDDS_SECURITY)
   RTPS::SecuritySubmessage secure_prefix_;
   OPENDDS_VECTOR(RTPS::Submessage) secure_submessages_;
@@ -21,6 +21,8 @@
 
 #include "dds/DdsDcpsGuidTypeSupportImpl.h"
 
+#include "ace/OS_NS_sys_time.h"
+
 #include <cstring>
 
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
@@ -222,7 +224,13 @@ RtpsUdpSendStrategy::send_single_i(const iovec iov[], int n,
   }
   const ssize_t result = link_->unicast_socket().send(buffer, iter - buffer, addr);
 #else
+  KernelTimestamps& timestamps = link_->unicast_timestamps();
+  const ACE_Time_Value called =
+    timestamps.enabled() ? ACE_OS::gettimeofday() : ACE_Time_Value::zero;
   const ssize_t result = link_->unicast_socket().send(iov, n, addr);
+  if (result >= 0) {
+    timestamps.sent(called);
+  }
 #endif
   if (result < 0) {
     ACE_TCHAR addr_buff[256] = {};
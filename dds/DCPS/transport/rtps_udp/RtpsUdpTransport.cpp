@@ -21,6 +21,7 @@
 
 #include "ace/CDR_Base.h"
 #include "ace/Log_Msg.h"
+#include "ace/OS_NS_sys_time.h"
 #include "ace/Sock_Connect.h"
 
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
@@ -462,11 +463,15 @@ RtpsUdpTransport::IceEndpoint::send(const ACE_INET_Addr& destination, const STUN
 
   iovec iov[MAX_SEND_BLOCKS];
   const int num_blocks = RtpsUdpSendStrategy::mb_to_iov(block, iov);
+  const ACE_Time_Value called = ACE_OS::gettimeofday();
   const ssize_t result = send_single_i(socket, iov, num_blocks, destination);
   if (result < 0) {
     const ACE_Log_Priority prio = shouldWarn(errno) ? LM_WARNING : LM_ERROR;
     ACE_ERROR((prio, "(%P|%t) RtpsUdpTransport::send() - "
                "failed to send STUN message\n"));
+  } else if (!transport.link_.is_nil()) {
+    // Keep the link's count of sent datagrams in step with the kernel's.
+    transport.link_->unicast_timestamps().sent(called);
   }
 }
 
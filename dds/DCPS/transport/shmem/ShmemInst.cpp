@@ -25,6 +25,9 @@ ShmemInst::ShmemInst(const std::string& name)
   : TransportInst("shmem", name)
   , pool_size_(16 * 1024 * 1024)
   , datalink_control_size_(4 * 1024)
+  , pool_huge_pages_(false)
+  , pool_prefault_(false)
+  , pool_numa_node_(-1)
   , hostname_(get_fully_qualified_hostname())
 {
   std::ostringstream pool;
@@ -48,6 +51,9 @@ ShmemInst::load(ACE_Configuration_Heap& cf,
   GET_CONFIG_VALUE(cf, sect, ACE_TEXT("pool_size"), pool_size_, size_t)
   GET_CONFIG_VALUE(cf, sect, ACE_TEXT("datalink_control_size"),
                    datalink_control_size_, size_t)
+  GET_CONFIG_VALUE(cf, sect, ACE_TEXT("pool_huge_pages"), pool_huge_pages_, bool)
+  GET_CONFIG_VALUE(cf, sect, ACE_TEXT("pool_prefault"), pool_prefault_, bool)
+  GET_CONFIG_VALUE(cf, sect, ACE_TEXT("pool_numa_node"), pool_numa_node_, int)
   return 0;
 }
 
@@ -57,7 +63,10 @@ ShmemInst::dump_to_str() const
   std::ostringstream os;
   os << TransportInst::dump_to_str() << std::endl;
   os << formatNameForDump("pool_size") << pool_size_ << "\n"
-     << formatNameForDump("datalink_control_size") << datalink_control_size_
+     << formatNameForDump("datalink_control_size") << datalink_control_size_ << "\n"
+     << formatNameForDump("pool_huge_pages") << (pool_huge_pages_ ? "true" : "false") << "\n"
+     << formatNameForDump("pool_prefault") << (pool_prefault_ ? "true" : "false") << "\n"
+     << formatNameForDump("pool_numa_node") << pool_numa_node_
      << std::endl;
   return OPENDDS_STRING(os.str());
 }
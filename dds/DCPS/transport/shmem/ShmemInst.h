@@ -35,6 +35,23 @@ public:
   /// Defaults to 4 kilobytes.
   size_t datalink_control_size_;
 
+  /// Request that the pool be backed by (transparent) huge pages.  Only
+  /// supported on Linux, where it requires transparent huge pages to be
+  /// enabled for shared memory (/sys/kernel/mm/transparent_hugepage/shmem_enabled
+  /// set to "advise" or "always").  Defaults to false.
+  bool pool_huge_pages_;
+
+  /// Touch every page of the pool when the transport is configured so that
+  /// page faults are taken at startup instead of on the data path.
+  /// Defaults to false.
+  bool pool_prefault_;
+
+  /// NUMA node that the pool's pages are bound to (Linux only).  This should
+  /// normally be the node that hosts the CPUs running the receiving
+  /// application.  Defaults to -1, which leaves the kernel's placement
+  /// policy unchanged.
+  int pool_numa_node_;
+
   bool is_reliable() const { return true; }
 
   virtual size_t populate_locator(OpenDDS::DCPS::TransportLocator& trans_info) const;
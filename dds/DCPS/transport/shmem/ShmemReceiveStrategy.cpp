@@ -7,6 +7,7 @@
 
 #include "ShmemReceiveStrategy.h"
 #include "ShmemDataLink.h"
+#include "ShmemTransport.h"
 
 #include "dds/DCPS/transport/framework/TransportHeader.h"
 
@@ -18,7 +19,8 @@ namespace OpenDDS {
 namespace DCPS {
 
 ShmemReceiveStrategy::ShmemReceiveStrategy(ShmemDataLink* link)
-  : link_(link)
+  : TransportReceiveStrategy<>(link->impl().config())
+  , link_(link)
   , current_data_(0)
   , partial_recv_remaining_(0)
   , partial_recv_ptr_(0)
@@ -110,7 +112,7 @@ ShmemReceiveStrategy::receive_bytes(iovec iov[],
   } else {
     remaining = TransportHeader::get_length(current_data_->transport_header_);
     const size_t hdr_sz = sizeof(current_data_->transport_header_);
-    // BUFFER_LOW_WATER in the framework ensures a large enough buffer
+    // receive_buffer_low_water in the framework ensures a large enough buffer
     if (static_cast<size_t>(iov[0].iov_len) <= hdr_sz) {
       VDBG_LVL((LM_ERROR, "(%P|%t) ERROR: ShmemReceiveStrategy::receive_bytes "
                 "receive buffer of length %d is too small\n",
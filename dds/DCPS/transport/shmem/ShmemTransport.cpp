@@ -15,9 +15,17 @@
 #include "dds/DCPS/transport/framework/TransportExceptions.h"
 
 #include "ace/Log_Msg.h"
+#include "ace/OS_NS_unistd.h"
+
+#if defined ACE_LINUX && defined OPENDDS_SHMEM_UNIX
+#  include <sys/mman.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#endif
 
 #include <sstream>
 #include <cstring>
+#include <vector>
 
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
@@ -125,6 +133,10 @@ ShmemTransport::configure_i(ShmemInst& config)
     new ShmemAllocator(ACE_TEXT_CHAR_TO_TCHAR(config.poolname().c_str()),
                        0 /*lock_name is optional*/, &alloc_opts));
 
+  if (!tune_pool(config)) {
+    return false;
+  }
+
   void* mem = alloc_->malloc(sizeof(ShmemSharedSemaphore));
   if (mem == 0) {
     ACE_ERROR_RETURN((LM_ERROR, ACE_TEXT("(%P|%t) ERROR: ")
@@ -170,6 +182,95 @@ ShmemTransport::configure_i(ShmemInst& config)
 #endif // ifdef OPENDDS_SHMEM_UNSUPPORTED
 }
 
+#if defined ACE_LINUX && defined OPENDDS_SHMEM_UNIX && defined SYS_mbind
+#  define OPENDDS_SHMEM_HAS_MBIND
+namespace {
+  // Values from <numaif.h>, which is part of libnuma and not always installed.
+  const int SHMEM_MPOL_BIND = 2;
+  const unsigned int SHMEM_MPOL_MF_MOVE = 1 << 1;
+}
+#endif
+
+bool
+ShmemTransport::tune_pool(const ShmemInst& config)
+{
+  if (!config.pool_huge_pages_ && !config.pool_prefault_
+      && config.pool_numa_node_ < 0) {
+    return true;
+  }
+
+#if defined OPENDDS_SHMEM_UNSUPPORTED
+  return true;
+#else
+  const size_t page = static_cast<size_t>(ACE_OS::getpagesize());
+  char* const base = static_cast<char*>(alloc_->base_addr());
+  const size_t size = config.pool_size_ - config.pool_size_ % page;
+  if (base == 0 || size == 0) {
+    ACE_ERROR_RETURN((LM_ERROR, ACE_TEXT("(%P|%t) ERROR: ")
+                      ACE_TEXT("ShmemTransport::tune_pool: ")
+                      ACE_TEXT("pool is not mapped\n")),
+                     false);
+  }
+
+  if (config.pool_huge_pages_) {
+#  if defined ACE_LINUX && defined MADV_HUGEPAGE
+    if (::madvise(base, size, MADV_HUGEPAGE) != 0) {
+      ACE_ERROR((LM_WARNING, ACE_TEXT("(%P|%t) WARNING: ")
+                 ACE_TEXT("ShmemTransport::tune_pool: madvise(MADV_HUGEPAGE) ")
+                 ACE_TEXT("failed for pool %C: %p\n"),
+                 config.poolname().c_str(), ACE_TEXT("madvise")));
+    }
+#  else
+    ACE_ERROR((LM_WARNING, ACE_TEXT("(%P|%t) WARNING: ")
+               ACE_TEXT("ShmemTransport::tune_pool: pool_huge_pages ")
+               ACE_TEXT("is not supported on this platform\n")));
+#  endif
+  }
+
+  if (config.pool_numa_node_ >= 0) {
+#  ifdef OPENDDS_SHMEM_HAS_MBIND
+    const unsigned long bits = 8 * sizeof(unsigned long);
+    const unsigned long node = static_cast<unsigned long>(config.pool_numa_node_);
+    std::vector<unsigned long> mask(node / bits + 1, 0ul);
+    mask[node / bits] = 1ul << (node % bits);
+    // maxnode is the number of bits in the mask plus one (see mbind(2))
+    if (::syscall(SYS_mbind, base, size, SHMEM_MPOL_BIND, &mask[0],
+                  mask.size() * bits + 1, SHMEM_MPOL_MF_MOVE) != 0) {
+      ACE_ERROR_RETURN((LM_ERROR, ACE_TEXT("(%P|%t) ERROR: ")
+                        ACE_TEXT("ShmemTransport::tune_pool: could not bind ")
+                        ACE_TEXT("pool %C to NUMA node %d: %p\n"),
+                        config.poolname().c_str(), config.pool_numa_node_,
+                        ACE_TEXT("mbind")),
+                       false);
+    }
+#  else
+    ACE_ERROR((LM_WARNING, ACE_TEXT("(%P|%t) WARNING: ")
+               ACE_TEXT("ShmemTransport::tune_pool: pool_numa_node ")
+               ACE_TEXT("is not supported on this platform\n")));
+#  endif
+  }
+
+  if (config.pool_prefault_) {
+    // The start of the pool holds the allocator's control block, so writing
+    // to the pages is not an option.  Reading through a volatile pointer is
+    // enough to populate the page tables; binding and huge page advice above
+    // have to come first so the faults are satisfied with the right pages.
+    volatile const char* p = base;
+    char sink = 0;
+    for (size_t offset = 0; offset < size; offset += page) {
+      sink ^= p[offset];
+    }
+    ACE_UNUSED_ARG(sink);
+  }
+
+  VDBG_LVL((LM_DEBUG, "(%P|%t) ShmemTransport::tune_pool: pool %C (%B bytes) "
+            "huge_pages %d prefault %d numa_node %d\n",
+            config.poolname().c_str(), size, config.pool_huge_pages_,
+            config.pool_prefault_, config.pool_numa_node_), 2);
+  return true;
+#endif
+}
+
 void
 ShmemTransport::shutdown_i()
 {
@@ -50,6 +50,10 @@ protected:
 
   bool configure_i(ShmemInst& config);
 
+  /// Apply the huge page, NUMA binding and pre-fault options from the
+  /// configuration to the pool owned by alloc_.
+  bool tune_pool(const ShmemInst& config);
+
   virtual void shutdown_i();
 
   virtual bool connection_info_i(TransportLocator& info) const;
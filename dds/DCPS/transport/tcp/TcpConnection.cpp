@@ -12,13 +12,16 @@
 #include "TcpDataLink.h"
 #include "TcpReceiveStrategy.h"
 #include "TcpSendStrategy.h"
-#include "TcpReconnectTask.h"
 #include "dds/DCPS/transport/framework/DirectPriorityMapper.h"
 #include "dds/DCPS/transport/framework/PriorityKey.h"
 
 #include "ace/os_include/netinet/os_tcp.h"
+#include "ace/ACE.h"
 #include "ace/OS_NS_arpa_inet.h"
+#include "ace/OS_NS_stdlib.h"
+#include "ace/OS_NS_sys_time.h"
 #include "ace/OS_NS_unistd.h"
+#include <cstdlib>
 #include <sstream>
 #include <string>
 
@@ -41,20 +44,31 @@ OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 // completes to when the reconnect request is dequeued.
 const ACE_Time_Value reconnect_delay(2);
 
+namespace {
+  // Timer argument that distinguishes the start of a reconnect from the
+  // timers used while reconnecting (see TcpConnection::handle_timeout()).
+  const int start_reconnect = 0;
+}
+
 OpenDDS::DCPS::TcpConnection::TcpConnection()
   : connected_(false)
   , is_connector_(false)
   , tcp_config_(0)
   , passive_reconnect_timer_id_(-1)
+  , reconnect_timer_id_(-1)
+  , reconnect_attempts_(0)
+  , reconnect_delay_msec_(0)
+  , jitter_seed_(0)
+  , connect_pending_(false)
   , reconnect_state_(INIT_STATE)
   , last_reconnect_attempted_(ACE_Time_Value::zero)
   , transport_priority_(0)  // TRANSPORT_PRIORITY.value default value - 0.
+  , stripe_(0)
   , shutdown_(false)
   , passive_setup_(false)
   , passive_setup_buffer_(sizeof(ACE_UINT32))
   , transport_during_setup_(0)
   , id_(0)
-  , reconnect_thread_(0)
 {
   DBG_ENTRY_LVL("TcpConnection","TcpConnection",6);
 
@@ -63,36 +77,42 @@ OpenDDS::DCPS::TcpConnection::TcpConnection()
 
 OpenDDS::DCPS::TcpConnection::TcpConnection(const ACE_INET_Addr& remote_address,
                                             Priority priority,
-                                            const TcpInst& config)
+                                            const TcpInst& config,
+                                            unsigned int stripe)
   : connected_(false)
   , is_connector_(true)
   , remote_address_(remote_address)
   , local_address_(config.local_address())
   , tcp_config_(&config)
   , passive_reconnect_timer_id_(-1)
+  , reconnect_timer_id_(-1)
+  , reconnect_attempts_(0)
+  , reconnect_delay_msec_(0)
+  , jitter_seed_(0)
+  , connect_pending_(false)
   , reconnect_state_(INIT_STATE)
   , last_reconnect_attempted_(ACE_Time_Value::zero)
   , transport_priority_(priority)
+  , stripe_(stripe)
   , shutdown_(false)
   , passive_setup_(false)
   , transport_during_setup_(0)
   , id_(0)
-  , reconnect_thread_(0)
 {
   DBG_ENTRY_LVL("TcpConnection","TcpConnection",6);
   this->reference_counting_policy().value(ACE_Event_Handler::Reference_Counting_Policy::ENABLED);
 
+  // Seed the reconnect jitter so that processes (and connections) that
+  // lose their peers together do not retry in lockstep.
+  const ACE_Time_Value now = ACE_OS::gettimeofday();
+  this->jitter_seed_ = static_cast<unsigned int>(now.usec()) ^
+    static_cast<unsigned int>(ACE_OS::getpid() << 16) ^
+    static_cast<unsigned int>(reinterpret_cast<size_t>(this)) ^
+    remote_address.get_port_number();
 }
 OpenDDS::DCPS::TcpConnection::~TcpConnection()
 {
   DBG_ENTRY_LVL("TcpConnection","~TcpConnection",6);
-  if (reconnect_thread_ &&
-    // This is for Windows, where join doesn't check if the thread is the same
-    // and the thread will hang itself if it tries to join itself.
-    !ACE_OS::thr_equal(ACE_OS::thr_self(), reconnect_thread_)
-  ) {
-    ACE_Thread_Manager::instance()->join(reconnect_thread_);
-  }
 }
 
 OpenDDS::DCPS::TcpSendStrategy_rch
@@ -107,6 +127,13 @@ OpenDDS::DCPS::TcpConnection::receive_strategy()
   return this->link_->receive_strategy();
 }
 
+ACE_Reactor*
+OpenDDS::DCPS::TcpConnection::link_reactor()
+{
+  TcpReceiveStrategy_rch receive_strategy = this->receive_strategy();
+  return receive_strategy ? receive_strategy->get_reactor() : this->link_->impl().reactor();
+}
+
 void
 OpenDDS::DCPS::TcpConnection::disconnect()
 {
@@ -114,8 +141,7 @@ OpenDDS::DCPS::TcpConnection::disconnect()
   this->connected_ = false;
   TcpReceiveStrategy_rch receive_strategy = this->receive_strategy();
   if (receive_strategy) {
-    receive_strategy->get_reactor()->remove_handler(this,
-                                                    ACE_Event_Handler::READ_MASK | ACE_Event_Handler::DONT_CALL);
+    receive_strategy->deregister_connection(this);
   }
 
   if (this->link_) {
@@ -140,7 +166,7 @@ OpenDDS::DCPS::TcpConnection::open(void* arg)
 
     const bool is_loop(local_address_ == remote_address_);
     const PriorityKey key(transport_priority_, remote_address_,
-                          is_loop, true /* active */);
+                          is_loop, true /* active */, stripe_);
 
     int active_open_ = active_open();
 
@@ -230,21 +256,24 @@ OpenDDS::DCPS::TcpConnection::handle_setup_input(ACE_HANDLE /*h*/)
   }
 
   passive_setup_buffer_.wr_ptr(ret);
-  // Parse the setup message: <len><addr><prio>
-  // len and prio are network order 32-bit ints
+  // Parse the setup message: <len><addr><prio>[<stripe>]
+  // len, prio and stripe are network order 32-bit ints
   // addr is a string of length len, including null
+  // stripe is only present if the transport uses more than one stripe
   ACE_UINT32 nlen = 0;
+  const bool striped = tcp_config_->conn_stripes_ > 1;
+  const size_t trailer = (striped ? 2 : 1) * sizeof(ACE_UINT32);
 
   if (passive_setup_buffer_.length() >= sizeof(nlen)) {
 
     ACE_OS::memcpy(&nlen, passive_setup_buffer_.rd_ptr(), sizeof(nlen));
     passive_setup_buffer_.rd_ptr(sizeof(nlen));
     ACE_UINT32 hlen = ntohl(nlen);
-    passive_setup_buffer_.size(hlen + 2 * sizeof(nlen));
+    passive_setup_buffer_.size(hlen + sizeof(nlen) + trailer);
 
     ACE_UINT32 nprio = 0;
 
-    if (passive_setup_buffer_.length() >= hlen + sizeof(nprio)) {
+    if (passive_setup_buffer_.length() >= hlen + trailer) {
 
       const std::string bufstr(passive_setup_buffer_.rd_ptr());
       const NetworkAddress network_order_address(bufstr);
@@ -253,6 +282,13 @@ OpenDDS::DCPS::TcpConnection::handle_setup_input(ACE_HANDLE /*h*/)
       ACE_OS::memcpy(&nprio, passive_setup_buffer_.rd_ptr() + hlen, sizeof(nprio));
       transport_priority_ = ntohl(nprio);
 
+      if (striped) {
+        ACE_UINT32 nstripe = 0;
+        ACE_OS::memcpy(&nstripe, passive_setup_buffer_.rd_ptr() + hlen + sizeof(nprio),
+                       sizeof(nstripe));
+        stripe_ = ntohl(nstripe);
+      }
+
       passive_setup_buffer_.reset();
       passive_setup_ = false;
 
@@ -293,13 +329,37 @@ OpenDDS::DCPS::TcpConnection::handle_input(ACE_HANDLE fd)
     return 0;
   }
 
-  return receive_strategy->handle_dds_input(fd);
+  // Zero-copy completions on the error queue also make the handle readable.
+  TcpSendStrategy_rch send_strategy = this->send_strategy();
+  if (send_strategy && send_strategy->reap_zerocopy_completions()
+      && ACE::handle_read_ready(fd, &ACE_Time_Value::zero) != 1) {
+    return 0;
+  }
+
+  int result = receive_strategy->handle_dds_input(fd);
+
+  // A single wakeup for the io_uring can carry a chunk of data in each of
+  // its buffers.
+  const size_t max_batch = this->link_->impl().config().io_uring_buffers_;
+  for (size_t i = 0; i < max_batch && result >= 0 && receive_strategy->receive_pending(); ++i) {
+    result = receive_strategy->handle_dds_input(fd);
+  }
+  return result;
 }
 
 int
 OpenDDS::DCPS::TcpConnection::handle_output(ACE_HANDLE)
 {
   DBG_ENTRY_LVL("TcpConnection","handle_output",6);
+
+  if (!this->connected_.value()) {
+    GuardType guard(this->reconnect_lock_);
+    if (this->connect_pending_) {
+      this->complete_reconnect_attempt_i();
+      return 0;
+    }
+  }
+
   TcpSendStrategy_rch send_strategy = this->send_strategy();
   if (send_strategy) {
     if (DCPS_debug_level > 9) {
@@ -374,7 +434,7 @@ OpenDDS::DCPS::TcpConnection::handle_close(ACE_HANDLE, ACE_Reactor_Mask)
   if (graceful) {
     this->link_->notify(DataLink::DISCONNECTED);
   } else {
-    this->spawn_reconnect_thread();
+    this->schedule_reconnect();
   }
 
   return 0;
@@ -383,6 +443,18 @@ OpenDDS::DCPS::TcpConnection::handle_close(ACE_HANDLE, ACE_Reactor_Mask)
 void
 OpenDDS::DCPS::TcpConnection::set_sock_options(const TcpInst* tcp_config)
 {
+#ifdef OPENDDS_TCP_HAS_ZEROCOPY
+  if (tcp_config->zerocopy_threshold_ > 0) {
+    int zerocopy = 1;
+    if (this->peer().set_option(SOL_SOCKET, SO_ZEROCOPY,
+                                &zerocopy, sizeof(zerocopy)) == -1) {
+      ACE_ERROR((LM_WARNING,
+                 "(%P|%t) WARNING: TcpConnection failed to set SO_ZEROCOPY, "
+                 "large packets will be copied: %m\n"));
+    }
+  }
+#endif
+
 #if defined (ACE_DEFAULT_MAX_SOCKET_BUFSIZ)
   int snd_size = ACE_DEFAULT_MAX_SOCKET_BUFSIZ;
   int rcv_size = ACE_DEFAULT_MAX_SOCKET_BUFSIZ;
@@ -474,39 +546,40 @@ OpenDDS::DCPS::TcpConnection::active_establishment(bool initiate_connect)
   // side, we need to tell the remote side about our public address.
   // It will use that as an "identifier" of sorts.  To the other
   // (passive) side, our local_address that we send here will be known
-  // as the remote_address.
-  std::string address = tcp_config_->get_public_address();
-  ACE_UINT32 len = static_cast<ACE_UINT32>(address.length()) + 1;
-
-  ACE_UINT32 nlen = htonl(len);
-
-  if (this->peer().send_n(&nlen,
-                          sizeof(ACE_UINT32)) == -1) {
-    // TBD later - Anything we are supposed to do to close the connection.
-    ACE_ERROR_RETURN((LM_ERROR,
-                      "(%P|%t) ERROR: Unable to send address string length to "
-                      "the passive side to complete the active connection "
-                      "establishment.\n"),
-                     -1);
+  // as the remote_address.  The address is followed by the priority and,
+  // with more than one stripe configured, the connection stripe.
+  const std::string address = tcp_config_->get_public_address();
+  const ACE_UINT32 len = static_cast<ACE_UINT32>(address.length()) + 1;
+  const bool send_stripe = tcp_config_->conn_stripes_ > 1;
+
+  ACE_Message_Block handshake(3 * sizeof(ACE_UINT32) + len);
+  const ACE_UINT32 nlen = htonl(len);
+  handshake.copy(reinterpret_cast<const char*>(&nlen), sizeof(ACE_UINT32));
+  handshake.copy(address.c_str(), len);
+  const ACE_UINT32 npriority = htonl(this->transport_priority_);
+  handshake.copy(reinterpret_cast<const char*>(&npriority), sizeof(ACE_UINT32));
+  if (send_stripe) {
+    const ACE_UINT32 nstripe = htonl(this->stripe_);
+    handshake.copy(reinterpret_cast<const char*>(&nstripe), sizeof(ACE_UINT32));
   }
 
-  if (this->peer().send_n(address.c_str(), len)  == -1) {
+  // A reconnect runs on the reactor thread, which must not block on a
+  // peer that stops reading.  The handshake is sent right after the
+  // connect completes, so it fits in the empty socket send buffer; if it
+  // does not, the attempt fails and the reconnect timer retries it.
+  const ACE_Time_Value* const timeout =
+    initiate_connect ? 0 : &ACE_Time_Value::zero;
+  size_t sent = 0;
+  if (this->peer().send_n(handshake.rd_ptr(), handshake.length(),
+                          timeout, &sent) == -1
+      || sent != handshake.length()) {
     // TBD later - Anything we are supposed to do to close the connection.
     ACE_ERROR_RETURN((LM_ERROR,
-                      "(%P|%t) ERROR: Unable to send our address to "
-                      "the passive side to complete the active connection "
-                      "establishment.\n"),
-                     -1);
-  }
-
-  ACE_UINT32 npriority = htonl(this->transport_priority_);
-
-  if (this->peer().send_n(&npriority, sizeof(ACE_UINT32)) == -1) {
-    // TBD later - Anything we are supposed to do to close the connection.
-    ACE_ERROR_RETURN((LM_ERROR,
-                      "(%P|%t) ERROR: Unable to send publication priority to "
-                      "the passive side to complete the active connection "
-                      "establishment.\n"),
+                      "(%P|%t) ERROR: Unable to send our address, priority%C "
+                      "to the passive side to complete the active connection "
+                      "establishment (sent %B of %B bytes).\n",
+                      send_stripe ? " and stripe" : "",
+                      sent, handshake.length()),
                      -1);
   }
 
@@ -660,6 +733,9 @@ OpenDDS::DCPS::TcpConnection::passive_reconnect_i()
 // - fourth at 2.0 (2*1.0) seconds
 // - fifth at 4.0 (2*2.0) seconds
 // - sixth at  8.0 (2*4.0) seconds
+// Each delay is randomized by conn_retry_jitter.  The attempts are
+// non-blocking connects driven by reactor timers (see handle_timeout() and
+// handle_output()), so no thread is tied up while the remote is unreachable.
 int
 OpenDDS::DCPS::TcpConnection::active_reconnect_i()
 {
@@ -711,79 +787,229 @@ OpenDDS::DCPS::TcpConnection::active_reconnect_i()
     // notify_disconnected() since the user application should get the
     // notify_lost() without delay.
 
-    double retry_delay_msec = this->tcp_config_->conn_retry_initial_delay_;
-    int ret = -1;
+    this->reconnect_state_ = ACTIVE_RECONNECTING_STATE;
+    this->reconnect_attempts_ = 0;
+    this->reconnect_delay_msec_ = this->tcp_config_->conn_retry_initial_delay_;
 
-    for (int i = 0; i < this->tcp_config_->conn_retry_attempts_; ++i) {
-      ret = this->active_establishment();
+    return this->active_reconnect_attempt_i();
+  }
 
-      if (this->shutdown_)
-        break;
+  return this->reconnect_state_ == LOST_STATE ? -1 : 0;
+}
 
-      if (ret == -1) {
-        ACE_Time_Value delay_tv(((int)retry_delay_msec)/1000,
-                                ((int)retry_delay_msec)%1000*1000);
-        ACE_OS::sleep(delay_tv);
-        retry_delay_msec *= this->tcp_config_->conn_retry_backoff_multiplier_;
+int
+OpenDDS::DCPS::TcpConnection::active_reconnect_attempt_i()
+{
+  DBG_ENTRY_LVL("TcpConnection","active_reconnect_attempt_i",6);
 
-      } else {
-        break;
-      }
-    }
+  if (this->connect_pending_) {
+    // The previous attempt did not complete before its backoff delay expired.
+    this->cancel_reconnect_attempt_i();
+    this->peer().close();
+  }
 
-    if (ret == -1) {
-      if (this->tcp_config_->conn_retry_attempts_ > 0) {
-        ACE_DEBUG((LM_DEBUG, "(%P|%t) we tried and failed to re-establish connection on transport: %C to %C:%d.\n",
-                   this->config_name().c_str(),
-                   this->remote_address_.get_host_addr(),
-                   this->remote_address_.get_port_number()));
-
-      } else {
-        ACE_DEBUG((LM_DEBUG, "(%P|%t) we did not try to re-establish connection on transport: %C to %C:%d.\n",
-                   this->config_name().c_str(),
-                   this->remote_address_.get_host_addr(),
-                   this->remote_address_.get_port_number()));
-      }
+  if (this->shutdown_)
+    return 0;
 
-      this->reconnect_state_ = LOST_STATE;
-      this->link_->notify(DataLink::LOST);
-      if (send_strategy)
-        send_strategy->terminate_send();
+  if (this->reconnect_attempts_ >= this->tcp_config_->conn_retry_attempts_) {
+    this->reconnect_failed_i();
+    return -1;
+  }
+
+  TcpTransport& transport = static_cast<TcpTransport&>(this->link_->impl());
+  if (!transport.acquire_connect_slot()) {
+    // Too many connects are already in flight for this transport: try again
+    // shortly without using up one of the attempts.
+    this->schedule_reconnect_timer_i(this->tcp_config_->conn_retry_initial_delay_);
+    return 0;
+  }
+
+  ++this->reconnect_attempts_;
+  const double delay_msec = this->reconnect_delay_msec_;
+  this->reconnect_delay_msec_ *= this->tcp_config_->conn_retry_backoff_multiplier_;
+
+  ACE_SOCK_Connector connector;
+  if (connector.connect(this->peer(), this->remote_address_, &ACE_Time_Value::zero) == 0) {
+    transport.release_connect_slot();
+    if (this->active_establishment(false /* !initiate_connect */) == 0) {
+      this->reconnected_i();
+      return 0;
+    }
+    this->connected_ = false;
+    this->peer().close();
 
+  } else if (errno == EWOULDBLOCK || errno == EINPROGRESS) {
+    // Completion (or failure) of the connect is reported as an output event.
+    ACE_Reactor* const reactor = this->link_reactor();
+    if (reactor && reactor->register_handler(this, ACE_Event_Handler::WRITE_MASK) == 0) {
+      this->connect_pending_ = true;
     } else {
-      ACE_DEBUG((LM_DEBUG, "(%P|%t) re-established connection on transport: %C to %C:%d.\n",
-                 this->config_name().c_str(),
-                 this->remote_address_.get_host_addr(),
-                 this->remote_address_.get_port_number()));
-      TcpReceiveStrategy_rch receive_strategy = this->receive_strategy();
-      if (receive_strategy->get_reactor()->register_handler(this, ACE_Event_Handler::READ_MASK) == -1) {
-        ACE_ERROR_RETURN((LM_ERROR,
-                          "(%P|%t) ERROR: OpenDDS::DCPS::TcpConnection::active_reconnect_i() can't register "
-                          "with reactor %X %p\n", this, ACE_TEXT("register_handler")),
-                         -1);
-      }
-      this->reconnect_state_ = RECONNECTED_STATE;
-      this->link_->notify(DataLink::RECONNECTED);
-      send_strategy->resume_send();
+      ACE_ERROR((LM_ERROR,
+                 ACE_TEXT("(%P|%t) ERROR: TcpConnection::active_reconnect_attempt_i, ")
+                 ACE_TEXT("%p\n"), ACE_TEXT("register_handler")));
+      transport.release_connect_slot();
+      this->peer().close();
     }
 
-    this->last_reconnect_attempted_ = ACE_OS::gettimeofday();
+  } else {
+    if (DCPS_debug_level >= 1) {
+      ACE_DEBUG((LM_DEBUG,
+                 ACE_TEXT("(%P|%t) DBG: Failed to connect. %p\n"),
+                 ACE_TEXT("connect")));
+    }
+    transport.release_connect_slot();
   }
 
-  return this->reconnect_state_ == LOST_STATE ? -1 : 0;
+  this->schedule_reconnect_timer_i(delay_msec);
+  return 0;
+}
+
+void
+OpenDDS::DCPS::TcpConnection::complete_reconnect_attempt_i()
+{
+  DBG_ENTRY_LVL("TcpConnection","complete_reconnect_attempt_i",6);
+
+  this->cancel_reconnect_attempt_i();
+
+  ACE_SOCK_Connector connector;
+  if (connector.complete(this->peer(), 0, &ACE_Time_Value::zero) == -1) {
+    if (DCPS_debug_level >= 1) {
+      ACE_DEBUG((LM_DEBUG,
+                 ACE_TEXT("(%P|%t) DBG: Failed to connect. %p\n"),
+                 ACE_TEXT("complete")));
+    }
+    // The timer for the next attempt is still scheduled.
+    return;
+  }
+
+  if (this->active_establishment(false /* !initiate_connect */) == -1) {
+    this->connected_ = false;
+    this->peer().close();
+    return;
+  }
+
+  ACE_Reactor* const reactor = this->link_reactor();
+  if (this->reconnect_timer_id_ != -1 && reactor) {
+    reactor->cancel_timer(this->reconnect_timer_id_);
+    this->reconnect_timer_id_ = -1;
+  }
+
+  this->reconnected_i();
+}
+
+void
+OpenDDS::DCPS::TcpConnection::cancel_reconnect_attempt_i()
+{
+  if (!this->connect_pending_)
+    return;
+
+  this->connect_pending_ = false;
+
+  ACE_Reactor* const reactor = this->link_reactor();
+  if (reactor) {
+    reactor->remove_handler(this, ACE_Event_Handler::WRITE_MASK | ACE_Event_Handler::DONT_CALL);
+  }
+  static_cast<TcpTransport&>(this->link_->impl()).release_connect_slot();
+}
+
+void
+OpenDDS::DCPS::TcpConnection::schedule_reconnect_timer_i(double delay_msec)
+{
+  // Spread the attempts of connections that were lost together.
+  const double jitter = this->tcp_config_->conn_retry_jitter_;
+  if (jitter > 0) {
+    delay_msec *= 1.0 + jitter *
+      (2.0 * ACE_OS::rand_r(&this->jitter_seed_) / RAND_MAX - 1.0);
+  }
+
+  ACE_Time_Value delay_tv(((int)delay_msec)/1000,
+                          ((int)delay_msec)%1000*1000);
+
+  ACE_Reactor* const reactor = this->link_reactor();
+  this->reconnect_timer_id_ = reactor ? reactor->schedule_timer(this, 0, delay_tv) : -1;
+
+  if (this->reconnect_timer_id_ == -1) {
+    ACE_ERROR((LM_ERROR,
+               ACE_TEXT("(%P|%t) ERROR: TcpConnection::schedule_reconnect_timer_i, ")
+               ACE_TEXT("%p\n"), ACE_TEXT("schedule_timer")));
+  }
+}
+
+void
+OpenDDS::DCPS::TcpConnection::reconnected_i()
+{
+  ACE_DEBUG((LM_DEBUG, "(%P|%t) re-established connection on transport: %C to %C:%d.\n",
+             this->config_name().c_str(),
+             this->remote_address_.get_host_addr(),
+             this->remote_address_.get_port_number()));
+
+  TcpReceiveStrategy_rch receive_strategy = this->receive_strategy();
+  if (!receive_strategy || receive_strategy->register_connection(this) == -1) {
+    ACE_ERROR((LM_ERROR,
+               "(%P|%t) ERROR: OpenDDS::DCPS::TcpConnection::reconnected_i() can't register "
+               "with reactor %X %p\n", this, ACE_TEXT("register_handler")));
+  }
+  this->reconnect_state_ = RECONNECTED_STATE;
+  this->link_->notify(DataLink::RECONNECTED);
+  TcpSendStrategy_rch send_strategy = this->send_strategy();
+  if (send_strategy)
+    send_strategy->resume_send();
+
+  this->last_reconnect_attempted_ = ACE_OS::gettimeofday();
+}
+
+void
+OpenDDS::DCPS::TcpConnection::reconnect_failed_i()
+{
+  if (this->tcp_config_->conn_retry_attempts_ > 0) {
+    ACE_DEBUG((LM_DEBUG, "(%P|%t) we tried and failed to re-establish connection on transport: %C to %C:%d.\n",
+               this->config_name().c_str(),
+               this->remote_address_.get_host_addr(),
+               this->remote_address_.get_port_number()));
+
+  } else {
+    ACE_DEBUG((LM_DEBUG, "(%P|%t) we did not try to re-establish connection on transport: %C to %C:%d.\n",
+               this->config_name().c_str(),
+               this->remote_address_.get_host_addr(),
+               this->remote_address_.get_port_number()));
+  }
+
+  this->reconnect_state_ = LOST_STATE;
+  this->link_->notify(DataLink::LOST);
+  TcpSendStrategy_rch send_strategy = this->send_strategy();
+  if (send_strategy)
+    send_strategy->terminate_send();
+
+  this->last_reconnect_attempted_ = ACE_OS::gettimeofday();
 }
 
 /// A timer is scheduled on acceptor side to check if a new connection
-/// is accepted after the connection is lost.
+/// is accepted after the connection is lost.  On the connector side,
+/// timers start the reconnect and each of its attempts.
 int
 OpenDDS::DCPS::TcpConnection::handle_timeout(const ACE_Time_Value &,
-                                             const void *)
+                                             const void *arg)
 {
   DBG_ENTRY_LVL("TcpConnection","handle_timeout",6);
 
+  if (arg == &start_reconnect) {
+    if (this->reconnect() == -1) {
+      this->tear_link();
+    }
+    return 0;
+  }
+
   GuardType guard(this->reconnect_lock_);
 
   switch (this->reconnect_state_) {
+  case ACTIVE_RECONNECTING_STATE:
+    this->reconnect_timer_id_ = -1;
+    if (this->active_reconnect_attempt_i() == -1) {
+      guard.release();
+      this->tear_link();
+    }
+    break;
+
   case PASSIVE_WAITING_STATE: {
     ACE_DEBUG((LM_DEBUG, "(%P|%t) TcpConnection::handle_timeout, we tried and failed to re-establish connection on transport: %C to %C:%d.\n",
                this->config_name().c_str(),
@@ -890,10 +1116,6 @@ OpenDDS::DCPS::TcpConnection::transfer(TcpConnection* connection)
                ACE_TEXT(" should NOT be called by the connector side \n")));
   }
 
-  if (reconnect_thread_) {
-      ACE_Thread_Manager::instance()->join(reconnect_thread_);
-      reconnect_thread_ = 0;
-  }
   // connection->receive_strategy_ = this->receive_strategy_;
   // connection->send_strategy_ = this->send_strategy_;
   connection->remote_address_ = this->remote_address_;
@@ -947,8 +1169,8 @@ OpenDDS::DCPS::TcpConnection::notify_lost_on_backpressure_timeout()
 
 /// This is called by TcpSendStrategy when a send fails
 /// and a reconnect should be initiated. This method
-/// suspends any sends and kicks the reconnect thread into
-/// action.
+/// suspends any sends and hands the reconnect to the
+/// reactor thread.
 void
 OpenDDS::DCPS::TcpConnection::relink_from_send(bool do_suspend)
 {
@@ -958,7 +1180,7 @@ OpenDDS::DCPS::TcpConnection::relink_from_send(bool do_suspend)
   if (do_suspend && send_strategy)
     send_strategy->suspend_send();
 
-  this->spawn_reconnect_thread();
+  this->schedule_reconnect();
 }
 
 /// This is called by TcpReceiveStrategy when a disconnect
@@ -987,6 +1209,15 @@ OpenDDS::DCPS::TcpConnection::shutdown()
   DBG_ENTRY_LVL("TcpConnection","shutdown",6);
   GuardType guard(this->reconnect_lock_);
   this->shutdown_ = true;
+
+  if (this->link_) {
+    ACE_Reactor* const reactor = this->link_reactor();
+    if (reactor) {
+      reactor->cancel_timer(this);
+      this->reconnect_timer_id_ = -1;
+    }
+    this->cancel_reconnect_attempt_i();
+  }
   ACE_Svc_Handler<ACE_SOCK_STREAM, ACE_NULL_SYNCH>::shutdown();
 
 }
@@ -1006,49 +1237,24 @@ OpenDDS::DCPS::TcpConnection::remove_reference()
 }
 
 void
-OpenDDS::DCPS::TcpConnection::spawn_reconnect_thread()
+OpenDDS::DCPS::TcpConnection::schedule_reconnect()
 {
-  DBG_ENTRY_LVL("TcpConnection","spawn_reconnect_thread",6);
+  DBG_ENTRY_LVL("TcpConnection","schedule_reconnect",6);
   GuardType guard(this->reconnect_lock_);
-  if (!shutdown_) {
-    // Make sure the associated transport_config outlives the connection object.
-    TransportInst& transport_config = this->link_->impl().config();
-    transport_config._add_ref();
-    // add the reference count to be picked up from the new thread
-    this->_add_ref();
-    if (ACE_Thread_Manager::instance()->spawn(&reconnect_thread_fun,
-                                              this,
-                                              THR_NEW_LWP|THR_JOINABLE|THR_INHERIT_SCHED,
-                                              &reconnect_thread_) == -1){
-      // we need to decrement the reference count when thread creation fails.
-      this->_remove_ref();
-      transport_config._remove_ref();
-    }
+  if (this->shutdown_ || !this->link_) {
+    return;
   }
-}
 
-ACE_THR_FUNC_RETURN
-OpenDDS::DCPS::TcpConnection::reconnect_thread_fun(void* arg)
-{
-  DBG_ENTRY_LVL("TcpConnection","reconnect_thread_fun",6);
-
-  // Ignore all signals to avoid
-  //     ERROR: <something descriptive> Interrupted system call
-  // The main thread will handle signals.
-  sigset_t set;
-  ACE_OS::sigfillset(&set);
-  ACE_OS::thr_sigsetmask(SIG_SETMASK, &set, NULL);
-
-  // Make sure the associated transport_config outlives the connection object.
-  RcHandle<TransportInst> transport_config;
-  TcpConnection_rch connection(static_cast<TcpConnection*>(arg), keep_count());
-  transport_config = RcHandle<TransportInst>(&connection->link_->impl().config(), keep_count());
-
-  if (connection->reconnect() == -1) {
-    connection->tear_link();
+  // The reactor holds a reference to us until the timer fires (see
+  // handle_timeout()), and TcpDataLink::pre_stop_i() cancels it through
+  // shutdown() before the transport goes away.
+  ACE_Reactor* const reactor = this->link_reactor();
+  if (!reactor
+      || reactor->schedule_timer(this, &start_reconnect, ACE_Time_Value::zero) == -1) {
+    ACE_ERROR((LM_ERROR,
+               ACE_TEXT("(%P|%t) ERROR: TcpConnection::schedule_reconnect, ")
+               ACE_TEXT("%p\n"), ACE_TEXT("schedule_timer")));
   }
-
-  return 0;
 }
 
 OPENDDS_STRING
@@ -1065,6 +1271,8 @@ OpenDDS::DCPS::TcpConnection::reconnect_state_string() const
     return "PASSIVE_WAITING_STATE";
   case PASSIVE_TIMEOUT_CALLED_STATE:
     return "PASSIVE_TIMEOUT_CALLED_STATE";
+  case ACTIVE_RECONNECTING_STATE:
+    return "ACTIVE_RECONNECTING_STATE";
   default:
     ACE_ERROR((LM_ERROR,
       ACE_TEXT("TcpConnection::reconnect_state_string(): ")
@@ -16,13 +16,13 @@
 #include "TcpConnection_rch.h"
 #include "TcpSendStrategy_rch.h"
 #include "TcpReceiveStrategy_rch.h"
-#include "TcpReconnectTask.h"
 #include "TcpTransport_rch.h"
 
 #include "dds/DCPS/RcObject.h"
 #include "dds/DCPS/PoolAllocator.h"
 #include "dds/DCPS/transport/framework/TransportDefs.h"
 
+#include "ace/Atomic_Op.h"
 #include "ace/SOCK_Stream.h"
 #include "ace/Svc_Handler.h"
 #include "ace/INET_Addr.h"
@@ -44,7 +44,8 @@ public:
     LOST_STATE,
     RECONNECTED_STATE,
     PASSIVE_WAITING_STATE,
-    PASSIVE_TIMEOUT_CALLED_STATE
+    PASSIVE_TIMEOUT_CALLED_STATE,
+    ACTIVE_RECONNECTING_STATE
   };
 
   /// Passive side constructor (acceptor)
@@ -53,7 +54,8 @@ public:
   /// Active side constructor (connector)
   TcpConnection(const ACE_INET_Addr& remote_address,
                 Priority priority,
-                const TcpInst& config);
+                const TcpInst& config,
+                unsigned int stripe = 0);
 
   virtual ~TcpConnection();
 
@@ -77,10 +79,16 @@ public:
   TcpSendStrategy_rch send_strategy();
   TcpReceiveStrategy_rch receive_strategy();
 
+  /// The reactor the link's receive strategy runs on, which is not
+  /// necessarily the transport's first reactor when the transport has
+  /// several reactor threads.
+  ACE_Reactor* link_reactor();
+
   /// We pass this "event" along to the receive_strategy.
   virtual int handle_input(ACE_HANDLE);
 
-  /// Handle back pressure when sending.
+  /// Handle back pressure when sending, or completion of a non-blocking
+  /// reconnect.
   virtual int handle_output(ACE_HANDLE);
 
   virtual int close(u_long);
@@ -127,6 +135,9 @@ public:
   Priority& transport_priority();
   Priority  transport_priority() const;
 
+  /// Access the connection stripe (see TcpInst::conn_stripes_).
+  unsigned int stripe() const;
+
   virtual ACE_Event_Handler::Reference_Count add_reference();
   virtual ACE_Event_Handler::Reference_Count remove_reference();
 
@@ -145,14 +156,36 @@ private:
   int passive_reconnect_i();
   int active_reconnect_on_new_association();
 
+  /// Start the next non-blocking connect of an active reconnect, or
+  /// declare the connection lost once conn_retry_attempts_ have failed.
+  /// Returns -1 if the connection is lost.
+  /// The caller needs to hold the reconnect_lock_.
+  int active_reconnect_attempt_i();
+
+  /// Finish the non-blocking connect started by active_reconnect_attempt_i()
+  /// once the reactor reports the socket writable.
+  /// The caller needs to hold the reconnect_lock_.
+  void complete_reconnect_attempt_i();
+
+  /// Drop a non-blocking connect that has not completed.
+  /// The caller needs to hold the reconnect_lock_.
+  void cancel_reconnect_attempt_i();
+
+  void reconnected_i();
+  void reconnect_failed_i();
+
+  /// Schedule the next reconnect timer after a jittered delay.
+  void schedule_reconnect_timer_i(double delay_msec);
+
   /// During the connection setup phase, the passive side sets passive_setup_,
   /// redirecting handle_input() events here (there is no recv strategy yet).
   int handle_setup_input(ACE_HANDLE h);
 
   const std::string& config_name() const;
 
-  void spawn_reconnect_thread();
-  static ACE_THR_FUNC_RETURN reconnect_thread_fun(void* conn);
+  /// Hand a lost connection to the reactor thread, which runs reconnect().
+  /// Callers may be sending threads that must not block on reconnecting.
+  void schedule_reconnect();
 
 
   typedef ACE_SYNCH_MUTEX     LockType;
@@ -188,6 +221,22 @@ private:
   /// the lost connection.
   int passive_reconnect_timer_id_;
 
+  /// The id of the scheduled timer for the next active reconnect attempt.
+  long reconnect_timer_id_;
+
+  /// Number of connects made by the current active reconnect.
+  int reconnect_attempts_;
+
+  /// Delay before the next active reconnect attempt, in milliseconds.
+  double reconnect_delay_msec_;
+
+  /// Seed for the conn_retry_jitter applied to reconnect delays.
+  unsigned int jitter_seed_;
+
+  /// A non-blocking connect is in progress and holds one of the
+  /// transport's connect slots.
+  bool connect_pending_;
+
   /// The state indicates each step of the reconnecting.
   ReconnectState reconnect_state_;
 
@@ -197,6 +246,10 @@ private:
   /// TRANSPORT_PRIORITY.value policy value.
   Priority transport_priority_;
 
+  /// Connection stripe, sent after the priority during connection setup
+  /// when the transport is configured with more than one stripe.
+  unsigned int stripe_;
+
   /// shutdown flag
   bool shutdown_;
 
@@ -206,7 +259,6 @@ private:
 
   /// Small unique identifying value.
   std::size_t id_;
-  ACE_thread_t reconnect_thread_;
 
   /// Get name of the current reconnect state as a string.
   OPENDDS_STRING reconnect_state_string() const;
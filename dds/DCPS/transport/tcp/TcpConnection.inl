@@ -62,4 +62,11 @@ OpenDDS::DCPS::TcpConnection::transport_priority() const
   return this->transport_priority_;
 }
 
+ACE_INLINE
+unsigned int
+OpenDDS::DCPS::TcpConnection::stripe() const
+{
+  return this->stripe_;
+}
+
 OPENDDS_END_VERSIONED_NAMESPACE_DECL
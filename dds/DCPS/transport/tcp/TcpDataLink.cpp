@@ -28,9 +28,11 @@ OpenDDS::DCPS::TcpDataLink::TcpDataLink(
   OpenDDS::DCPS::TcpTransport&  transport_impl,
   Priority priority,
   bool        is_loopback,
-  bool        is_active)
+  bool        is_active,
+  unsigned int stripe)
   : DataLink(transport_impl, priority, is_loopback, is_active),
     remote_address_(remote_address),
+    stripe_(stripe),
     graceful_disconnect_sent_(false),
     release_is_pending_(false)
 {
@@ -535,6 +537,14 @@ OpenDDS::DCPS::TcpDataLink::receive_strategy()
 {
   return static_rchandle_cast<OpenDDS::DCPS::TcpReceiveStrategy>(receive_strategy_);
 }
+
+ACE_Reactor*
+OpenDDS::DCPS::TcpDataLink::get_reactor()
+{
+  TcpReceiveStrategy_rch receive_strategy = this->receive_strategy();
+  return receive_strategy ? receive_strategy->get_reactor() : impl().reactor();
+}
+
 int
 OpenDDS::DCPS::TcpDataLink::make_reservation(const RepoId& remote_subscription_id,
                                              const RepoId& local_publication_id,
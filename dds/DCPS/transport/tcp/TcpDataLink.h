@@ -28,12 +28,17 @@ public:
                     TcpTransport&  transport_impl,
                     Priority           priority,
                     bool               is_loopback,
-                    bool               is_active);
+                    bool               is_active,
+                    unsigned int       stripe = 0);
   virtual ~TcpDataLink();
 
   /// Accessor for the remote address.
   const ACE_INET_Addr& remote_address() const;
 
+  /// Which of the TcpInst::conn_stripes_ connections to the remote
+  /// address this link uses.
+  unsigned int stripe() const;
+
   /// Called when an established connection object is available
   /// for this TcpDataLink.  Called by the TcpTransport's
   /// connect_datalink() method.
@@ -60,6 +65,10 @@ public:
   TcpSendStrategy_rch send_strategy();
   TcpReceiveStrategy_rch receive_strategy();
 
+  /// The reactor of the receive strategy, which serves both directions
+  /// of the link, or the transport's once the link has stopped.
+  ACE_Reactor* get_reactor();
+
   int make_reservation(const RepoId& remote_subscription_id,
                        const RepoId& local_publication_id,
                        const TransportSendListener_wrch& send_listener);
@@ -82,6 +91,7 @@ private:
   void send_association_msg(const RepoId& local, const RepoId& remote);
 
   ACE_INET_Addr           remote_address_;
+  unsigned int            stripe_;
   WeakRcHandle<TcpConnection> connection_;
   bool graceful_disconnect_sent_;
   ACE_Atomic_Op<ACE_Thread_Mutex, bool> release_is_pending_;
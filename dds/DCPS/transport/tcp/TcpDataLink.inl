@@ -18,6 +18,12 @@ OpenDDS::DCPS::TcpDataLink::remote_address() const
   return this->remote_address_;
 }
 
+ACE_INLINE unsigned int
+OpenDDS::DCPS::TcpDataLink::stripe() const
+{
+  return this->stripe_;
+}
+
 ACE_INLINE OpenDDS::DCPS::TcpConnection_rch
 OpenDDS::DCPS::TcpDataLink::get_connection()
 {
@@ -9,6 +9,7 @@
 #include "TcpInst.h"
 
 #include "dds/DCPS/transport/framework/NetworkAddress.h"
+#include "dds/DCPS/transport/framework/Compressor.h"
 
 #include "ace/Configuration.h"
 
@@ -50,6 +51,12 @@ OpenDDS::DCPS::TcpInst::load(ACE_Configuration_Heap& cf,
   GET_CONFIG_VALUE(cf, trans_sect, ACE_TEXT("enable_nagle_algorithm"),
                    this->enable_nagle_algorithm_, bool)
 
+  GET_CONFIG_VALUE(cf, trans_sect, ACE_TEXT("enable_cork"),
+                   this->enable_cork_, bool)
+
+  GET_CONFIG_VALUE(cf, trans_sect, ACE_TEXT("zerocopy_threshold"),
+                   this->zerocopy_threshold_, size_t)
+
   GET_CONFIG_VALUE(cf, trans_sect, ACE_TEXT("conn_retry_initial_delay"),
                    this->conn_retry_initial_delay_, int)
 
@@ -59,12 +66,25 @@ OpenDDS::DCPS::TcpInst::load(ACE_Configuration_Heap& cf,
   GET_CONFIG_VALUE(cf, trans_sect, ACE_TEXT("conn_retry_attempts"),
                    this->conn_retry_attempts_, int)
 
+  GET_CONFIG_DOUBLE_VALUE(cf, trans_sect, ACE_TEXT("conn_retry_jitter"),
+                   this->conn_retry_jitter_)
+
+  GET_CONFIG_VALUE(cf, trans_sect, ACE_TEXT("max_concurrent_reconnects"),
+                   this->max_concurrent_reconnects_, size_t)
+
   GET_CONFIG_VALUE(cf, trans_sect, ACE_TEXT("passive_reconnect_duration"),
                    this->passive_reconnect_duration_, int)
 
   GET_CONFIG_VALUE(cf, trans_sect, ACE_TEXT("max_output_pause_period"),
                    this->max_output_pause_period_, int)
 
+  GET_CONFIG_VALUE(cf, trans_sect, ACE_TEXT("conn_stripes"),
+                   this->conn_stripes_, size_t)
+
+  if (this->conn_stripes_ == 0) {
+    this->conn_stripes_ = 1;
+  }
+
   return 0;
 }
 
@@ -77,11 +97,16 @@ OpenDDS::DCPS::TcpInst::dump_to_str() const
   os << formatNameForDump("local_address")                 << this->local_address_string() << std::endl;
   os << formatNameForDump("pub_address")                   << this->pub_address_str_ << std::endl;
   os << formatNameForDump("enable_nagle_algorithm")        << (this->enable_nagle_algorithm_ ? "true" : "false") << std::endl;
+  os << formatNameForDump("enable_cork")                   << (this->enable_cork_ ? "true" : "false") << std::endl;
+  os << formatNameForDump("zerocopy_threshold")            << this->zerocopy_threshold_ << std::endl;
   os << formatNameForDump("conn_retry_initial_delay")      << this->conn_retry_initial_delay_ << std::endl;
   os << formatNameForDump("conn_retry_backoff_multiplier") << this->conn_retry_backoff_multiplier_ << std::endl;
   os << formatNameForDump("conn_retry_attempts")           << this->conn_retry_attempts_ << std::endl;
+  os << formatNameForDump("conn_retry_jitter")             << this->conn_retry_jitter_ << std::endl;
+  os << formatNameForDump("max_concurrent_reconnects")     << this->max_concurrent_reconnects_ << std::endl;
   os << formatNameForDump("passive_reconnect_duration")    << this->passive_reconnect_duration_ << std::endl;
   os << formatNameForDump("max_output_pause_period")       << this->max_output_pause_period_ << std::endl;
+  os << formatNameForDump("conn_stripes")                  << this->conn_stripes_ << std::endl;
   return OPENDDS_STRING(os.str());
 }
 
@@ -94,6 +119,8 @@ OpenDDS::DCPS::TcpInst::populate_locator(OpenDDS::DCPS::TransportLocator& local_
 
     ACE_OutputCDR cdr;
     cdr << network_order_address;
+    // Peers ignore what follows the address unless they can compress.
+    cdr << ACE_OutputCDR::from_octet(Compressor::available());
     const CORBA::ULong len = static_cast<CORBA::ULong>(cdr.total_length());
     char* buffer = const_cast<char*>(cdr.buffer()); // safe
 
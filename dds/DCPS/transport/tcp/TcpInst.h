@@ -42,6 +42,19 @@ public:
 
   bool enable_nagle_algorithm_;
 
+  /// Set TCP_CORK (Linux only) on the socket while queued packets are
+  /// being drained, so that small packets (for example control messages)
+  /// are coalesced into full segments.  The socket is uncorked as soon as
+  /// the queue is empty.  The default is false.
+  bool enable_cork_;
+
+  /// Packets of at least this many bytes are sent with MSG_ZEROCOPY
+  /// (Linux 4.14 or later), avoiding the copy into kernel buffers.  The
+  /// samples are reported delivered to their DataWriters only once the
+  /// kernel reports completion on the socket's error queue.  Zero, the
+  /// default, disables zero-copy sends.
+  size_t zerocopy_threshold_;
+
   /// The initial retry delay in milliseconds.
   /// The first connection retry will be when the loss of connection
   /// is detected.  The second try will be after this delay.
@@ -63,6 +76,18 @@ public:
   /// The default is 3.
   int conn_retry_attempts_;
 
+  /// Fraction of each reconnect delay that is randomized, so that
+  /// connections lost at the same moment do not retry in lockstep.
+  /// With 0.25 a 1 second delay becomes a delay between 0.75 and 1.25
+  /// seconds.  Zero disables the jitter.  The default is 0.25.
+  double conn_retry_jitter_;
+
+  /// Maximum number of non-blocking reconnect attempts that may be in
+  /// progress at once for this transport.  Connections over the limit wait
+  /// (without using up one of their conn_retry_attempts) for a slot.  Zero
+  /// means no limit.  The default is 16.
+  size_t max_concurrent_reconnects_;
+
   /// Maximum period (in milliseconds) of not being able to send queued
   /// messages. If there are samples queued and no output for longer
   /// than this period then the connection will be closed and on_*_lost()
@@ -70,6 +95,14 @@ public:
   /// this check will not be made.
   int max_output_pause_period_;
 
+  /// Number of TCP connections that a logical DataLink to a remote
+  /// transport is striped across.  Each DataWriter is pinned to one of the
+  /// connections (chosen by hashing its GUID) so that its samples stay in
+  /// order.  Both sides of an association must use the same value since
+  /// the stripe is exchanged in the connection handshake when this is
+  /// greater than one.  The default is 1 (no striping).
+  size_t conn_stripes_;
+
   /// The time period in milliseconds for the acceptor side
   /// of a connection to wait for the connection to be reconnected.
   /// If not reconnected within this period then
@@ -13,10 +13,15 @@ ACE_INLINE
 OpenDDS::DCPS::TcpInst::TcpInst(const OPENDDS_STRING& name)
   : TransportInst("tcp", name),
     enable_nagle_algorithm_(false),
+    enable_cork_(false),
+    zerocopy_threshold_(0),
     conn_retry_initial_delay_(500),
     conn_retry_backoff_multiplier_(2.0),
     conn_retry_attempts_(3),
+    conn_retry_jitter_(0.25),
+    max_concurrent_reconnects_(16),
     max_output_pause_period_(-1),
+    conn_stripes_(1),
     passive_reconnect_duration_(2000)
 {
   DBG_ENTRY_LVL("TcpInst", "TcpInst", 6);
@@ -23,8 +23,10 @@ OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 OpenDDS::DCPS::TcpReceiveStrategy::TcpReceiveStrategy(
   TcpDataLink& link,
   const ReactorTask_rch& task)
-  : link_(link)
+  : TransportReceiveStrategy<>(link.impl().config())
+  , link_(link)
   , reactor_task_(task)
+  , use_io_uring_(link.impl().config().use_io_uring_)
 {
   DBG_ENTRY_LVL("TcpReceiveStrategy","TcpReceiveStrategy",6);
 }
@@ -38,12 +40,21 @@ ssize_t
 OpenDDS::DCPS::TcpReceiveStrategy::receive_bytes(
   iovec iov[],
   int   n,
-  ACE_INET_Addr& /*remote_address*/,
+  ACE_INET_Addr& remote_address,
   ACE_HANDLE /*fd*/,
-  bool& /*stop*/)
+  bool& stop)
 {
   DBG_ENTRY_LVL("TcpReceiveStrategy", "receive_bytes", 6);
 
+  if (this->io_uring_.is_open()) {
+    const ssize_t ret = this->io_uring_.receive(iov, n, remote_address);
+    if (ret == -1 && errno == EWOULDBLOCK) {
+      stop = true;
+      return 0;
+    }
+    return ret;
+  }
+
   // We don't do anything to the remote_address for the Tcp case.
   TcpConnection_rch connection = link_.get_connection();
   if (!connection) {
@@ -95,9 +106,7 @@ OpenDDS::DCPS::TcpReceiveStrategy::start_i()
                connection->get_remote_address().get_port_number()));
   }
 
-  if (this->reactor_task_->get_reactor()->register_handler
-      (connection.in(),
-       ACE_Event_Handler::READ_MASK) == -1) {
+  if (this->register_connection(connection.in()) == -1) {
     // Take back the "copy" we made.
     ACE_ERROR_RETURN((LM_ERROR,
                       "(%P|%t) ERROR: TcpReceiveStrategy::start_i TcpConnection can't register with "
@@ -117,19 +126,14 @@ OpenDDS::DCPS::TcpReceiveStrategy::reset(TcpConnection* old_connection, TcpConne
   DBG_ENTRY_LVL("TcpReceiveStrategy","reset",6);
   // Unregister the old handle
   if (old_connection) {
-    this->reactor_task_->get_reactor()->remove_handler
-    (old_connection,
-     ACE_Event_Handler::READ_MASK |
-     ACE_Event_Handler::DONT_CALL);
+    this->deregister_connection(old_connection);
    }
 
    link_.drop_pending_request_acks();
 
   // Give the reactor its own "copy" of the reference to the connection object.
 
-  if (this->reactor_task_->get_reactor()->register_handler
-      (new_connection,
-       ACE_Event_Handler::READ_MASK) == -1) {
+  if (this->register_connection(new_connection) == -1) {
     // Take back the "copy" we made.
     ACE_ERROR_RETURN((LM_ERROR,
                       "(%P|%t) ERROR: TcpReceiveStrategy::reset TcpConnection can't register with "
@@ -140,11 +144,61 @@ OpenDDS::DCPS::TcpReceiveStrategy::reset(TcpConnection* old_connection, TcpConne
   return 0;
 }
 
+int
+OpenDDS::DCPS::TcpReceiveStrategy::register_connection(TcpConnection* connection)
+{
+  ACE_Reactor* const reactor = this->reactor_task_->get_reactor();
+
+  if (this->use_io_uring_) {
+    const TransportInst& config = link_.impl().config();
+    if ((this->io_uring_.is_open()
+         || this->io_uring_.open(config.io_uring_buffers_, RECEIVE_DATA_BUFFER_SIZE))
+        && this->io_uring_.add(connection->get_handle(), true)) {
+      return reactor->register_handler(this->io_uring_.get_handle(), connection,
+                                       ACE_Event_Handler::READ_MASK);
+    }
+    ACE_ERROR((LM_WARNING,
+               ACE_TEXT("(%P|%t) WARNING: TcpReceiveStrategy::register_connection: ")
+               ACE_TEXT("io_uring unavailable, receiving through the reactor\n")));
+    this->io_uring_.close();
+    this->use_io_uring_ = false;
+  }
+
+  return reactor->register_handler(connection, ACE_Event_Handler::READ_MASK);
+}
+
+void
+OpenDDS::DCPS::TcpReceiveStrategy::deregister_connection(TcpConnection* connection)
+{
+  ACE_Reactor* const reactor = this->reactor_task_->get_reactor();
+
+  if (this->io_uring_.is_open()) {
+    reactor->remove_handler(this->io_uring_.get_handle(),
+                            ACE_Event_Handler::READ_MASK | ACE_Event_Handler::DONT_CALL);
+    this->io_uring_.remove(connection->get_handle());
+  } else {
+    reactor->remove_handler(connection,
+                            ACE_Event_Handler::READ_MASK | ACE_Event_Handler::DONT_CALL);
+  }
+}
+
+bool
+OpenDDS::DCPS::TcpReceiveStrategy::receive_pending() const
+{
+  return this->io_uring_.pending();
+}
+
 void
 OpenDDS::DCPS::TcpReceiveStrategy::stop_i()
 {
   DBG_ENTRY_LVL("TcpReceiveStrategy","stop_i",6);
 
+  if (this->io_uring_.is_open()) {
+    VDBG_LVL((LM_DEBUG, ACE_TEXT("(%P|%t) TcpReceiveStrategy[%@]::stop_i: ")
+              ACE_TEXT("io_uring completions: %B system calls: %B\n"),
+              this, this->io_uring_.completions(), this->io_uring_.syscalls()), 1);
+  }
+
   link_.drop_pending_request_acks();
 }
 
@@ -11,6 +11,7 @@
 #include "TcpConnection_rch.h"
 #include "TcpDataLink_rch.h"
 #include "dds/DCPS/transport/framework/TransportReceiveStrategy_T.h"
+#include "dds/DCPS/transport/framework/IoUringReceiver.h"
 #include "dds/DCPS/ReactorTask_rch.h"
 #include "dds/DCPS/RcEventHandler.h"
 
@@ -34,6 +35,14 @@ public:
 
   int reset(TcpConnection* old_connection, TcpConnection* new_connection);
 
+  /// Start or stop reading @a connection with the reactor, through the
+  /// io_uring when the transport is configured to use one.
+  int register_connection(TcpConnection* connection);
+  void deregister_connection(TcpConnection* connection);
+
+  /// Is data received through the io_uring waiting to be parsed?
+  bool receive_pending() const;
+
   ACE_Reactor* get_reactor();
 
   bool gracefully_disconnected();
@@ -60,6 +69,9 @@ private:
 
   TcpDataLink& link_;
   ReactorTask_rch reactor_task_;
+
+  bool use_io_uring_;
+  IoUringReceiver io_uring_;
 };
 
 } // namespace DCPS
@@ -16,6 +16,17 @@
 #include "dds/DCPS/transport/framework/ScheduleOutputHandler.h"
 #include "dds/DCPS/ReactorTask.h"
 #include "dds/DCPS/transport/framework/ReactorSynchStrategy.h"
+#include "dds/DCPS/transport/framework/TransportQueueElement.h"
+
+#include "ace/ACE.h"
+#include "ace/OS_NS_sys_socket.h"
+
+#include <cstring>
+
+#ifdef OPENDDS_TCP_HAS_ZEROCOPY
+#  include <linux/errqueue.h>
+#  include <netinet/in.h>
+#endif
 
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
@@ -30,6 +41,10 @@ OpenDDS::DCPS::TcpSendStrategy::TcpSendStrategy(
                           make_rch<ReactorSynchStrategy>(this,task->get_reactor()))
   , link_(link)
   , reactor_task_(task)
+  , enable_cork_(static_cast<TcpTransport&>(link.impl()).config().enable_cork_)
+  , zerocopy_threshold_(static_cast<TcpTransport&>(link.impl()).config().zerocopy_threshold_)
+  , corked_(false)
+  , zerocopy_next_(0)
 {
   DBG_ENTRY_LVL("TcpSendStrategy","TcpSendStrategy",6);
 
@@ -38,6 +53,14 @@ OpenDDS::DCPS::TcpSendStrategy::TcpSendStrategy(
 OpenDDS::DCPS::TcpSendStrategy::~TcpSendStrategy()
 {
   DBG_ENTRY_LVL("TcpSendStrategy","~TcpSendStrategy",6);
+
+  // The samples still held for the kernel are released with the strategy.
+  OPENDDS_VECTOR(TransportQueueElement*) released;
+  release_all_zerocopy(released);
+  if (!released.empty()) {
+    add_delayed_notifications(released);
+    send_delayed_notifications();
+  }
 }
 
 void
@@ -76,9 +99,64 @@ OpenDDS::DCPS::TcpSendStrategy::reset(bool reset_mode)
     //reset graceful_disconnecting_ to initial state
     this->set_graceful_disconnecting(false);
   }
+  // The new connection's socket has no cork set and numbers its zero-copy
+  // notifications from zero.  The old socket is gone, so the kernel no
+  // longer references anything sent on it.
+  this->corked_ = false;
+  OPENDDS_VECTOR(TransportQueueElement*) released;
+  this->release_all_zerocopy(released);
+  if (!released.empty()) {
+    this->add_delayed_notifications(released);
+    this->send_delayed_notifications();
+  }
   return 0;
 }
 
+OpenDDS::DCPS::ThreadSynchWorker::WorkOutcome
+OpenDDS::DCPS::TcpSendStrategy::perform_work()
+{
+  DBG_ENTRY_LVL("TcpSendStrategy","perform_work",6);
+
+  if (this->enable_cork_ && !this->corked_) {
+    this->cork(true);
+  }
+
+  const WorkOutcome outcome = TransportSendStrategy::perform_work();
+
+  if (this->corked_ && outcome != WORK_OUTCOME_MORE_TO_DO) {
+    // Queue is drained (or the link is broken): push out what is left.
+    this->cork(false);
+  }
+
+  return outcome;
+}
+
+void
+OpenDDS::DCPS::TcpSendStrategy::cork(bool enable)
+{
+#ifdef OPENDDS_TCP_HAS_CORK
+  TcpConnection_rch connection = link_.get_connection();
+  if (!connection) {
+    this->corked_ = false;
+    return;
+  }
+
+  int opt = enable ? 1 : 0;
+  if (connection->peer().set_option(IPPROTO_TCP, TCP_CORK, &opt, sizeof(opt)) == -1) {
+    VDBG_LVL((LM_WARNING, ACE_TEXT("(%P|%t) WARNING: TcpSendStrategy::cork: ")
+              ACE_TEXT("failed to set TCP_CORK to %d: %p\n"),
+              opt, ACE_TEXT("set_option")), 1);
+    this->enable_cork_ = false;
+    this->corked_ = false;
+    return;
+  }
+  this->corked_ = enable;
+#else
+  ACE_UNUSED_ARG(enable);
+  this->enable_cork_ = false;
+#endif
+}
+
 ssize_t
 OpenDDS::DCPS::TcpSendStrategy::send_bytes(const iovec iov[], int n, int& bp)
 {
@@ -104,7 +182,20 @@ OpenDDS::DCPS::TcpSendStrategy::send_bytes_i(const iovec iov[], int n)
 
   if (!connection)
     return -1;
-  ssize_t result = connection->peer().sendv(iov, n);
+
+  ssize_t result;
+  const size_t zerocopy_threshold = this->zerocopy_threshold_.value();
+  if (zerocopy_threshold > 0) {
+    size_t total = 0;
+    for (int i = 0; i < n; ++i) {
+      total += iov[i].iov_len;
+    }
+    result = (total >= zerocopy_threshold)
+      ? this->send_zerocopy(connection->peer().get_handle(), iov, n)
+      : connection->peer().sendv(iov, n);
+  } else {
+    result = connection->peer().sendv(iov, n);
+  }
   if (DCPS_debug_level > 4)
     ACE_DEBUG((LM_DEBUG, "(%P|%t) TcpSendStrategy::send_bytes_i sent %d bytes \n", result));
 
@@ -122,19 +213,243 @@ OpenDDS::DCPS::TcpSendStrategy::relink(bool do_suspend)
   }
 }
 
+ssize_t
+OpenDDS::DCPS::TcpSendStrategy::send_zerocopy(ACE_HANDLE handle,
+                                              const iovec iov[], int n)
+{
+#ifdef OPENDDS_TCP_HAS_ZEROCOPY
+  this->queue_zerocopy_completions();
+
+  const ACE_Message_Block* packet = this->current_packet_chain();
+  if (packet == 0 || packet->rd_ptr() != iov[0].iov_base) {
+    // Not sending from the current packet, so there is nothing we can hold
+    // on to until the kernel is done with the data.
+    return ACE::sendv(handle, iov, n);
+  }
+
+  // The bytes must be those of the packet's blocks, which its elements
+  // keep until they are notified.
+  int mapped = 0;
+  for (const ACE_Message_Block* mb = packet; mb && mapped < n; mb = mb->cont()) {
+    if (mb->length() == 0) {
+      continue;
+    }
+    if (mb->rd_ptr() != iov[mapped].iov_base || mb->length() != iov[mapped].iov_len) {
+      break;
+    }
+    ++mapped;
+  }
+  if (mapped != n) {
+    // The iovecs do not map to the packet's blocks one to one.
+    return ACE::sendv(handle, iov, n);
+  }
+
+  if (this->zerocopy_next_ == 0) {
+    // Without SO_ZEROCOPY the kernel silently copies and never notifies,
+    // so the held elements would never be released.
+    int enabled = 0;
+    int len = sizeof enabled;
+    if (ACE_OS::getsockopt(handle, SOL_SOCKET, SO_ZEROCOPY,
+                           reinterpret_cast<char*>(&enabled), &len) == -1
+        || !enabled) {
+      this->zerocopy_threshold_ = 0;
+      return ACE::sendv(handle, iov, n);
+    }
+  }
+
+  msghdr msg;
+  std::memset(&msg, 0, sizeof msg);
+  msg.msg_iov = const_cast<iovec*>(iov);
+  msg.msg_iovlen = n;
+
+  const ssize_t result = ::sendmsg(handle, &msg, MSG_ZEROCOPY);
+  if (result > 0) {
+    // Once the packet is sent its header block goes back to the allocator
+    // for the next packet's header, so it is held here; the elements hold
+    // the rest of the blocks.
+    const ACE_Message_Block* const header = this->current_packet_header();
+    ACE_Message_Block* const held =
+      (header && header->data_block() == packet->data_block()) ? header->duplicate() : 0;
+
+    // Each successful call is assigned the next notification id.
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, this->zerocopy_lock_, result);
+    this->zerocopy_pending_[this->zerocopy_next_++] = held;
+  }
+  return result;
+#else
+  this->zerocopy_threshold_ = 0;
+  return ACE::sendv(handle, iov, n);
+#endif
+}
+
+bool
+OpenDDS::DCPS::TcpSendStrategy::reap_zerocopy_completions()
+{
+  OPENDDS_VECTOR(TransportQueueElement*) released;
+  const bool found = this->reap_zerocopy(released);
+  if (!released.empty()) {
+    this->add_delayed_notifications(released);
+    this->send_delayed_notifications();
+  }
+  return found;
+}
+
+void
+OpenDDS::DCPS::TcpSendStrategy::queue_zerocopy_completions()
+{
+  // lock_ is held, so the notifications are issued with the other delayed
+  // notifications once the send is done.
+  OPENDDS_VECTOR(TransportQueueElement*) released;
+  this->reap_zerocopy(released);
+  for (size_t i = 0; i < released.size(); ++i) {
+    TransportSendStrategy::add_delayed_notification(released[i]);
+  }
+}
+
+bool
+OpenDDS::DCPS::TcpSendStrategy::reap_zerocopy(OPENDDS_VECTOR(TransportQueueElement*)& released)
+{
+#ifdef OPENDDS_TCP_HAS_ZEROCOPY
+  if (this->zerocopy_threshold_.value() == 0) {
+    return false;
+  }
+
+  const ACE_HANDLE handle = this->get_handle();
+  if (handle == ACE_INVALID_HANDLE) {
+    return false;
+  }
+
+  bool found = false;
+  char control[CMSG_SPACE(sizeof(sock_extended_err)) + CMSG_SPACE(sizeof(sockaddr_in6))];
+  while (true) {
+    msghdr msg;
+    std::memset(&msg, 0, sizeof msg);
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof control;
+
+    if (::recvmsg(handle, &msg, MSG_ERRQUEUE | MSG_DONTWAIT) == -1) {
+      break;
+    }
+
+    for (cmsghdr* cm = CMSG_FIRSTHDR(&msg); cm; cm = CMSG_NXTHDR(&msg, cm)) {
+      if (!((cm->cmsg_level == SOL_IP && cm->cmsg_type == IP_RECVERR)
+            || (cm->cmsg_level == SOL_IPV6 && cm->cmsg_type == IPV6_RECVERR))) {
+        continue;
+      }
+      const sock_extended_err* err =
+        reinterpret_cast<const sock_extended_err*>(CMSG_DATA(cm));
+      if (err->ee_errno == 0 && err->ee_origin == SO_EE_ORIGIN_ZEROCOPY) {
+        found = true;
+        this->release_zerocopy(err->ee_info, err->ee_data, released);
+      }
+    }
+  }
+  return found;
+#else
+  ACE_UNUSED_ARG(released);
+  return false;
+#endif
+}
+
+ACE_UINT64
+OpenDDS::DCPS::TcpSendStrategy::zerocopy_send(ACE_UINT32 id) const
+{
+  // The notification ids wrap around, but the sends in flight are among
+  // the last 2^32.
+  const ACE_UINT64 last = this->zerocopy_next_ - 1;
+  return last - static_cast<ACE_UINT32>(static_cast<ACE_UINT32>(last) - id);
+}
+
+void
+OpenDDS::DCPS::TcpSendStrategy::release_zerocopy(ACE_UINT32 low, ACE_UINT32 high,
+                                                 OPENDDS_VECTOR(TransportQueueElement*)& released)
+{
+  ACE_GUARD(ACE_Thread_Mutex, guard, this->zerocopy_lock_);
+
+  // The range is inclusive and may wrap around the 32-bit id space.
+  const ACE_UINT64 first = this->zerocopy_send(low);
+  const ACE_UINT64 last = first + static_cast<ACE_UINT32>(high - low);
+  const ZeroCopyMap::iterator begin = this->zerocopy_pending_.lower_bound(first);
+  const ZeroCopyMap::iterator end = this->zerocopy_pending_.upper_bound(last);
+  for (ZeroCopyMap::iterator it = begin; it != end; ++it) {
+    if (it->second) {
+      it->second->release();
+    }
+  }
+  this->zerocopy_pending_.erase(begin, end);
+
+  // An element may have been sent in part by any send up to the one it is
+  // held for.
+  while (!this->zerocopy_held_.empty()
+         && (this->zerocopy_pending_.empty()
+             || this->zerocopy_held_.front().first < this->zerocopy_pending_.begin()->first)) {
+    released.push_back(this->zerocopy_held_.front().second);
+    this->zerocopy_held_.pop_front();
+  }
+}
+
+void
+OpenDDS::DCPS::TcpSendStrategy::release_all_zerocopy(OPENDDS_VECTOR(TransportQueueElement*)& released)
+{
+  ACE_GUARD(ACE_Thread_Mutex, guard, this->zerocopy_lock_);
+  for (ZeroCopyMap::iterator it = this->zerocopy_pending_.begin();
+       it != this->zerocopy_pending_.end(); ++it) {
+    if (it->second) {
+      it->second->release();
+    }
+  }
+  this->zerocopy_pending_.clear();
+  this->zerocopy_next_ = 0;
+
+  for (size_t i = 0; i < this->zerocopy_held_.size(); ++i) {
+    released.push_back(this->zerocopy_held_[i].second);
+  }
+  this->zerocopy_held_.clear();
+}
+
 void
 OpenDDS::DCPS::TcpSendStrategy::stop_i()
 {
   DBG_ENTRY_LVL("TcpSendStrategy","stop_i",6);
+  this->queue_zerocopy_completions();
 }
 
 void
 OpenDDS::DCPS::TcpSendStrategy::add_delayed_notification(TransportQueueElement* element)
 {
-  if (!element->is_request_ack()) {
+  if (element->is_request_ack()) {
     // only add the notification when we are not sending REQUEST_ACK message
-    TransportSendStrategy::add_delayed_notification(element);
+    return;
+  }
+
+  {
+    ACE_GUARD(ACE_Thread_Mutex, guard, this->zerocopy_lock_);
+    if (!this->zerocopy_pending_.empty()) {
+      // The DataWriter frees the element's blocks once it is notified, but
+      // the last zero-copy send may have been from them.
+      this->zerocopy_held_.push_back(std::make_pair(this->zerocopy_next_ - 1, element));
+      return;
+    }
+  }
+  TransportSendStrategy::add_delayed_notification(element);
+}
+
+OpenDDS::DCPS::RemoveResult
+OpenDDS::DCPS::TcpSendStrategy::do_remove_sample(const RepoId& pub_id,
+  const TransportQueueElement::MatchCriteria& criteria)
+{
+  // Removing the element at the front of a partly sent packet releases it,
+  // but a zero-copy send may have been from its blocks, which the kernel
+  // reads until it is done (and retransmits from).  It is left to be sent
+  // and notified instead.
+  TransportQueueElement* const first = this->current_packet_first_element();
+  if (first && criteria.matches(*first)) {
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, this->zerocopy_lock_, REMOVE_ERROR);
+    if (!this->zerocopy_pending_.empty()) {
+      return REMOVE_NOT_FOUND;
+    }
   }
+  return TransportSendStrategy::do_remove_sample(pub_id, criteria);
 }
 
 OPENDDS_END_VERSIONED_NAMESPACE_DECL
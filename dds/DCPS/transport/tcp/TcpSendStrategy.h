@@ -14,6 +14,21 @@
 #include "TcpConnection_rch.h"
 #include "dds/DCPS/transport/framework/TransportSendStrategy.h"
 #include "dds/DCPS/ReactorTask_rch.h"
+#include "dds/DCPS/PoolAllocator.h"
+
+#include "ace/Atomic_Op.h"
+#include "ace/Thread_Mutex.h"
+
+#if defined ACE_LINUX
+#  include <sys/socket.h>
+#  if defined MSG_ZEROCOPY && defined SO_ZEROCOPY
+#    define OPENDDS_TCP_HAS_ZEROCOPY
+#  endif
+#  include <netinet/tcp.h>
+#  if defined TCP_CORK
+#    define OPENDDS_TCP_HAS_CORK
+#  endif
+#endif
 
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
@@ -41,6 +56,15 @@ public:
   /// Enable or disable output processing by the reactor according to mode.
   virtual void schedule_output();
 
+  /// Corks the socket (if enable_cork is configured) for as long as there
+  /// are queued packets to send.
+  virtual WorkOutcome perform_work();
+
+  /// Drain the socket's error queue of MSG_ZEROCOPY completion
+  /// notifications and issue the delivery notifications of the samples
+  /// they release.  Returns true if any notification was found.
+  bool reap_zerocopy_completions();
+
 protected:
 
   virtual ssize_t send_bytes(const iovec iov[], int n, int& bp);
@@ -52,10 +76,60 @@ protected:
   virtual void relink(bool do_suspend = true);
 
   virtual void stop_i();
+
+  /// Holds back the notification of an element sent while MSG_ZEROCOPY
+  /// sends are pending, until the kernel is done with them.
   virtual void add_delayed_notification(TransportQueueElement* element);
+
+  virtual RemoveResult do_remove_sample(const RepoId& pub_id,
+    const TransportQueueElement::MatchCriteria& criteria);
+
 private:
+  /// Send the current packet with MSG_ZEROCOPY.  Its elements are held by
+  /// add_delayed_notification(), and its header here, until the kernel is
+  /// done with them.
+  ssize_t send_zerocopy(ACE_HANDLE handle, const iovec iov[], int n);
+
+  /// Drain the error queue, adding the elements that are released to
+  /// @a released.
+  bool reap_zerocopy(OPENDDS_VECTOR(TransportQueueElement*)& released);
+
+  /// Reap the completions with lock_ held, queueing the released elements
+  /// for the delayed notifications.
+  void queue_zerocopy_completions();
+
+  ACE_UINT64 zerocopy_send(ACE_UINT32 id) const;
+  void release_zerocopy(ACE_UINT32 low, ACE_UINT32 high,
+                        OPENDDS_VECTOR(TransportQueueElement*)& released);
+  void release_all_zerocopy(OPENDDS_VECTOR(TransportQueueElement*)& released);
+
+  void cork(bool enable);
+
   TcpDataLink& link_;
   ReactorTask_rch reactor_task_;
+
+  /// Copies of the TcpInst settings.  zerocopy_threshold_ is reset to 0
+  /// when the socket turns out not to support SO_ZEROCOPY.
+  bool enable_cork_;
+  ACE_Atomic_Op<ACE_Thread_Mutex, size_t> zerocopy_threshold_;
+
+  /// True while TCP_CORK is set on the socket.
+  bool corked_;
+
+  /// The MSG_ZEROCOPY sends the kernel may still be reading from, keyed
+  /// by their number on the connection, whose low 32 bits are the
+  /// notification id the kernel assigns to each zero-copy send call.
+  /// Each holds the packet header it sent, if any.
+  typedef OPENDDS_MAP(ACE_UINT64, ACE_Message_Block*) ZeroCopyMap;
+  ZeroCopyMap zerocopy_pending_;
+  ACE_UINT64 zerocopy_next_;
+
+  /// Elements sent while zero-copy sends were pending, with the last send
+  /// they may have taken part in.  They are released, in order, once it
+  /// and the sends before it are done.
+  typedef std::pair<ACE_UINT64, TransportQueueElement*> ZeroCopyElement;
+  OPENDDS_DEQUE(ZeroCopyElement) zerocopy_held_;
+  ACE_Thread_Mutex zerocopy_lock_;
 };
 
 } // namespace DCPS
@@ -25,6 +25,8 @@
 #include "dds/DCPS/Service_Participant.h"
 #include "dds/DCPS/transport/framework/TransportClient.h"
 
+#include "ace/ACE.h"
+
 #include <sstream>
 
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
@@ -36,6 +38,7 @@ TcpTransport::TcpTransport(TcpInst& inst)
   : TransportImpl(inst)
   , acceptor_(new TcpAcceptor(this))
   , con_checker_(new TcpConnectionReplaceTask(this))
+  , connects_in_progress_(0)
 {
   DBG_ENTRY_LVL("TcpTransport","TcpTransport",6);
 
@@ -62,12 +65,53 @@ TcpTransport::config() const
 PriorityKey
 TcpTransport::blob_to_key(const TransportBLOB& remote,
                           Priority priority,
-                          bool active)
+                          bool active,
+                          unsigned int stripe)
 {
   const ACE_INET_Addr remote_address =
     AssociationData::get_remote_address(remote);
   const bool is_loopback = remote_address == config().local_address();
-  return PriorityKey(priority, remote_address, is_loopback, active);
+  // With send lanes, writers of every TRANSPORT_PRIORITY share one
+  // connection and its send queue orders their samples instead.
+  if (config().send_lanes_ > 1) {
+    priority = 0;
+  }
+  return PriorityKey(priority, remote_address, is_loopback, active, stripe);
+}
+
+unsigned int
+TcpTransport::stripe_for(const RepoId& local_id, const RepoId& remote_id) const
+{
+  const size_t stripes = config().conn_stripes_;
+  if (stripes <= 1) {
+    return 0;
+  }
+  // Both sides of the association see the same writer GUID, so both
+  // compute the same stripe.
+  const RepoId& writer = GuidConverter(local_id).isWriter() ? local_id : remote_id;
+  return static_cast<unsigned int>(
+    ACE::hash_pjw(reinterpret_cast<const char*>(&writer), sizeof writer) % stripes);
+}
+
+bool
+TcpTransport::acquire_connect_slot()
+{
+  const size_t limit = config().max_concurrent_reconnects_;
+  GuardType guard(connect_slots_lock_);
+  if (limit && connects_in_progress_ >= limit) {
+    return false;
+  }
+  ++connects_in_progress_;
+  return true;
+}
+
+void
+TcpTransport::release_connect_slot()
+{
+  GuardType guard(connect_slots_lock_);
+  if (connects_in_progress_) {
+    --connects_in_progress_;
+  }
 }
 
 TransportImpl::AcceptConnectResult
@@ -78,7 +122,8 @@ TcpTransport::connect_datalink(const RemoteTransport& remote,
   DBG_ENTRY_LVL("TcpTransport", "connect_datalink", 6);
 
   const PriorityKey key =
-    blob_to_key(remote.blob_, attribs.priority_, true /*active*/);
+    blob_to_key(remote.blob_, attribs.priority_, true /*active*/,
+                stripe_for(attribs.local_id_, remote.repo_id_));
 
   VDBG_LVL((LM_DEBUG, "(%P|%t) TcpTransport::connect_datalink PriorityKey "
             "prio=%d, addr=%C:%hu, is_loopback=%d, is_active=%d\n",
@@ -97,8 +142,9 @@ TcpTransport::connect_datalink(const RemoteTransport& remote,
         : AcceptConnectResult(link);
     }
 
-    link = make_rch<TcpDataLink>(key.address(), ref(*this), attribs.priority_,
-                                key.is_loopback(), true /*active*/);
+    link = make_rch<TcpDataLink>(key.address(), ref(*this), key.priority(),
+                                key.is_loopback(), true /*active*/, key.stripe());
+    link->negotiate_compression(remote.blob_);
     VDBG_LVL((LM_DEBUG, "(%P|%t) TcpTransport::connect_datalink create new link[%@]\n", link.in()), 0);
     if (links_.bind(key, link) != 0 /*OK*/) {
       ACE_ERROR((LM_ERROR, "(%P|%t) ERROR: TcpTransport::connect_datalink "
@@ -109,7 +155,8 @@ TcpTransport::connect_datalink(const RemoteTransport& remote,
   }
 
   TcpConnection_rch connection(
-    make_rch<TcpConnection>(key.address(), link->transport_priority(), this->config()));
+    make_rch<TcpConnection>(key.address(), link->transport_priority(), this->config(),
+                            link->stripe()));
   connection->set_datalink(link);
 
   TcpConnection* pConn = connection.in();
@@ -241,7 +288,8 @@ TcpTransport::accept_datalink(const RemoteTransport& remote,
 
   GuardType guard(connections_lock_);
   const PriorityKey key =
-    blob_to_key(remote.blob_, attribs.priority_, false /* !active */);
+    blob_to_key(remote.blob_, attribs.priority_, false /* !active */,
+                stripe_for(attribs.local_id_, remote.repo_id_));
 
   VDBG_LVL((LM_DEBUG, "(%P|%t) TcpTransport::accept_datalink PriorityKey "
             "prio=%d, addr=%C:%hu, is_loopback=%d, is_active=%d\n", attribs.priority_,
@@ -259,7 +307,8 @@ TcpTransport::accept_datalink(const RemoteTransport& remote,
 
     } else {
       link = make_rch<TcpDataLink>(key.address(), ref(*this), key.priority(),
-                                  key.is_loopback(), key.is_active());
+                                  key.is_loopback(), key.is_active(), key.stripe());
+      link->negotiate_compression(remote.blob_);
 
       if (links_.bind(key, link) != 0 /*OK*/) {
         ACE_ERROR((LM_ERROR,
@@ -507,7 +556,8 @@ TcpTransport::release_datalink(DataLink* link)
     tcp_link->transport_priority(),
     tcp_link->remote_address(),
     tcp_link->is_loopback(),
-    tcp_link->is_active());
+    tcp_link->is_active(),
+    tcp_link->stripe());
 
   VDBG_LVL((LM_DEBUG,
             "(%P|%t) TcpTransport::release_datalink link[%@] PriorityKey "
@@ -604,7 +654,8 @@ TcpTransport::passive_connection(const ACE_INET_Addr& remote_address,
   const PriorityKey key(connection->transport_priority(),
                         remote_address,
                         remote_address == config().local_address(),
-                        connection->is_connector());
+                        connection->is_connector(),
+                        connection->stripe());
 
   VDBG_LVL((LM_DEBUG, ACE_TEXT("(%P|%t) TcpTransport::passive_connection() - ")
             ACE_TEXT("established with %C:%d.\n"),
@@ -678,14 +729,21 @@ TcpTransport::connect_tcp_datalink(TcpDataLink& link,
 
   connection->id() = last_link_;
 
+  // Both directions of a link are served by the same reactor thread,
+  // chosen by the remote endpoint so that the links of a transport with
+  // several reactor threads are spread across them.
+  ReactorTask_rch task =
+    this->reactor_task(link.remote_address().hash() + link.stripe() +
+                       size_t(link.transport_priority()));
+
   TcpSendStrategy_rch send_strategy (
     make_rch<TcpSendStrategy>(last_link_, ref(link),
                              new TcpSynchResource(link,
                                                   this->config().max_output_pause_period_),
-                             this->reactor_task(), link.transport_priority()));
+                             task, link.transport_priority()));
 
   TcpReceiveStrategy_rch receive_strategy(
-    make_rch<TcpReceiveStrategy>(ref(link), this->reactor_task()));
+    make_rch<TcpReceiveStrategy>(ref(link), task));
 
   if (link.connect(connection, send_strategy, receive_strategy) != 0) {
     return -1;
@@ -694,7 +752,7 @@ TcpTransport::connect_tcp_datalink(TcpDataLink& link,
   return 0;
 }
 
-/// This function is called by the TcpReconnectTask thread to check if the passively
+/// This function is called by the TcpConnectionReplaceTask thread to check if the passively
 /// accepted connection is the re-established connection. If it is, then the "old" connection
 /// object in the datalink is replaced by the "new" connection object.
 int
@@ -708,7 +766,8 @@ TcpTransport::fresh_link(TcpConnection_rch connection)
   PriorityKey key(connection->transport_priority(),
                   connection->get_remote_address(),
                   connection->get_remote_address() == this->config().local_address(),
-                  connection->is_connector());
+                  connection->is_connector(),
+                  connection->stripe());
 
   if (this->links_.find(key, link) == 0) {
     TcpConnection_rch old_con = link->get_connection();
@@ -748,7 +807,8 @@ TcpTransport::unbind_link(DataLink* link)
     tcp_link->transport_priority(),
     tcp_link->remote_address(),
     tcp_link->is_loopback(),
-    tcp_link->is_active());
+    tcp_link->is_active(),
+    tcp_link->stripe());
 
   VDBG_LVL((LM_DEBUG,
             "(%P|%t) TcpTransport::unbind_link link %@ PriorityKey "
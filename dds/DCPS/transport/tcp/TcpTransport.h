@@ -106,7 +106,17 @@ private:
 
   PriorityKey blob_to_key(const TransportBLOB& remote,
                           Priority priority,
-                          bool active);
+                          bool active,
+                          unsigned int stripe);
+
+  /// Select the connection stripe for an association: the DataWriter's
+  /// GUID is hashed so that all of its samples use the same connection.
+  unsigned int stripe_for(const RepoId& local_id, const RepoId& remote_id) const;
+
+  /// Reserve one of the TcpInst::max_concurrent_reconnects_ slots for a
+  /// non-blocking reconnect.  Returns false if they are all in use.
+  bool acquire_connect_slot();
+  void release_connect_slot();
 
   /// Map Type: (key) PriorityKey to (value) TcpDataLink_rch
   typedef ACE_Hash_Map_Manager_Ex
@@ -159,9 +169,13 @@ private:
 
   /// This task is used to resolve some deadlock situation
   /// during reconnecting.
-  /// TODO: reuse the reconnect_task in the TcpConnection
-  ///       for new connection checking.
   unique_ptr<TcpConnectionReplaceTask> con_checker_;
+
+  /// Number of reconnect attempts currently in progress.
+  size_t connects_in_progress_;
+
+  /// This protects the connects_in_progress_ data member.
+  LockType connect_slots_lock_;
 };
 
 } // namespace DCPS
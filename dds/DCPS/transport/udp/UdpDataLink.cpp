@@ -256,6 +256,9 @@ UdpDataLink::open(const ACE_INET_Addr& remote_address)
     }
   }
 
+  // After the handshake, which is not numbered by the kernel.
+  enable_kernel_timestamps(this->timestamps_, this->socket_.get_handle());
+
   if (start(static_rchandle_cast<TransportSendStrategy>(this->send_strategy_),
             static_rchandle_cast<TransportStrategy>(this->recv_strategy_))
       != 0) {
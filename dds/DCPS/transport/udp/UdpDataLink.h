@@ -20,6 +20,7 @@
 #include "ace/SOCK_Dgram.h"
 
 #include "dds/DCPS/transport/framework/DataLink.h"
+#include "dds/DCPS/transport/framework/KernelTimestamps.h"
 #include "dds/DCPS/ReactorTask.h"
 
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
@@ -49,6 +50,10 @@ public:
 
   ACE_SOCK_Dgram& socket();
 
+  /// Kernel timestamps of the datagrams of socket(), if the transport
+  /// sets kernel_timestamps.
+  KernelTimestamps& timestamps();
+
   bool open(const ACE_INET_Addr& remote_address);
 
   void control_received(ReceivedDataSample& sample,
@@ -68,6 +73,8 @@ private:
   ACE_INET_Addr remote_address_;
 
   ACE_SOCK_Dgram socket_;
+
+  KernelTimestamps timestamps_;
 };
 
 } // namespace DCPS
@@ -42,6 +42,12 @@ UdpDataLink::socket()
   return this->socket_;
 }
 
+ACE_INLINE KernelTimestamps&
+UdpDataLink::timestamps()
+{
+  return this->timestamps_;
+}
+
 } // namespace DCPS
 } // namespace OpenDDS
 
@@ -10,6 +10,7 @@
 
 #include "dds/DCPS/transport/framework/TransportDefs.h"
 #include "dds/DCPS/transport/framework/NetworkAddress.h"
+#include "dds/DCPS/transport/framework/Compressor.h"
 
 #include "ace/Configuration.h"
 
@@ -85,6 +86,8 @@ UdpInst::populate_locator(OpenDDS::DCPS::TransportLocator& info) const
     }
     ACE_OutputCDR cdr;
     cdr << network_address;
+    // Peers ignore what follows the address unless they can compress.
+    cdr << ACE_OutputCDR::from_octet(Compressor::available());
 
     const CORBA::ULong len = static_cast<CORBA::ULong>(cdr.total_length());
     char* buffer = const_cast<char*>(cdr.buffer()); // safe
@@ -7,6 +7,7 @@
 
 #include "UdpReceiveStrategy.h"
 #include "UdpDataLink.h"
+#include "UdpTransport.h"
 
 #include "ace/Reactor.h"
 
@@ -16,7 +17,8 @@ namespace OpenDDS {
 namespace DCPS {
 
 UdpReceiveStrategy::UdpReceiveStrategy(UdpDataLink* link)
-  : link_(link)
+  : TransportReceiveStrategy<>(link->impl().config())
+  , link_(link)
   , expected_(SequenceNumber::SEQUENCENUMBER_UNKNOWN())
 {
 }
@@ -24,6 +26,9 @@ UdpReceiveStrategy::UdpReceiveStrategy(UdpDataLink* link)
 ACE_HANDLE
 UdpReceiveStrategy::get_handle() const
 {
+  if (this->io_uring_.is_open()) {
+    return this->io_uring_.get_handle();
+  }
   ACE_SOCK_Dgram& socket = this->link_->socket();
   return socket.get_handle();
 }
@@ -31,7 +36,14 @@ UdpReceiveStrategy::get_handle() const
 int
 UdpReceiveStrategy::handle_input(ACE_HANDLE fd)
 {
-  return this->handle_dds_input(fd);
+  int result = this->handle_dds_input(fd);
+
+  // A single wakeup for the io_uring can carry many datagrams.
+  const size_t max_batch = this->link_->impl().config().io_uring_buffers_;
+  for (size_t i = 0; i < max_batch && result >= 0 && this->io_uring_.pending(); ++i) {
+    result = this->handle_dds_input(fd);
+  }
+  return result;
 }
 
 ssize_t
@@ -39,8 +51,33 @@ UdpReceiveStrategy::receive_bytes(iovec iov[],
                                   int n,
                                   ACE_INET_Addr& remote_address,
                                   ACE_HANDLE /*fd*/,
-                                  bool& /*stop*/)
+                                  bool& stop)
 {
+  if (this->io_uring_.is_open()) {
+    const ssize_t ret = this->io_uring_.receive(iov, n, remote_address);
+    if (ret == -1 && errno == EWOULDBLOCK) {
+      stop = true;
+      return 0;
+    }
+    remote_address_ = remote_address;
+    return ret;
+  }
+
+  KernelTimestamps& timestamps = this->link_->timestamps();
+  if (timestamps.enabled()) {
+    const ACE_HANDLE handle = this->link_->socket().get_handle();
+    timestamps.collect_send_timestamps(handle, *this->link_->latency());
+    const ssize_t ret = timestamps.recv(handle, iov, n, remote_address,
+                                        this->kernel_receive_time_);
+    if (ret == -1 && errno == EWOULDBLOCK) {
+      // Only transmit timestamps were waiting.
+      stop = true;
+      return 0;
+    }
+    remote_address_ = remote_address;
+    return ret;
+  }
+
   const ssize_t ret = this->link_->socket().recv(iov, n, remote_address);
   remote_address_ = remote_address;
   return ret;
@@ -74,6 +111,16 @@ UdpReceiveStrategy::start_i()
                      -1);
   }
 
+  const TransportInst& config = this->link_->impl().config();
+  if (config.use_io_uring_
+      && !(this->io_uring_.open(config.io_uring_buffers_, IoUringReceiver::DATAGRAM_BUFFER_SIZE)
+           && this->io_uring_.add(this->link_->socket().get_handle(), false))) {
+    ACE_ERROR((LM_WARNING,
+               ACE_TEXT("(%P|%t) WARNING: UdpReceiveStrategy::start_i: ")
+               ACE_TEXT("io_uring unavailable, receiving through the reactor\n")));
+    this->io_uring_.close();
+  }
+
   if (reactor->register_handler(this, ACE_Event_Handler::READ_MASK) != 0) {
     ACE_ERROR_RETURN((LM_ERROR,
                       ACE_TEXT("(%P|%t) ERROR: ")
@@ -105,6 +152,13 @@ UdpReceiveStrategy::stop_i()
   }
 
   reactor->remove_handler(this, ACE_Event_Handler::READ_MASK);
+
+  if (this->io_uring_.is_open()) {
+    VDBG_LVL((LM_DEBUG, ACE_TEXT("(%P|%t) UdpReceiveStrategy[%@]::stop_i: ")
+              ACE_TEXT("io_uring completions: %B system calls: %B\n"),
+              this, this->io_uring_.completions(), this->io_uring_.syscalls()), 1);
+    this->io_uring_.close();
+  }
 }
 
 bool
@@ -13,6 +13,7 @@
 #include "ace/INET_Addr.h"
 
 #include "dds/DCPS/transport/framework/TransportReceiveStrategy_T.h"
+#include "dds/DCPS/transport/framework/IoUringReceiver.h"
 #include "dds/DCPS/RcEventHandler.h"
 
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
@@ -58,6 +59,9 @@ private:
 
   UdpDataLink* link_;
   SequenceNumber expected_;
+
+  /// Used instead of reading the socket when the io_uring option is set.
+  IoUringReceiver io_uring_;
   ACE_INET_Addr remote_address_; // of the current datagram
 
   typedef std::pair<TransportReassembly, SequenceNumber> ReassemblyInfo;
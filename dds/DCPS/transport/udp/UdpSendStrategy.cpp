@@ -10,6 +10,8 @@
 #include "UdpInst.h"
 #include "dds/DCPS/transport/framework/NullSynchStrategy.h"
 
+#include "ace/OS_NS_sys_time.h"
+
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
 namespace OpenDDS {
@@ -28,7 +30,17 @@ ssize_t
 UdpSendStrategy::send_bytes_i(const iovec iov[], int n)
 {
   ACE_SOCK_Dgram& socket = this->link_->socket();
-  return socket.send(iov, n, this->link_->remote_address());
+  KernelTimestamps& timestamps = this->link_->timestamps();
+  if (!timestamps.enabled()) {
+    return socket.send(iov, n, this->link_->remote_address());
+  }
+
+  const ACE_Time_Value called = ACE_OS::gettimeofday();
+  const ssize_t result = socket.send(iov, n, this->link_->remote_address());
+  if (result >= 0) {
+    timestamps.sent(called);
+  }
+  return result;
 }
 
 void
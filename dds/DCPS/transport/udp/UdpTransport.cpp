@@ -13,6 +13,7 @@
 
 #include "ace/CDR_Base.h"
 #include "ace/Log_Msg.h"
+#include "ace/OS_NS_sys_time.h"
 
 #include "dds/DCPS/transport/framework/NetworkAddress.h"
 #include "dds/DCPS/transport/framework/PriorityKey.h"
@@ -44,7 +45,7 @@ UdpDataLink_rch
 UdpTransport::make_datalink(const ACE_INET_Addr& remote_address,
                             Priority priority, bool active)
 {
-  ReactorTask_rch rtask (reactor_task());
+  ReactorTask_rch rtask (reactor_task(remote_address.hash() + size_t(priority)));
   UdpDataLink_rch link(make_rch<UdpDataLink>(ref(*this), priority, rtask.in(), active));
   // Configure link with transport configuration and reactor task:
 
@@ -91,6 +92,7 @@ UdpTransport::connect_datalink(const RemoteTransport& remote,
                                        active));
 
   if (!link.is_nil()) {
+    link->negotiate_compression(remote.blob_);
     client_links_.insert(UdpDataLinkMap::value_type(key, link));
     VDBG((LM_DEBUG, "(%P|%t) UdpTransport::connect_datalink connected\n"));
   }
@@ -267,8 +269,11 @@ UdpTransport::passive_connection(const ACE_INET_Addr& remote_address,
   // framework (TransportHeader, DataSampleHeader,
   // ReceiveStrategy).
   const char ack_data = 23;
+  const ACE_Time_Value called = ACE_OS::gettimeofday();
   if (server_link_->socket().send(&ack_data, 1, remote_address) <= 0) {
     VDBG((LM_DEBUG, "(%P|%t) UdpTransport::passive_connection failed to send ack\n"));
+  } else {
+    server_link_->timestamps().sent(called);
   }
 
   const PriorityKey key = blob_to_key(blob, priority, config().local_address(), false /* passive */);
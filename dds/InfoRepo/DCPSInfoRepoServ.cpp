@@ -14,6 +14,7 @@
 #include "ShutdownInterface.h"
 #include "PersistenceUpdater.h"
 #include "UpdateManager.h"
+#include "WalPersistenceUpdater.h"
 
 #include "dds/DCPS/Service_Participant.h"
 #include "dds/DCPS/InfoRepoDiscovery/InfoRepoDiscovery.h"
@@ -36,10 +37,29 @@
 #include "ace/Arg_Shifter.h"
 #include "ace/Service_Config.h"
 #include "ace/Argv_Type_Converter.h"
+#include "ace/Thread_Manager.h"
 
 #include <string>
 #include <sstream>
 
+namespace {
+
+ACE_THR_FUNC_RETURN run_orb(void* arg)
+{
+  CORBA::ORB_ptr orb = static_cast<CORBA::ORB_ptr>(arg);
+
+  try {
+    orb->run();
+
+  } catch (const CORBA::Exception& ex) {
+    ex._tao_print_exception("ERROR: InfoRepo ORB thread:");
+  }
+
+  return 0;
+}
+
+}
+
 InfoRepo::InfoRepo(int argc, ACE_TCHAR *argv[])
 : ior_file_(ACE_TEXT("repo.ior"))
 , listen_address_given_(0)
@@ -57,6 +77,8 @@ InfoRepo::InfoRepo(int argc, ACE_TCHAR *argv[])
 , cond_(lock_)
 , shutdown_complete_(false)
 , dispatch_cleanup_delay_(30,0)
+, num_threads_(1)
+, batch_associations_(false)
 {
   try {
     this->init();
@@ -75,7 +97,21 @@ void
 InfoRepo::run()
 {
   this->shutdown_complete_ = false;
+
+  // Requests for different domains are handled in parallel by the
+  // additional threads.
+  ACE_Thread_Manager orb_threads;
+
+  if (this->num_threads_ > 1 &&
+      orb_threads.spawn_n(this->num_threads_ - 1, run_orb, this->orb_.in()) == -1) {
+    ACE_ERROR((LM_ERROR,
+               ACE_TEXT("(%P|%t) ERROR: InfoRepo::run: ")
+               ACE_TEXT("failed to start %d ORB threads %p\n"),
+               this->num_threads_ - 1, ACE_TEXT("spawn_n")));
+  }
+
   this->orb_->run();
+  orb_threads.wait();
   this->finalize();
   ACE_GUARD(ACE_Thread_Mutex, g, this->lock_);
   this->shutdown_complete_ = true;
@@ -159,6 +195,9 @@ InfoRepo::usage(const ACE_TCHAR* cmd)
              ACE_TEXT("    -FederateWith <ior> federate initially with object at <ior>\n")
              ACE_TEXT("    -ReassociateDelay <msec> delay between reassociations\n")
              ACE_TEXT("    -DispatchingCheckDelay <sec> delay between checks for cleaning up dispatching connections.\n")
+             ACE_TEXT("    -NumThreads <n> number of threads handling requests, by default 1\n")
+             ACE_TEXT("    -BatchAssociations send the matches of a new writer or reader in one call,\n")
+             ACE_TEXT("                       only if all participants support add_associations\n")
              ACE_TEXT("    -?\n")
              ACE_TEXT("\n"),
              cmd));
@@ -210,6 +249,19 @@ InfoRepo::parse_args(int argc, ACE_TCHAR *argv[])
       this->dispatch_cleanup_delay_.sec(sec);
       arg_shifter.consume_arg();
 
+    } else if ((current_arg = arg_shifter.get_the_parameter(ACE_TEXT("-NumThreads"))) != 0) {
+      this->num_threads_ = ACE_OS::atoi(current_arg);
+
+      if (this->num_threads_ < 1) {
+        this->num_threads_ = 1;
+      }
+
+      arg_shifter.consume_arg();
+
+    } else if (arg_shifter.cur_arg_strncasecmp(ACE_TEXT("-BatchAssociations")) == 0) {
+      this->batch_associations_ = true;
+      arg_shifter.consume_arg();
+
     }
 
     // The '-?' option
@@ -261,6 +313,8 @@ InfoRepo::init()
     new TAO_DDS_DCPSInfo_i(this->orb_, this->resurrect_, this,
                            this->federatorConfig_.federationId());
 
+  this->info_servant_->batch_associations(this->batch_associations_);
+
   // Install the DCPSInfo_i into the Federator::Manager.
   this->federator_.info() = this->info_servant_.in();
 
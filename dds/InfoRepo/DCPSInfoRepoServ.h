@@ -77,6 +77,12 @@ private:
   bool shutdown_complete_;
 
   ACE_Time_Value dispatch_cleanup_delay_;
+
+  /// Number of threads running the ORB.
+  int num_threads_;
+
+  /// Send the matches of a new writer or reader in one call.
+  bool batch_associations_;
 };
 
 class OpenDDS_DCPSInfoRepoServ_Export InfoRepo_Shutdown :
@@ -44,6 +44,7 @@ TAO_DDS_DCPSInfo_i::TAO_DDS_DCPSInfo_i(CORBA::ORB_ptr orb
   , participantIdGenerator_(federation.id())
   , um_(0)
   , reincarnate_(reincarnate)
+  , batchAssociations_(false)
   , shutdown_(shutdown)
   , reassociate_timer_id_(-1)
   , dispatch_check_timer_id_(-1)
@@ -63,9 +64,9 @@ int
 TAO_DDS_DCPSInfo_i::handle_timeout(const ACE_Time_Value& /*now*/,
                                    const void* arg)
 {
-  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, this->lock_, 0);
-
   if (arg == this) {
+    ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, this->lock_, 0);
+
     if ( !CORBA::is_nil(this->dispatchingOrb_.in())){
       if (this->dispatchingOrb_->work_pending())
       {
@@ -79,10 +80,16 @@ TAO_DDS_DCPSInfo_i::handle_timeout(const ACE_Time_Value& /*now*/,
   // NOTE: This is a purposefully naive approach to addressing defunct
   // associations.  In the future, it may be worthwhile to introduce a
   // callback model to fix the heinous runtime cost below:
-  for (DCPS_IR_Domain_Map::const_iterator dom(this->domains_.begin());
-       dom != this->domains_.end(); ++dom) {
+  std::vector<DDS::DomainId_t> domainIds;
+  this->domain_ids(domainIds);
+
+  for (size_t i = 0; i < domainIds.size(); ++i) {
+    DomainGuard domain(*this, domainIds[i]);
+    if (0 == domain.domain()) {
+      continue;
+    }
 
-    const DCPS_IR_Participant_Map& participants(dom->second->participants());
+    const DCPS_IR_Participant_Map& participants(domain.domain()->participants());
     for (DCPS_IR_Participant_Map::const_iterator part(participants.begin());
          part != participants.end(); ++part) {
 
@@ -120,18 +127,17 @@ CORBA::Boolean TAO_DDS_DCPSInfo_i::attach_participant(
   DDS::DomainId_t            domainId,
   const OpenDDS::DCPS::RepoId& participantId)
 {
-  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, this->lock_, 0);
-
-  // Grab the domain.
-  DCPS_IR_Domain_Map::iterator where = this->domains_.find(domainId);
+  // Grab and lock the domain.
+  DomainGuard guard(*this, domainId);
+  DCPS_IR_Domain* const domainPtr = guard.domain();
 
-  if (where == this->domains_.end()) {
+  if (0 == domainPtr) {
     throw OpenDDS::DCPS::Invalid_Domain();
   }
 
   // Grab the participant.
   DCPS_IR_Participant* participant
-  = where->second->participant(participantId);
+  = domainPtr->participant(participantId);
 
   if (0 == participant) {
     throw OpenDDS::DCPS::Invalid_Participant();
@@ -150,18 +156,17 @@ TAO_DDS_DCPSInfo_i::changeOwnership(
   long                           sender,
   long                           owner)
 {
-  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, this->lock_, false);
-
-  // Grab the domain.
-  DCPS_IR_Domain_Map::iterator where = this->domains_.find(domainId);
+  // Grab and lock the domain.
+  DomainGuard guard(*this, domainId);
+  DCPS_IR_Domain* const domainPtr = guard.domain();
 
-  if (where == this->domains_.end()) {
+  if (0 == domainPtr) {
     return false;
   }
 
   // Grab the participant.
   DCPS_IR_Participant* participant
-  = where->second->participant(participantId);
+  = domainPtr->participant(participantId);
 
   if (0 == participant) {
     return false;
@@ -181,24 +186,24 @@ OpenDDS::DCPS::TopicStatus TAO_DDS_DCPSInfo_i::assert_topic(
   const DDS::TopicQos & qos,
   bool /*hasDcpsKey -- only used for RTPS Discovery*/)
 {
-  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, this->lock_, OpenDDS::DCPS::INTERNAL_ERROR);
-  // Grab the domain.
-  DCPS_IR_Domain_Map::iterator where = this->domains_.find(domainId);
+  // Grab and lock the domain.
+  DomainGuard guard(*this, domainId);
+  DCPS_IR_Domain* const domainPtr = guard.domain();
 
-  if (where == this->domains_.end()) {
+  if (0 == domainPtr) {
     throw OpenDDS::DCPS::Invalid_Domain();
   }
 
   // Grab the participant.
   DCPS_IR_Participant* participantPtr
-  = where->second->participant(participantId);
+  = domainPtr->participant(participantId);
 
   if (0 == participantPtr) {
     throw OpenDDS::DCPS::Invalid_Participant();
   }
 
   OpenDDS::DCPS::TopicStatus topicStatus
-  = where->second->add_topic(
+  = domainPtr->add_topic(
       topicId,
       topicName,
       dataTypeName,
@@ -231,12 +236,11 @@ TAO_DDS_DCPSInfo_i::add_topic(const OpenDDS::DCPS::RepoId& topicId,
                               const char* dataTypeName,
                               const DDS::TopicQos& qos)
 {
-  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, this->lock_, false);
-
-  // Grab the domain.
-  DCPS_IR_Domain_Map::iterator where = this->domains_.find(domainId);
+  // Grab and lock the domain.
+  DomainGuard guard(*this, domainId);
+  DCPS_IR_Domain* const domainPtr = guard.domain();
 
-  if (where == this->domains_.end()) {
+  if (0 == domainPtr) {
     if (OpenDDS::DCPS::DCPS_debug_level > 4) {
       ACE_DEBUG((LM_WARNING,
                  ACE_TEXT("(%P|%t) WARNING: TAO_DDS_DCPSInfo_i:add_topic: ")
@@ -249,7 +253,7 @@ TAO_DDS_DCPSInfo_i::add_topic(const OpenDDS::DCPS::RepoId& topicId,
 
   // Grab the participant.
   DCPS_IR_Participant* participantPtr
-  = where->second->participant(participantId);
+  = domainPtr->participant(participantId);
 
   if (0 == participantPtr) {
     if (OpenDDS::DCPS::DCPS_debug_level > 4) {
@@ -264,7 +268,7 @@ TAO_DDS_DCPSInfo_i::add_topic(const OpenDDS::DCPS::RepoId& topicId,
   }
 
   OpenDDS::DCPS::TopicStatus topicStatus
-  = where->second->force_add_topic(topicId, topicName, dataTypeName,
+  = domainPtr->force_add_topic(topicId, topicName, dataTypeName,
                                    qos, participantPtr);
 
   if (topicStatus != OpenDDS::DCPS::CREATED) {
@@ -290,12 +294,11 @@ OpenDDS::DCPS::TopicStatus TAO_DDS_DCPSInfo_i::find_topic(
   DDS::TopicQos_out qos,
   OpenDDS::DCPS::RepoId_out topicId)
 {
-  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, this->lock_, OpenDDS::DCPS::INTERNAL_ERROR);
-
-  // Grab the domain.
-  DCPS_IR_Domain_Map::iterator where = this->domains_.find(domainId);
+  // Grab and lock the domain.
+  DomainGuard guard(*this, domainId);
+  DCPS_IR_Domain* const domainPtr = guard.domain();
 
-  if (where == this->domains_.end()) {
+  if (0 == domainPtr) {
     throw OpenDDS::DCPS::Invalid_Domain();
   }
 
@@ -304,7 +307,7 @@ OpenDDS::DCPS::TopicStatus TAO_DDS_DCPSInfo_i::find_topic(
   DCPS_IR_Topic* topic = 0;
   qos = new DDS::TopicQos;
 
-  status = where->second->find_topic(topicName, topic);
+  status = domainPtr->find_topic(topicName, topic);
 
   if (0 != topic) {
     status = OpenDDS::DCPS::FOUND;
@@ -322,18 +325,17 @@ OpenDDS::DCPS::TopicStatus TAO_DDS_DCPSInfo_i::remove_topic(
   const OpenDDS::DCPS::RepoId& participantId,
   const OpenDDS::DCPS::RepoId& topicId)
 {
-  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, this->lock_, OpenDDS::DCPS::INTERNAL_ERROR);
-
-  // Grab the domain.
-  DCPS_IR_Domain_Map::iterator where = this->domains_.find(domainId);
+  // Grab and lock the domain.
+  DomainGuard guard(*this, domainId);
+  DCPS_IR_Domain* const domainPtr = guard.domain();
 
-  if (where == this->domains_.end()) {
+  if (0 == domainPtr) {
     throw OpenDDS::DCPS::Invalid_Domain();
   }
 
   // Grab the participant.
   DCPS_IR_Participant* partPtr
-  = where->second->participant(participantId);
+  = domainPtr->participant(participantId);
 
   if (0 == partPtr) {
     throw OpenDDS::DCPS::Invalid_Participant();
@@ -345,7 +347,7 @@ OpenDDS::DCPS::TopicStatus TAO_DDS_DCPSInfo_i::remove_topic(
     throw OpenDDS::DCPS::Invalid_Topic();
   }
 
-  OpenDDS::DCPS::TopicStatus removedStatus = where->second->remove_topic(partPtr, topic);
+  OpenDDS::DCPS::TopicStatus removedStatus = domainPtr->remove_topic(partPtr, topic);
 
   if (this->um_
       && (partPtr->isOwner() == true)
@@ -384,24 +386,23 @@ OpenDDS::DCPS::RepoId TAO_DDS_DCPSInfo_i::add_publication(
     return OpenDDS::DCPS::GUID_UNKNOWN;
   }
 
-  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, this->lock_, OpenDDS::DCPS::GUID_UNKNOWN);
-
-  // Grab the domain.
-  DCPS_IR_Domain_Map::iterator where = this->domains_.find(domainId);
+  // Grab and lock the domain.
+  DomainGuard guard(*this, domainId);
+  DCPS_IR_Domain* const domainPtr = guard.domain();
 
-  if (where == this->domains_.end()) {
+  if (0 == domainPtr) {
     throw OpenDDS::DCPS::Invalid_Domain();
   }
 
   // Grab the participant.
   DCPS_IR_Participant* partPtr
-  = where->second->participant(participantId);
+  = domainPtr->participant(participantId);
 
   if (0 == partPtr) {
     throw OpenDDS::DCPS::Invalid_Participant();
   }
 
-  DCPS_IR_Topic* topic = where->second->find_topic(topicId);
+  DCPS_IR_Topic* topic = domainPtr->find_topic(topicId);
 
   if (topic == 0) {
     throw OpenDDS::DCPS::Invalid_Topic();
@@ -473,7 +474,7 @@ OpenDDS::DCPS::RepoId TAO_DDS_DCPSInfo_i::add_publication(
     }
   }
 
-  where->second->remove_dead_participants();
+  domainPtr->remove_dead_participants();
   return pubId;
 }
 
@@ -488,12 +489,11 @@ TAO_DDS_DCPSInfo_i::add_publication(DDS::DomainId_t domainId,
                                     const DDS::PublisherQos & publisherQos,
                                     bool associate)
 {
-  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, this->lock_, false);
-
-  // Grab the domain.
-  DCPS_IR_Domain_Map::iterator where = this->domains_.find(domainId);
+  // Grab and lock the domain.
+  DomainGuard guard(*this, domainId);
+  DCPS_IR_Domain* const domainPtr = guard.domain();
 
-  if (where == this->domains_.end()) {
+  if (0 == domainPtr) {
     if (OpenDDS::DCPS::DCPS_debug_level > 4) {
       ACE_DEBUG((LM_WARNING,
                  ACE_TEXT("(%P|%t) WARNING: TAO_DDS_DCPSInfo_i:add_publication: ")
@@ -506,7 +506,7 @@ TAO_DDS_DCPSInfo_i::add_publication(DDS::DomainId_t domainId,
 
   // Grab the participant.
   DCPS_IR_Participant* partPtr
-  = where->second->participant(participantId);
+  = domainPtr->participant(participantId);
 
   if (0 == partPtr) {
     if (OpenDDS::DCPS::DCPS_debug_level > 4) {
@@ -521,7 +521,7 @@ TAO_DDS_DCPSInfo_i::add_publication(DDS::DomainId_t domainId,
     return false;
   }
 
-  DCPS_IR_Topic* topic = where->second->find_topic(topicId);
+  DCPS_IR_Topic* topic = domainPtr->find_topic(topicId);
 
   if (topic == 0) {
     OpenDDS::DCPS::RepoIdConverter converter(topicId);
@@ -619,31 +619,30 @@ void TAO_DDS_DCPSInfo_i::remove_publication(
   const OpenDDS::DCPS::RepoId& participantId,
   const OpenDDS::DCPS::RepoId& publicationId)
 {
-  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, this->lock_);
+  // Grab and lock the domain.
+  DomainGuard guard(*this, domainId);
+  DCPS_IR_Domain* const domainPtr = guard.domain();
 
-  // Grab the domain.
-  DCPS_IR_Domain_Map::iterator where = this->domains_.find(domainId);
-
-  if (where == this->domains_.end()) {
+  if (0 == domainPtr) {
     throw OpenDDS::DCPS::Invalid_Domain();
   }
 
   // Grab the participant.
   DCPS_IR_Participant* partPtr
-  = where->second->participant(participantId);
+  = domainPtr->participant(participantId);
 
   if (0 == partPtr) {
     throw OpenDDS::DCPS::Invalid_Participant();
   }
 
   if (partPtr->remove_publication(publicationId) != 0) {
-    where->second->remove_dead_participants();
+    domainPtr->remove_dead_participants();
 
     // throw exception because the publication was not removed!
     throw OpenDDS::DCPS::Invalid_Publication();
   }
 
-  where->second->remove_dead_participants();
+  domainPtr->remove_dead_participants();
 
   if (this->um_
       && (partPtr->isOwner() == true)
@@ -688,25 +687,25 @@ OpenDDS::DCPS::RepoId TAO_DDS_DCPSInfo_i::add_subscription(
   DCPS_IR_Topic* topic;
   OpenDDS::DCPS::RepoId subId;
   OpenDDS::DCPS::unique_ptr<DCPS_IR_Subscription> subPtr;
-  {
-    ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, this->lock_, OpenDDS::DCPS::GUID_UNKNOWN);
 
-    // Grab the domain.
-    DCPS_IR_Domain_Map::iterator where = this->domains_.find(domainId);
+  // Grab and lock the domain, which stays in the repository after the
+  // lock is released below.
+  DomainGuard guard(*this, domainId);
+  {
+    domainPtr = guard.domain();
 
-    if (where == this->domains_.end()) {
+    if (0 == domainPtr) {
       throw OpenDDS::DCPS::Invalid_Domain();
     }
 
-    // Grab the domain and participant.
-    domainPtr = where->second.get();
+    // Grab the participant.
     partPtr = domainPtr->participant(participantId);
 
     if (0 == partPtr) {
       throw OpenDDS::DCPS::Invalid_Participant();
     }
 
-    topic = where->second->find_topic(topicId);
+    topic = domainPtr->find_topic(topicId);
 
     if (topic == 0) {
       throw OpenDDS::DCPS::Invalid_Topic();
@@ -748,6 +747,7 @@ OpenDDS::DCPS::RepoId TAO_DDS_DCPSInfo_i::add_subscription(
                      exprParams));
 
     // Release lock
+    guard.release();
   }
 
   DCPS_IR_Subscription* sub = subPtr.get();
@@ -804,12 +804,11 @@ TAO_DDS_DCPSInfo_i::add_subscription(
   const DDS::StringSeq& exprParams,
   bool associate)
 {
-  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, this->lock_, false);
+  // Grab and lock the domain.
+  DomainGuard guard(*this, domainId);
+  DCPS_IR_Domain* const domainPtr = guard.domain();
 
-  // Grab the domain.
-  DCPS_IR_Domain_Map::iterator where = this->domains_.find(domainId);
-
-  if (where == this->domains_.end()) {
+  if (0 == domainPtr) {
     if (OpenDDS::DCPS::DCPS_debug_level > 4) {
       ACE_DEBUG((LM_WARNING,
                  ACE_TEXT("(%P|%t) WARNING: TAO_DDS_DCPSInfo_i:add_subscription: ")
@@ -822,7 +821,7 @@ TAO_DDS_DCPSInfo_i::add_subscription(
 
   // Grab the participant.
   DCPS_IR_Participant* partPtr
-  = where->second->participant(participantId);
+  = domainPtr->participant(participantId);
 
   if (0 == partPtr) {
     if (OpenDDS::DCPS::DCPS_debug_level > 4) {
@@ -837,7 +836,7 @@ TAO_DDS_DCPSInfo_i::add_subscription(
     return false;
   }
 
-  DCPS_IR_Topic* topic = where->second->find_topic(topicId);
+  DCPS_IR_Topic* topic = domainPtr->find_topic(topicId);
 
   if (topic == 0) {
     if (OpenDDS::DCPS::DCPS_debug_level > 4) {
@@ -940,18 +939,17 @@ void TAO_DDS_DCPSInfo_i::remove_subscription(
   const OpenDDS::DCPS::RepoId& participantId,
   const OpenDDS::DCPS::RepoId& subscriptionId)
 {
-  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, this->lock_);
-
-  // Grab the domain.
-  DCPS_IR_Domain_Map::iterator where = this->domains_.find(domainId);
+  // Grab and lock the domain.
+  DomainGuard guard(*this, domainId);
+  DCPS_IR_Domain* const domainPtr = guard.domain();
 
-  if (where == this->domains_.end()) {
+  if (0 == domainPtr) {
     throw OpenDDS::DCPS::Invalid_Domain();
   }
 
   // Grab the participant.
   DCPS_IR_Participant* partPtr
-  = where->second->participant(participantId);
+  = domainPtr->participant(participantId);
 
   if (0 == partPtr) {
     throw OpenDDS::DCPS::Invalid_Participant();
@@ -962,7 +960,7 @@ void TAO_DDS_DCPSInfo_i::remove_subscription(
     throw OpenDDS::DCPS::Invalid_Subscription();
   }
 
-  where->second->remove_dead_participants();
+  domainPtr->remove_dead_participants();
 
   if (this->um_
       && (partPtr->isOwner() == true)
@@ -990,10 +988,9 @@ OpenDDS::DCPS::AddDomainStatus TAO_DDS_DCPSInfo_i::add_domain_participant(
   value.id        = OpenDDS::DCPS::GUID_UNKNOWN;
   value.federated = this->federation_.overridden();
 
-  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, this->lock_, value);
-
-  // Grab the domain.
-  DCPS_IR_Domain* domainPtr = this->domain(domain);
+  // Grab and lock the domain, creating it if needed.
+  DomainGuard guard(*this, domain, true);
+  DCPS_IR_Domain* const domainPtr = guard.domain();
 
   if (0 == domainPtr) {
     throw OpenDDS::DCPS::Invalid_Domain();
@@ -1080,10 +1077,9 @@ TAO_DDS_DCPSInfo_i::add_domain_participant(DDS::DomainId_t domainId
                                            , const OpenDDS::DCPS::RepoId& participantId
                                            , const DDS::DomainParticipantQos & qos)
 {
-  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, this->lock_, false);
-
-  // Grab the domain.
-  DCPS_IR_Domain* domainPtr = this->domain(domainId);
+  // Grab and lock the domain, creating it if needed.
+  DomainGuard guard(*this, domainId, true);
+  DCPS_IR_Domain* const domainPtr = guard.domain();
 
   if (0 == domainPtr) {
     if (OpenDDS::DCPS::DCPS_debug_level > 4) {
@@ -1181,20 +1177,19 @@ TAO_DDS_DCPSInfo_i::remove_by_owner(
   DDS::DomainId_t domain,
   long              owner)
 {
-  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, this->lock_, false);
-
-  // Grab the domain.
-  DCPS_IR_Domain_Map::iterator where = this->domains_.find(domain);
+  // Grab and lock the domain.
+  DomainGuard guard(*this, domain);
+  DCPS_IR_Domain* const domainPtr = guard.domain();
 
-  if (where == this->domains_.end()) {
+  if (0 == domainPtr) {
     return false;
   }
 
   std::vector<OpenDDS::DCPS::RepoId> candidates;
 
   for (DCPS_IR_Participant_Map::const_iterator
-       current = where->second->participants().begin();
-       current != where->second->participants().end();
+       current = domainPtr->participants().begin();
+       current != domainPtr->participants().end();
        ++current) {
     if (current->second->owner() == owner) {
       candidates.push_back(current->second->get_id());
@@ -1213,7 +1208,7 @@ TAO_DDS_DCPSInfo_i::remove_by_owner(
 
   for (unsigned int index = 0; index < candidates.size(); ++index) {
     DCPS_IR_Participant* participant
-    = where->second->participant(candidates[index]);
+    = domainPtr->participant(candidates[index]);
     if (participant) {
       std::vector<OpenDDS::DCPS::RepoId> keylist;
 
@@ -1293,8 +1288,8 @@ TAO_DDS_DCPSInfo_i::remove_by_owner(
       }
     }
 
-    // Remove Participant
-    this->remove_domain_participant(domain, candidates[ index]);
+    // Remove Participant, the domain is already locked
+    this->remove_domain_participant_i(domainPtr, candidates[ index]);
   }
 
   return status;
@@ -1306,14 +1301,15 @@ TAO_DDS_DCPSInfo_i::disassociate_participant(
   const OpenDDS::DCPS::RepoId& local_id,
   const OpenDDS::DCPS::RepoId& remote_id)
 {
-  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, this->lock_);
+  // Grab and lock the domain.
+  DomainGuard guard(*this, domainId);
+  DCPS_IR_Domain* const domainPtr = guard.domain();
 
-  DCPS_IR_Domain_Map::iterator it(this->domains_.find(domainId));
-  if (it == this->domains_.end()) {
+  if (0 == domainPtr) {
     throw OpenDDS::DCPS::Invalid_Domain();
   }
 
-  DCPS_IR_Participant* participant = it->second->participant(local_id);
+  DCPS_IR_Participant* participant = domainPtr->participant(local_id);
   if (participant == 0) {
     throw OpenDDS::DCPS::Invalid_Participant();
   }
@@ -1331,7 +1327,7 @@ TAO_DDS_DCPSInfo_i::disassociate_participant(
     pub->second->disassociate_participant(remote_id, true);
   }
 
-  it->second->remove_dead_participants();
+  domainPtr->remove_dead_participants();
 }
 
 void
@@ -1341,14 +1337,23 @@ TAO_DDS_DCPSInfo_i::disassociate_subscription(
   const OpenDDS::DCPS::RepoId& local_id,
   const OpenDDS::DCPS::RepoId& remote_id)
 {
-  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, this->lock_);
+  // Grab and lock the domain.
+  DomainGuard guard(*this, domainId);
+  DCPS_IR_Domain* const domainPtr = guard.domain();
 
-  DCPS_IR_Domain_Map::iterator it(this->domains_.find(domainId));
-  if (it == this->domains_.end()) {
+  if (0 == domainPtr) {
     throw OpenDDS::DCPS::Invalid_Domain();
   }
 
-  DCPS_IR_Participant* participant = it->second->participant(participantId);
+  this->remove_domain_participant_i(domainPtr, participantId);
+}
+
+void TAO_DDS_DCPSInfo_i::remove_domain_participant_i(
+  DCPS_IR_Domain* domainPtr,
+  const OpenDDS::DCPS::RepoId& participantId)
+{
+  const DDS::DomainId_t domainId = domainPtr->get_id();
+  DCPS_IR_Participant* participant = domainPtr->participant(participantId);
   if (participant == 0) {
     throw OpenDDS::DCPS::Invalid_Participant();
   }
@@ -1373,7 +1378,7 @@ TAO_DDS_DCPSInfo_i::disassociate_subscription(
   // Disassociate from publication temporarily:
   subscription->disassociate_publication(remote_id, true);
 
-  it->second->remove_dead_participants();
+  domainPtr->remove_dead_participants();
 }
 
 void
@@ -1383,14 +1388,15 @@ TAO_DDS_DCPSInfo_i::disassociate_publication(
   const OpenDDS::DCPS::RepoId& local_id,
   const OpenDDS::DCPS::RepoId& remote_id)
 {
-  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, this->lock_);
+  // Grab and lock the domain.
+  DomainGuard guard(*this, domainId);
+  DCPS_IR_Domain* const domainPtr = guard.domain();
 
-  DCPS_IR_Domain_Map::iterator it(this->domains_.find(domainId));
-  if (it == this->domains_.end()) {
+  if (0 == domainPtr) {
     throw OpenDDS::DCPS::Invalid_Domain();
   }
 
-  DCPS_IR_Participant* participant = it->second->participant(participantId);
+  DCPS_IR_Participant* participant = domainPtr->participant(participantId);
   if (participant == 0) {
     throw OpenDDS::DCPS::Invalid_Participant();
   }
@@ -1415,23 +1421,22 @@ TAO_DDS_DCPSInfo_i::disassociate_publication(
   // Disassociate from subscription temporarily:
   publication->disassociate_subscription(remote_id, true);
 
-  it->second->remove_dead_participants();
+  domainPtr->remove_dead_participants();
 }
 
 void TAO_DDS_DCPSInfo_i::remove_domain_participant(
   DDS::DomainId_t domainId,
   const OpenDDS::DCPS::RepoId& participantId)
 {
-  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, this->lock_);
-
-  // Grab the domain.
-  DCPS_IR_Domain_Map::iterator where = this->domains_.find(domainId);
+  // Grab and lock the domain.
+  DomainGuard guard(*this, domainId);
+  DCPS_IR_Domain* const domainPtr = guard.domain();
 
-  if (where == this->domains_.end()) {
+  if (0 == domainPtr) {
     throw OpenDDS::DCPS::Invalid_Domain();
   }
 
-  DCPS_IR_Participant* participant = where->second->participant(participantId);
+  DCPS_IR_Participant* participant = domainPtr->participant(participantId);
 
   if (participant == 0) {
     OpenDDS::DCPS::RepoIdConverter converter(participantId);
@@ -1449,7 +1454,7 @@ void TAO_DDS_DCPSInfo_i::remove_domain_participant(
                     && (participant->isBitPublisher() == false);
 
   CORBA::Boolean dont_notify_lost = 0;
-  int status = where->second->remove_participant(participantId, dont_notify_lost);
+  int status = domainPtr->remove_participant(participantId, dont_notify_lost);
 
   if (0 != status) {
     // Removing the participant failed
@@ -1459,7 +1464,7 @@ void TAO_DDS_DCPSInfo_i::remove_domain_participant(
   // Update any concerned observers that the participant was destroyed.
   if (this->um_ && sendUpdate) {
     Update::IdPath path(
-      where->second->get_id(),
+      domainPtr->get_id(),
       participantId,
       participantId);
     this->um_->destroy(path, Update::Participant);
@@ -1474,13 +1479,11 @@ void TAO_DDS_DCPSInfo_i::remove_domain_participant(
     }
   }
 
-  if (where->second->participants().empty()) {
-    domains_.erase(where);
-  }
+  // An empty domain is removed when the last guard on it is released.
 
 #ifndef DDS_HAS_MINIMUM_BIT
-  else if (where->second->useBIT() &&
-           where->second->participants().size() == 1) {
+  if (domainPtr->useBIT() &&
+      domainPtr->participants().size() == 1) {
     // The only participant left is the one we created to publish BITs.
     // It can be removed now since no user participants exist in this domain,
     // but it has to be removed on the Service Participant's reactor thread
@@ -1494,16 +1497,15 @@ void TAO_DDS_DCPSInfo_i::remove_domain_participant(
 #ifndef DDS_HAS_MINIMUM_BIT
 int TAO_DDS_DCPSInfo_i::BIT_Cleanup_Handler::handle_exception(ACE_HANDLE)
 {
-  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, parent_->lock_, 0);
-
-  const DCPS_IR_Domain_Map::iterator where = parent_->domains_.find(domain_);
+  DomainGuard guard(*parent_.in(), domain_);
+  DCPS_IR_Domain* const domainPtr = guard.domain();
 
-  if (where == parent_->domains_.end()) {
+  if (0 == domainPtr) {
     return 0;
   }
 
-  if (where->second->participants().size() == 1) {
-    where->second->cleanup_built_in_topics();
+  if (domainPtr->participants().size() == 1) {
+    domainPtr->cleanup_built_in_topics();
   }
 
   return 0;
@@ -1515,14 +1517,15 @@ void TAO_DDS_DCPSInfo_i::association_complete(DDS::DomainId_t domainId,
   const OpenDDS::DCPS::RepoId& localId,
   const OpenDDS::DCPS::RepoId& remoteId)
 {
-  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, this->lock_);
+  // Grab and lock the domain.
+  DomainGuard guard(*this, domainId);
+  DCPS_IR_Domain* const domainPtr = guard.domain();
 
-  DCPS_IR_Domain_Map::iterator dom_iter = this->domains_.find(domainId);
-  if (dom_iter == this->domains_.end()) {
+  if (0 == domainPtr) {
     return;
   }
 
-  DCPS_IR_Participant* partPtr = dom_iter->second->participant(participantId);
+  DCPS_IR_Participant* partPtr = domainPtr->participant(participantId);
   if (0 == partPtr) {
     return;
   }
@@ -1559,18 +1562,17 @@ void TAO_DDS_DCPSInfo_i::ignore_domain_participant(
   const OpenDDS::DCPS::RepoId& myParticipantId,
   const OpenDDS::DCPS::RepoId& ignoreId)
 {
-  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, this->lock_);
-
-  // Grab the domain.
-  DCPS_IR_Domain_Map::iterator where = this->domains_.find(domainId);
+  // Grab and lock the domain.
+  DomainGuard guard(*this, domainId);
+  DCPS_IR_Domain* const domainPtr = guard.domain();
 
-  if (where == this->domains_.end()) {
+  if (0 == domainPtr) {
     throw OpenDDS::DCPS::Invalid_Domain();
   }
 
   // Grab the participant.
   DCPS_IR_Participant* partPtr
-  = where->second->participant(myParticipantId);
+  = domainPtr->participant(myParticipantId);
 
   if (0 == partPtr) {
     throw OpenDDS::DCPS::Invalid_Participant();
@@ -1578,7 +1580,7 @@ void TAO_DDS_DCPSInfo_i::ignore_domain_participant(
 
   partPtr->ignore_participant(ignoreId);
 
-  where->second->remove_dead_participants();
+  domainPtr->remove_dead_participants();
 }
 
 void TAO_DDS_DCPSInfo_i::ignore_topic(
@@ -1586,18 +1588,17 @@ void TAO_DDS_DCPSInfo_i::ignore_topic(
   const OpenDDS::DCPS::RepoId& myParticipantId,
   const OpenDDS::DCPS::RepoId& ignoreId)
 {
-  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, this->lock_);
-
-  // Grab the domain.
-  DCPS_IR_Domain_Map::iterator where = this->domains_.find(domainId);
+  // Grab and lock the domain.
+  DomainGuard guard(*this, domainId);
+  DCPS_IR_Domain* const domainPtr = guard.domain();
 
-  if (where == this->domains_.end()) {
+  if (0 == domainPtr) {
     throw OpenDDS::DCPS::Invalid_Domain();
   }
 
   // Grab the participant.
   DCPS_IR_Participant* partPtr
-  = where->second->participant(myParticipantId);
+  = domainPtr->participant(myParticipantId);
 
   if (0 == partPtr) {
     throw OpenDDS::DCPS::Invalid_Participant();
@@ -1605,7 +1606,7 @@ void TAO_DDS_DCPSInfo_i::ignore_topic(
 
   partPtr->ignore_topic(ignoreId);
 
-  where->second->remove_dead_participants();
+  domainPtr->remove_dead_participants();
 }
 
 void TAO_DDS_DCPSInfo_i::ignore_subscription(
@@ -1613,18 +1614,17 @@ void TAO_DDS_DCPSInfo_i::ignore_subscription(
   const OpenDDS::DCPS::RepoId& myParticipantId,
   const OpenDDS::DCPS::RepoId& ignoreId)
 {
-  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, this->lock_);
+  // Grab and lock the domain.
+  DomainGuard guard(*this, domainId);
+  DCPS_IR_Domain* const domainPtr = guard.domain();
 
-  // Grab the domain.
-  DCPS_IR_Domain_Map::iterator where = this->domains_.find(domainId);
-
-  if (where == this->domains_.end()) {
+  if (0 == domainPtr) {
     throw OpenDDS::DCPS::Invalid_Domain();
   }
 
   // Grab the participant.
   DCPS_IR_Participant* partPtr
-  = where->second->participant(myParticipantId);
+  = domainPtr->participant(myParticipantId);
 
   if (0 == partPtr) {
     throw OpenDDS::DCPS::Invalid_Participant();
@@ -1632,7 +1632,7 @@ void TAO_DDS_DCPSInfo_i::ignore_subscription(
 
   partPtr->ignore_subscription(ignoreId);
 
-  where->second->remove_dead_participants();
+  domainPtr->remove_dead_participants();
 }
 
 void TAO_DDS_DCPSInfo_i::ignore_publication(
@@ -1640,18 +1640,17 @@ void TAO_DDS_DCPSInfo_i::ignore_publication(
   const OpenDDS::DCPS::RepoId& myParticipantId,
   const OpenDDS::DCPS::RepoId& ignoreId)
 {
-  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, this->lock_);
-
-  // Grab the domain.
-  DCPS_IR_Domain_Map::iterator where = this->domains_.find(domainId);
+  // Grab and lock the domain.
+  DomainGuard guard(*this, domainId);
+  DCPS_IR_Domain* const domainPtr = guard.domain();
 
-  if (where == this->domains_.end()) {
+  if (0 == domainPtr) {
     throw OpenDDS::DCPS::Invalid_Domain();
   }
 
   // Grab the participant.
   DCPS_IR_Participant* partPtr
-  = where->second->participant(myParticipantId);
+  = domainPtr->participant(myParticipantId);
 
   if (0 == partPtr) {
     throw OpenDDS::DCPS::Invalid_Participant();
@@ -1659,7 +1658,7 @@ void TAO_DDS_DCPSInfo_i::ignore_publication(
 
   partPtr->ignore_publication(ignoreId);
 
-  where->second->remove_dead_participants();
+  domainPtr->remove_dead_participants();
 }
 
 CORBA::Boolean TAO_DDS_DCPSInfo_i::update_publication_qos(
@@ -1669,18 +1668,17 @@ CORBA::Boolean TAO_DDS_DCPSInfo_i::update_publication_qos(
   const DDS::DataWriterQos & qos,
   const DDS::PublisherQos & publisherQos)
 {
-  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, this->lock_, 0);
-
-  // Grab the domain.
-  DCPS_IR_Domain_Map::iterator where = this->domains_.find(domainId);
+  // Grab and lock the domain.
+  DomainGuard guard(*this, domainId);
+  DCPS_IR_Domain* const domainPtr = guard.domain();
 
-  if (where == this->domains_.end()) {
+  if (0 == domainPtr) {
     throw OpenDDS::DCPS::Invalid_Domain();
   }
 
   // Grab the participant.
   DCPS_IR_Participant* partPtr
-  = where->second->participant(partId);
+  = domainPtr->participant(partId);
 
   if (0 == partPtr) {
     throw OpenDDS::DCPS::Invalid_Participant();
@@ -1745,18 +1743,17 @@ TAO_DDS_DCPSInfo_i::update_publication_qos(
   const OpenDDS::DCPS::RepoId& dwId,
   const DDS::DataWriterQos&  qos)
 {
-  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, this->lock_);
-
-  // Grab the domain.
-  DCPS_IR_Domain_Map::iterator where = this->domains_.find(domainId);
+  // Grab and lock the domain.
+  DomainGuard guard(*this, domainId);
+  DCPS_IR_Domain* const domainPtr = guard.domain();
 
-  if (where == this->domains_.end()) {
+  if (0 == domainPtr) {
     throw OpenDDS::DCPS::Invalid_Domain();
   }
 
   // Grab the participant.
   DCPS_IR_Participant* partPtr
-  = where->second->participant(partId);
+  = domainPtr->participant(partId);
 
   if (0 == partPtr) {
     throw OpenDDS::DCPS::Invalid_Participant();
@@ -1789,18 +1786,17 @@ TAO_DDS_DCPSInfo_i::update_publication_qos(
   const OpenDDS::DCPS::RepoId& dwId,
   const DDS::PublisherQos&   qos)
 {
-  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, this->lock_);
+  // Grab and lock the domain.
+  DomainGuard guard(*this, domainId);
+  DCPS_IR_Domain* const domainPtr = guard.domain();
 
-  // Grab the domain.
-  DCPS_IR_Domain_Map::iterator where = this->domains_.find(domainId);
-
-  if (where == this->domains_.end()) {
+  if (0 == domainPtr) {
     throw OpenDDS::DCPS::Invalid_Domain();
   }
 
   // Grab the participant.
   DCPS_IR_Participant* partPtr
-  = where->second->participant(partId);
+  = domainPtr->participant(partId);
 
   if (0 == partPtr) {
     throw OpenDDS::DCPS::Invalid_Participant();
@@ -1833,18 +1829,17 @@ CORBA::Boolean TAO_DDS_DCPSInfo_i::update_subscription_qos(
   const DDS::DataReaderQos & qos,
   const DDS::SubscriberQos & subscriberQos)
 {
-  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, this->lock_, 0);
-
-  // Grab the domain.
-  DCPS_IR_Domain_Map::iterator where = this->domains_.find(domainId);
+  // Grab and lock the domain.
+  DomainGuard guard(*this, domainId);
+  DCPS_IR_Domain* const domainPtr = guard.domain();
 
-  if (where == this->domains_.end()) {
+  if (0 == domainPtr) {
     throw OpenDDS::DCPS::Invalid_Domain();
   }
 
   // Grab the participant.
   DCPS_IR_Participant* partPtr
-  = where->second->participant(partId);
+  = domainPtr->participant(partId);
 
   if (0 == partPtr) {
     throw OpenDDS::DCPS::Invalid_Participant();
@@ -1909,18 +1904,17 @@ TAO_DDS_DCPSInfo_i::update_subscription_qos(
   const OpenDDS::DCPS::RepoId& drId,
   const DDS::DataReaderQos&  qos)
 {
-  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, this->lock_);
-
-  // Grab the domain.
-  DCPS_IR_Domain_Map::iterator where = this->domains_.find(domainId);
+  // Grab and lock the domain.
+  DomainGuard guard(*this, domainId);
+  DCPS_IR_Domain* const domainPtr = guard.domain();
 
-  if (where == this->domains_.end()) {
+  if (0 == domainPtr) {
     throw OpenDDS::DCPS::Invalid_Domain();
   }
 
   // Grab the participant.
   DCPS_IR_Participant* partPtr
-  = where->second->participant(partId);
+  = domainPtr->participant(partId);
 
   if (0 == partPtr) {
     throw OpenDDS::DCPS::Invalid_Participant();
@@ -1953,18 +1947,17 @@ TAO_DDS_DCPSInfo_i::update_subscription_qos(
   const OpenDDS::DCPS::RepoId& drId,
   const DDS::SubscriberQos&  qos)
 {
-  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, this->lock_);
+  // Grab and lock the domain.
+  DomainGuard guard(*this, domainId);
+  DCPS_IR_Domain* const domainPtr = guard.domain();
 
-  // Grab the domain.
-  DCPS_IR_Domain_Map::iterator where = this->domains_.find(domainId);
-
-  if (where == this->domains_.end()) {
+  if (0 == domainPtr) {
     throw OpenDDS::DCPS::Invalid_Domain();
   }
 
   // Grab the participant.
   DCPS_IR_Participant* partPtr
-  = where->second->participant(partId);
+  = domainPtr->participant(partId);
 
   if (0 == partPtr) {
     throw OpenDDS::DCPS::Invalid_Participant();
@@ -1997,14 +1990,15 @@ TAO_DDS_DCPSInfo_i::update_subscription_params(
     const OpenDDS::DCPS::RepoId& subscriptionId,
     const DDS::StringSeq& params)
 {
-  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, this->lock_, 0);
+  // Grab and lock the domain.
+  DomainGuard guard(*this, domainId);
+  DCPS_IR_Domain* const domainPtr = guard.domain();
 
-  DCPS_IR_Domain_Map::iterator domain = this->domains_.find(domainId);
-  if (domain == this->domains_.end()) {
+  if (0 == domainPtr) {
     throw OpenDDS::DCPS::Invalid_Domain();
   }
 
-  DCPS_IR_Participant* partPtr = domain->second->participant(participantId);
+  DCPS_IR_Participant* partPtr = domainPtr->participant(participantId);
   if (0 == partPtr) {
     throw OpenDDS::DCPS::Invalid_Participant();
   }
@@ -2041,18 +2035,17 @@ CORBA::Boolean TAO_DDS_DCPSInfo_i::update_topic_qos(
   const OpenDDS::DCPS::RepoId& participantId,
   const DDS::TopicQos & qos)
 {
-  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, this->lock_, 0);
-
-  // Grab the domain.
-  DCPS_IR_Domain_Map::iterator where = this->domains_.find(domainId);
+  // Grab and lock the domain.
+  DomainGuard guard(*this, domainId);
+  DCPS_IR_Domain* const domainPtr = guard.domain();
 
-  if (where == this->domains_.end()) {
+  if (0 == domainPtr) {
     throw OpenDDS::DCPS::Invalid_Domain();
   }
 
   // Grab the participant.
   DCPS_IR_Participant* partPtr
-  = where->second->participant(participantId);
+  = domainPtr->participant(participantId);
 
   if (0 == partPtr) {
     throw OpenDDS::DCPS::Invalid_Participant();
@@ -2091,18 +2084,17 @@ CORBA::Boolean TAO_DDS_DCPSInfo_i::update_domain_participant_qos(
   const OpenDDS::DCPS::RepoId& participantId,
   const DDS::DomainParticipantQos & qos)
 {
-  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, this->lock_, 0);
-
-  // Grab the domain.
-  DCPS_IR_Domain_Map::iterator where = this->domains_.find(domainId);
+  // Grab and lock the domain.
+  DomainGuard guard(*this, domainId);
+  DCPS_IR_Domain* const domainPtr = guard.domain();
 
-  if (where == this->domains_.end()) {
+  if (0 == domainPtr) {
     throw OpenDDS::DCPS::Invalid_Domain();
   }
 
   // Grab the participant.
   DCPS_IR_Participant* partPtr
-  = where->second->participant(participantId);
+  = domainPtr->participant(participantId);
 
   if (0 == partPtr) {
     throw OpenDDS::DCPS::Invalid_Participant();
@@ -2140,15 +2132,19 @@ TAO_DDS_DCPSInfo_i::domain(DDS::DomainId_t domain)
     return 0;
   }
 
+  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, this->lock_, 0);
+
   // Check if the domain is already in the map.
   DCPS_IR_Domain_Map::iterator where = this->domains_.find(domain);
 
   if (where == this->domains_.end()) {
     // We will attempt to insert a new domain, go ahead and allocate it.
     OpenDDS::DCPS::unique_ptr<DCPS_IR_Domain> domain_uptr( new
-                   DCPS_IR_Domain(domain, this->participantIdGenerator_));
+                   DCPS_IR_Domain(domain, this->participantIdGenerator_,
+                                  this->participantIdGeneratorLock_));
 
     DCPS_IR_Domain* domainPtr = domain_uptr.get();
+    domainPtr->batchAssociations(this->batchAssociations_);
 
     // We need to insert the domain into the map at this time since it
     // might be looked up during the init_built_in_topics() call.
@@ -2157,9 +2153,15 @@ TAO_DDS_DCPSInfo_i::domain(DDS::DomainId_t domain)
       DCPS_IR_Domain_Map::value_type(domain, OpenDDS::DCPS::move(domain_uptr)));
 
 #ifndef DDS_HAS_MINIMUM_BIT
-    if (TheServiceParticipant->get_BIT() && !domainPtr->useBIT() &&
-      domainPtr->init_built_in_topics(federation_.overridden(), reincarnate_)
-    ) {
+    // The Built-In Topic participant calls back into the repository for
+    // this domain, so it is in use until they are initialized.  The lock
+    // is held throughout, so no other thread can use the new domain.
+    ++domainPtr->users();
+    const bool failed = TheServiceParticipant->get_BIT() && !domainPtr->useBIT() &&
+      domainPtr->init_built_in_topics(federation_.overridden(), reincarnate_);
+    --domainPtr->users();
+
+    if (failed) {
       ACE_ERROR((LM_ERROR,
                  ACE_TEXT("(%P|%t) ERROR: TAO_DDS_DCPSInfo_i::domain: ")
                  ACE_TEXT("failed to initialize the Built-In Topics ")
@@ -2264,7 +2266,10 @@ TAO_DDS_DCPSInfo_i::receive_image(const Update::UImage& image)
 #endif
 
   // Ensure that new non-BIT participants do not reuse an id
-  participantIdGenerator_.last(image.lastPartId);
+  {
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, this->participantIdGeneratorLock_, false);
+    participantIdGenerator_.last(image.lastPartId);
+  }
 
   for (Update::UImage::ParticipantSeq::const_iterator
        iter = image.participants.begin();
@@ -2385,10 +2390,14 @@ TAO_DDS_DCPSInfo_i::receive_image(const Update::UImage& image)
 
 #ifndef DDS_HAS_MINIMUM_BIT
   if (TheServiceParticipant->get_BIT()) {
-    for (DCPS_IR_Domain_Map::const_iterator currentDomain = domains_.begin();
-         currentDomain != domains_.end();
-         ++currentDomain) {
-      currentDomain->second->reassociate_built_in_topic_pubs();
+    std::vector<DDS::DomainId_t> domainIds;
+    this->domain_ids(domainIds);
+
+    for (size_t i = 0; i < domainIds.size(); ++i) {
+      DomainGuard domain(*this, domainIds[i]);
+      if (domain.domain()) {
+        domain.domain()->reassociate_built_in_topic_pubs();
+      }
     }
   }
 #endif
@@ -2466,10 +2475,105 @@ TAO_DDS_DCPSInfo_i::finalize()
   }
 }
 
-const DCPS_IR_Domain_Map&
-TAO_DDS_DCPSInfo_i::domains() const
+void
+TAO_DDS_DCPSInfo_i::batch_associations(bool batch)
 {
-  return this->domains_;
+  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, this->lock_);
+
+  this->batchAssociations_ = batch;
+}
+
+void
+TAO_DDS_DCPSInfo_i::domain_ids(std::vector<DDS::DomainId_t>& domainIds)
+{
+  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, this->lock_);
+
+  for (DCPS_IR_Domain_Map::const_iterator dom(this->domains_.begin());
+       dom != this->domains_.end(); ++dom) {
+    domainIds.push_back(dom->first);
+  }
+}
+
+DCPS_IR_Domain*
+TAO_DDS_DCPSInfo_i::acquire_domain(DDS::DomainId_t domainId, bool create)
+{
+  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, this->lock_, 0);
+
+  DCPS_IR_Domain* domainPtr = 0;
+
+  if (create) {
+    domainPtr = this->domain(domainId);
+
+  } else {
+    const DCPS_IR_Domain_Map::iterator where = this->domains_.find(domainId);
+
+    if (where != this->domains_.end()) {
+      domainPtr = where->second.get();
+    }
+  }
+
+  if (domainPtr) {
+    ++domainPtr->users();
+  }
+
+  return domainPtr;
+}
+
+void
+TAO_DDS_DCPSInfo_i::release_domain(DCPS_IR_Domain* domainPtr)
+{
+  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, this->lock_);
+
+  // Nothing else is using the domain, so its participants can be read
+  // without its lock.
+  if (--domainPtr->users() == 0 && domainPtr->participants().empty()) {
+    this->domains_.erase(domainPtr->get_id());
+  }
+}
+
+TAO_DDS_DCPSInfo_i::DomainGuard::DomainGuard(TAO_DDS_DCPSInfo_i& info,
+                                             DDS::DomainId_t domainId,
+                                             bool create)
+  : info_(info)
+  , domain_(info.acquire_domain(domainId, create))
+  , locked_(false)
+{
+  // The repository lock is not held here, so waiting for the domain
+  // does not block operations on other domains.
+  if (domain_) {
+    locked_ = domain_->lock().acquire() == 0;
+
+    if (!locked_) {
+      ACE_ERROR((LM_ERROR,
+                 ACE_TEXT("(%P|%t) ERROR: TAO_DDS_DCPSInfo_i::DomainGuard: ")
+                 ACE_TEXT("failed to lock domain %d %p\n"),
+                 domainId, ACE_TEXT("acquire")));
+    }
+  }
+}
+
+TAO_DDS_DCPSInfo_i::DomainGuard::~DomainGuard()
+{
+  if (domain_) {
+    release();
+    info_.release_domain(domain_);
+  }
+
+  // The operation returns once what it changed is persisted.  The domain
+  // is unlocked first, so the updates of operations on other domains
+  // are persisted together with it.
+  if (info_.um_) {
+    info_.um_->sync();
+  }
+}
+
+void
+TAO_DDS_DCPSInfo_i::DomainGuard::release()
+{
+  if (locked_) {
+    domain_->lock().release();
+    locked_ = false;
+  }
 }
 
 
@@ -2480,11 +2584,15 @@ TAO_DDS_DCPSInfo_i::dump_to_string()
 #if !defined (OPENDDS_INFOREPO_REDUCED_FOOTPRINT)
   std::string indent ("    ");
 
-  for (DCPS_IR_Domain_Map::const_iterator dm = domains_.begin();
-       dm != domains_.end();
-       dm++)
+  std::vector<DDS::DomainId_t> domainIds;
+  this->domain_ids(domainIds);
+
+  for (size_t i = 0; i < domainIds.size(); ++i)
   {
-    dump += dm->second->dump_to_string(indent, 0);
+    DomainGuard domain(*this, domainIds[i]);
+    if (domain.domain()) {
+      dump += domain.domain()->dump_to_string(indent, 0);
+    }
   }
 #endif // !defined (OPENDDS_INFOREPO_REDUCED_FOOTPRINT)
   return CORBA::string_dup(dump.c_str());
@@ -25,6 +25,7 @@
 #include "UpdateManager.h"
 
 #include <map>
+#include <vector>
 
 #if !defined (ACE_LACKS_PRAGMA_ONCE)
 #pragma once
@@ -50,6 +51,15 @@ class ShutdownInterface;
  *
  * This is the Information Repository object.  Clients of
  * the system will use the CORBA reference of this object.
+ *
+ * Locking: lock_, the repository's lock, is taken before a domain's
+ * lock.  lock_ is held while a domain is created, and the Built-In
+ * Topic participant created with it calls back into the repository,
+ * which locks the new domain.  So code holding a domain's lock, in the
+ * scope of a DomainGuard, must not take lock_: it must not call
+ * domain() or domain_ids(), or create another DomainGuard, all of which
+ * take lock_.  It works on the DCPS_IR_Domain it holds.  The lock of
+ * the Update::Manager is taken after the domain's.
  */
 class  OpenDDS_InfoRepoLib_Export TAO_DDS_DCPSInfo_i
   : public virtual POA_OpenDDS::DCPS::DCPSInfo,
@@ -391,10 +401,12 @@ public:
   void add(Update::Updater* updater);
 
   /// Convert a domain Id into a reference to a DCPS_IR_Domain object.
+  /// Not to be called while a domain is locked.
   DCPS_IR_Domain* domain(DDS::DomainId_t domain);
 
-  /// Expose a readable reference of the domain map.
-  const DCPS_IR_Domain_Map& domains() const;
+  /// The ids of the current domains.  Each one is locked with a
+  /// DomainGuard to look at it, and may be gone by then.
+  void domain_ids(std::vector<DDS::DomainId_t>& domainIds);
 
   /// Expose the ORB.
   CORBA::ORB_ptr orb();
@@ -408,20 +420,73 @@ public:
   /// Cleanup state for shutdown.
   void finalize();
 
+  /// Whether the matches a new writer or reader makes are sent to it in
+  /// one add_associations() call instead of one add_association() call
+  /// each.  Participants built before add_associations() existed drop
+  /// the call, so this is only for systems where none are left.  Set
+  /// before the repository handles requests; off by default.
+  void batch_associations(bool batch);
+
+  /**
+   * @class DomainGuard
+   *
+   * @brief Locks one domain for an operation on it.
+   *
+   * Operations on different domains hold different locks, so they can
+   * run on different ORB threads.  The domain stays in the repository
+   * while the guard exists, even after release(), and is removed when
+   * the last guard on it is destroyed if it has no participants left.
+   * Its destruction waits, unlocked, until the updaters persisted what
+   * the operation changed.
+   */
+  class DomainGuard {
+  public:
+    DomainGuard(TAO_DDS_DCPSInfo_i& info, DDS::DomainId_t domainId,
+                bool create = false);
+    ~DomainGuard();
+
+    /// The domain, or 0 if it does not exist.
+    DCPS_IR_Domain* domain() const { return domain_; }
+
+    /// Unlock the domain before the guard is destroyed.
+    void release();
+
+  private:
+    TAO_DDS_DCPSInfo_i& info_;
+    DCPS_IR_Domain* domain_;
+    bool locked_;
+  };
+
 private:
+  /// remove_domain_participant() for the domain locked by the caller.
+  void remove_domain_participant_i(DCPS_IR_Domain* domainPtr,
+                                   const OpenDDS::DCPS::RepoId& participantId);
+
+  /// Find the domain, or create it if create is true, and count
+  /// a use of it.  Returns 0 if it does not exist.
+  DCPS_IR_Domain* acquire_domain(DDS::DomainId_t domainId, bool create);
+
+  /// Count the end of a use of the domain, removing it if that was
+  /// the last use and it has no participants.
+  void release_domain(DCPS_IR_Domain* domainPtr);
+
   DCPS_IR_Domain_Map domains_;
   CORBA::ORB_var orb_;
   CORBA::ORB_var dispatchingOrb_;
 
   const TAO_DDS_DCPSFederationId& federation_;
   OpenDDS::DCPS::RepoIdGenerator participantIdGenerator_;
+  ACE_Thread_Mutex participantIdGeneratorLock_;
 
   Update::Manager* um_;
   bool reincarnate_;
+  bool batchAssociations_;
 
   /// Interface to effect shutdown of the process.
   ShutdownInterface* shutdown_;
 
+  /// Guards domains_ and the number of users of each domain.  Each
+  /// domain has its own lock for the operations on it.
   ACE_Recursive_Thread_Mutex lock_;
 
   long reassociate_timer_id_;
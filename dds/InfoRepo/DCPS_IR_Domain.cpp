@@ -35,10 +35,15 @@
 
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
-DCPS_IR_Domain::DCPS_IR_Domain(DDS::DomainId_t id, OpenDDS::DCPS::RepoIdGenerator& generator)
+DCPS_IR_Domain::DCPS_IR_Domain(DDS::DomainId_t id,
+                               OpenDDS::DCPS::RepoIdGenerator& generator,
+                               ACE_Thread_Mutex& generatorLock)
   : id_(id),
     participantIdGenerator_(generator),
-    useBIT_(false)
+    participantIdGeneratorLock_(generatorLock),
+    users_(0),
+    useBIT_(false),
+    batchAssociations_(false)
 {
 }
 
@@ -984,12 +989,15 @@ DDS::DomainId_t DCPS_IR_Domain::get_id()
 OpenDDS::DCPS::RepoId
 DCPS_IR_Domain::get_next_participant_id()
 {
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, this->participantIdGeneratorLock_,
+                   OpenDDS::DCPS::GUID_UNKNOWN);
   return this->participantIdGenerator_.next();
 }
 
 void
 DCPS_IR_Domain::last_participant_key(long key)
 {
+  ACE_GUARD(ACE_Thread_Mutex, guard, this->participantIdGeneratorLock_);
   this->participantIdGenerator_.last(key);
 }
 
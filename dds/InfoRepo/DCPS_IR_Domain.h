@@ -25,6 +25,8 @@
 #include "dds/DCPS/transport/tcp/TcpTransport.h"
 #include "dds/DCPS/transport/framework/TransportConfig_rch.h"
 #include /**/ "ace/Unbounded_Set.h"
+#include /**/ "ace/Recursive_Thread_Mutex.h"
+#include /**/ "ace/Thread_Mutex.h"
 
 #include <set>
 #include <map>
@@ -64,7 +66,10 @@ class DCPS_IR_Publication;
 class OpenDDS_InfoRepoLib_Export DCPS_IR_Domain
 : public OpenDDS::DCPS::EnableContainerSupportedUniquePtr<DCPS_IR_Domain>{
 public:
-  DCPS_IR_Domain(DDS::DomainId_t id, OpenDDS::DCPS::RepoIdGenerator& generator);
+  /// The generator is shared by all of the domains, and is only used
+  /// while generatorLock is held.
+  DCPS_IR_Domain(DDS::DomainId_t id, OpenDDS::DCPS::RepoIdGenerator& generator,
+                 ACE_Thread_Mutex& generatorLock);
 
   ~DCPS_IR_Domain();
 
@@ -175,6 +180,19 @@ public:
 
   bool useBIT() const { return useBIT_; }
 
+  /// Whether the matches a new writer or reader makes are sent to it
+  /// in one add_associations() call.
+  bool batchAssociations() const { return batchAssociations_; }
+  void batchAssociations(bool batch) { batchAssociations_ = batch; }
+
+  /// Held by the repository for the duration of each operation on
+  /// this domain, so operations on different domains run in parallel.
+  ACE_Recursive_Thread_Mutex& lock() { return lock_; }
+
+  /// The number of operations using this domain, which keep the
+  /// repository from removing it.  Guarded by the repository's lock.
+  int& users() { return users_; }
+
 private:
   OpenDDS::DCPS::TopicStatus add_topic_i(OpenDDS::DCPS::RepoId& topicId,
                                          const char * topicName,
@@ -217,6 +235,10 @@ private:
   /// Participant GUID Id generator.  The remaining Entities have their
   /// values generated within the containing Participant.
   OpenDDS::DCPS::RepoIdGenerator& participantIdGenerator_;
+  ACE_Thread_Mutex& participantIdGeneratorLock_;
+
+  ACE_Recursive_Thread_Mutex lock_;
+  int users_;
 
   /// all the participants
   DCPS_IR_Participant_Map participants_;
@@ -239,6 +261,8 @@ private:
   /// indicates if the BuiltIn Topics are enabled
   bool useBIT_;
 
+  bool batchAssociations_;
+
   ///@{
   /// Built-in Topic variables
   DDS::DomainParticipantFactory_var                bitParticipantFactory_;
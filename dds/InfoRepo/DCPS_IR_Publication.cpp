@@ -49,16 +49,14 @@ DCPS_IR_Publication::~DCPS_IR_Publication()
 {
 }
 
-int DCPS_IR_Publication::add_associated_subscription(DCPS_IR_Subscription* sub,
-                                                     bool active)
+int DCPS_IR_Publication::insert_association(DCPS_IR_Subscription* sub,
+                                            OpenDDS::DCPS::ReaderAssociation& association)
 {
   // keep track of the association locally
-  int status = associations_.insert(sub);
+  const int status = associations_.insert(sub);
 
   switch (status) {
-  case 0: {
-    // inform the datawriter about the association
-    OpenDDS::DCPS::ReaderAssociation association;
+  case 0:
     association.readerTransInfo = sub->get_transportLocatorSeq();
     association.readerId = sub->get_id();
     association.subQos = *(sub->get_subscriber_qos());
@@ -66,36 +64,7 @@ int DCPS_IR_Publication::add_associated_subscription(DCPS_IR_Subscription* sub,
     association.filterClassName = sub->get_filter_class_name().c_str();
     association.filterExpression = sub->get_filter_expression().c_str();
     association.exprParams = sub->get_expr_params();
-
-    if (participant_->is_alive() && this->participant_->isOwner()) {
-      try {
-        if (OpenDDS::DCPS::DCPS_debug_level > 0) {
-          OpenDDS::DCPS::RepoIdConverter pub_converter(id_);
-          OpenDDS::DCPS::RepoIdConverter sub_converter(sub->get_id());
-          ACE_DEBUG((LM_DEBUG,
-                     ACE_TEXT("(%P|%t) DCPS_IR_Publication::add_associated_subscription:")
-                     ACE_TEXT(" publication %C adding subscription %C.\n"),
-                     std::string(pub_converter).c_str(),
-                     std::string(sub_converter).c_str()));
-        }
-
-        writer_->add_association(id_, association, active);
-
-        if (OpenDDS::DCPS::DCPS_debug_level > 0) {
-          ACE_DEBUG((LM_DEBUG,
-                     ACE_TEXT("(%P|%t) DCPS_IR_Publication::add_associated_subscription: ")
-                     ACE_TEXT("successfully added subscription %x.\n"),
-                     sub));
-        }
-      } catch (const CORBA::Exception& ex) {
-        ex._tao_print_exception(
-          "(%P|%t) ERROR: Exception caught in DCPS_IR_Publication::add_associated_subscription:");
-        participant_->mark_dead();
-        status = -1;
-      }
-    }
-  }
-  break;
+    break;
 
   case 1: {
     OpenDDS::DCPS::RepoIdConverter pub_converter(id_);
@@ -122,6 +91,88 @@ int DCPS_IR_Publication::add_associated_subscription(DCPS_IR_Subscription* sub,
   return status;
 }
 
+int DCPS_IR_Publication::add_associated_subscription(DCPS_IR_Subscription* sub,
+                                                     bool active)
+{
+  OpenDDS::DCPS::ReaderAssociation association;
+  int status = insert_association(sub, association);
+
+  // inform the datawriter about the association
+  if (status == 0 && participant_->is_alive() && this->participant_->isOwner()) {
+    try {
+      if (OpenDDS::DCPS::DCPS_debug_level > 0) {
+        OpenDDS::DCPS::RepoIdConverter pub_converter(id_);
+        OpenDDS::DCPS::RepoIdConverter sub_converter(sub->get_id());
+        ACE_DEBUG((LM_DEBUG,
+                   ACE_TEXT("(%P|%t) DCPS_IR_Publication::add_associated_subscription:")
+                   ACE_TEXT(" publication %C adding subscription %C.\n"),
+                   std::string(pub_converter).c_str(),
+                   std::string(sub_converter).c_str()));
+      }
+
+      writer_->add_association(id_, association, active);
+
+      if (OpenDDS::DCPS::DCPS_debug_level > 0) {
+        ACE_DEBUG((LM_DEBUG,
+                   ACE_TEXT("(%P|%t) DCPS_IR_Publication::add_associated_subscription: ")
+                   ACE_TEXT("successfully added subscription %x.\n"),
+                   sub));
+      }
+    } catch (const CORBA::Exception& ex) {
+      ex._tao_print_exception(
+        "(%P|%t) ERROR: Exception caught in DCPS_IR_Publication::add_associated_subscription:");
+      participant_->mark_dead();
+      status = -1;
+    }
+  }
+
+  return status;
+}
+
+int DCPS_IR_Publication::add_associated_subscriptions(const DCPS_IR_Subscription_Set& subs,
+                                                      bool active)
+{
+  OpenDDS::DCPS::ReaderAssociationSeq associations(static_cast<CORBA::ULong>(subs.size()));
+  CORBA::ULong count = 0;
+  for (DCPS_IR_Subscription_Set::CONST_ITERATOR iter = subs.begin();
+       iter != subs.end(); ++iter) {
+    associations.length(count + 1);
+    if (insert_association(*iter, associations[count]) == 0) {
+      ++count;
+    }
+  }
+  associations.length(count);
+
+  if (count == 0 || !participant_->is_alive() || !this->participant_->isOwner()) {
+    return 0;
+  }
+
+  // inform the datawriter about all of the associations at once
+  try {
+    if (OpenDDS::DCPS::DCPS_debug_level > 0) {
+      OpenDDS::DCPS::RepoIdConverter pub_converter(id_);
+      ACE_DEBUG((LM_DEBUG,
+                 ACE_TEXT("(%P|%t) DCPS_IR_Publication::add_associated_subscriptions:")
+                 ACE_TEXT(" publication %C adding %u subscriptions.\n"),
+                 std::string(pub_converter).c_str(),
+                 count));
+    }
+
+    if (count == 1) {
+      writer_->add_association(id_, associations[0], active);
+    } else {
+      writer_->add_associations(id_, associations, active);
+    }
+  } catch (const CORBA::Exception& ex) {
+    ex._tao_print_exception(
+      "(%P|%t) ERROR: Exception caught in DCPS_IR_Publication::add_associated_subscriptions:");
+    participant_->mark_dead();
+    return -1;
+  }
+
+  return 0;
+}
+
 void
 DCPS_IR_Publication::association_complete(const OpenDDS::DCPS::RepoId& remote)
 {
@@ -58,6 +58,14 @@ public:
   /// Returns 0 if added, 1 if already exists, -1 other failure
   int add_associated_subscription(DCPS_IR_Subscription* sub, bool active);
 
+  /// Associate with each of the subscriptions
+  /// Like add_associated_subscription(), but the datawriter is
+  ///  notified of all of the added subscriptions in one call
+  /// This method can mark the participant dead
+  /// Returns -1 if the datawriter couldn't be notified, otherwise 0
+  int add_associated_subscriptions(const DCPS_IR_Subscription_Set& subs,
+                                   bool active);
+
   /// The service participant that contains this Publication has indicated
   /// that the assocation to peer "remote" is complete.  This method will
   /// locate the Subscription object for "remote" in order to inform it
@@ -179,6 +187,11 @@ public:
   std::string dump_to_string(const std::string& prefix, int depth) const;
 
 private:
+  /// Adds the subscription to the list of associated subscriptions
+  ///  and fills in the association to send to the datawriter
+  /// Returns 0 if added, 1 if already exists, -1 other failure
+  int insert_association(DCPS_IR_Subscription* sub,
+                         OpenDDS::DCPS::ReaderAssociation& association);
 
   OpenDDS::DCPS::RepoId id_;
   DCPS_IR_Participant* participant_;
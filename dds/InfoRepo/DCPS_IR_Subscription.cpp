@@ -54,51 +54,19 @@ DCPS_IR_Subscription::~DCPS_IR_Subscription()
 {
 }
 
-int DCPS_IR_Subscription::add_associated_publication(DCPS_IR_Publication* pub,
-                                                     bool active)
+int DCPS_IR_Subscription::insert_association(DCPS_IR_Publication* pub,
+                                             OpenDDS::DCPS::WriterAssociation& association)
 {
   // keep track of the association locally
-  int status = associations_.insert(pub);
+  const int status = associations_.insert(pub);
 
   switch (status) {
-  case 0: {
-    // inform the datareader about the association
-    OpenDDS::DCPS::WriterAssociation association;
+  case 0:
     association.writerTransInfo = pub->get_transportLocatorSeq();
     association.writerId = pub->get_id();
     association.pubQos = *(pub->get_publisher_qos());
     association.writerQos = *(pub->get_datawriter_qos());
-
-    if (participant_->is_alive() && this->participant_->isOwner()) {
-      try {
-        if (OpenDDS::DCPS::DCPS_debug_level > 0) {
-          OpenDDS::DCPS::RepoIdConverter sub_converter(id_);
-          OpenDDS::DCPS::RepoIdConverter pub_converter(pub->get_id());
-          ACE_DEBUG((LM_DEBUG,
-                     ACE_TEXT("(%P|%t) DCPS_IR_Subscription::add_associated_publication:")
-                     ACE_TEXT(" subscription %C adding publication %C.\n"),
-                     std::string(sub_converter).c_str(),
-                     std::string(pub_converter).c_str()));
-        }
-
-        reader_->add_association(id_, association, active);
-
-        if (OpenDDS::DCPS::DCPS_debug_level > 0) {
-          ACE_DEBUG((LM_DEBUG,
-                     ACE_TEXT("(%P|%t) DCPS_IR_Subscription::add_associated_publication: ")
-                     ACE_TEXT("successfully added publication %x\n"),
-                     pub));
-        }
-      } catch (const CORBA::Exception& ex) {
-        ex._tao_print_exception(
-          "(%P|%t) ERROR: Exception caught in DCPS_IR_Subscription::add_associated_publication:");
-        participant_->mark_dead();
-        status = -1;
-      }
-    }
-
-  }
-  break;
+    break;
 
   case 1: {
     OpenDDS::DCPS::RepoIdConverter sub_converter(id_);
@@ -125,6 +93,88 @@ int DCPS_IR_Subscription::add_associated_publication(DCPS_IR_Publication* pub,
   return status;
 }
 
+int DCPS_IR_Subscription::add_associated_publication(DCPS_IR_Publication* pub,
+                                                     bool active)
+{
+  OpenDDS::DCPS::WriterAssociation association;
+  int status = insert_association(pub, association);
+
+  // inform the datareader about the association
+  if (status == 0 && participant_->is_alive() && this->participant_->isOwner()) {
+    try {
+      if (OpenDDS::DCPS::DCPS_debug_level > 0) {
+        OpenDDS::DCPS::RepoIdConverter sub_converter(id_);
+        OpenDDS::DCPS::RepoIdConverter pub_converter(pub->get_id());
+        ACE_DEBUG((LM_DEBUG,
+                   ACE_TEXT("(%P|%t) DCPS_IR_Subscription::add_associated_publication:")
+                   ACE_TEXT(" subscription %C adding publication %C.\n"),
+                   std::string(sub_converter).c_str(),
+                   std::string(pub_converter).c_str()));
+      }
+
+      reader_->add_association(id_, association, active);
+
+      if (OpenDDS::DCPS::DCPS_debug_level > 0) {
+        ACE_DEBUG((LM_DEBUG,
+                   ACE_TEXT("(%P|%t) DCPS_IR_Subscription::add_associated_publication: ")
+                   ACE_TEXT("successfully added publication %x\n"),
+                   pub));
+      }
+    } catch (const CORBA::Exception& ex) {
+      ex._tao_print_exception(
+        "(%P|%t) ERROR: Exception caught in DCPS_IR_Subscription::add_associated_publication:");
+      participant_->mark_dead();
+      status = -1;
+    }
+  }
+
+  return status;
+}
+
+int DCPS_IR_Subscription::add_associated_publications(const DCPS_IR_Publication_Set& pubs,
+                                                      bool active)
+{
+  OpenDDS::DCPS::WriterAssociationSeq associations(static_cast<CORBA::ULong>(pubs.size()));
+  CORBA::ULong count = 0;
+  for (DCPS_IR_Publication_Set::CONST_ITERATOR iter = pubs.begin();
+       iter != pubs.end(); ++iter) {
+    associations.length(count + 1);
+    if (insert_association(*iter, associations[count]) == 0) {
+      ++count;
+    }
+  }
+  associations.length(count);
+
+  if (count == 0 || !participant_->is_alive() || !this->participant_->isOwner()) {
+    return 0;
+  }
+
+  // inform the datareader about all of the associations at once
+  try {
+    if (OpenDDS::DCPS::DCPS_debug_level > 0) {
+      OpenDDS::DCPS::RepoIdConverter sub_converter(id_);
+      ACE_DEBUG((LM_DEBUG,
+                 ACE_TEXT("(%P|%t) DCPS_IR_Subscription::add_associated_publications:")
+                 ACE_TEXT(" subscription %C adding %u publications.\n"),
+                 std::string(sub_converter).c_str(),
+                 count));
+    }
+
+    if (count == 1) {
+      reader_->add_association(id_, associations[0], active);
+    } else {
+      reader_->add_associations(id_, associations, active);
+    }
+  } catch (const CORBA::Exception& ex) {
+    ex._tao_print_exception(
+      "(%P|%t) ERROR: Exception caught in DCPS_IR_Subscription::add_associated_publications:");
+    participant_->mark_dead();
+    return -1;
+  }
+
+  return 0;
+}
+
 void
 DCPS_IR_Subscription::association_complete(const OpenDDS::DCPS::RepoId& remote)
 {
@@ -61,6 +61,14 @@ public:
   /// Returns 0 if added, 1 if already exists, -1 other failure
   int add_associated_publication(DCPS_IR_Publication* pub, bool active);
 
+  /// Associate with each of the publications
+  /// Like add_associated_publication(), but the datareader is
+  ///  notified of all of the added publications in one call
+  /// This method can mark the participant dead
+  /// Returns -1 if the datareader couldn't be notified, otherwise 0
+  int add_associated_publications(const DCPS_IR_Publication_Set& pubs,
+                                  bool active);
+
   /// The service participant that contains this Subscription has indicated
   /// that the assocation to peer "remote" is complete.  This method will
   /// locate the Publication object for "remote" in order to inform it
@@ -187,6 +195,12 @@ public:
   std::string dump_to_string(const std::string& prefix, int depth) const;
 
 private:
+  /// Adds the publication to the list of associated publications
+  ///  and fills in the association to send to the datareader
+  /// Returns 0 if added, 1 if already exists, -1 other failure
+  int insert_association(DCPS_IR_Publication* pub,
+                         OpenDDS::DCPS::WriterAssociation& association);
+
   OpenDDS::DCPS::RepoId id_;
   DCPS_IR_Participant* participant_;
   DCPS_IR_Topic* topic_;
@@ -81,12 +81,13 @@ public:
   int remove_subscription_reference(DCPS_IR_Subscription* subscription);
 
   /// Called by the DCPS_IR_Topic_Description
-  /// Find any compatible publications and associate
-  ///  them using the DCPS_IR_Topic_Description's
-  ///  associate method.
+  /// Find any compatible publications and add them to
+  ///  matched, for the DCPS_IR_Topic_Description to
+  ///  associate them all at once.
   /// This method does not check the subscription's incompatible
   ///  qos status.
-  void try_associate(DCPS_IR_Subscription* subscription);
+  void try_associate(DCPS_IR_Subscription* subscription,
+                     DCPS_IR_Publication_Set& matched);
 
   /// Called by the DCPS_IR_Topic_Description to re-evaluate the
   /// association between the publications of this topic and the
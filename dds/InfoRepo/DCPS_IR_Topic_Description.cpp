@@ -210,13 +210,17 @@ void DCPS_IR_Topic_Description::try_associate_publication(DCPS_IR_Publication* p
   DCPS_IR_Subscription* subscription = 0;
   OpenDDS::DCPS::IncompatibleQosStatus* qosStatus = 0;
 
+  DCPS_IR_Subscription_Set matched;
+
   DCPS_IR_Subscription_Set::ITERATOR iter = subscriptionRefs_.begin();
   DCPS_IR_Subscription_Set::ITERATOR end = subscriptionRefs_.end();
 
   while (iter != end) {
     subscription = *iter;
     ++iter;
-    try_associate(publication, subscription);
+    if (compatible(publication, subscription)) {
+      matched.insert_tail(subscription);
+    }
 
     // Check the subscriptions QOS status
     qosStatus = subscription->get_incompatibleQosStatus();
@@ -226,6 +230,8 @@ void DCPS_IR_Topic_Description::try_associate_publication(DCPS_IR_Publication* p
     }
   }
 
+  associate(publication, matched);
+
   // Check the publications QOS status
   qosStatus = publication->get_incompatibleQosStatus();
 
@@ -239,6 +245,7 @@ void DCPS_IR_Topic_Description::try_associate_subscription(DCPS_IR_Subscription*
   // check all topics for compatible publications
 
   DCPS_IR_Topic* topic = 0;
+  DCPS_IR_Publication_Set matched;
 
   DCPS_IR_Topic_Set::ITERATOR iter = topics_.begin();
   DCPS_IR_Topic_Set::ITERATOR end = topics_.end();
@@ -247,9 +254,11 @@ void DCPS_IR_Topic_Description::try_associate_subscription(DCPS_IR_Subscription*
     topic = *iter;
     ++iter;
 
-    topic->try_associate(subscription);
+    topic->try_associate(subscription, matched);
   }
 
+  associate(matched, subscription);
+
   // Check the subscriptions QOS status
   OpenDDS::DCPS::IncompatibleQosStatus* qosStatus =
     subscription->get_incompatibleQosStatus();
@@ -273,6 +282,17 @@ void DCPS_IR_Topic_Description::try_associate_subscription(DCPS_IR_Subscription*
 bool
 DCPS_IR_Topic_Description::try_associate(DCPS_IR_Publication* publication,
                                          DCPS_IR_Subscription* subscription)
+{
+  if (compatible(publication, subscription)) {
+    associate(publication, subscription);
+    return true;
+  }
+  return false;
+}
+
+bool
+DCPS_IR_Topic_Description::compatible(DCPS_IR_Publication* publication,
+                                      DCPS_IR_Subscription* subscription)
 {
   if (publication->is_subscription_ignored(subscription->get_participant_id(),
                                            subscription->get_topic_id(),
@@ -324,7 +344,6 @@ DCPS_IR_Topic_Description::try_associate(DCPS_IR_Publication* publication,
                                      subscription->get_datareader_qos(),
                                      publication->get_publisher_qos(),
                                      subscription->get_subscriber_qos())) {
-      associate(publication, subscription);
       return true;
     }
 
@@ -371,6 +390,85 @@ void DCPS_IR_Topic_Description::associate(DCPS_IR_Publication* publication,
   }
 }
 
+void DCPS_IR_Topic_Description::associate(DCPS_IR_Publication* publication,
+                                          const DCPS_IR_Subscription_Set& subscriptions)
+{
+  if (subscriptions.is_empty()) {
+    return;
+  }
+
+  if (!this->domain_->batchAssociations()) {
+    for (DCPS_IR_Subscription_Set::CONST_ITERATOR iter = subscriptions.begin();
+         iter != subscriptions.end(); ++iter) {
+      associate(publication, *iter);
+    }
+    return;
+  }
+
+  if (OpenDDS::DCPS::DCPS_debug_level > 0) {
+    OpenDDS::DCPS::RepoIdConverter pub_converter(publication->get_id());
+    ACE_DEBUG((LM_DEBUG,
+               ACE_TEXT("(%P|%t) DCPS_IR_Topic_Description::associate: ")
+               ACE_TEXT("topic description %C associating ")
+               ACE_TEXT("publication %C with %u subscriptions.\n"),
+               this->name_.c_str(),
+               std::string(pub_converter).c_str(),
+               static_cast<unsigned int>(subscriptions.size())));
+  }
+
+  // As in associate() for one subscription, the publication is told
+  // first, here about all of the subscriptions at once.
+  if (publication->add_associated_subscriptions(subscriptions, true) != -1) {
+    for (DCPS_IR_Subscription_Set::CONST_ITERATOR iter = subscriptions.begin();
+         iter != subscriptions.end(); ++iter) {
+      (*iter)->add_associated_publication(publication, false);
+    }
+  } else {
+    ACE_DEBUG((LM_INFO, ACE_TEXT("Invalid publication detected, NOT notifying subscriptions of association\n")));
+  }
+}
+
+void DCPS_IR_Topic_Description::associate(const DCPS_IR_Publication_Set& publications,
+                                          DCPS_IR_Subscription* subscription)
+{
+  if (publications.is_empty()) {
+    return;
+  }
+
+  if (!this->domain_->batchAssociations()) {
+    for (DCPS_IR_Publication_Set::CONST_ITERATOR iter = publications.begin();
+         iter != publications.end(); ++iter) {
+      associate(*iter, subscription);
+    }
+    return;
+  }
+
+  if (OpenDDS::DCPS::DCPS_debug_level > 0) {
+    OpenDDS::DCPS::RepoIdConverter sub_converter(subscription->get_id());
+    ACE_DEBUG((LM_DEBUG,
+               ACE_TEXT("(%P|%t) DCPS_IR_Topic_Description::associate: ")
+               ACE_TEXT("topic description %C associating ")
+               ACE_TEXT("%u publications with subscription %C.\n"),
+               this->name_.c_str(),
+               static_cast<unsigned int>(publications.size()),
+               std::string(sub_converter).c_str()));
+  }
+
+  // Each publication is told first, then the subscription about all of
+  // the publications that could be told at once.
+  DCPS_IR_Publication_Set told;
+  for (DCPS_IR_Publication_Set::CONST_ITERATOR iter = publications.begin();
+       iter != publications.end(); ++iter) {
+    if ((*iter)->add_associated_subscription(subscription, true) != -1) {
+      told.insert_tail(*iter);
+    } else {
+      ACE_DEBUG((LM_INFO, ACE_TEXT("Invalid publication detected, NOT notifying subscription of association\n")));
+    }
+  }
+
+  subscription->add_associated_publications(told, false);
+}
+
 void DCPS_IR_Topic_Description::reevaluate_associations(DCPS_IR_Subscription* subscription)
 {
   DCPS_IR_Topic* topic = 0;
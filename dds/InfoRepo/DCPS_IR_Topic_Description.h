@@ -26,6 +26,7 @@ OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
 // forward declarations
 class DCPS_IR_Publication;
+typedef ACE_Unbounded_Set<DCPS_IR_Publication*> DCPS_IR_Publication_Set;
 class DCPS_IR_Domain;
 
 class DCPS_IR_Subscription;
@@ -84,14 +85,29 @@ public:
   void try_associate_subscription(DCPS_IR_Subscription* subscription);
 
   /// Checks to see if the publication and subscription can
-  ///  be associated.
+  ///  be associated, and associates them if so.
   bool try_associate(DCPS_IR_Publication* publication,
                      DCPS_IR_Subscription* subscription);
 
+  /// Checks to see if the publication and subscription can
+  ///  be associated.
+  bool compatible(DCPS_IR_Publication* publication,
+                  DCPS_IR_Subscription* subscription);
+
   /// Associate the publication and subscription
   void associate(DCPS_IR_Publication* publication,
                  DCPS_IR_Subscription* subscription);
 
+  /// Associate the publication with each of the subscriptions,
+  ///  notifying its datawriter once if the domain batches associations
+  void associate(DCPS_IR_Publication* publication,
+                 const DCPS_IR_Subscription_Set& subscriptions);
+
+  /// Associate each of the publications with the subscription,
+  ///  notifying its datareader once if the domain batches associations
+  void associate(const DCPS_IR_Publication_Set& publications,
+                 DCPS_IR_Subscription* subscription);
+
   /// Re-evaluate the association between the provided publication and
   /// the subscriptions it maintains.
   void reevaluate_associations(DCPS_IR_Publication* publication);
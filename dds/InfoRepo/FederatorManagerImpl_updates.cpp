@@ -1247,141 +1247,158 @@ ManagerImpl::pushState(Manager_ptr peer)
   //   foreach DCPS_IR_Participant
   //     peer->initializeParticipant(...)
   //     peer->initializeOwner(...)
-  //   foreach DCPS_IR_Participant
-  //     foreach DCPS_IR_Topic
-  //       peer->initializeTopic(...)
-  //     foreach DCPS_IR_Publication
-  //       peer->initializePublication(...)
-  //     foreach DCPS_IR_Subscription
-  //       peer->initializeSubscription(...)
-
-  // Process each domain within the repository.
-  for (DCPS_IR_Domain_Map::const_iterator currentDomain
-       = this->info_->domains().begin();
-       currentDomain != this->info_->domains().end();
-       ++currentDomain) {
-
-    if (currentDomain->second->get_id() == this->config_.federationDomain()) {
-      // Do not push the Federation domain publications.
-      //continue;
-    }
-
-    // Process each participant within the current domain.
-    for (DCPS_IR_Participant_Map::const_iterator currentParticipant
-         = currentDomain->second->participants().begin();
-         currentParticipant != currentDomain->second->participants().end();
-         ++currentParticipant) {
+  //   foreach DCPS_IR_Topic of each DCPS_IR_Participant
+  //     peer->initializeTopic(...)
+  //   foreach DCPS_IR_Publication of each DCPS_IR_Participant
+  //     peer->initializePublication(...)
+  //   foreach DCPS_IR_Subscription of each DCPS_IR_Participant
+  //     peer->initializeSubscription(...)
+
+  // Process each domain within the repository.  The samples are
+  // collected while the domain is locked and pushed to the peer after.
+  std::vector<DDS::DomainId_t> domainIds;
+  this->info_->domain_ids(domainIds);
+
+  for (size_t i = 0; i < domainIds.size(); ++i) {
+    std::vector<ParticipantUpdate> participantSamples;
+    std::vector<OwnerUpdate> ownerSamples;
+    std::vector<TopicUpdate> topicSamples;
+    std::vector<PublicationUpdate> publicationSamples;
+    std::vector<SubscriptionUpdate> subscriptionSamples;
 
-      if (currentParticipant->second->isBitPublisher() == true) {
-        // Do not push the built-in topic publications.
+    {
+      TAO_DDS_DCPSInfo_i::DomainGuard guard(*this->info_, domainIds[i]);
+      DCPS_IR_Domain* const currentDomain = guard.domain();
+      if (!currentDomain) {
         continue;
       }
 
-      // Initialize the participant on the peer.
-      ParticipantUpdate participantSample;
-      participantSample.sender = this->id().id();
-      participantSample.action = CreateEntity;
-
-      participantSample.owner  =  currentParticipant->second->owner();
-      participantSample.domain =  currentDomain->second->get_id();
-      participantSample.id     =  currentParticipant->second->get_id();
-      participantSample.qos    = *currentParticipant->second->get_qos();
-
-      peer->initializeParticipant(participantSample);
-
-      // Initialize the ownership of the participant on the peer.
-      OwnerUpdate ownerSample;
-      ownerSample.sender      = this->id().id();
-      ownerSample.action      = CreateEntity;
+      if (currentDomain->get_id() == this->config_.federationDomain()) {
+        // Do not push the Federation domain publications.
+        //continue;
+      }
 
-      ownerSample.domain      = currentDomain->second->get_id();
-      ownerSample.participant = currentParticipant->second->get_id();
-      ownerSample.owner       = currentParticipant->second->owner();
+      CORBA::ORB_var orb = this->info_->orb();
 
-      peer->initializeOwner(ownerSample);
-    }
+      // Process each participant within the current domain.
+      for (DCPS_IR_Participant_Map::const_iterator currentParticipant
+           = currentDomain->participants().begin();
+           currentParticipant != currentDomain->participants().end();
+           ++currentParticipant) {
 
-    // Process each participant within the current domain.
-    for (DCPS_IR_Participant_Map::const_iterator currentParticipant
-         = currentDomain->second->participants().begin();
-         currentParticipant != currentDomain->second->participants().end();
-         ++currentParticipant) {
+        if (currentParticipant->second->isBitPublisher() == true) {
+          // Do not push the built-in topic publications.
+          continue;
+        }
 
-      if (currentParticipant->second->isBitPublisher() == true) {
-        // Do not push the built-in topic publications.
-        continue;
-      }
+        // Initialize the participant on the peer.
+        ParticipantUpdate participantSample;
+        participantSample.sender = this->id().id();
+        participantSample.action = CreateEntity;
+
+        participantSample.owner  =  currentParticipant->second->owner();
+        participantSample.domain =  currentDomain->get_id();
+        participantSample.id     =  currentParticipant->second->get_id();
+        participantSample.qos    = *currentParticipant->second->get_qos();
+
+        participantSamples.push_back(participantSample);
+
+        // Initialize the ownership of the participant on the peer.
+        OwnerUpdate ownerSample;
+        ownerSample.sender      = this->id().id();
+        ownerSample.action      = CreateEntity;
+
+        ownerSample.domain      = currentDomain->get_id();
+        ownerSample.participant = currentParticipant->second->get_id();
+        ownerSample.owner       = currentParticipant->second->owner();
+
+        ownerSamples.push_back(ownerSample);
+
+        // Process each topic within the current particpant.
+        for (DCPS_IR_Topic_Map::const_iterator currentTopic
+             = currentParticipant->second->topics().begin();
+             currentTopic != currentParticipant->second->topics().end();
+             ++currentTopic) {
+          TopicUpdate topicSample;
+          topicSample.sender      = this->id().id();
+          topicSample.action      = CreateEntity;
+
+          topicSample.id          = currentTopic->second->get_id();
+          topicSample.domain      = currentDomain->get_id();
+          topicSample.participant = currentTopic->second->get_participant_id();
+          topicSample.topic       = currentTopic->second->get_topic_description()->get_name();
+          topicSample.datatype    = currentTopic->second->get_topic_description()->get_dataTypeName();
+          topicSample.qos         = *currentTopic->second->get_topic_qos();
+
+          topicSamples.push_back(topicSample);
+        }
 
-      // Process each topic within the current particpant.
-      for (DCPS_IR_Topic_Map::const_iterator currentTopic
-           = currentParticipant->second->topics().begin();
-           currentTopic != currentParticipant->second->topics().end();
-           ++currentTopic) {
-        TopicUpdate topicSample;
-        topicSample.sender      = this->id().id();
-        topicSample.action      = CreateEntity;
-
-        topicSample.id          = currentTopic->second->get_id();
-        topicSample.domain      = currentDomain->second->get_id();
-        topicSample.participant = currentTopic->second->get_participant_id();
-        topicSample.topic       = currentTopic->second->get_topic_description()->get_name();
-        topicSample.datatype    = currentTopic->second->get_topic_description()->get_dataTypeName();
-        topicSample.qos         = *currentTopic->second->get_topic_qos();
-
-        peer->initializeTopic(topicSample);
-      }
+        // Process each publication within the current particpant.
+        for (DCPS_IR_Publication_Map::const_iterator currentPublication
+             = currentParticipant->second->publications().begin();
+             currentPublication != currentParticipant->second->publications().end();
+             ++currentPublication) {
+          PublicationUpdate publicationSample;
+          publicationSample.sender         = this->id().id();
+          publicationSample.action         = CreateEntity;
+
+          DCPS_IR_Publication* p = currentPublication->second.get();
+          CORBA::String_var callback = orb->object_to_string(p->writer());
+
+          publicationSample.domain         = currentDomain->get_id();
+          publicationSample.participant    = p->get_participant_id();
+          publicationSample.topic          = p->get_topic_id();
+          publicationSample.id             = p->get_id();
+          publicationSample.callback       = callback.in();
+          publicationSample.datawriter_qos = *p->get_datawriter_qos();
+          publicationSample.publisher_qos  = *p->get_publisher_qos();
+          publicationSample.transport_info = p->get_transportLocatorSeq();
+
+          publicationSamples.push_back(publicationSample);
+        }
 
-      // Process each publication within the current particpant.
-      for (DCPS_IR_Publication_Map::const_iterator currentPublication
-           = currentParticipant->second->publications().begin();
-           currentPublication != currentParticipant->second->publications().end();
-           ++currentPublication) {
-        PublicationUpdate publicationSample;
-        publicationSample.sender         = this->id().id();
-        publicationSample.action         = CreateEntity;
-
-        DCPS_IR_Publication* p = currentPublication->second.get();
-        CORBA::ORB_var orb = this->info_->orb();
-        CORBA::String_var callback = orb->object_to_string(p->writer());
-
-        publicationSample.domain         = currentDomain->second->get_id();
-        publicationSample.participant    = p->get_participant_id();
-        publicationSample.topic          = p->get_topic_id();
-        publicationSample.id             = p->get_id();
-        publicationSample.callback       = callback.in();
-        publicationSample.datawriter_qos = *p->get_datawriter_qos();
-        publicationSample.publisher_qos  = *p->get_publisher_qos();
-        publicationSample.transport_info = p->get_transportLocatorSeq();
-
-        peer->initializePublication(publicationSample);
+        // Process each subscription within the current particpant.
+        for (DCPS_IR_Subscription_Map::const_iterator currentSubscription
+             = currentParticipant->second->subscriptions().begin();
+             currentSubscription != currentParticipant->second->subscriptions().end();
+             ++currentSubscription) {
+          SubscriptionUpdate subscriptionSample;
+          subscriptionSample.sender         = this->id().id();
+          subscriptionSample.action         = CreateEntity;
+
+          DCPS_IR_Subscription* s = currentSubscription->second.get();
+          CORBA::String_var callback = orb->object_to_string(s->reader());
+
+          subscriptionSample.domain         = currentDomain->get_id();
+          subscriptionSample.participant    = s->get_participant_id();
+          subscriptionSample.topic          = s->get_topic_id();
+          subscriptionSample.id             = s->get_id();
+          subscriptionSample.callback       = callback.in();
+          subscriptionSample.datareader_qos = *s->get_datareader_qos();
+          subscriptionSample.subscriber_qos = *s->get_subscriber_qos();
+          subscriptionSample.transport_info = s->get_transportLocatorSeq();
+          subscriptionSample.filter_expression = s->get_filter_expression().c_str();
+          subscriptionSample.expression_params = s->get_expr_params();
+
+          subscriptionSamples.push_back(subscriptionSample);
+        }
       }
+    }
 
-      // Process each subscription within the current particpant.
-      for (DCPS_IR_Subscription_Map::const_iterator currentSubscription
-           = currentParticipant->second->subscriptions().begin();
-           currentSubscription != currentParticipant->second->subscriptions().end();
-           ++currentSubscription) {
-        SubscriptionUpdate subscriptionSample;
-        subscriptionSample.sender         = this->id().id();
-        subscriptionSample.action         = CreateEntity;
-
-        DCPS_IR_Subscription* s = currentSubscription->second.get();
-        CORBA::ORB_var orb = this->info_->orb();
-        CORBA::String_var callback = orb->object_to_string(s->reader());
-
-        subscriptionSample.domain         = currentDomain->second->get_id();
-        subscriptionSample.participant    = s->get_participant_id();
-        subscriptionSample.topic          = s->get_topic_id();
-        subscriptionSample.id             = s->get_id();
-        subscriptionSample.callback       = callback.in();
-        subscriptionSample.datareader_qos = *s->get_datareader_qos();
-        subscriptionSample.subscriber_qos = *s->get_subscriber_qos();
-        subscriptionSample.transport_info = s->get_transportLocatorSeq();
-        subscriptionSample.filter_expression = s->get_filter_expression().c_str();
-        subscriptionSample.expression_params = s->get_expr_params();
-
-        peer->initializeSubscription(subscriptionSample);
-      }
+    // The peer is called without the domain's lock, and is told about
+    // the participants before their topics and endpoints.
+    for (size_t j = 0; j < participantSamples.size(); ++j) {
+      peer->initializeParticipant(participantSamples[j]);
+      peer->initializeOwner(ownerSamples[j]);
+    }
+    for (size_t j = 0; j < topicSamples.size(); ++j) {
+      peer->initializeTopic(topicSamples[j]);
+    }
+    for (size_t j = 0; j < publicationSamples.size(); ++j) {
+      peer->initializePublication(publicationSamples[j]);
+    }
+    for (size_t j = 0; j < subscriptionSamples.size(); ++j) {
+      peer->initializeSubscription(subscriptionSamples[j]);
     }
   }
 }
@@ -38,6 +38,8 @@ Manager::add(TAO_DDS_DCPSInfo_i* info)
 void
 Manager::add(Updater* updater)
 {
+  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, lock_);
+
   // push new element to the back.
   updaters_.insert(updater);
 }
@@ -52,6 +54,8 @@ Manager::remove()
 void
 Manager::remove(const Updater* updater)
 {
+  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, lock_);
+
   // check if the Updaters is part of the list.
   Updaters::iterator iter = updaters_.find(const_cast<Updater*>(updater));
 
@@ -292,6 +296,8 @@ Manager::pushImage(const DImage& image)
 void
 Manager::destroy(const IdPath& id, ItemType type, ActorType actor)
 {
+  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, lock_);
+
   // Invoke remove on each of the iterators.
   for (Updaters::iterator iter = updaters_.begin();
        iter != updaters_.end();
@@ -400,6 +406,8 @@ Manager::add(const DActor& actor)
 
 void Manager::updateLastPartId(PartIdType partId)
 {
+  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, lock_);
+
   for (Updaters::iterator iter = updaters_.begin();
        iter != updaters_.end();
        iter++) {
@@ -407,6 +415,23 @@ void Manager::updateLastPartId(PartIdType partId)
   }
 }
 
+void Manager::sync()
+{
+  // Updaters are removed before they are finalized, and the repository
+  // is shut down before they are.
+  std::vector<Updater*> updaters;
+  {
+    ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, lock_);
+    updaters.assign(updaters_.begin(), updaters_.end());
+  }
+
+  for (std::vector<Updater*>::iterator iter = updaters.begin();
+       iter != updaters.end();
+       ++iter) {
+    (*iter)->sync();
+  }
+}
+
 } // namespace Update
 
 
@@ -19,6 +19,7 @@
 
 #include "ace/Service_Object.h"
 #include "ace/Service_Config.h"
+#include "ace/Recursive_Thread_Mutex.h"
 
 #include <set>
 
@@ -79,6 +80,10 @@ public:
   /// Update Last Participant Id for the repo
   virtual void updateLastPartId(PartIdType partId);
 
+  /// Wait until the updaters persisted what the calling thread
+  /// propagated.  The manager's lock is not held while waiting.
+  void sync();
+
 private:
   typedef std::set <Updater*> Updaters;
 
@@ -87,6 +92,9 @@ private:
 
   TAO_DDS_DCPSInfo_i* info_;
   Updaters updaters_;
+
+  /// The repository calls the updaters from each of its ORB threads.
+  ACE_Recursive_Thread_Mutex lock_;
 };
 
 } // End of namespace Update
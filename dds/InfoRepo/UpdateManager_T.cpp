@@ -11,6 +11,8 @@ template<class UType>
 void
 Update::Manager::create(const UType& info)
 {
+  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, lock_);
+
   // Invoke add on each of the iterators.
   for (Updaters::iterator iter = updaters_.begin();
        iter != updaters_.end();
@@ -23,6 +25,8 @@ template<class QosType>
 void
 Update::Manager::update(const Update::IdPath& id, const QosType& qos)
 {
+  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, lock_);
+
   // Invoke update on each of the iterators.
   for (Updaters::iterator iter = updaters_.begin();
        iter != updaters_.end();
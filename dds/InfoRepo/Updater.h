@@ -56,6 +56,11 @@ public:
   virtual void updateLastPartId(PartIdType partId) {
     ACE_UNUSED_ARG(partId);
   };
+
+  /// Wait until what the calling thread propagated is persisted.  Called
+  /// once the thread holds none of the repository's locks, so that the
+  /// updates of other threads can be persisted with its own.
+  virtual void sync() {};
 };
 
 inline
@@ -0,0 +1,1252 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "DcpsInfo_pch.h"
+
+#include "WalPersistenceUpdater.h"
+#include "UpdateManager.h"
+#include "ArrDelAdapter.h"
+
+#include "dds/DCPS/RepoIdConverter.h"
+#include "dds/DCPS/debug.h"
+
+#include "tao/CDR.h"
+
+#include "ace/ACE.h"
+#include "ace/Dynamic_Service.h"
+#include "ace/OS_NS_fcntl.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_stdlib.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_strings.h"
+#include "ace/OS_NS_sys_time.h"
+#include "ace/OS_NS_Thread.h"
+#include "ace/OS_NS_unistd.h"
+#include "ace/Reverse_Lock_T.h"
+
+#include <vector>
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace {
+  // Both files start with a magic number, a version and a sequence
+  // number, followed by records framed by their length and CRC-32.  A
+  // record is the new state of an entity, its removal or the last
+  // participant id.  Records are numbered in the order they are appended:
+  // a snapshot's header holds the number of the last record it includes,
+  // and the log's the number of the record before its first.  A log left
+  // by a crash before it was started again after a snapshot holds records
+  // older than the snapshot's state (an erase of an entity created again
+  // since, for instance), so recovery only replays the records after the
+  // snapshot's.
+  const char LOG_MAGIC[4] = { 'O', 'D', 'W', 'L' };
+  const char SNAPSHOT_MAGIC[4] = { 'O', 'D', 'W', 'S' };
+  const ACE_UINT32 VERSION = 1;
+  const size_t HEADER_SIZE = 16;
+  const size_t FRAME_SIZE = 8;
+
+  enum RecordKind {
+    PUT_TOPIC = 1,
+    PUT_PARTICIPANT,
+    PUT_ACTOR,
+    ERASE,
+    LAST_PART_ID
+  };
+
+  void put_ulong(std::string& out, ACE_UINT32 value)
+  {
+    for (int i = 0; i < 4; ++i) {
+      out += static_cast<char>((value >> (8 * i)) & 0xff);
+    }
+  }
+
+  ACE_UINT32 get_ulong(const char* in)
+  {
+    ACE_UINT32 value = 0;
+    for (int i = 0; i < 4; ++i) {
+      value |= static_cast<ACE_UINT32>(static_cast<unsigned char>(in[i])) << (8 * i);
+    }
+    return value;
+  }
+
+  std::string header(const char (&magic)[4], ACE_UINT64 seq)
+  {
+    std::string out(magic, sizeof magic);
+    put_ulong(out, VERSION);
+    put_ulong(out, static_cast<ACE_UINT32>(seq & 0xffffffff));
+    put_ulong(out, static_cast<ACE_UINT32>(seq >> 32));
+    return out;
+  }
+
+  bool check_header(const std::string& data, const char (&magic)[4],
+                    ACE_UINT64& seq)
+  {
+    if (data.size() < HEADER_SIZE ||
+        ACE_OS::memcmp(data.data(), magic, sizeof magic) != 0 ||
+        get_ulong(data.data() + sizeof magic) != VERSION) {
+      return false;
+    }
+    seq = get_ulong(data.data() + 8) |
+      static_cast<ACE_UINT64>(get_ulong(data.data() + 12)) << 32;
+    return true;
+  }
+
+  /// Builds the payload of one record.
+  class RecordWriter {
+  public:
+    explicit RecordWriter(RecordKind kind)
+    {
+      payload_ += static_cast<char>(kind);
+    }
+
+    void octet(unsigned char value) { payload_ += static_cast<char>(value); }
+    void ulong(ACE_UINT32 value) { put_ulong(payload_, value); }
+
+    void id(const Update::IdType& value)
+    {
+      payload_.append(reinterpret_cast<const char*>(&value), sizeof value);
+    }
+
+    void bytes(const std::string& value)
+    {
+      ulong(static_cast<ACE_UINT32>(value.size()));
+      payload_ += value;
+    }
+
+    /// Append the framed record to out.
+    void frame(std::string& out) const
+    {
+      put_ulong(out, static_cast<ACE_UINT32>(payload_.size()));
+      put_ulong(out, ACE::crc32(payload_.data(), payload_.size()));
+      out += payload_;
+    }
+
+  private:
+    std::string payload_;
+  };
+
+  /// Reads the payload of one record.
+  class RecordReader {
+  public:
+    RecordReader(const char* data, size_t length)
+      : pos_(data), end_(data + length), ok_(true) {}
+
+    unsigned char octet()
+    {
+      if (!need(1)) {
+        return 0;
+      }
+      return static_cast<unsigned char>(*pos_++);
+    }
+
+    ACE_UINT32 ulong()
+    {
+      if (!need(4)) {
+        return 0;
+      }
+      const ACE_UINT32 value = get_ulong(pos_);
+      pos_ += 4;
+      return value;
+    }
+
+    Update::IdType id()
+    {
+      Update::IdType value = OpenDDS::DCPS::GUID_UNKNOWN;
+      if (need(sizeof value)) {
+        ACE_OS::memcpy(&value, pos_, sizeof value);
+        pos_ += sizeof value;
+      }
+      return value;
+    }
+
+    std::string bytes()
+    {
+      const ACE_UINT32 length = ulong();
+      if (!need(length)) {
+        return std::string();
+      }
+      const std::string value(pos_, length);
+      pos_ += length;
+      return value;
+    }
+
+    /// Everything was read, and nothing is left.
+    bool ok() const { return ok_ && pos_ == end_; }
+
+  private:
+    bool need(size_t length)
+    {
+      if (ok_ && static_cast<size_t>(end_ - pos_) < length) {
+        ok_ = false;
+      }
+      return ok_;
+    }
+
+    const char* pos_;
+    const char* end_;
+    bool ok_;
+  };
+
+  template <typename T>
+  std::string to_cdr(const T& value)
+  {
+    TAO_OutputCDR outCdr;
+    outCdr << value;
+    ACE_Message_Block dst;
+    ACE_CDR::consolidate(&dst, outCdr.begin());
+    return std::string(dst.base(), dst.length());
+  }
+
+  bool read_file(const std::string& path, std::string& data)
+  {
+    data.clear();
+    FILE* const file = ACE_OS::fopen(path.c_str(), ACE_TEXT("rb"));
+    if (!file) {
+      return false;
+    }
+    char block[64 * 1024];
+    size_t n;
+    while ((n = ACE_OS::fread(block, 1, sizeof block, file)) > 0) {
+      data.append(block, n);
+    }
+    ACE_OS::fclose(file);
+    return true;
+  }
+
+  bool write_all(ACE_HANDLE handle, const std::string& data)
+  {
+    return data.empty() ||
+      ACE::write_n(handle, data.data(), data.size()) == static_cast<ssize_t>(data.size());
+  }
+
+  /// A copy of the bytes in a buffer aligned for CDR, kept in buffers.
+  Update::BinSeq bin(const std::string& data,
+                     std::vector<ArrDelAdapter<char> >& buffers)
+  {
+    char* buf = new char[data.size() ? data.size() : 1];
+    buffers.push_back(ArrDelAdapter<char>(buf));
+    ACE_OS::memcpy(buf, data.data(), data.size());
+    return Update::BinSeq(data.size(), buf);
+  }
+}
+
+namespace Update {
+
+WalPersistenceUpdater::WalPersistenceUpdater()
+  : persistence_file_(ACE_TEXT("InforepoWal"))
+  , reset_(false)
+  , write_behind_(false)
+  , commit_interval_(0, 10000)
+  , commit_bytes_(64 * 1024)
+  , snapshot_records_(10000)
+  , um_(0)
+  , work_(lock_)
+  , committed_(lock_)
+  , last_part_id_(0)
+  , pending_records_(0)
+  , appended_(0)
+  , committed_seq_(0)
+  , attempted_seq_(0)
+  , commits_(0)
+  , log_records_(0)
+  , log_(ACE_INVALID_HANDLE)
+  , flush_requested_(false)
+  , failed_(false)
+  , shutdown_(false)
+  , running_(false)
+{}
+
+WalPersistenceUpdater::~WalPersistenceUpdater()
+{
+  this->fini();
+}
+
+int
+WalPersistenceUpdater::init(int argc, ACE_TCHAR *argv[])
+{
+  // discover the UpdateManager
+  um_ = ACE_Dynamic_Service<Update::Manager>::instance("UpdateManagerSvc");
+
+  if (um_ == 0) {
+    ACE_ERROR((LM_ERROR, ACE_TEXT("(%P|%t) ERROR: WalPersistenceUpdater::init ")
+               ACE_TEXT("No UpdateManager discovered.\n")));
+    return -1;
+  }
+
+  if (this->parse(argc, argv) != 0) {
+    return -1;
+  }
+
+  if (reset_) {
+    ACE_OS::unlink(snapshotPath().c_str());
+    ACE_OS::unlink(logPath().c_str());
+  }
+
+  if (!this->recover()) {
+    return -1;
+  }
+
+  if (this->activate(THR_NEW_LWP | THR_JOINABLE, 1) != 0) {
+    ACE_ERROR((LM_ERROR, ACE_TEXT("(%P|%t) ERROR: WalPersistenceUpdater::init ")
+               ACE_TEXT("failed to start the commit thread %p\n"),
+               ACE_TEXT("activate")));
+    return -1;
+  }
+  running_ = true;
+
+  // lastly register the callback
+  um_->add(this);
+
+  return 0;
+}
+
+int
+WalPersistenceUpdater::parse(int argc, ACE_TCHAR *argv[])
+{
+  for (ssize_t count = 0; count < argc; count++) {
+    if (ACE_OS::strcasecmp(argv[count], ACE_TEXT("-file")) == 0) {
+      if ((count + 1) < argc) {
+        persistence_file_ = argv[count+1];
+        count++;
+      }
+
+    } else if (ACE_OS::strcasecmp(argv[count], ACE_TEXT("-reset")) == 0) {
+      if ((count + 1) < argc) {
+        reset_ = ACE_OS::atoi(argv[count+1]) != 0;
+        count++;
+      }
+
+    } else if (ACE_OS::strcasecmp(argv[count], ACE_TEXT("-write_behind")) == 0) {
+      if ((count + 1) < argc) {
+        write_behind_ = ACE_OS::atoi(argv[count+1]) != 0;
+        count++;
+      }
+
+    } else if (ACE_OS::strcasecmp(argv[count], ACE_TEXT("-commit_interval")) == 0) {
+      if ((count + 1) < argc) {
+        commit_interval_.msec(static_cast<long>(ACE_OS::atoi(argv[count+1])));
+        count++;
+      }
+
+    } else if (ACE_OS::strcasecmp(argv[count], ACE_TEXT("-commit_bytes")) == 0) {
+      if ((count + 1) < argc) {
+        commit_bytes_ = ACE_OS::atoi(argv[count+1]);
+        count++;
+      }
+
+    } else if (ACE_OS::strcasecmp(argv[count], ACE_TEXT("-snapshot_records")) == 0) {
+      if ((count + 1) < argc) {
+        snapshot_records_ = ACE_OS::atoi(argv[count+1]);
+        count++;
+      }
+
+    } else {
+      ACE_DEBUG((LM_DEBUG, ACE_TEXT("(%P|%t) WalPersistenceUpdater::parse: Unknown option %s\n")
+                 , argv[count]));
+      return -1;
+    }
+  }
+
+  return 0;
+}
+
+int
+WalPersistenceUpdater::fini()
+{
+  if (running_) {
+    // No update may be appended once the commit thread is gone.
+    if (um_) {
+      um_->remove(this);
+    }
+
+    {
+      ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, lock_, -1);
+      shutdown_ = true;
+      work_.signal();
+    }
+    // The commit thread commits the pending records before it exits.
+    this->wait();
+    running_ = false;
+  }
+
+  if (log_ != ACE_INVALID_HANDLE) {
+    ACE_OS::close(log_);
+    log_ = ACE_INVALID_HANDLE;
+  }
+
+  return 0;
+}
+
+int
+WalPersistenceUpdater::svc()
+{
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, lock_, -1);
+  ACE_Reverse_Lock<ACE_Thread_Mutex> unlocked(lock_);
+
+  for (;;) {
+    while (pending_records_ == 0 && !shutdown_) {
+      work_.wait();
+    }
+
+    if (pending_records_ == 0) {
+      break;
+    }
+
+    // Group commit: when writing behind, gather what is appended until
+    // the oldest pending record has waited commit_interval_.  Otherwise
+    // the operations are waiting in sync(), so commit right away; what
+    // is appended while a commit is written goes in the next one.
+    const ACE_Time_Value deadline = pending_since_ + commit_interval_;
+    while (write_behind_ && !shutdown_ && !flush_requested_ &&
+           pending_.size() < commit_bytes_) {
+      if (work_.wait(&deadline) == -1) {
+        break;
+      }
+    }
+
+    // A snapshot replaces a log that has grown larger than the state,
+    // and one that is missing records because writing it failed.
+    const size_t records = log_records_ + pending_records_;
+    const bool snapshot = failed_ ||
+      (records >= snapshot_records_ && records >= topics_.size() +
+       participants_.size() + actors_.size());
+
+    std::string batch;
+    if (snapshot) {
+      encodeSnapshot(batch);
+    } else {
+      batch.swap(pending_);
+    }
+    pending_.clear();
+    flush_requested_ = false;
+    const size_t batch_records = pending_records_;
+    pending_records_ = 0;
+    const ACE_UINT64 seq = appended_;
+
+    bool ok;
+    {
+      ACE_GUARD_RETURN(ACE_Reverse_Lock<ACE_Thread_Mutex>, unlock, unlocked, -1);
+      ok = snapshot ? commitSnapshot(batch, seq) : commitLog(batch);
+    }
+
+    attempted_seq_ = seq;
+    ++commits_;
+    if (ok) {
+      failed_ = false;
+      committed_seq_ = seq;
+      log_records_ = snapshot ? 0 : log_records_ + batch_records;
+
+    } else {
+      // The state is written in a snapshot with the next records.
+      failed_ = true;
+    }
+
+    committed_.broadcast();
+  }
+
+  return 0;
+}
+
+bool
+WalPersistenceUpdater::flush()
+{
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, lock_, false);
+  return waitCommitted(appended_);
+}
+
+void
+WalPersistenceUpdater::sync()
+{
+  ACE_GUARD(ACE_Thread_Mutex, guard, lock_);
+
+  const ACE_thread_t self = ACE_OS::thr_self();
+  for (ThreadSeqs::iterator iter = unsynced_.begin();
+       iter != unsynced_.end(); ++iter) {
+    if (ACE_OS::thr_equal(iter->first, self)) {
+      const ACE_UINT64 seq = iter->second;
+      unsynced_.erase(iter);
+      waitCommitted(seq);
+      return;
+    }
+  }
+}
+
+ACE_UINT64
+WalPersistenceUpdater::commits() const
+{
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, lock_, 0);
+  return commits_;
+}
+
+bool
+WalPersistenceUpdater::waitCommitted(ACE_UINT64 seq)
+{
+  while (committed_seq_ < seq && attempted_seq_ < seq && running_) {
+    // Commit without waiting for the rest of the interval.
+    flush_requested_ = true;
+    work_.signal();
+    committed_.wait();
+  }
+
+  return committed_seq_ >= seq;
+}
+
+size_t
+WalPersistenceUpdater::entities() const
+{
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, lock_, 0);
+  return topics_.size() + participants_.size() + actors_.size();
+}
+
+std::string
+WalPersistenceUpdater::logPath() const
+{
+  return std::string(ACE_TEXT_ALWAYS_CHAR(persistence_file_.c_str())) + ".log";
+}
+
+std::string
+WalPersistenceUpdater::snapshotPath() const
+{
+  return std::string(ACE_TEXT_ALWAYS_CHAR(persistence_file_.c_str())) + ".snapshot";
+}
+
+bool
+WalPersistenceUpdater::recover()
+{
+  std::string data;
+  ACE_UINT64 snapshot_seq = 0;
+
+  if (read_file(snapshotPath(), data)) {
+    if (!check_header(data, SNAPSHOT_MAGIC, snapshot_seq)) {
+      ACE_ERROR_RETURN((LM_ERROR,
+                        ACE_TEXT("(%P|%t) ERROR: WalPersistenceUpdater::recover: ")
+                        ACE_TEXT("%C is not a snapshot.\n"),
+                        snapshotPath().c_str()), false);
+    }
+
+    // The snapshot is renamed into place once it is synced, so all of
+    // it has to be there.
+    size_t pos = HEADER_SIZE;
+    while (pos < data.size()) {
+      const size_t length = data.size() - pos >= FRAME_SIZE ?
+        get_ulong(data.data() + pos) : 0;
+      if (length == 0 || data.size() - pos - FRAME_SIZE < length ||
+          ACE::crc32(data.data() + pos + FRAME_SIZE, length) !=
+          get_ulong(data.data() + pos + 4) ||
+          !apply(data.data() + pos + FRAME_SIZE, length)) {
+        ACE_ERROR_RETURN((LM_ERROR,
+                          ACE_TEXT("(%P|%t) ERROR: WalPersistenceUpdater::recover: ")
+                          ACE_TEXT("%C is corrupt at offset %B.\n"),
+                          snapshotPath().c_str(), pos), false);
+      }
+      pos += FRAME_SIZE + length;
+    }
+  }
+
+  ACE_UINT64 seq = snapshot_seq;
+  bool have_log = read_file(logPath(), data) && data.size() >= HEADER_SIZE;
+
+  if (have_log) {
+    ACE_UINT64 log_seq = 0;
+    if (!check_header(data, LOG_MAGIC, log_seq)) {
+      ACE_ERROR_RETURN((LM_ERROR,
+                        ACE_TEXT("(%P|%t) ERROR: WalPersistenceUpdater::recover: ")
+                        ACE_TEXT("%C is not a write-ahead log.\n"),
+                        logPath().c_str()), false);
+    }
+
+    if (log_seq > snapshot_seq) {
+      ACE_ERROR_RETURN((LM_ERROR,
+                        ACE_TEXT("(%P|%t) ERROR: WalPersistenceUpdater::recover: ")
+                        ACE_TEXT("%C starts after record %Q, but %C ends at record %Q.\n"),
+                        logPath().c_str(), log_seq,
+                        snapshotPath().c_str(), snapshot_seq), false);
+    }
+
+    size_t pos = HEADER_SIZE;
+    while (pos < data.size()) {
+      const size_t length = data.size() - pos >= FRAME_SIZE ?
+        get_ulong(data.data() + pos) : 0;
+      // The records up to snapshot_seq are in the snapshot already.
+      if (length == 0 || data.size() - pos - FRAME_SIZE < length ||
+          ACE::crc32(data.data() + pos + FRAME_SIZE, length) !=
+          get_ulong(data.data() + pos + 4) ||
+          (log_seq >= snapshot_seq &&
+           !apply(data.data() + pos + FRAME_SIZE, length))) {
+        // Only the last commit can have been interrupted.
+        ACE_ERROR((LM_WARNING,
+                   ACE_TEXT("(%P|%t) WARNING: WalPersistenceUpdater::recover: ")
+                   ACE_TEXT("dropping %B bytes torn from the end of %C.\n"),
+                   data.size() - pos, logPath().c_str()));
+        if (ACE_OS::truncate(ACE_TEXT_CHAR_TO_TCHAR(logPath().c_str()),
+                             static_cast<ACE_OFF_T>(pos)) != 0) {
+          ACE_ERROR_RETURN((LM_ERROR,
+                            ACE_TEXT("(%P|%t) ERROR: WalPersistenceUpdater::recover: ")
+                            ACE_TEXT("failed to truncate %C %p\n"),
+                            logPath().c_str(), ACE_TEXT("truncate")), false);
+        }
+        break;
+      }
+      pos += FRAME_SIZE + length;
+      ++log_seq;
+      ++log_records_;
+    }
+
+    if (log_seq < snapshot_seq) {
+      // The snapshot was written, but the log wasn't started again.
+      have_log = false;
+      log_records_ = 0;
+    } else {
+      seq = log_seq;
+    }
+  }
+
+  appended_ = committed_seq_ = attempted_seq_ = seq;
+
+  if (OpenDDS::DCPS::DCPS_debug_level > 0) {
+    ACE_DEBUG((LM_DEBUG,
+               ACE_TEXT("(%P|%t) WalPersistenceUpdater::recover: ")
+               ACE_TEXT("recovered %B topics, %B participants and %B actors ")
+               ACE_TEXT("from a snapshot and %B log records.\n"),
+               topics_.size(), participants_.size(), actors_.size(),
+               log_records_));
+  }
+
+  return openLog(!have_log, seq);
+}
+
+bool
+WalPersistenceUpdater::apply(const char* record, size_t length)
+{
+  RecordReader in(record, length);
+
+  switch (in.octet()) {
+  case PUT_TOPIC: {
+    TopicData topic;
+    topic.domainId = static_cast<DomainIdType>(in.ulong());
+    topic.topicId = in.id();
+    topic.participantId = in.id();
+    topic.name = in.bytes();
+    topic.dataType = in.bytes();
+    topic.qos = in.bytes();
+    if (!in.ok()) {
+      return false;
+    }
+    topics_[topic.topicId] = topic;
+    break;
+  }
+
+  case PUT_PARTICIPANT: {
+    ParticipantData participant;
+    participant.domainId = static_cast<DomainIdType>(in.ulong());
+    participant.owner = static_cast<ACE_INT32>(in.ulong());
+    participant.participantId = in.id();
+    participant.qos = in.bytes();
+    if (!in.ok()) {
+      return false;
+    }
+    participants_[participant.participantId] = participant;
+    break;
+  }
+
+  case PUT_ACTOR: {
+    ActorData actor;
+    actor.domainId = static_cast<DomainIdType>(in.ulong());
+    actor.actorId = in.id();
+    actor.topicId = in.id();
+    actor.participantId = in.id();
+    actor.type = in.octet() == DataReader ? DataReader : DataWriter;
+    actor.callback = in.bytes();
+    actor.pubsubQos = in.bytes();
+    actor.drdwQos = in.bytes();
+    actor.transportInterfaceInfo = in.bytes();
+    actor.filterClassName = in.bytes();
+    actor.filterExpr = in.bytes();
+    actor.exprParams = in.bytes();
+    if (!in.ok()) {
+      return false;
+    }
+    actors_[actor.actorId] = actor;
+    break;
+  }
+
+  case ERASE: {
+    const unsigned char type = in.octet();
+    const IdType id = in.id();
+    if (!in.ok()) {
+      return false;
+    }
+    switch (type) {
+    case Update::Topic:
+      topics_.erase(id);
+      break;
+    case Update::Participant:
+      participants_.erase(id);
+      break;
+    case Update::Actor:
+      actors_.erase(id);
+      break;
+    default:
+      return false;
+    }
+    break;
+  }
+
+  case LAST_PART_ID:
+    last_part_id_ = static_cast<ACE_INT32>(in.ulong());
+    return in.ok();
+
+  default:
+    return false;
+  }
+
+  return true;
+}
+
+void
+WalPersistenceUpdater::encode(const TopicData& topic, std::string& out)
+{
+  RecordWriter record(PUT_TOPIC);
+  record.ulong(static_cast<ACE_UINT32>(topic.domainId));
+  record.id(topic.topicId);
+  record.id(topic.participantId);
+  record.bytes(topic.name);
+  record.bytes(topic.dataType);
+  record.bytes(topic.qos);
+  record.frame(out);
+}
+
+void
+WalPersistenceUpdater::encode(const ParticipantData& participant, std::string& out)
+{
+  RecordWriter record(PUT_PARTICIPANT);
+  record.ulong(static_cast<ACE_UINT32>(participant.domainId));
+  record.ulong(static_cast<ACE_UINT32>(participant.owner));
+  record.id(participant.participantId);
+  record.bytes(participant.qos);
+  record.frame(out);
+}
+
+void
+WalPersistenceUpdater::encode(const ActorData& actor, std::string& out)
+{
+  RecordWriter record(PUT_ACTOR);
+  record.ulong(static_cast<ACE_UINT32>(actor.domainId));
+  record.id(actor.actorId);
+  record.id(actor.topicId);
+  record.id(actor.participantId);
+  record.octet(static_cast<unsigned char>(actor.type));
+  record.bytes(actor.callback);
+  record.bytes(actor.pubsubQos);
+  record.bytes(actor.drdwQos);
+  record.bytes(actor.transportInterfaceInfo);
+  record.bytes(actor.filterClassName);
+  record.bytes(actor.filterExpr);
+  record.bytes(actor.exprParams);
+  record.frame(out);
+}
+
+void
+WalPersistenceUpdater::appendErase(ItemType type, const IdType& id)
+{
+  RecordWriter out(ERASE);
+  out.octet(static_cast<unsigned char>(type));
+  out.id(id);
+
+  std::string record;
+  out.frame(record);
+  appended(record);
+}
+
+void
+WalPersistenceUpdater::encodeLastPartId(PartIdType partId, std::string& out)
+{
+  RecordWriter record(LAST_PART_ID);
+  record.ulong(static_cast<ACE_UINT32>(partId));
+  record.frame(out);
+}
+
+void
+WalPersistenceUpdater::appended(const std::string& record)
+{
+  if (pending_records_ == 0) {
+    pending_since_ = ACE_OS::gettimeofday();
+    work_.signal();
+  }
+
+  pending_ += record;
+  ++pending_records_;
+  ++appended_;
+
+  if (pending_.size() >= commit_bytes_) {
+    work_.signal();
+  }
+
+  if (!write_behind_) {
+    const ACE_thread_t self = ACE_OS::thr_self();
+    for (ThreadSeqs::iterator iter = unsynced_.begin();
+         iter != unsynced_.end(); ++iter) {
+      if (ACE_OS::thr_equal(iter->first, self)) {
+        iter->second = appended_;
+        return;
+      }
+    }
+    unsynced_.push_back(std::make_pair(self, appended_));
+  }
+}
+
+void
+WalPersistenceUpdater::encodeSnapshot(std::string& out) const
+{
+  for (ParticipantMap::const_iterator iter = participants_.begin();
+       iter != participants_.end(); ++iter) {
+    encode(iter->second, out);
+  }
+
+  for (TopicMap::const_iterator iter = topics_.begin();
+       iter != topics_.end(); ++iter) {
+    encode(iter->second, out);
+  }
+
+  for (ActorMap::const_iterator iter = actors_.begin();
+       iter != actors_.end(); ++iter) {
+    encode(iter->second, out);
+  }
+
+  encodeLastPartId(last_part_id_, out);
+}
+
+bool
+WalPersistenceUpdater::commitLog(const std::string& records)
+{
+  if (log_ == ACE_INVALID_HANDLE && !openLog(false, 0)) {
+    return false;
+  }
+
+  if (!write_all(log_, records) || ACE_OS::fsync(log_) != 0) {
+    ACE_ERROR_RETURN((LM_ERROR,
+                      ACE_TEXT("(%P|%t) ERROR: WalPersistenceUpdater::commitLog: ")
+                      ACE_TEXT("failed to write %C %p\n"),
+                      logPath().c_str(), ACE_TEXT("write")), false);
+  }
+
+  return true;
+}
+
+bool
+WalPersistenceUpdater::commitSnapshot(const std::string& snapshot, ACE_UINT64 seq)
+{
+  const std::string path = snapshotPath();
+  const std::string tmp_path = path + ".tmp";
+
+  const ACE_HANDLE file = ACE_OS::open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC,
+                                       ACE_DEFAULT_FILE_PERMS);
+  if (file == ACE_INVALID_HANDLE) {
+    ACE_ERROR_RETURN((LM_ERROR,
+                      ACE_TEXT("(%P|%t) ERROR: WalPersistenceUpdater::commitSnapshot: ")
+                      ACE_TEXT("failed to open %C %p\n"),
+                      tmp_path.c_str(), ACE_TEXT("open")), false);
+  }
+
+  const bool written = write_all(file, header(SNAPSHOT_MAGIC, seq)) &&
+    write_all(file, snapshot) && ACE_OS::fsync(file) == 0;
+  if (ACE_OS::close(file) != 0 || !written ||
+      ACE_OS::rename(tmp_path.c_str(), path.c_str()) != 0) {
+    ACE_ERROR((LM_ERROR,
+               ACE_TEXT("(%P|%t) ERROR: WalPersistenceUpdater::commitSnapshot: ")
+               ACE_TEXT("failed to write %C %p\n"),
+               path.c_str(), ACE_TEXT("write")));
+    ACE_OS::unlink(tmp_path.c_str());
+    return false;
+  }
+
+  // The log's records are in the snapshot now.  If this fails, recovery
+  // skips them.
+  return openLog(true, seq);
+}
+
+bool
+WalPersistenceUpdater::openLog(bool truncate, ACE_UINT64 base)
+{
+  if (log_ != ACE_INVALID_HANDLE) {
+    ACE_OS::close(log_);
+  }
+
+  const std::string path = logPath();
+  log_ = ACE_OS::open(path.c_str(),
+                      O_WRONLY | O_CREAT | O_APPEND | (truncate ? O_TRUNC : 0),
+                      ACE_DEFAULT_FILE_PERMS);
+  if (log_ == ACE_INVALID_HANDLE) {
+    ACE_ERROR_RETURN((LM_ERROR,
+                      ACE_TEXT("(%P|%t) ERROR: WalPersistenceUpdater::openLog: ")
+                      ACE_TEXT("failed to open %C %p\n"),
+                      path.c_str(), ACE_TEXT("open")), false);
+  }
+
+  if (truncate &&
+      (!write_all(log_, header(LOG_MAGIC, base)) || ACE_OS::fsync(log_) != 0)) {
+    ACE_ERROR((LM_ERROR,
+               ACE_TEXT("(%P|%t) ERROR: WalPersistenceUpdater::openLog: ")
+               ACE_TEXT("failed to write %C %p\n"),
+               path.c_str(), ACE_TEXT("write")));
+    ACE_OS::close(log_);
+    log_ = ACE_INVALID_HANDLE;
+    return false;
+  }
+
+  return true;
+}
+
+void
+WalPersistenceUpdater::requestImage()
+{
+  if (um_ == NULL) {
+    return;
+  }
+
+  DImage image;
+
+  // Buffers of the QoS and transport sequences in the image.
+  std::vector<ArrDelAdapter<char> > buffers;
+
+  {
+    ACE_GUARD(ACE_Thread_Mutex, guard, lock_);
+
+    for (ParticipantMap::const_iterator iter = participants_.begin();
+         iter != participants_.end(); ++iter) {
+      const ParticipantData& participant = iter->second;
+      const QosSeq qos(ParticipantQos, bin(participant.qos, buffers));
+      image.participants.push_back(DParticipant(participant.domainId
+                                                , participant.owner
+                                                , participant.participantId
+                                                , qos));
+    }
+
+    for (TopicMap::const_iterator iter = topics_.begin();
+         iter != topics_.end(); ++iter) {
+      const TopicData& topic = iter->second;
+      const QosSeq qos(TopicQos, bin(topic.qos, buffers));
+      image.topics.push_back(DTopic(topic.domainId, topic.topicId
+                                    , topic.participantId, topic.name.c_str()
+                                    , topic.dataType.c_str(), qos));
+    }
+
+    for (ActorMap::const_iterator iter = actors_.begin();
+         iter != actors_.end(); ++iter) {
+      const ActorData& actor = iter->second;
+      const bool reader = actor.type == DataReader;
+      const QosSeq pubsub_qos(reader ? SubscriberQos : PublisherQos,
+                              bin(actor.pubsubQos, buffers));
+      const QosSeq drdw_qos(reader ? DataReaderQos : DataWriterQos,
+                            bin(actor.drdwQos, buffers));
+
+      ContentSubscriptionBin csp_bin;
+      if (reader) {
+        csp_bin.filterClassName = actor.filterClassName.c_str();
+        csp_bin.filterExpr = actor.filterExpr.c_str();
+        csp_bin.exprParams = bin(actor.exprParams, buffers);
+      }
+
+      image.actors.push_back(DActor(actor.domainId, actor.actorId, actor.topicId
+                                    , actor.participantId
+                                    , actor.type, actor.callback.c_str()
+                                    , pubsub_qos, drdw_qos
+                                    , bin(actor.transportInterfaceInfo, buffers)
+                                    , csp_bin));
+    }
+
+    image.lastPartId = last_part_id_;
+  }
+
+  // The repository persists what it adds from the image through this
+  // updater again, so it is pushed without the lock.
+  um_->pushImage(image);
+}
+
+void
+WalPersistenceUpdater::create(const UTopic& topic)
+{
+  TopicData data;
+  data.domainId = topic.domainId;
+  data.topicId = topic.topicId;
+  data.participantId = topic.participantId;
+  data.name = topic.name;
+  data.dataType = topic.dataType;
+  data.qos = to_cdr(topic.topicQos);
+
+  ACE_GUARD(ACE_Thread_Mutex, guard, lock_);
+  append(topics_[data.topicId] = data);
+}
+
+void
+WalPersistenceUpdater::create(const UParticipant& participant)
+{
+  ParticipantData data;
+  data.domainId = participant.domainId;
+  data.owner = participant.owner;
+  data.participantId = participant.participantId;
+  data.qos = to_cdr(participant.participantQos);
+
+  ACE_GUARD(ACE_Thread_Mutex, guard, lock_);
+  append(participants_[data.participantId] = data);
+}
+
+void
+WalPersistenceUpdater::create(const URActor& actor)
+{
+  ActorData data;
+  data.domainId = actor.domainId;
+  data.actorId = actor.actorId;
+  data.topicId = actor.topicId;
+  data.participantId = actor.participantId;
+  data.type = DataReader;
+  data.callback = actor.callback;
+  data.pubsubQos = to_cdr(actor.pubsubQos);
+  data.drdwQos = to_cdr(actor.drdwQos);
+  data.transportInterfaceInfo = to_cdr(actor.transportInterfaceInfo);
+  data.filterClassName = actor.contentSubscriptionProfile.filterClassName.in();
+  data.filterExpr = actor.contentSubscriptionProfile.filterExpr.in();
+  data.exprParams = to_cdr(actor.contentSubscriptionProfile.exprParams);
+
+  ACE_GUARD(ACE_Thread_Mutex, guard, lock_);
+  append(actors_[data.actorId] = data);
+}
+
+void
+WalPersistenceUpdater::create(const UWActor& actor)
+{
+  ActorData data;
+  data.domainId = actor.domainId;
+  data.actorId = actor.actorId;
+  data.topicId = actor.topicId;
+  data.participantId = actor.participantId;
+  data.type = DataWriter;
+  data.callback = actor.callback;
+  data.pubsubQos = to_cdr(actor.pubsubQos);
+  data.drdwQos = to_cdr(actor.drdwQos);
+  data.transportInterfaceInfo = to_cdr(actor.transportInterfaceInfo);
+
+  ACE_GUARD(ACE_Thread_Mutex, guard, lock_);
+  append(actors_[data.actorId] = data);
+}
+
+void
+WalPersistenceUpdater::create(const OwnershipData& /* data */)
+{
+  /* Ownership is not persisted, as in PersistenceUpdater. */
+}
+
+void
+WalPersistenceUpdater::update(const IdPath& id, const DDS::DomainParticipantQos& qos)
+{
+  const std::string data = to_cdr(qos);
+
+  ACE_GUARD(ACE_Thread_Mutex, guard, lock_);
+  const ParticipantMap::iterator iter = participants_.find(id.id);
+
+  if (iter != participants_.end()) {
+    iter->second.qos = data;
+    append(iter->second);
+
+  } else {
+    OpenDDS::DCPS::RepoIdConverter converter(id.id);
+    ACE_ERROR((LM_ERROR,
+               ACE_TEXT("(%P|%t) WalPersistenceUpdater::update: ")
+               ACE_TEXT("participant %C not found\n"),
+               std::string(converter).c_str()));
+  }
+}
+
+void
+WalPersistenceUpdater::update(const IdPath& id, const DDS::TopicQos& qos)
+{
+  const std::string data = to_cdr(qos);
+
+  ACE_GUARD(ACE_Thread_Mutex, guard, lock_);
+  const TopicMap::iterator iter = topics_.find(id.id);
+
+  if (iter != topics_.end()) {
+    iter->second.qos = data;
+    append(iter->second);
+
+  } else {
+    OpenDDS::DCPS::RepoIdConverter converter(id.id);
+    ACE_ERROR((LM_ERROR,
+               ACE_TEXT("(%P|%t) WalPersistenceUpdater::update: ")
+               ACE_TEXT("topic %C not found\n"),
+               std::string(converter).c_str()));
+  }
+}
+
+void
+WalPersistenceUpdater::update(const IdPath& id, const DDS::DataWriterQos& qos)
+{
+  const std::string data = to_cdr(qos);
+
+  ACE_GUARD(ACE_Thread_Mutex, guard, lock_);
+  const ActorMap::iterator iter = actors_.find(id.id);
+
+  if (iter != actors_.end()) {
+    iter->second.drdwQos = data;
+    append(iter->second);
+
+  } else {
+    OpenDDS::DCPS::RepoIdConverter converter(id.id);
+    ACE_ERROR((LM_ERROR,
+               ACE_TEXT("(%P|%t) WalPersistenceUpdater::update(writerQos): ")
+               ACE_TEXT("publication %C not found\n"),
+               std::string(converter).c_str()));
+  }
+}
+
+void
+WalPersistenceUpdater::update(const IdPath& id, const DDS::PublisherQos& qos)
+{
+  const std::string data = to_cdr(qos);
+
+  ACE_GUARD(ACE_Thread_Mutex, guard, lock_);
+  const ActorMap::iterator iter = actors_.find(id.id);
+
+  if (iter != actors_.end()) {
+    iter->second.pubsubQos = data;
+    append(iter->second);
+
+  } else {
+    OpenDDS::DCPS::RepoIdConverter converter(id.id);
+    ACE_ERROR((LM_ERROR,
+               ACE_TEXT("(%P|%t) WalPersistenceUpdater::update(publisherQos): ")
+               ACE_TEXT("publication %C not found\n"),
+               std::string(converter).c_str()));
+  }
+}
+
+void
+WalPersistenceUpdater::update(const IdPath& id, const DDS::DataReaderQos& qos)
+{
+  const std::string data = to_cdr(qos);
+
+  ACE_GUARD(ACE_Thread_Mutex, guard, lock_);
+  const ActorMap::iterator iter = actors_.find(id.id);
+
+  if (iter != actors_.end()) {
+    iter->second.drdwQos = data;
+    append(iter->second);
+
+  } else {
+    OpenDDS::DCPS::RepoIdConverter converter(id.id);
+    ACE_ERROR((LM_ERROR,
+               ACE_TEXT("(%P|%t) WalPersistenceUpdater::update(readerQos): ")
+               ACE_TEXT("subscription %C not found\n"),
+               std::string(converter).c_str()));
+  }
+}
+
+void
+WalPersistenceUpdater::update(const IdPath& id, const DDS::SubscriberQos& qos)
+{
+  const std::string data = to_cdr(qos);
+
+  ACE_GUARD(ACE_Thread_Mutex, guard, lock_);
+  const ActorMap::iterator iter = actors_.find(id.id);
+
+  if (iter != actors_.end()) {
+    iter->second.pubsubQos = data;
+    append(iter->second);
+
+  } else {
+    OpenDDS::DCPS::RepoIdConverter converter(id.id);
+    ACE_ERROR((LM_ERROR,
+               ACE_TEXT("(%P|%t) WalPersistenceUpdater::update(subscriberQos): ")
+               ACE_TEXT("subscription %C not found\n"),
+               std::string(converter).c_str()));
+  }
+}
+
+void
+WalPersistenceUpdater::update(const IdPath& id, const DDS::StringSeq& exprParams)
+{
+  const std::string data = to_cdr(exprParams);
+
+  ACE_GUARD(ACE_Thread_Mutex, guard, lock_);
+  const ActorMap::iterator iter = actors_.find(id.id);
+
+  if (iter != actors_.end()) {
+    iter->second.exprParams = data;
+    append(iter->second);
+
+  } else {
+    OpenDDS::DCPS::RepoIdConverter converter(id.id);
+    ACE_ERROR((LM_ERROR,
+               ACE_TEXT("(%P|%t) WalPersistenceUpdater::update(exprParams): ")
+               ACE_TEXT("subscription %C not found\n"),
+               std::string(converter).c_str()));
+  }
+}
+
+void
+WalPersistenceUpdater::destroy(const IdPath& id, ItemType type, ActorType)
+{
+  ACE_GUARD(ACE_Thread_Mutex, guard, lock_);
+  size_t erased = 0;
+
+  switch (type) {
+  case Update::Topic:
+    erased = topics_.erase(id.id);
+    break;
+  case Update::Participant:
+    erased = participants_.erase(id.id);
+    break;
+  case Update::Actor:
+    erased = actors_.erase(id.id);
+    break;
+  default: {
+    OpenDDS::DCPS::RepoIdConverter converter(id.id);
+    ACE_ERROR((LM_ERROR,
+               ACE_TEXT("(%P|%t) WalPersistenceUpdater::destroy: ")
+               ACE_TEXT("unknown entity - %C.\n"),
+               std::string(converter).c_str()));
+  }
+  }
+
+  if (erased) {
+    appendErase(type, id.id);
+  }
+}
+
+void
+WalPersistenceUpdater::updateLastPartId(PartIdType partId)
+{
+  ACE_GUARD(ACE_Thread_Mutex, guard, lock_);
+  last_part_id_ = partId;
+
+  std::string record;
+  encodeLastPartId(partId, record);
+  appended(record);
+}
+
+} // namespace Update
+
+int
+WalPersistenceUpdaterSvc_Loader::init()
+{
+  return ACE_Service_Config::process_directive
+         (ace_svc_desc_WalPersistenceUpdaterSvc);
+}
+
+ACE_FACTORY_DEFINE(ACE_Local_Service, WalPersistenceUpdaterSvc)
+
+ACE_STATIC_SVC_DEFINE(WalPersistenceUpdaterSvc,
+                      ACE_TEXT("WalPersistenceUpdaterSvc"),
+                      ACE_SVC_OBJ_T,
+                      &ACE_SVC_NAME(WalPersistenceUpdaterSvc),
+                      ACE_Service_Type::DELETE_THIS |
+                      ACE_Service_Type::DELETE_OBJ,
+                      0)
+
+ACE_STATIC_SVC_REQUIRE(WalPersistenceUpdaterSvc)
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,303 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef WAL_PERSISTENCE_UPDATER_H
+#define WAL_PERSISTENCE_UPDATER_H
+
+#include "inforepo_export.h"
+#include "Updater.h"
+
+#include "dds/DdsDcpsInfoUtilsC.h"
+#include "dds/DCPS/GuidUtils.h"
+
+#include "ace/Task.h"
+#include "ace/Thread_Mutex.h"
+#include "ace/Condition_Thread_Mutex.h"
+#include "ace/Service_Object.h"
+#include "ace/Service_Config.h"
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace Update {
+
+// Forward declaration
+class Manager;
+
+/**
+ * @class WalPersistenceUpdater
+ *
+ * @brief Persists the repository in an append-only write-ahead log.
+ *
+ * An alternative to PersistenceUpdater, loaded with
+ *   static WalPersistenceUpdaterSvc "-file <name>"
+ * in place of PersistenceUpdaterSvc.  The entities are kept in memory,
+ * and each change is appended to <name>.log as a record of the entity's
+ * new state or its removal.  A thread writes the pending records with one
+ * write and one sync.  The repository's operations wait in sync(), once
+ * they released its locks, until their records are synced, so the
+ * records that other operations append meanwhile share the next sync.
+ * With -write_behind 1 sync() doesn't wait, and the thread gathers the
+ * records appended during -commit_interval milliseconds (or until
+ * -commit_bytes are pending), so a burst of updates costs one sync but
+ * the updates of the last interval can be lost in a crash.  Once the log holds -snapshot_records records, and at least as
+ * many as there are entities, the state is written to <name>.snapshot
+ * instead and the log is started again.  On startup the snapshot is
+ * loaded and the log records it doesn't include are replayed, dropping a
+ * record torn by a crash at its end.
+ */
+class OpenDDS_InfoRepoLib_Export WalPersistenceUpdater : public Updater, public ACE_Task_Base {
+public:
+  WalPersistenceUpdater();
+  virtual ~WalPersistenceUpdater();
+
+  /// Service object initialization
+  virtual int init(int argc, ACE_TCHAR *argv[]);
+
+  /// Service object finalizer, which commits the pending records.
+  virtual int fini();
+
+  /// ACE_Task_Base thread, which commits the records.
+  virtual int svc();
+
+  /// Send the recovered image upstream.
+  virtual void requestImage();
+
+  /// Add topic to be persisted.
+  virtual void create(const UTopic& topic);
+
+  /// Add participant to be persisted.
+  virtual void create(const UParticipant& participant);
+
+  /// Add DataReader to be persisted.
+  virtual void create(const URActor& actor);
+
+  /// Add DataWriter to be persisted.
+  virtual void create(const UWActor& actor);
+
+  /// Add ownership data to be persisted.
+  virtual void create(const OwnershipData& data);
+
+  /// Persist updated Qos parameters for a Participant.
+  virtual void update(const IdPath& id, const DDS::DomainParticipantQos& qos);
+
+  /// Persist updated Qos parameters for a Topic.
+  virtual void update(const IdPath& id, const DDS::TopicQos&             qos);
+
+  /// Persist updated Qos parameters for a DataWriter.
+  virtual void update(const IdPath& id, const DDS::DataWriterQos&        qos);
+
+  /// Persist updated Qos parameters for a Publisher.
+  virtual void update(const IdPath& id, const DDS::PublisherQos&         qos);
+
+  /// Persist updated Qos parameters for a DataReader.
+  virtual void update(const IdPath& id, const DDS::DataReaderQos&        qos);
+
+  /// Persist updated Qos parameters for a Subscriber.
+  virtual void update(const IdPath& id, const DDS::SubscriberQos&        qos);
+
+  /// Persist updated subscription exprParams.
+  virtual void update(const IdPath& id, const DDS::StringSeq&     exprParams);
+
+  /// Remove an entity (but not children) from persistence.
+  virtual void destroy(const IdPath& id, ItemType type, ActorType actor);
+
+  /// Update Last Participant Id for repo
+  virtual void updateLastPartId(PartIdType partId);
+
+  /// Wait for the records the calling thread appended to be committed,
+  /// unless writing behind.
+  virtual void sync();
+
+  /// Wait for the records appended so far to be committed.  Returns
+  /// false if writing the log failed.
+  bool flush();
+
+  /// Number of commits written since startup.
+  ACE_UINT64 commits() const;
+
+  /// Number of persisted topics, participants, readers and writers.
+  size_t entities() const;
+
+private:
+  struct TopicData {
+    DomainIdType domainId;
+    IdType       topicId;
+    IdType       participantId;
+    std::string  name;
+    std::string  dataType;
+    std::string  qos;
+  };
+
+  struct ParticipantData {
+    DomainIdType domainId;
+    long         owner;
+    IdType       participantId;
+    std::string  qos;
+  };
+
+  struct ActorData {
+    DomainIdType domainId;
+    IdType       actorId;
+    IdType       topicId;
+    IdType       participantId;
+    ActorType    type;
+    std::string  callback;
+    std::string  pubsubQos;
+    std::string  drdwQos;
+    std::string  transportInterfaceInfo;
+    std::string  filterClassName;
+    std::string  filterExpr;
+    std::string  exprParams;
+  };
+
+  typedef std::map<IdType, TopicData, OpenDDS::DCPS::GUID_tKeyLessThan> TopicMap;
+  typedef std::map<IdType, ParticipantData, OpenDDS::DCPS::GUID_tKeyLessThan> ParticipantMap;
+  typedef std::map<IdType, ActorData, OpenDDS::DCPS::GUID_tKeyLessThan> ActorMap;
+
+  int parse(int argc, ACE_TCHAR *argv[]);
+
+  /// Load the snapshot and replay the log.
+  bool recover();
+
+  /// Apply one record to the state.  Returns false if it is malformed.
+  bool apply(const char* record, size_t length);
+
+  /// Append a framed record of the entity's state to out.
+  static void encode(const TopicData& topic, std::string& out);
+  static void encode(const ParticipantData& participant, std::string& out);
+  static void encode(const ActorData& actor, std::string& out);
+  static void encodeLastPartId(PartIdType partId, std::string& out);
+
+  /// Append a record to those pending.
+  template <typename T>
+  void append(const T& data)
+  {
+    std::string record;
+    encode(data, record);
+    appended(record);
+  }
+  void appendErase(ItemType type, const IdType& id);
+
+  /// Add a framed record to those pending.
+  void appended(const std::string& record);
+
+  /// Wait, holding lock_, until the records up to seq are committed.
+  /// Returns false if writing them failed.
+  bool waitCommitted(ACE_UINT64 seq);
+
+  /// The records of the whole state.
+  void encodeSnapshot(std::string& out) const;
+
+  /// Write and sync the records at the end of the log.
+  bool commitLog(const std::string& records);
+
+  /// Write and sync a snapshot of the records up to seq, then start the
+  /// log again.
+  bool commitSnapshot(const std::string& snapshot, ACE_UINT64 seq);
+
+  /// Open the log for appending, starting it after the record base if
+  /// truncate is true.
+  bool openLog(bool truncate, ACE_UINT64 base);
+
+  std::string logPath() const;
+  std::string snapshotPath() const;
+
+  ACE_TString persistence_file_;
+  bool reset_;
+
+  /// Return from an update without waiting for its commit.
+  bool write_behind_;
+
+  /// Longest time a record waits to be committed.
+  ACE_Time_Value commit_interval_;
+
+  /// Commit without waiting once this many bytes are pending.
+  size_t commit_bytes_;
+
+  /// Log records that trigger a snapshot.
+  size_t snapshot_records_;
+
+  Manager *um_;
+
+  /// Guards the state and the commit counters.
+  mutable ACE_Thread_Mutex lock_;
+
+  /// Signals the commit thread that records are pending.
+  ACE_Condition_Thread_Mutex work_;
+
+  /// Signals flush() that records were committed.
+  ACE_Condition_Thread_Mutex committed_;
+
+  TopicMap topics_;
+  ParticipantMap participants_;
+  ActorMap actors_;
+  PartIdType last_part_id_;
+
+  /// Framed records waiting for the commit thread.
+  std::string pending_;
+  size_t pending_records_;
+  ACE_Time_Value pending_since_;
+
+  /// Sequence numbers of the last record appended, committed and last
+  /// tried to commit.  They go on from those of the files: a snapshot's
+  /// header holds the last record it includes, and the log's the record
+  /// before its first.
+  ACE_UINT64 appended_;
+  ACE_UINT64 committed_seq_;
+  ACE_UINT64 attempted_seq_;
+
+  /// The last record each thread appended and hasn't waited for in
+  /// sync().  There is an entry for each of the repository's threads at
+  /// most.
+  typedef std::vector<std::pair<ACE_thread_t, ACE_UINT64> > ThreadSeqs;
+  ThreadSeqs unsynced_;
+
+  ACE_UINT64 commits_;
+
+  /// Records in the log since the last snapshot.
+  size_t log_records_;
+
+  ACE_HANDLE log_;
+  bool flush_requested_;
+  bool failed_;
+  bool shutdown_;
+  bool running_;
+};
+
+} // End of namespace Update
+
+typedef Update::WalPersistenceUpdater WalPersistenceUpdaterSvc;
+
+ACE_STATIC_SVC_DECLARE(WalPersistenceUpdaterSvc)
+
+ACE_FACTORY_DECLARE(ACE_Local_Service, WalPersistenceUpdaterSvc)
+
+class OpenDDS_InfoRepoLib_Export WalPersistenceUpdaterSvc_Loader {
+public:
+  static int init();
+};
+
+#if defined(ACE_HAS_BROKEN_STATIC_CONSTRUCTORS)
+
+typedef int (*WalPersistenceUpdaterSvc_LoaderFn)();
+
+static WalPersistenceUpdaterSvc_LoaderFn wal_load = &WalPersistenceUpdaterSvc_Loader::init;
+
+#else
+
+static int wal_load = WalPersistenceUpdaterSvc_Loader::init();
+
+#endif /* ACE_HAS_BROKEN_STATIC_CONSTRUCTORS */
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* WAL_PERSISTENCE_UPDATER_H */
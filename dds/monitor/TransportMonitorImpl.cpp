@@ -10,6 +10,7 @@
 #include "monitorTypeSupportImpl.h"
 #include "dds/DCPS/transport/framework/TransportImpl.h"
 #include <dds/DdsDcpsInfrastructureC.h>
+#include "ace/OS_NS_stdio.h"
 
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
@@ -19,9 +20,52 @@ namespace DCPS {
 TransportMonitorImpl::TransportReportVec TransportMonitorImpl::queue_;
 ACE_Recursive_Thread_Mutex TransportMonitorImpl::queue_lock_;
 
-TransportMonitorImpl::TransportMonitorImpl(TransportImpl* /*transport*/,
+namespace {
+
+void add_value(NVPSeq& values, const std::string& name, const ValueUnion& value)
+{
+  const CORBA::ULong i = values.length();
+  values.length(i + 1);
+  values[i].name = name.c_str();
+  values[i].value = value;
+}
+
+Statistics to_statistics(const Log2Histogram& histogram)
+{
+  Statistics stats;
+  stats.n = static_cast<CORBA::ULong>(histogram.n_);
+  stats.maximum = double(histogram.max_);
+  stats.minimum = double(histogram.min_);
+  stats.mean = histogram.n_ ? histogram.sum_ / histogram.n_ : 0.0;
+  stats.variance = histogram.n_ ?
+    histogram.sum_sq_ / histogram.n_ - stats.mean * stats.mean : 0.0;
+  return stats;
+}
+
+/// The non-empty buckets as "<smallest value in the bucket>:<count>".
+DDS::StringSeq to_buckets(const Log2Histogram& histogram)
+{
+  DDS::StringSeq buckets;
+  for (size_t i = 0; i < Log2Histogram::BUCKETS; ++i) {
+    if (histogram.counts_[i]) {
+      char bucket[48];
+      ACE_OS::snprintf(bucket, sizeof bucket, "%llu:%llu",
+                       static_cast<unsigned long long>(Log2Histogram::bucket_min(i)),
+                       static_cast<unsigned long long>(histogram.counts_[i]));
+      const CORBA::ULong n = buckets.length();
+      buckets.length(n + 1);
+      buckets[n] = bucket;
+    }
+  }
+  return buckets;
+}
+
+}
+
+TransportMonitorImpl::TransportMonitorImpl(TransportImpl* transport,
               OpenDDS::DCPS::TransportReportDataWriter_ptr transport_writer)
-  : transport_writer_(TransportReportDataWriter::_duplicate(transport_writer))
+  : transport_(transport)
+  , transport_writer_(TransportReportDataWriter::_duplicate(transport_writer))
 {
   char host[256];
   ACE_OS::hostname(host, 256);
@@ -41,7 +85,9 @@ TransportMonitorImpl::report() {
   report.pid  = this->pid_;
   // TODO: remove/replace
   report.transport_id  = 0;
-  report.transport_type = "";
+  report.transport_type = this->transport_ ? this->transport_->transport_type().c_str() : "";
+  this->add_send_task_stats(report.values);
+  this->add_link_latency_stats(report.values);
   // ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, queue_lock_);
   if (!CORBA::is_nil(this->transport_writer_.in())) {
     if (this->queue_.size()) {
@@ -63,6 +109,81 @@ TransportMonitorImpl::report() {
   }
 }
 
+void
+TransportMonitorImpl::add_send_task_stats(NVPSeq& values)
+{
+  if (!this->transport_) {
+    return;
+  }
+
+  TransportImpl::SendTaskStatsSeq tasks;
+  this->transport_->send_task_stats(tasks);
+
+  for (size_t i = 0; i < tasks.size(); ++i) {
+    const SendTaskStats& task = tasks[i];
+    char prefix[48];
+    ACE_OS::snprintf(prefix, sizeof prefix, "send_task.%llu.",
+                     static_cast<unsigned long long>(task.link_id_));
+    const std::string name(prefix);
+
+    ValueUnion value;
+    value.stat_value(to_statistics(task.depth_));
+    add_value(values, name + "queue_depth", value);
+    value.string_seq_value(to_buckets(task.depth_));
+    add_value(values, name + "queue_depth_buckets", value);
+
+    value.stat_value(to_statistics(task.latency_));
+    add_value(values, name + "queue_latency_usec", value);
+    value.string_seq_value(to_buckets(task.latency_));
+    add_value(values, name + "queue_latency_usec_buckets", value);
+
+    value.integer_value(static_cast<CORBA::Long>(task.blocked_));
+    add_value(values, name + "blocked", value);
+    value.integer_value(static_cast<CORBA::Long>(task.timed_out_));
+    add_value(values, name + "timed_out", value);
+    value.integer_value(static_cast<CORBA::Long>(task.dropped_));
+    add_value(values, name + "dropped", value);
+    value.integer_value(static_cast<CORBA::Long>(task.rejected_));
+    add_value(values, name + "rejected", value);
+  }
+}
+
+void
+TransportMonitorImpl::add_link_latency_stats(NVPSeq& values)
+{
+  if (!this->transport_) {
+    return;
+  }
+
+  TransportImpl::LinkLatencyStatsSeq links;
+  this->transport_->link_latency_stats(links);
+
+  for (size_t i = 0; i < links.size(); ++i) {
+    const LinkLatencyStats& link = links[i];
+    char prefix[48];
+    ACE_OS::snprintf(prefix, sizeof prefix, "link.%llu.",
+                     static_cast<unsigned long long>(link.link_id_));
+    const std::string name(prefix);
+
+    const struct {
+      const char* name;
+      const Log2Histogram* histogram;
+    } stages[] = {
+      { "send_queue_usec", &link.send_queue_ },
+      { "kernel_send_usec", &link.kernel_send_ },
+      { "receive_dispatch_usec", &link.receive_dispatch_ },
+      { "reader_usec", &link.reader_ }
+    };
+
+    for (size_t s = 0; s < sizeof stages / sizeof stages[0]; ++s) {
+      ValueUnion value;
+      value.stat_value(to_statistics(*stages[s].histogram));
+      add_value(values, name + stages[s].name, value);
+      value.string_seq_value(to_buckets(*stages[s].histogram));
+      add_value(values, name + stages[s].name + "_buckets", value);
+    }
+  }
+}
 
 } // namespace DCPS
 } // namespace OpenDDS
@@ -31,6 +31,15 @@ public:
   virtual void report();
 
 private:
+  /// Append the queue statistics of the transport's send tasks to
+  /// @a values.
+  void add_send_task_stats(NVPSeq& values);
+
+  /// Append the latency breakdown of the transport's DataLinks to
+  /// @a values.
+  void add_link_latency_stats(NVPSeq& values);
+
+  TransportImpl* transport_;
   OpenDDS::DCPS::TransportReportDataWriter_var transport_writer_;
   std::string hostname_;
   pid_t pid_;
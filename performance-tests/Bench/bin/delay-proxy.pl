@@ -0,0 +1,109 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+    & eval 'exec perl -S $0 $argv:q'
+    if 0;
+
+use warnings;
+use strict;
+
+=head1 NAME
+
+delay-proxy.pl - forward TCP connections with an added one-way delay
+
+=head1 SYNOPSIS
+
+  delay-proxy.pl <listen-port> <target-host:port> <delay-ms>
+
+=head1 DESCRIPTION
+
+This script accepts TCP connections on the listen port of the loopback
+interface and forwards each of them to the target address.  Data in both
+directions is held for the given number of milliseconds before it is
+forwarded, emulating a network with that one-way latency without the need
+for netem or other kernel configuration.
+
+A transport is placed behind the proxy by setting its pub_address to the
+proxy's listen port while its local_address remains the target.
+
+=cut
+
+use IO::Socket::INET;
+use IO::Select;
+use Time::HiRes qw(time);
+
+my ($listen_port, $target, $delay_ms) = @ARGV;
+die "usage: $0 <listen-port> <target-host:port> <delay-ms>\n"
+  unless defined $delay_ms;
+my $delay = $delay_ms / 1000.0;
+
+my $listener = IO::Socket::INET->new(LocalAddr => '127.0.0.1',
+                                     LocalPort => $listen_port,
+                                     Listen => 128,
+                                     ReuseAddr => 1)
+  or die "$0: unable to listen on $listen_port: $!\n";
+
+my $select = IO::Select->new($listener);
+my %peer;    # socket -> socket it forwards to
+my %pending; # socket -> [[release time, data], ...] waiting to be written to it
+
+sub close_pair {
+  my $sock = shift;
+  my $other = delete $peer{$sock};
+  for my $s ($sock, $other) {
+    next unless defined $s;
+    delete $peer{$s};
+    delete $pending{$s};
+    $select->remove($s);
+    close $s;
+  }
+}
+
+while (1) {
+  # Wake up in time for the earliest pending chunk.
+  my $now = time;
+  my $timeout = 1;
+  for my $queue (values %pending) {
+    next unless @$queue;
+    my $wait = $queue->[0][0] - $now;
+    $timeout = $wait if $wait < $timeout;
+  }
+  $timeout = 0 if $timeout < 0;
+
+  for my $sock ($select->can_read($timeout)) {
+    if ($sock == $listener) {
+      my $client = $listener->accept() or next;
+      my $server = IO::Socket::INET->new(PeerAddr => $target) or do {
+        warn "$0: unable to connect to $target: $!\n";
+        close $client;
+        next;
+      };
+      $peer{$client} = $server;
+      $peer{$server} = $client;
+      $pending{$client} = [];
+      $pending{$server} = [];
+      $select->add($client, $server);
+      next;
+    }
+    my $data;
+    my $n = sysread($sock, $data, 65536);
+    if (!$n) {
+      close_pair($sock);
+      next;
+    }
+    push @{$pending{$peer{$sock}}}, [time + $delay, $data];
+  }
+
+  $now = time;
+  for my $sock ($select->handles) {
+    next if $sock == $listener || !exists $pending{$sock};
+    my $queue = $pending{$sock};
+    while (@$queue && $queue->[0][0] <= $now) {
+      my $chunk = shift @$queue;
+      my $data = $chunk->[1];
+      while (length $data) {
+        my $written = syswrite($sock, $data);
+        last unless defined $written;
+        substr($data, 0, $written) = '';
+      }
+    }
+  }
+}
@@ -0,0 +1,22 @@
+#!/bin/bash -vx
+#
+# Latency and throughput of 100 byte samples written at 200000/s over
+# udp, without batching and with several batch_bytes/batch_delay
+# settings.  With transport debugging on, the publisher logs how many
+# batches were sent by the timer instead of by filling up.
+#
+
+export BENCHBASE=$DDS_ROOT/performance-tests/Bench
+export TESTBASE=$BENCHBASE/tests/batching
+export TESTCMD="$BENCHBASE/bin/run_test -t 60 -S -h localhost:2809 -P -T 1"
+export BATCHING=${BATCHING-"none 1400-100 1400-1000 8000-1000"}
+
+mkdir -p run
+pushd run
+for batching in $BATCHING; do
+  $TESTCMD -f batching-$batching.log -i $TESTBASE/transport-$batching.ini \
+           -s $TESTBASE/s1.ini,$TESTBASE/p1.ini
+  mv latency-s1.data batching-$batching-latency-s1.data
+done
+popd
+
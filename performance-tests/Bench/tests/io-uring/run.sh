@@ -0,0 +1,26 @@
+#!/bin/bash -vx
+#
+# System calls and delivery latency of the udp, rtps_udp and tcp
+# transports receiving through the reactor versus through io_uring.
+# perf stat counts the system calls made by every process of a run;
+# with io_uring the DataLinks also log their own completion and
+# io_uring_enter() counts at shutdown.
+#
+
+export BENCHBASE=$DDS_ROOT/performance-tests/Bench
+export TESTBASE=$BENCHBASE/tests/io-uring
+export TESTCMD="$BENCHBASE/bin/run_test -t 60 -S -h localhost:2809 -P -T 1"
+export TRANSPORTS=${TRANSPORTS-"udp rtps_udp tcp"}
+
+mkdir -p run
+pushd run
+for transport in $TRANSPORTS; do
+  for mode in reactor io_uring; do
+    perf stat -e raw_syscalls:sys_enter -o $transport-$mode-syscalls.txt \
+      $TESTCMD -f $transport-$mode.log -i $TESTBASE/transport-$transport-$mode.ini \
+               -s $TESTBASE/s1.ini,$TESTBASE/p1.ini
+    mv latency-s1.data $transport-$mode-latency-s1.data
+    grep -h "io_uring completions" $transport-$mode.log >> $transport-$mode-syscalls.txt
+  done
+done
+popd
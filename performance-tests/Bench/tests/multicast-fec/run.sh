@@ -0,0 +1,31 @@
+#!/bin/bash -vx
+#
+# Delivery latency and repair traffic of the reliable multicast transport
+# under injected loss, with repair requests (NAKs) only and with forward
+# error correction (fec_k/fec_m).  The publishing transport drops
+# datagrams with send_loss_rate/send_loss_burst; repair traffic is taken
+# from the transport's statistics logged at shutdown.
+#
+
+export BENCHBASE=$DDS_ROOT/performance-tests/Bench
+export TESTBASE=$BENCHBASE/tests/multicast-fec
+export TESTCMD="$BENCHBASE/bin/run_test -t 60 -S -h localhost:2809 -P -T 1"
+export LOSS_RATES=${LOSS_RATES-"0.001 0.01 0.05"}
+export LOSS_BURST=${LOSS_BURST-1}
+
+for rate in $LOSS_RATES; do
+  mkdir -p run/$rate
+  pushd run/$rate
+  for mode in nak fec-8-1 fec-8-2; do
+    sed -e "s/@LOSS_RATE@/$rate/" -e "s/@LOSS_BURST@/$LOSS_BURST/" \
+      $TESTBASE/transport-$mode.ini > transport-$mode.ini
+    $TESTCMD -f $mode.log -i transport-$mode.ini -s $TESTBASE/s1.ini,$TESTBASE/p1.ini
+    mv latency-s1.data $mode-latency-s1.data
+    {
+      echo "$mode loss $rate burst $LOSS_BURST"
+      grep -h "naks sent" $mode.log
+      grep -h "fec parity sent" $mode.log
+    } > $mode-repair.txt
+  done
+  popd
+done
@@ -0,0 +1,29 @@
+#!/bin/bash -vx
+#
+# Receive throughput of one subscription fed by 8 publishing processes,
+# with the subscriber's tcp transport using 1, 2, 4 and 8 reactor
+# threads.  Set REACTOR_CPUS (e.g. "0,1,2,3") to also bind the reactor
+# threads to those cpus.
+#
+
+export BENCHBASE=$DDS_ROOT/performance-tests/Bench
+export TESTBASE=$BENCHBASE/tests/reactor-scaling
+export TESTCMD="$BENCHBASE/bin/run_test -t 60 -S -h localhost:2809 -P"
+
+PUBLICATIONS=
+for i in 1 2 3 4 5 6 7 8; do
+  PUBLICATIONS=$PUBLICATIONS,$TESTBASE/p1.ini
+done
+
+mkdir -p run
+pushd run
+for reactors in 1 2 4 8; do
+  TRANSPORT=$TESTBASE/transport-reactors-$reactors.ini
+  if [ -n "$REACTOR_CPUS" ]; then
+    sed -e "s/^reactor_threads=.*/&\nreactor_cpus=$REACTOR_CPUS/" $TRANSPORT > transport-reactors-$reactors.ini
+    TRANSPORT=transport-reactors-$reactors.ini
+  fi
+  $TESTCMD -i $TRANSPORT -s $TESTBASE/s1.ini$PUBLICATIONS
+  mv latency-s1.data reactors-$reactors-latency-s1.data
+done
+popd
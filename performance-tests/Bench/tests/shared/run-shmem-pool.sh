@@ -0,0 +1,29 @@
+#!/bin/bash -vx
+#
+# Compare large-sample (1 MB) throughput of the shmem transport with a
+# default pool against a pool using huge pages, pre-faulting and NUMA binding.
+# The subscriber data files in run/shmem-pool/<N>-1 record the received
+# samples; compare default-* with tuned-* for each publisher count.
+#
+
+export BENCHBASE=$DDS_ROOT/performance-tests/Bench
+export TESTBASE=$BENCHBASE/tests/shared
+export TESTCMD="$BENCHBASE/bin/run_test -t 60 -S -h localhost:2809 -P"
+export NUMACMD="${NUMACMD-numactl --cpunodebind=0 --membind=0}"
+
+export TRANSPORT_DEFAULT=$TESTBASE/transport-shmem-pool.ini
+export TRANSPORT_TUNED=$TESTBASE/transport-shmem-pool-tuned.ini
+
+for pubs in 1 2 4; do
+  PUBLICATIONS=
+  for ((i = 0; i < pubs; ++i)); do
+    PUBLICATIONS=$PUBLICATIONS,$TESTBASE/p1-large.ini
+  done
+  mkdir -p run/shmem-pool/$pubs-1
+  pushd run/shmem-pool/$pubs-1
+  $NUMACMD $TESTCMD -i $TRANSPORT_DEFAULT -s $TESTBASE/s1-large.ini$PUBLICATIONS > default.log 2>&1
+  mv latency-s1-large.data default-latency-s1.data
+  $NUMACMD $TESTCMD -i $TRANSPORT_TUNED -s $TESTBASE/s1-large.ini$PUBLICATIONS > tuned.log 2>&1
+  mv latency-s1-large.data tuned-latency-s1.data
+  popd
+done
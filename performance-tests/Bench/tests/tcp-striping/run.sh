@@ -0,0 +1,31 @@
+#!/bin/bash -vx
+#
+# Throughput of 8 publications over one logical tcp link, unstriped versus
+# striped across 4 connections, with loopback latency added by
+# delay-proxy.pl instead of netem.
+#
+
+export BENCHBASE=$DDS_ROOT/performance-tests/Bench
+export TESTBASE=$BENCHBASE/tests/tcp-striping
+export TESTCMD="$BENCHBASE/bin/run_test -t 60 -S -h localhost:2809 -P"
+export DELAY_MS=${DELAY_MS-10}
+
+$BENCHBASE/bin/delay-proxy.pl 41001 127.0.0.1:40001 $DELAY_MS &
+PROXY1=$!
+$BENCHBASE/bin/delay-proxy.pl 41002 127.0.0.1:40002 $DELAY_MS &
+PROXY2=$!
+
+PUBLICATIONS=
+for i in 1 2 3 4 5 6 7 8; do
+  PUBLICATIONS=$PUBLICATIONS,$TESTBASE/p1.ini
+done
+
+mkdir -p run/$DELAY_MS
+pushd run/$DELAY_MS
+for stripes in 1 4; do
+  $TESTCMD -i $TESTBASE/transport-stripes-$stripes.ini -s $TESTBASE/s1.ini$PUBLICATIONS
+  mv latency-s1.data stripes-$stripes-latency-s1.data
+done
+popd
+
+kill $PROXY1 $PROXY2
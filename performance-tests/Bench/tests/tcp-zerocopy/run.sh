@@ -0,0 +1,22 @@
+#!/bin/bash -vx
+#
+# Throughput and CPU cost of the tcp transport with and without zero-copy
+# sends (zerocopy_threshold) and corking (enable_cork) for samples from
+# 64 KB to 8 MB.  Each publication offers about 1 GB/s.  CPU usage of the
+# whole test is taken from /usr/bin/time and written next to the data files.
+#
+
+export BENCHBASE=$DDS_ROOT/performance-tests/Bench
+export TESTBASE=$BENCHBASE/tests/tcp-zerocopy
+export TESTCMD="$BENCHBASE/bin/run_test -t 60 -S -h localhost:2809 -P"
+
+for size in 65536 262144 1048576 4194304 8388608; do
+  mkdir -p run/$size
+  pushd run/$size
+  for transport in copy zerocopy; do
+    /usr/bin/time -v -o $transport-cpu.txt \
+      $TESTCMD -i $TESTBASE/transport-$transport.ini -s $TESTBASE/s1.ini,$TESTBASE/p-$size.ini
+    mv latency-s1.data $transport-latency-s1.data
+  done
+  popd
+done
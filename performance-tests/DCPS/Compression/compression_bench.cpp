@@ -0,0 +1,195 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+// Compresses representative sample payloads with each compressor the
+// transport framework was built with and reports the compression ratio
+// and the CPU time it costs per sample, to choose the transport's
+// "compression" and "compression_threshold" options.
+
+#include <dds/DCPS/transport/framework/Compressor.h>
+
+#include <ace/Arg_Shifter.h>
+#include <ace/Log_Msg.h>
+#include <ace/OS_NS_stdlib.h>
+#include <ace/Profile_Timer.h>
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+using OpenDDS::DCPS::Compressor;
+
+namespace {
+
+/// Doubles from slowly drifting sensors, as a telemetry sample holds.
+void telemetry(std::vector<char>& payload, size_t size)
+{
+  payload.resize(size);
+  double value = 20.0;
+  for (size_t i = 0; i + sizeof value <= size; i += sizeof value) {
+    value += (ACE_OS::rand() % 200 - 100) / 1000.0;
+    std::memcpy(&payload[i], &value, sizeof value);
+  }
+}
+
+/// Strings with repeated field names and small numbers, as a sample of
+/// a struct with a sequence of records holds.
+void records(std::vector<char>& payload, size_t size)
+{
+  payload.clear();
+  char record[128];
+  for (int i = 0; payload.size() < size; ++i) {
+    const int n = std::sprintf(record,
+                               "{\"id\":%d,\"status\":\"%s\",\"temperature\":%d,"
+                               "\"location\":\"building-%d/floor-%d\"}",
+                               i, (i % 7) ? "nominal" : "degraded",
+                               60 + ACE_OS::rand() % 20, i % 4, i % 12);
+    payload.insert(payload.end(), record, record + n);
+  }
+  payload.resize(size);
+}
+
+/// Mostly zero octets with a few set ones, as an image mask or an
+/// occupancy grid holds.
+void sparse(std::vector<char>& payload, size_t size)
+{
+  payload.assign(size, 0);
+  for (size_t i = 0; i < size / 64; ++i) {
+    payload[ACE_OS::rand() % size] = static_cast<char>(ACE_OS::rand());
+  }
+}
+
+/// Octets that do not compress, as encrypted or already compressed data.
+void incompressible(std::vector<char>& payload, size_t size)
+{
+  payload.resize(size);
+  for (size_t i = 0; i < size; ++i) {
+    payload[i] = static_cast<char>(ACE_OS::rand());
+  }
+}
+
+struct Payload {
+  const char* name;
+  void (*fill)(std::vector<char>&, size_t);
+};
+
+const Payload payloads[] = {
+  { "telemetry", telemetry },
+  { "records", records },
+  { "sparse", sparse },
+  { "random", incompressible }
+};
+
+double cpu_usec(ACE_Profile_Timer& timer)
+{
+  ACE_Profile_Timer::ACE_Elapsed_Time elapsed;
+  timer.elapsed_time(elapsed);
+  return (elapsed.user_time + elapsed.system_time) * 1e6;
+}
+
+}
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR* argv[])
+{
+  int iterations = 1000;
+  int level = 0;
+  ACE_Arg_Shifter_T<ACE_TCHAR> shifter(argc, argv);
+  while (shifter.is_anything_left()) {
+    const ACE_TCHAR* currentArg = 0;
+    if ((currentArg = shifter.get_the_parameter(ACE_TEXT("-n"))) != 0) {
+      iterations = ACE_OS::atoi(currentArg);
+      shifter.consume_arg();
+    } else if ((currentArg = shifter.get_the_parameter(ACE_TEXT("-l"))) != 0) {
+      level = ACE_OS::atoi(currentArg);
+      shifter.consume_arg();
+    } else {
+      shifter.ignore_arg();
+    }
+  }
+
+  std::vector<const Compressor*> compressors;
+  for (int kind = Compressor::NONE + 1; kind <= Compressor::MAX_KIND; ++kind) {
+    const Compressor* const compressor =
+      Compressor::find(static_cast<Compressor::Kind>(kind));
+    if (compressor) {
+      compressors.push_back(compressor);
+    }
+  }
+  if (compressors.empty()) {
+    ACE_ERROR_RETURN((LM_ERROR,
+                      ACE_TEXT("ERROR: no compressor is available, ")
+                      ACE_TEXT("configure OpenDDS with --lz4 or --zstd\n")), 1);
+  }
+
+  const size_t sizes[] = { 256, 1024, 4096, 16384, 65536 };
+  const size_t n_sizes = sizeof sizes / sizeof sizes[0];
+
+  std::printf("%-6s %-10s %7s %7s %12s %12s %10s %10s\n",
+              "algo", "payload", "bytes", "ratio",
+              "comp us/smp", "dec us/smp", "comp MB/s", "dec MB/s");
+
+  std::vector<char> payload;
+  std::vector<char> compressed;
+  std::vector<char> restored;
+  int status = 0;
+
+  for (size_t c = 0; c < compressors.size(); ++c) {
+    const Compressor& compressor = *compressors[c];
+    for (size_t p = 0; p < sizeof payloads / sizeof payloads[0]; ++p) {
+      for (size_t s = 0; s < n_sizes; ++s) {
+        const size_t size = sizes[s];
+        ACE_OS::srand(static_cast<u_int>(size));
+        payloads[p].fill(payload, size);
+        compressed.resize(compressor.bound(size));
+        restored.resize(size);
+
+        size_t compressed_size = 0;
+        ACE_Profile_Timer timer;
+        timer.start();
+        for (int i = 0; i < iterations; ++i) {
+          compressed_size = compressor.compress(&payload[0], size,
+                                                &compressed[0], compressed.size(),
+                                                level);
+        }
+        timer.stop();
+        const double compress_usec = cpu_usec(timer) / iterations;
+
+        if (compressed_size == 0) {
+          ACE_ERROR((LM_ERROR, ACE_TEXT("ERROR: %C failed to compress %C\n"),
+                     compressor.name(), payloads[p].name));
+          status = 1;
+          continue;
+        }
+
+        bool ok = true;
+        timer.start();
+        for (int i = 0; i < iterations; ++i) {
+          ok = compressor.decompress(&compressed[0], compressed_size,
+                                     &restored[0], size) && ok;
+        }
+        timer.stop();
+        const double decompress_usec = cpu_usec(timer) / iterations;
+
+        if (!ok || restored != payload) {
+          ACE_ERROR((LM_ERROR, ACE_TEXT("ERROR: %C did not restore %C\n"),
+                     compressor.name(), payloads[p].name));
+          status = 1;
+        }
+
+        std::printf("%-6s %-10s %7u %7.2f %12.2f %12.2f %10.1f %10.1f\n",
+                    compressor.name(), payloads[p].name, unsigned(size),
+                    double(size) / (compressed_size + Compressor::PREFIX_SIZE),
+                    compress_usec, decompress_usec,
+                    compress_usec > 0 ? size / compress_usec : 0.0,
+                    decompress_usec > 0 ? size / decompress_usec : 0.0);
+      }
+    }
+  }
+
+  return status;
+}
@@ -0,0 +1,20 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+    & eval 'exec perl -S $0 $argv:q'
+    if 0;
+
+# Reports the compression ratio and CPU cost per sample of each
+# compressor OpenDDS was built with (configure --lz4 and/or --zstd).
+# Arguments are passed on to compression_bench: -n <iterations> and
+# -l <compression_level>.
+
+use Env (DDS_ROOT);
+use lib "$DDS_ROOT/bin";
+use Env (ACE_ROOT);
+use lib "$ACE_ROOT/bin";
+use PerlDDS::Run_Test;
+use strict;
+
+my $test = new PerlDDS::TestFramework();
+$test->process('bench', 'compression_bench', join(' ', @ARGV));
+$test->start_process('bench');
+exit $test->finish(300);
@@ -0,0 +1,200 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+// With -w, writes a sample every 10 ms for -t seconds.  Otherwise, creates
+// a subscriber and reports the time from the creation of its participant
+// to its first sample, which is mostly the time RTPS discovery takes to
+// find the writer.  With -c, the DiscoveryCache option is set, so when the
+// subscriber restarts the writer is preloaded as it was last discovered
+// and the reader is associated with it before it is discovered again.
+// -l labels the report.
+
+#include "DiscoveryCacheRestartTypeSupportImpl.h"
+
+#include <dds/DCPS/Marked_Default_Qos.h>
+#include <dds/DCPS/Service_Participant.h>
+#include <dds/DCPS/WaitSet.h>
+
+#include <dds/DCPS/RTPS/RtpsDiscovery.h>
+
+#include "dds/DCPS/StaticIncludes.h"
+#ifdef ACE_AS_STATIC_LIBS
+#include <dds/DCPS/transport/rtps_udp/RtpsUdp.h>
+#endif
+
+#include <ace/Arg_Shifter.h>
+#include <ace/Log_Msg.h>
+#include <ace/OS_NS_stdlib.h>
+#include <ace/OS_NS_sys_time.h>
+#include <ace/OS_NS_unistd.h>
+
+#include <cstdio>
+
+namespace {
+
+const DDS::DomainId_t domain = 49;
+const char topic_name[] = "DiscoveryCacheRestart";
+
+double msec_since(const ACE_Time_Value& start)
+{
+  const ACE_Time_Value elapsed = ACE_OS::gettimeofday() - start;
+  return elapsed.sec() * 1e3 + elapsed.usec() / 1e3;
+}
+
+DDS::Topic_ptr create_topic(DDS::DomainParticipant_ptr participant)
+{
+  DiscoveryCacheRestart::SampleTypeSupport_var ts =
+    new DiscoveryCacheRestart::SampleTypeSupportImpl;
+  if (ts->register_type(participant, "") != DDS::RETCODE_OK) {
+    ACE_ERROR_RETURN((LM_ERROR,
+                      ACE_TEXT("ERROR: register_type failed\n")), 0);
+  }
+  const CORBA::String_var type_name = ts->get_type_name();
+  return participant->create_topic(topic_name, type_name, TOPIC_QOS_DEFAULT, 0,
+                                   OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+}
+
+int publish(DDS::DomainParticipant_ptr participant, int duration_sec)
+{
+  DDS::Topic_var topic = create_topic(participant);
+  if (CORBA::is_nil(topic.in())) {
+    return 1;
+  }
+  DDS::Publisher_var publisher =
+    participant->create_publisher(PUBLISHER_QOS_DEFAULT, 0,
+                                  OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+  DDS::DataWriter_var writer =
+    publisher->create_datawriter(topic.in(), DATAWRITER_QOS_DEFAULT, 0,
+                                 OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+  DiscoveryCacheRestart::SampleDataWriter_var sample_writer =
+    DiscoveryCacheRestart::SampleDataWriter::_narrow(writer.in());
+  if (CORBA::is_nil(sample_writer.in())) {
+    ACE_ERROR_RETURN((LM_ERROR,
+                      ACE_TEXT("ERROR: create_datawriter failed\n")), 1);
+  }
+
+  const ACE_Time_Value end = ACE_OS::gettimeofday() + ACE_Time_Value(duration_sec);
+  DiscoveryCacheRestart::Sample sample;
+  sample.id = 0;
+  while (ACE_OS::gettimeofday() < end) {
+    sample_writer->write(sample, DDS::HANDLE_NIL);
+    ++sample.id;
+    ACE_OS::sleep(ACE_Time_Value(0, 10000));
+  }
+  return 0;
+}
+
+int subscribe(DDS::DomainParticipant_ptr participant, const ACE_Time_Value& start,
+              int timeout_sec, const char* label, bool cache)
+{
+  DDS::Topic_var topic = create_topic(participant);
+  if (CORBA::is_nil(topic.in())) {
+    return 1;
+  }
+  DDS::Subscriber_var subscriber =
+    participant->create_subscriber(SUBSCRIBER_QOS_DEFAULT, 0,
+                                   OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+  DDS::DataReaderQos qos;
+  subscriber->get_default_datareader_qos(qos);
+  qos.reliability.kind = DDS::RELIABLE_RELIABILITY_QOS;
+  DDS::DataReader_var reader =
+    subscriber->create_datareader(topic.in(), qos, 0,
+                                  OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+  if (CORBA::is_nil(reader.in())) {
+    ACE_ERROR_RETURN((LM_ERROR,
+                      ACE_TEXT("ERROR: create_datareader failed\n")), 1);
+  }
+
+  DDS::ReadCondition_var condition =
+    reader->create_readcondition(DDS::ANY_SAMPLE_STATE, DDS::ANY_VIEW_STATE,
+                                 DDS::ANY_INSTANCE_STATE);
+  DDS::WaitSet_var ws = new DDS::WaitSet;
+  ws->attach_condition(condition.in());
+  DDS::ConditionSeq active;
+  const DDS::Duration_t timeout = { timeout_sec, 0 };
+  const bool received = ws->wait(active, timeout) == DDS::RETCODE_OK;
+  const double elapsed = msec_since(start);
+  ws->detach_condition(condition.in());
+  reader->delete_readcondition(condition.in());
+
+  if (!received) {
+    ACE_ERROR_RETURN((LM_ERROR,
+                      ACE_TEXT("ERROR: %C: no sample in %d seconds\n"),
+                      label, timeout_sec), 1);
+  }
+  std::printf("%-8s cache %-3s first sample after %10.1f ms\n",
+              label, cache ? "on" : "off", elapsed);
+  return 0;
+}
+
+}
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR* argv[])
+{
+  int status = 0;
+  try {
+    DDS::DomainParticipantFactory_var dpf =
+      TheParticipantFactoryWithArgs(argc, argv);
+
+    bool writer = false;
+    bool cache = false;
+    int time_sec = 30;
+    ACE_TString label = ACE_TEXT("restart");
+    ACE_Arg_Shifter_T<ACE_TCHAR> shifter(argc, argv);
+    while (shifter.is_anything_left()) {
+      const ACE_TCHAR* currentArg = 0;
+      if (shifter.cur_arg_strncasecmp(ACE_TEXT("-w")) == 0) {
+        writer = true;
+        shifter.consume_arg();
+      } else if (shifter.cur_arg_strncasecmp(ACE_TEXT("-c")) == 0) {
+        cache = true;
+        shifter.consume_arg();
+      } else if ((currentArg = shifter.get_the_parameter(ACE_TEXT("-t"))) != 0) {
+        time_sec = ACE_OS::atoi(currentArg);
+        shifter.consume_arg();
+      } else if ((currentArg = shifter.get_the_parameter(ACE_TEXT("-l"))) != 0) {
+        label = currentArg;
+        shifter.consume_arg();
+      } else {
+        shifter.ignore_arg();
+      }
+    }
+
+    OpenDDS::RTPS::RtpsDiscovery_rch disco =
+      OpenDDS::DCPS::dynamic_rchandle_cast<OpenDDS::RTPS::RtpsDiscovery>(
+        TheServiceParticipant->get_discovery(domain));
+    if (!disco) {
+      ACE_ERROR_RETURN((LM_ERROR,
+                        ACE_TEXT("ERROR: the domain doesn't use RTPS discovery\n")), 1);
+    }
+    disco->discovery_cache(cache);
+
+    const ACE_Time_Value start = ACE_OS::gettimeofday();
+    DDS::DomainParticipant_var participant =
+      dpf->create_participant(domain, PARTICIPANT_QOS_DEFAULT, 0,
+                              OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+    if (CORBA::is_nil(participant.in())) {
+      ACE_ERROR_RETURN((LM_ERROR,
+                        ACE_TEXT("ERROR: create_participant failed\n")), 1);
+    }
+
+    status = writer ? publish(participant.in(), time_sec)
+      : subscribe(participant.in(), start, time_sec,
+                  ACE_TEXT_ALWAYS_CHAR(label.c_str()), cache);
+
+    participant->delete_contained_entities();
+    dpf->delete_participant(participant.in());
+    TheServiceParticipant->shutdown();
+
+  } catch (const CORBA::Exception& e) {
+    e._tao_print_exception("Exception caught in main():");
+    status = 1;
+  }
+
+  return status;
+}
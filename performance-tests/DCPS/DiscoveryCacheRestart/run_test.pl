@@ -0,0 +1,40 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+    & eval 'exec perl -S $0 $argv:q'
+    if 0;
+
+# Reports the time from the start of a subscriber to its first sample
+# from a running publisher, when the subscriber discovers the publisher
+# from scratch ("cold") and when it restarts with the publisher preloaded
+# from its DiscoveryCache ("cached").  The first run with the cache only
+# fills it.
+
+use Env (DDS_ROOT);
+use lib "$DDS_ROOT/bin";
+use Env (ACE_ROOT);
+use lib "$ACE_ROOT/bin";
+use PerlDDS::Run_Test;
+use File::Path qw(rmtree);
+use strict;
+
+my $dir = 'discovery_cache_dir';
+rmtree($dir);
+
+my $common = '-DCPSConfigFile discovery_cache_restart.ini ' .
+  "-DCPSPersistentDataDir $dir";
+
+my $test = new PerlDDS::TestFramework();
+$test->process('publisher', 'discovery_cache_restart', "$common -w -t 120");
+$test->start_process('publisher');
+sleep 2;
+
+my @runs = (['cold', ''], ['fill', '-c'], ['cached', '-c']);
+foreach my $run (@runs) {
+  my ($name, $args) = @$run;
+  $test->process($name, 'discovery_cache_restart', "$common -l $name $args");
+  $test->start_process($name);
+  $test->stop_process(60, $name);
+}
+
+$test->kill_process(5, 'publisher');
+rmtree($dir);
+exit $test->finish(5);
@@ -0,0 +1,347 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+// Creates a synthetic domain of participants in this process, each with
+// writers and readers spread over a number of topics and partitions,
+// and reports how long RTPS discovery takes until every reader has
+// matched each writer on its topic and in its partition.  Writers and
+// readers in different partitions are never matched, so raising the
+// number of partitions shows what the endpoint match keys save.  With
+// -s, it then reports the CPU time discovery uses in the steady state,
+// when it only repeats its announcements (for instance with -p 2 -e 1000
+// for 1000 local endpoints per participant).
+//
+// All the participants start at once, as after the restart of a system,
+// so -j <ms> (SpdpInitialJitter), -m <messages per second>
+// (SedpMaxMessageRate) and -b <messages> (SedpMaxBurst) show how the
+// discovery storm control changes the time until the domain is matched.
+
+#include "DiscoveryScalingTypeSupportImpl.h"
+
+#include <dds/DCPS/Marked_Default_Qos.h>
+#include <dds/DCPS/Service_Participant.h>
+#include <dds/DCPS/transport/framework/TransportConfig.h>
+#include <dds/DCPS/transport/framework/TransportRegistry.h>
+
+#include <dds/DCPS/RTPS/RtpsDiscovery.h>
+
+#include "dds/DCPS/StaticIncludes.h"
+#ifdef ACE_AS_STATIC_LIBS
+#include <dds/DCPS/transport/rtps_udp/RtpsUdp.h>
+#endif
+
+#include <ace/Arg_Shifter.h>
+#include <ace/Log_Msg.h>
+#include <ace/OS_NS_stdlib.h>
+#include <ace/OS_NS_sys_resource.h>
+#include <ace/OS_NS_sys_time.h>
+#include <ace/OS_NS_unistd.h>
+
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+const DDS::DomainId_t domain = 48;
+
+struct Layout {
+  int participants;
+  int endpoints;
+  int topics;
+  int partitions;
+
+  /// Even endpoints of a participant are writers, odd ones readers.
+  static bool is_writer(int endpoint) { return endpoint % 2 == 0; }
+
+  int topic(int endpoint) const { return (endpoint / 2) % topics; }
+
+  int partition(int participant, int endpoint) const
+  {
+    return (participant + endpoint / 2) % partitions;
+  }
+
+  /// Writer/reader pairs with the same topic and partition, which are
+  /// the associations discovery has to make.
+  long expected_matches() const
+  {
+    std::vector<long> writers(topics * partitions, 0);
+    for (int p = 0; p < participants; ++p) {
+      for (int e = 0; e < endpoints; e += 2) {
+        ++writers[topic(e) * partitions + partition(p, e)];
+      }
+    }
+    long matches = 0;
+    for (int p = 0; p < participants; ++p) {
+      for (int e = 1; e < endpoints; e += 2) {
+        matches += writers[topic(e) * partitions + partition(p, e)];
+      }
+    }
+    return matches;
+  }
+};
+
+struct Participant {
+  DDS::DomainParticipant_var participant;
+  std::vector<DDS::Topic_var> topics;
+  std::vector<DDS::Publisher_var> publishers;
+  std::vector<DDS::Subscriber_var> subscribers;
+  std::vector<DDS::DataWriter_var> writers;
+  std::vector<DDS::DataReader_var> readers;
+};
+
+void partition_name(int partition, DDS::PartitionQosPolicy& qos)
+{
+  char name[32];
+  std::sprintf(name, "partition-%d", partition);
+  qos.name.length(1);
+  qos.name[0] = name;
+}
+
+/// Creates participant @a index of @a layout with its own rtps_udp
+/// transport instance.  Returns false on an error.
+bool create(DDS::DomainParticipantFactory_ptr dpf, int index,
+            const Layout& layout, Participant& part)
+{
+  part.participant =
+    dpf->create_participant(domain, PARTICIPANT_QOS_DEFAULT, 0,
+                            OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+  if (CORBA::is_nil(part.participant.in())) {
+    ACE_ERROR_RETURN((LM_ERROR,
+                      ACE_TEXT("ERROR: create_participant failed\n")), false);
+  }
+
+  char name[32];
+  std::sprintf(name, "rtps%d", index);
+  OpenDDS::DCPS::TransportConfig_rch config =
+    TheTransportRegistry->create_config(name);
+  config->instances_.push_back(TheTransportRegistry->create_inst(name, "rtps_udp"));
+  TheTransportRegistry->bind_config(config, part.participant.in());
+
+  DiscoveryScaling::SampleTypeSupport_var ts =
+    new DiscoveryScaling::SampleTypeSupportImpl;
+  if (ts->register_type(part.participant.in(), "") != DDS::RETCODE_OK) {
+    ACE_ERROR_RETURN((LM_ERROR,
+                      ACE_TEXT("ERROR: register_type failed\n")), false);
+  }
+  const CORBA::String_var type_name = ts->get_type_name();
+
+  for (int t = 0; t < layout.topics; ++t) {
+    char topic_name[32];
+    std::sprintf(topic_name, "DiscoveryScaling%d", t);
+    part.topics.push_back(
+      part.participant->create_topic(topic_name, type_name, TOPIC_QOS_DEFAULT, 0,
+                                     OpenDDS::DCPS::DEFAULT_STATUS_MASK));
+  }
+
+  for (int k = 0; k < layout.partitions; ++k) {
+    DDS::PublisherQos pub_qos;
+    part.participant->get_default_publisher_qos(pub_qos);
+    partition_name(k, pub_qos.partition);
+    part.publishers.push_back(
+      part.participant->create_publisher(pub_qos, 0,
+                                         OpenDDS::DCPS::DEFAULT_STATUS_MASK));
+    DDS::SubscriberQos sub_qos;
+    part.participant->get_default_subscriber_qos(sub_qos);
+    partition_name(k, sub_qos.partition);
+    part.subscribers.push_back(
+      part.participant->create_subscriber(sub_qos, 0,
+                                          OpenDDS::DCPS::DEFAULT_STATUS_MASK));
+  }
+
+  for (int e = 0; e < layout.endpoints; ++e) {
+    const int k = layout.partition(index, e);
+    DDS::Topic_ptr topic = part.topics[layout.topic(e)].in();
+    if (Layout::is_writer(e)) {
+      DDS::DataWriter_var writer =
+        part.publishers[k]->create_datawriter(topic, DATAWRITER_QOS_DEFAULT, 0,
+                                              OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+      if (CORBA::is_nil(writer.in())) {
+        ACE_ERROR_RETURN((LM_ERROR,
+                          ACE_TEXT("ERROR: create_datawriter failed\n")), false);
+      }
+      part.writers.push_back(writer);
+    } else {
+      DDS::DataReader_var reader =
+        part.subscribers[k]->create_datareader(topic, DATAREADER_QOS_DEFAULT, 0,
+                                               OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+      if (CORBA::is_nil(reader.in())) {
+        ACE_ERROR_RETURN((LM_ERROR,
+                          ACE_TEXT("ERROR: create_datareader failed\n")), false);
+      }
+      part.readers.push_back(reader);
+    }
+  }
+  return true;
+}
+
+long matched(const std::vector<Participant>& parts)
+{
+  long total = 0;
+  for (size_t p = 0; p < parts.size(); ++p) {
+    for (size_t r = 0; r < parts[p].readers.size(); ++r) {
+      DDS::SubscriptionMatchedStatus status;
+      if (parts[p].readers[r]->get_subscription_matched_status(status) == DDS::RETCODE_OK) {
+        total += status.current_count;
+      }
+    }
+  }
+  return total;
+}
+
+double seconds_since(const ACE_Time_Value& start)
+{
+  const ACE_Time_Value elapsed = ACE_OS::gettimeofday() - start;
+  return elapsed.sec() + elapsed.usec() / 1e6;
+}
+
+/// User and system CPU time of this process in seconds.
+double cpu_seconds()
+{
+  ACE_Rusage usage;
+  if (ACE_OS::getrusage(RUSAGE_SELF, &usage) != 0) {
+    return 0;
+  }
+  const ACE_Time_Value cpu = ACE_Time_Value(usage.ru_utime) + ACE_Time_Value(usage.ru_stime);
+  return cpu.sec() + cpu.usec() / 1e6;
+}
+
+}
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR* argv[])
+{
+  int status = 0;
+  try {
+    DDS::DomainParticipantFactory_var dpf =
+      TheParticipantFactoryWithArgs(argc, argv);
+
+    Layout layout = { 20, 100, 10, 4 };
+    int timeout_sec = 600;
+    int steady_sec = 0;
+    int jitter_msec = -1, max_message_rate = -1, max_burst = -1;
+    ACE_Arg_Shifter_T<ACE_TCHAR> shifter(argc, argv);
+    while (shifter.is_anything_left()) {
+      const ACE_TCHAR* currentArg = 0;
+      if ((currentArg = shifter.get_the_parameter(ACE_TEXT("-p"))) != 0) {
+        layout.participants = ACE_OS::atoi(currentArg);
+        shifter.consume_arg();
+      } else if ((currentArg = shifter.get_the_parameter(ACE_TEXT("-e"))) != 0) {
+        layout.endpoints = ACE_OS::atoi(currentArg);
+        shifter.consume_arg();
+      } else if ((currentArg = shifter.get_the_parameter(ACE_TEXT("-T"))) != 0) {
+        layout.topics = ACE_OS::atoi(currentArg);
+        shifter.consume_arg();
+      } else if ((currentArg = shifter.get_the_parameter(ACE_TEXT("-k"))) != 0) {
+        layout.partitions = ACE_OS::atoi(currentArg);
+        shifter.consume_arg();
+      } else if ((currentArg = shifter.get_the_parameter(ACE_TEXT("-t"))) != 0) {
+        timeout_sec = ACE_OS::atoi(currentArg);
+        shifter.consume_arg();
+      } else if ((currentArg = shifter.get_the_parameter(ACE_TEXT("-s"))) != 0) {
+        steady_sec = ACE_OS::atoi(currentArg);
+        shifter.consume_arg();
+      } else if ((currentArg = shifter.get_the_parameter(ACE_TEXT("-j"))) != 0) {
+        jitter_msec = ACE_OS::atoi(currentArg);
+        shifter.consume_arg();
+      } else if ((currentArg = shifter.get_the_parameter(ACE_TEXT("-m"))) != 0) {
+        max_message_rate = ACE_OS::atoi(currentArg);
+        shifter.consume_arg();
+      } else if ((currentArg = shifter.get_the_parameter(ACE_TEXT("-b"))) != 0) {
+        max_burst = ACE_OS::atoi(currentArg);
+        shifter.consume_arg();
+      } else {
+        shifter.ignore_arg();
+      }
+    }
+    if (layout.participants < 1 || layout.endpoints < 2 ||
+        layout.topics < 1 || layout.partitions < 1) {
+      ACE_ERROR_RETURN((LM_ERROR,
+                        ACE_TEXT("ERROR: -p, -T and -k must be at least 1 ")
+                        ACE_TEXT("and -e at least 2\n")), 1);
+    }
+
+    // Override the configuration file's storm control.
+    OpenDDS::RTPS::RtpsDiscovery_rch disco =
+      OpenDDS::DCPS::dynamic_rchandle_cast<OpenDDS::RTPS::RtpsDiscovery>(
+        TheServiceParticipant->get_discovery(domain));
+    if (!disco) {
+      ACE_ERROR_RETURN((LM_ERROR,
+                        ACE_TEXT("ERROR: the domain doesn't use RTPS discovery\n")), 1);
+    }
+    if (jitter_msec >= 0) {
+      disco->spdp_initial_jitter(ACE_Time_Value(0, jitter_msec * 1000));
+    }
+    if (max_message_rate >= 0) {
+      disco->sedp_max_message_rate(max_message_rate);
+    }
+    if (max_burst >= 0) {
+      disco->sedp_max_burst(max_burst);
+    }
+
+    const long expected = layout.expected_matches();
+    const ACE_Time_Value start = ACE_OS::gettimeofday();
+    const double start_cpu = cpu_seconds();
+
+    std::vector<Participant> parts(layout.participants);
+    for (int p = 0; p < layout.participants; ++p) {
+      if (!create(dpf.in(), p, layout, parts[p])) {
+        return 1;
+      }
+    }
+    const double created = seconds_since(start);
+
+    const ACE_Time_Value deadline = start + ACE_Time_Value(timeout_sec);
+    long current = 0;
+    while ((current = matched(parts)) < expected &&
+           ACE_OS::gettimeofday() < deadline) {
+      ACE_OS::sleep(ACE_Time_Value(0, 100000));
+    }
+    const double elapsed = seconds_since(start);
+    const double matched_cpu = cpu_seconds() - start_cpu;
+
+    std::printf("%6s %9s %6s %10s %10s %10s %10s %10s %10s\n",
+                "parts", "endpoints", "topics", "partitions",
+                "expected", "matched", "created s", "matched s", "cpu s");
+    std::printf("%6d %9d %6d %10d %10ld %10ld %10.2f %10.2f %10.2f\n",
+                layout.participants, layout.participants * layout.endpoints,
+                layout.topics, layout.partitions, expected, current,
+                created, elapsed, matched_cpu);
+
+    std::printf("storm control: jitter %d ms, SEDP rate %u/s, burst %u\n",
+                int(disco->spdp_initial_jitter().msec()),
+                disco->sedp_max_message_rate(), disco->sedp_max_burst());
+
+    if (steady_sec > 0 && current == expected) {
+      // Nothing changes now, so discovery only resends its announcements.
+      const ACE_Time_Value steady_start = ACE_OS::gettimeofday();
+      const double steady_start_cpu = cpu_seconds();
+      ACE_OS::sleep(steady_sec);
+      const double steady_cpu = cpu_seconds() - steady_start_cpu;
+      const double steady_elapsed = seconds_since(steady_start);
+      std::printf("steady state: %.3f cpu s in %.2f s (%.2f%% of a core)\n",
+                  steady_cpu, steady_elapsed, 100 * steady_cpu / steady_elapsed);
+    }
+    if (current < expected) {
+      ACE_ERROR((LM_ERROR,
+                 ACE_TEXT("ERROR: only %d of %d associations were made in %d seconds\n"),
+                 int(current), int(expected), timeout_sec));
+      status = 1;
+    }
+
+    for (size_t p = 0; p < parts.size(); ++p) {
+      parts[p].participant->delete_contained_entities();
+      dpf->delete_participant(parts[p].participant.in());
+    }
+    TheServiceParticipant->shutdown();
+
+  } catch (const CORBA::Exception& e) {
+    e._tao_print_exception("Exception caught in main():");
+    status = 1;
+  }
+
+  return status;
+}
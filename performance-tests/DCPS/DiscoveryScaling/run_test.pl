@@ -0,0 +1,23 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+    & eval 'exec perl -S $0 $argv:q'
+    if 0;
+
+# Reports the time until every reader of a synthetic domain has matched
+# every writer it should.  Arguments are passed on to discovery_scaling:
+# -p <participants>, -e <endpoints per participant>, -T <topics>,
+# -k <partitions>, -t <timeout in seconds>, -s <seconds of steady state
+# to report the CPU time of>, and for the discovery storm control
+# -j <SPDP jitter ms>, -m <SEDP messages per second> and -b <SEDP burst>.
+
+use Env (DDS_ROOT);
+use lib "$DDS_ROOT/bin";
+use Env (ACE_ROOT);
+use lib "$ACE_ROOT/bin";
+use PerlDDS::Run_Test;
+use strict;
+
+my $test = new PerlDDS::TestFramework();
+$test->process('bench', 'discovery_scaling',
+               '-DCPSConfigFile discovery_scaling.ini ' . join(' ', @ARGV));
+$test->start_process('bench');
+exit $test->finish(900);
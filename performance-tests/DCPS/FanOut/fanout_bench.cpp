@@ -0,0 +1,300 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+// Writes samples over a udp link to 1, 8 and 64 readers of the same topic
+// in another participant, which all share the link, and reports the CPU
+// time the process spends per sample delivered to a reader.  With the
+// shared decode in ReceiveListenerSet the payload is demarshaled once per
+// sample instead of once per reader.
+
+#include "FanOutTypeSupportImpl.h"
+
+#include <dds/DCPS/LocalObject.h>
+#include <dds/DCPS/Marked_Default_Qos.h>
+#include <dds/DCPS/Service_Participant.h>
+#include <dds/DCPS/transport/framework/TransportRegistry.h>
+
+#include "dds/DCPS/StaticIncludes.h"
+#ifdef ACE_AS_STATIC_LIBS
+#include <dds/DCPS/RTPS/RtpsDiscovery.h>
+#include <dds/DCPS/transport/udp/Udp.h>
+#endif
+
+#include <ace/Arg_Shifter.h>
+#include <ace/Atomic_Op.h>
+#include <ace/Log_Msg.h>
+#include <ace/OS_NS_stdlib.h>
+#include <ace/OS_NS_sys_time.h>
+#include <ace/OS_NS_unistd.h>
+#include <ace/Profile_Timer.h>
+
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+const DDS::DomainId_t domain = 47;
+
+/// Takes and counts the samples of one reader.
+class CountingListener
+  : public virtual OpenDDS::DCPS::LocalObject<DDS::DataReaderListener> {
+public:
+  explicit CountingListener(ACE_Atomic_Op<ACE_Thread_Mutex, long>& received)
+    : received_(received)
+  {}
+
+  void on_data_available(DDS::DataReader_ptr reader)
+  {
+    FanOut::ReportDataReader_var report_reader =
+      FanOut::ReportDataReader::_narrow(reader);
+    FanOut::ReportSeq reports;
+    DDS::SampleInfoSeq infos;
+    while (report_reader->take(reports, infos, DDS::LENGTH_UNLIMITED,
+                               DDS::ANY_SAMPLE_STATE, DDS::ANY_VIEW_STATE,
+                               DDS::ANY_INSTANCE_STATE) == DDS::RETCODE_OK) {
+      for (CORBA::ULong i = 0; i < infos.length(); ++i) {
+        if (infos[i].valid_data) {
+          ++received_;
+        }
+      }
+      report_reader->return_loan(reports, infos);
+    }
+  }
+
+  void on_requested_deadline_missed(DDS::DataReader_ptr,
+                                    const DDS::RequestedDeadlineMissedStatus&) {}
+  void on_requested_incompatible_qos(DDS::DataReader_ptr,
+                                     const DDS::RequestedIncompatibleQosStatus&) {}
+  void on_sample_rejected(DDS::DataReader_ptr,
+                          const DDS::SampleRejectedStatus&) {}
+  void on_liveliness_changed(DDS::DataReader_ptr,
+                             const DDS::LivelinessChangedStatus&) {}
+  void on_subscription_matched(DDS::DataReader_ptr,
+                               const DDS::SubscriptionMatchedStatus&) {}
+  void on_sample_lost(DDS::DataReader_ptr, const DDS::SampleLostStatus&) {}
+
+private:
+  ACE_Atomic_Op<ACE_Thread_Mutex, long>& received_;
+};
+
+double cpu_usec(ACE_Profile_Timer& timer)
+{
+  ACE_Profile_Timer::ACE_Elapsed_Time elapsed;
+  timer.elapsed_time(elapsed);
+  return (elapsed.user_time + elapsed.system_time) * 1e6;
+}
+
+bool wait_matched(DDS::DataWriter_ptr writer, int readers, int timeout_sec)
+{
+  const ACE_Time_Value deadline =
+    ACE_OS::gettimeofday() + ACE_Time_Value(timeout_sec);
+  DDS::PublicationMatchedStatus status;
+  while (writer->get_publication_matched_status(status) == DDS::RETCODE_OK &&
+         status.current_count < readers) {
+    if (ACE_OS::gettimeofday() > deadline) {
+      return false;
+    }
+    ACE_OS::sleep(ACE_Time_Value(0, 100000));
+  }
+  return true;
+}
+
+/// Delivers @a samples samples to @a readers readers of a new topic and
+/// prints a line of results.  Returns false on an error.
+bool run(DDS::DomainParticipant_ptr pub_participant,
+         DDS::DomainParticipant_ptr sub_participant,
+         int readers, int samples, int readings, int timeout_sec)
+{
+  char topic_name[64];
+  std::sprintf(topic_name, "FanOut%d", readers);
+
+  FanOut::ReportTypeSupport_var ts = new FanOut::ReportTypeSupportImpl;
+  const CORBA::String_var type_name = ts->get_type_name();
+
+  DDS::Topic_var pub_topic =
+    pub_participant->create_topic(topic_name, type_name, TOPIC_QOS_DEFAULT,
+                                  0, OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+  DDS::Topic_var sub_topic =
+    sub_participant->create_topic(topic_name, type_name, TOPIC_QOS_DEFAULT,
+                                  0, OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+  DDS::Publisher_var pub =
+    pub_participant->create_publisher(PUBLISHER_QOS_DEFAULT, 0,
+                                      OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+  DDS::Subscriber_var sub =
+    sub_participant->create_subscriber(SUBSCRIBER_QOS_DEFAULT, 0,
+                                       OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+  if (CORBA::is_nil(pub_topic.in()) || CORBA::is_nil(sub_topic.in()) ||
+      CORBA::is_nil(pub.in()) || CORBA::is_nil(sub.in())) {
+    ACE_ERROR_RETURN((LM_ERROR,
+                      ACE_TEXT("ERROR: failed to create the topics, ")
+                      ACE_TEXT("publisher or subscriber\n")), false);
+  }
+
+  ACE_Atomic_Op<ACE_Thread_Mutex, long> received(0);
+  DDS::DataReaderListener_var listener = new CountingListener(received);
+
+  DDS::DataReaderQos dr_qos;
+  sub->get_default_datareader_qos(dr_qos);
+  dr_qos.history.kind = DDS::KEEP_ALL_HISTORY_QOS;
+  for (int i = 0; i < readers; ++i) {
+    DDS::DataReader_var reader =
+      sub->create_datareader(sub_topic.in(), dr_qos, listener.in(),
+                             DDS::DATA_AVAILABLE_STATUS);
+    if (CORBA::is_nil(reader.in())) {
+      ACE_ERROR_RETURN((LM_ERROR,
+                        ACE_TEXT("ERROR: create_datareader failed\n")), false);
+    }
+  }
+
+  DDS::DataWriter_var dw =
+    pub->create_datawriter(pub_topic.in(), DATAWRITER_QOS_DEFAULT, 0,
+                           OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+  FanOut::ReportDataWriter_var writer = FanOut::ReportDataWriter::_narrow(dw.in());
+  if (CORBA::is_nil(writer.in())) {
+    ACE_ERROR_RETURN((LM_ERROR,
+                      ACE_TEXT("ERROR: create_datawriter failed\n")), false);
+  }
+
+  if (!wait_matched(dw.in(), readers, timeout_sec)) {
+    ACE_ERROR_RETURN((LM_ERROR,
+                      ACE_TEXT("ERROR: %d readers did not match\n"), readers), false);
+  }
+
+  FanOut::Report report;
+  report.id = 0;
+  report.source = "fanout_bench";
+  report.readings.length(readings);
+  for (int i = 0; i < readings; ++i) {
+    char name[32];
+    std::sprintf(name, "sensor-%d", i);
+    report.readings[i].name = name;
+    report.readings[i].value = i * 0.5;
+    report.readings[i].timestamp = i;
+  }
+
+  const long expected = long(samples) * readers;
+  const ACE_Time_Value deadline =
+    ACE_OS::gettimeofday() + ACE_Time_Value(timeout_sec);
+
+  ACE_Profile_Timer timer;
+  timer.start();
+  for (int i = 0; i < samples; ++i) {
+    report.seq = i;
+    writer->write(report, DDS::HANDLE_NIL);
+    // Pace the writer so the udp receive buffer does not overflow.
+    if (i % 16 == 15) {
+      ACE_OS::sleep(ACE_Time_Value(0, 1000));
+    }
+  }
+  while (received.value() < expected && ACE_OS::gettimeofday() < deadline) {
+    ACE_OS::sleep(ACE_Time_Value(0, 1000));
+  }
+  timer.stop();
+
+  const long delivered = received.value();
+  const double usec = cpu_usec(timer);
+  std::printf("%7d %9d %10ld %7.2f%% %12.2f %12.2f\n",
+              readers, samples, delivered,
+              expected ? 100.0 * (expected - delivered) / expected : 0.0,
+              samples ? usec / samples : 0.0,
+              delivered ? usec / delivered : 0.0);
+
+  pub->delete_contained_entities();
+  sub->delete_contained_entities();
+  pub_participant->delete_publisher(pub.in());
+  sub_participant->delete_subscriber(sub.in());
+  pub_participant->delete_topic(pub_topic.in());
+  sub_participant->delete_topic(sub_topic.in());
+  return true;
+}
+
+}
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR* argv[])
+{
+  int status = 0;
+  try {
+    DDS::DomainParticipantFactory_var dpf =
+      TheParticipantFactoryWithArgs(argc, argv);
+
+    int samples = 2000;
+    int readings = 32;
+    int timeout_sec = 60;
+    std::vector<int> reader_counts;
+    ACE_Arg_Shifter_T<ACE_TCHAR> shifter(argc, argv);
+    while (shifter.is_anything_left()) {
+      const ACE_TCHAR* currentArg = 0;
+      if ((currentArg = shifter.get_the_parameter(ACE_TEXT("-n"))) != 0) {
+        samples = ACE_OS::atoi(currentArg);
+        shifter.consume_arg();
+      } else if ((currentArg = shifter.get_the_parameter(ACE_TEXT("-s"))) != 0) {
+        readings = ACE_OS::atoi(currentArg);
+        shifter.consume_arg();
+      } else if ((currentArg = shifter.get_the_parameter(ACE_TEXT("-r"))) != 0) {
+        reader_counts.push_back(ACE_OS::atoi(currentArg));
+        shifter.consume_arg();
+      } else if ((currentArg = shifter.get_the_parameter(ACE_TEXT("-t"))) != 0) {
+        timeout_sec = ACE_OS::atoi(currentArg);
+        shifter.consume_arg();
+      } else {
+        shifter.ignore_arg();
+      }
+    }
+    if (reader_counts.empty()) {
+      reader_counts.push_back(1);
+      reader_counts.push_back(8);
+      reader_counts.push_back(64);
+    }
+
+    DDS::DomainParticipant_var pub_participant =
+      dpf->create_participant(domain, PARTICIPANT_QOS_DEFAULT, 0,
+                              OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+    DDS::DomainParticipant_var sub_participant =
+      dpf->create_participant(domain, PARTICIPANT_QOS_DEFAULT, 0,
+                              OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+    if (CORBA::is_nil(pub_participant.in()) || CORBA::is_nil(sub_participant.in())) {
+      ACE_ERROR_RETURN((LM_ERROR,
+                        ACE_TEXT("ERROR: create_participant failed\n")), 1);
+    }
+
+    // Each participant has its own udp transport instance, so all of the
+    // readers receive through the one DataLink to the writer.
+    TheTransportRegistry->bind_config("pub", pub_participant.in());
+    TheTransportRegistry->bind_config("sub", sub_participant.in());
+
+    FanOut::ReportTypeSupport_var ts = new FanOut::ReportTypeSupportImpl;
+    if (ts->register_type(pub_participant.in(), "") != DDS::RETCODE_OK ||
+        ts->register_type(sub_participant.in(), "") != DDS::RETCODE_OK) {
+      ACE_ERROR_RETURN((LM_ERROR,
+                        ACE_TEXT("ERROR: register_type failed\n")), 1);
+    }
+
+    std::printf("%7s %9s %10s %8s %12s %12s\n",
+                "readers", "samples", "delivered", "lost",
+                "cpu us/smp", "cpu us/dlv");
+
+    for (size_t i = 0; i < reader_counts.size(); ++i) {
+      if (!run(pub_participant.in(), sub_participant.in(), reader_counts[i],
+               samples, readings, timeout_sec)) {
+        status = 1;
+      }
+    }
+
+    pub_participant->delete_contained_entities();
+    sub_participant->delete_contained_entities();
+    dpf->delete_participant(pub_participant.in());
+    dpf->delete_participant(sub_participant.in());
+    TheServiceParticipant->shutdown();
+
+  } catch (const CORBA::Exception& e) {
+    e._tao_print_exception("Exception caught in main():");
+    status = 1;
+  }
+
+  return status;
+}
@@ -0,0 +1,21 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+    & eval 'exec perl -S $0 $argv:q'
+    if 0;
+
+# Reports the CPU time per sample delivered to 1, 8 and 64 readers that
+# share one udp DataLink.  Arguments are passed on to fanout_bench:
+# -n <samples>, -s <readings per sample>, -r <readers> (repeatable) and
+# -t <timeout in seconds per run>.
+
+use Env (DDS_ROOT);
+use lib "$DDS_ROOT/bin";
+use Env (ACE_ROOT);
+use lib "$ACE_ROOT/bin";
+use PerlDDS::Run_Test;
+use strict;
+
+my $test = new PerlDDS::TestFramework();
+$test->process('bench', 'fanout_bench',
+               '-DCPSConfigFile fanout.ini ' . join(' ', @ARGV));
+$test->start_process('bench');
+exit $test->finish(600);
@@ -0,0 +1,328 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+// Persists -n entities (participants, each with a topic, 4 writers and 4
+// readers) with the PersistenceUpdater ("mmap") and the
+// WalPersistenceUpdater, syncing each update from one thread ("wal") and
+// from -t threads ("wal-mt"), and writing behind ("wal-wb").  It reports
+// the rate of the updates, the number of log syncs per update and the
+// time to recover them.  As in the repository, each update goes through
+// the Update::Manager and is followed by its sync(), and the updates are
+// timed until they are committed, which for the WalPersistenceUpdater
+// includes syncing the log; the PersistenceUpdater leaves it to the
+// memory-mapped file.  The recovery is the time a new updater takes to
+// load the file and produce the repository image.  -u also updates the
+// QoS of each writer once.
+
+#include "dds/InfoRepo/PersistenceUpdater.h"
+#include "dds/InfoRepo/UpdateManager.h"
+#include "dds/InfoRepo/WalPersistenceUpdater.h"
+
+#include <dds/DCPS/RepoIdBuilder.h>
+#include <dds/DCPS/Service_Participant.h>
+
+#include <ace/ARGV.h>
+#include <ace/Arg_Shifter.h>
+#include <ace/Dynamic_Service.h>
+#include <ace/Log_Msg.h>
+#include <ace/OS_NS_stdlib.h>
+#include <ace/OS_NS_sys_time.h>
+#include <ace/OS_NS_unistd.h>
+#include <ace/Thread_Manager.h>
+
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+const int endpoints = 4;
+
+// A participant, its topic and its writers and readers.
+const int entities_per_participant = 2 + 2 * endpoints;
+
+double seconds(const ACE_Time_Value& tv)
+{
+  return tv.sec() + tv.usec() / 1e6;
+}
+
+OpenDDS::DCPS::RepoId make_id(long participant, long key,
+                              OpenDDS::DCPS::EntityKind kind)
+{
+  OpenDDS::DCPS::RepoId id;
+  OpenDDS::DCPS::RepoIdBuilder builder(id);
+  builder.federationId(1);
+  builder.participantId(participant);
+  builder.entityKey(key);
+  builder.entityKind(kind, false);
+  return id;
+}
+
+/// Persist the entities of participants first to last through um, each
+/// update followed by its sync() as a repository operation does.
+void populate(Update::Manager& um, long first, long last, bool update)
+{
+  const Update::DomainIdType domain = 0;
+  DDS::DomainParticipantQos participant_qos =
+    TheServiceParticipant->initial_DomainParticipantQos();
+  DDS::TopicQos topic_qos = TheServiceParticipant->initial_TopicQos();
+  DDS::PublisherQos publisher_qos = TheServiceParticipant->initial_PublisherQos();
+  DDS::DataWriterQos writer_qos = TheServiceParticipant->initial_DataWriterQos();
+  DDS::SubscriberQos subscriber_qos = TheServiceParticipant->initial_SubscriberQos();
+  DDS::DataReaderQos reader_qos = TheServiceParticipant->initial_DataReaderQos();
+  OpenDDS::DCPS::TransportLocatorSeq transport;
+  Update::ContentSubscriptionInfo csi;
+  const char callback[] = "IOR:callback";
+
+  for (long p = first; p <= last; ++p) {
+    const Update::IdType participant_id =
+      make_id(p, 0, OpenDDS::DCPS::KIND_PARTICIPANT);
+    um.create(Update::UParticipant(domain, 0, participant_id,
+                                   participant_qos));
+    um.updateLastPartId(p);
+    um.sync();
+
+    const Update::IdType topic_id =
+      make_id(p, 1, OpenDDS::DCPS::KIND_USER_TOPIC);
+    um.create(Update::UTopic(domain, topic_id, participant_id,
+                             "PersistenceRate", "Messenger::Message",
+                             topic_qos));
+    um.sync();
+
+    for (long e = 0; e < endpoints; ++e) {
+      const Update::IdType writer_id =
+        make_id(p, 2 + e, OpenDDS::DCPS::KIND_USER_WRITER);
+      um.create(Update::UWActor(domain, writer_id, topic_id,
+                                participant_id, Update::DataWriter,
+                                callback, publisher_qos, writer_qos,
+                                transport, csi));
+      um.sync();
+      if (update) {
+        writer_qos.lifespan.duration.sec = e + 1;
+        um.update(Update::IdPath(domain, participant_id, writer_id),
+                  writer_qos);
+        um.sync();
+      }
+
+      const Update::IdType reader_id =
+        make_id(p, 2 + endpoints + e, OpenDDS::DCPS::KIND_USER_READER);
+      um.create(Update::URActor(domain, reader_id, topic_id,
+                                participant_id, Update::DataReader,
+                                callback, subscriber_qos, reader_qos,
+                                transport, csi));
+      um.sync();
+    }
+  }
+}
+
+struct Populate {
+  Update::Manager* um_;
+  long first_;
+  long last_;
+  bool update_;
+};
+
+ACE_THR_FUNC_RETURN populate_thread(void* arg)
+{
+  const Populate* const range = static_cast<Populate*>(arg);
+  populate(*range->um_, range->first_, range->last_, range->update_);
+  return 0;
+}
+
+/// Persist participants participants from threads threads.
+void populate(Update::Manager& um, int participants, int threads, bool update)
+{
+  if (threads <= 1) {
+    populate(um, 1, participants, update);
+    return;
+  }
+
+  std::vector<Populate> ranges(threads);
+  ACE_Thread_Manager thread_manager;
+  long first = 1;
+  for (int i = 0; i < threads; ++i) {
+    ranges[i].um_ = &um;
+    ranges[i].first_ = first;
+    ranges[i].last_ = first + (participants - first + 1) / (threads - i) - 1;
+    ranges[i].update_ = update;
+    first = ranges[i].last_ + 1;
+    thread_manager.spawn(populate_thread, &ranges[i]);
+  }
+  thread_manager.wait();
+}
+
+// The PersistenceUpdater does not sync the memory-mapped file, and does
+// not count what it recovers or its syncs.
+bool flush(Update::PersistenceUpdater&)
+{
+  return true;
+}
+
+bool flush(Update::WalPersistenceUpdater& updater)
+{
+  return updater.flush();
+}
+
+size_t entities(Update::PersistenceUpdater&)
+{
+  return 0;
+}
+
+size_t entities(Update::WalPersistenceUpdater& updater)
+{
+  return updater.entities();
+}
+
+ACE_UINT64 commits(Update::PersistenceUpdater&)
+{
+  return 0;
+}
+
+ACE_UINT64 commits(Update::WalPersistenceUpdater& updater)
+{
+  return updater.commits();
+}
+
+template <typename T>
+int run(const char* label, const ACE_TCHAR* options, int participants,
+        int threads, bool update, size_t& recovered)
+{
+  Update::Manager* um =
+    ACE_Dynamic_Service<Update::Manager>::instance("UpdateManagerSvc");
+
+  ACE_Time_Value populate_time;
+  ACE_UINT64 syncs = 0;
+  {
+    ACE_ARGV args((ACE_TString(options) + ACE_TEXT(" -reset 1")).c_str());
+    T updater;
+    if (updater.init(args.argc(), args.argv()) != 0) {
+      ACE_ERROR_RETURN((LM_ERROR,
+                        ACE_TEXT("ERROR: %C updater init failed\n"), label), 1);
+    }
+
+    const ACE_Time_Value start = ACE_OS::gettimeofday();
+    populate(*um, participants, threads, update);
+    if (!flush(updater)) {
+      um->remove(&updater);
+      ACE_ERROR_RETURN((LM_ERROR,
+                        ACE_TEXT("ERROR: %C updater flush failed\n"), label), 1);
+    }
+    populate_time = ACE_OS::gettimeofday() - start;
+    syncs = commits(updater);
+    um->remove(&updater);
+    updater.fini();
+  }
+
+  ACE_Time_Value recover_time;
+  {
+    ACE_ARGV args(options);
+    T updater;
+
+    const ACE_Time_Value start = ACE_OS::gettimeofday();
+    if (updater.init(args.argc(), args.argv()) != 0) {
+      ACE_ERROR_RETURN((LM_ERROR,
+                        ACE_TEXT("ERROR: %C updater recovery failed\n"), label), 1);
+    }
+    updater.requestImage();
+    recover_time = ACE_OS::gettimeofday() - start;
+    recovered = entities(updater);
+    um->remove(&updater);
+    updater.fini();
+  }
+
+  const double updates = participants *
+    (entities_per_participant + 1.0 + (update ? endpoints : 0));
+  std::printf("%-6s %2d threads %7d entities %8.3f s %10.1f updates/s "
+              "%6.3f syncs/update recovered in %8.3f s\n",
+              label, threads, participants * entities_per_participant,
+              seconds(populate_time), updates / seconds(populate_time),
+              syncs / updates, seconds(recover_time));
+  return 0;
+}
+
+bool check_recovered(size_t recovered, int participants)
+{
+  if (recovered != size_t(participants * entities_per_participant)) {
+    ACE_ERROR((LM_ERROR,
+               ACE_TEXT("ERROR: recovered %B of %d entities from the log\n"),
+               recovered, participants * entities_per_participant));
+    return false;
+  }
+  return true;
+}
+
+}
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR* argv[])
+{
+  int status = 0;
+  try {
+    DDS::DomainParticipantFactory_var dpf =
+      TheParticipantFactoryWithArgs(argc, argv);
+
+    int count = 100000;
+    int threads = 8;
+    bool update = false;
+    ACE_Arg_Shifter_T<ACE_TCHAR> shifter(argc, argv);
+    while (shifter.is_anything_left()) {
+      const ACE_TCHAR* currentArg = 0;
+      if ((currentArg = shifter.get_the_parameter(ACE_TEXT("-n"))) != 0) {
+        count = ACE_OS::atoi(currentArg);
+        shifter.consume_arg();
+      } else if ((currentArg = shifter.get_the_parameter(ACE_TEXT("-t"))) != 0) {
+        threads = ACE_OS::atoi(currentArg);
+        shifter.consume_arg();
+      } else if (shifter.cur_arg_strncasecmp(ACE_TEXT("-u")) == 0) {
+        update = true;
+        shifter.consume_arg();
+      } else {
+        shifter.ignore_arg();
+      }
+    }
+
+    const int participants = count / entities_per_participant;
+    size_t recovered = 0;
+
+    status |= run<Update::PersistenceUpdater>(
+      "mmap", ACE_TEXT("-file persistence_rate.pr"),
+      participants, 1, update, recovered);
+
+    status |= run<Update::WalPersistenceUpdater>(
+      "wal", ACE_TEXT("-file persistence_rate.wal"),
+      participants, 1, update, recovered);
+    if (status == 0 && !check_recovered(recovered, participants)) {
+      status = 1;
+    }
+
+    // The threads' updates share syncs, as the operations of a
+    // repository with -NumThreads do.
+    status |= run<Update::WalPersistenceUpdater>(
+      "wal-mt", ACE_TEXT("-file persistence_rate.wal"),
+      participants, threads, update, recovered);
+    if (status == 0 && !check_recovered(recovered, participants)) {
+      status = 1;
+    }
+
+    status |= run<Update::WalPersistenceUpdater>(
+      "wal-wb", ACE_TEXT("-file persistence_rate.wal -write_behind 1"),
+      participants, 1, update, recovered);
+    if (status == 0 && !check_recovered(recovered, participants)) {
+      status = 1;
+    }
+
+    ACE_OS::unlink("persistence_rate.pr");
+    ACE_OS::unlink("persistence_rate.wal.log");
+    ACE_OS::unlink("persistence_rate.wal.snapshot");
+    TheServiceParticipant->shutdown();
+
+  } catch (const CORBA::Exception& e) {
+    e._tao_print_exception("Exception caught in main():");
+    status = 1;
+  }
+
+  return status;
+}
@@ -0,0 +1,30 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+    & eval 'exec perl -S $0 $argv:q'
+    if 0;
+
+# Reports the update rate and the recovery time of the InfoRepo's
+# PersistenceUpdater and WalPersistenceUpdater with 100000 entities.
+# Extra arguments are passed to persistence_rate, for example -n 10000
+# or -u.
+
+use Env (DDS_ROOT);
+use lib "$DDS_ROOT/bin";
+use Env (ACE_ROOT);
+use lib "$ACE_ROOT/bin";
+use PerlDDS::Run_Test;
+use strict;
+
+my $Bench = PerlDDS::create_process("persistence_rate",
+                                    "-DCPSBit 0 " . join(' ', @ARGV));
+my $status = $Bench->SpawnWaitKill(600);
+if ($status != 0) {
+  print STDERR "ERROR: persistence_rate returned $status\n";
+}
+
+if ($status == 0) {
+  print "test PASSED.\n";
+} else {
+  print STDERR "test FAILED.\n";
+}
+
+exit $status;
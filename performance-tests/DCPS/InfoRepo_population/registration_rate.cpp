@@ -0,0 +1,234 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+// Registers participants, writers and readers with a DCPSInfoRepo from -t
+// threads at once, each in its own domain, and reports how many
+// registrations the repository handled per second.  Each thread creates -e
+// writers and -e readers of one topic, alternately, so each new endpoint is
+// matched with all of the opposite ones created before it.  -l labels the
+// report, which run_registration_rate.pl runs against a repository started
+// with -NumThreads 1 to 8, with and without -BatchAssociations.  Once they
+// are registered, each writer and reader must be matched with all of the
+// opposite ones, or the run fails.
+
+#include "MessengerTypeSupportImpl.h"
+
+#include <dds/DCPS/Marked_Default_Qos.h>
+#include <dds/DCPS/Service_Participant.h>
+
+#include "dds/DCPS/StaticIncludes.h"
+#ifdef ACE_AS_STATIC_LIBS
+#include <dds/DCPS/transport/tcp/Tcp.h>
+#endif
+
+#include <ace/Arg_Shifter.h>
+#include <ace/Log_Msg.h>
+#include <ace/OS_NS_stdlib.h>
+#include <ace/OS_NS_sys_time.h>
+#include <ace/OS_NS_unistd.h>
+#include <ace/Thread_Manager.h>
+
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+const DDS::DomainId_t first_domain = 100;
+const char topic_name[] = "RegistrationRate";
+
+struct Client {
+  DDS::DomainId_t domain;
+  int endpoints;
+  DDS::DomainParticipant_var participant;
+  std::vector<DDS::DataWriter_var> writers;
+  std::vector<DDS::DataReader_var> readers;
+  int status;
+};
+
+int register_endpoints(Client& client)
+{
+  DDS::DomainParticipantFactory_var dpf = TheParticipantFactory;
+  client.participant =
+    dpf->create_participant(client.domain, PARTICIPANT_QOS_DEFAULT, 0,
+                            OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+  if (CORBA::is_nil(client.participant.in())) {
+    ACE_ERROR_RETURN((LM_ERROR,
+                      ACE_TEXT("ERROR: create_participant failed\n")), 1);
+  }
+
+  Messenger::MessageTypeSupport_var ts = new Messenger::MessageTypeSupportImpl;
+  if (ts->register_type(client.participant.in(), "") != DDS::RETCODE_OK) {
+    ACE_ERROR_RETURN((LM_ERROR,
+                      ACE_TEXT("ERROR: register_type failed\n")), 1);
+  }
+  const CORBA::String_var type_name = ts->get_type_name();
+  DDS::Topic_var topic =
+    client.participant->create_topic(topic_name, type_name, TOPIC_QOS_DEFAULT, 0,
+                                     OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+  DDS::Publisher_var publisher =
+    client.participant->create_publisher(PUBLISHER_QOS_DEFAULT, 0,
+                                         OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+  DDS::Subscriber_var subscriber =
+    client.participant->create_subscriber(SUBSCRIBER_QOS_DEFAULT, 0,
+                                          OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+  if (CORBA::is_nil(topic.in()) || CORBA::is_nil(publisher.in()) ||
+      CORBA::is_nil(subscriber.in())) {
+    ACE_ERROR_RETURN((LM_ERROR,
+                      ACE_TEXT("ERROR: failed to create the topic, ")
+                      ACE_TEXT("publisher or subscriber\n")), 1);
+  }
+
+  for (int i = 0; i < client.endpoints; ++i) {
+    DDS::DataWriter_var writer =
+      publisher->create_datawriter(topic.in(), DATAWRITER_QOS_DEFAULT, 0,
+                                   OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+    DDS::DataReader_var reader =
+      subscriber->create_datareader(topic.in(), DATAREADER_QOS_DEFAULT, 0,
+                                    OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+    if (CORBA::is_nil(writer.in()) || CORBA::is_nil(reader.in())) {
+      ACE_ERROR_RETURN((LM_ERROR,
+                        ACE_TEXT("ERROR: failed to create endpoint %d ")
+                        ACE_TEXT("in domain %d\n"), i, client.domain), 1);
+    }
+    client.writers.push_back(writer);
+    client.readers.push_back(reader);
+  }
+  return 0;
+}
+
+/// Wait until each writer and reader of @a client is matched with all of
+/// the opposite ones, or until @a deadline.
+int check_matches(const Client& client, const ACE_Time_Value& deadline)
+{
+  for (size_t i = 0; i < client.writers.size(); ++i) {
+    DDS::PublicationMatchedStatus status = {0, 0, 0, 0, 0};
+    while (client.writers[i]->get_publication_matched_status(status) == DDS::RETCODE_OK &&
+           status.current_count != client.endpoints &&
+           ACE_OS::gettimeofday() < deadline) {
+      ACE_OS::sleep(ACE_Time_Value(0, 10000));
+    }
+    if (status.current_count != client.endpoints) {
+      ACE_ERROR_RETURN((LM_ERROR,
+                        ACE_TEXT("ERROR: writer %B in domain %d matched %d ")
+                        ACE_TEXT("readers of %d\n"), i, client.domain,
+                        status.current_count, client.endpoints), 1);
+    }
+  }
+  for (size_t i = 0; i < client.readers.size(); ++i) {
+    DDS::SubscriptionMatchedStatus status = {0, 0, 0, 0, 0};
+    while (client.readers[i]->get_subscription_matched_status(status) == DDS::RETCODE_OK &&
+           status.current_count != client.endpoints &&
+           ACE_OS::gettimeofday() < deadline) {
+      ACE_OS::sleep(ACE_Time_Value(0, 10000));
+    }
+    if (status.current_count != client.endpoints) {
+      ACE_ERROR_RETURN((LM_ERROR,
+                        ACE_TEXT("ERROR: reader %B in domain %d matched %d ")
+                        ACE_TEXT("writers of %d\n"), i, client.domain,
+                        status.current_count, client.endpoints), 1);
+    }
+  }
+  return 0;
+}
+
+ACE_THR_FUNC_RETURN run_client(void* arg)
+{
+  Client& client = *static_cast<Client*>(arg);
+  try {
+    client.status = register_endpoints(client);
+  } catch (const CORBA::Exception& e) {
+    e._tao_print_exception("Exception caught in run_client():");
+    client.status = 1;
+  }
+  return 0;
+}
+
+}
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR* argv[])
+{
+  int status = 0;
+  try {
+    DDS::DomainParticipantFactory_var dpf =
+      TheParticipantFactoryWithArgs(argc, argv);
+
+    int threads = 8;
+    int endpoints = 50;
+    ACE_TString label = ACE_TEXT("repo");
+    ACE_Arg_Shifter_T<ACE_TCHAR> shifter(argc, argv);
+    while (shifter.is_anything_left()) {
+      const ACE_TCHAR* currentArg = 0;
+      if ((currentArg = shifter.get_the_parameter(ACE_TEXT("-t"))) != 0) {
+        threads = ACE_OS::atoi(currentArg);
+        shifter.consume_arg();
+      } else if ((currentArg = shifter.get_the_parameter(ACE_TEXT("-e"))) != 0) {
+        endpoints = ACE_OS::atoi(currentArg);
+        shifter.consume_arg();
+      } else if ((currentArg = shifter.get_the_parameter(ACE_TEXT("-l"))) != 0) {
+        label = currentArg;
+        shifter.consume_arg();
+      } else {
+        shifter.ignore_arg();
+      }
+    }
+
+    std::vector<Client> clients(threads);
+    ACE_Thread_Manager client_threads;
+    const ACE_Time_Value start = ACE_OS::gettimeofday();
+    for (int i = 0; i < threads; ++i) {
+      clients[i].domain = first_domain + i;
+      clients[i].endpoints = endpoints;
+      clients[i].status = 0;
+      if (client_threads.spawn(run_client, &clients[i]) == -1) {
+        ACE_ERROR_RETURN((LM_ERROR,
+                          ACE_TEXT("ERROR: failed to start client %d\n"), i), 1);
+      }
+    }
+    client_threads.wait();
+    const ACE_Time_Value elapsed = ACE_OS::gettimeofday() - start;
+
+    for (int i = 0; i < threads; ++i) {
+      if (clients[i].status) {
+        status = 1;
+      }
+    }
+
+    // Every association was made, batched or not.
+    const ACE_Time_Value deadline = ACE_OS::gettimeofday() + ACE_Time_Value(120);
+    for (int i = 0; i < threads && status == 0; ++i) {
+      status = check_matches(clients[i], deadline);
+    }
+
+    if (status == 0) {
+      // A participant, a topic and the writers and readers in each domain.
+      const double registrations = threads * (2.0 + 2 * endpoints);
+      const double associations = threads * double(endpoints) * endpoints;
+      const double sec = elapsed.sec() + elapsed.usec() / 1e6;
+      std::printf("%-16s %2d domains %5.0f registrations %7.0f associations "
+                  "%8.3f s %9.1f registrations/s\n",
+                  ACE_TEXT_ALWAYS_CHAR(label.c_str()), threads, registrations,
+                  associations, sec, registrations / sec);
+    }
+
+    for (int i = 0; i < threads; ++i) {
+      clients[i].writers.clear();
+      clients[i].readers.clear();
+      if (!CORBA::is_nil(clients[i].participant.in())) {
+        clients[i].participant->delete_contained_entities();
+        dpf->delete_participant(clients[i].participant.in());
+      }
+    }
+    TheServiceParticipant->shutdown();
+
+  } catch (const CORBA::Exception& e) {
+    e._tao_print_exception("Exception caught in main():");
+    status = 1;
+  }
+
+  return status;
+}
@@ -0,0 +1,61 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+    & eval 'exec perl -S $0 $argv:q'
+    if 0;
+
+# Reports the rate at which a DCPSInfoRepo running 1 to 8 ORB threads
+# handles registrations from 8 domains at once, with and without
+# -BatchAssociations.  registration_rate fails if any writer or reader
+# isn't matched with all of the opposite ones.  Extra arguments are
+# passed to registration_rate, for example -e 100.
+
+use Env (DDS_ROOT);
+use lib "$DDS_ROOT/bin";
+use Env (ACE_ROOT);
+use lib "$ACE_ROOT/bin";
+use PerlDDS::Run_Test;
+use strict;
+
+my $status = 0;
+my $dcpsrepo_ior = "repo.ior";
+my $client_opts = "-DCPSConfigFile pub.ini -DCPSBit 0 -t 8 " . join(' ', @ARGV);
+
+foreach my $batch ('', '-BatchAssociations') {
+  foreach my $threads (1, 2, 4, 8) {
+    unlink $dcpsrepo_ior;
+
+    my $DCPSREPO = PerlDDS::create_process("$ENV{DDS_ROOT}/bin/DCPSInfoRepo",
+                                           "-NOBITS -NumThreads $threads $batch " .
+                                           "-o $dcpsrepo_ior");
+    $DCPSREPO->Spawn();
+    if (PerlACE::waitforfile_timed($dcpsrepo_ior, 30) == -1) {
+      print STDERR "ERROR: waiting for Info Repo IOR file\n";
+      $DCPSREPO->Kill();
+      exit 1;
+    }
+
+    my $label = $batch ? "batch threads $threads" : "repo threads $threads";
+    my $Client = PerlDDS::create_process("registration_rate",
+                                         "$client_opts -l \"$label\"");
+    my $result = $Client->SpawnWaitKill(600);
+    if ($result != 0) {
+      print STDERR "ERROR: registration_rate returned $result\n";
+      $status = 1;
+    }
+
+    my $ir = $DCPSREPO->TerminateWaitKill(5);
+    if ($ir != 0) {
+      print STDERR "ERROR: DCPSInfoRepo returned $ir\n";
+      $status = 1;
+    }
+  }
+}
+
+unlink $dcpsrepo_ior;
+
+if ($status == 0) {
+  print "test PASSED.\n";
+} else {
+  print STDERR "test FAILED.\n";
+}
+
+exit $status;
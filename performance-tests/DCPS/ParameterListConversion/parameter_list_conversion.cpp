@@ -0,0 +1,290 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+// Times serializing and parsing the SPDP participant data and the SEDP
+// writer and reader data of a typical endpoint.  "list" converts to and
+// from a ParameterList that is then serialized or was deserialized, as
+// discovery did before ParameterListWriter, and "direct" writes and reads
+// the parameters without the ParameterList.
+
+#include <dds/DCPS/RTPS/BaseMessageTypes.h>
+#include <dds/DCPS/RTPS/BaseMessageUtils.h>
+#include <dds/DCPS/RTPS/GuidGenerator.h>
+#include <dds/DCPS/RTPS/ParameterListConverter.h>
+#include <dds/DCPS/Service_Participant.h>
+
+#include <ace/Arg_Shifter.h>
+#include <ace/High_Res_Timer.h>
+#include <ace/OS_NS_stdlib.h>
+
+#include <cstdio>
+#include <cstring>
+
+using namespace OpenDDS::RTPS;
+using namespace OpenDDS::RTPS::ParameterListConverter;
+using OpenDDS::DCPS::Serializer;
+
+namespace {
+
+GuidGenerator guid_generator;
+
+OpenDDS::DCPS::Locator_t locator(unsigned long port, unsigned char a, unsigned char b,
+                                 unsigned char c, unsigned char d)
+{
+  OpenDDS::DCPS::Locator_t result;
+  result.kind = LOCATOR_KIND_UDPv4;
+  result.port = port;
+  std::memset(result.address, 0, sizeof result.address);
+  result.address[12] = a;
+  result.address[13] = b;
+  result.address[14] = c;
+  result.address[15] = d;
+  return result;
+}
+
+void rtps_udp_locators(OpenDDS::DCPS::TransportLocatorSeq& all)
+{
+  OpenDDS::DCPS::LocatorSeq locators;
+  locators.length(2);
+  locators[0] = locator(7411, 192, 168, 1, 10);
+  locators[1] = locator(7401, 239, 255, 0, 1);
+  all.length(1);
+  all[0].transport_type = "rtps_udp";
+  locators_to_blob(locators, all[0].data);
+}
+
+void partitions(DDS::PartitionQosPolicy& partition)
+{
+  partition.name.length(2);
+  partition.name[0] = "sensors";
+  partition.name[1] = "site-*";
+}
+
+SPDPdiscoveredParticipantData participant_data()
+{
+  SPDPdiscoveredParticipantData data;
+  data.ddsParticipantData.user_data.value.length(16);
+  data.participantProxy.protocolVersion = PROTOCOLVERSION;
+  OpenDDS::DCPS::GUID_t guid;
+  guid_generator.populate(guid);
+  std::memcpy(data.participantProxy.guidPrefix, guid.guidPrefix, sizeof guid.guidPrefix);
+  data.participantProxy.vendorId = VENDORID_OPENDDS;
+  data.participantProxy.expectsInlineQos = false;
+  data.participantProxy.availableBuiltinEndpoints = 0x3f;
+  data.participantProxy.metatrafficUnicastLocatorList.length(1);
+  data.participantProxy.metatrafficUnicastLocatorList[0] = locator(7410, 192, 168, 1, 10);
+  data.participantProxy.metatrafficMulticastLocatorList.length(1);
+  data.participantProxy.metatrafficMulticastLocatorList[0] = locator(7400, 239, 255, 0, 1);
+  data.participantProxy.defaultUnicastLocatorList.length(1);
+  data.participantProxy.defaultUnicastLocatorList[0] = locator(7411, 192, 168, 1, 10);
+  data.participantProxy.defaultMulticastLocatorList.length(1);
+  data.participantProxy.defaultMulticastLocatorList[0] = locator(7401, 239, 255, 0, 1);
+  data.participantProxy.manualLivelinessCount.value = 0;
+  data.leaseDuration.seconds = 300;
+  data.leaseDuration.fraction = 0;
+  return data;
+}
+
+OpenDDS::DCPS::DiscoveredWriterData writer_data()
+{
+  OpenDDS::DCPS::DiscoveredWriterData data;
+  DDS::PublicationBuiltinTopicData& pub = data.ddsPublicationData;
+  pub.topic_name = "Telemetry";
+  pub.type_name = "Sensors::Telemetry";
+  const DDS::DataWriterQos& qos = TheServiceParticipant->initial_DataWriterQos();
+  pub.durability = qos.durability;
+  pub.durability.kind = DDS::TRANSIENT_LOCAL_DURABILITY_QOS;
+  pub.durability_service = qos.durability_service;
+  pub.deadline = qos.deadline;
+  pub.latency_budget = qos.latency_budget;
+  pub.liveliness = qos.liveliness;
+  pub.reliability = qos.reliability;
+  pub.lifespan = qos.lifespan;
+  pub.user_data = qos.user_data;
+  pub.ownership = qos.ownership;
+  pub.ownership_strength = qos.ownership_strength;
+  pub.destination_order = qos.destination_order;
+  pub.presentation = TheServiceParticipant->initial_PublisherQos().presentation;
+  partitions(pub.partition);
+  pub.topic_data = TheServiceParticipant->initial_TopicDataQosPolicy();
+  pub.group_data = TheServiceParticipant->initial_GroupDataQosPolicy();
+  guid_generator.populate(data.writerProxy.remoteWriterGuid);
+  rtps_udp_locators(data.writerProxy.allLocators);
+  return data;
+}
+
+OpenDDS::DCPS::DiscoveredReaderData reader_data()
+{
+  OpenDDS::DCPS::DiscoveredReaderData data;
+  DDS::SubscriptionBuiltinTopicData& sub = data.ddsSubscriptionData;
+  sub.topic_name = "Telemetry";
+  sub.type_name = "Sensors::Telemetry";
+  const DDS::DataReaderQos& qos = TheServiceParticipant->initial_DataReaderQos();
+  sub.durability = qos.durability;
+  sub.deadline = qos.deadline;
+  sub.latency_budget = qos.latency_budget;
+  sub.liveliness = qos.liveliness;
+  sub.reliability = qos.reliability;
+  sub.ownership = qos.ownership;
+  sub.destination_order = qos.destination_order;
+  sub.user_data = qos.user_data;
+  sub.time_based_filter = qos.time_based_filter;
+  sub.presentation = TheServiceParticipant->initial_SubscriberQos().presentation;
+  partitions(sub.partition);
+  sub.topic_data = TheServiceParticipant->initial_TopicDataQosPolicy();
+  sub.group_data = TheServiceParticipant->initial_GroupDataQosPolicy();
+  guid_generator.populate(data.readerProxy.remoteReaderGuid);
+  data.readerProxy.expectsInlineQos = false;
+  rtps_udp_locators(data.readerProxy.allLocators);
+  data.contentFilterProperty.filterClassName = "";
+  return data;
+}
+
+double usec_per(ACE_High_Res_Timer& timer, int iterations)
+{
+  ACE_hrtime_t nsec;
+  timer.elapsed_time(nsec);
+  return double(nsec) / 1000.0 / iterations;
+}
+
+/// Serialize @a data into @a buffer, which is reset first.
+template <typename T>
+bool write_list(const T& data, ACE_Message_Block& buffer)
+{
+  ParameterList param_list;
+  if (to_param_list(data, param_list) != 0) {
+    return false;
+  }
+  size_t size = 0, padding = 0;
+  OpenDDS::DCPS::gen_find_size(param_list, size, padding);
+  buffer.reset();
+  if (buffer.space() < size) {
+    return false;
+  }
+  Serializer ser(&buffer, false, Serializer::ALIGN_CDR);
+  return ser << param_list;
+}
+
+template <typename T>
+bool write_direct(const T& data, ACE_Message_Block& buffer)
+{
+  ParameterListWriter sizer;
+  if (to_param_list(data, sizer) != 0 || !sizer.finish()) {
+    return false;
+  }
+  buffer.reset();
+  if (buffer.space() < sizer.size()) {
+    return false;
+  }
+  Serializer ser(&buffer, false, Serializer::ALIGN_CDR);
+  ParameterListWriter writer(&ser);
+  return to_param_list(data, writer) == 0 && writer.finish();
+}
+
+template <typename T>
+bool read_list(ACE_Message_Block& buffer, T& data)
+{
+  const char* const start = buffer.rd_ptr();
+  Serializer ser(&buffer, false, Serializer::ALIGN_CDR);
+  ParameterList param_list;
+  const bool ok = (ser >> param_list) && from_param_list(param_list, data) == 0;
+  buffer.rd_ptr(const_cast<char*>(start));
+  return ok;
+}
+
+template <typename T>
+bool read_direct(ACE_Message_Block& buffer, T& data)
+{
+  const char* const start = buffer.rd_ptr();
+  Serializer ser(&buffer, false, Serializer::ALIGN_CDR);
+  const bool ok = from_param_list(ser, data) == 0;
+  buffer.rd_ptr(const_cast<char*>(start));
+  return ok;
+}
+
+template <typename T>
+bool run(const char* name, const T& data, int iterations)
+{
+  ACE_Message_Block list_buffer(4096), direct_buffer(4096);
+  bool ok = true;
+  ACE_High_Res_Timer timer;
+
+  timer.start();
+  for (int i = 0; ok && i < iterations; ++i) {
+    ok = write_list(data, list_buffer);
+  }
+  timer.stop();
+  const double write_list_usec = usec_per(timer, iterations);
+
+  timer.reset();
+  timer.start();
+  for (int i = 0; ok && i < iterations; ++i) {
+    ok = write_direct(data, direct_buffer);
+  }
+  timer.stop();
+  const double write_direct_usec = usec_per(timer, iterations);
+
+  if (ok && (list_buffer.length() != direct_buffer.length() ||
+             std::memcmp(list_buffer.rd_ptr(), direct_buffer.rd_ptr(), list_buffer.length()))) {
+    ACE_ERROR((LM_ERROR, ACE_TEXT("ERROR: %C serialized differently\n"), name));
+    ok = false;
+  }
+
+  T out;
+  timer.reset();
+  timer.start();
+  for (int i = 0; ok && i < iterations; ++i) {
+    ok = read_list(list_buffer, out);
+  }
+  timer.stop();
+  const double read_list_usec = usec_per(timer, iterations);
+
+  timer.reset();
+  timer.start();
+  for (int i = 0; ok && i < iterations; ++i) {
+    ok = read_direct(list_buffer, out);
+  }
+  timer.stop();
+  const double read_direct_usec = usec_per(timer, iterations);
+
+  if (!ok) {
+    ACE_ERROR((LM_ERROR, ACE_TEXT("ERROR: %C failed to convert\n"), name));
+    return false;
+  }
+
+  std::printf("%12s %8lu %14.2f %14.2f %14.2f %14.2f\n", name,
+              static_cast<unsigned long>(list_buffer.length()),
+              write_list_usec, write_direct_usec, read_list_usec, read_direct_usec);
+  return true;
+}
+
+}
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR* argv[])
+{
+  int iterations = 100000;
+  ACE_Arg_Shifter_T<ACE_TCHAR> shifter(argc, argv);
+  while (shifter.is_anything_left()) {
+    const ACE_TCHAR* currentArg = 0;
+    if ((currentArg = shifter.get_the_parameter(ACE_TEXT("-n"))) != 0) {
+      iterations = ACE_OS::atoi(currentArg);
+      shifter.consume_arg();
+    } else {
+      shifter.ignore_arg();
+    }
+  }
+
+  std::printf("%12s %8s %14s %14s %14s %14s\n", "data", "bytes",
+              "write list us", "write dir us", "read list us", "read dir us");
+
+  const bool ok = run("participant", participant_data(), iterations)
+    && run("writer", writer_data(), iterations)
+    && run("reader", reader_data(), iterations);
+
+  return ok ? 0 : 1;
+}
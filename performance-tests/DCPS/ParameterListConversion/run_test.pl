@@ -0,0 +1,19 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+    & eval 'exec perl -S $0 $argv:q'
+    if 0;
+
+# Reports the time to serialize and parse SPDP participant data and SEDP
+# writer and reader data by way of a ParameterList and directly.
+# Arguments are passed on to parameter_list_conversion: -n <iterations>.
+
+use Env (DDS_ROOT);
+use lib "$DDS_ROOT/bin";
+use Env (ACE_ROOT);
+use lib "$ACE_ROOT/bin";
+use PerlDDS::Run_Test;
+use strict;
+
+my $test = new PerlDDS::TestFramework();
+$test->process('bench', 'parameter_list_conversion', join(' ', @ARGV));
+$test->start_process('bench');
+exit $test->finish(300);
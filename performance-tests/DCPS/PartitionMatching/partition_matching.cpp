@@ -0,0 +1,154 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+// Times matching a publisher's partitions with a subscriber's for lists
+// of 1 to 1000 names, a tenth of them wildcards, that share no partition
+// (so every name has to be compared).  "pairwise" is the comparison of
+// every name of one list with every name of the other that discovery
+// made before PartitionMatcher, "compiled" compares lists compiled once,
+// and "cached" looks the result up as discovery does for endpoints whose
+// partitions have been compared before.
+
+#include <dds/DCPS/PartitionMatcher.h>
+
+#include <ace/ACE.h>
+#include <ace/Arg_Shifter.h>
+#include <ace/High_Res_Timer.h>
+#include <ace/OS_NS_stdlib.h>
+#include <ace/OS_NS_string.h>
+
+#include <cstdio>
+
+using OpenDDS::DCPS::PartitionMatcher;
+
+namespace {
+
+bool is_wildcard(const char* name)
+{
+  return ACE_OS::strpbrk(name, "?*[") != 0;
+}
+
+/// The per pair matching from before PartitionMatcher.
+bool pairwise(const DDS::PartitionQosPolicy& pub, const DDS::PartitionQosPolicy& sub)
+{
+  for (CORBA::ULong i = 0; i < pub.name.length(); ++i) {
+    const bool pub_wild = is_wildcard(pub.name[i]);
+    for (CORBA::ULong j = 0; j < sub.name.length(); ++j) {
+      const bool sub_wild = is_wildcard(sub.name[j]);
+      if (pub_wild && sub_wild) {
+        continue;
+      }
+      if (sub_wild ? ACE::wild_match(pub.name[i], sub.name[j], true, true) :
+          pub_wild ? ACE::wild_match(sub.name[j], pub.name[i], true, true) :
+          ACE_OS::strcmp(pub.name[i], sub.name[j]) == 0) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+/// @a count names for @a side ("pub" or "sub"), every tenth a wildcard
+/// that only matches names of the same side.
+void partitions(DDS::PartitionQosPolicy& qos, const char* side, int count)
+{
+  qos.name.length(count);
+  for (int i = 0; i < count; ++i) {
+    char name[64];
+    if (i % 10 == 9) {
+      std::sprintf(name, "%s/region-%d/*", side, i);
+    } else {
+      std::sprintf(name, "%s/region-%d/site-%d", side, i / 10, i);
+    }
+    qos.name[i] = name;
+  }
+}
+
+double usec_per(ACE_High_Res_Timer& timer, int iterations)
+{
+  ACE_hrtime_t nsec;
+  timer.elapsed_time(nsec);
+  return double(nsec) / 1000.0 / iterations;
+}
+
+}
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR* argv[])
+{
+  int iterations = 1000;
+  ACE_Arg_Shifter_T<ACE_TCHAR> shifter(argc, argv);
+  while (shifter.is_anything_left()) {
+    const ACE_TCHAR* currentArg = 0;
+    if ((currentArg = shifter.get_the_parameter(ACE_TEXT("-n"))) != 0) {
+      iterations = ACE_OS::atoi(currentArg);
+      shifter.consume_arg();
+    } else {
+      shifter.ignore_arg();
+    }
+  }
+
+  const int counts[] = { 1, 10, 100, 300, 1000 };
+
+  std::printf("%10s %14s %14s %14s %14s\n", "partitions", "pairwise us",
+              "compile 2 us", "compiled us", "cached us");
+
+  PartitionMatcher& matcher = *PartitionMatcher::instance();
+  int status = 0;
+
+  for (size_t c = 0; c < sizeof counts / sizeof counts[0]; ++c) {
+    DDS::PartitionQosPolicy pub, sub;
+    partitions(pub, "pub", counts[c]);
+    partitions(sub, "sub", counts[c]);
+
+    bool matched = false;
+    ACE_High_Res_Timer timer;
+
+    // Fewer iterations for the quadratic comparison of the long lists.
+    const int pairwise_iterations = counts[c] > 100 ? iterations / 100 + 1 : iterations;
+    timer.start();
+    for (int i = 0; i < pairwise_iterations; ++i) {
+      matched = pairwise(pub, sub) || matched;
+    }
+    timer.stop();
+    const double pairwise_usec = usec_per(timer, pairwise_iterations);
+
+    // Each list is compiled the first time it is seen.
+    timer.reset();
+    timer.start();
+    PartitionMatcher::Partitions_rch pub_compiled = matcher.compile(pub);
+    PartitionMatcher::Partitions_rch sub_compiled = matcher.compile(sub);
+    timer.stop();
+    const double compile_usec = usec_per(timer, 1);
+
+    timer.reset();
+    timer.start();
+    for (int i = 0; i < iterations; ++i) {
+      matched = PartitionMatcher::match_i(*pub_compiled, *sub_compiled) || matched;
+    }
+    timer.stop();
+    const double compiled_usec = usec_per(timer, iterations);
+
+    timer.reset();
+    timer.start();
+    for (int i = 0; i < iterations; ++i) {
+      matched = matcher.match(*pub_compiled, *sub_compiled) || matched;
+    }
+    timer.stop();
+    const double cached_usec = usec_per(timer, iterations);
+
+    if (matched) {
+      ACE_ERROR((LM_ERROR, ACE_TEXT("ERROR: partitions that share no name matched\n")));
+      status = 1;
+    }
+
+    std::printf("%10d %14.2f %14.2f %14.2f %14.2f\n", counts[c], pairwise_usec,
+                compile_usec, compiled_usec, cached_usec);
+  }
+
+  return status;
+}
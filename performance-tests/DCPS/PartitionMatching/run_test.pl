@@ -0,0 +1,19 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+    & eval 'exec perl -S $0 $argv:q'
+    if 0;
+
+# Reports the time to match a publisher's and a subscriber's partition
+# lists of 1 to 1000 names.  Arguments are passed on to
+# partition_matching: -n <iterations>.
+
+use Env (DDS_ROOT);
+use lib "$DDS_ROOT/bin";
+use Env (ACE_ROOT);
+use lib "$ACE_ROOT/bin";
+use PerlDDS::Run_Test;
+use strict;
+
+my $test = new PerlDDS::TestFramework();
+$test->process('bench', 'partition_matching', join(' ', @ARGV));
+$test->start_process('bench');
+exit $test->finish(300);
@@ -0,0 +1,21 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+    & eval 'exec perl -S $0 $argv:q'
+    if 0;
+
+# Reports the time StaticDiscovery takes to load 100 to 4000 endpoints from
+# [endpoint] sections, matching them as it goes, and from the generated
+# tables, which are already matched.
+
+use Env (DDS_ROOT);
+use lib "$DDS_ROOT/bin";
+use Env (ACE_ROOT);
+use lib "$ACE_ROOT/bin";
+use PerlDDS::Run_Test;
+use strict;
+
+my $test = new PerlDDS::TestFramework();
+$test->process('bench', 'static_discovery_startup',
+               '-DCPSConfigFile static_discovery_startup.ini ' . join(' ', @ARGV));
+$test->start_process('bench');
+$test->stop_process(600, 'bench');
+exit $test->finish(5);
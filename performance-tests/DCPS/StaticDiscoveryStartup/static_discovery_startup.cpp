@@ -0,0 +1,188 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+// Compares the two ways StaticDiscovery can learn a domain of endpoints at
+// startup.  For each count given with -n (default 100, 1000 and 4000), a
+// configuration file with that many [endpoint] sections is written,
+// spread over -t topics (default 10) and participants of -e writers and -e
+// readers (default 10 each).  Then the time to read the file and
+// load_configuration() it, which parses it and matches every writer with
+// every reader, is compared with the time to load_tables() the tables
+// that bin/static_discovery_tables would generate from it.  The tables
+// are built in memory here, which is what the generated C++ initializes
+// when the program is loaded.
+
+#include <dds/DCPS/Service_Participant.h>
+#include <dds/DCPS/StaticDiscovery.h>
+
+#include "dds/DCPS/StaticIncludes.h"
+#ifdef ACE_AS_STATIC_LIBS
+#include <dds/DCPS/transport/rtps_udp/RtpsUdp.h>
+#endif
+
+#include <ace/Arg_Shifter.h>
+#include <ace/Configuration.h>
+#include <ace/Configuration_Import_Export.h>
+#include <ace/Log_Msg.h>
+#include <ace/OS_NS_stdio.h>
+#include <ace/OS_NS_stdlib.h>
+#include <ace/OS_NS_sys_time.h>
+#include <ace/OS_NS_unistd.h>
+
+#include <cstdio>
+#include <vector>
+
+using namespace OpenDDS::DCPS;
+
+namespace {
+
+const char ini_path[] = "static_discovery_startup_endpoints.ini";
+
+double msec_since(const ACE_Time_Value& start)
+{
+  const ACE_Time_Value elapsed = ACE_OS::gettimeofday() - start;
+  return elapsed.sec() * 1e3 + elapsed.usec() / 1e3;
+}
+
+bool write_ini(int endpoints, int topics, int per_participant)
+{
+  FILE* const file = ACE_OS::fopen(ini_path, ACE_TEXT("w"));
+  if (!file) {
+    ACE_ERROR_RETURN((LM_ERROR, ACE_TEXT("ERROR: %p\n"), ACE_TEXT(ini_path)), false);
+  }
+
+  for (int t = 0; t < topics; ++t) {
+    std::fprintf(file, "[topic/T%d]\nname=Topic%d\ntype_name=Type%d\n\n", t, t, t);
+  }
+  std::fprintf(file, "[datawriterqos/reliable]\nreliability.kind=RELIABLE\n\n"
+               "[datareaderqos/reliable]\nreliability.kind=RELIABLE\n\n");
+
+  for (int i = 0; i < endpoints; ++i) {
+    const int participant = i / (2 * per_participant);
+    const int local = i % (2 * per_participant);
+    const bool writer = local < per_participant;
+    std::fprintf(file,
+                 "[endpoint/E%d]\ndomain=54\nparticipant=%012x\nentity=%06x\n"
+                 "type=%s\ntopic=T%d\n%s=reliable\nconfig=bench\n\n",
+                 i, participant + 1, local + 1, writer ? "writer" : "reader",
+                 (local % per_participant) % topics,
+                 writer ? "datawriterqos" : "datareaderqos");
+  }
+
+  return ACE_OS::fclose(file) == 0;
+}
+
+size_t match_count(const EndpointRegistry& registry)
+{
+  size_t count = 0;
+  for (EndpointRegistry::WriterMapType::const_iterator it = registry.writer_map.begin();
+       it != registry.writer_map.end(); ++it) {
+    count += it->second.reliable_readers.size() + it->second.best_effort_readers.size();
+  }
+  return count;
+}
+
+int run(int endpoints, int topics, int per_participant)
+{
+  if (!write_ini(endpoints, topics, per_participant)) {
+    return 1;
+  }
+
+  const ACE_Time_Value parse_start = ACE_OS::gettimeofday();
+  ACE_Configuration_Heap cf;
+  cf.open();
+  ACE_Ini_ImpExp import(cf);
+  const StaticDiscovery_rch parsed = make_rch<StaticDiscovery>("parsed");
+  if (import.import_config(ACE_TEXT(ini_path)) != 0 ||
+      parsed->load_configuration(cf) != 0) {
+    ACE_ERROR_RETURN((LM_ERROR,
+                      ACE_TEXT("ERROR: loading %C failed\n"), ini_path), 1);
+  }
+  const double parse_ms = msec_since(parse_start);
+
+  const StaticDiscoveryTableBuilder builder(parsed->registry);
+  if (!builder.good()) {
+    ACE_ERROR_RETURN((LM_ERROR,
+                      ACE_TEXT("ERROR: building the tables failed\n")), 1);
+  }
+
+  const ACE_Time_Value tables_start = ACE_OS::gettimeofday();
+  const StaticDiscovery_rch loaded = make_rch<StaticDiscovery>("loaded");
+  if (loaded->load_tables(builder.tables()) != 0) {
+    ACE_ERROR_RETURN((LM_ERROR,
+                      ACE_TEXT("ERROR: load_tables failed\n")), 1);
+  }
+  const double tables_ms = msec_since(tables_start);
+
+  const size_t matches = match_count(parsed->registry);
+  if (match_count(loaded->registry) != matches) {
+    ACE_ERROR_RETURN((LM_ERROR,
+                      ACE_TEXT("ERROR: the tables have %B matches instead of %B\n"),
+                      match_count(loaded->registry), matches), 1);
+  }
+
+  std::printf("%9d %9lu %14.2f %14.2f %8.1fx\n", endpoints,
+              static_cast<unsigned long>(matches), parse_ms, tables_ms,
+              tables_ms > 0 ? parse_ms / tables_ms : 0.0);
+  return 0;
+}
+
+}
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR* argv[])
+{
+  int status = 0;
+  try {
+    DDS::DomainParticipantFactory_var dpf =
+      TheParticipantFactoryWithArgs(argc, argv);
+
+    std::vector<int> counts;
+    int topics = 10;
+    int per_participant = 10;
+    ACE_Arg_Shifter_T<ACE_TCHAR> shifter(argc, argv);
+    while (shifter.is_anything_left()) {
+      const ACE_TCHAR* currentArg = 0;
+      if ((currentArg = shifter.get_the_parameter(ACE_TEXT("-n"))) != 0) {
+        counts.push_back(ACE_OS::atoi(currentArg));
+        shifter.consume_arg();
+      } else if ((currentArg = shifter.get_the_parameter(ACE_TEXT("-t"))) != 0) {
+        topics = ACE_OS::atoi(currentArg);
+        shifter.consume_arg();
+      } else if ((currentArg = shifter.get_the_parameter(ACE_TEXT("-e"))) != 0) {
+        per_participant = ACE_OS::atoi(currentArg);
+        shifter.consume_arg();
+      } else {
+        shifter.ignore_arg();
+      }
+    }
+    if (counts.empty()) {
+      counts.push_back(100);
+      counts.push_back(1000);
+      counts.push_back(4000);
+    }
+    if (topics < 1 || per_participant < 1) {
+      ACE_ERROR_RETURN((LM_ERROR,
+                        ACE_TEXT("ERROR: -t and -e must be positive\n")), 1);
+    }
+
+    std::printf("%9s %9s %14s %14s %9s\n",
+                "endpoints", "matches", "config (ms)", "tables (ms)", "speedup");
+    for (size_t i = 0; status == 0 && i < counts.size(); ++i) {
+      status = run(counts[i], topics, per_participant);
+    }
+
+    ACE_OS::unlink(ini_path);
+    TheServiceParticipant->shutdown();
+
+  } catch (const CORBA::Exception& e) {
+    e._tao_print_exception("Exception caught in main():");
+    status = 1;
+  }
+
+  return status;
+}
@@ -0,0 +1,184 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+// Several DataWriters, each written from its own thread, share a tcp
+// link whose transport batches small samples (batch_bytes/batch_delay),
+// so the batch timer often fires while a sample is being added to the
+// packet it holds.
+
+#include <ace/Arg_Shifter.h>
+#include <ace/Log_Msg.h>
+#include <ace/OS_NS_stdlib.h>
+#include <ace/OS_NS_unistd.h>
+#include <ace/Thread_Manager.h>
+
+#include <dds/DCPS/Marked_Default_Qos.h>
+#include <dds/DCPS/Service_Participant.h>
+#include "model/Sync.h"
+
+#include "dds/DCPS/StaticIncludes.h"
+
+#include "MessengerTypeSupportImpl.h"
+
+#include <vector>
+
+namespace {
+
+struct Writer {
+  DDS::DataWriter_var dw;
+  Messenger::MessageDataWriter_var writer;
+  CORBA::Long subject_id;
+  int samples;
+  int interval_usec;
+  int status;
+};
+
+ACE_THR_FUNC_RETURN write_samples(void* arg)
+{
+  Writer& w = *static_cast<Writer*>(arg);
+  Messenger::Message message;
+  message.subject_id = w.subject_id;
+
+  const ACE_Time_Value interval(0, w.interval_usec);
+  for (int i = 0; i < w.samples; ++i) {
+    message.count = i;
+    DDS::ReturnCode_t error;
+    do {
+      error = w.writer->write(message, DDS::HANDLE_NIL);
+    } while (error == DDS::RETCODE_TIMEOUT);
+
+    if (error != DDS::RETCODE_OK) {
+      ACE_ERROR((LM_ERROR,
+                 ACE_TEXT("%N:%l write_samples()")
+                 ACE_TEXT(" ERROR: write returned %d!\n"), error));
+      w.status = 1;
+      break;
+    }
+    ACE_OS::sleep(interval);
+  }
+  return 0;
+}
+
+}
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  int status = 0;
+  try {
+    DDS::DomainParticipantFactory_var dpf =
+      TheParticipantFactoryWithArgs(argc, argv);
+
+    int num_writers = 4;
+    int num_samples = 2000;
+    int interval_usec = 300;
+    ACE_Arg_Shifter_T<ACE_TCHAR> shifter(argc, argv);
+    while (shifter.is_anything_left()) {
+      const ACE_TCHAR* currentArg = 0;
+      if ((currentArg = shifter.get_the_parameter(ACE_TEXT("-w"))) != 0) {
+        num_writers = ACE_OS::atoi(currentArg);
+        shifter.consume_arg();
+      } else if ((currentArg = shifter.get_the_parameter(ACE_TEXT("-n"))) != 0) {
+        num_samples = ACE_OS::atoi(currentArg);
+        shifter.consume_arg();
+      } else if ((currentArg = shifter.get_the_parameter(ACE_TEXT("-i"))) != 0) {
+        interval_usec = ACE_OS::atoi(currentArg);
+        shifter.consume_arg();
+      } else {
+        shifter.ignore_arg();
+      }
+    }
+
+    DDS::DomainParticipant_var participant =
+      dpf->create_participant(42,
+                              PARTICIPANT_QOS_DEFAULT,
+                              DDS::DomainParticipantListener::_nil(),
+                              OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+
+    if (CORBA::is_nil(participant.in())) {
+      ACE_ERROR_RETURN((LM_ERROR,
+                        ACE_TEXT("%N:%l main()")
+                        ACE_TEXT(" ERROR: create_participant() failed!\n")), -1);
+    }
+
+    Messenger::MessageTypeSupport_var ts =
+      new Messenger::MessageTypeSupportImpl();
+
+    if (ts->register_type(participant.in(), "") != DDS::RETCODE_OK) {
+      ACE_ERROR_RETURN((LM_ERROR,
+                        ACE_TEXT("%N:%l main()")
+                        ACE_TEXT(" ERROR: register_type() failed!\n")), -1);
+    }
+
+    CORBA::String_var type_name = ts->get_type_name();
+    DDS::Topic_var topic =
+      participant->create_topic("Batching",
+                                type_name.in(),
+                                TOPIC_QOS_DEFAULT,
+                                DDS::TopicListener::_nil(),
+                                OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+
+    DDS::Publisher_var pub =
+      participant->create_publisher(PUBLISHER_QOS_DEFAULT,
+                                    DDS::PublisherListener::_nil(),
+                                    OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+
+    if (CORBA::is_nil(topic.in()) || CORBA::is_nil(pub.in())) {
+      ACE_ERROR_RETURN((LM_ERROR,
+                        ACE_TEXT("%N:%l main()")
+                        ACE_TEXT(" ERROR: create_topic() or create_publisher() failed!\n")), -1);
+    }
+
+    DDS::DataWriterQos dw_qos;
+    pub->get_default_datawriter_qos(dw_qos);
+    dw_qos.history.kind = DDS::KEEP_ALL_HISTORY_QOS;
+    dw_qos.reliability.kind = DDS::RELIABLE_RELIABILITY_QOS;
+
+    std::vector<Writer> writers(num_writers);
+    for (int i = 0; i < num_writers; ++i) {
+      writers[i].dw =
+        pub->create_datawriter(topic.in(),
+                               dw_qos,
+                               DDS::DataWriterListener::_nil(),
+                               OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+      writers[i].writer = Messenger::MessageDataWriter::_narrow(writers[i].dw.in());
+      if (CORBA::is_nil(writers[i].writer.in())) {
+        ACE_ERROR_RETURN((LM_ERROR,
+                          ACE_TEXT("%N:%l main()")
+                          ACE_TEXT(" ERROR: create_datawriter() failed!\n")), -1);
+      }
+      writers[i].subject_id = i;
+      writers[i].samples = num_samples;
+      writers[i].interval_usec = interval_usec;
+      writers[i].status = 0;
+    }
+
+    for (int i = 0; i < num_writers; ++i) {
+      OpenDDS::Model::WriterSync::wait_match(writers[i].dw, 1);
+    }
+
+    for (int i = 0; i < num_writers; ++i) {
+      ACE_Thread_Manager::instance()->spawn(write_samples, &writers[i]);
+    }
+    ACE_Thread_Manager::instance()->wait();
+
+    for (int i = 0; i < num_writers; ++i) {
+      status |= writers[i].status;
+      OpenDDS::Model::WriterSync::wait_unmatch(writers[i].dw, 1);
+    }
+
+    participant->delete_contained_entities();
+    dpf->delete_participant(participant.in());
+    TheServiceParticipant->shutdown();
+
+  } catch (const CORBA::Exception& e) {
+    e._tao_print_exception("Exception caught in main():");
+    status = 1;
+  }
+
+  return status;
+}
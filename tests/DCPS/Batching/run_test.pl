@@ -0,0 +1,55 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+    & eval 'exec perl -S $0 $argv:q'
+    if 0;
+
+# -*- perl -*-
+
+# Several writers sharing one batching tcp link write small samples
+# faster than the batch fills.  Every sample must arrive and none may be
+# held back much longer than batch_delay, even when the batch timer
+# fires while another thread is in the middle of a send.
+
+use Env (DDS_ROOT);
+use lib "$DDS_ROOT/bin";
+use Env (ACE_ROOT);
+use lib "$ACE_ROOT/bin";
+use PerlDDS::Run_Test;
+use strict;
+
+my $test = new PerlDDS::TestFramework();
+
+$test->{dcps_transport_debug_level} = 1;
+$test->{add_transport_config} = 0;
+
+my $writers = 4;
+my $samples = 2000;
+my $total = $writers * $samples;
+my $batch_delay_msec = 100;
+my $bound_msec = 150;
+
+open(my $fh, '>', 'batching.ini') or die "Open batching.ini failed: $!";
+print $fh "[common]\n" .
+  "DCPSGlobalTransportConfig=\$file\n\n" .
+  "[transport/tcp]\n" .
+  "transport_type=tcp\n" .
+  "batch_bytes=64000\n" .
+  "batch_delay=" . ($batch_delay_msec * 1000) . "\n";
+close $fh;
+
+unlink 'pub.log', 'sub.log';
+
+$test->setup_discovery();
+
+$test->process('sub', 'subscriber',
+               "-DCPSConfigFile batching.ini -ORBLogFile sub.log " .
+               "-n $total -b $bound_msec");
+$test->process('pub', 'publisher',
+               "-DCPSConfigFile batching.ini -ORBLogFile pub.log " .
+               "-w $writers -n $samples -i 300");
+$test->start_process('sub');
+$test->start_process('pub');
+
+my $status = $test->finish(300);
+
+unlink 'batching.ini';
+exit $status;
@@ -371,6 +371,114 @@ bool pubsub(OpenDDS::DCPS::Discovery_rch disc, CORBA::ORB_var orb)
   return true;
 }
 
+/// A new reader or writer that matches several endpoints at once is told
+/// about each of them, whether the repository sends them in one
+/// add_associations() call (-BatchAssociations) or not.
+bool multiple_matches(OpenDDS::DCPS::Discovery_rch disc, CORBA::ORB_var orb)
+{
+  ACE_DEBUG((LM_DEBUG,
+             ACE_TEXT("multiple matches test\n")));
+
+  const CORBA::Long domain = 10;
+  const unsigned int max_delay = 10;
+
+  struct Callbacks : public OpenDDS::DCPS::TopicCallbacks {
+    void inconsistent_topic(int /*count*/) {}
+  } callbacks;
+
+  ::DDS::DomainParticipantQos_var partQos = new ::DDS::DomainParticipantQos;
+  *partQos = TheServiceParticipant->initial_DomainParticipantQos();
+  const OpenDDS::DCPS::RepoId pubPartId =
+    disc->add_domain_participant(domain, partQos.in()).id;
+  const OpenDDS::DCPS::RepoId subPartId =
+    disc->add_domain_participant(domain, partQos.in()).id;
+  if (OpenDDS::DCPS::GUID_UNKNOWN == pubPartId ||
+      OpenDDS::DCPS::GUID_UNKNOWN == subPartId)
+    {
+      ACE_ERROR_RETURN((LM_ERROR, ACE_TEXT("ERROR: add_domain_participant failed!\n")), false);
+    }
+
+  ::DDS::TopicQos_var topicQos = new ::DDS::TopicQos;
+  *topicQos = TheServiceParticipant->initial_TopicQos();
+  OpenDDS::DCPS::RepoId pubTopicId, subTopicId;
+  if (disc->assert_topic(pubTopicId, domain, pubPartId, "MultiTopic", "MultiType",
+                         topicQos.in(), false, &callbacks) != OpenDDS::DCPS::CREATED ||
+      disc->assert_topic(subTopicId, domain, subPartId, "MultiTopic", "MultiType",
+                         topicQos.in(), false, &callbacks) != OpenDDS::DCPS::CREATED)
+    {
+      ACE_ERROR_RETURN((LM_ERROR, ACE_TEXT("ERROR: Topic creation failed\n")), false);
+    }
+
+  ::DDS::DataWriterQos_var dwQos = new ::DDS::DataWriterQos;
+  *dwQos = TheServiceParticipant->initial_DataWriterQos();
+  dwQos->reliability.kind = DDS::RELIABLE_RELIABILITY_QOS;
+  ::DDS::PublisherQos_var pQos = new ::DDS::PublisherQos;
+  *pQos = TheServiceParticipant->initial_PublisherQos();
+  ::DDS::DataReaderQos_var drQos = new ::DDS::DataReaderQos;
+  *drQos = TheServiceParticipant->initial_DataReaderQos();
+  drQos->reliability.kind = ::DDS::RELIABLE_RELIABILITY_QOS;
+  ::DDS::SubscriberQos_var subQos = new ::DDS::SubscriberQos;
+  *subQos = TheServiceParticipant->initial_SubscriberQos();
+
+  OpenDDS::DCPS::TransportLocatorSeq tii;
+  tii.length(1);
+  tii[0].transport_type = "fake transport for test";
+
+  std::vector<DiscReceivedCalls::Called> one(1, DiscReceivedCalls::ADD_ASSOC);
+  std::vector<DiscReceivedCalls::Called> two(2, DiscReceivedCalls::ADD_ASSOC);
+  bool ok = true;
+
+  // Two writers, then a reader matching both of them.
+  TAO_DDS_DCPSDataWriter_i dw1Impl, dw2Impl, dw3Impl;
+  const OpenDDS::DCPS::RepoId pub1Id =
+    disc->add_publication(domain, pubPartId, pubTopicId, &dw1Impl, dwQos.in(), tii, pQos.in());
+  const OpenDDS::DCPS::RepoId pub2Id =
+    disc->add_publication(domain, pubPartId, pubTopicId, &dw2Impl, dwQos.in(), tii, pQos.in());
+
+  TAO_DDS_DCPSDataReader_i dr1Impl, dr2Impl;
+  const OpenDDS::DCPS::RepoId sub1Id =
+    disc->add_subscription(domain, subPartId, subTopicId, &dr1Impl, drQos.in(), tii,
+                           subQos.in(), "", "", DDS::StringSeq());
+
+  ok &= dr1Impl.received().expect(orb, max_delay, two);
+  ok &= dw1Impl.received().expect(orb, max_delay, one);
+  ok &= dw2Impl.received().expect(orb, max_delay, one);
+
+  // Another reader, which also matches both.
+  const OpenDDS::DCPS::RepoId sub2Id =
+    disc->add_subscription(domain, subPartId, subTopicId, &dr2Impl, drQos.in(), tii,
+                           subQos.in(), "", "", DDS::StringSeq());
+
+  ok &= dr2Impl.received().expect(orb, max_delay, two);
+  ok &= dw1Impl.received().expect(orb, max_delay, one);
+  ok &= dw2Impl.received().expect(orb, max_delay, one);
+
+  // A writer matching both readers.
+  const OpenDDS::DCPS::RepoId pub3Id =
+    disc->add_publication(domain, pubPartId, pubTopicId, &dw3Impl, dwQos.in(), tii, pQos.in());
+
+  ok &= dw3Impl.received().expect(orb, max_delay, two);
+  ok &= dr1Impl.received().expect(orb, max_delay, one);
+  ok &= dr2Impl.received().expect(orb, max_delay, one);
+
+  if (!ok)
+    {
+      ACE_ERROR((LM_ERROR, ACE_TEXT("ERROR: multiple matches were not all associated\n")));
+    }
+
+  disc->remove_publication(domain, pubPartId, pub3Id);
+  disc->remove_subscription(domain, subPartId, sub2Id);
+  disc->remove_subscription(domain, subPartId, sub1Id);
+  disc->remove_publication(domain, pubPartId, pub2Id);
+  disc->remove_publication(domain, pubPartId, pub1Id);
+  disc->remove_topic(domain, pubPartId, pubTopicId);
+  disc->remove_topic(domain, subPartId, subTopicId);
+  disc->remove_domain_participant(domain, subPartId);
+  disc->remove_domain_participant(domain, pubPartId);
+
+  return ok;
+}
+
 int ACE_TMAIN(int argc, ACE_TCHAR *argv[])
 {
   if (parse_args(argc, argv) != 0)
@@ -430,6 +538,12 @@ int ACE_TMAIN(int argc, ACE_TCHAR *argv[])
           return 1;
         }
 
+      // How the repository sends matches; RTPS discovery doesn't batch.
+      if (!use_rtps && !multiple_matches(disc, orb))
+        {
+          failed = true;
+        }
+
       disc.reset();
       obj = 0;
       poa = 0;
@@ -19,6 +19,11 @@ my $dcpsrepo_ior = "dcps_ir.ior";
 unlink $dcpsrepo_ior;
 
 my $opts = "";
+my $repo_opts = "";
+
+if ($ARGV[0] eq "batch") {
+  $repo_opts .= ' -BatchAssociations';
+}
 
 if ($ARGV[0] eq "rtps_disc") {
   $is_rtps_disc = 1;
@@ -30,7 +35,7 @@ if ($ARGV[0] eq "rtps_disc") {
 my $DCPSREPO = undef;
 unless ($is_rtps_disc) {
   $DCPSREPO = PerlDDS::create_process("$DDS_ROOT/bin/DCPSInfoRepo",
-                                       "-NOBITS -o $dcpsrepo_ior");
+                                       "-NOBITS -o $dcpsrepo_ior$repo_opts");
 }
 
 my $PUBSUB = PerlDDS::create_process("pubsub", "$opts -q");
@@ -0,0 +1,239 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+// A subscriber discovers a writer and saves it in its DiscoveryCache when
+// its participant is deleted.  The writer's participant is then deleted
+// without saving, and the subscriber starts again: the writer is
+// preloaded, so the reader is matched with it although it is gone, until
+// DiscoveryCacheLease passes without it being discovered again.  Expired
+// entries are not saved back to the cache.
+
+#include "TestMsgTypeSupportImpl.h"
+
+#include "dds/DCPS/Service_Participant.h"
+#include "dds/DCPS/Marked_Default_Qos.h"
+#include "dds/DCPS/WaitSet.h"
+
+#include "dds/DCPS/RTPS/DiscoveryCache.h"
+#include "dds/DCPS/RTPS/RtpsDiscovery.h"
+
+#include "dds/DCPS/transport/framework/TransportRegistry.h"
+
+#include "dds/DCPS/StaticIncludes.h"
+#ifdef ACE_AS_STATIC_LIBS
+#include "dds/DCPS/transport/rtps_udp/RtpsUdp.h"
+#endif
+
+#include "ace/OS_NS_sys_time.h"
+
+using namespace DDS;
+using OpenDDS::DCPS::DEFAULT_STATUS_MASK;
+using OpenDDS::RTPS::DiscoveryCache;
+using OpenDDS::RTPS::RtpsDiscovery;
+using OpenDDS::RTPS::RtpsDiscovery_rch;
+
+namespace {
+
+const DomainId_t domain = 51;
+const char topic_name[] = "DiscoveryCacheTest";
+
+DomainParticipant_var create_participant(const DomainParticipantFactory_var& dpf,
+                                         const char* config)
+{
+  DomainParticipant_var dp =
+    dpf->create_participant(domain, PARTICIPANT_QOS_DEFAULT, 0, DEFAULT_STATUS_MASK);
+  if (!dp) {
+    ACE_ERROR((LM_ERROR, "ERROR: %P could not create participant %C\n", config));
+    return 0;
+  }
+  // An rtps_udp transport can't be shared between participants.
+  TheTransportRegistry->bind_config(config, dp);
+
+  TestMsgTypeSupport_var ts = new TestMsgTypeSupportImpl;
+  if (ts->register_type(dp, "") != RETCODE_OK) {
+    ACE_ERROR((LM_ERROR, "ERROR: %P failed to register type\n"));
+    return 0;
+  }
+  return dp;
+}
+
+Topic_var create_topic(const DomainParticipant_var& dp)
+{
+  TestMsgTypeSupport_var ts = new TestMsgTypeSupportImpl;
+  const CORBA::String_var type_name = ts->get_type_name();
+  return dp->create_topic(topic_name, type_name, TOPIC_QOS_DEFAULT, 0,
+                          DEFAULT_STATUS_MASK);
+}
+
+DataReader_var create_reader(const DomainParticipant_var& dp)
+{
+  Topic_var topic = create_topic(dp);
+  Subscriber_var sub = dp->create_subscriber(SUBSCRIBER_QOS_DEFAULT, 0,
+                                             DEFAULT_STATUS_MASK);
+  if (!topic || !sub) {
+    return 0;
+  }
+  return sub->create_datareader(topic, DATAREADER_QOS_DEFAULT, 0,
+                                DEFAULT_STATUS_MASK);
+}
+
+DataWriter_var create_writer(const DomainParticipant_var& dp)
+{
+  Topic_var topic = create_topic(dp);
+  Publisher_var pub = dp->create_publisher(PUBLISHER_QOS_DEFAULT, 0,
+                                           DEFAULT_STATUS_MASK);
+  if (!topic || !pub) {
+    return 0;
+  }
+  return pub->create_datawriter(topic, DATAWRITER_QOS_DEFAULT, 0,
+                                DEFAULT_STATUS_MASK);
+}
+
+void cleanup(const DomainParticipantFactory_var& dpf, DomainParticipant_var& dp)
+{
+  if (!dp) return;
+  dp->delete_contained_entities();
+  dpf->delete_participant(dp);
+  dp = 0;
+}
+
+/// Wait until @a dr is matched with @a n writers, or until @a deadline.
+bool wait_match(const DataReader_var& dr, int n, const ACE_Time_Value& deadline)
+{
+  StatusCondition_var condition = dr->get_statuscondition();
+  condition->set_enabled_statuses(SUBSCRIPTION_MATCHED_STATUS);
+  WaitSet_var ws = new DDS::WaitSet;
+  ws->attach_condition(condition);
+  ConditionSeq conditions;
+  SubscriptionMatchedStatus ms = {0, 0, 0, 0, 0};
+  const Duration_t timeout = {0, 100000000};
+  bool matched = false;
+  while (dr->get_subscription_matched_status(ms) == RETCODE_OK) {
+    if (ms.current_count == n) {
+      matched = true;
+      break;
+    }
+    if (ACE_OS::gettimeofday() >= deadline) {
+      break;
+    }
+    ws->wait(conditions, timeout);
+  }
+  ws->detach_condition(condition);
+  return matched;
+}
+
+/// The number of writers in the cache file; -1 if there is none.
+int cached_writers(const RtpsDiscovery_rch& disco)
+{
+  DiscoveryCache cache;
+  if (!cache.load(DiscoveryCache::path(TheServiceParticipant->persistent_data_dir().c_str(),
+                                       disco->key(), domain))) {
+    return -1;
+  }
+  return static_cast<int>(cache.writers_.size());
+}
+
+bool run_test(const DomainParticipantFactory_var& dpf, const RtpsDiscovery_rch& disco)
+{
+  const ACE_Time_Value lease = disco->discovery_cache_lease();
+
+  DomainParticipant_var dp_pub = create_participant(dpf, "pub");
+  DomainParticipant_var dp_sub = create_participant(dpf, "sub");
+  if (!dp_pub || !dp_sub) {
+    return false;
+  }
+  DataWriter_var dw = create_writer(dp_pub);
+  DataReader_var dr = create_reader(dp_sub);
+  if (!dw || !dr) {
+    ACE_ERROR((LM_ERROR, "ERROR: %P failed to create the writer or the reader\n"));
+    return false;
+  }
+  if (!wait_match(dr, 1, ACE_OS::gettimeofday() + ACE_Time_Value(30))) {
+    ACE_ERROR((LM_ERROR, "ERROR: %P the reader wasn't matched with the writer\n"));
+    return false;
+  }
+
+  // Deleting the subscriber's participant saves what it discovered.
+  dr = 0;
+  cleanup(dpf, dp_sub);
+  const int saved = cached_writers(disco);
+  if (saved != 1) {
+    ACE_ERROR((LM_ERROR, "ERROR: %P expected 1 cached writer, found %d\n", saved));
+    return false;
+  }
+
+  // The publisher doesn't save, so the subscriber's file is left as it is.
+  disco->discovery_cache(false);
+  dw = 0;
+  cleanup(dpf, dp_pub);
+  disco->discovery_cache(true);
+
+  // The writer is gone, so a match can only come from the cache.
+  const ACE_Time_Value start = ACE_OS::gettimeofday();
+  DomainParticipant_var dp_restart = create_participant(dpf, "restart");
+  if (!dp_restart) {
+    return false;
+  }
+  dr = create_reader(dp_restart);
+  if (!dr) {
+    ACE_ERROR((LM_ERROR, "ERROR: %P failed to create the restarted reader\n"));
+    return false;
+  }
+  if (!wait_match(dr, 1, start + lease - ACE_Time_Value(1))) {
+    ACE_ERROR((LM_ERROR, "ERROR: %P the preloaded writer wasn't matched\n"));
+    return false;
+  }
+
+  // It isn't discovered again, so it expires.
+  if (!wait_match(dr, 0, start + lease + ACE_Time_Value(10))) {
+    ACE_ERROR((LM_ERROR, "ERROR: %P the preloaded writer didn't expire\n"));
+    return false;
+  }
+  const ACE_Time_Value expired = ACE_OS::gettimeofday() - start;
+  if (expired < lease - ACE_Time_Value(1)) {
+    ACE_ERROR((LM_ERROR, "ERROR: %P the preloaded writer expired after %d ms, "
+               "before its lease\n", static_cast<int>(expired.msec())));
+    return false;
+  }
+
+  dr = 0;
+  cleanup(dpf, dp_restart);
+  const int resaved = cached_writers(disco);
+  if (resaved != 0) {
+    ACE_ERROR((LM_ERROR, "ERROR: %P expected no cached writer after it expired, "
+               "found %d\n", resaved));
+    return false;
+  }
+  return true;
+}
+
+}
+
+int ACE_TMAIN(int argc, ACE_TCHAR* argv[])
+{
+  bool ok = false;
+  try {
+    DomainParticipantFactory_var dpf = TheParticipantFactoryWithArgs(argc, argv);
+
+    RtpsDiscovery_rch disco =
+      OpenDDS::DCPS::dynamic_rchandle_cast<RtpsDiscovery>(
+        TheServiceParticipant->get_discovery(domain));
+    if (!disco || !disco->discovery_cache()) {
+      ACE_ERROR((LM_ERROR, "ERROR: %P the domain doesn't use RTPS discovery "
+                 "with DiscoveryCache\n"));
+    } else {
+      ok = run_test(dpf, disco);
+    }
+
+    TheServiceParticipant->shutdown();
+  } catch (const CORBA::Exception& e) {
+    e._tao_print_exception("ERROR: %P Exception thrown:");
+    return -2;
+  }
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
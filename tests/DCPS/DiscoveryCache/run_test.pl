@@ -0,0 +1,24 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+     & eval 'exec perl -S $0 $argv:q'
+     if 0;
+
+# -*- perl -*-
+
+use lib "$ENV{ACE_ROOT}/bin";
+use lib "$ENV{DDS_ROOT}/bin";
+use PerlDDS::Run_Test;
+use File::Path qw(rmtree);
+use strict;
+
+my $dir = 'discovery_cache_dir';
+rmtree($dir);
+
+my $test = new PerlDDS::TestFramework();
+$test->enable_console_logging();
+$test->process('test', 'DiscoveryCacheTest',
+               "-DCPSConfigFile discovery_cache.ini -DCPSPersistentDataDir $dir");
+$test->start_process('test');
+my $result = $test->finish(120);
+
+rmtree($dir);
+exit $result;
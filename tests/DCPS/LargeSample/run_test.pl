@@ -29,6 +29,11 @@ elsif ($test->flag('multicast_async')) {
     $pub_opts .= "-DCPSConfigFile pub_multicast_async.ini ";
     $sub_opts .= "-DCPSConfigFile multicast.ini ";
 }
+# tcp, sending the samples with MSG_ZEROCOPY
+elsif ($test->flag('tcp_zerocopy')) {
+    $pub_opts .= "-DCPSConfigFile tcp_zerocopy.ini ";
+    $sub_opts .= "-DCPSConfigFile tcp_zerocopy.ini ";
+}
 
 my($pub1opts, $pub2opts) =
     $PerlDDS::SafetyProfile ? ('-p 1', '-p 2') : ('' , '');
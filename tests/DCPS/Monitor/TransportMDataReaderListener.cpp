@@ -15,11 +15,74 @@
 #include <dds/monitor/monitorTypeSupportC.h>
 #include <dds/monitor/monitorTypeSupportImpl.h>
 
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <map>
+#include <string>
 
 using std::cout;
 using std::endl;
 
+namespace {
+
+/// Checks the statistics the send tasks report, which run_test.pl
+/// looks for in the output.  Each bucket list must add up to the count
+/// of the Statistics before it, and the queues are not bounded, so no
+/// sample may have been blocked, dropped or rejected.
+bool check_send_task_values(const OpenDDS::DCPS::NVPSeq& values)
+{
+  bool ok = true;
+  std::map<std::string, CORBA::ULong> counts;
+  for (CORBA::ULong i = 0; i < values.length(); ++i) {
+    const std::string name = values[i].name.in();
+    if (name.compare(0, 10, "send_task.") != 0) {
+      continue;
+    }
+    const OpenDDS::DCPS::ValueUnion& value = values[i].value;
+
+    switch (value._d()) {
+    case OpenDDS::DCPS::STATISTICS_TYPE:
+      counts[name] = value.stat_value().n;
+      if (value.stat_value().n && value.stat_value().mean > value.stat_value().maximum) {
+        ok = false;
+      }
+      break;
+    case OpenDDS::DCPS::STRING_LIST_TYPE: {
+      CORBA::ULong total = 0;
+      for (CORBA::ULong j = 0; j < value.string_seq_value().length(); ++j) {
+        const char* const bucket = value.string_seq_value()[j].in();
+        const char* const colon = std::strchr(bucket, ':');
+        if (colon) {
+          total += static_cast<CORBA::ULong>(std::strtoul(colon + 1, 0, 10));
+        }
+      }
+      const std::string stats = name.substr(0, name.size() - 8); // "_buckets"
+      if (counts.find(stats) == counts.end() || counts[stats] != total) {
+        ok = false;
+      }
+      break;
+    }
+    case OpenDDS::DCPS::INTEGER_TYPE:
+      if (value.integer_value() != 0) {
+        ok = false;
+      }
+      break;
+    default:
+      ok = false;
+      break;
+    }
+
+    if (!ok) {
+      cout << "ERROR: invalid " << name << endl;
+      return false;
+    }
+  }
+  return ok;
+}
+
+}
+
 TransportMDataReaderListenerImpl::TransportMDataReaderListenerImpl()
 {
 }
@@ -57,6 +120,39 @@ void TransportMDataReaderListenerImpl::on_data_available(DDS::DataReader_ptr rea
              << "  transport_id   = " << transportr.transport_id        << endl
              << "  transport_type = " << transportr.transport_type.in() << endl;
 
+        for (CORBA::ULong i = 0; i < transportr.values.length(); ++i) {
+          const OpenDDS::DCPS::NameValuePair& nvp = transportr.values[i];
+          cout << "  " << nvp.name.in() << " = ";
+          switch (nvp.value._d()) {
+          case OpenDDS::DCPS::INTEGER_TYPE:
+            cout << nvp.value.integer_value();
+            break;
+          case OpenDDS::DCPS::DOUBLE_TYPE:
+            cout << nvp.value.double_value();
+            break;
+          case OpenDDS::DCPS::STRING_TYPE:
+            cout << nvp.value.string_value();
+            break;
+          case OpenDDS::DCPS::STATISTICS_TYPE:
+            cout << "n " << nvp.value.stat_value().n
+                 << " mean " << nvp.value.stat_value().mean
+                 << " max " << nvp.value.stat_value().maximum;
+            break;
+          case OpenDDS::DCPS::STRING_LIST_TYPE:
+            for (CORBA::ULong j = 0; j < nvp.value.string_seq_value().length(); ++j) {
+              cout << (j ? " " : "") << nvp.value.string_seq_value()[j].in();
+            }
+            break;
+          }
+          cout << endl;
+        }
+
+        if (!check_send_task_values(transportr.values)) {
+          ACE_ERROR((LM_ERROR,
+                     ACE_TEXT("%N:%l: on_data_available()")
+                     ACE_TEXT(" ERROR: invalid send task statistics\n")));
+        }
+
       } else if (si.instance_state == DDS::NOT_ALIVE_DISPOSED_INSTANCE_STATE) {
         ACE_DEBUG((LM_DEBUG, ACE_TEXT("%N:%l: INFO: instance is disposed\n")));
 
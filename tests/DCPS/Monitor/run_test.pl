@@ -104,6 +104,19 @@ if ($mon_count < 145) {
     $status = 1;
 }
 
+# The publisher sends from a thread per connection, whose statistics are
+# reported from its transport's reactor while it runs.
+my $send_task_count = grep /send_task\.\d+\.queue_depth = n [1-9]/,@monout;
+print STDOUT "send_task_count=$send_task_count\n";
+if ($send_task_count < 1) {
+    print STDERR "ERROR: No send task statistics seen\n";
+    $status = 1;
+}
+if (grep /ERROR: invalid send_task/,@monout) {
+    print STDERR "ERROR: Invalid send task statistics seen\n";
+    $status = 1;
+}
+
 if ($status == 0) {
   print "test PASSED.\n";
 } else {
@@ -0,0 +1,151 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+// Writes samples over a reliable multicast link whose transport drops
+// outgoing datagrams (send_loss_rate), so that every subscriber has to
+// repair the losses with NAKs.
+
+#include <ace/Arg_Shifter.h>
+#include <ace/Log_Msg.h>
+#include <ace/OS_NS_stdlib.h>
+#include <ace/OS_NS_unistd.h>
+
+#include <dds/DCPS/Marked_Default_Qos.h>
+#include <dds/DCPS/Service_Participant.h>
+#include "model/Sync.h"
+
+#include "dds/DCPS/StaticIncludes.h"
+
+#include "MessengerTypeSupportImpl.h"
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  int status = 0;
+  try {
+    DDS::DomainParticipantFactory_var dpf =
+      TheParticipantFactoryWithArgs(argc, argv);
+
+    int num_samples = 2000;
+    int num_subscribers = 8;
+    int interval_usec = 1000;
+    ACE_Arg_Shifter_T<ACE_TCHAR> shifter(argc, argv);
+    while (shifter.is_anything_left()) {
+      const ACE_TCHAR* currentArg = 0;
+      if ((currentArg = shifter.get_the_parameter(ACE_TEXT("-n"))) != 0) {
+        num_samples = ACE_OS::atoi(currentArg);
+        shifter.consume_arg();
+      } else if ((currentArg = shifter.get_the_parameter(ACE_TEXT("-s"))) != 0) {
+        num_subscribers = ACE_OS::atoi(currentArg);
+        shifter.consume_arg();
+      } else if ((currentArg = shifter.get_the_parameter(ACE_TEXT("-i"))) != 0) {
+        interval_usec = ACE_OS::atoi(currentArg);
+        shifter.consume_arg();
+      } else {
+        shifter.ignore_arg();
+      }
+    }
+
+    DDS::DomainParticipant_var participant =
+      dpf->create_participant(42,
+                              PARTICIPANT_QOS_DEFAULT,
+                              DDS::DomainParticipantListener::_nil(),
+                              OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+
+    if (CORBA::is_nil(participant.in())) {
+      ACE_ERROR_RETURN((LM_ERROR,
+                        ACE_TEXT("%N:%l main()")
+                        ACE_TEXT(" ERROR: create_participant() failed!\n")), -1);
+    }
+
+    Messenger::MessageTypeSupport_var ts =
+      new Messenger::MessageTypeSupportImpl();
+
+    if (ts->register_type(participant.in(), "") != DDS::RETCODE_OK) {
+      ACE_ERROR_RETURN((LM_ERROR,
+                        ACE_TEXT("%N:%l main()")
+                        ACE_TEXT(" ERROR: register_type() failed!\n")), -1);
+    }
+
+    CORBA::String_var type_name = ts->get_type_name();
+    DDS::Topic_var topic =
+      participant->create_topic("MulticastRepair",
+                                type_name.in(),
+                                TOPIC_QOS_DEFAULT,
+                                DDS::TopicListener::_nil(),
+                                OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+
+    DDS::Publisher_var pub =
+      participant->create_publisher(PUBLISHER_QOS_DEFAULT,
+                                    DDS::PublisherListener::_nil(),
+                                    OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+
+    if (CORBA::is_nil(topic.in()) || CORBA::is_nil(pub.in())) {
+      ACE_ERROR_RETURN((LM_ERROR,
+                        ACE_TEXT("%N:%l main()")
+                        ACE_TEXT(" ERROR: create_topic() or create_publisher() failed!\n")), -1);
+    }
+
+    DDS::DataWriterQos dw_qos;
+    pub->get_default_datawriter_qos(dw_qos);
+    dw_qos.history.kind = DDS::KEEP_ALL_HISTORY_QOS;
+    dw_qos.reliability.kind = DDS::RELIABLE_RELIABILITY_QOS;
+
+    DDS::DataWriter_var dw =
+      pub->create_datawriter(topic.in(),
+                             dw_qos,
+                             DDS::DataWriterListener::_nil(),
+                             OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+
+    Messenger::MessageDataWriter_var message_dw =
+      Messenger::MessageDataWriter::_narrow(dw.in());
+
+    if (CORBA::is_nil(message_dw.in())) {
+      ACE_ERROR_RETURN((LM_ERROR,
+                        ACE_TEXT("%N:%l main()")
+                        ACE_TEXT(" ERROR: create_datawriter() failed!\n")), -1);
+    }
+
+    OpenDDS::Model::WriterSync::wait_match(dw, num_subscribers);
+
+    Messenger::Message message;
+    message.subject_id = 0;
+    message.text = "A lost datagram is repaired once for every receiver.";
+
+    const ACE_Time_Value interval(0, interval_usec);
+    for (int i = 0; i < num_samples; ++i) {
+      message.count = i;
+      DDS::ReturnCode_t error;
+      do {
+        error = message_dw->write(message, DDS::HANDLE_NIL);
+      } while (error == DDS::RETCODE_TIMEOUT);
+
+      if (error != DDS::RETCODE_OK) {
+        ACE_ERROR((LM_ERROR,
+                   ACE_TEXT("%N:%l main()")
+                   ACE_TEXT(" ERROR: write returned %d!\n"), error));
+        status = 1;
+        break;
+      }
+      ACE_OS::sleep(interval);
+    }
+
+    // Keep the link, and the send buffer the repairs come from, until
+    // every subscriber has all of the samples and goes away.
+    OpenDDS::Model::WriterSync::wait_unmatch(dw, num_subscribers);
+
+    participant->delete_contained_entities();
+    dpf->delete_participant(participant.in());
+    TheServiceParticipant->shutdown();
+
+  } catch (const CORBA::Exception& e) {
+    e._tao_print_exception("Exception caught in main():");
+    status = 1;
+  }
+
+  return status;
+}
@@ -0,0 +1,102 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+    & eval 'exec perl -S $0 $argv:q'
+    if 0;
+
+# -*- perl -*-
+
+# One publisher and many subscribers on a reliable multicast link whose
+# publishing transport drops datagrams.  Every subscriber must receive
+# every sample; the repair traffic (NAKs sent and suppressed, repairs
+# requested and resent) is summarized from the transport statistics.
+#
+#   run_test.pl [nosuppress] [subscribers=N]
+#
+# nosuppress turns off NAK suppression and repair aggregation for
+# comparison.
+
+use Env (DDS_ROOT);
+use lib "$DDS_ROOT/bin";
+use Env (ACE_ROOT);
+use lib "$ACE_ROOT/bin";
+use PerlDDS::Run_Test;
+use strict;
+
+my $test = new PerlDDS::TestFramework();
+
+$test->{dcps_transport_debug_level} = 1;
+$test->{add_transport_config} = 0;
+
+my $subscribers = 8;
+foreach my $arg (@ARGV) {
+  $subscribers = $1 if $arg =~ /^subscribers=(\d+)$/;
+}
+my $samples = 2000;
+my $suppress = $test->flag('nosuppress') ? 0 : 1;
+my $repair_delay = $suppress ? 20 : 0;
+
+sub write_ini {
+  my ($file, $extra) = @_;
+  open(my $fh, '>', $file) or die "Open $file failed: $!";
+  print $fh "[common]\n" .
+    "DCPSGlobalTransportConfig=\$file\n\n" .
+    "[transport/multicast]\n" .
+    "transport_type=multicast\n" .
+    "group_address=224.0.0.128:49210\n" .
+    "nak_depth=4096\n" .
+    "nak_interval=100\n" .
+    "nak_suppression=$suppress\n" .
+    "nak_repair_delay=$repair_delay\n" .
+    $extra;
+  close $fh;
+}
+
+write_ini('pub.ini', "send_loss_rate=0.02\nsend_loss_burst=2\n");
+write_ini('sub.ini', "");
+
+my @logs = ('pub.log');
+unlink 'pub.log';
+
+$test->setup_discovery();
+
+$test->process('pub', 'publisher',
+               "-DCPSConfigFile pub.ini -ORBLogFile pub.log " .
+               "-n $samples -s $subscribers");
+for (my $i = 0; $i < $subscribers; ++$i) {
+  unlink "sub$i.log";
+  push(@logs, "sub$i.log");
+  $test->process("sub$i", 'subscriber',
+                 "-DCPSConfigFile sub.ini -ORBLogFile sub$i.log -n $samples");
+  $test->start_process("sub$i");
+}
+$test->start_process('pub');
+
+my $status = $test->finish(300);
+
+my %totals = (naks => 0, suppressed => 0, requested => 0, resent => 0);
+foreach my $log (@logs) {
+  open(my $fh, '<', $log) or next;
+  while (<$fh>) {
+    if (/naks sent: (\d+) suppressed: (\d+)/) {
+      $totals{naks} += $1;
+      $totals{suppressed} += $2;
+    }
+    if (/repair ranges requested: (\d+) resent: (\d+)/) {
+      $totals{requested} += $1;
+      $totals{resent} += $2;
+    }
+  }
+  close $fh;
+}
+
+print "$subscribers subscribers, nak_suppression=$suppress " .
+      "nak_repair_delay=$repair_delay: " .
+      "naks sent $totals{naks}, suppressed $totals{suppressed}, " .
+      "repair ranges requested $totals{requested}, resent $totals{resent}\n";
+
+if ($totals{resent} > $totals{requested}) {
+  print STDERR "ERROR: more repairs resent than requested\n";
+  $status = 1;
+}
+
+unlink 'pub.ini', 'sub.ini';
+exit $status;
@@ -0,0 +1,171 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include <ace/Arg_Shifter.h>
+#include <ace/Log_Msg.h>
+#include <ace/OS_NS_stdlib.h>
+#include <ace/OS_NS_sys_time.h>
+
+#include <dds/DCPS/Marked_Default_Qos.h>
+#include <dds/DCPS/Service_Participant.h>
+#include <dds/DCPS/WaitSet.h>
+
+#include "dds/DCPS/StaticIncludes.h"
+
+#include "MessengerTypeSupportImpl.h"
+
+#include <iostream>
+#include <vector>
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  int status = 0;
+  try {
+    DDS::DomainParticipantFactory_var dpf =
+      TheParticipantFactoryWithArgs(argc, argv);
+
+    int num_samples = 2000;
+    int timeout_sec = 120;
+    ACE_Arg_Shifter_T<ACE_TCHAR> shifter(argc, argv);
+    while (shifter.is_anything_left()) {
+      const ACE_TCHAR* currentArg = 0;
+      if ((currentArg = shifter.get_the_parameter(ACE_TEXT("-n"))) != 0) {
+        num_samples = ACE_OS::atoi(currentArg);
+        shifter.consume_arg();
+      } else if ((currentArg = shifter.get_the_parameter(ACE_TEXT("-t"))) != 0) {
+        timeout_sec = ACE_OS::atoi(currentArg);
+        shifter.consume_arg();
+      } else {
+        shifter.ignore_arg();
+      }
+    }
+
+    DDS::DomainParticipant_var participant =
+      dpf->create_participant(42,
+                              PARTICIPANT_QOS_DEFAULT,
+                              DDS::DomainParticipantListener::_nil(),
+                              OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+
+    if (CORBA::is_nil(participant.in())) {
+      ACE_ERROR_RETURN((LM_ERROR,
+                        ACE_TEXT("%N:%l main()")
+                        ACE_TEXT(" ERROR: create_participant() failed!\n")), -1);
+    }
+
+    Messenger::MessageTypeSupport_var ts =
+      new Messenger::MessageTypeSupportImpl();
+
+    if (ts->register_type(participant.in(), "") != DDS::RETCODE_OK) {
+      ACE_ERROR_RETURN((LM_ERROR,
+                        ACE_TEXT("%N:%l main()")
+                        ACE_TEXT(" ERROR: register_type() failed!\n")), -1);
+    }
+
+    CORBA::String_var type_name = ts->get_type_name();
+    DDS::Topic_var topic =
+      participant->create_topic("MulticastRepair",
+                                type_name.in(),
+                                TOPIC_QOS_DEFAULT,
+                                DDS::TopicListener::_nil(),
+                                OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+
+    DDS::Subscriber_var sub =
+      participant->create_subscriber(SUBSCRIBER_QOS_DEFAULT,
+                                     DDS::SubscriberListener::_nil(),
+                                     OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+
+    if (CORBA::is_nil(topic.in()) || CORBA::is_nil(sub.in())) {
+      ACE_ERROR_RETURN((LM_ERROR,
+                        ACE_TEXT("%N:%l main()")
+                        ACE_TEXT(" ERROR: create_topic() or create_subscriber() failed!\n")), -1);
+    }
+
+    DDS::DataReaderQos dr_qos;
+    sub->get_default_datareader_qos(dr_qos);
+    dr_qos.history.kind = DDS::KEEP_ALL_HISTORY_QOS;
+    dr_qos.reliability.kind = DDS::RELIABLE_RELIABILITY_QOS;
+
+    DDS::DataReader_var reader =
+      sub->create_datareader(topic.in(),
+                             dr_qos,
+                             DDS::DataReaderListener::_nil(),
+                             OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+
+    Messenger::MessageDataReader_var message_dr =
+      Messenger::MessageDataReader::_narrow(reader.in());
+
+    if (CORBA::is_nil(message_dr.in())) {
+      ACE_ERROR_RETURN((LM_ERROR,
+                        ACE_TEXT("%N:%l main()")
+                        ACE_TEXT(" ERROR: create_datareader() failed!\n")), -1);
+    }
+
+    DDS::ReadCondition_var condition =
+      reader->create_readcondition(DDS::ANY_SAMPLE_STATE,
+                                   DDS::ANY_VIEW_STATE,
+                                   DDS::ANY_INSTANCE_STATE);
+
+    DDS::WaitSet_var ws = new DDS::WaitSet;
+    ws->attach_condition(condition);
+
+    const DDS::Duration_t wait_timeout = { 1, 0 };
+    const ACE_Time_Value deadline =
+      ACE_OS::gettimeofday() + ACE_Time_Value(timeout_sec);
+
+    // Every sample must arrive exactly once and in order; the losses
+    // injected by the publishing transport are repaired by NAKs.
+    std::vector<bool> received(num_samples, false);
+    int count = 0;
+    int out_of_order = 0;
+    CORBA::Long last = -1;
+    DDS::ConditionSeq conditions;
+
+    while (count < num_samples && ACE_OS::gettimeofday() < deadline) {
+      Messenger::Message message;
+      DDS::SampleInfo si;
+      while (message_dr->take_next_sample(message, si) == DDS::RETCODE_OK) {
+        if (!si.valid_data) {
+          continue;
+        }
+        if (message.count < 0 || message.count >= num_samples ||
+            received[message.count]) {
+          std::cout << "ERROR: unexpected sample " << message.count << std::endl;
+          status = 1;
+          continue;
+        }
+        if (message.count < last) {
+          ++out_of_order;
+        }
+        last = message.count;
+        received[message.count] = true;
+        ++count;
+      }
+      ws->wait(conditions, wait_timeout);
+    }
+
+    std::cout << "received " << count << " of " << num_samples
+              << " samples, " << out_of_order << " out of order" << std::endl;
+    if (count != num_samples || out_of_order != 0) {
+      std::cout << "ERROR: samples were lost or reordered" << std::endl;
+      status = 1;
+    }
+
+    ws->detach_condition(condition);
+    reader->delete_readcondition(condition);
+
+    participant->delete_contained_entities();
+    dpf->delete_participant(participant.in());
+    TheServiceParticipant->shutdown();
+
+  } catch (const CORBA::Exception& e) {
+    e._tao_print_exception("Exception caught in main():");
+    status = 1;
+  }
+
+  return status;
+}
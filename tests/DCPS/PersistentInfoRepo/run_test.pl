@@ -26,6 +26,7 @@ my $nobit = 1; # Set to a non-zero value to disable the Builtin Topics.
 
 my $pub_ini = ' -DCPSConfigFile tcp.ini';
 my $sub_ini = ' -DCPSConfigFile tcp.ini';
+my $svc_conf = 'mySvc.conf';
 
 for my $arg (@ARGV) {
     if ($arg eq 'udp') {
@@ -53,6 +54,9 @@ for my $arg (@ARGV) {
         $logging_p .= " -verbose";
         $logging_s .= " -verbose";
     }
+    elsif ($arg eq 'wal') {
+        $svc_conf = 'walSvc.conf';
+    }
     elsif ($arg eq 'BIT' || $arg eq 'bit') {
         $nobit = 0;
     }
@@ -87,12 +91,13 @@ my $info_prst_file = "info.pr";
 
 unlink $dcpsrepo_ior;
 unlink $info_prst_file;
+unlink "info.wal.snapshot";
 unlink <*.log>;
 
 my $SRV_PORT = PerlACE::random_port();
 my $DCPSREPO = PerlDDS::create_process("$ENV{DDS_ROOT}/bin/DCPSInfoRepo",
                                        "$repo_bit_opt -o $dcpsrepo_ior "
-                                       . "-ORBSvcConf mySvc.conf "
+                                       . "-ORBSvcConf $svc_conf "
                                        . "-orbendpoint iiop://:$SRV_PORT ");
 
 my $Subscriber1 = PerlDDS::create_process("subscriber", $sub1_opts);
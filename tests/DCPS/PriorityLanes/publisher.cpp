@@ -0,0 +1,241 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+// Writes large bulk samples at TRANSPORT_PRIORITY 0 as fast as the link
+// accepts them, and small timestamped alarm samples at priority 1 in
+// between, over a tcp link that carries both.
+
+#include <ace/Arg_Shifter.h>
+#include <ace/Atomic_Op.h>
+#include <ace/Log_Msg.h>
+#include <ace/OS_NS_stdlib.h>
+#include <ace/OS_NS_sys_time.h>
+#include <ace/OS_NS_unistd.h>
+#include <ace/Task.h>
+
+#include <dds/DCPS/Marked_Default_Qos.h>
+#include <dds/DCPS/Service_Participant.h>
+#include "model/Sync.h"
+
+#include "dds/DCPS/StaticIncludes.h"
+
+#include "MessengerTypeSupportImpl.h"
+
+namespace {
+
+class BulkWriter : public ACE_Task_Base {
+public:
+  BulkWriter(Messenger::BulkDataWriter_ptr writer, size_t size)
+    : writer_(Messenger::BulkDataWriter::_duplicate(writer))
+    , size_(size)
+    , stop_(false)
+    , written_(0)
+  {}
+
+  int svc()
+  {
+    Messenger::Bulk bulk;
+    bulk.data.length(static_cast<CORBA::ULong>(size_));
+    for (CORBA::ULong i = 0; i < bulk.data.length(); ++i) {
+      bulk.data[i] = static_cast<CORBA::Octet>(i);
+    }
+
+    while (!stop_.value()) {
+      bulk.count = written_.value();
+      const ACE_Time_Value now = ACE_OS::gettimeofday();
+      bulk.sent_usec = CORBA::LongLong(now.sec()) * 1000000 + now.usec();
+      const DDS::ReturnCode_t error = writer_->write(bulk, DDS::HANDLE_NIL);
+      if (error == DDS::RETCODE_OK) {
+        ++written_;
+      } else if (error != DDS::RETCODE_TIMEOUT) {
+        ACE_ERROR_RETURN((LM_ERROR,
+                          ACE_TEXT("%N:%l BulkWriter::svc()")
+                          ACE_TEXT(" ERROR: write returned %d!\n"), error), -1);
+      }
+    }
+    return 0;
+  }
+
+  void stop() { stop_ = true; }
+
+  long written() const { return written_.value(); }
+
+private:
+  Messenger::BulkDataWriter_var writer_;
+  size_t size_;
+  ACE_Atomic_Op<ACE_Thread_Mutex, bool> stop_;
+  ACE_Atomic_Op<ACE_Thread_Mutex, long> written_;
+};
+
+}
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  int status = 0;
+  try {
+    DDS::DomainParticipantFactory_var dpf =
+      TheParticipantFactoryWithArgs(argc, argv);
+
+    int num_alarms = 200;
+    int interval_usec = 20000;
+    int bulk_size = 65536;
+    int bulk_depth = 64;
+    ACE_Arg_Shifter_T<ACE_TCHAR> shifter(argc, argv);
+    while (shifter.is_anything_left()) {
+      const ACE_TCHAR* currentArg = 0;
+      if ((currentArg = shifter.get_the_parameter(ACE_TEXT("-a"))) != 0) {
+        num_alarms = ACE_OS::atoi(currentArg);
+        shifter.consume_arg();
+      } else if ((currentArg = shifter.get_the_parameter(ACE_TEXT("-i"))) != 0) {
+        interval_usec = ACE_OS::atoi(currentArg);
+        shifter.consume_arg();
+      } else if ((currentArg = shifter.get_the_parameter(ACE_TEXT("-b"))) != 0) {
+        bulk_size = ACE_OS::atoi(currentArg);
+        shifter.consume_arg();
+      } else if ((currentArg = shifter.get_the_parameter(ACE_TEXT("-d"))) != 0) {
+        bulk_depth = ACE_OS::atoi(currentArg);
+        shifter.consume_arg();
+      } else {
+        shifter.ignore_arg();
+      }
+    }
+
+    DDS::DomainParticipant_var participant =
+      dpf->create_participant(42,
+                              PARTICIPANT_QOS_DEFAULT,
+                              DDS::DomainParticipantListener::_nil(),
+                              OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+
+    if (CORBA::is_nil(participant.in())) {
+      ACE_ERROR_RETURN((LM_ERROR,
+                        ACE_TEXT("%N:%l main()")
+                        ACE_TEXT(" ERROR: create_participant() failed!\n")), -1);
+    }
+
+    Messenger::AlarmTypeSupport_var alarm_ts =
+      new Messenger::AlarmTypeSupportImpl();
+    Messenger::BulkTypeSupport_var bulk_ts =
+      new Messenger::BulkTypeSupportImpl();
+
+    if (alarm_ts->register_type(participant.in(), "") != DDS::RETCODE_OK ||
+        bulk_ts->register_type(participant.in(), "") != DDS::RETCODE_OK) {
+      ACE_ERROR_RETURN((LM_ERROR,
+                        ACE_TEXT("%N:%l main()")
+                        ACE_TEXT(" ERROR: register_type() failed!\n")), -1);
+    }
+
+    CORBA::String_var alarm_type = alarm_ts->get_type_name();
+    CORBA::String_var bulk_type = bulk_ts->get_type_name();
+    DDS::Topic_var alarm_topic =
+      participant->create_topic("PriorityLanesAlarm",
+                                alarm_type.in(),
+                                TOPIC_QOS_DEFAULT,
+                                DDS::TopicListener::_nil(),
+                                OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+    DDS::Topic_var bulk_topic =
+      participant->create_topic("PriorityLanesBulk",
+                                bulk_type.in(),
+                                TOPIC_QOS_DEFAULT,
+                                DDS::TopicListener::_nil(),
+                                OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+
+    DDS::Publisher_var pub =
+      participant->create_publisher(PUBLISHER_QOS_DEFAULT,
+                                    DDS::PublisherListener::_nil(),
+                                    OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+
+    if (CORBA::is_nil(alarm_topic.in()) || CORBA::is_nil(bulk_topic.in()) ||
+        CORBA::is_nil(pub.in())) {
+      ACE_ERROR_RETURN((LM_ERROR,
+                        ACE_TEXT("%N:%l main()")
+                        ACE_TEXT(" ERROR: create_topic() or create_publisher() failed!\n")), -1);
+    }
+
+    DDS::DataWriterQos bulk_qos;
+    pub->get_default_datawriter_qos(bulk_qos);
+    bulk_qos.reliability.kind = DDS::RELIABLE_RELIABILITY_QOS;
+    bulk_qos.history.kind = DDS::KEEP_LAST_HISTORY_QOS;
+    bulk_qos.history.depth = bulk_depth;
+    bulk_qos.transport_priority.value = 0;
+
+    DDS::DataWriterQos alarm_qos;
+    pub->get_default_datawriter_qos(alarm_qos);
+    alarm_qos.reliability.kind = DDS::RELIABLE_RELIABILITY_QOS;
+    alarm_qos.history.kind = DDS::KEEP_ALL_HISTORY_QOS;
+    alarm_qos.transport_priority.value = 1;
+
+    DDS::DataWriter_var bulk_dw =
+      pub->create_datawriter(bulk_topic.in(),
+                             bulk_qos,
+                             DDS::DataWriterListener::_nil(),
+                             OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+    DDS::DataWriter_var alarm_dw =
+      pub->create_datawriter(alarm_topic.in(),
+                             alarm_qos,
+                             DDS::DataWriterListener::_nil(),
+                             OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+
+    Messenger::BulkDataWriter_var bulk_writer =
+      Messenger::BulkDataWriter::_narrow(bulk_dw.in());
+    Messenger::AlarmDataWriter_var alarm_writer =
+      Messenger::AlarmDataWriter::_narrow(alarm_dw.in());
+
+    if (CORBA::is_nil(bulk_writer.in()) || CORBA::is_nil(alarm_writer.in())) {
+      ACE_ERROR_RETURN((LM_ERROR,
+                        ACE_TEXT("%N:%l main()")
+                        ACE_TEXT(" ERROR: create_datawriter() failed!\n")), -1);
+    }
+
+    OpenDDS::Model::WriterSync::wait_match(bulk_dw);
+    OpenDDS::Model::WriterSync::wait_match(alarm_dw);
+
+    // Let the bulk writer fill the link before the first alarm.
+    BulkWriter bulk(bulk_writer.in(), bulk_size);
+    bulk.activate();
+    ACE_OS::sleep(1);
+
+    Messenger::Alarm alarm;
+    const ACE_Time_Value interval(0, interval_usec);
+    for (int i = 0; i < num_alarms; ++i) {
+      alarm.id = i;
+      const ACE_Time_Value now = ACE_OS::gettimeofday();
+      alarm.sent_usec = CORBA::LongLong(now.sec()) * 1000000 + now.usec();
+      DDS::ReturnCode_t error;
+      do {
+        error = alarm_writer->write(alarm, DDS::HANDLE_NIL);
+      } while (error == DDS::RETCODE_TIMEOUT);
+
+      if (error != DDS::RETCODE_OK) {
+        ACE_ERROR((LM_ERROR,
+                   ACE_TEXT("%N:%l main()")
+                   ACE_TEXT(" ERROR: write returned %d!\n"), error));
+        status = 1;
+        break;
+      }
+      ACE_OS::sleep(interval);
+    }
+
+    bulk.stop();
+    bulk.wait();
+    ACE_DEBUG((LM_INFO, ACE_TEXT("(%P|%t) wrote %d alarms and %d bulk samples\n"),
+               num_alarms, int(bulk.written())));
+
+    // The subscriber leaves once it has all of the alarms.
+    OpenDDS::Model::WriterSync::wait_unmatch(alarm_dw);
+
+    participant->delete_contained_entities();
+    dpf->delete_participant(participant.in());
+    TheServiceParticipant->shutdown();
+
+  } catch (const CORBA::Exception& e) {
+    e._tao_print_exception("Exception caught in main():");
+    status = 1;
+  }
+
+  return status;
+}
@@ -0,0 +1,69 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+    & eval 'exec perl -S $0 $argv:q'
+    if 0;
+
+# -*- perl -*-
+
+# A bulk writer at TRANSPORT_PRIORITY 0 saturates a tcp link while an
+# alarm writer at priority 1 sends a timestamped sample every 20ms.  The
+# subscriber reports the alarm latency.
+#
+#   run_test.pl [weighted|nolanes]
+#
+# By default both priorities share a connection with two strictly
+# ordered send lanes.  weighted gives the lanes weights of 1 and 4
+# instead, and nolanes keeps the usual connection per priority for
+# comparison.
+
+use Env (DDS_ROOT);
+use lib "$DDS_ROOT/bin";
+use Env (ACE_ROOT);
+use lib "$ACE_ROOT/bin";
+use PerlDDS::Run_Test;
+use strict;
+
+my $test = new PerlDDS::TestFramework();
+
+$test->{dcps_transport_debug_level} = 2;
+$test->{add_transport_config} = 0;
+
+my $alarms = 200;
+my $lanes = "send_lanes=2\n";
+$lanes .= "send_lane_weights=1,4\n" if $test->flag('weighted');
+$lanes = "send_lanes=1\n" if $test->flag('nolanes');
+
+# With lanes, the alarms must come out ahead of the bulk samples.
+my $check = $test->flag('nolanes') ? '' : ' -c';
+
+my $ini = 'lanes.ini';
+open(my $fh, '>', $ini) or die "Open $ini failed: $!";
+print $fh "[common]\n" .
+  "DCPSGlobalTransportConfig=\$file\n\n" .
+  "[transport/tcp]\n" .
+  "transport_type=tcp\n" .
+  $lanes;
+close $fh;
+
+unlink 'pub.log', 'sub.log';
+
+$test->setup_discovery();
+
+$test->process('sub', 'subscriber',
+               "-DCPSConfigFile $ini -ORBLogFile sub.log -a $alarms$check");
+$test->process('pub', 'publisher',
+               "-DCPSConfigFile $ini -ORBLogFile pub.log -a $alarms");
+$test->start_process('sub');
+$test->start_process('pub');
+
+my $status = $test->finish(300);
+
+# Packets built from each lane while the link was backpressured.
+if (open(my $log, '<', 'pub.log')) {
+  while (<$log>) {
+    print "publisher: $1\n" if /(send lane \d+ queued packets: \d+)/;
+  }
+  close $log;
+}
+
+unlink $ini;
+exit $status;
@@ -0,0 +1,227 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include <ace/Arg_Shifter.h>
+#include <ace/Log_Msg.h>
+#include <ace/OS_NS_stdlib.h>
+#include <ace/OS_NS_sys_time.h>
+
+#include <dds/DCPS/Marked_Default_Qos.h>
+#include <dds/DCPS/Service_Participant.h>
+#include <dds/DCPS/WaitSet.h>
+
+#include "dds/DCPS/StaticIncludes.h"
+
+#include "MessengerTypeSupportImpl.h"
+
+#include <iostream>
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  int status = 0;
+  try {
+    DDS::DomainParticipantFactory_var dpf =
+      TheParticipantFactoryWithArgs(argc, argv);
+
+    int num_alarms = 200;
+    int timeout_sec = 120;
+    bool check_ahead = false;
+    ACE_Arg_Shifter_T<ACE_TCHAR> shifter(argc, argv);
+    while (shifter.is_anything_left()) {
+      const ACE_TCHAR* currentArg = 0;
+      if ((currentArg = shifter.get_the_parameter(ACE_TEXT("-a"))) != 0) {
+        num_alarms = ACE_OS::atoi(currentArg);
+        shifter.consume_arg();
+      } else if ((currentArg = shifter.get_the_parameter(ACE_TEXT("-t"))) != 0) {
+        timeout_sec = ACE_OS::atoi(currentArg);
+        shifter.consume_arg();
+      } else if (shifter.cur_arg_strncasecmp(ACE_TEXT("-c")) == 0) {
+        check_ahead = true;
+        shifter.consume_arg();
+      } else {
+        shifter.ignore_arg();
+      }
+    }
+
+    DDS::DomainParticipant_var participant =
+      dpf->create_participant(42,
+                              PARTICIPANT_QOS_DEFAULT,
+                              DDS::DomainParticipantListener::_nil(),
+                              OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+
+    if (CORBA::is_nil(participant.in())) {
+      ACE_ERROR_RETURN((LM_ERROR,
+                        ACE_TEXT("%N:%l main()")
+                        ACE_TEXT(" ERROR: create_participant() failed!\n")), -1);
+    }
+
+    Messenger::AlarmTypeSupport_var alarm_ts =
+      new Messenger::AlarmTypeSupportImpl();
+    Messenger::BulkTypeSupport_var bulk_ts =
+      new Messenger::BulkTypeSupportImpl();
+
+    if (alarm_ts->register_type(participant.in(), "") != DDS::RETCODE_OK ||
+        bulk_ts->register_type(participant.in(), "") != DDS::RETCODE_OK) {
+      ACE_ERROR_RETURN((LM_ERROR,
+                        ACE_TEXT("%N:%l main()")
+                        ACE_TEXT(" ERROR: register_type() failed!\n")), -1);
+    }
+
+    CORBA::String_var alarm_type = alarm_ts->get_type_name();
+    CORBA::String_var bulk_type = bulk_ts->get_type_name();
+    DDS::Topic_var alarm_topic =
+      participant->create_topic("PriorityLanesAlarm",
+                                alarm_type.in(),
+                                TOPIC_QOS_DEFAULT,
+                                DDS::TopicListener::_nil(),
+                                OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+    DDS::Topic_var bulk_topic =
+      participant->create_topic("PriorityLanesBulk",
+                                bulk_type.in(),
+                                TOPIC_QOS_DEFAULT,
+                                DDS::TopicListener::_nil(),
+                                OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+
+    DDS::Subscriber_var sub =
+      participant->create_subscriber(SUBSCRIBER_QOS_DEFAULT,
+                                     DDS::SubscriberListener::_nil(),
+                                     OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+
+    if (CORBA::is_nil(alarm_topic.in()) || CORBA::is_nil(bulk_topic.in()) ||
+        CORBA::is_nil(sub.in())) {
+      ACE_ERROR_RETURN((LM_ERROR,
+                        ACE_TEXT("%N:%l main()")
+                        ACE_TEXT(" ERROR: create_topic() or create_subscriber() failed!\n")), -1);
+    }
+
+    DDS::DataReaderQos dr_qos;
+    sub->get_default_datareader_qos(dr_qos);
+    dr_qos.history.kind = DDS::KEEP_ALL_HISTORY_QOS;
+    dr_qos.reliability.kind = DDS::RELIABLE_RELIABILITY_QOS;
+
+    DDS::DataReader_var alarm_dr =
+      sub->create_datareader(alarm_topic.in(),
+                             dr_qos,
+                             DDS::DataReaderListener::_nil(),
+                             OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+    DDS::DataReader_var bulk_dr =
+      sub->create_datareader(bulk_topic.in(),
+                             dr_qos,
+                             DDS::DataReaderListener::_nil(),
+                             OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+
+    Messenger::AlarmDataReader_var alarm_reader =
+      Messenger::AlarmDataReader::_narrow(alarm_dr.in());
+    Messenger::BulkDataReader_var bulk_reader =
+      Messenger::BulkDataReader::_narrow(bulk_dr.in());
+
+    if (CORBA::is_nil(alarm_reader.in()) || CORBA::is_nil(bulk_reader.in())) {
+      ACE_ERROR_RETURN((LM_ERROR,
+                        ACE_TEXT("%N:%l main()")
+                        ACE_TEXT(" ERROR: create_datareader() failed!\n")), -1);
+    }
+
+    DDS::ReadCondition_var alarm_condition =
+      alarm_dr->create_readcondition(DDS::ANY_SAMPLE_STATE,
+                                     DDS::ANY_VIEW_STATE,
+                                     DDS::ANY_INSTANCE_STATE);
+    DDS::ReadCondition_var bulk_condition =
+      bulk_dr->create_readcondition(DDS::ANY_SAMPLE_STATE,
+                                    DDS::ANY_VIEW_STATE,
+                                    DDS::ANY_INSTANCE_STATE);
+
+    DDS::WaitSet_var ws = new DDS::WaitSet;
+    ws->attach_condition(alarm_condition);
+    ws->attach_condition(bulk_condition);
+
+    const DDS::Duration_t wait_timeout = { 1, 0 };
+    const ACE_Time_Value deadline =
+      ACE_OS::gettimeofday() + ACE_Time_Value(timeout_sec);
+
+    // Latencies are measured from the publisher's write to the take
+    // here; both run on the same host.
+    int alarms = 0;
+    long bulk_samples = 0;
+    CORBA::LongLong total_usec = 0;
+    CORBA::LongLong max_usec = 0;
+    CORBA::LongLong bulk_total_usec = 0;
+    DDS::ConditionSeq conditions;
+
+    while (alarms < num_alarms && ACE_OS::gettimeofday() < deadline) {
+      ws->wait(conditions, wait_timeout);
+
+      Messenger::Alarm alarm;
+      DDS::SampleInfo si;
+      while (alarm_reader->take_next_sample(alarm, si) == DDS::RETCODE_OK) {
+        if (!si.valid_data) {
+          continue;
+        }
+        const ACE_Time_Value now = ACE_OS::gettimeofday();
+        const CORBA::LongLong latency =
+          CORBA::LongLong(now.sec()) * 1000000 + now.usec() - alarm.sent_usec;
+        total_usec += latency;
+        if (latency > max_usec) {
+          max_usec = latency;
+        }
+        ++alarms;
+      }
+
+      Messenger::BulkSeq bulk;
+      DDS::SampleInfoSeq infos;
+      if (bulk_reader->take(bulk, infos, DDS::LENGTH_UNLIMITED,
+                            DDS::ANY_SAMPLE_STATE, DDS::ANY_VIEW_STATE,
+                            DDS::ANY_INSTANCE_STATE) == DDS::RETCODE_OK) {
+        const ACE_Time_Value now = ACE_OS::gettimeofday();
+        const CORBA::LongLong now_usec =
+          CORBA::LongLong(now.sec()) * 1000000 + now.usec();
+        for (CORBA::ULong i = 0; i < bulk.length(); ++i) {
+          if (infos[i].valid_data) {
+            bulk_total_usec += now_usec - bulk[i].sent_usec;
+            ++bulk_samples;
+          }
+        }
+        bulk_reader->return_loan(bulk, infos);
+      }
+    }
+
+    const CORBA::LongLong alarm_avg_usec = alarms ? total_usec / alarms : 0;
+    const CORBA::LongLong bulk_avg_usec =
+      bulk_samples ? bulk_total_usec / bulk_samples : 0;
+    std::cout << "received " << alarms << " of " << num_alarms
+              << " alarms and " << bulk_samples << " bulk samples, alarm latency"
+              << " avg " << alarm_avg_usec << " usec"
+              << " max " << max_usec << " usec, bulk latency avg "
+              << bulk_avg_usec << " usec" << std::endl;
+    if (alarms != num_alarms) {
+      std::cout << "ERROR: alarms were lost" << std::endl;
+      status = 1;
+    }
+    // The alarms are queued in the higher lane, so they must overtake the
+    // bulk samples queued ahead of them on the saturated link.
+    if (check_ahead && (bulk_samples == 0 || alarm_avg_usec >= bulk_avg_usec)) {
+      std::cout << "ERROR: the alarm lane did not come out ahead of the "
+                << "bulk lane" << std::endl;
+      status = 1;
+    }
+
+    ws->detach_condition(alarm_condition);
+    ws->detach_condition(bulk_condition);
+    alarm_dr->delete_readcondition(alarm_condition);
+    bulk_dr->delete_readcondition(bulk_condition);
+
+    participant->delete_contained_entities();
+    dpf->delete_participant(participant.in());
+    TheServiceParticipant->shutdown();
+
+  } catch (const CORBA::Exception& e) {
+    e._tao_print_exception("Exception caught in main():");
+    status = 1;
+  }
+
+  return status;
+}
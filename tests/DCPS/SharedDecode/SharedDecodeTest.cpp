@@ -0,0 +1,377 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+// Readers that share one DataLink share the demarshaled samples of their
+// writer (see SharedDecode).  Three readers of one topic, one of them
+// content filtered and one with a deadline (which looks up the instance
+// of each dispose and unregister before storing it), and a reader of a
+// topic of another type all receive through the one tcp link between two
+// participants.  The writers write samples of different sizes, which the
+// filtered reader is the first to demarshal and rejects in part, then
+// dispose and unregister instances, whose key-only samples are shared
+// too.  Each reader must end up with exactly the samples and instance
+// states it would have without the sharing.
+
+#include "SharedDecodeTypeSupportImpl.h"
+
+#include "dds/DCPS/Marked_Default_Qos.h"
+#include "dds/DCPS/Service_Participant.h"
+#include "dds/DCPS/transport/framework/TransportRegistry.h"
+
+#include "dds/DCPS/StaticIncludes.h"
+#ifdef ACE_AS_STATIC_LIBS
+#include "dds/DCPS/RTPS/RtpsDiscovery.h"
+#include "dds/DCPS/transport/tcp/Tcp.h"
+#endif
+
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_sys_time.h"
+#include "ace/OS_NS_unistd.h"
+
+#include <map>
+#include <vector>
+
+using namespace DDS;
+using OpenDDS::DCPS::DEFAULT_STATUS_MASK;
+using SharedDecodeTest::Report;
+using SharedDecodeTest::Status;
+
+namespace {
+
+const DomainId_t domain = 53;
+const int timeout_sec = 60;
+
+Report make_report(CORBA::Long id, int revision)
+{
+  Report report;
+  report.id = id;
+  char text[64];
+  ACE_OS::snprintf(text, sizeof text, "report %d revision %d", id, revision);
+  report.text = text;
+  // Of different lengths, so the samples are too.
+  report.values.length(id % 7 + revision * 50);
+  for (CORBA::ULong i = 0; i < report.values.length(); ++i) {
+    report.values[i] = id * 1000 + revision * 100 + i;
+  }
+  return report;
+}
+
+bool same(const Report& a, const Report& b)
+{
+  if (a.id != b.id || ACE_OS::strcmp(a.text.in(), b.text.in()) ||
+      a.values.length() != b.values.length()) {
+    return false;
+  }
+  for (CORBA::ULong i = 0; i < a.values.length(); ++i) {
+    if (a.values[i] != b.values[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// A reader of the reports, the samples it should receive, and the
+/// states their instances should end in.
+struct ReportReader {
+  const char* name_;
+  SharedDecodeTest::ReportDataReader_var reader_;
+  std::vector<Report> expected_;
+  std::map<CORBA::Long, InstanceStateKind> states_;
+
+  /// Does the reader have as many samples as expected, in the expected
+  /// instance states?  Errors are logged if @a verify is set.
+  bool check(bool verify)
+  {
+    SharedDecodeTest::ReportSeq reports;
+    SampleInfoSeq infos;
+    const ReturnCode_t ret = reader_->read(reports, infos, LENGTH_UNLIMITED,
+                                           ANY_SAMPLE_STATE, ANY_VIEW_STATE,
+                                           ANY_INSTANCE_STATE);
+    if (ret != RETCODE_OK && ret != RETCODE_NO_DATA) {
+      if (verify) {
+        ACE_ERROR((LM_ERROR, "ERROR: %C: read failed: %d\n", name_, ret));
+      }
+      return false;
+    }
+
+    bool ok = true;
+    std::vector<Report> unmatched = expected_;
+    std::map<CORBA::Long, InstanceStateKind> states;
+    for (CORBA::ULong i = 0; i < infos.length(); ++i) {
+      Report key;
+      if (reader_->get_key_value(key, infos[i].instance_handle) != RETCODE_OK) {
+        if (verify) {
+          ACE_ERROR((LM_ERROR, "ERROR: %C: no key for an instance\n", name_));
+        }
+        ok = false;
+        continue;
+      }
+      states[key.id] = infos[i].instance_state;
+      if (!infos[i].valid_data) {
+        continue;
+      }
+      if (reports[i].id != key.id) {
+        if (verify) {
+          ACE_ERROR((LM_ERROR, "ERROR: %C: report %d in the instance of %d\n",
+                     name_, reports[i].id, key.id));
+        }
+        ok = false;
+      }
+      bool found = false;
+      for (size_t j = 0; !found && j < unmatched.size(); ++j) {
+        if (same(reports[i], unmatched[j])) {
+          unmatched.erase(unmatched.begin() + j);
+          found = true;
+        }
+      }
+      if (!found) {
+        if (verify) {
+          ACE_ERROR((LM_ERROR, "ERROR: %C: unexpected sample \"%C\" with %u values\n",
+                     name_, reports[i].text.in(), reports[i].values.length()));
+        }
+        ok = false;
+      }
+    }
+    reader_->return_loan(reports, infos);
+
+    if (!unmatched.empty()) {
+      if (verify) {
+        ACE_ERROR((LM_ERROR, "ERROR: %C: %B samples missing, the first \"%C\"\n",
+                   name_, unmatched.size(), unmatched[0].text.in()));
+      }
+      ok = false;
+    }
+    if (states != states_) {
+      if (verify) {
+        ACE_ERROR((LM_ERROR, "ERROR: %C: %B instances, %B expected, or in other states\n",
+                   name_, states.size(), states_.size()));
+      }
+      ok = false;
+    }
+    return ok;
+  }
+};
+
+template <typename Writer>
+bool wait_matched(const Writer& writer, int readers)
+{
+  const ACE_Time_Value deadline =
+    ACE_OS::gettimeofday() + ACE_Time_Value(timeout_sec);
+  PublicationMatchedStatus status;
+  while (writer->get_publication_matched_status(status) == RETCODE_OK &&
+         status.current_count < readers) {
+    if (ACE_OS::gettimeofday() > deadline) {
+      return false;
+    }
+    ACE_OS::sleep(ACE_Time_Value(0, 100000));
+  }
+  return true;
+}
+
+}
+
+int ACE_TMAIN(int argc, ACE_TCHAR* argv[])
+{
+  int status = 0;
+  try {
+    DomainParticipantFactory_var dpf = TheParticipantFactoryWithArgs(argc, argv);
+
+    DomainParticipant_var pub_participant =
+      dpf->create_participant(domain, PARTICIPANT_QOS_DEFAULT, 0, DEFAULT_STATUS_MASK);
+    DomainParticipant_var sub_participant =
+      dpf->create_participant(domain, PARTICIPANT_QOS_DEFAULT, 0, DEFAULT_STATUS_MASK);
+    if (!pub_participant || !sub_participant) {
+      ACE_ERROR_RETURN((LM_ERROR, "ERROR: create_participant failed\n"), 1);
+    }
+    // Each participant has its own tcp transport instance, so every
+    // reader receives through the one DataLink to the writers.
+    TheTransportRegistry->bind_config("pub", pub_participant);
+    TheTransportRegistry->bind_config("sub", sub_participant);
+
+    SharedDecodeTest::ReportTypeSupport_var report_ts =
+      new SharedDecodeTest::ReportTypeSupportImpl;
+    SharedDecodeTest::StatusTypeSupport_var status_ts =
+      new SharedDecodeTest::StatusTypeSupportImpl;
+    if (report_ts->register_type(pub_participant, "") != RETCODE_OK ||
+        report_ts->register_type(sub_participant, "") != RETCODE_OK ||
+        status_ts->register_type(pub_participant, "") != RETCODE_OK ||
+        status_ts->register_type(sub_participant, "") != RETCODE_OK) {
+      ACE_ERROR_RETURN((LM_ERROR, "ERROR: register_type failed\n"), 1);
+    }
+    const CORBA::String_var report_type = report_ts->get_type_name();
+    const CORBA::String_var status_type = status_ts->get_type_name();
+
+    Topic_var pub_reports = pub_participant->create_topic(
+      "Reports", report_type, TOPIC_QOS_DEFAULT, 0, DEFAULT_STATUS_MASK);
+    Topic_var pub_statuses = pub_participant->create_topic(
+      "Statuses", status_type, TOPIC_QOS_DEFAULT, 0, DEFAULT_STATUS_MASK);
+    Topic_var sub_reports = sub_participant->create_topic(
+      "Reports", report_type, TOPIC_QOS_DEFAULT, 0, DEFAULT_STATUS_MASK);
+    Topic_var sub_statuses = sub_participant->create_topic(
+      "Statuses", status_type, TOPIC_QOS_DEFAULT, 0, DEFAULT_STATUS_MASK);
+    ContentFilteredTopic_var high_reports = sub_participant->create_contentfilteredtopic(
+      "HighReports", sub_reports, "id > 100", StringSeq());
+    Publisher_var pub = pub_participant->create_publisher(
+      PUBLISHER_QOS_DEFAULT, 0, DEFAULT_STATUS_MASK);
+    Subscriber_var sub = sub_participant->create_subscriber(
+      SUBSCRIBER_QOS_DEFAULT, 0, DEFAULT_STATUS_MASK);
+    if (!pub_reports || !pub_statuses || !sub_reports || !sub_statuses ||
+        !high_reports || !pub || !sub) {
+      ACE_ERROR_RETURN((LM_ERROR, "ERROR: failed to create the topics, "
+                        "publisher or subscriber\n"), 1);
+    }
+
+    DataReaderQos dr_qos;
+    sub->get_default_datareader_qos(dr_qos);
+    dr_qos.history.kind = KEEP_ALL_HISTORY_QOS;
+    dr_qos.reliability.kind = RELIABLE_RELIABILITY_QOS;
+    DataReaderQos deadline_qos = dr_qos;
+    deadline_qos.deadline.period.sec = 3600;
+    deadline_qos.deadline.period.nanosec = 0;
+
+    // The readers are delivered to in the order of their ids, so the
+    // filtered reader, created first, demarshals each report first.
+    ReportReader readers[3];
+    readers[0].name_ = "filtered";
+    readers[1].name_ = "deadline";
+    readers[2].name_ = "full";
+    DataReader_var filtered = sub->create_datareader(
+      high_reports, dr_qos, 0, DEFAULT_STATUS_MASK);
+    DataReader_var deadline = sub->create_datareader(
+      sub_reports, deadline_qos, 0, DEFAULT_STATUS_MASK);
+    DataReader_var full = sub->create_datareader(
+      sub_reports, dr_qos, 0, DEFAULT_STATUS_MASK);
+    DataReader_var statuses = sub->create_datareader(
+      sub_statuses, dr_qos, 0, DEFAULT_STATUS_MASK);
+    readers[0].reader_ = SharedDecodeTest::ReportDataReader::_narrow(filtered);
+    readers[1].reader_ = SharedDecodeTest::ReportDataReader::_narrow(deadline);
+    readers[2].reader_ = SharedDecodeTest::ReportDataReader::_narrow(full);
+    SharedDecodeTest::StatusDataReader_var status_reader =
+      SharedDecodeTest::StatusDataReader::_narrow(statuses);
+    if (!readers[0].reader_ || !readers[1].reader_ || !readers[2].reader_ ||
+        !status_reader) {
+      ACE_ERROR_RETURN((LM_ERROR, "ERROR: create_datareader failed\n"), 1);
+    }
+
+    DataWriter_var report_dw = pub->create_datawriter(
+      pub_reports, DATAWRITER_QOS_DEFAULT, 0, DEFAULT_STATUS_MASK);
+    DataWriter_var status_dw = pub->create_datawriter(
+      pub_statuses, DATAWRITER_QOS_DEFAULT, 0, DEFAULT_STATUS_MASK);
+    SharedDecodeTest::ReportDataWriter_var report_writer =
+      SharedDecodeTest::ReportDataWriter::_narrow(report_dw);
+    SharedDecodeTest::StatusDataWriter_var status_writer =
+      SharedDecodeTest::StatusDataWriter::_narrow(status_dw);
+    if (!report_writer || !status_writer) {
+      ACE_ERROR_RETURN((LM_ERROR, "ERROR: create_datawriter failed\n"), 1);
+    }
+    if (!wait_matched(report_writer, 3) || !wait_matched(status_writer, 1)) {
+      ACE_ERROR_RETURN((LM_ERROR, "ERROR: the readers did not match\n"), 1);
+    }
+
+    // The reports, interleaved with the statuses on the same link.
+    const CORBA::Long ids[] = { 1, 2, 101, 102 };
+    std::vector<Status> written_statuses;
+    for (size_t i = 0; i < sizeof ids / sizeof ids[0]; ++i) {
+      const Report report = make_report(ids[i], 0);
+      report_writer->write(report, HANDLE_NIL);
+      for (size_t r = 0; r < 3; ++r) {
+        if (r > 0 || ids[i] > 100) {
+          readers[r].expected_.push_back(report);
+        }
+      }
+
+      Status level;
+      level.name = i % 2 ? "valve" : "pump";
+      level.level = 0.5 + i;
+      status_writer->write(level, HANDLE_NIL);
+      written_statuses.push_back(level);
+    }
+    const Report revised = make_report(101, 1);
+    report_writer->write(revised, HANDLE_NIL);
+    for (size_t r = 0; r < 3; ++r) {
+      readers[r].expected_.push_back(revised);
+    }
+
+    // Dispose and unregister messages carry only the key.
+    report_writer->dispose(make_report(2, 0), HANDLE_NIL);
+    report_writer->dispose(make_report(102, 0), HANDLE_NIL);
+    report_writer->unregister_instance(make_report(1, 0), HANDLE_NIL);
+
+    readers[0].states_[101] = ALIVE_INSTANCE_STATE;
+    readers[0].states_[102] = NOT_ALIVE_DISPOSED_INSTANCE_STATE;
+    for (size_t r = 1; r < 3; ++r) {
+      readers[r].states_[1] = NOT_ALIVE_NO_WRITERS_INSTANCE_STATE;
+      readers[r].states_[2] = NOT_ALIVE_DISPOSED_INSTANCE_STATE;
+      readers[r].states_[101] = ALIVE_INSTANCE_STATE;
+      readers[r].states_[102] = NOT_ALIVE_DISPOSED_INSTANCE_STATE;
+    }
+
+    const ACE_Time_Value deadline_time =
+      ACE_OS::gettimeofday() + ACE_Time_Value(timeout_sec);
+    bool done = false;
+    while (!done && ACE_OS::gettimeofday() < deadline_time) {
+      done = readers[0].check(false) && readers[1].check(false) &&
+        readers[2].check(false);
+      if (!done) {
+        ACE_OS::sleep(ACE_Time_Value(0, 100000));
+      }
+    }
+    for (size_t r = 0; r < 3; ++r) {
+      if (!readers[r].check(true)) {
+        status = 1;
+      }
+    }
+
+    // The statuses, of the other type.
+    SharedDecodeTest::StatusSeq received;
+    SampleInfoSeq infos;
+    std::vector<Status> unmatched = written_statuses;
+    while (!unmatched.empty() && ACE_OS::gettimeofday() < deadline_time) {
+      if (status_reader->take(received, infos, LENGTH_UNLIMITED, ANY_SAMPLE_STATE,
+                              ANY_VIEW_STATE, ANY_INSTANCE_STATE) != RETCODE_OK) {
+        ACE_OS::sleep(ACE_Time_Value(0, 100000));
+        continue;
+      }
+      for (CORBA::ULong i = 0; i < infos.length(); ++i) {
+        if (!infos[i].valid_data) {
+          continue;
+        }
+        bool found = false;
+        for (size_t j = 0; !found && j < unmatched.size(); ++j) {
+          if (!ACE_OS::strcmp(received[i].name.in(), unmatched[j].name.in()) &&
+              received[i].level == unmatched[j].level) {
+            unmatched.erase(unmatched.begin() + j);
+            found = true;
+          }
+        }
+        if (!found) {
+          ACE_ERROR((LM_ERROR, "ERROR: unexpected status %C %f\n",
+                     received[i].name.in(), received[i].level));
+          status = 1;
+        }
+      }
+      status_reader->return_loan(received, infos);
+    }
+    if (!unmatched.empty()) {
+      ACE_ERROR((LM_ERROR, "ERROR: %B statuses missing\n", unmatched.size()));
+      status = 1;
+    }
+
+    pub_participant->delete_contained_entities();
+    sub_participant->delete_contained_entities();
+    dpf->delete_participant(pub_participant);
+    dpf->delete_participant(sub_participant);
+    TheServiceParticipant->shutdown();
+
+  } catch (const CORBA::Exception& e) {
+    e._tao_print_exception("Exception caught in main():");
+    status = 1;
+  }
+
+  return status;
+}
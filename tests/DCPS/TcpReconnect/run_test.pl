@@ -33,6 +33,11 @@ if ($test->flag('thread_per')) {
     $thread_per_connection = " -p ";
 }
 
+# storm: drop hundreds of striped connections at once and measure the
+# recovery time and the number of threads used while reconnecting.
+my $storm = $test->flag('storm');
+my $storm_writers = 512;
+
 #
 # stub parameters
 #
@@ -72,26 +77,42 @@ my $resub = "[common]\n" .
     "local_address=$stubSubSideHost:$stubSubSidePort\n" .
     "pub_address=$stubPubSideHost:$stubPubSidePort\n";
 
+if ($storm) {
+    $resub .= "conn_stripes=$storm_writers\n";
+    open(my $pfh, '>', 'storm_pub.ini');
+    print $pfh "[common]\n" .
+        "DCPSGlobalTransportConfig=\$file\n\n" .
+        "[transport/t1]\n" .
+        "transport_type=tcp\n" .
+        "datalink_release_delay=60000\n" .
+        "conn_retry_initial_delay=250\n" .
+        "conn_retry_backoff_multiplier=1.5\n" .
+        "conn_retry_attempts=20\n" .
+        "conn_stripes=$storm_writers\n";
+    close $pfh;
+}
+
 open(my $fh, '>', 'resub.ini');
 print $fh $resub;
 close $fh;
 
-$pub_opts .= ' -DCPSConfigFile repub.ini';
+$pub_opts .= $storm ? ' -DCPSConfigFile storm_pub.ini' : ' -DCPSConfigFile repub.ini';
 $sub_opts .= ' -DCPSConfigFile resub.ini';
-$sub_opts .= " -k $stubKillCount -d $stubKillDelay";
+$sub_opts .= $storm ? " -n $storm_writers" : " -k $stubKillCount -d $stubKillDelay";
 
 #clean up files left from previous run
 my $stub_ready = 'stub_ready.txt';
 unlink $stub_ready;
 
 $pub_opts .= $thread_per_connection;
-$pub_opts .= " -stubCmd $stubCmd $stubArgs -stub_ready_file $stub_ready -k $stubKillCount -d $stubKillDelay";
+$pub_opts .= " -stubCmd $stubCmd $stubArgs -stub_ready_file $stub_ready";
+$pub_opts .= $storm ? " -n $storm_writers" : " -k $stubKillCount -d $stubKillDelay";
 
 $test->setup_discovery("-NOBITS -ORBDebugLevel 1 -ORBLogFile DCPSInfoRepo.log " .
                        "$repo_bit_opt");
 
-$test->process("publisher", "publisher", $pub_opts);
-$test->process("subscriber", "subscriber", $sub_opts);
+$test->process("publisher", $storm ? "storm_publisher" : "publisher", $pub_opts);
+$test->process("subscriber", $storm ? "storm_subscriber" : "subscriber", $sub_opts);
 
 $test->start_process("subscriber");
 $test->start_process("publisher");
@@ -105,8 +126,9 @@ $test->ignore_error("Failed to connect. connect: Connection refused");
 $test->ignore_error("Unrecoverable problem with data link detected");
 
 # start killing processes in 60 seconds
-my $fin = $test->finish(60);
+my $fin = $test->finish($storm ? 180 : 60);
 
 unlink $stub_ready;
 unlink 'resub.ini';
+unlink 'storm_pub.ini';
 exit $fin;
@@ -0,0 +1,351 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+// Reconnect storm: many tcp connections (one per stripe, see conn_stripes)
+// run through the stub, which is killed so that they all drop at once.
+// Measures how long it takes until every DataWriter's sample is
+// acknowledged again, and how many threads the process needs meanwhile.
+
+#include <ace/Arg_Shifter.h>
+#include <ace/Log_Msg.h>
+#include <ace/OS_NS_stdio.h>
+#include <ace/OS_NS_stdlib.h>
+#include <ace/OS_NS_string.h>
+#include <ace/OS_NS_sys_time.h>
+#include <ace/OS_NS_unistd.h>
+#include <ace/Process.h>
+#include <ace/Task.h>
+
+#include <dds/DCPS/Marked_Default_Qos.h>
+#include <dds/DCPS/Service_Participant.h>
+#include "model/Sync.h"
+
+#include "dds/DCPS/StaticIncludes.h"
+
+#include "MessengerTypeSupportImpl.h"
+
+#include <iostream>
+#include <vector>
+
+namespace {
+
+/// Number of threads in this process, or 0 where it can't be determined.
+long thread_count()
+{
+#ifdef ACE_LINUX
+  FILE* status = ACE_OS::fopen("/proc/self/status", "r");
+  if (status == 0) {
+    return 0;
+  }
+  char line[256];
+  long threads = 0;
+  while (ACE_OS::fgets(line, sizeof line, status)) {
+    if (ACE_OS::strncmp(line, "Threads:", 8) == 0) {
+      threads = ACE_OS::atoi(line + 8);
+      break;
+    }
+  }
+  ACE_OS::fclose(status);
+  return threads;
+#else
+  return 0;
+#endif
+}
+
+/// Samples the thread count until stopped and keeps the peak.
+class ThreadSampler : public ACE_Task_Base {
+public:
+  ThreadSampler() : done_(false), peak_(0) {}
+
+  int svc()
+  {
+    while (!done_.value()) {
+      const long threads = thread_count();
+      if (threads > peak_.value()) {
+        peak_ = threads;
+      }
+      ACE_OS::sleep(ACE_Time_Value(0, 10000));
+    }
+    return 0;
+  }
+
+  long stop()
+  {
+    done_ = true;
+    wait();
+    // Don't count the sampler itself.
+    return peak_.value() - 1;
+  }
+
+private:
+  ACE_Atomic_Op<ACE_SYNCH_MUTEX, bool> done_;
+  ACE_Atomic_Op<ACE_SYNCH_MUTEX, long> peak_;
+};
+
+bool write_all(const std::vector<Messenger::MessageDataWriter_var>& writers,
+               CORBA::Long phase)
+{
+  for (size_t i = 0; i < writers.size(); ++i) {
+    Messenger::Message message;
+    message.from = "Comic Book Guy";
+    message.subject = "Review";
+    message.subject_id = static_cast<CORBA::Long>(i);
+    message.text = "Worst. Movie. Ever.";
+    message.count = 0;
+    message.phase_number = phase;
+
+    DDS::ReturnCode_t error;
+    do {
+      error = writers[i]->write(message, DDS::HANDLE_NIL);
+    } while (error == DDS::RETCODE_TIMEOUT);
+
+    if (error != DDS::RETCODE_OK) {
+      ACE_ERROR_RETURN((LM_ERROR,
+                        ACE_TEXT("%N:%l: write_all()")
+                        ACE_TEXT(" ERROR: write returned %d!\n"), error),
+                       false);
+    }
+  }
+  return true;
+}
+
+bool wait_for_acks(const std::vector<Messenger::MessageDataWriter_var>& writers,
+                   const ACE_Time_Value& deadline)
+{
+  for (size_t i = 0; i < writers.size(); ++i) {
+    const ACE_Time_Value left = deadline - ACE_OS::gettimeofday();
+    if (left <= ACE_Time_Value::zero) {
+      return false;
+    }
+    const DDS::Duration_t timeout = { static_cast<CORBA::Long>(left.sec()),
+                                      static_cast<CORBA::ULong>(left.usec() * 1000) };
+    if (writers[i]->wait_for_acknowledgments(timeout) != DDS::RETCODE_OK) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}
+
+int ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  int status = 0;
+  ACE_Process process;
+
+  try {
+    int num_writers = 256;
+    int max_recovery_sec = 30;
+    int max_extra_threads = 16;
+    ACE_TString stubCmd;
+    ACE_TString stubArgs;
+    ACE_TString stub_ready_filename;
+
+    DDS::DomainParticipantFactory_var dpf =
+      TheParticipantFactoryWithArgs(argc, argv);
+
+    ACE_Arg_Shifter_T<ACE_TCHAR> shifter(argc, argv);
+    while (shifter.is_anything_left()) {
+      const ACE_TCHAR* currentArg = 0;
+      if ((currentArg = shifter.get_the_parameter(ACE_TEXT("-n"))) != 0) {
+        num_writers = ACE_OS::atoi(currentArg);
+        shifter.consume_arg();
+      } else if ((currentArg = shifter.get_the_parameter(ACE_TEXT("-r"))) != 0) {
+        max_recovery_sec = ACE_OS::atoi(currentArg);
+        shifter.consume_arg();
+      } else if ((currentArg = shifter.get_the_parameter(ACE_TEXT("-t"))) != 0) {
+        max_extra_threads = ACE_OS::atoi(currentArg);
+        shifter.consume_arg();
+      } else if ((currentArg = shifter.get_the_parameter(ACE_TEXT("-stubCmd"))) != 0) {
+        stubCmd = currentArg;
+        shifter.consume_arg();
+      } else if ((currentArg = shifter.get_the_parameter(ACE_TEXT("-stubp"))) != 0) {
+        stubArgs += ACE_TEXT(" -p");
+        stubArgs += currentArg;
+        shifter.consume_arg();
+      } else if ((currentArg = shifter.get_the_parameter(ACE_TEXT("-stubs"))) != 0) {
+        stubArgs += ACE_TEXT(" -s");
+        stubArgs += currentArg;
+        shifter.consume_arg();
+      } else if ((currentArg = shifter.get_the_parameter(ACE_TEXT("-stub_ready_file"))) != 0) {
+        stubArgs += ACE_TEXT(" -stub_ready_file:");
+        stubArgs += currentArg;
+        stub_ready_filename = currentArg;
+        shifter.consume_arg();
+      } else {
+        shifter.ignore_arg();
+      }
+    }
+
+    if (stub_ready_filename.empty())
+      ACE_ERROR_RETURN((LM_ERROR, ACE_TEXT("-stub_ready_file required.\n")), -1);
+
+    ACE_Process_Options options;
+    options.command_line((stubCmd + stubArgs).c_str());
+#ifdef ACE_WIN32
+    options.creation_flags(CREATE_NEW_PROCESS_GROUP);
+#endif
+
+    if (process.spawn(options) == ACE_INVALID_PID)
+      ACE_ERROR_RETURN((LM_ERROR, ACE_TEXT("%p\n"), ACE_TEXT("spawn")), -1);
+
+    FILE* stub_ready = 0;
+    while ((stub_ready = ACE_OS::fopen(stub_ready_filename.c_str(), ACE_TEXT("r"))) == 0) {
+      ACE_OS::sleep(ACE_Time_Value(0, 250000));
+    }
+    ACE_OS::fclose(stub_ready);
+
+    DDS::DomainParticipant_var participant =
+      dpf->create_participant(4,
+                              PARTICIPANT_QOS_DEFAULT,
+                              DDS::DomainParticipantListener::_nil(),
+                              OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+
+    if (CORBA::is_nil(participant.in())) {
+      ACE_ERROR_RETURN((LM_ERROR,
+                        ACE_TEXT("%N:%l: main()")
+                        ACE_TEXT(" ERROR: create_participant failed!\n")),
+                       -1);
+    }
+
+    Messenger::MessageTypeSupport_var mts =
+      new Messenger::MessageTypeSupportImpl();
+
+    if (mts->register_type(participant.in(), "") != DDS::RETCODE_OK) {
+      ACE_ERROR_RETURN((LM_ERROR,
+                        ACE_TEXT("%N:%l: main()")
+                        ACE_TEXT(" ERROR: register_type failed!\n")),
+                       -1);
+    }
+
+    CORBA::String_var type_name = mts->get_type_name();
+    DDS::Topic_var topic =
+      participant->create_topic("Movie Discussion List",
+                                type_name.in(),
+                                TOPIC_QOS_DEFAULT,
+                                DDS::TopicListener::_nil(),
+                                OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+
+    DDS::Publisher_var pub =
+      participant->create_publisher(PUBLISHER_QOS_DEFAULT,
+                                    DDS::PublisherListener::_nil(),
+                                    OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+
+    if (CORBA::is_nil(topic.in()) || CORBA::is_nil(pub.in())) {
+      ACE_ERROR_RETURN((LM_ERROR,
+                        ACE_TEXT("%N:%l: main()")
+                        ACE_TEXT(" ERROR: create_topic or create_publisher failed!\n")),
+                       -1);
+    }
+
+    DDS::DataWriterQos qos;
+    pub->get_default_datawriter_qos(qos);
+    qos.history.kind = DDS::KEEP_ALL_HISTORY_QOS;
+    qos.reliability.kind = DDS::RELIABLE_RELIABILITY_QOS;
+
+    std::vector<Messenger::MessageDataWriter_var> writers;
+    for (int i = 0; i < num_writers; ++i) {
+      DDS::DataWriter_var dw =
+        pub->create_datawriter(topic.in(),
+                               qos,
+                               DDS::DataWriterListener::_nil(),
+                               OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+      writers.push_back(Messenger::MessageDataWriter::_narrow(dw.in()));
+      if (CORBA::is_nil(writers.back().in())) {
+        ACE_ERROR_RETURN((LM_ERROR,
+                          ACE_TEXT("%N:%l: main()")
+                          ACE_TEXT(" ERROR: create_datawriter failed!\n")),
+                         -1);
+      }
+    }
+
+    for (size_t i = 0; i < writers.size(); ++i) {
+      const DDS::DataWriter_var dw = DDS::DataWriter::_duplicate(writers[i].in());
+      OpenDDS::Model::WriterSync::wait_match(dw, 1);
+    }
+
+    const ACE_Time_Value max_recovery(max_recovery_sec);
+    if (!write_all(writers, 0)
+        || !wait_for_acks(writers, ACE_OS::gettimeofday() + max_recovery)) {
+      ACE_ERROR_RETURN((LM_ERROR,
+                        ACE_TEXT("%N:%l: main()")
+                        ACE_TEXT(" ERROR: initial samples were not acknowledged\n")),
+                       -1);
+    }
+
+    const long baseline_threads = thread_count();
+    ThreadSampler sampler;
+    sampler.activate();
+
+    std::cout << "Kill stub (dropping connections of " << num_writers
+              << " writers)" << std::endl;
+#ifdef ACE_WIN32
+    GenerateConsoleCtrlEvent(CTRL_BREAK_EVENT, process.getpid());
+#else
+    process.kill();
+#endif
+    process.wait();
+
+    // Let every connection notice the loss and fail some attempts.
+    ACE_OS::sleep(2);
+
+    ACE_OS::unlink(stub_ready_filename.c_str());
+    if (process.spawn(options) == ACE_INVALID_PID)
+      ACE_ERROR_RETURN((LM_ERROR, ACE_TEXT("%p\n"), ACE_TEXT("spawn")), -1);
+    while ((stub_ready = ACE_OS::fopen(stub_ready_filename.c_str(), ACE_TEXT("r"))) == 0) {
+      ACE_OS::sleep(ACE_Time_Value(0, 10000));
+    }
+    ACE_OS::fclose(stub_ready);
+
+    const ACE_Time_Value start = ACE_OS::gettimeofday();
+    const bool recovered = write_all(writers, 1)
+      && wait_for_acks(writers, start + max_recovery);
+    const ACE_Time_Value recovery = ACE_OS::gettimeofday() - start;
+    const long peak_threads = sampler.stop();
+
+    std::cout << "storm: writers=" << num_writers
+              << " recovery_ms=" << recovery.msec()
+              << " baseline_threads=" << baseline_threads
+              << " peak_threads=" << peak_threads << std::endl;
+
+    if (!recovered) {
+      ACE_ERROR((LM_ERROR,
+                 ACE_TEXT("%N:%l: main()")
+                 ACE_TEXT(" ERROR: connections did not recover within %d seconds\n"),
+                 max_recovery_sec));
+      status = 1;
+    }
+
+    if (baseline_threads && peak_threads - baseline_threads > max_extra_threads) {
+      ACE_ERROR((LM_ERROR,
+                 ACE_TEXT("%N:%l: main()")
+                 ACE_TEXT(" ERROR: reconnecting used %d extra threads (limit %d)\n"),
+                 int(peak_threads - baseline_threads), max_extra_threads));
+      status = 1;
+    }
+
+    writers.clear();
+    participant->delete_contained_entities();
+    dpf->delete_participant(participant.in());
+    TheServiceParticipant->shutdown();
+
+  } catch (const CORBA::Exception& e) {
+    e._tao_print_exception("Exception caught in main():");
+    status = 1;
+  }
+
+  if (process.getpid() != ACE_INVALID_PID) {
+#ifdef ACE_WIN32
+    GenerateConsoleCtrlEvent(CTRL_BREAK_EVENT, process.getpid());
+#else
+    process.kill();
+#endif
+    process.wait();
+  }
+
+  return status;
+}
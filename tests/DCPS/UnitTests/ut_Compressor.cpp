@@ -0,0 +1,270 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "ace/OS_main.h"
+#include "ace/Message_Block.h"
+
+#include "dds/DCPS/DataSampleHeader.h"
+#include "dds/DCPS/GuidUtils.h"
+#include "dds/DCPS/transport/framework/Compressor.h"
+#include "dds/DCPS/transport/framework/ReceivedDataSample.h"
+#include "dds/DCPS/transport/framework/TransportSendControlElement.h"
+#include "dds/DCPS/transport/framework/TransportSendListener.h"
+
+#include "../common/TestSupport.h"
+
+#include <cstring>
+#include <string>
+
+using namespace OpenDDS::DCPS;
+
+namespace {
+
+/// Run length encoding as (count, octet) pairs, so the test does not
+/// depend on OpenDDS being built with LZ4 or zstd.
+class RunLengthCompressor : public Compressor {
+public:
+  enum { RLE = 6 };
+
+  Kind kind() const { return static_cast<Kind>(RLE); }
+
+  const char* name() const { return "rle"; }
+
+  size_t bound(size_t size) const { return 2 * size; }
+
+  size_t compress(const char* in, size_t in_size,
+                  char* out, size_t out_size, int) const
+  {
+    size_t written = 0;
+    for (size_t i = 0; i < in_size;) {
+      size_t run = 1;
+      while (i + run < in_size && run < 255 && in[i + run] == in[i]) {
+        ++run;
+      }
+      if (written + 2 > out_size) {
+        return 0;
+      }
+      out[written++] = static_cast<char>(run);
+      out[written++] = in[i];
+      i += run;
+    }
+    return written;
+  }
+
+  bool decompress(const char* in, size_t in_size,
+                  char* out, size_t out_size) const
+  {
+    if (in_size % 2) {
+      return false;
+    }
+    size_t written = 0;
+    for (size_t i = 0; i < in_size; i += 2) {
+      const size_t run = static_cast<unsigned char>(in[i]);
+      if (run == 0 || written + run > out_size) {
+        return false;
+      }
+      std::memset(out + written, in[i + 1], run);
+      written += run;
+    }
+    return written == out_size;
+  }
+};
+
+class Listener : public TransportSendListener {
+public:
+  Listener() : released_(0) {}
+
+  void control_delivered(const Message_Block_Ptr&) { ++released_; }
+  void control_dropped(const Message_Block_Ptr&, bool) { ++released_; }
+
+  void notify_publication_disconnected(const ReaderIdSeq&) {}
+  void notify_publication_reconnected(const ReaderIdSeq&) {}
+  void notify_publication_lost(const ReaderIdSeq&) {}
+  void remove_associations(const ReaderIdSeq&, bool) {}
+
+  int released_;
+};
+
+const RunLengthCompressor rle;
+
+std::string payload_of(const ReceivedDataSample& sample)
+{
+  std::string result;
+  for (const ACE_Message_Block* mb = sample.sample_.get(); mb; mb = mb->cont()) {
+    result.append(mb->rd_ptr(), mb->length());
+  }
+  return result;
+}
+
+/// A SAMPLE_DATA message carrying @a payload.
+TransportSendControlElement* make_element(Listener& listener,
+                                          const std::string& payload)
+{
+  DataSampleHeader header;
+  header.message_id_ = SAMPLE_DATA;
+  header.message_length_ = static_cast<ACE_UINT32>(payload.size());
+  Message_Block_Ptr msg(new ACE_Message_Block(DataSampleHeader::max_marshaled_size()));
+  *msg << header;
+  ACE_Message_Block* const data = new ACE_Message_Block(payload.size());
+  data->copy(payload.data(), payload.size());
+  msg->cont(data);
+  return new TransportSendControlElement(1, GUID_UNKNOWN, &listener,
+                                         header, move(msg));
+}
+
+/// What a receive strategy makes of the message @a msg.
+ReceivedDataSample receive(const ACE_Message_Block& msg)
+{
+  Message_Block_Ptr dup(msg.duplicate());
+  DataSampleHeader header(*dup);
+  ACE_Message_Block* payload = dup.get();
+  while (payload && payload->length() == 0) {
+    payload = payload->cont();
+  }
+  ReceivedDataSample sample(payload ? payload->duplicate() : 0);
+  sample.header_ = header;
+  return sample;
+}
+
+/// A compressed sample whose prefix claims @a original_size bytes of
+/// kind @a kind, followed by @a body.
+ReceivedDataSample compressed_sample(ACE_CDR::ULong original_size, int kind,
+                                     const std::string& body)
+{
+  ACE_Message_Block* const mb =
+    new ACE_Message_Block(Compressor::PREFIX_SIZE + body.size());
+  char* const out = mb->wr_ptr();
+  out[0] = static_cast<char>((original_size >> 24) & 0xff);
+  out[1] = static_cast<char>((original_size >> 16) & 0xff);
+  out[2] = static_cast<char>((original_size >> 8) & 0xff);
+  out[3] = static_cast<char>(original_size & 0xff);
+  out[4] = static_cast<char>(kind);
+  mb->wr_ptr(Compressor::PREFIX_SIZE);
+  mb->copy(body.data(), body.size());
+  ReceivedDataSample sample(mb);
+  sample.header_.message_id_ = SAMPLE_DATA;
+  sample.header_.compressed_ = true;
+  sample.header_.message_length_ = static_cast<ACE_UINT32>(mb->length());
+  return sample;
+}
+
+void test_round_trip(const Compressor& compressor, size_t threshold)
+{
+  std::string payload;
+  for (int i = 0; i < 64; ++i) {
+    payload += std::string(40, static_cast<char>('a' + i % 26));
+  }
+
+  Listener listener;
+  TransportSendControlElement* const element = make_element(listener, payload);
+  TransportQueueElement* const compressed =
+    Compressor::compress_sample(element, compressor, threshold, 0);
+  TEST_CHECK(compressed != element);
+
+  ReceivedDataSample sample = receive(*compressed->msg());
+  TEST_CHECK(sample.header_.compressed_);
+  TEST_CHECK(sample.header_.message_length_ < payload.size());
+  TEST_CHECK(sample.sample_ &&
+             sample.sample_->total_length() == sample.header_.message_length_);
+
+  TEST_CHECK(Compressor::decompress_sample(sample, payload.size()));
+  TEST_CHECK(!sample.header_.compressed_);
+  TEST_CHECK(sample.header_.message_length_ == payload.size());
+  TEST_CHECK(payload_of(sample) == payload);
+
+  // Releasing the compressed copy releases the original element.
+  compressed->data_dropped(true);
+  TEST_CHECK(listener.released_ == 1);
+}
+
+void test_not_compressed()
+{
+  Listener listener;
+
+  // Below the threshold.
+  TransportSendControlElement* element =
+    make_element(listener, std::string(100, 'x'));
+  TEST_CHECK(Compressor::compress_sample(element, rle, 1024, 0) == element);
+  element->data_dropped(true);
+
+  // Doesn't get any smaller.
+  std::string varied;
+  for (int i = 0; i < 2000; ++i) {
+    varied += static_cast<char>(i % 251);
+  }
+  element = make_element(listener, varied);
+  TEST_CHECK(Compressor::compress_sample(element, rle, 1024, 0) == element);
+  element->data_dropped(true);
+  TEST_CHECK(listener.released_ == 2);
+
+  // A sample that isn't compressed is left as it is.
+  ACE_Message_Block* const mb = new ACE_Message_Block(16);
+  mb->copy("plain sample", 12);
+  ReceivedDataSample sample(mb);
+  TEST_CHECK(Compressor::decompress_sample(sample, 0));
+  TEST_CHECK(payload_of(sample) == "plain sample");
+}
+
+void test_rejected()
+{
+  std::string body;
+  body += char(100);
+  body += 'z';
+
+  // The size comes from the peer: claiming more than the limit is
+  // rejected before it is allocated.
+  ReceivedDataSample huge = compressed_sample(0xffffffff, RunLengthCompressor::RLE, body);
+  TEST_CHECK(!Compressor::decompress_sample(huge, 64 * 1024 * 1024));
+  ReceivedDataSample over = compressed_sample(100, RunLengthCompressor::RLE, body);
+  TEST_CHECK(!Compressor::decompress_sample(over, 99));
+  ReceivedDataSample within = compressed_sample(100, RunLengthCompressor::RLE, body);
+  TEST_CHECK(Compressor::decompress_sample(within, 100));
+  TEST_CHECK(payload_of(within) == std::string(100, 'z'));
+
+  // A size the data doesn't restore to.
+  ReceivedDataSample wrong_size = compressed_sample(50, RunLengthCompressor::RLE, body);
+  TEST_CHECK(!Compressor::decompress_sample(wrong_size, 1000));
+
+  // Corrupt data.
+  ReceivedDataSample corrupt = compressed_sample(100, RunLengthCompressor::RLE, "z");
+  TEST_CHECK(!Compressor::decompress_sample(corrupt, 1000));
+
+  // An algorithm this process doesn't have.
+  ReceivedDataSample unknown = compressed_sample(100, Compressor::MAX_KIND, body);
+  TEST_CHECK(!Compressor::decompress_sample(unknown, 1000));
+
+  // Shorter than the prefix.
+  ACE_Message_Block* const mb = new ACE_Message_Block(4);
+  mb->copy("abc", 3);
+  ReceivedDataSample short_sample(mb);
+  short_sample.header_.compressed_ = true;
+  TEST_CHECK(!Compressor::decompress_sample(short_sample, 1000));
+}
+
+}
+
+int ACE_TMAIN(int, ACE_TCHAR*[])
+{
+  Compressor::install(&rle);
+  TEST_CHECK(Compressor::find(rle.kind()) == &rle);
+  TEST_CHECK(Compressor::find(OPENDDS_STRING("rle")) == &rle);
+  TEST_CHECK(Compressor::available() & (1 << RunLengthCompressor::RLE));
+
+  test_round_trip(rle, 1024);
+  test_not_compressed();
+  test_rejected();
+
+  // The built in algorithms, when OpenDDS is configured with them.
+  const Compressor::Kind builtin[] = { Compressor::LZ4, Compressor::ZSTD };
+  for (size_t i = 0; i < sizeof builtin / sizeof builtin[0]; ++i) {
+    if (const Compressor* const compressor = Compressor::find(builtin[i])) {
+      test_round_trip(*compressor, 1024);
+    }
+  }
+
+  return 0;
+}
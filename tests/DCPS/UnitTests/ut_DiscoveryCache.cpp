@@ -0,0 +1,202 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "ace/OS_main.h"
+#include "ace/Dirent.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_unistd.h"
+#include "../common/TestSupport.h"
+#include "dds/DCPS/RTPS/DiscoveryCache.h"
+#include "dds/DCPS/RTPS/BaseMessageTypes.h"
+#include "dds/DCPS/RTPS/BaseMessageUtils.h"
+#include "dds/DCPS/RTPS/GuidGenerator.h"
+#include "dds/DCPS/GuidUtils.h"
+
+#include <cstring>
+
+using namespace OpenDDS::RTPS;
+using OpenDDS::DCPS::DiscoveredWriterData;
+using OpenDDS::DCPS::DiscoveredReaderData;
+using OpenDDS::DCPS::GUID_t;
+
+namespace {
+
+GuidGenerator guid_generator;
+
+ParticipantData_t participant_data()
+{
+  ParticipantData_t data;
+  data.participantProxy.protocolVersion = PROTOCOLVERSION;
+  GUID_t guid;
+  guid_generator.populate(guid);
+  std::memcpy(data.participantProxy.guidPrefix, guid.guidPrefix, sizeof guid.guidPrefix);
+  data.participantProxy.vendorId = VENDORID_OPENDDS;
+  data.participantProxy.expectsInlineQos = false;
+  data.participantProxy.availableBuiltinEndpoints = 0x3f;
+  data.participantProxy.manualLivelinessCount.value = 0;
+  data.leaseDuration.seconds = 300;
+  data.leaseDuration.fraction = 0;
+  return data;
+}
+
+DiscoveredWriterData writer_data(const char* topic)
+{
+  DiscoveredWriterData data;
+  data.ddsPublicationData.topic_name = topic;
+  data.ddsPublicationData.type_name = "Messenger::Message";
+  guid_generator.populate(data.writerProxy.remoteWriterGuid);
+  return data;
+}
+
+DiscoveredReaderData reader_data(const char* topic)
+{
+  DiscoveredReaderData data;
+  data.ddsSubscriptionData.topic_name = topic;
+  data.ddsSubscriptionData.type_name = "Messenger::Message";
+  guid_generator.populate(data.readerProxy.remoteReaderGuid);
+  data.readerProxy.expectsInlineQos = false;
+  data.contentFilterProperty.filterClassName = "";
+  return data;
+}
+
+DiscoveryCache populated()
+{
+  DiscoveryCache cache;
+  cache.participants_.push_back(participant_data());
+  cache.participants_.push_back(participant_data());
+  cache.writers_.push_back(writer_data("Movie Discussion List"));
+  cache.writers_.push_back(writer_data("Weather"));
+  cache.readers_.push_back(reader_data("Movie Discussion List"));
+  return cache;
+}
+
+bool same(const DiscoveryCache& a, const DiscoveryCache& b)
+{
+  if (a.participants_.size() != b.participants_.size() ||
+      a.writers_.size() != b.writers_.size() ||
+      a.readers_.size() != b.readers_.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < a.participants_.size(); ++i) {
+    if (std::memcmp(a.participants_[i].participantProxy.guidPrefix,
+                    b.participants_[i].participantProxy.guidPrefix,
+                    sizeof(OpenDDS::DCPS::GuidPrefix_t)) ||
+        a.participants_[i].leaseDuration.seconds != b.participants_[i].leaseDuration.seconds) {
+      return false;
+    }
+  }
+  for (size_t i = 0; i < a.writers_.size(); ++i) {
+    if (a.writers_[i].writerProxy.remoteWriterGuid != b.writers_[i].writerProxy.remoteWriterGuid ||
+        std::strcmp(a.writers_[i].ddsPublicationData.topic_name,
+                    b.writers_[i].ddsPublicationData.topic_name)) {
+      return false;
+    }
+  }
+  for (size_t i = 0; i < a.readers_.size(); ++i) {
+    if (a.readers_[i].readerProxy.remoteReaderGuid != b.readers_[i].readerProxy.remoteReaderGuid ||
+        std::strcmp(a.readers_[i].ddsSubscriptionData.topic_name,
+                    b.readers_[i].ddsSubscriptionData.topic_name)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// The names in @a dir other than "." and "..".
+OPENDDS_VECTOR(OPENDDS_STRING) files_in(const char* dir)
+{
+  OPENDDS_VECTOR(OPENDDS_STRING) files;
+  ACE_Dirent dirent(ACE_TEXT_CHAR_TO_TCHAR(dir));
+  while (ACE_DIRENT* const entry = dirent.read()) {
+    const OPENDDS_STRING name = ACE_TEXT_ALWAYS_CHAR(entry->d_name);
+    if (name != "." && name != "..") {
+      files.push_back(name);
+    }
+  }
+  return files;
+}
+
+}
+
+int ACE_TMAIN(int, ACE_TCHAR*[])
+{
+  {
+    // Round trip through a buffer.
+    const DiscoveryCache cache = populated();
+    OPENDDS_VECTOR(char) buffer;
+    TEST_CHECK(cache.to_buffer(buffer));
+    DiscoveryCache copy;
+    TEST_CHECK(copy.from_buffer(&buffer[0], buffer.size()));
+    TEST_CHECK(same(cache, copy));
+
+    // An empty cache.
+    DiscoveryCache empty;
+    TEST_CHECK(empty.empty());
+    TEST_CHECK(empty.to_buffer(buffer));
+    TEST_CHECK(copy.from_buffer(&buffer[0], buffer.size()));
+    TEST_CHECK(copy.empty());
+  }
+
+  {
+    // Not a cache, or a truncated one.
+    const DiscoveryCache cache = populated();
+    OPENDDS_VECTOR(char) buffer;
+    TEST_CHECK(cache.to_buffer(buffer));
+    DiscoveryCache copy;
+    TEST_CHECK(!copy.from_buffer(&buffer[0], buffer.size() / 2));
+    TEST_CHECK(copy.empty());
+    buffer[0] = 'X';
+    TEST_CHECK(!copy.from_buffer(&buffer[0], buffer.size()));
+
+    // Counts larger than what is left are rejected before they are
+    // allocated.  An empty cache is the magic, the version and three
+    // little-endian counts.
+    TEST_CHECK(DiscoveryCache().to_buffer(buffer));
+    TEST_CHECK(buffer.size() == 20);
+    for (size_t offset = 8; offset < buffer.size(); offset += 4) {
+      OPENDDS_VECTOR(char) corrupt = buffer;
+      std::memset(&corrupt[offset], 0xff, 4);
+      TEST_CHECK(!copy.from_buffer(&corrupt[0], corrupt.size()));
+      TEST_CHECK(copy.empty());
+    }
+  }
+
+  {
+    // Through a file.
+    const OPENDDS_STRING path =
+      DiscoveryCache::path("ut_DiscoveryCache_dir", "test", 42);
+    GUID_t participant, other_participant;
+    guid_generator.populate(participant);
+    guid_generator.populate(other_participant);
+    const DiscoveryCache cache = populated();
+    TEST_CHECK(cache.save(path, participant));
+    DiscoveryCache copy;
+    TEST_CHECK(copy.load(path));
+    TEST_CHECK(same(cache, copy));
+
+    // Replaced, by another participant sharing the file.
+    DiscoveryCache smaller;
+    smaller.participants_.push_back(participant_data());
+    TEST_CHECK(smaller.save(path, other_participant));
+    TEST_CHECK(copy.load(path));
+    TEST_CHECK(same(smaller, copy));
+
+    // The temporary files were renamed over the cache.
+    const OPENDDS_VECTOR(OPENDDS_STRING) files = files_in("ut_DiscoveryCache_dir");
+    TEST_CHECK(files.size() == 1);
+    TEST_CHECK(!files.empty() && path.size() >= files[0].size() &&
+               path.compare(path.size() - files[0].size(), OPENDDS_STRING::npos,
+                            files[0]) == 0);
+
+    ACE_OS::unlink(path.c_str());
+    TEST_CHECK(!copy.load(path));
+    TEST_CHECK(copy.empty());
+    ACE_OS::rmdir("ut_DiscoveryCache_dir");
+  }
+
+  return 0;
+}
@@ -0,0 +1,149 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "ace/OS_main.h"
+#include "../common/TestSupport.h"
+#include "dds/DCPS/RTPS/DiscoveryPacer.h"
+
+#include <vector>
+
+using OpenDDS::RTPS::DiscoveryPacer;
+
+namespace {
+
+typedef std::vector<int> Sent;
+
+class TestMessage : public DiscoveryPacer::Message {
+public:
+  TestMessage(Sent& sent, int id, int& deleted)
+    : sent_(sent)
+    , id_(id)
+    , deleted_(deleted)
+  {}
+
+  ~TestMessage()
+  {
+    ++deleted_;
+  }
+
+  void send()
+  {
+    sent_.push_back(id_);
+  }
+
+private:
+  Sent& sent_;
+  int id_;
+  int& deleted_;
+};
+
+ACE_Time_Value msec(int ms)
+{
+  return ACE_Time_Value(1000, 0) + ACE_Time_Value(0, ms * 1000);
+}
+
+}
+
+int ACE_TMAIN(int, ACE_TCHAR*[])
+{
+  {
+    // Disabled: everything is sent at once.
+    DiscoveryPacer pacer;
+    Sent sent;
+    int deleted = 0;
+    TEST_CHECK(!pacer.enabled());
+    for (int i = 0; i < 100; ++i) {
+      pacer.send(DiscoveryPacer::PRIORITY_SECURITY, new TestMessage(sent, i, deleted), msec(0));
+    }
+    TEST_CHECK(sent.size() == 100);
+    TEST_CHECK(deleted == 100);
+    TEST_CHECK(pacer.queued() == 0);
+  }
+
+  {
+    // A burst, then the configured rate.
+    DiscoveryPacer pacer;
+    pacer.configure(100, 5);
+    Sent sent;
+    int deleted = 0;
+    TEST_CHECK(pacer.enabled());
+    for (int i = 0; i < 20; ++i) {
+      pacer.send(DiscoveryPacer::PRIORITY_ENDPOINT, new TestMessage(sent, i, deleted), msec(0));
+    }
+    TEST_CHECK(sent.size() == 5);
+    TEST_CHECK(pacer.queued() == 15);
+
+    // 100 per second is one every 10 ms.
+    pacer.drain(msec(5));
+    TEST_CHECK(sent.size() == 5);
+    pacer.drain(msec(11));
+    TEST_CHECK(sent.size() == 6);
+    pacer.drain(msec(55));
+    TEST_CHECK(sent.size() == 10);
+
+    // No more than a burst after a long time.
+    pacer.drain(msec(10000));
+    TEST_CHECK(sent.size() == 15);
+    pacer.drain(msec(10000));
+    TEST_CHECK(sent.size() == 15);
+    pacer.drain(msec(10100));
+    TEST_CHECK(sent.size() == 20);
+
+    // In order.
+    for (int i = 0; i < 20; ++i) {
+      TEST_CHECK(sent[i] == i);
+    }
+    TEST_CHECK(deleted == 20);
+    TEST_CHECK(pacer.queued() == 0);
+  }
+
+  {
+    // Higher priorities first, and in order within a priority.
+    DiscoveryPacer pacer;
+    pacer.configure(100, 1);
+    Sent sent;
+    int deleted = 0;
+    pacer.send(DiscoveryPacer::PRIORITY_SECURITY, new TestMessage(sent, 0, deleted), msec(0));
+    pacer.send(DiscoveryPacer::PRIORITY_SECURITY, new TestMessage(sent, 1, deleted), msec(0));
+    pacer.send(DiscoveryPacer::PRIORITY_PARTICIPANT_MESSAGE, new TestMessage(sent, 2, deleted), msec(0));
+    pacer.send(DiscoveryPacer::PRIORITY_ENDPOINT, new TestMessage(sent, 3, deleted), msec(0));
+    pacer.send(DiscoveryPacer::PRIORITY_ENDPOINT, new TestMessage(sent, 4, deleted), msec(0));
+    TEST_CHECK(sent.size() == 1);
+    TEST_CHECK(sent[0] == 0);
+
+    for (int t = 15; t <= 60; t += 15) {
+      pacer.drain(msec(t));
+    }
+    TEST_CHECK(sent.size() == 5);
+    TEST_CHECK(sent[1] == 3);
+    TEST_CHECK(sent[2] == 4);
+    TEST_CHECK(sent[3] == 2);
+    TEST_CHECK(sent[4] == 1);
+  }
+
+  {
+    // Queued messages are deleted without being sent.
+    Sent sent;
+    int deleted = 0;
+    {
+      DiscoveryPacer pacer;
+      pacer.configure(1, 1);
+      for (int i = 0; i < 3; ++i) {
+        pacer.send(DiscoveryPacer::PRIORITY_ENDPOINT, new TestMessage(sent, i, deleted), msec(0));
+      }
+      TEST_CHECK(pacer.queued() == 2);
+      pacer.clear();
+      TEST_CHECK(pacer.queued() == 0);
+      TEST_CHECK(deleted == 3);
+      pacer.send(DiscoveryPacer::PRIORITY_ENDPOINT, new TestMessage(sent, 3, deleted), msec(0));
+    }
+    TEST_CHECK(sent.size() == 1);
+    TEST_CHECK(deleted == 4);
+  }
+
+  return 0;
+}
@@ -0,0 +1,235 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "ace/OS_main.h"
+#include "../common/TestSupport.h"
+#include "dds/DCPS/DCPS_Utils.h"
+#include "dds/DCPS/EndpointMatchKey.h"
+#include "dds/DCPS/Service_Participant.h"
+#include "dds/DCPS/TopicDetails.h"
+
+using OpenDDS::DCPS::EndpointMatchKey;
+using OpenDDS::DCPS::RepoId;
+using OpenDDS::DCPS::TopicDetails;
+
+namespace {
+
+struct Writer {
+  Writer()
+    : qos(TheServiceParticipant->initial_DataWriterQos())
+    , publisher_qos(TheServiceParticipant->initial_PublisherQos())
+  {
+    trans_info.length(1);
+    trans_info[0].transport_type = "rtps_udp";
+  }
+
+  EndpointMatchKey key() const
+  {
+    EndpointMatchKey k;
+    k.set(qos, publisher_qos, trans_info);
+    return k;
+  }
+
+  DDS::DataWriterQos qos;
+  DDS::PublisherQos publisher_qos;
+  OpenDDS::DCPS::TransportLocatorSeq trans_info;
+};
+
+struct Reader {
+  Reader()
+    : qos(TheServiceParticipant->initial_DataReaderQos())
+    , subscriber_qos(TheServiceParticipant->initial_SubscriberQos())
+  {
+    trans_info.length(1);
+    trans_info[0].transport_type = "rtps_udp";
+  }
+
+  EndpointMatchKey key() const
+  {
+    EndpointMatchKey k;
+    k.set(qos, subscriber_qos, trans_info);
+    return k;
+  }
+
+  DDS::DataReaderQos qos;
+  DDS::SubscriberQos subscriber_qos;
+  OpenDDS::DCPS::TransportLocatorSeq trans_info;
+};
+
+void partition(DDS::PartitionQosPolicy& qos, const char* name)
+{
+  qos.name.length(1);
+  qos.name[0] = name;
+}
+
+/// The keys must only exclude pairs that compatibleQOS() rejects without
+/// counting an incompatible policy.
+bool agrees(const Writer& w, const Reader& r)
+{
+  OpenDDS::DCPS::IncompatibleQosStatus writer_status = {0, 0, 0, DDS::QosPolicyCountSeq()};
+  OpenDDS::DCPS::IncompatibleQosStatus reader_status = {0, 0, 0, DDS::QosPolicyCountSeq()};
+  const bool compatible =
+    OpenDDS::DCPS::compatibleQOS(&writer_status, &reader_status,
+                                 w.trans_info, r.trans_info,
+                                 &w.qos, &r.qos, &w.publisher_qos, &r.subscriber_qos);
+  const bool silent = !compatible && writer_status.total_count == 0;
+  return EndpointMatchKey::excluded(w.key(), r.key()) == silent;
+}
+
+class Callbacks : public OpenDDS::DCPS::TopicCallbacks {
+public:
+  Callbacks() : count_(-1) {}
+  void inconsistent_topic(int count) { count_ = count; }
+  int count_;
+};
+
+RepoId endpoint(unsigned char participant, unsigned char entity)
+{
+  RepoId guid = OpenDDS::DCPS::GUID_UNKNOWN;
+  guid.guidPrefix[11] = participant;
+  guid.entityId.entityKey[2] = entity;
+  guid.entityId.entityKind = OpenDDS::DCPS::ENTITYKIND_USER_WRITER_WITH_KEY;
+  return guid;
+}
+
+/// Matching only pairs discovered endpoints with local_endpoints(), so
+/// asserting the topic again must keep the local ones in endpoints().
+void test_topic_details()
+{
+  const DDS::TopicQos qos = TheServiceParticipant->initial_TopicQos();
+  Callbacks callbacks;
+  TopicDetails details;
+  details.init("Topic", endpoint(1, 0));
+  details.set_local("Type", qos, true, &callbacks);
+
+  const RepoId local = endpoint(1, 1);
+  const RepoId consistent = endpoint(2, 1);
+  const RepoId inconsistent = endpoint(3, 1);
+  details.add_pub_sub(local);
+  details.add_pub_sub(consistent, "Type");
+  details.add_pub_sub(inconsistent, "OtherType");
+  TEST_CHECK(callbacks.count_ == 1);
+  TEST_CHECK(details.endpoints().size() == 2);
+  TEST_CHECK(details.endpoints().count(local) == 1);
+  TEST_CHECK(details.endpoints().count(consistent) == 1);
+  TEST_CHECK(details.local_endpoints().size() == 1);
+  TEST_CHECK(details.local_endpoints().count(local) == 1);
+
+  // Another create_topic() of the same name.
+  callbacks.count_ = -1;
+  details.set_local("Type", qos, true, &callbacks);
+  TEST_CHECK(callbacks.count_ == 1);
+  TEST_CHECK(details.endpoints().size() == 2);
+  TEST_CHECK(details.endpoints().count(local) == 1);
+  TEST_CHECK(details.endpoints().count(consistent) == 1);
+  TEST_CHECK(details.local_endpoints().size() == 1);
+
+  details.remove_pub_sub(local);
+  TEST_CHECK(details.local_endpoints().empty());
+  TEST_CHECK(details.endpoints().size() == 1);
+  TEST_CHECK(details.endpoints().count(consistent) == 1);
+
+  details.remove_pub_sub(consistent);
+  details.remove_pub_sub(inconsistent);
+  TEST_CHECK(details.endpoints().empty());
+  TEST_CHECK(callbacks.count_ == 0);
+  details.unset_local();
+  TEST_CHECK(details.is_dead());
+}
+
+}
+
+int ACE_TMAIN(int, ACE_TCHAR*[])
+{
+  {
+    // Keys that were never set exclude nothing.
+    TEST_CHECK(!EndpointMatchKey::excluded(EndpointMatchKey(), EndpointMatchKey()));
+  }
+
+  {
+    // Same partition: not excluded.
+    Writer w;
+    Reader r;
+    TEST_CHECK(!EndpointMatchKey::excluded(w.key(), r.key()));
+    TEST_CHECK(agrees(w, r));
+    partition(w.publisher_qos.partition, "A");
+    partition(r.subscriber_qos.partition, "A");
+    TEST_CHECK(!EndpointMatchKey::excluded(w.key(), r.key()));
+    TEST_CHECK(agrees(w, r));
+  }
+
+  {
+    // Different partitions: excluded.
+    Writer w;
+    Reader r;
+    partition(w.publisher_qos.partition, "A");
+    partition(r.subscriber_qos.partition, "B");
+    TEST_CHECK(EndpointMatchKey::excluded(w.key(), r.key()));
+    TEST_CHECK(agrees(w, r));
+
+    // A wildcard still matches.
+    partition(r.subscriber_qos.partition, "[AB]");
+    TEST_CHECK(!EndpointMatchKey::excluded(w.key(), r.key()));
+    TEST_CHECK(agrees(w, r));
+  }
+
+  {
+    // Different partitions and an incompatible policy: not excluded, so
+    // the incompatible QoS is reported.
+    Writer w;
+    Reader r;
+    partition(w.publisher_qos.partition, "A");
+    partition(r.subscriber_qos.partition, "B");
+    w.qos.reliability.kind = DDS::BEST_EFFORT_RELIABILITY_QOS;
+    r.qos.reliability.kind = DDS::RELIABLE_RELIABILITY_QOS;
+    TEST_CHECK(!EndpointMatchKey::excluded(w.key(), r.key()));
+    TEST_CHECK(agrees(w, r));
+
+    r.qos.reliability.kind = DDS::BEST_EFFORT_RELIABILITY_QOS;
+    r.qos.deadline.period.sec = 1;
+    r.qos.deadline.period.nanosec = 0;
+    TEST_CHECK(!EndpointMatchKey::excluded(w.key(), r.key()));
+    TEST_CHECK(agrees(w, r));
+
+    r.qos.deadline = w.qos.deadline;
+    r.subscriber_qos.presentation.access_scope = DDS::GROUP_PRESENTATION_QOS;
+    TEST_CHECK(!EndpointMatchKey::excluded(w.key(), r.key()));
+    TEST_CHECK(agrees(w, r));
+
+    r.subscriber_qos.presentation.access_scope = w.publisher_qos.presentation.access_scope;
+    r.trans_info[0].transport_type = "tcp";
+    TEST_CHECK(!EndpointMatchKey::excluded(w.key(), r.key()));
+    TEST_CHECK(agrees(w, r));
+  }
+
+  {
+    // A discovered endpoint without locators gets its participant's
+    // later, so its transports are not known.
+    Writer w;
+    partition(w.publisher_qos.partition, "A");
+    DDS::SubscriptionBuiltinTopicData data;
+    Reader r;
+    data.reliability = r.qos.reliability;
+    data.durability = r.qos.durability;
+    data.liveliness = r.qos.liveliness;
+    data.deadline = r.qos.deadline;
+    data.latency_budget = r.qos.latency_budget;
+    data.ownership = r.qos.ownership;
+    data.presentation = r.subscriber_qos.presentation;
+    partition(data.partition, "B");
+
+    EndpointMatchKey reader_key;
+    reader_key.set(data, OpenDDS::DCPS::TransportLocatorSeq());
+    TEST_CHECK(!EndpointMatchKey::excluded(w.key(), reader_key));
+    reader_key.set(data, r.trans_info);
+    TEST_CHECK(EndpointMatchKey::excluded(w.key(), reader_key));
+  }
+
+  test_topic_details();
+
+  return 0;
+}
@@ -0,0 +1,177 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "ace/OS_main.h"
+#include "ace/Log_Msg.h"
+#include "ace/OS_NS_errno.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_sys_time.h"
+#include "ace/OS_NS_unistd.h"
+#include "ace/SOCK_Acceptor.h"
+#include "ace/SOCK_Connector.h"
+#include "ace/SOCK_Dgram.h"
+#include "ace/SOCK_Stream.h"
+#include "../common/TestSupport.h"
+#include "dds/DCPS/transport/framework/IoUringReceiver.h"
+#include "dds/DCPS/transport/framework/KernelTimestamps.h"
+
+#include <string>
+
+using OpenDDS::DCPS::IoUringReceiver;
+using OpenDDS::DCPS::KernelTimestamps;
+
+namespace {
+
+/// Receive into @a buffer, giving the kernel up to two seconds to post
+/// the completion.
+ssize_t receive(IoUringReceiver& receiver, char* buffer, size_t size,
+                ACE_INET_Addr& from, ACE_Time_Value* received = 0,
+                ACE_INET_Addr* local_address = 0)
+{
+  iovec iov;
+  iov.iov_base = buffer;
+  iov.iov_len = size;
+  for (int i = 0; i < 200; ++i) {
+    const ssize_t ret = receiver.receive(&iov, 1, from, received, local_address);
+    if (ret != -1 || errno != EWOULDBLOCK) {
+      return ret;
+    }
+    ACE_OS::sleep(ACE_Time_Value(0, 10000));
+  }
+  return -1;
+}
+
+void test_datagrams(IoUringReceiver& receiver)
+{
+  ACE_SOCK_Dgram socket(ACE_INET_Addr(u_short(0), "127.0.0.1"));
+  ACE_INET_Addr address;
+  TEST_CHECK(socket.get_local_addr(address) == 0);
+
+  KernelTimestamps timestamps;
+  const bool timestamped = KernelTimestamps::supported() &&
+    timestamps.enable(socket.get_handle());
+
+  TEST_CHECK(receiver.add(socket.get_handle(), false));
+  TEST_CHECK(!receiver.pending());
+
+  ACE_SOCK_Dgram sender(ACE_INET_Addr(u_short(0), "127.0.0.1"));
+  ACE_INET_Addr sender_address;
+  TEST_CHECK(sender.get_local_addr(sender_address) == 0);
+
+  const ACE_Time_Value before = ACE_OS::gettimeofday();
+  const char* const messages[] = { "first", "second datagram", "third" };
+  for (size_t i = 0; i < 3; ++i) {
+    TEST_CHECK(sender.send(messages[i], ACE_OS::strlen(messages[i]), address) ==
+               static_cast<ssize_t>(ACE_OS::strlen(messages[i])));
+  }
+
+  // One completion per datagram, in order, with the sender's address.
+  for (size_t i = 0; i < 3; ++i) {
+    char buffer[64];
+    ACE_INET_Addr from;
+    ACE_Time_Value received;
+    const ssize_t n = receive(receiver, buffer, sizeof buffer, from, &received);
+    TEST_CHECK(n == static_cast<ssize_t>(ACE_OS::strlen(messages[i])));
+    TEST_CHECK(n > 0 && std::string(buffer, n) == messages[i]);
+    TEST_CHECK(from.get_port_number() == sender_address.get_port_number());
+    if (timestamped) {
+      // The kernel timestamp travels through the ring with the datagram.
+      TEST_CHECK(received >= before - ACE_Time_Value(1));
+      TEST_CHECK(received <= ACE_OS::gettimeofday() + ACE_Time_Value(1));
+    } else {
+      TEST_CHECK(received == ACE_Time_Value::zero);
+    }
+  }
+
+  char buffer[64];
+  iovec iov;
+  iov.iov_base = buffer;
+  iov.iov_len = sizeof buffer;
+  ACE_INET_Addr from;
+  TEST_CHECK(receiver.receive(&iov, 1, from) == -1 && errno == EWOULDBLOCK);
+
+  receiver.remove(socket.get_handle());
+}
+
+void test_stream(IoUringReceiver& receiver)
+{
+  ACE_SOCK_Acceptor acceptor(ACE_INET_Addr(u_short(0), "127.0.0.1"), 1);
+  ACE_INET_Addr address;
+  TEST_CHECK(acceptor.get_local_addr(address) == 0);
+
+  ACE_SOCK_Stream client;
+  ACE_SOCK_Connector connector;
+  TEST_CHECK(connector.connect(client, address) == 0);
+  ACE_SOCK_Stream server;
+  TEST_CHECK(acceptor.accept(server) == 0);
+
+  TEST_CHECK(receiver.add(server.get_handle(), true));
+
+  std::string sent;
+  for (int i = 0; i < 10000; ++i) {
+    sent += static_cast<char>('a' + i % 26);
+  }
+  TEST_CHECK(client.send_n(sent.data(), sent.size()) ==
+             static_cast<ssize_t>(sent.size()));
+
+  // The chunks are larger than the receive buffer, so they are handed
+  // out across several calls.
+  std::string received;
+  while (received.size() < sent.size()) {
+    char buffer[1000];
+    ACE_INET_Addr from;
+    const ssize_t n = receive(receiver, buffer, sizeof buffer, from);
+    TEST_CHECK(n > 0);
+    if (n <= 0) {
+      break;
+    }
+    received.append(buffer, n);
+  }
+  TEST_CHECK(received == sent);
+
+  // The peer closing the connection is reported as 0 bytes.
+  client.close();
+  char buffer[16];
+  ACE_INET_Addr from;
+  TEST_CHECK(receive(receiver, buffer, sizeof buffer, from) == 0);
+
+  receiver.remove(server.get_handle());
+  server.close();
+  acceptor.close();
+}
+
+}
+
+int ACE_TMAIN(int, ACE_TCHAR*[])
+{
+  if (!IoUringReceiver::supported()) {
+    ACE_DEBUG((LM_INFO, "(%P|%t) io_uring is not supported, skipping\n"));
+    return 0;
+  }
+
+  {
+    IoUringReceiver receiver;
+    if (!receiver.open(8, IoUringReceiver::DATAGRAM_BUFFER_SIZE)) {
+      ACE_DEBUG((LM_INFO, "(%P|%t) io_uring is not available, skipping\n"));
+      return 0;
+    }
+    TEST_CHECK(receiver.is_open());
+    TEST_CHECK(receiver.get_handle() != ACE_INVALID_HANDLE);
+    test_datagrams(receiver);
+    TEST_CHECK(receiver.completions() >= 3);
+    receiver.close();
+    TEST_CHECK(!receiver.is_open());
+  }
+
+  {
+    IoUringReceiver receiver;
+    TEST_CHECK(receiver.open(8, 4096));
+    test_stream(receiver);
+  }
+
+  return 0;
+}
@@ -0,0 +1,146 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "ace/OS_main.h"
+#include "ace/Log_Msg.h"
+#include "ace/OS_NS_errno.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_sys_time.h"
+#include "ace/OS_NS_unistd.h"
+#include "ace/SOCK_Dgram.h"
+#include "../common/TestSupport.h"
+#include "dds/DCPS/transport/framework/KernelTimestamps.h"
+#include "dds/DCPS/transport/framework/LinkLatency.h"
+
+#include <string>
+
+using OpenDDS::DCPS::KernelTimestamps;
+using OpenDDS::DCPS::LinkLatency;
+using OpenDDS::DCPS::LinkLatencyStats;
+
+namespace {
+
+/// Receive with @a timestamps, giving the kernel up to two seconds to
+/// deliver the datagram.
+ssize_t receive(KernelTimestamps& timestamps, ACE_SOCK_Dgram& socket,
+                char* buffer, size_t size, ACE_INET_Addr& from,
+                ACE_Time_Value& received)
+{
+  iovec iov;
+  iov.iov_base = buffer;
+  iov.iov_len = size;
+  for (int i = 0; i < 200; ++i) {
+    const ssize_t ret = timestamps.recv(socket.get_handle(), &iov, 1, from, received);
+    if (ret != -1 || errno != EWOULDBLOCK) {
+      return ret;
+    }
+    ACE_OS::sleep(ACE_Time_Value(0, 10000));
+  }
+  return -1;
+}
+
+void test_datagrams()
+{
+  ACE_SOCK_Dgram receiver(ACE_INET_Addr(u_short(0), "127.0.0.1"));
+  ACE_INET_Addr address;
+  TEST_CHECK(receiver.get_local_addr(address) == 0);
+  ACE_SOCK_Dgram sender(ACE_INET_Addr(u_short(0), "127.0.0.1"));
+
+  KernelTimestamps receive_timestamps;
+  KernelTimestamps send_timestamps;
+  TEST_CHECK(!receive_timestamps.enabled());
+  TEST_CHECK(receive_timestamps.enable(receiver.get_handle()));
+  TEST_CHECK(receive_timestamps.enabled());
+  TEST_CHECK(send_timestamps.enable(sender.get_handle()));
+
+  // Nothing is waiting yet.
+  char buffer[64];
+  iovec iov;
+  iov.iov_base = buffer;
+  iov.iov_len = sizeof buffer;
+  ACE_INET_Addr from;
+  ACE_Time_Value received;
+  TEST_CHECK(receive_timestamps.recv(receiver.get_handle(), &iov, 1, from, received) == -1 &&
+             errno == EWOULDBLOCK);
+
+  const ACE_Time_Value before = ACE_OS::gettimeofday();
+  const char* const messages[] = { "first", "second datagram", "third" };
+  const size_t count = sizeof messages / sizeof messages[0];
+  for (size_t i = 0; i < count; ++i) {
+    const ACE_Time_Value called = ACE_OS::gettimeofday();
+    TEST_CHECK(sender.send(messages[i], ACE_OS::strlen(messages[i]), address) ==
+               static_cast<ssize_t>(ACE_OS::strlen(messages[i])));
+    send_timestamps.sent(called);
+  }
+
+  // Each datagram carries the time the kernel received it.
+  for (size_t i = 0; i < count; ++i) {
+    const ssize_t n = receive(receive_timestamps, receiver, buffer, sizeof buffer,
+                              from, received);
+    TEST_CHECK(n == static_cast<ssize_t>(ACE_OS::strlen(messages[i])));
+    TEST_CHECK(n > 0 && std::string(buffer, n) == messages[i]);
+    TEST_CHECK(received >= before);
+    TEST_CHECK(received <= ACE_OS::gettimeofday());
+  }
+
+  // The sender's error queue has a transmit timestamp for each send.
+  LinkLatency latency(1);
+  LinkLatencyStats stats;
+  for (int i = 0; i < 200; ++i) {
+    send_timestamps.collect_send_timestamps(sender.get_handle(), latency);
+    latency.stats(stats);
+    if (stats.kernel_send_.n_ >= count) {
+      break;
+    }
+    ACE_OS::sleep(ACE_Time_Value(0, 10000));
+  }
+  TEST_CHECK(stats.kernel_send_.n_ == count);
+  TEST_CHECK(stats.kernel_send_.max_ < 1000000);
+  TEST_CHECK(stats.send_queue_.n_ == 0);
+  TEST_CHECK(stats.receive_dispatch_.n_ == 0);
+
+  // Collecting them again finds nothing new.
+  send_timestamps.collect_send_timestamps(sender.get_handle(), latency);
+  latency.stats(stats);
+  TEST_CHECK(stats.kernel_send_.n_ == count);
+}
+
+void test_without_timestamps()
+{
+  // A datagram without ancillary data has no receive timestamp.
+  ACE_Time_Value received(1);
+  KernelTimestamps::received(0, 0, received);
+  TEST_CHECK(received == ACE_Time_Value::zero);
+
+  // Sends on a socket without timestamps are not numbered.
+  ACE_SOCK_Dgram sender(ACE_INET_Addr(u_short(0), "127.0.0.1"));
+  KernelTimestamps timestamps;
+  timestamps.sent(ACE_OS::gettimeofday());
+  LinkLatency latency(2);
+  timestamps.collect_send_timestamps(sender.get_handle(), latency);
+  LinkLatencyStats stats;
+  latency.stats(stats);
+  TEST_CHECK(stats.kernel_send_.n_ == 0);
+}
+
+}
+
+int ACE_TMAIN(int, ACE_TCHAR*[])
+{
+  if (!KernelTimestamps::supported()) {
+    ACE_SOCK_Dgram socket(ACE_INET_Addr(u_short(0), "127.0.0.1"));
+    KernelTimestamps timestamps;
+    TEST_CHECK(!timestamps.enable(socket.get_handle()));
+    TEST_CHECK(!timestamps.enabled());
+    ACE_DEBUG((LM_INFO, "(%P|%t) kernel timestamps are not supported, skipping\n"));
+    return 0;
+  }
+
+  test_datagrams();
+  test_without_timestamps();
+  return 0;
+}
@@ -0,0 +1,115 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "ace/OS_main.h"
+#include "../common/TestSupport.h"
+#include "dds/DCPS/RTPS/LeaseExpirations.h"
+
+using OpenDDS::DCPS::RepoId;
+using OpenDDS::DCPS::GUID_UNKNOWN;
+using OpenDDS::RTPS::LeaseExpirations;
+
+namespace {
+
+RepoId participant(unsigned char id)
+{
+  RepoId guid = GUID_UNKNOWN;
+  guid.guidPrefix[11] = id;
+  guid.entityId.entityKind = OpenDDS::DCPS::ENTITYKIND_BUILTIN_PARTICIPANT;
+  return guid;
+}
+
+void test_order()
+{
+  LeaseExpirations leases;
+  RepoId guid;
+  TEST_CHECK(!leases.pop_due(ACE_Time_Value(1000), guid));
+
+  leases.schedule(participant(1), ACE_Time_Value(30));
+  leases.schedule(participant(2), ACE_Time_Value(10));
+  leases.schedule(participant(3), ACE_Time_Value(20));
+  leases.schedule(participant(4), ACE_Time_Value(20));
+  TEST_CHECK(leases.size() == 4);
+
+  // Nothing is due before the earliest expiration.
+  TEST_CHECK(!leases.pop_due(ACE_Time_Value(9), guid));
+
+  // Only the entries that are due come out, earliest first.
+  TEST_CHECK(leases.pop_due(ACE_Time_Value(20), guid));
+  TEST_CHECK(guid == participant(2));
+  TEST_CHECK(leases.pop_due(ACE_Time_Value(20), guid));
+  const RepoId first = guid;
+  TEST_CHECK(leases.pop_due(ACE_Time_Value(20), guid));
+  TEST_CHECK((first == participant(3) && guid == participant(4)) ||
+             (first == participant(4) && guid == participant(3)));
+  TEST_CHECK(!leases.pop_due(ACE_Time_Value(20), guid));
+  TEST_CHECK(leases.size() == 1);
+
+  ACE_Time_Value expiration;
+  TEST_CHECK(!leases.expiration(participant(2), expiration));
+  TEST_CHECK(leases.expiration(participant(1), expiration));
+  TEST_CHECK(expiration == ACE_Time_Value(30));
+
+  TEST_CHECK(leases.pop_due(ACE_Time_Value(100), guid));
+  TEST_CHECK(guid == participant(1));
+  TEST_CHECK(leases.size() == 0);
+}
+
+void test_reschedule()
+{
+  LeaseExpirations leases;
+  leases.schedule(participant(1), ACE_Time_Value(10));
+  leases.schedule(participant(2), ACE_Time_Value(15));
+
+  // A participant has one entry, at its latest expiration.
+  leases.schedule(participant(1), ACE_Time_Value(20));
+  TEST_CHECK(leases.size() == 2);
+  ACE_Time_Value expiration;
+  TEST_CHECK(leases.expiration(participant(1), expiration));
+  TEST_CHECK(expiration == ACE_Time_Value(20));
+
+  RepoId guid;
+  TEST_CHECK(leases.pop_due(ACE_Time_Value(19), guid));
+  TEST_CHECK(guid == participant(2));
+  TEST_CHECK(!leases.pop_due(ACE_Time_Value(19), guid));
+
+  // Moving an entry earlier, as a shorter lease does.
+  leases.schedule(participant(1), ACE_Time_Value(5));
+  TEST_CHECK(leases.pop_due(ACE_Time_Value(5), guid));
+  TEST_CHECK(guid == participant(1));
+  TEST_CHECK(leases.size() == 0);
+}
+
+void test_cancel()
+{
+  LeaseExpirations leases;
+  leases.schedule(participant(1), ACE_Time_Value(10));
+  leases.schedule(participant(2), ACE_Time_Value(10));
+  leases.schedule(participant(3), ACE_Time_Value(5));
+
+  leases.cancel(participant(3));
+  leases.cancel(participant(1));
+  // Cancelling a participant without an entry does nothing.
+  leases.cancel(participant(1));
+  leases.cancel(participant(9));
+  TEST_CHECK(leases.size() == 1);
+
+  RepoId guid;
+  TEST_CHECK(leases.pop_due(ACE_Time_Value(10), guid));
+  TEST_CHECK(guid == participant(2));
+  TEST_CHECK(!leases.pop_due(ACE_Time_Value(10), guid));
+}
+
+}
+
+int ACE_TMAIN(int, ACE_TCHAR*[])
+{
+  test_order();
+  test_reschedule();
+  test_cancel();
+  return 0;
+}
@@ -0,0 +1,84 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "ace/OS_main.h"
+#include "../common/TestSupport.h"
+#include "dds/DCPS/transport/framework/LinkLatency.h"
+
+using OpenDDS::DCPS::LinkLatency;
+using OpenDDS::DCPS::LinkLatencyStats;
+using OpenDDS::DCPS::Log2Histogram;
+
+namespace {
+
+void test_histogram()
+{
+  Log2Histogram histogram;
+  TEST_CHECK(histogram.n_ == 0);
+
+  const ACE_UINT64 values[] = { 0, 1, 2, 3, 4, 1000 };
+  for (size_t i = 0; i < sizeof values / sizeof values[0]; ++i) {
+    histogram.add(values[i]);
+  }
+  TEST_CHECK(histogram.n_ == 6);
+  TEST_CHECK(histogram.min_ == 0);
+  TEST_CHECK(histogram.max_ == 1000);
+  TEST_CHECK(histogram.sum_ == 1010.0);
+
+  // Bucket i > 0 holds 2^(i-1) to 2^i - 1.
+  TEST_CHECK(histogram.counts_[0] == 1);
+  TEST_CHECK(histogram.counts_[1] == 1);
+  TEST_CHECK(histogram.counts_[2] == 2);
+  TEST_CHECK(histogram.counts_[3] == 1);
+  TEST_CHECK(histogram.counts_[10] == 1);
+  TEST_CHECK(Log2Histogram::bucket_min(0) == 0);
+  TEST_CHECK(Log2Histogram::bucket_min(1) == 1);
+  TEST_CHECK(Log2Histogram::bucket_min(10) == 512);
+
+  // The last bucket takes everything larger.
+  histogram.add(ACE_UINT64(1) << 40);
+  TEST_CHECK(histogram.counts_[Log2Histogram::BUCKETS - 1] == 1);
+}
+
+void test_stages()
+{
+  LinkLatency latency(42);
+  latency.record(LinkLatency::SEND_QUEUE, ACE_Time_Value(0, 10));
+  latency.record(LinkLatency::SEND_QUEUE, ACE_Time_Value(0, 30));
+  latency.record(LinkLatency::KERNEL_SEND, ACE_Time_Value(1, 5));
+  latency.record(LinkLatency::RECEIVE_DISPATCH, ACE_Time_Value(0, 700));
+  latency.record(LinkLatency::READER, ACE_Time_Value::zero);
+
+  LinkLatencyStats stats;
+  latency.stats(stats);
+  TEST_CHECK(stats.link_id_ == 42);
+  TEST_CHECK(stats.send_queue_.n_ == 2);
+  TEST_CHECK(stats.send_queue_.min_ == 10);
+  TEST_CHECK(stats.send_queue_.max_ == 30);
+  TEST_CHECK(stats.kernel_send_.n_ == 1);
+  TEST_CHECK(stats.kernel_send_.max_ == 1000005);
+  TEST_CHECK(stats.receive_dispatch_.n_ == 1);
+  TEST_CHECK(stats.receive_dispatch_.max_ == 700);
+  TEST_CHECK(stats.reader_.n_ == 1);
+  TEST_CHECK(stats.reader_.max_ == 0);
+
+  // The system clock going back counts as no time at all.
+  latency.record(LinkLatency::KERNEL_SEND, ACE_Time_Value(-2, 0));
+  latency.stats(stats);
+  TEST_CHECK(stats.kernel_send_.n_ == 2);
+  TEST_CHECK(stats.kernel_send_.min_ == 0);
+  TEST_CHECK(stats.kernel_send_.max_ == 1000005);
+}
+
+}
+
+int ACE_TMAIN(int, ACE_TCHAR*[])
+{
+  test_histogram();
+  test_stages();
+  return 0;
+}
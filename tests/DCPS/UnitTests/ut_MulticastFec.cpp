@@ -0,0 +1,273 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "ace/OS_main.h"
+#include "ace/OS_NS_string.h"
+
+#include "dds/DCPS/transport/framework/TransportHeader.h"
+#include "dds/DCPS/transport/multicast/MulticastFec.h"
+
+#include "../common/TestSupport.h"
+
+#include <string>
+
+using namespace OpenDDS::DCPS;
+
+namespace {
+
+const MulticastPeer sender = 0x01020304;
+const MulticastPeer receiver = 0x11121314;
+
+/// Sequence numbers the decoder keeps datagrams for.
+const size_t window = 16;
+
+std::string datagram(ACE_INT64 seq, size_t body_size)
+{
+  TransportHeader header;
+  header.source_ = sender;
+  header.sequence_ = SequenceNumber(seq);
+  header.length_ = static_cast<ACE_UINT32>(body_size);
+  ACE_Message_Block mb(TransportHeader::max_marshaled_size());
+  TEST_CHECK(mb << header);
+
+  std::string body(body_size, '\0');
+  for (size_t i = 0; i < body_size; ++i) {
+    body[i] = static_cast<char>(seq * 31 + i);
+  }
+  return std::string(mb.rd_ptr(), mb.length()) + body;
+}
+
+/// A sender's encoder and a receiver's decoder, and the datagrams and
+/// parity that pass between them.
+class Channel {
+public:
+  Channel(size_t k, size_t m)
+    : encoder_(sender, k, m)
+    , decoder_(receiver, window)
+    , parity_sent_(0)
+  {}
+
+  /// Send datagram @a seq with a body of @a body_size octets, and the
+  /// parity it completes.  A lost datagram is not received.
+  void send(ACE_INT64 seq, size_t body_size, bool lost = false)
+  {
+    const std::string data = datagram(seq, body_size);
+    sent_[seq] = data;
+
+    // Sent in two pieces, as the send strategy gathers its header and
+    // samples.
+    iovec iov[2];
+    const size_t half = data.size() / 2;
+    iov[0].iov_base = const_cast<char*>(data.data());
+    iov[0].iov_len = half;
+    iov[1].iov_base = const_cast<char*>(data.data() + half);
+    iov[1].iov_len = data.size() - half;
+    OPENDDS_VECTOR(OPENDDS_STRING) parity;
+    encoder_.encode(iov, 2, parity);
+
+    if (!lost) {
+      TEST_CHECK(!receive(data));
+    }
+    for (size_t i = 0; i < parity.size(); ++i) {
+      ++parity_sent_;
+      TEST_CHECK(receive(parity[i]));
+    }
+  }
+
+  /// Send @a count datagrams from @a first, none of them lost.
+  void send_all(ACE_INT64 first, ACE_INT64 count, size_t body_size = 100)
+  {
+    for (ACE_INT64 seq = first; seq < first + count; ++seq) {
+      send(seq, body_size);
+    }
+  }
+
+  /// Is the next rebuilt datagram @a seq as it was sent?
+  bool recovered(ACE_INT64 seq)
+  {
+    char buffer[4096];
+    iovec iov;
+    iov.iov_base = buffer;
+    iov.iov_len = sizeof buffer;
+    const ssize_t size = decoder_.take_recovered(&iov, 1);
+    return size > 0 && std::string(buffer, size) == sent_[seq];
+  }
+
+  FecEncoder encoder_;
+  FecDecoder decoder_;
+  size_t parity_sent_;
+
+private:
+  /// Read @a data as the receive strategy does, into receive buffers
+  /// that split its header and are larger than it.
+  bool receive(const std::string& data)
+  {
+    char buffer[4096];
+    ACE_OS::memcpy(buffer, data.data(), data.size());
+    iovec iov[2];
+    iov[0].iov_base = buffer;
+    iov[0].iov_len = 20;
+    iov[1].iov_base = buffer + 20;
+    iov[1].iov_len = sizeof buffer - 20;
+    return decoder_.received(iov, 2, data.size());
+  }
+
+  OPENDDS_MAP(ACE_INT64, std::string) sent_;
+};
+
+// The receiver keeps a source's datagrams once it has received parity
+// from it, so the first block of each test only starts that.
+
+void test_single_loss()
+{
+  Channel channel(4, 1);
+  channel.send_all(1, 4);
+  TEST_CHECK(channel.decoder_.kept() == 0);
+
+  channel.send(5, 100);
+  channel.send(6, 100);
+  channel.send(7, 100, true);
+  TEST_CHECK(channel.decoder_.kept() == 2);
+  channel.send(8, 100);
+  TEST_CHECK(channel.parity_sent_ == 2);
+  TEST_CHECK(channel.decoder_.has_recovered());
+  TEST_CHECK(channel.recovered(7));
+  TEST_CHECK(!channel.decoder_.has_recovered());
+  TEST_CHECK(channel.decoder_.recovered() == 1);
+  TEST_CHECK(channel.decoder_.unrecoverable() == 0);
+  // The block is resolved, so none of it is kept.
+  TEST_CHECK(channel.decoder_.kept() == 0);
+}
+
+void test_two_losses()
+{
+  {
+    // Both losses are in the group of the one parity datagram.
+    Channel channel(4, 1);
+    channel.send_all(1, 4);
+    channel.send(5, 100);
+    channel.send(6, 100, true);
+    channel.send(7, 100, true);
+    channel.send(8, 100);
+    TEST_CHECK(!channel.decoder_.has_recovered());
+    TEST_CHECK(channel.decoder_.kept() == 2);
+
+    // Counted once the block leaves the window.
+    channel.send_all(9, window + 4);
+    TEST_CHECK(!channel.decoder_.has_recovered());
+    TEST_CHECK(channel.decoder_.recovered() == 0);
+    TEST_CHECK(channel.decoder_.unrecoverable() == 1);
+    TEST_CHECK(channel.decoder_.kept() == 0);
+  }
+
+  {
+    // With two parity datagrams per block, adjacent losses are in
+    // different groups.
+    Channel channel(4, 2);
+    channel.send_all(1, 4);
+    channel.send(5, 100);
+    channel.send(6, 100, true);
+    channel.send(7, 100, true);
+    channel.send(8, 100);
+    TEST_CHECK(channel.parity_sent_ == 4);
+    TEST_CHECK(channel.recovered(7));
+    TEST_CHECK(channel.recovered(6));
+    TEST_CHECK(channel.decoder_.recovered() == 2);
+    TEST_CHECK(channel.decoder_.kept() == 0);
+  }
+}
+
+void test_lengths()
+{
+  // The parity is as long as the longest datagram of its group, and the
+  // XOR of their lengths gives the length of the one rebuilt.
+  Channel channel(4, 1);
+  channel.send_all(1, 4);
+  channel.send(5, 300);
+  channel.send(6, 10, true);
+  channel.send(7, 1000);
+  channel.send(8, 50);
+  TEST_CHECK(channel.recovered(6));
+
+  channel.send(9, 300);
+  channel.send(10, 10);
+  channel.send(11, 1000, true);
+  channel.send(12, 0);
+  TEST_CHECK(channel.recovered(11));
+  TEST_CHECK(channel.decoder_.recovered() == 2);
+}
+
+void test_gap()
+{
+  // Datagram 7 is never encoded, e.g. while a peer without forward error
+  // correction is associated, so the block of 5 and 6 is abandoned.
+  Channel channel(4, 1);
+  channel.send_all(1, 4);
+  channel.send(5, 100);
+  channel.send(6, 100);
+  channel.send(8, 100);
+  channel.send(9, 100, true);
+  channel.send(10, 100);
+  TEST_CHECK(channel.parity_sent_ == 1);
+  channel.send(11, 100);
+  TEST_CHECK(channel.parity_sent_ == 2);
+  TEST_CHECK(channel.encoder_.parity_generated() == 2);
+
+  // The block that starts at 8 still rebuilds its loss.
+  TEST_CHECK(channel.recovered(9));
+  TEST_CHECK(channel.decoder_.unrecoverable() == 0);
+
+  // 5 and 6 are covered by no parity, and are kept until they leave the
+  // window.
+  TEST_CHECK(channel.decoder_.kept() == 2);
+  channel.send_all(12, window);
+  TEST_CHECK(channel.decoder_.kept() == 0);
+}
+
+void test_resend()
+{
+  Channel channel(4, 1);
+  channel.send_all(1, 8);
+  TEST_CHECK(channel.parity_sent_ == 2);
+
+  // A repair of 6 is not covered by parity, and does not disturb the
+  // block being encoded.
+  channel.send(9, 100);
+  channel.send(6, 100);
+  TEST_CHECK(channel.parity_sent_ == 2);
+  // Nor is it kept, since its block was resolved.
+  TEST_CHECK(channel.decoder_.kept() == 1);
+
+  channel.send(10, 100, true);
+  channel.send(11, 100);
+  channel.send(12, 100);
+  TEST_CHECK(channel.parity_sent_ == 3);
+  TEST_CHECK(channel.recovered(10));
+  TEST_CHECK(channel.decoder_.kept() == 0);
+}
+
+void test_no_parity()
+{
+  // Nothing is kept for a source that does not send parity.
+  Channel channel(4, 1);
+  channel.send_all(1, 3);
+  TEST_CHECK(channel.parity_sent_ == 0);
+  TEST_CHECK(channel.decoder_.kept() == 0);
+}
+
+}
+
+int ACE_TMAIN(int, ACE_TCHAR*[])
+{
+  test_single_loss();
+  test_two_losses();
+  test_lengths();
+  test_gap();
+  test_resend();
+  test_no_parity();
+  return 0;
+}
@@ -14,6 +14,7 @@
 #include "dds/DdsDcpsInfoUtilsC.h"
 #include "dds/DCPS/RTPS/RtpsCoreC.h"
 #include "dds/DCPS/RTPS/GuidGenerator.h"
+#include <cstring>
 #include <iostream>
 
 using namespace OpenDDS::RTPS;
@@ -496,6 +497,65 @@ Parameter get(const ParameterList& param_list,
   TEST_ASSERT(false); // Not found
 }
 
+// The serialized ParameterList of data, built by the conversion to a
+// ParameterList (direct = false) or by ParameterListWriter (direct = true).
+template <typename T>
+ACE_Message_Block* serialize(const T& data, bool direct)
+{
+  size_t size = 0, padding = 0;
+  ParameterList param_list;
+  ParameterListWriter sizer;
+  if (direct) {
+    TEST_ASSERT(to_param_list(data, sizer) == 0);
+    TEST_ASSERT(sizer.finish());
+    size = sizer.size();
+  } else {
+    TEST_ASSERT(to_param_list(data, param_list) == 0);
+    gen_find_size(param_list, size, padding);
+  }
+
+  ACE_Message_Block* mb = new ACE_Message_Block(size + padding);
+  Serializer ser(mb, false, Serializer::ALIGN_CDR);
+  if (direct) {
+    ParameterListWriter writer(&ser);
+    TEST_ASSERT(to_param_list(data, writer) == 0);
+    TEST_ASSERT(writer.finish());
+    TEST_ASSERT(writer.size() == size);
+  } else {
+    TEST_ASSERT(ser << param_list);
+  }
+  TEST_ASSERT(mb->length() == size);
+  return mb;
+}
+
+bool same_bytes(const ACE_Message_Block& a, const ACE_Message_Block& b)
+{
+  return a.length() == b.length()
+    && std::memcmp(a.rd_ptr(), b.rd_ptr(), a.length()) == 0;
+}
+
+// Read data from mb by way of a ParameterList (direct = false) or
+// straight from the stream (direct = true).
+template <typename T>
+int deserialize(const ACE_Message_Block& mb, T& data, bool direct)
+{
+  ACE_Message_Block* copy = mb.duplicate();
+  Serializer ser(copy, false, Serializer::ALIGN_CDR);
+  int result = -1;
+  if (direct) {
+    result = from_param_list(ser, data);
+  } else {
+    ParameterList param_list;
+    if (ser >> param_list) {
+      result = from_param_list(param_list, data);
+    }
+  }
+  // The whole list, with its sentinel, was read.
+  TEST_ASSERT(result != 0 || copy->length() == 0);
+  copy->release();
+  return result;
+}
+
 int
 ACE_TMAIN(int, ACE_TCHAR*[])
 {
@@ -3426,6 +3486,162 @@ ACE_TMAIN(int, ACE_TCHAR*[])
       TEST_ASSERT(!is_present(param_list, PID_GROUP_DATA));
       TEST_ASSERT(!is_present(param_list, PID_CONTENT_FILTER_PROPERTY));
     }
+    { // Should serialize writer data directly as the ParameterList would
+      DiscoveredWriterData writer_data = Factory::writer_data("Direct", "Type");
+      writer_data.ddsPublicationData.deadline.period.sec = 3;
+      writer_data.ddsPublicationData.reliability.kind = RELIABLE_RELIABILITY_QOS;
+      writer_data.ddsPublicationData.partition.name.length(2);
+      writer_data.ddsPublicationData.partition.name[0] = "A";
+      writer_data.ddsPublicationData.partition.name[1] = "B*";
+      writer_data.ddsPublicationData.user_data.value.length(3);
+      LocatorSeq locators;
+      locators.length(2);
+      locators[0] = Factory::locator(LOCATOR_KIND_UDPv4, 7400, 192, 168, 0, 1);
+      locators[1] = Factory::locator(LOCATOR_KIND_UDPv4, 7401, 239, 255, 0, 1);
+      writer_data.writerProxy.allLocators.length(1);
+      writer_data.writerProxy.allLocators[0].transport_type = "rtps_udp";
+      locators_to_blob(locators, writer_data.writerProxy.allLocators[0].data);
+
+      ACE_Message_Block* expected = serialize(writer_data, false);
+      ACE_Message_Block* actual = serialize(writer_data, true);
+      TEST_ASSERT(same_bytes(*expected, *actual));
+
+      DiscoveredWriterData from_list, direct;
+      TEST_ASSERT(deserialize(*expected, from_list, false) == 0);
+      TEST_ASSERT(deserialize(*expected, direct, true) == 0);
+      TEST_ASSERT(!std::strcmp(direct.ddsPublicationData.topic_name, "Direct"));
+      TEST_ASSERT(!std::strcmp(direct.ddsPublicationData.type_name, "Type"));
+      TEST_ASSERT(direct.ddsPublicationData.deadline.period.sec == 3);
+      TEST_ASSERT(direct.ddsPublicationData.reliability.kind == RELIABLE_RELIABILITY_QOS);
+      TEST_ASSERT(direct.ddsPublicationData.partition.name.length() == 2);
+      TEST_ASSERT(!std::strcmp(direct.ddsPublicationData.partition.name[1], "B*"));
+      TEST_ASSERT(direct.ddsPublicationData.user_data.value.length() == 3);
+      TEST_ASSERT(direct.writerProxy.remoteWriterGuid == writer_data.writerProxy.remoteWriterGuid);
+      TEST_ASSERT(direct.writerProxy.allLocators.length() == 1);
+      const DDS::OctetSeq& blob = direct.writerProxy.allLocators[0].data;
+      const DDS::OctetSeq& list_blob = from_list.writerProxy.allLocators[0].data;
+      TEST_ASSERT(blob.length() == list_blob.length());
+      TEST_ASSERT(!std::memcmp(blob.get_buffer(), list_blob.get_buffer(), blob.length()));
+
+      // Converting the result back gives the same bytes again.
+      ACE_Message_Block* again = serialize(direct, true);
+      TEST_ASSERT(same_bytes(*expected, *again));
+      again->release();
+      actual->release();
+      expected->release();
+    }
+    { // Should serialize reader data directly as the ParameterList would
+      DiscoveredReaderData reader_data = Factory::reader_data("Direct", "Type");
+      reader_data.ddsSubscriptionData.durability.kind = TRANSIENT_LOCAL_DURABILITY_QOS;
+      reader_data.ddsSubscriptionData.time_based_filter.minimum_separation.sec = 1;
+      reader_data.contentFilterProperty.contentFilteredTopicName = "CFT";
+      reader_data.contentFilterProperty.relatedTopicName = "Direct";
+      reader_data.contentFilterProperty.filterExpression = "a > %0";
+      reader_data.contentFilterProperty.expressionParameters.length(1);
+      reader_data.contentFilterProperty.expressionParameters[0] = "5";
+      reader_data.readerProxy.associatedWriters.length(1);
+      guid_generator.populate(reader_data.readerProxy.associatedWriters[0]);
+      reader_data.readerProxy.allLocators.length(1);
+      reader_data.readerProxy.allLocators[0].transport_type = "tcp";
+      reader_data.readerProxy.allLocators[0].data.length(5);
+
+      ACE_Message_Block* expected = serialize(reader_data, false);
+      ACE_Message_Block* actual = serialize(reader_data, true);
+      TEST_ASSERT(same_bytes(*expected, *actual));
+
+      DiscoveredReaderData direct;
+      TEST_ASSERT(deserialize(*expected, direct, true) == 0);
+      TEST_ASSERT(!std::strcmp(direct.ddsSubscriptionData.topic_name, "Direct"));
+      TEST_ASSERT(direct.ddsSubscriptionData.durability.kind == TRANSIENT_LOCAL_DURABILITY_QOS);
+      TEST_ASSERT(direct.ddsSubscriptionData.time_based_filter.minimum_separation.sec == 1);
+      TEST_ASSERT(!std::strcmp(direct.contentFilterProperty.filterExpression, "a > %0"));
+      TEST_ASSERT(!std::strcmp(direct.contentFilterProperty.filterClassName, "DDSSQL"));
+      TEST_ASSERT(direct.contentFilterProperty.expressionParameters.length() == 1);
+      TEST_ASSERT(direct.readerProxy.associatedWriters.length() == 1);
+      TEST_ASSERT(direct.readerProxy.associatedWriters[0] == reader_data.readerProxy.associatedWriters[0]);
+      TEST_ASSERT(direct.readerProxy.allLocators.length() == 1);
+      TEST_ASSERT(!std::strcmp(direct.readerProxy.allLocators[0].transport_type, "tcp"));
+      TEST_ASSERT(direct.readerProxy.allLocators[0].data.length() == 5);
+      actual->release();
+      expected->release();
+    }
+    { // Should serialize participant data directly as the ParameterList would
+      const char user_data[] = "user";
+      Locator_t locators[2];
+      locators[0] = Factory::locator(LOCATOR_KIND_UDPv4, 7410, 192, 168, 0, 1);
+      locators[1] = Factory::locator(LOCATOR_KIND_UDPv4, 7400, 239, 255, 0, 1);
+      GUID_t guid;
+      guid_generator.populate(guid);
+      char vendor_id[] = { 1, 3 };
+      SPDPdiscoveredParticipantData participant_data = Factory::spdp_participant(
+          user_data, sizeof user_data, 2, 4, vendor_id, &guid, true, 0x3f,
+          locators, 1, locators + 1, 1, locators, 1, locators + 1, 1, 7, 30, 0);
+
+      ACE_Message_Block* expected = serialize(participant_data, false);
+      ACE_Message_Block* actual = serialize(participant_data, true);
+      TEST_ASSERT(same_bytes(*expected, *actual));
+
+      SPDPdiscoveredParticipantData direct;
+      TEST_ASSERT(deserialize(*expected, direct, true) == 0);
+      TEST_ASSERT(direct.ddsParticipantData.user_data.value.length() == sizeof user_data);
+      TEST_ASSERT(!std::memcmp(direct.participantProxy.guidPrefix, guid.guidPrefix, sizeof(GuidPrefix_t)));
+      TEST_ASSERT(direct.participantProxy.expectsInlineQos);
+      TEST_ASSERT(direct.participantProxy.availableBuiltinEndpoints == 0x3f);
+      TEST_ASSERT(direct.participantProxy.metatrafficUnicastLocatorList.length() == 1);
+      TEST_ASSERT(direct.participantProxy.defaultMulticastLocatorList.length() == 1);
+      TEST_ASSERT(direct.participantProxy.defaultMulticastLocatorList[0].port == 7400);
+      TEST_ASSERT(direct.participantProxy.manualLivelinessCount.value == 7);
+      TEST_ASSERT(direct.leaseDuration.seconds == 30);
+      actual->release();
+      expected->release();
+    }
+    { // Should reject an incompatible parameter when reading directly
+      ParameterList param_list;
+      TEST_ASSERT(!to_param_list(Factory::default_participant_data(), param_list));
+      const CORBA::ULong length = param_list.length();
+      param_list.length(length + 1);
+      param_list[length].unknown_data(DDS::OctetSeq());
+      param_list[length]._d(0x4001 /* PIDMASK_INCOMPATIBLE */);
+      size_t size = 0, padding = 0;
+      gen_find_size(param_list, size, padding);
+      ACE_Message_Block mb(size + padding);
+      Serializer ser(&mb, false, Serializer::ALIGN_CDR);
+      TEST_ASSERT(ser << param_list);
+
+      SPDPdiscoveredParticipantData from_list, direct;
+      TEST_ASSERT(deserialize(mb, from_list, false) == -1);
+      TEST_ASSERT(deserialize(mb, direct, true) == -1);
+    }
+    { // Should read ICE agent info in the same pass as writer data
+      DiscoveredWriterData writer_data = Factory::writer_data("Direct", "Type");
+      OpenDDS::ICE::AgentInfo agent_info;
+      agent_info.type = OpenDDS::ICE::LITE;
+      agent_info.username = "user";
+      agent_info.password = "password";
+
+      ParameterListWriter sizer;
+      TEST_ASSERT(!to_param_list(writer_data, sizer));
+      TEST_ASSERT(!to_param_list(agent_info, sizer));
+      TEST_ASSERT(sizer.finish());
+      ACE_Message_Block mb(sizer.size());
+      Serializer ser(&mb, false, Serializer::ALIGN_CDR);
+      ParameterListWriter writer(&ser);
+      TEST_ASSERT(!to_param_list(writer_data, writer));
+      TEST_ASSERT(!to_param_list(agent_info, writer));
+      TEST_ASSERT(writer.finish());
+      TEST_ASSERT(mb.length() == sizer.size());
+
+      Serializer in(&mb, false, Serializer::ALIGN_CDR);
+      DiscoveredWriterData direct;
+      OpenDDS::ICE::AgentInfo agent_info_out;
+      bool have_agent_info = false;
+      TEST_ASSERT(!from_param_list(in, direct, agent_info_out, have_agent_info));
+      TEST_ASSERT(have_agent_info);
+      TEST_ASSERT(agent_info_out.type == OpenDDS::ICE::LITE);
+      TEST_ASSERT(agent_info_out.username == "user");
+      TEST_ASSERT(agent_info_out.password == "password");
+      TEST_ASSERT(!std::strcmp(direct.ddsPublicationData.topic_name, "Direct"));
+    }
   }
   catch (char const *ex)
   {
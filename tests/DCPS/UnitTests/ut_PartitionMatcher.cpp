@@ -0,0 +1,103 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "ace/OS_main.h"
+#include "../common/TestSupport.h"
+#include "dds/DCPS/PartitionMatcher.h"
+
+using OpenDDS::DCPS::PartitionMatcher;
+
+namespace {
+
+DDS::PartitionQosPolicy partitions(const char* a = 0, const char* b = 0)
+{
+  DDS::PartitionQosPolicy qos;
+  qos.name.length((a ? 1 : 0) + (b ? 1 : 0));
+  if (a) {
+    qos.name[0] = a;
+  }
+  if (b) {
+    qos.name[1] = b;
+  }
+  return qos;
+}
+
+bool match(const DDS::PartitionQosPolicy& pub, const DDS::PartitionQosPolicy& sub)
+{
+  PartitionMatcher& matcher = *PartitionMatcher::instance();
+  const bool cached = matcher.match(pub, sub);
+  // The cached result is the same as comparing again.
+  TEST_CHECK(cached == matcher.match(pub, sub));
+  TEST_CHECK(cached == PartitionMatcher::match_i(*matcher.compile(pub), *matcher.compile(sub)));
+  return cached;
+}
+
+bool pattern(const char* pattern, const char* name)
+{
+  return PartitionMatcher::Pattern(pattern).matches(name);
+}
+
+}
+
+int ACE_TMAIN(int, ACE_TCHAR*[])
+{
+  {
+    // Patterns
+    TEST_CHECK(pattern("*", ""));
+    TEST_CHECK(pattern("*", "abc"));
+    TEST_CHECK(pattern("a*c", "abbbc"));
+    TEST_CHECK(!pattern("a*c", "abcd"));
+    TEST_CHECK(pattern("a**c*", "ac"));
+    TEST_CHECK(pattern("a?c", "abc"));
+    TEST_CHECK(!pattern("a?c", "ac"));
+    TEST_CHECK(pattern("[ab]x", "bx"));
+    TEST_CHECK(!pattern("[ab]x", "cx"));
+    TEST_CHECK(pattern("[a-c]", "b"));
+    TEST_CHECK(!pattern("[!a-c]", "b"));
+    TEST_CHECK(pattern("[!a-c]", "d"));
+    TEST_CHECK(pattern("[]]", "]"));
+    TEST_CHECK(pattern("a[b", "a[b"));
+    TEST_CHECK(pattern("a\\*", "a*"));
+    TEST_CHECK(!pattern("a\\*", "ab"));
+    TEST_CHECK(pattern("*/site-?", "region/1/site-7"));
+  }
+
+  {
+    // Default partitions
+    TEST_CHECK(match(partitions(), partitions()));
+    TEST_CHECK(match(partitions(), partitions("")));
+    TEST_CHECK(match(partitions("", "A"), partitions("B", "")));
+    TEST_CHECK(!match(partitions(), partitions("A")));
+    TEST_CHECK(!match(partitions("A"), partitions()));
+    // A subscriber's wildcard matches a publisher without partitions.
+    TEST_CHECK(match(partitions(), partitions("*")));
+    TEST_CHECK(!match(partitions(), partitions("?")));
+  }
+
+  {
+    // Literals and wildcards
+    TEST_CHECK(match(partitions("A", "B"), partitions("C", "B")));
+    TEST_CHECK(!match(partitions("A", "B"), partitions("C", "D")));
+    TEST_CHECK(match(partitions("A*"), partitions("Ab")));
+    TEST_CHECK(match(partitions("Ab"), partitions("A*")));
+    // Two wildcards never match.
+    TEST_CHECK(!match(partitions("A*"), partitions("A*")));
+    // An escaped wildcard is a literal name.
+    TEST_CHECK(match(partitions("A\\*"), partitions("A\\*")));
+  }
+
+  {
+    // Lists with the same names in another order share their compiled form.
+    PartitionMatcher& matcher = *PartitionMatcher::instance();
+    TEST_CHECK(matcher.compile(partitions("A", "B")) == matcher.compile(partitions("B", "A")));
+    TEST_CHECK(matcher.compile(partitions("A")) != matcher.compile(partitions("B")));
+    TEST_CHECK(matcher.compile(partitions())->is_default());
+    TEST_CHECK(!matcher.compile(partitions("A"))->is_default());
+  }
+
+  return 0;
+}
@@ -0,0 +1,215 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "ace/OS_main.h"
+#include "ace/OS_NS_string.h"
+
+#include "dds/DCPS/DataSampleHeader.h"
+#include "dds/DCPS/transport/framework/TransportInst.h"
+#include "dds/DCPS/transport/framework/TransportReceiveStrategy_T.h"
+
+#include "../common/TestSupport.h"
+
+#include <algorithm>
+#include <string>
+
+using namespace OpenDDS::DCPS;
+
+namespace {
+
+class TestInst : public TransportInst {
+public:
+  TestInst() : TransportInst("test", "receive_pool_test") {}
+
+  bool is_reliable() const { return true; }
+  size_t populate_locator(TransportLocator&) const { return 0; }
+
+private:
+  TransportImpl_rch new_impl() { return TransportImpl_rch(); }
+};
+
+/// Receives a byte stream, at most max_receive_ bytes per receive as a
+/// stream socket would, and keeps the samples it delivers while hold_ is
+/// set, so that their data blocks stay in use.
+class TestStrategy : public TransportReceiveStrategy<> {
+public:
+  explicit TestStrategy(const TransportInst& config)
+    : TransportReceiveStrategy<>(config)
+    , max_receive_(0)
+    , hold_(false)
+    , delivered_(0)
+  {}
+
+  /// Receive @a count samples of @a size bytes, @a max_receive bytes at
+  /// a time.
+  void receive(size_t count, size_t size, size_t max_receive)
+  {
+    for (size_t i = 0; i < count; ++i) {
+      stream_ += packet(size);
+    }
+    max_receive_ = max_receive;
+    while (!stream_.empty()) {
+      TEST_CHECK(handle_dds_input(ACE_INVALID_HANDLE) == 0);
+    }
+  }
+
+  size_t max_receive_;
+  bool hold_;
+  size_t delivered_;
+  OPENDDS_VECTOR(ReceivedDataSample) held_;
+
+private:
+  static std::string packet(size_t size)
+  {
+    DataSampleHeader sample_header;
+    sample_header.message_length_ = static_cast<ACE_UINT32>(size);
+    ACE_Message_Block sample_mb(DataSampleHeader::max_marshaled_size());
+    TEST_CHECK(sample_mb << sample_header);
+
+    TransportHeader header;
+    header.length_ = static_cast<ACE_UINT32>(sample_mb.length() + size);
+    ACE_Message_Block mb(TransportHeader::max_marshaled_size());
+    TEST_CHECK(mb << header);
+
+    return std::string(mb.rd_ptr(), mb.length()) +
+      std::string(sample_mb.rd_ptr(), sample_mb.length()) +
+      std::string(size, 'x');
+  }
+
+  ssize_t receive_bytes(iovec iov[], int n, ACE_INET_Addr&, ACE_HANDLE, bool&)
+  {
+    size_t received = 0;
+    for (int i = 0; i < n && received < max_receive_ && received < stream_.size(); ++i) {
+      const size_t amount = std::min(static_cast<size_t>(iov[i].iov_len),
+                                     std::min(max_receive_ - received,
+                                              stream_.size() - received));
+      ACE_OS::memcpy(iov[i].iov_base, stream_.data() + received, amount);
+      received += amount;
+    }
+    stream_.erase(0, received);
+    return static_cast<ssize_t>(received);
+  }
+
+  void deliver_sample(ReceivedDataSample& sample, const ACE_INET_Addr&)
+  {
+    ++delivered_;
+    if (hold_) {
+      held_.push_back(sample);
+    }
+  }
+
+  int start_i() { return 0; }
+  void stop_i() {}
+
+  std::string stream_;
+};
+
+const size_t segment_blocks = 32;
+const size_t large_size = 60000;
+const size_t small_size = 200;
+
+RcHandle<TestInst> make_inst(size_t max_blocks)
+{
+  RcHandle<TestInst> inst = make_rch<TestInst>();
+  inst->receive_buffers_ = 16;
+  inst->receive_buffer_low_water_ = 4096;
+  inst->receive_data_blocks_ = segment_blocks;
+  inst->receive_data_blocks_max_ = max_blocks;
+  return inst;
+}
+
+void test_small_packets()
+{
+  RcHandle<TestInst> inst = make_inst(4 * segment_blocks);
+  RcHandle<TestStrategy> strategy = make_rch<TestStrategy>(ref(*inst));
+
+  // Enough datagram-sized receives to go through several buffers.
+  strategy->receive(2000, small_size, small_size + 64);
+  TEST_CHECK(strategy->delivered_ == 2000);
+
+  const ReceiveBufferPoolStats stats = strategy->pool_stats();
+  TEST_CHECK(stats.data_hits > 1);
+  TEST_CHECK(stats.data_misses == 0);
+  TEST_CHECK(stats.message_block_misses == 0);
+  TEST_CHECK(stats.segments == 1);
+  TEST_CHECK(stats.data_blocks == segment_blocks);
+  TEST_CHECK(stats.grows == 0);
+  TEST_CHECK(stats.receive_peak < 1024);
+  TEST_CHECK(stats.high_water == 2);
+}
+
+void test_grow_and_release()
+{
+  RcHandle<TestInst> inst = make_inst(4 * segment_blocks);
+  RcHandle<TestStrategy> strategy = make_rch<TestStrategy>(ref(*inst));
+
+  // Large samples received four at a time, all held by the "reader":
+  // the first segment cannot hold both them and the ring.
+  strategy->hold_ = true;
+  strategy->receive(30, large_size, 4 * large_size);
+  TEST_CHECK(strategy->held_.size() == 30);
+
+  ReceiveBufferPoolStats stats = strategy->pool_stats();
+  TEST_CHECK(stats.receive_peak >= 3 * large_size);
+  TEST_CHECK(stats.high_water > 2);
+  TEST_CHECK(stats.segments > 1);
+  TEST_CHECK(stats.grows == stats.segments - 1);
+  TEST_CHECK(stats.data_misses == 0);
+  TEST_CHECK(stats.shrinks == 0);
+  const unsigned long hits = stats.data_hits;
+
+  // Once the samples are released and the link's packets are small, the
+  // grown segments are idle and are deleted.
+  strategy->hold_ = false;
+  strategy->held_.clear();
+  strategy->receive(20000, small_size, small_size + 64);
+
+  stats = strategy->pool_stats();
+  TEST_CHECK(stats.high_water == 2);
+  TEST_CHECK(stats.segments == 1);
+  TEST_CHECK(stats.shrinks == stats.grows);
+  TEST_CHECK(stats.shrinks > 0);
+  // The counters of the deleted segments are kept.
+  TEST_CHECK(stats.data_hits > hits);
+  TEST_CHECK(stats.data_misses == 0);
+}
+
+void test_overflow()
+{
+  // The pool may not grow, so blocks held beyond the first segment come
+  // from the heap.
+  RcHandle<TestInst> inst = make_inst(segment_blocks);
+  RcHandle<TestStrategy> strategy = make_rch<TestStrategy>(ref(*inst));
+
+  strategy->hold_ = true;
+  strategy->receive(2 * segment_blocks, large_size, large_size);
+  TEST_CHECK(strategy->held_.size() == 2 * segment_blocks);
+
+  ReceiveBufferPoolStats stats = strategy->pool_stats();
+  TEST_CHECK(stats.segments == 1);
+  TEST_CHECK(stats.grows == 0);
+  TEST_CHECK(stats.data_hits >= segment_blocks);
+  TEST_CHECK(stats.data_misses > 0);
+
+  // Nothing is left over once the samples are released.
+  strategy->held_.clear();
+  strategy->hold_ = false;
+  strategy->receive(10, small_size, small_size);
+  stats = strategy->pool_stats();
+  TEST_CHECK(stats.segments == 1);
+  TEST_CHECK(stats.shrinks == 0);
+}
+
+}
+
+int ACE_TMAIN(int, ACE_TCHAR*[])
+{
+  test_small_packets();
+  test_grow_and_release();
+  test_overflow();
+  return 0;
+}
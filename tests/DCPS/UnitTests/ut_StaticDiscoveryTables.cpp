@@ -0,0 +1,137 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "ace/OS_main.h"
+#include "../common/TestSupport.h"
+#include "dds/DCPS/StaticDiscovery.h"
+#include "dds/DCPS/Service_Participant.h"
+#include "dds/DCPS/Qos_Helper.h"
+
+#include <cstring>
+
+using namespace OpenDDS::DCPS;
+
+namespace {
+
+TransportLocatorSeq locators(unsigned char port)
+{
+  TransportLocatorSeq seq;
+  seq.length(1);
+  seq[0].transport_type = "rtps_udp";
+  seq[0].data.length(1);
+  seq[0].data[0] = port;
+  return seq;
+}
+
+RepoId id(unsigned char participant, unsigned char entity, bool writer)
+{
+  const unsigned char part[6] = { 0, 0, 0, 0, 0, participant };
+  const unsigned char key[3] = { 0, 0, entity };
+  return EndpointRegistry::build_id(7, part,
+    EndpointRegistry::build_id(key, writer ? ENTITYKIND_USER_WRITER_WITH_KEY
+                                           : ENTITYKIND_USER_READER_WITH_KEY));
+}
+
+void add_writer(EndpointRegistry& registry, const RepoId& rid, const char* topic)
+{
+  DDS::DataWriterQos qos(TheServiceParticipant->initial_DataWriterQos());
+  qos.user_data.value.length(3);
+  std::memcpy(qos.user_data.value.get_buffer(), rid.entityId.entityKey, 3);
+  registry.writer_map.insert(std::make_pair(rid,
+    EndpointRegistry::Writer(topic, qos, TheServiceParticipant->initial_PublisherQos(),
+                             "", locators(rid.guidPrefix[11]))));
+}
+
+void add_reader(EndpointRegistry& registry, const RepoId& rid, const char* topic,
+                bool reliable)
+{
+  DDS::DataReaderQos qos(TheServiceParticipant->initial_DataReaderQos());
+  qos.reliability.kind = reliable ? DDS::RELIABLE_RELIABILITY_QOS : DDS::BEST_EFFORT_RELIABILITY_QOS;
+  qos.user_data.value.length(3);
+  std::memcpy(qos.user_data.value.get_buffer(), rid.entityId.entityKey, 3);
+  registry.reader_map.insert(std::make_pair(rid,
+    EndpointRegistry::Reader(topic, qos, TheServiceParticipant->initial_SubscriberQos(),
+                             "reader_config", locators(rid.guidPrefix[11]))));
+}
+
+void add_topic(EndpointRegistry& registry, const char* key, const char* name)
+{
+  EndpointRegistry::Topic topic;
+  topic.name = name;
+  topic.type_name = "Messenger::Message";
+  registry.topic_map[key] = topic;
+}
+
+}
+
+int ACE_TMAIN(int, ACE_TCHAR*[])
+{
+  EndpointRegistry parsed;
+  add_topic(parsed, "movies", "Movie Discussion List");
+  add_topic(parsed, "weather", "Weather");
+  add_writer(parsed, id(1, 1, true), "Movie Discussion List");
+  add_writer(parsed, id(1, 2, true), "Weather");
+  add_reader(parsed, id(2, 1, false), "Movie Discussion List", true);
+  add_reader(parsed, id(2, 2, false), "Weather", false);
+  add_reader(parsed, id(3, 1, false), "Movie Discussion List", false);
+  // Not matched with the writer of its own participant.
+  add_reader(parsed, id(1, 3, false), "Weather", true);
+  parsed.match();
+
+  const StaticDiscoveryTableBuilder builder(parsed);
+  TEST_CHECK(builder.good());
+  const StaticDiscoveryTables& tables = builder.tables();
+  TEST_CHECK(tables.topic_count == 2);
+  TEST_CHECK(tables.endpoint_count == 6);
+  TEST_CHECK(tables.match_count == 3);
+  // The QoS without the user data and the group QoS are the same.
+  TEST_CHECK(tables.writer_qos_count == 1);
+  TEST_CHECK(tables.reader_qos_count == 2);
+  TEST_CHECK(tables.publisher_qos_count == 1);
+  TEST_CHECK(tables.locator_count == 3);
+
+  const OPENDDS_STRING cpp = builder.to_cpp("test_tables");
+  TEST_CHECK(cpp.find("const OpenDDS::DCPS::StaticDiscoveryTables test_tables = {") != OPENDDS_STRING::npos);
+  TEST_CHECK(cpp.find("\"Movie Discussion List\"") != OPENDDS_STRING::npos);
+
+  const StaticDiscovery_rch loaded = make_rch<StaticDiscovery>("ut_StaticDiscoveryTables");
+  TEST_CHECK(loaded->load_tables(tables) == 0);
+  const EndpointRegistry& registry = loaded->registry;
+
+  TEST_CHECK(registry.topic_map.size() == 2);
+  TEST_CHECK(registry.topic_map.find("movies")->second.name == "Movie Discussion List");
+  TEST_CHECK(registry.writer_map.size() == parsed.writer_map.size());
+  TEST_CHECK(registry.reader_map.size() == parsed.reader_map.size());
+
+  for (EndpointRegistry::WriterMapType::const_iterator p = parsed.writer_map.begin();
+       p != parsed.writer_map.end(); ++p) {
+    const EndpointRegistry::WriterMapType::const_iterator l = registry.writer_map.find(p->first);
+    TEST_CHECK(l != registry.writer_map.end());
+    TEST_CHECK(l->second.topic_name == p->second.topic_name);
+    TEST_CHECK(l->second.qos == p->second.qos);
+    TEST_CHECK(l->second.publisher_qos == p->second.publisher_qos);
+    TEST_CHECK(l->second.trans_info[0].data[0] == p->second.trans_info[0].data[0]);
+    TEST_CHECK(l->second.best_effort_readers == p->second.best_effort_readers);
+    TEST_CHECK(l->second.reliable_readers == p->second.reliable_readers);
+  }
+
+  for (EndpointRegistry::ReaderMapType::const_iterator p = parsed.reader_map.begin();
+       p != parsed.reader_map.end(); ++p) {
+    const EndpointRegistry::ReaderMapType::const_iterator l = registry.reader_map.find(p->first);
+    TEST_CHECK(l != registry.reader_map.end());
+    TEST_CHECK(l->second.topic_name == p->second.topic_name);
+    TEST_CHECK(l->second.qos == p->second.qos);
+    TEST_CHECK(l->second.trans_cfg == "reader_config");
+    TEST_CHECK(l->second.best_effort_writers == p->second.best_effort_writers);
+    TEST_CHECK(l->second.reliable_writers == p->second.reliable_writers);
+  }
+
+  // Loading the same endpoints again fails.
+  TEST_CHECK(loaded->load_tables(tables) != 0);
+
+  return 0;
+}
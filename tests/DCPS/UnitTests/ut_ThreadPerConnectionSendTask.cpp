@@ -0,0 +1,274 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "ace/OS_main.h"
+#include "ace/Atomic_Op.h"
+#include "ace/OS_NS_sys_time.h"
+#include "ace/OS_NS_unistd.h"
+#include "ace/Thread_Manager.h"
+#include "ace/Thread_Mutex.h"
+#include "ace/Thread_Semaphore.h"
+
+#include "dds/DCPS/ReactorTask.h"
+#include "dds/DCPS/transport/framework/DataLink.h"
+#include "dds/DCPS/transport/framework/TransportImpl.h"
+#include "dds/DCPS/transport/framework/TransportInst.h"
+#include "dds/DCPS/transport/framework/TransportQueueElement.h"
+
+#include "../common/TestSupport.h"
+
+using namespace OpenDDS::DCPS;
+
+namespace {
+
+typedef ACE_Atomic_Op<ACE_Thread_Mutex, long> Counter;
+
+/// Holds the send thread in the release of an element until opened.
+struct Gate {
+  Gate() : entered_(0), open_(0) {}
+  ACE_Thread_Semaphore entered_;
+  ACE_Thread_Semaphore open_;
+};
+
+/// A sample that counts its release.  The DataLinks of this test have
+/// no send strategy, so the send thread releases (drops) each sample as
+/// soon as it takes it out of the queue.
+class TestElement : public TransportQueueElement {
+public:
+  TestElement(Counter& released,
+              const ACE_Time_Value& max_blocking = ACE_Time_Value::max_time,
+              Gate* gate = 0)
+    : TransportQueueElement(1)
+    , released_(released)
+    , max_blocking_(max_blocking)
+    , gate_(gate)
+  {}
+
+  RepoId publication_id() const { return GUID_UNKNOWN; }
+  ACE_Time_Value max_blocking_time() const { return max_blocking_; }
+  const ACE_Message_Block* msg() const { return 0; }
+  const ACE_Message_Block* msg_payload() const { return 0; }
+  bool owned_by_transport() { return false; }
+
+private:
+  void release_element(bool)
+  {
+    if (gate_) {
+      gate_->entered_.release();
+      gate_->open_.acquire();
+    }
+    ++released_;
+    delete this;
+  }
+
+  Counter& released_;
+  const ACE_Time_Value max_blocking_;
+  Gate* const gate_;
+};
+
+class TestInst : public TransportInst {
+public:
+  TestInst() : TransportInst("test", "send_task_test") {}
+
+  bool is_reliable() const { return true; }
+  size_t populate_locator(TransportLocator&) const { return 0; }
+
+private:
+  TransportImpl_rch new_impl() { return TransportImpl_rch(); }
+};
+
+class TestImpl : public TransportImpl {
+public:
+  explicit TestImpl(TransportInst& inst) : TransportImpl(inst) {}
+
+  void stop_reactor() { reactor_task()->stop(); }
+
+  OPENDDS_STRING transport_type() const { return "test"; }
+
+private:
+  bool connection_info_i(TransportLocator&) const { return false; }
+  AcceptConnectResult connect_datalink(const RemoteTransport&,
+                                       const ConnectionAttribs&,
+                                       const TransportClient_rch&)
+  { return AcceptConnectResult(); }
+  AcceptConnectResult accept_datalink(const RemoteTransport&,
+                                      const ConnectionAttribs&,
+                                      const TransportClient_rch&)
+  { return AcceptConnectResult(); }
+  void stop_accepting_or_connecting(const TransportClient_wrch&, const RepoId&) {}
+  void shutdown_i() {}
+  void release_datalink(DataLink*) {}
+};
+
+/// A DataLink with a thread_per_connection send thread whose queue
+/// holds at most @a queue_max samples.
+struct Fixture {
+  Fixture(const char* backpressure, size_t queue_max)
+    : inst_(make_rch<TestInst>())
+  {
+    inst_->thread_per_connection_ = true;
+    inst_->thread_per_connection_queue_max_ = queue_max;
+    inst_->thread_per_connection_backpressure_ = backpressure;
+    impl_ = make_rch<TestImpl>(ref(*inst_));
+    impl_->create_reactor_task();
+    link_ = make_rch<DataLink>(ref(*impl_), Priority(0), false, false);
+  }
+
+  ~Fixture()
+  {
+    link_.reset();
+    impl_->stop_reactor();
+  }
+
+  SendTaskStats stats() const
+  {
+    TransportImpl::SendTaskStatsSeq stats;
+    impl_->send_task_stats(stats);
+    TEST_CHECK(stats.size() == 1);
+    return stats.empty() ? SendTaskStats() : stats[0];
+  }
+
+  RcHandle<TestInst> inst_;
+  RcHandle<TestImpl> impl_;
+  DataLink_rch link_;
+};
+
+/// Wait up to two seconds for @a counter to reach @a value.
+bool wait_for(const Counter& counter, long value)
+{
+  for (int i = 0; i < 200 && counter.value() < value; ++i) {
+    ACE_OS::sleep(ACE_Time_Value(0, 10000));
+  }
+  return counter.value() == value;
+}
+
+void test_fail()
+{
+  Fixture f("fail", 2);
+  Gate gate;
+  Counter first(0), queued(0), rejected(0);
+
+  f.link_->send(new TestElement(first, ACE_Time_Value::max_time, &gate));
+  gate.entered_.acquire();
+
+  // The thread is busy, so these two fill the queue.
+  f.link_->send(new TestElement(queued));
+  f.link_->send(new TestElement(queued));
+  TEST_CHECK(queued == 0);
+
+  // The next one is rejected and released right away.
+  f.link_->send(new TestElement(rejected));
+  TEST_CHECK(rejected == 1);
+  TEST_CHECK(queued == 0);
+
+  const SendTaskStats stats = f.stats();
+  TEST_CHECK(stats.rejected_ == 1);
+  TEST_CHECK(stats.dropped_ == 0);
+  TEST_CHECK(stats.blocked_ == 0);
+
+  gate.open_.release();
+  TEST_CHECK(wait_for(first, 1));
+  TEST_CHECK(wait_for(queued, 2));
+}
+
+void test_drop_oldest()
+{
+  Fixture f("drop_oldest", 2);
+  Gate gate;
+  Counter first(0), oldest(0), newer(0);
+
+  f.link_->send(new TestElement(first, ACE_Time_Value::max_time, &gate));
+  gate.entered_.acquire();
+
+  f.link_->send(new TestElement(oldest));
+  f.link_->send(new TestElement(newer));
+
+  // Making room for this one drops the oldest queued sample.
+  f.link_->send(new TestElement(newer));
+  TEST_CHECK(oldest == 1);
+  TEST_CHECK(newer == 0);
+
+  const SendTaskStats stats = f.stats();
+  TEST_CHECK(stats.dropped_ == 1);
+  TEST_CHECK(stats.rejected_ == 0);
+
+  gate.open_.release();
+  TEST_CHECK(wait_for(first, 1));
+  TEST_CHECK(wait_for(newer, 2));
+}
+
+struct BlockedSend {
+  DataLink* link_;
+  Counter* released_;
+  Counter sent_;
+};
+
+ACE_THR_FUNC_RETURN send_blocked(void* arg)
+{
+  BlockedSend* const send = static_cast<BlockedSend*>(arg);
+  send->link_->send(new TestElement(*send->released_));
+  ++send->sent_;
+  return 0;
+}
+
+void test_block()
+{
+  Fixture f("block", 1);
+  Gate gate;
+  Counter first(0), queued(0), timed_out(0), waited(0);
+
+  f.link_->send(new TestElement(first, ACE_Time_Value::max_time, &gate));
+  gate.entered_.acquire();
+
+  f.link_->send(new TestElement(queued));
+
+  // The queue stays full, so this one is dropped once its writer's
+  // max_blocking_time has passed.
+  const ACE_Time_Value max_blocking(0, 100000);
+  const ACE_Time_Value start = ACE_OS::gettimeofday();
+  f.link_->send(new TestElement(timed_out, max_blocking));
+  const ACE_Time_Value elapsed = ACE_OS::gettimeofday() - start;
+  TEST_CHECK(timed_out == 1);
+  TEST_CHECK(elapsed >= ACE_Time_Value(0, 90000));
+  TEST_CHECK(elapsed < ACE_Time_Value(5));
+
+  SendTaskStats stats = f.stats();
+  TEST_CHECK(stats.blocked_ == 1);
+  TEST_CHECK(stats.timed_out_ == 1);
+
+  // Without a max_blocking_time the writer waits until there is room.
+  BlockedSend send;
+  send.link_ = f.link_.in();
+  send.released_ = &waited;
+  send.sent_ = 0;
+  TEST_CHECK(ACE_Thread_Manager::instance()->spawn(send_blocked, &send) != -1);
+  ACE_OS::sleep(ACE_Time_Value(0, 200000));
+  TEST_CHECK(send.sent_ == 0);
+
+  gate.open_.release();
+  ACE_Thread_Manager::instance()->wait();
+  TEST_CHECK(send.sent_ == 1);
+  TEST_CHECK(wait_for(first, 1));
+  TEST_CHECK(wait_for(queued, 1));
+  TEST_CHECK(wait_for(waited, 1));
+
+  stats = f.stats();
+  TEST_CHECK(stats.blocked_ == 2);
+  TEST_CHECK(stats.timed_out_ == 1);
+  TEST_CHECK(stats.rejected_ == 0);
+  TEST_CHECK(stats.dropped_ == 0);
+}
+
+}
+
+int ACE_TMAIN(int, ACE_TCHAR*[])
+{
+  test_fail();
+  test_drop_oldest();
+  test_block();
+  return 0;
+}
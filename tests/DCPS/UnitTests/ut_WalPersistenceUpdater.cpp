@@ -0,0 +1,269 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "ace/OS_main.h"
+#include "ace/ARGV.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_unistd.h"
+
+#include "dds/DCPS/RepoIdBuilder.h"
+#include "dds/InfoRepo/UpdateManager.h"
+#include "dds/InfoRepo/WalPersistenceUpdater.h"
+
+#include "../common/TestSupport.h"
+
+#include <string>
+
+using Update::WalPersistenceUpdater;
+
+namespace {
+
+const char log_path[] = "ut_wal.log";
+const char snapshot_path[] = "ut_wal.snapshot";
+
+/// The size of a file header: magic, version and sequence number.
+const size_t header_size = 16;
+
+const Update::DomainIdType domain = 0;
+
+bool start(WalPersistenceUpdater& updater, const ACE_TCHAR* options)
+{
+  ACE_ARGV args((ACE_TString(ACE_TEXT("-file ut_wal ")) + options).c_str());
+  return updater.init(args.argc(), args.argv()) == 0;
+}
+
+bool read_file(const char* path, std::string& data)
+{
+  data.clear();
+  FILE* const file = ACE_OS::fopen(path, ACE_TEXT("rb"));
+  if (!file) {
+    return false;
+  }
+  char block[4096];
+  size_t n;
+  while ((n = ACE_OS::fread(block, 1, sizeof block, file)) > 0) {
+    data.append(block, n);
+  }
+  ACE_OS::fclose(file);
+  return true;
+}
+
+size_t file_size(const char* path)
+{
+  std::string data;
+  read_file(path, data);
+  return data.size();
+}
+
+void write_file(const char* path, const std::string& data)
+{
+  FILE* const file = ACE_OS::fopen(path, ACE_TEXT("wb"));
+  TEST_CHECK(file != 0);
+  if (file) {
+    TEST_CHECK(ACE_OS::fwrite(data.data(), 1, data.size(), file) == data.size());
+    ACE_OS::fclose(file);
+  }
+}
+
+Update::IdType make_id(long participant, long key,
+                       OpenDDS::DCPS::EntityKind kind)
+{
+  OpenDDS::DCPS::RepoId id;
+  OpenDDS::DCPS::RepoIdBuilder builder(id);
+  builder.federationId(1);
+  builder.participantId(participant);
+  builder.entityKey(key);
+  builder.entityKind(kind, false);
+  return id;
+}
+
+Update::IdType participant_id(long participant)
+{
+  return make_id(participant, 0, OpenDDS::DCPS::KIND_PARTICIPANT);
+}
+
+Update::IdType topic_id(long participant, long key)
+{
+  return make_id(participant, key, OpenDDS::DCPS::KIND_USER_TOPIC);
+}
+
+// Like the repository's operations, each of these waits in sync() until
+// its record is committed.
+
+void create_participant(WalPersistenceUpdater& updater, long participant)
+{
+  DDS::DomainParticipantQos qos = DDS::DomainParticipantQos();
+  updater.create(Update::UParticipant(domain, 0, participant_id(participant), qos));
+  updater.sync();
+}
+
+void create_topic(WalPersistenceUpdater& updater, long participant, long key)
+{
+  DDS::TopicQos qos = DDS::TopicQos();
+  updater.create(Update::UTopic(domain, topic_id(participant, key),
+                                participant_id(participant),
+                                "WalTopic", "Messenger::Message", qos));
+  updater.sync();
+}
+
+void destroy_participant(WalPersistenceUpdater& updater, long participant)
+{
+  updater.destroy(Update::IdPath(domain, participant_id(participant),
+                                 participant_id(participant)),
+                  Update::Participant, Update::DataWriter);
+  updater.sync();
+}
+
+void destroy_topic(WalPersistenceUpdater& updater, long participant, long key)
+{
+  updater.destroy(Update::IdPath(domain, participant_id(participant),
+                                 topic_id(participant, key)),
+                  Update::Topic, Update::DataWriter);
+  updater.sync();
+}
+
+void test_torn_tail()
+{
+  size_t committed = 0;
+  {
+    WalPersistenceUpdater updater;
+    TEST_CHECK(start(updater, ACE_TEXT("-reset 1")));
+    create_participant(updater, 1);
+    create_topic(updater, 1, 1);
+    create_topic(updater, 1, 2);
+    committed = file_size(log_path);
+    create_topic(updater, 1, 3);
+    TEST_CHECK(file_size(log_path) > committed);
+    updater.fini();
+  }
+
+  // A crash in the middle of a commit leaves part of its record.
+  std::string log;
+  TEST_CHECK(read_file(log_path, log));
+  write_file(log_path, log.substr(0, log.size() - 5));
+
+  {
+    WalPersistenceUpdater updater;
+    TEST_CHECK(start(updater, ACE_TEXT("")));
+    TEST_CHECK(updater.entities() == 3);
+    TEST_CHECK(file_size(log_path) == committed);
+    create_topic(updater, 1, 3);
+    updater.fini();
+  }
+
+  // The log goes on after the dropped record.
+  WalPersistenceUpdater updater;
+  TEST_CHECK(start(updater, ACE_TEXT("")));
+  TEST_CHECK(updater.entities() == 4);
+  updater.fini();
+}
+
+void test_snapshot_and_log()
+{
+  {
+    WalPersistenceUpdater updater;
+    TEST_CHECK(start(updater, ACE_TEXT("-reset 1 -snapshot_records 3")));
+    create_participant(updater, 1);
+    create_participant(updater, 2);
+    // The third record in the log writes a snapshot instead.
+    create_participant(updater, 3);
+    std::string snapshot;
+    TEST_CHECK(read_file(snapshot_path, snapshot));
+    TEST_CHECK(snapshot.size() > header_size);
+    TEST_CHECK(file_size(log_path) == header_size);
+
+    create_participant(updater, 4);
+    destroy_participant(updater, 1);
+    TEST_CHECK(file_size(log_path) > header_size);
+    updater.fini();
+  }
+
+  // The snapshot holds 1, 2 and 3, and the log adds 4 and erases 1.
+  WalPersistenceUpdater updater;
+  TEST_CHECK(start(updater, ACE_TEXT("")));
+  TEST_CHECK(updater.entities() == 3);
+  updater.fini();
+}
+
+void test_erase_before_snapshot()
+{
+  std::string old_log;
+  {
+    WalPersistenceUpdater updater;
+    TEST_CHECK(start(updater, ACE_TEXT("-reset 1")));
+    create_participant(updater, 1);
+    create_topic(updater, 1, 1);
+    destroy_topic(updater, 1, 1);
+    TEST_CHECK(read_file(log_path, old_log));
+    create_topic(updater, 1, 1);
+    updater.fini();
+  }
+
+  {
+    WalPersistenceUpdater updater;
+    TEST_CHECK(start(updater, ACE_TEXT("-snapshot_records 1")));
+    TEST_CHECK(updater.entities() == 2);
+    updater.updateLastPartId(1);
+    updater.sync();
+    TEST_CHECK(file_size(log_path) == header_size);
+    updater.fini();
+  }
+
+  // A crash after the snapshot was renamed into place, before the log was
+  // started again: the log's erase of the topic is older than the
+  // snapshot, which has the topic created again.
+  write_file(log_path, old_log);
+
+  {
+    WalPersistenceUpdater updater;
+    TEST_CHECK(start(updater, ACE_TEXT("")));
+    TEST_CHECK(updater.entities() == 2);
+    create_topic(updater, 1, 2);
+    updater.fini();
+  }
+
+  // The old log was started again after the snapshot.
+  WalPersistenceUpdater updater;
+  TEST_CHECK(start(updater, ACE_TEXT("")));
+  TEST_CHECK(updater.entities() == 3);
+  updater.fini();
+}
+
+void test_write_behind()
+{
+  {
+    WalPersistenceUpdater updater;
+    TEST_CHECK(start(updater, ACE_TEXT("-reset 1 -write_behind 1 -commit_interval 60000")));
+    // sync() returns without the commit, which flush() asks for.
+    create_participant(updater, 1);
+    TEST_CHECK(file_size(log_path) == header_size);
+    TEST_CHECK(updater.flush());
+    TEST_CHECK(file_size(log_path) > header_size);
+    // Committed when the updater is finalized.
+    create_participant(updater, 2);
+    updater.fini();
+  }
+
+  WalPersistenceUpdater updater;
+  TEST_CHECK(start(updater, ACE_TEXT("")));
+  TEST_CHECK(updater.entities() == 2);
+  updater.fini();
+}
+
+}
+
+int ACE_TMAIN(int, ACE_TCHAR*[])
+{
+  test_torn_tail();
+  test_snapshot_and_log();
+  test_erase_before_snapshot();
+  test_write_behind();
+
+  ACE_OS::unlink(log_path);
+  ACE_OS::unlink(snapshot_path);
+  return 0;
+}
@@ -92,6 +92,7 @@ int hf_sample_flags_more_frags  = -1;
 int hf_sample_flags2            = -1;
 int hf_sample_flags2_cdr_encap  = -1;
 int hf_sample_flags2_key_only   = -1;
+int hf_sample_flags2_compressed = -1;
 
 // Payload IDL Type, ex "Messenger::Message"
 int hf_sample_payload = -1;
@@ -121,6 +122,7 @@ const int sample_flags2_bits = 8;
 const int* sample_flags2_fields[] = {
   &hf_sample_flags2_cdr_encap,
   &hf_sample_flags2_key_only,
+  &hf_sample_flags2_compressed,
   NULL
 };
 
@@ -923,6 +925,11 @@ namespace OpenDDS
               FT_BOOLEAN, sample_flags2_bits, BF_HFILL(1)
             }
         },
+        { &hf_sample_flags2_compressed,
+            { "Compressed", "opendds.sample.flags2.compressed",
+              FT_BOOLEAN, sample_flags2_bits, BF_HFILL(2)
+            }
+        },
         { &hf_sample_length,
             { "Length", "opendds.sample.length",
                 FT_UINT32, BASE_HEX, NULL_HFILL
@@ -0,0 +1,104 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+// Reads the [topic], [*qos] and [endpoint] sections of a static discovery
+// configuration file, matches the writers and readers, and writes the
+// result as a C++ source file of constant tables.  The application links
+// that file and passes the tables to StaticDiscovery::load_tables()
+// instead of having the [endpoint] sections parsed and matched at
+// startup.  The transport configurations of the endpoints have to be in
+// the file too, as their locators are stored in the tables.
+
+#include "dds/DCPS/Service_Participant.h"
+#include "dds/DCPS/StaticDiscovery.h"
+
+#include "dds/DCPS/StaticIncludes.h"
+
+#include "ace/Arg_Shifter.h"
+#include "ace/OS_NS_stdio.h"
+
+#include <iostream>
+
+namespace {
+
+void print_usage()
+{
+  std::cout << std::endl
+    << "USAGE: static_discovery_tables -DCPSConfigFile <file> [-o <file>] [-n <name>]" << std::endl
+    << "       -o <file>  the C++ file to write. default: static_discovery_tables.cpp" << std::endl
+    << "       -n <name>  the name of the tables. default: static_discovery_tables" << std::endl
+    << "       -h         print help and exit" << std::endl;
+}
+
+}
+
+int ACE_TMAIN(int argc, ACE_TCHAR* argv[])
+{
+  int status = 0;
+  try {
+    DDS::DomainParticipantFactory_var dpf =
+      TheParticipantFactoryWithArgs(argc, argv);
+
+    ACE_TString output = ACE_TEXT("static_discovery_tables.cpp");
+    ACE_TString name = ACE_TEXT("static_discovery_tables");
+    ACE_Arg_Shifter_T<ACE_TCHAR> shifter(argc, argv);
+    while (shifter.is_anything_left()) {
+      const ACE_TCHAR* currentArg = 0;
+      if ((currentArg = shifter.get_the_parameter(ACE_TEXT("-o"))) != 0) {
+        output = currentArg;
+        shifter.consume_arg();
+      } else if ((currentArg = shifter.get_the_parameter(ACE_TEXT("-n"))) != 0) {
+        name = currentArg;
+        shifter.consume_arg();
+      } else if (shifter.cur_arg_strncasecmp(ACE_TEXT("-h")) == 0) {
+        print_usage();
+        return 0;
+      } else {
+        shifter.ignore_arg();
+      }
+    }
+
+    const OpenDDS::DCPS::EndpointRegistry& registry =
+      OpenDDS::DCPS::StaticDiscovery::instance()->registry;
+    if (registry.writer_map.empty() && registry.reader_map.empty()) {
+      ACE_ERROR((LM_WARNING,
+                 ACE_TEXT("WARNING: the configuration has no [endpoint] sections\n")));
+    }
+
+    const OpenDDS::DCPS::StaticDiscoveryTableBuilder builder(registry);
+    if (!builder.good()) {
+      ACE_ERROR_RETURN((LM_ERROR,
+                        ACE_TEXT("ERROR: failed to build the tables\n")), 1);
+    }
+    const OPENDDS_STRING cpp = builder.to_cpp(ACE_TEXT_ALWAYS_CHAR(name.c_str()));
+
+    FILE* const file = ACE_OS::fopen(output.c_str(), ACE_TEXT("w"));
+    if (!file) {
+      ACE_ERROR_RETURN((LM_ERROR,
+                        ACE_TEXT("ERROR: failed to open %s %p\n"),
+                        output.c_str(), ACE_TEXT("fopen")), 1);
+    }
+    const bool written = ACE_OS::fwrite(cpp.data(), 1, cpp.size(), file) == cpp.size();
+    if (ACE_OS::fclose(file) != 0 || !written) {
+      ACE_ERROR((LM_ERROR,
+                 ACE_TEXT("ERROR: failed to write %s\n"), output.c_str()));
+      status = 1;
+    } else {
+      std::cout << "wrote " << registry.writer_map.size() << " writers and "
+                << registry.reader_map.size() << " readers to "
+                << ACE_TEXT_ALWAYS_CHAR(output.c_str()) << std::endl;
+    }
+
+    TheServiceParticipant->shutdown();
+
+  } catch (const CORBA::Exception& e) {
+    e._tao_print_exception("Exception caught in main():");
+    status = 1;
+  }
+
+  return status;
+}